@@ -296,6 +296,7 @@ else:
         "gpu.state",
         "gpu.texture",
         "gpu.platform",
+        "gpu.profile",
         "gpu.capabilities",
         "gpu_extras",
         "idprop.types",
@@ -2240,6 +2241,7 @@ def write_rst_importable_modules(basepath):
         "gpu.state": "GPU State Utilities",
         "gpu.texture": "GPU Texture Utilities",
         "gpu.platform": "GPU Platform Utilities",
+        "gpu.profile": "GPU Profiling Utilities",
         "gpu.capabilities": "GPU Capabilities Utilities",
         "bmesh": "BMesh Module",
         "bmesh.ops": "BMesh Operators",
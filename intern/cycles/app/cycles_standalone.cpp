@@ -9,6 +9,7 @@
 #include "scene/integrator.h"
 #include "scene/scene.h"
 #include "session/buffers.h"
+#include "session/merge.h"
 #include "session/session.h"
 
 #include "util/args.h"
@@ -49,6 +50,11 @@ struct Options {
   bool show_help, interactive, pause;
   string output_filepath;
   string output_pass;
+  /* Render only one of multiple ranges of samples, to distribute a frame over render nodes. */
+  int split_count, split_index;
+  /* Merge images rendered with split samples instead of rendering. */
+  bool merge;
+  vector<string> input_filepaths;
 } options;
 
 static void session_print(const string &str)
@@ -139,8 +145,12 @@ static void session_init()
 #endif
 
   if (!options.output_filepath.empty()) {
-    options.session->set_output_driver(make_unique<OIIOOutputDriver>(
-        options.output_filepath, options.output_pass, session_print));
+    unique_ptr<OIIOOutputDriver> output_driver = make_unique<OIIOOutputDriver>(
+        options.output_filepath, options.output_pass, session_print);
+    if (options.split_count > 1) {
+      output_driver->set_samples_metadata(options.session_params.samples);
+    }
+    options.session->set_output_driver(std::move(output_driver));
   }
 
   if (options.session_params.background && !options.quiet) {
@@ -354,9 +364,27 @@ static int files_parse(int argc, const char *argv[])
     options.filepath = argv[0];
   }
 
+  for (int i = 0; i < argc; i++) {
+    options.input_filepaths.push_back(argv[i]);
+  }
+
   return 0;
 }
 
+static int merge_images()
+{
+  ImageMerger merger;
+  merger.input = options.input_filepaths;
+  merger.output = options.output_filepath;
+
+  if (!merger.run()) {
+    fprintf(stderr, "%s\n", merger.error.c_str());
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
+
 static void options_parse(int argc, const char **argv)
 {
   options.width = 1024;
@@ -366,6 +394,9 @@ static void options_parse(int argc, const char **argv)
   options.quiet = false;
   options.session_params.use_auto_tile = false;
   options.session_params.tile_size = 0;
+  options.split_count = 1;
+  options.split_index = 0;
+  options.merge = false;
 
   /* device names */
   string device_names = "";
@@ -411,6 +442,15 @@ static void options_parse(int argc, const char **argv)
              "--samples %d",
              &options.session_params.samples,
              "Number of samples to render",
+             "--split-count %d",
+             &options.split_count,
+             "Split the samples into this many ranges, to render them on multiple nodes",
+             "--split-index %d",
+             &options.split_index,
+             "Index of the sample range to render, from 0 to the split count minus one",
+             "--merge",
+             &options.merge,
+             "Merge the EXR files rendered with split samples into the output file",
              "--output %s",
              &options.output_filepath,
              "File path to write output image",
@@ -480,6 +520,13 @@ static void options_parse(int argc, const char **argv)
     ap.usage();
     exit(EXIT_SUCCESS);
   }
+  else if (options.merge) {
+    if (options.output_filepath.empty()) {
+      fprintf(stderr, "No output file path specified for merging\n");
+      exit(EXIT_FAILURE);
+    }
+    return;
+  }
 
   options.session_params.use_profiling = profile;
 
@@ -529,10 +576,39 @@ static void options_parse(int argc, const char **argv)
     fprintf(stderr, "Invalid number of samples: %d\n", options.session_params.samples);
     exit(EXIT_FAILURE);
   }
+  else if (options.split_count < 1 || options.split_index < 0 ||
+           options.split_index >= options.split_count)
+  {
+    fprintf(stderr,
+            "Invalid sample split: index %d of %d\n",
+            options.split_index,
+            options.split_count);
+    exit(EXIT_FAILURE);
+  }
+  else if (options.split_count > 1 &&
+           !string_endswith(string_to_lower(options.output_filepath), ".exr"))
+  {
+    fprintf(stderr, "Rendering split samples requires an EXR output file\n");
+    exit(EXIT_FAILURE);
+  }
   else if (options.filepath == "") {
     fprintf(stderr, "No file path specified\n");
     exit(EXIT_FAILURE);
   }
+
+  if (options.split_count > 1) {
+    /* Each node renders a disjoint range of samples, so the merged result is the same as
+     * rendering all samples on a single node. */
+    const int64_t samples = options.session_params.samples;
+    const int sample_start = int(samples * options.split_index / options.split_count);
+    const int sample_end = int(samples * (options.split_index + 1) / options.split_count);
+    if (sample_end == sample_start) {
+      fprintf(stderr, "Split count %d is larger than the number of samples\n", options.split_count);
+      exit(EXIT_FAILURE);
+    }
+    options.session_params.sample_offset = sample_start;
+    options.session_params.samples = sample_end - sample_start;
+  }
 }
 
 CCL_NAMESPACE_END
@@ -545,6 +621,10 @@ int main(int argc, const char **argv)
   path_init();
   options_parse(argc, argv);
 
+  if (options.merge) {
+    return merge_images();
+  }
+
 #ifdef WITH_CYCLES_STANDALONE_GUI
   if (options.session_params.background) {
 #endif
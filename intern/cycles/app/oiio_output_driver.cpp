@@ -20,6 +20,11 @@ OIIOOutputDriver::OIIOOutputDriver(const string_view filepath,
 
 OIIOOutputDriver::~OIIOOutputDriver() {}
 
+void OIIOOutputDriver::set_samples_metadata(const int samples)
+{
+  samples_ = samples;
+}
+
 void OIIOOutputDriver::write_render_tile(const Tile &tile)
 {
   /* Only write the full buffer, no intermediate tiles. */
@@ -39,6 +44,10 @@ void OIIOOutputDriver::write_render_tile(const Tile &tile)
   const int height = tile.size.y;
 
   ImageSpec spec(width, height, 4, TypeDesc::FLOAT);
+  if (samples_ > 0) {
+    const string layer = tile.layer.empty() ? "RenderLayer" : tile.layer;
+    spec.attribute("cycles." + layer + ".samples", string_printf("%d", samples_));
+  }
   if (!image_output->open(filepath_, spec)) {
     log_("Failed to create image file");
     return;
@@ -21,10 +21,15 @@ class OIIOOutputDriver : public OutputDriver {
 
   void write_render_tile(const Tile &tile) override;
 
+  /* Store the number of samples in the file metadata, so that images rendered with different
+   * sample ranges can be merged with ImageMerger. */
+  void set_samples_metadata(const int samples);
+
  protected:
   string filepath_;
   string pass_;
   LogFunction log_;
+  int samples_ = 0;
 };
 
 CCL_NAMESPACE_END
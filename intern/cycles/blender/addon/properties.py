@@ -1040,6 +1040,17 @@ class CyclesRenderSettings(bpy.types.PropertyGroup):
         description="",
         min=8, max=8192,
     )
+    use_streaming_tiles: BoolProperty(
+        name="Stream Tiles",
+        description="Denoise and output the tiles cached on disk in bands of the tile size, so that the memory usage after rendering depends on the tile size rather than the image size",
+        default=False,
+    )
+    texture_memory_budget: IntProperty(
+        name="Texture Memory Budget",
+        description="Maximum memory in megabytes used by image textures, the largest images are scaled down until all of them fit. 0 disables the budget",
+        default=0,
+        min=0,
+    )
 
     # Various fine-tuning debug flags
 
@@ -13,7 +13,11 @@
 #include "blender/util.h"
 
 #include "util/foreach.h"
+#include "util/log.h"
+#include "util/md5.h"
 #include "util/task.h"
+#include "util/tbb.h"
+#include "util/time.h"
 
 CCL_NAMESPACE_BEGIN
 
@@ -186,6 +190,118 @@ Geometry *BlenderSync::sync_geometry(BL::Depsgraph &b_depsgraph,
   return geom;
 }
 
+bool BlenderSync::geometry_is_modified(const Geometry *geom) const
+{
+  /* Geometry synced in the task pool gets modified concurrently, so conservatively assume it
+   * changed. Other geometry is not touched by the task pool. */
+  if (geometry_synced.find(const_cast<Geometry *>(geom)) != geometry_synced.end()) {
+    return true;
+  }
+  return geom->is_modified();
+}
+
+static void md5_append_data(MD5Hash &md5, const void *data, size_t size)
+{
+  /* MD5Hash takes sizes as int, so append large buffers in pieces. */
+  const uint8_t *bytes = static_cast<const uint8_t *>(data);
+  const size_t max_chunk_size = 1 << 30;
+  while (size > 0) {
+    const size_t chunk_size = min(size, max_chunk_size);
+    md5.append(bytes, int(chunk_size));
+    bytes += chunk_size;
+    size -= chunk_size;
+  }
+}
+
+/* Hash of all sockets and attributes of the geometry, identical for geometry synced from
+ * different datablocks with the same content. */
+static string geometry_content_hash(Geometry *geom)
+{
+  MD5Hash md5;
+  geom->hash(md5);
+
+  foreach (const Attribute &attr, geom->attributes.attributes) {
+    md5.append(attr.name.string());
+    md5_append_data(md5, &attr.std, sizeof(attr.std));
+    md5_append_data(md5, &attr.element, sizeof(attr.element));
+    md5.append(string(attr.type.c_str()));
+    md5_append_data(md5, attr.data(), attr.data_size());
+  }
+
+  return md5.get_hex();
+}
+
+void BlenderSync::deduplicate_geometry()
+{
+  /* Motion steps are synced per object after this point, so geometry which is identical at the
+   * center of the frame may still deform differently. */
+  if (scene->need_motion() != Scene::MOTION_NONE) {
+    return;
+  }
+
+  scoped_timer timer;
+
+  /* Volumes reference image handles rather than data, and adaptive subdivision is diced for
+   * each object separately, so only consider other geometry. */
+  vector<Geometry *> candidates;
+  foreach (Geometry *geom, geometry_synced) {
+    if (geom->is_volume()) {
+      continue;
+    }
+    if (geom->is_mesh() &&
+        static_cast<Mesh *>(geom)->get_subdivision_type() != Mesh::SUBDIVISION_NONE)
+    {
+      continue;
+    }
+    candidates.push_back(geom);
+  }
+
+  if (candidates.size() < 2) {
+    return;
+  }
+
+  vector<string> hashes(candidates.size());
+  parallel_for(size_t(0), candidates.size(), [&](size_t i) {
+    if (!progress.get_cancel()) {
+      hashes[i] = geometry_content_hash(candidates[i]);
+    }
+  });
+
+  if (progress.get_cancel()) {
+    return;
+  }
+
+  /* Map every duplicate to the first geometry found with the same content. */
+  map<string, Geometry *> unique_geometry;
+  map<Geometry *, Geometry *> duplicate_geometry;
+  for (size_t i = 0; i < candidates.size(); i++) {
+    auto it = unique_geometry.insert(std::make_pair(hashes[i], candidates[i]));
+    if (!it.second) {
+      duplicate_geometry[candidates[i]] = it.first->second;
+    }
+  }
+
+  if (duplicate_geometry.empty()) {
+    return;
+  }
+
+  foreach (Object *object, scene->objects) {
+    auto it = duplicate_geometry.find(object->get_geometry());
+    if (it != duplicate_geometry.end()) {
+      object->set_geometry(it->second);
+    }
+  }
+
+  /* Duplicates are no longer referenced by any object, and get deleted in post_sync. */
+  for (auto &it : duplicate_geometry) {
+    geometry_synced.erase(it.first);
+    geometry_map.unused(it.first);
+  }
+
+  VLOG_INFO << "Deduplicated " << duplicate_geometry.size() << " of " << candidates.size()
+            << " geometries in " << timer.get_time() << " seconds.";
+}
+
 void BlenderSync::sync_geometry_motion(BL::Depsgraph &b_depsgraph,
                                        BObjectInfo &b_ob_info,
                                        Object *object,
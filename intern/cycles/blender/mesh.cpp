@@ -25,6 +25,7 @@
 #include "util/hash.h"
 #include "util/log.h"
 #include "util/math.h"
+#include "util/tbb.h"
 
 #include "mikktspace.hh"
 
@@ -33,8 +34,30 @@
 #include "BKE_customdata.hh"
 #include "BKE_mesh.hh"
 
+#include "BLI_implicit_sharing.hh"
+
 CCL_NAMESPACE_BEGIN
 
+/* Per element conversion of large meshes runs in parallel. Geometry sync already converts
+ * multiple meshes at the same time, this helps when a few heavy meshes dominate the sync. */
+static const int MESH_ELEMENTS_PER_TASK = 4096;
+
+template<typename Func> static void parallel_for_elements(const int size, const Func &func)
+{
+  if (size <= MESH_ELEMENTS_PER_TASK) {
+    for (int i = 0; i < size; i++) {
+      func(i);
+    }
+    return;
+  }
+  parallel_for(blocked_range<int>(0, size, MESH_ELEMENTS_PER_TASK),
+               [&](const blocked_range<int> &r) {
+                 for (int i = r.begin(); i != r.end(); i++) {
+                   func(i);
+                 }
+               });
+}
+
 /* Tangent Space */
 
 template<bool is_subd> struct MikkMeshWrapper {
@@ -267,6 +290,38 @@ static void attr_create_motion_from_velocity(Mesh *mesh,
   }
 }
 
+/* Reference the array of a Blender attribute instead of copying it, when Cycles uses the same
+ * storage for it. Implicit sharing guarantees that the array is not modified while referenced,
+ * Blender copies it on write instead. */
+template<typename BlenderT, typename CyclesT>
+static bool attr_share_generic(Attribute *attr, const blender::bke::GAttributeReader &b_attr)
+{
+  constexpr bool same_storage = std::is_same_v<BlenderT, float> ||
+                                std::is_same_v<BlenderT, blender::float2> ||
+                                std::is_same_v<BlenderT, blender::ColorGeometry4f>;
+  if constexpr (!same_storage || sizeof(BlenderT) != sizeof(CyclesT)) {
+    return false;
+  }
+  else {
+    if (b_attr.sharing_info == nullptr || !b_attr.varray.is_span()) {
+      return false;
+    }
+    const blender::GSpan span = b_attr.varray.get_internal_span();
+    if (span.is_empty() || (uintptr_t(span.data()) % alignof(CyclesT)) != 0) {
+      return false;
+    }
+
+    const blender::ImplicitSharingInfo *sharing_info = b_attr.sharing_info;
+    sharing_info->add_user();
+    attr->set_external_data(span.data(),
+                            span.size_in_bytes(),
+                            std::shared_ptr<const void>(span.data(), [sharing_info](const void *) {
+                              sharing_info->remove_user_and_delete_if_last();
+                            }));
+    return true;
+  }
+}
+
 static void attr_create_generic(Scene *scene,
                                 Mesh *mesh,
                                 const ::Mesh &b_mesh,
@@ -377,36 +432,38 @@ static void attr_create_generic(Scene *scene,
         switch (b_attr.domain) {
           case blender::bke::AttrDomain::Corner: {
             if (subdivision) {
-              for (const int i : src.index_range()) {
-                data[i] = Converter::convert(src[i]);
-              }
+              parallel_for_elements(src.size(),
+                                    [&](const int i) { data[i] = Converter::convert(src[i]); });
             }
             else {
-              for (const int i : corner_tris.index_range()) {
+              parallel_for_elements(corner_tris.size(), [&](const int i) {
                 const blender::int3 &tri = corner_tris[i];
                 data[i * 3 + 0] = Converter::convert(src[tri[0]]);
                 data[i * 3 + 1] = Converter::convert(src[tri[1]]);
                 data[i * 3 + 2] = Converter::convert(src[tri[2]]);
-              }
+              });
             }
             break;
           }
           case blender::bke::AttrDomain::Point: {
-            for (const int i : src.index_range()) {
-              data[i] = Converter::convert(src[i]);
+            /* Vertex attributes have the same layout in Blender and Cycles, except for the ngon
+             * centers that subdivision meshes append. */
+            if (!subdivision && attr_share_generic<BlenderT, CyclesT>(attr, b_attr)) {
+              break;
             }
+            parallel_for_elements(src.size(),
+                                  [&](const int i) { data[i] = Converter::convert(src[i]); });
             break;
           }
           case blender::bke::AttrDomain::Face: {
             if (subdivision) {
-              for (const int i : src.index_range()) {
-                data[i] = Converter::convert(src[i]);
-              }
+              parallel_for_elements(src.size(),
+                                    [&](const int i) { data[i] = Converter::convert(src[i]); });
             }
             else {
-              for (const int i : corner_tris.index_range()) {
+              parallel_for_elements(corner_tris.size(), [&](const int i) {
                 data[i] = Converter::convert(src[tri_faces[i]]);
-              }
+              });
             }
             break;
           }
@@ -477,12 +534,12 @@ static void attr_create_uv_map(Scene *scene,
         const blender::VArraySpan b_uv_map = *b_attributes.lookup<blender::float2>(
             uv_name.c_str(), blender::bke::AttrDomain::Corner);
         float2 *fdata = uv_attr->data_float2();
-        for (const int i : corner_tris.index_range()) {
+        parallel_for_elements(corner_tris.size(), [&](const int i) {
           const blender::int3 &tri = corner_tris[i];
           fdata[i * 3 + 0] = make_float2(b_uv_map[tri[0]][0], b_uv_map[tri[0]][1]);
           fdata[i * 3 + 1] = make_float2(b_uv_map[tri[1]][0], b_uv_map[tri[1]][1]);
           fdata[i * 3 + 2] = make_float2(b_uv_map[tri[2]][0], b_uv_map[tri[2]][1]);
-        }
+        });
       }
 
       /* UV tangent */
@@ -865,9 +922,9 @@ static void create_mesh(Scene *scene,
   mesh->resize_mesh(positions.size(), numtris);
 
   float3 *verts = mesh->get_verts().data();
-  for (const int i : positions.index_range()) {
+  parallel_for_elements(positions.size(), [&](const int i) {
     verts[i] = make_float3(positions[i][0], positions[i][1], positions[i][2]);
-  }
+  });
 
   AttributeSet &attributes = (subdivision) ? mesh->subd_attributes : mesh->attributes;
   Attribute *attr_N = attributes.add(ATTR_STD_VERTEX_NORMAL);
@@ -875,9 +932,9 @@ static void create_mesh(Scene *scene,
 
   if (subdivision || !(use_corner_normals && !corner_normals.is_empty())) {
     const blender::Span<blender::float3> vert_normals = b_mesh.vert_normals();
-    for (const int i : vert_normals.index_range()) {
+    parallel_for_elements(vert_normals.size(), [&](const int i) {
       N[i] = make_float3(vert_normals[i][0], vert_normals[i][1], vert_normals[i][2]);
-    }
+    });
   }
 
   const set<ustring> blender_uv_names = get_blender_uv_names(b_mesh);
@@ -901,7 +958,7 @@ static void create_mesh(Scene *scene,
 
     float3 *generated = attr->data_float3();
 
-    for (const int i : positions.index_range()) {
+    parallel_for_elements(positions.size(), [&](const int i) {
       blender::float3 value;
       if (orco) {
         madd_v3_v3v3v3(value, texspace_location, orco[i], texspace_size);
@@ -910,7 +967,7 @@ static void create_mesh(Scene *scene,
         value = positions[i];
       }
       generated[i] = make_float3(value[0], value[1], value[2]) * size - loc;
-    }
+    });
   }
 
   auto clamp_material_index = [&](const int material_index) -> int {
@@ -924,18 +981,18 @@ static void create_mesh(Scene *scene,
     int *shader = mesh->get_shader().data();
 
     const blender::Span<blender::int3> corner_tris = b_mesh.corner_tris();
-    for (const int i : corner_tris.index_range()) {
+    parallel_for_elements(corner_tris.size(), [&](const int i) {
       const blender::int3 &tri = corner_tris[i];
       triangles[i * 3 + 0] = corner_verts[tri[0]];
       triangles[i * 3 + 1] = corner_verts[tri[1]];
       triangles[i * 3 + 2] = corner_verts[tri[2]];
-    }
+    });
 
     if (!material_indices.is_empty()) {
       const blender::Span<int> tri_faces = b_mesh.corner_tri_faces();
-      for (const int i : corner_tris.index_range()) {
+      parallel_for_elements(corner_tris.size(), [&](const int i) {
         shader[i] = clamp_material_index(material_indices[tri_faces[i]]);
-      }
+      });
     }
     else {
       std::fill(shader, shader + numtris, 0);
@@ -943,9 +1000,8 @@ static void create_mesh(Scene *scene,
 
     if (!sharp_faces.is_empty() && !(use_corner_normals && !corner_normals.is_empty())) {
       const blender::Span<int> tri_faces = b_mesh.corner_tri_faces();
-      for (const int i : corner_tris.index_range()) {
-        smooth[i] = !sharp_faces[tri_faces[i]];
-      }
+      parallel_for_elements(corner_tris.size(),
+                            [&](const int i) { smooth[i] = !sharp_faces[tri_faces[i]]; });
     }
     else {
       /* If only face normals are needed, all faces are sharp. */
@@ -445,7 +445,11 @@ void BlenderSession::render(BL::Depsgraph &b_depsgraph_)
     session->reset(effective_session_params, buffer_params);
 
     /* render */
-    if (!b_engine.is_preview() && background && print_render_stats) {
+    const char *stats_json_dir = getenv("CYCLES_STATS_JSON_DIR");
+    const bool write_stats_json = !b_engine.is_preview() && background && stats_json_dir &&
+                                  stats_json_dir[0];
+
+    if (!b_engine.is_preview() && background && (print_render_stats || write_stats_json)) {
       scene->enable_update_stats();
     }
 
@@ -458,6 +462,20 @@ void BlenderSession::render(BL::Depsgraph &b_depsgraph_)
       printf("Render statistics:\n%s\n", stats.full_report().c_str());
     }
 
+    if (write_stats_json) {
+      RenderStats stats;
+      session->collect_statistics(&stats);
+      string json = stats.json_report(scene->update_stats);
+      const string filepath = path_join(stats_json_dir,
+                                        string_printf("cycles_stats_%04d_%s_%s.json",
+                                                      b_scene.frame_current(),
+                                                      b_rlay_name.c_str(),
+                                                      b_rview_name.c_str()));
+      if (!path_write_text(filepath, json)) {
+        LOG(ERROR) << "Failed to write render statistics to " << filepath;
+      }
+    }
+
     if (session->progress.get_cancel()) {
       break;
     }
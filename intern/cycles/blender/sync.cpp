@@ -879,6 +879,8 @@ SceneParams BlenderSync::get_scene_params(BL::Scene &b_scene,
   else {
     params.texture_limit = 0;
   }
+  const int texture_memory_budget = get_int(cscene, "texture_memory_budget");
+  params.texture_memory_budget = size_t(max(texture_memory_budget, 0)) * 1024 * 1024;
 
   params.bvh_layout = DebugFlags().cpu.bvh_layout;
 
@@ -982,6 +984,7 @@ SessionParams BlenderSync::get_session_params(BL::RenderEngine &b_engine,
   if (background) {
     params.use_auto_tile = RNA_boolean_get(&cscene, "use_auto_tile");
     params.tile_size = max(get_int(cscene, "tile_size"), 8);
+    params.use_streaming_tiles = RNA_boolean_get(&cscene, "use_streaming_tiles");
   }
   else {
     params.use_auto_tile = false;
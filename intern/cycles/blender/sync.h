@@ -194,6 +194,11 @@ class BlenderSync {
                             bool use_particle_hair,
                             TaskPool *task_pool);
 
+  /* Whether geometry is modified in this sync. Safe to call while geometry sync tasks run, unlike
+   * Geometry::is_modified(). */
+  bool geometry_is_modified(const Geometry *geom) const;
+  void deduplicate_geometry();
+
   /* Light */
   void sync_light(BL::Object &b_parent,
                   int persistent_id[OBJECT_PERSISTENT_ID_SIZE],
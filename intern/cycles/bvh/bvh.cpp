@@ -82,10 +82,18 @@ BVHLayout BVHParams::best_bvh_layout(BVHLayout requested_layout, BVHLayoutMask s
 BVH::BVH(const BVHParams &params_,
          const vector<Geometry *> &geometry_,
          const vector<Object *> &objects_)
-    : params(params_), geometry(geometry_), objects(objects_)
+    : params(params_), geometry(geometry_), objects(objects_), num_refits(0)
 {
 }
 
+/* Rebuild after this many refits, when the quality of the refitted BVH is not known. */
+static const int BVH_MAX_NUM_REFITS = 32;
+
+bool BVH::refit_degraded() const
+{
+  return num_refits >= BVH_MAX_NUM_REFITS;
+}
+
 BVH *BVH::create(const BVHParams &params,
                  const vector<Geometry *> &geometry,
                  const vector<Object *> &objects,
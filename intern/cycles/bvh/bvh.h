@@ -82,6 +82,19 @@ class BVH {
     this->objects = objects;
   }
 
+  /* Number of refits since the BVH was built. */
+  int num_refits;
+
+  /* Whether refitting degraded the BVH so much that it should be rebuilt instead. BVHs that can't
+   * estimate their quality are rebuilt after a fixed number of refits. */
+  virtual bool refit_degraded() const;
+
+  /* Memory used by the acceleration structure, zero when the backend can not report it. */
+  virtual size_t memory_size() const
+  {
+    return 0;
+  }
+
  protected:
   BVH(const BVHParams &params,
       const vector<Geometry *> &geometry,
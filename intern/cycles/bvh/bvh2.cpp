@@ -13,6 +13,7 @@
 #include "scene/pointcloud.h"
 
 #include "bvh/build.h"
+#include "bvh/cache.h"
 #include "bvh/node.h"
 #include "bvh/unaligned.h"
 
@@ -31,12 +32,23 @@ int BVHStackEntry::encodeIdx() const
 BVH2::BVH2(const BVHParams &params_,
            const vector<Geometry *> &geometry_,
            const vector<Object *> &objects_)
-    : BVH(params_, geometry_, objects_)
+    : BVH(params_, geometry_, objects_), build_sah_cost(0.0f), refit_sah_cost(0.0f)
 {
 }
 
 void BVH2::build(Progress &progress, Stats *)
 {
+  const string cache_key = bvh_cache_key(params, objects);
+  if (!cache_key.empty()) {
+    progress.set_substatus("Loading BVH from cache");
+    if (bvh_cache_read(cache_key, pack)) {
+      build_sah_cost = 0.0f;
+      refit_sah_cost = 0.0f;
+      pack_primitives();
+      return;
+    }
+  }
+
   progress.set_substatus("Building BVH");
 
   /* build nodes */
@@ -83,8 +95,16 @@ void BVH2::build(Progress &progress, Stats *)
   progress.set_substatus("Packing BVH nodes");
   pack_nodes(root);
 
+  /* Remember the quality of the tree, to detect when refitting degraded it. */
+  build_sah_cost = params.top_level ? 0.0f : root->computeSubtreeSAHCost(params);
+  refit_sah_cost = build_sah_cost;
+
   /* free build nodes */
   root->deleteSubtree();
+
+  if (!cache_key.empty()) {
+    bvh_cache_write(cache_key, pack);
+  }
 }
 
 void BVH2::refit(Progress &progress)
@@ -100,6 +120,25 @@ void BVH2::refit(Progress &progress)
   refit_nodes();
 }
 
+/* Rebuild when refitting made the SAH cost this much worse than that of the built tree. */
+static const float BVH2_MAX_REFIT_SAH_RATIO = 1.5f;
+
+bool BVH2::refit_degraded() const
+{
+  if (build_sah_cost == 0.0f) {
+    return BVH::refit_degraded();
+  }
+  return refit_sah_cost > build_sah_cost * BVH2_MAX_REFIT_SAH_RATIO;
+}
+
+size_t BVH2::memory_size() const
+{
+  return pack.nodes.size() * sizeof(int4) + pack.leaf_nodes.size() * sizeof(int4) +
+         pack.object_node.size() * sizeof(int) + pack.prim_type.size() * sizeof(int) +
+         pack.prim_visibility.size() * sizeof(uint) + pack.prim_index.size() * sizeof(int) +
+         pack.prim_object.size() * sizeof(int) + pack.prim_time.size() * sizeof(float2);
+}
+
 BVHNode *BVH2::widen_children_nodes(const BVHNode *root)
 {
   return const_cast<BVHNode *>(root);
@@ -309,10 +348,15 @@ void BVH2::refit_nodes()
 
   BoundBox bbox = BoundBox::empty;
   uint visibility = 0;
-  refit_node(0, (pack.root_index == -1) ? true : false, bbox, visibility);
+  float sah_cost = 0.0f;
+  refit_node(0, (pack.root_index == -1) ? true : false, bbox, visibility, sah_cost);
+
+  /* Same normalization as BVHNode::computeSubtreeSAHCost(). */
+  const float root_area = bbox.safe_area();
+  refit_sah_cost = (root_area > 0.0f) ? sah_cost / root_area : 0.0f;
 }
 
-void BVH2::refit_node(int idx, bool leaf, BoundBox &bbox, uint &visibility)
+void BVH2::refit_node(int idx, bool leaf, BoundBox &bbox, uint &visibility, float &sah_cost)
 {
   if (leaf) {
     /* refit leaf node */
@@ -322,6 +366,7 @@ void BVH2::refit_node(int idx, bool leaf, BoundBox &bbox, uint &visibility)
     const int c1 = data[0].y;
 
     refit_primitives(c0, c1, bbox, visibility);
+    sah_cost += bbox.safe_area() * params.primitive_cost(c1 - c0);
 
     /* TODO(sergey): De-duplicate with pack_leaf(). */
     float4 leaf_data[BVH_NODE_LEAF_SIZE];
@@ -342,8 +387,8 @@ void BVH2::refit_node(int idx, bool leaf, BoundBox &bbox, uint &visibility)
     BoundBox bbox0 = BoundBox::empty, bbox1 = BoundBox::empty;
     uint visibility0 = 0, visibility1 = 0;
 
-    refit_node((c0 < 0) ? -c0 - 1 : c0, (c0 < 0), bbox0, visibility0);
-    refit_node((c1 < 0) ? -c1 - 1 : c1, (c1 < 0), bbox1, visibility1);
+    refit_node((c0 < 0) ? -c0 - 1 : c0, (c0 < 0), bbox0, visibility0, sah_cost);
+    refit_node((c1 < 0) ? -c1 - 1 : c1, (c1 < 0), bbox1, visibility1, sah_cost);
 
     if (is_unaligned) {
       Transform aligned_space = transform_identity();
@@ -357,6 +402,7 @@ void BVH2::refit_node(int idx, bool leaf, BoundBox &bbox, uint &visibility)
     bbox.grow(bbox0);
     bbox.grow(bbox1);
     visibility = visibility0 | visibility1;
+    sah_cost += bbox.safe_area() * params.node_cost(2);
   }
 }
 
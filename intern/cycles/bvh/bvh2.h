@@ -38,8 +38,16 @@ class BVH2 : public BVH {
   void build(Progress &progress, Stats *stats);
   void refit(Progress &progress);
 
+  bool refit_degraded() const override;
+  size_t memory_size() const override;
+
   PackedBVH pack;
 
+  /* SAH cost of the tree as built and after the last refit, relative to the root bounds. Zero
+   * when unknown, for example when the tree was loaded from the cache. */
+  float build_sah_cost;
+  float refit_sah_cost;
+
  protected:
   /* constructor */
   friend class BVH;
@@ -82,7 +90,7 @@ class BVH2 : public BVH {
 
   /* refit */
   void refit_nodes();
-  void refit_node(int idx, bool leaf, BoundBox &bbox, uint &visibility);
+  void refit_node(int idx, bool leaf, BoundBox &bbox, uint &visibility, float &sah_cost);
 
   /* Refit range of primitives. */
   void refit_primitives(int start, int end, BoundBox &bbox, uint &visibility);
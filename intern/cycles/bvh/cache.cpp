@@ -0,0 +1,283 @@
+/* SPDX-FileCopyrightText: 2011-2022 Blender Foundation
+ *
+ * SPDX-License-Identifier: Apache-2.0 */
+
+#include "bvh/cache.h"
+
+#include <climits>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+
+#include "bvh/bvh.h"
+#include "bvh/params.h"
+
+#include "scene/attribute.h"
+#include "scene/hair.h"
+#include "scene/mesh.h"
+#include "scene/object.h"
+#include "scene/pointcloud.h"
+
+#include "util/log.h"
+#include "util/md5.h"
+#include "util/path.h"
+
+CCL_NAMESPACE_BEGIN
+
+namespace {
+
+const uint32_t BVH_CACHE_MAGIC = 0x48564243; /* "CBVH" */
+
+/* Increase when changing how the BVH is built or packed, to ignore existing cache entries. */
+const uint32_t BVH_CACHE_VERSION = 1;
+
+class BVHCacheHash {
+ public:
+  template<typename T> void add(const T &value)
+  {
+    add_data(&value, sizeof(value));
+  }
+
+  void add_data(const void *data, size_t size)
+  {
+    const uint8_t *bytes = static_cast<const uint8_t *>(data);
+    while (size > 0) {
+      const int chunk_size = (int)min(size, (size_t)INT_MAX);
+      hash_.append(bytes, chunk_size);
+      bytes += chunk_size;
+      size -= chunk_size;
+    }
+  }
+
+  /* Only hash the components that are used, the padding of float3 is not always initialized. */
+  void add_float3(const float3 *data, const size_t num)
+  {
+    add(num);
+    float buffer[3 * 1024];
+    for (size_t i = 0; i < num; i += 1024) {
+      const size_t chunk_num = min(num - i, (size_t)1024);
+      for (size_t j = 0; j < chunk_num; j++) {
+        buffer[j * 3 + 0] = data[i + j].x;
+        buffer[j * 3 + 1] = data[i + j].y;
+        buffer[j * 3 + 2] = data[i + j].z;
+      }
+      add_data(buffer, sizeof(float) * 3 * chunk_num);
+    }
+  }
+
+  template<typename T> void add_array(const array<T> &data)
+  {
+    add(data.size());
+    add_data(data.data(), sizeof(T) * data.size());
+  }
+
+  void add_array(const array<float3> &data)
+  {
+    add_float3(data.data(), data.size());
+  }
+
+  string get_hex()
+  {
+    return hash_.get_hex();
+  }
+
+ private:
+  MD5Hash hash_;
+};
+
+template<typename T> void write_value(vector<uint8_t> &binary, const T &value)
+{
+  const uint8_t *bytes = reinterpret_cast<const uint8_t *>(&value);
+  binary.insert(binary.end(), bytes, bytes + sizeof(value));
+}
+
+template<typename T> void write_array(vector<uint8_t> &binary, const array<T> &data)
+{
+  write_value(binary, (uint64_t)data.size());
+  const uint8_t *bytes = reinterpret_cast<const uint8_t *>(data.data());
+  binary.insert(binary.end(), bytes, bytes + sizeof(T) * data.size());
+}
+
+template<typename T>
+bool read_value(const vector<uint8_t> &binary, size_t &offset, T &r_value)
+{
+  if (binary.size() - offset < sizeof(T)) {
+    return false;
+  }
+  memcpy(&r_value, binary.data() + offset, sizeof(T));
+  offset += sizeof(T);
+  return true;
+}
+
+template<typename T>
+bool read_array(const vector<uint8_t> &binary, size_t &offset, array<T> &r_data)
+{
+  uint64_t size;
+  if (!read_value(binary, offset, size) || (binary.size() - offset) / sizeof(T) < size) {
+    return false;
+  }
+  r_data.resize(size);
+  if (size > 0) {
+    memcpy(r_data.data(), binary.data() + offset, sizeof(T) * size);
+  }
+  offset += sizeof(T) * size;
+  return true;
+}
+
+string bvh_cache_filepath(const string &key)
+{
+  return path_join(bvh_cache_directory(), key + ".bvh");
+}
+
+}  // namespace
+
+const string &bvh_cache_directory()
+{
+  static const string directory = []() {
+    const char *path = getenv("CYCLES_BVH_CACHE_PATH");
+    return (path) ? string(path) : string();
+  }();
+  return directory;
+}
+
+string bvh_cache_key(const BVHParams &params, const vector<Object *> &objects)
+{
+  if (bvh_cache_directory().empty() || params.bvh_layout != BVH_LAYOUT_BVH2 || params.top_level)
+  {
+    /* The top level BVH merges the geometry level BVHs and depends on the object transforms,
+     * which is not worth caching. */
+    return "";
+  }
+
+  BVHCacheHash hash;
+  hash.add(BVH_CACHE_VERSION);
+
+  hash.add(params.use_spatial_split);
+  hash.add(params.spatial_split_alpha);
+  hash.add(params.unaligned_split_threshold);
+  hash.add(params.sah_node_cost);
+  hash.add(params.sah_primitive_cost);
+  hash.add(params.min_leaf_size);
+  hash.add(params.max_triangle_leaf_size);
+  hash.add(params.max_motion_triangle_leaf_size);
+  hash.add(params.max_curve_leaf_size);
+  hash.add(params.max_motion_curve_leaf_size);
+  hash.add(params.max_point_leaf_size);
+  hash.add(params.max_motion_point_leaf_size);
+  hash.add(params.use_unaligned_nodes);
+  hash.add(params.use_compact_structure);
+  hash.add(params.num_motion_triangle_steps);
+  hash.add(params.num_motion_curve_steps);
+  hash.add(params.num_motion_point_steps);
+  hash.add(params.bvh_type);
+  hash.add(params.curve_subdivisions);
+
+  hash.add(objects.size());
+  for (Object *ob : objects) {
+    Geometry *geom = ob->get_geometry();
+    hash.add(ob->visibility_for_tracing());
+    hash.add(geom->geometry_type);
+    hash.add(geom->primitive_type());
+
+    if (geom->geometry_type == Geometry::MESH || geom->geometry_type == Geometry::VOLUME) {
+      const Mesh *mesh = static_cast<const Mesh *>(geom);
+      hash.add_array(mesh->get_verts());
+      hash.add_array(mesh->get_triangles());
+    }
+    else if (geom->geometry_type == Geometry::HAIR) {
+      const Hair *hair = static_cast<const Hair *>(geom);
+      hash.add_array(hair->get_curve_keys());
+      hash.add_array(hair->get_curve_radius());
+      hash.add_array(hair->get_curve_first_key());
+    }
+    else if (geom->geometry_type == Geometry::POINTCLOUD) {
+      const PointCloud *pointcloud = static_cast<const PointCloud *>(geom);
+      hash.add_array(pointcloud->get_points());
+      hash.add_array(pointcloud->get_radius());
+    }
+    else {
+      return "";
+    }
+
+    const Attribute *attr_mP = (geom->has_motion_blur()) ?
+                                   geom->attributes.find(ATTR_STD_MOTION_VERTEX_POSITION) :
+                                   NULL;
+    if (attr_mP) {
+      hash.add(geom->get_motion_steps());
+      if (attr_mP->data_sizeof() == sizeof(float3)) {
+        hash.add_float3(attr_mP->data_float3(), attr_mP->buffer.size() / sizeof(float3));
+      }
+      else {
+        hash.add(attr_mP->buffer.size());
+        hash.add_data(attr_mP->buffer.data(), attr_mP->buffer.size());
+      }
+    }
+  }
+
+  return hash.get_hex();
+}
+
+bool bvh_cache_read(const string &key, PackedBVH &pack)
+{
+  const string filepath = bvh_cache_filepath(key);
+
+  vector<uint8_t> binary;
+  if (!path_exists(filepath) || !path_read_binary(filepath, binary)) {
+    return false;
+  }
+
+  size_t offset = 0;
+  uint32_t magic, version;
+  int root_index;
+  if (!read_value(binary, offset, magic) || magic != BVH_CACHE_MAGIC ||
+      !read_value(binary, offset, version) || version != BVH_CACHE_VERSION ||
+      !read_value(binary, offset, root_index) || !read_array(binary, offset, pack.nodes) ||
+      !read_array(binary, offset, pack.leaf_nodes) ||
+      !read_array(binary, offset, pack.object_node) ||
+      !read_array(binary, offset, pack.prim_type) ||
+      !read_array(binary, offset, pack.prim_index) ||
+      !read_array(binary, offset, pack.prim_object) ||
+      !read_array(binary, offset, pack.prim_time) || offset != binary.size())
+  {
+    LOG(WARNING) << "Ignoring invalid BVH cache file " << filepath << ".";
+    pack = PackedBVH();
+    return false;
+  }
+
+  pack.root_index = root_index;
+
+  VLOG_INFO << "Loaded BVH from cache file " << filepath << ".";
+  return true;
+}
+
+void bvh_cache_write(const string &key, const PackedBVH &pack)
+{
+  vector<uint8_t> binary;
+  write_value(binary, BVH_CACHE_MAGIC);
+  write_value(binary, BVH_CACHE_VERSION);
+  write_value(binary, pack.root_index);
+  write_array(binary, pack.nodes);
+  write_array(binary, pack.leaf_nodes);
+  write_array(binary, pack.object_node);
+  write_array(binary, pack.prim_type);
+  write_array(binary, pack.prim_index);
+  write_array(binary, pack.prim_object);
+  write_array(binary, pack.prim_time);
+
+  /* Write to a temporary file first, so other processes sharing the cache never read a partially
+   * written file. */
+  const string filepath = bvh_cache_filepath(key);
+  const string temp_filepath = filepath + "." + std::to_string(std::random_device()()) + ".tmp";
+  if (!path_write_binary(temp_filepath, binary)) {
+    LOG(WARNING) << "Failed to write BVH cache file " << temp_filepath << ".";
+    return;
+  }
+  if (std::rename(temp_filepath.c_str(), filepath.c_str()) != 0) {
+    path_remove(temp_filepath);
+    return;
+  }
+
+  VLOG_INFO << "Stored BVH in cache file " << filepath << ".";
+}
+
+CCL_NAMESPACE_END
@@ -0,0 +1,38 @@
+/* SPDX-FileCopyrightText: 2011-2022 Blender Foundation
+ *
+ * SPDX-License-Identifier: Apache-2.0 */
+
+#ifndef __BVH_CACHE_H__
+#define __BVH_CACHE_H__
+
+#include "util/string.h"
+#include "util/vector.h"
+
+CCL_NAMESPACE_BEGIN
+
+class BVHParams;
+class Object;
+struct PackedBVH;
+
+/* BVH Cache
+ *
+ * Disk cache of packed geometry level BVH2 trees, keyed by a hash of the build parameters and
+ * the geometry contents. Static geometry then only has to be built once per shot, instead of
+ * once per frame on every render node sharing the cache directory.
+ *
+ * Enabled by setting the CYCLES_BVH_CACHE_PATH environment variable to a directory. Entries are
+ * never removed automatically. */
+
+/* Directory of the cache, empty when caching is disabled. */
+const string &bvh_cache_directory();
+
+/* Key for the BVH of the given objects, empty when their BVH can't be cached. */
+string bvh_cache_key(const BVHParams &params, const vector<Object *> &objects);
+
+/* Read the pack for the key, except for the primitive visibility which is not stored. */
+bool bvh_cache_read(const string &key, PackedBVH &pack);
+void bvh_cache_write(const string &key, const PackedBVH &pack);
+
+CCL_NAMESPACE_END
+
+#endif /* __BVH_CACHE_H__ */
@@ -30,4 +30,28 @@ void BVHMulti::replace_geometry(const vector<Geometry *> &geometry,
   }
 }
 
+bool BVHMulti::refit_degraded() const
+{
+  if (BVH::refit_degraded()) {
+    return true;
+  }
+
+  foreach (const BVH *bvh, sub_bvhs) {
+    if (bvh->refit_degraded()) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+size_t BVHMulti::memory_size() const
+{
+  size_t size = 0;
+  foreach (const BVH *bvh, sub_bvhs) {
+    size += bvh->memory_size();
+  }
+  return size;
+}
+
 CCL_NAMESPACE_END
@@ -14,6 +14,9 @@ class BVHMulti : public BVH {
  public:
   vector<BVH *> sub_bvhs;
 
+  bool refit_degraded() const override;
+  size_t memory_size() const override;
+
  protected:
   friend class BVH;
   BVHMulti(const BVHParams &params,
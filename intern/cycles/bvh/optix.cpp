@@ -32,6 +32,18 @@ BVHOptiX::~BVHOptiX()
   device->release_bvh(this);
 }
 
+size_t BVHOptiX::memory_size() const
+{
+  size_t size = 0;
+  if (as_data) {
+    size += as_data->memory_size();
+  }
+  if (motion_transform_data) {
+    size += motion_transform_data->memory_size();
+  }
+  return size;
+}
+
 CCL_NAMESPACE_END
 
 #endif /* WITH_OPTIX */
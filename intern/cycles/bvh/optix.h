@@ -24,6 +24,8 @@ class BVHOptiX : public BVH {
   unique_ptr<device_only_memory<char>> as_data;
   unique_ptr<device_only_memory<char>> motion_transform_data;
 
+  size_t memory_size() const override;
+
  protected:
   friend class BVH;
   BVHOptiX(const BVHParams &params,
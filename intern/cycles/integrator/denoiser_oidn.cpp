@@ -12,6 +12,7 @@
 #include "session/buffers.h"
 #include "util/array.h"
 #include "util/log.h"
+#include "util/map.h"
 #include "util/openimagedenoise.h"
 #include "util/path.h"
 
@@ -36,6 +37,45 @@ OIDNDenoiser::OIDNDenoiser(Device *denoiser_device, const DenoiseParams &params)
 #endif
 }
 
+#ifdef WITH_OPENIMAGEDENOISE
+class OIDNDenoiser::State {
+ public:
+  State()
+  {
+    oidn_device = oidn::newDevice(oidn::DeviceType::CPU);
+    oidn_device.set("setAffinity", false);
+    oidn_device.commit();
+
+    const char *custom_weight_path = getenv("CYCLES_OIDN_CUSTOM_WEIGHTS");
+    if (custom_weight_path) {
+      if (!path_read_binary(custom_weight_path, custom_weights)) {
+        fprintf(stderr, "Cycles: Failed to load custom OIDN weights!");
+      }
+    }
+  }
+
+  /* Get filter for the given configuration of images, creating it when used for the first time.
+   * Committing a filter again with only the image data changed is much cheaper than creating a
+   * new one. */
+  oidn::FilterRef &filter(const string &key)
+  {
+    oidn::FilterRef &oidn_filter = filters[key];
+    if (!oidn_filter) {
+      oidn_filter = oidn_device.newFilter("RT");
+    }
+    return oidn_filter;
+  }
+
+  oidn::DeviceRef oidn_device;
+  map<string, oidn::FilterRef> filters;
+  vector<uint8_t> custom_weights;
+};
+#else
+class OIDNDenoiser::State {};
+#endif
+
+OIDNDenoiser::~OIDNDenoiser() = default;
+
 #ifdef WITH_OPENIMAGEDENOISE
 static bool oidn_progress_monitor_function(void *user_ptr, double /*n*/)
 {
@@ -100,12 +140,14 @@ class OIDNPass {
 class OIDNDenoiseContext {
  public:
   OIDNDenoiseContext(OIDNDenoiser *denoiser,
+                     OIDNDenoiser::State &state,
                      const DenoiseParams &denoise_params,
                      const BufferParams &buffer_params,
                      RenderBuffers *render_buffers,
                      const int num_samples,
                      const bool allow_inplace_modification)
       : denoiser_(denoiser),
+        state_(state),
         denoise_params_(denoise_params),
         buffer_params_(buffer_params),
         render_buffers_(render_buffers),
@@ -120,13 +162,6 @@ class OIDNDenoiseContext {
     if (denoise_params_.use_pass_normal) {
       oidn_normal_pass_ = OIDNPass(buffer_params_, "normal", PASS_DENOISING_NORMAL);
     }
-
-    const char *custom_weight_path = getenv("CYCLES_OIDN_CUSTOM_WEIGHTS");
-    if (custom_weight_path) {
-      if (!path_read_binary(custom_weight_path, custom_weights)) {
-        fprintf(stderr, "Cycles: Failed to load custom OIDN weights!");
-      }
-    }
   }
 
   bool need_denoising() const
@@ -167,21 +202,26 @@ class OIDNDenoiseContext {
 
     OIDNPass oidn_color_access_pass = read_input_pass(oidn_color_pass, oidn_output_pass);
 
-    oidn::DeviceRef oidn_device = oidn::newDevice(oidn::DeviceType::CPU);
-    oidn_device.set("setAffinity", false);
-    oidn_device.commit();
-
-    /* Create a filter for denoising a beauty (color) image using prefiltered auxiliary images too.
-     */
-    oidn::FilterRef oidn_filter = oidn_device.newFilter("RT");
+    oidn::DeviceRef &oidn_device = state_.oidn_device;
+
+    /* Filter for denoising a beauty (color) image using prefiltered auxiliary images too. The
+     * set of images the filter was created with depends on the guiding passes, so filters are
+     * reused only for the same configuration. */
+    const bool use_fake_albedo = oidn_albedo_pass_ && !oidn_color_pass.use_denoising_albedo;
+    const string filter_key = string_printf("%s_%d_%d_%d",
+                                            pass_type_as_string(pass_type).c_str(),
+                                            bool(oidn_albedo_pass_),
+                                            use_fake_albedo,
+                                            bool(oidn_normal_pass_));
+    oidn::FilterRef &oidn_filter = state_.filter(filter_key);
     set_input_pass(oidn_filter, oidn_color_access_pass);
     set_guiding_passes(oidn_filter, oidn_color_pass);
     set_output_pass(oidn_filter, oidn_output_pass);
     oidn_filter.setProgressMonitorFunction(oidn_progress_monitor_function, denoiser_);
     oidn_filter.set("hdr", true);
     oidn_filter.set("srgb", false);
-    if (custom_weights.size()) {
-      oidn_filter.setData("weights", custom_weights.data(), custom_weights.size());
+    if (state_.custom_weights.size()) {
+      oidn_filter.setData("weights", state_.custom_weights.data(), state_.custom_weights.size());
     }
     set_quality(oidn_filter);
 
@@ -192,8 +232,8 @@ class OIDNDenoiseContext {
     }
     oidn_filter.commit();
 
-    filter_guiding_pass_if_needed(oidn_device, oidn_albedo_pass_);
-    filter_guiding_pass_if_needed(oidn_device, oidn_normal_pass_);
+    filter_guiding_pass_if_needed(oidn_albedo_pass_);
+    filter_guiding_pass_if_needed(oidn_normal_pass_);
 
     /* Filter the beauty image. */
     oidn_filter.execute();
@@ -209,7 +249,7 @@ class OIDNDenoiseContext {
   }
 
  protected:
-  void filter_guiding_pass_if_needed(oidn::DeviceRef &oidn_device, OIDNPass &oidn_pass)
+  void filter_guiding_pass_if_needed(OIDNPass &oidn_pass)
   {
     if (denoise_params_.prefilter != DENOISER_PREFILTER_ACCURATE || !oidn_pass ||
         oidn_pass.is_filtered)
@@ -217,7 +257,7 @@ class OIDNDenoiseContext {
       return;
     }
 
-    oidn::FilterRef oidn_filter = oidn_device.newFilter("RT");
+    oidn::FilterRef &oidn_filter = state_.filter(string("prefilter_") + oidn_pass.name);
     set_pass(oidn_filter, oidn_pass);
     set_output_pass(oidn_filter, oidn_pass);
     set_quality(oidn_filter);
@@ -557,6 +597,7 @@ class OIDNDenoiseContext {
   }
 
   OIDNDenoiser *denoiser_ = nullptr;
+  OIDNDenoiser::State &state_;
 
   const DenoiseParams &denoise_params_;
   const BufferParams &buffer_params_;
@@ -565,8 +606,6 @@ class OIDNDenoiseContext {
   bool allow_inplace_modification_ = false;
   int pass_sample_count_ = PASS_UNUSED;
 
-  vector<uint8_t> custom_weights;
-
   /* Optional albedo and normal passes, reused by denoising of different pass types. */
   OIDNPass oidn_albedo_pass_;
   OIDNPass oidn_normal_pass_;
@@ -627,8 +666,17 @@ bool OIDNDenoiser::denoise_buffer(const BufferParams &buffer_params,
   unique_ptr<DeviceQueue> queue = create_device_queue(render_buffers);
   copy_render_buffers_from_device(queue, render_buffers);
 
-  OIDNDenoiseContext context(
-      this, params_, buffer_params, render_buffers, num_samples, allow_inplace_modification);
+  if (!state_) {
+    state_ = make_unique<State>();
+  }
+
+  OIDNDenoiseContext context(this,
+                             *state_,
+                             params_,
+                             buffer_params,
+                             render_buffers,
+                             num_samples,
+                             allow_inplace_modification);
 
   if (context.need_denoising()) {
     context.read_guiding_passes();
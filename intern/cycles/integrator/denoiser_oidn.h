@@ -18,6 +18,7 @@ class OIDNDenoiser : public Denoiser {
   class State;
 
   OIDNDenoiser(Device *denoiser_device, const DenoiseParams &params);
+  ~OIDNDenoiser();
 
   virtual bool denoise_buffer(const BufferParams &buffer_params,
                               RenderBuffers *render_buffers,
@@ -30,6 +31,10 @@ class OIDNDenoiser : public Denoiser {
   /* We only perform one denoising at a time, since OpenImageDenoise itself is multithreaded.
    * Use this mutex whenever images are passed to the OIDN and needs to be denoised. */
   static thread_mutex mutex_;
+
+  /* OpenImageDenoise device and filters, kept alive between denoising calls so that denoising a
+   * sequence of images does not re-create them for every image. */
+  unique_ptr<State> state_;
 };
 
 CCL_NAMESPACE_END
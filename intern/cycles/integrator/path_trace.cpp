@@ -1013,17 +1013,14 @@ static string get_layer_view_name(const RenderBuffers &buffers)
   return result;
 }
 
-void PathTrace::process_full_buffer_from_disk(string_view filename)
+void PathTrace::process_full_buffer_from_disk(string_view filename, const int band_height)
 {
   VLOG_WORK << "Processing full frame buffer file " << filename;
 
   progress_set_status("Reading full buffer from disk");
 
-  RenderBuffers full_frame_buffers(cpu_device_.get());
-
-  DenoiseParams denoise_params;
-  if (!tile_manager_.read_full_buffer_from_disk(filename, &full_frame_buffers, &denoise_params)) {
-    const string error_message = "Error reading tiles from file";
+  const string error_message = "Error reading tiles from file";
+  auto report_read_error = [&]() {
     if (progress_) {
       progress_->set_error(error_message);
       progress_->set_cancel(error_message);
@@ -1031,11 +1028,63 @@ void PathTrace::process_full_buffer_from_disk(string_view filename)
     else {
       LOG(ERROR) << error_message;
     }
+  };
+
+  BufferParams full_params;
+  DenoiseParams denoise_params;
+  if (!tile_manager_.read_full_buffer_params_from_disk(filename, &full_params, &denoise_params)) {
+    report_read_error();
     return;
   }
 
-  const string layer_view_name = get_layer_view_name(full_frame_buffers);
+  if (band_height <= 0 || band_height >= full_params.window_height) {
+    RenderBuffers full_frame_buffers(cpu_device_.get());
+    if (!tile_manager_.read_full_buffer_from_disk(filename, &full_frame_buffers, &denoise_params))
+    {
+      report_read_error();
+      return;
+    }
+
+    process_full_buffer(
+        &full_frame_buffers, denoise_params, get_layer_view_name(full_frame_buffers));
+    return;
+  }
+
+  /* Rows around each band which are only used as denoiser input, to avoid visible seams between
+   * the bands. */
+  const int overlap = denoise_params.use ? TileManager::IMAGE_TILE_SIZE : 0;
+  const int num_bands = divide_up(full_params.window_height, band_height);
+
+  VLOG_WORK << "Processing full frame buffer in " << num_bands << " bands of " << band_height
+            << " rows.";
+
+  for (int band = 0; band < num_bands; band++) {
+    const int y = full_params.window_y + band * band_height;
+    const int height = min(band_height, full_params.window_y + full_params.window_height - y);
+
+    RenderBuffers band_buffers(cpu_device_.get());
+    if (!tile_manager_.read_full_buffer_rows_from_disk(filename, y, height, overlap, &band_buffers))
+    {
+      report_read_error();
+      return;
+    }
+
+    full_frame_state_.window_offset = make_int2(0, y - full_params.window_y);
+
+    process_full_buffer(&band_buffers, denoise_params, get_layer_view_name(band_buffers));
+
+    if (progress_ && progress_->get_cancel()) {
+      break;
+    }
+  }
+
+  full_frame_state_.window_offset = make_int2(0, 0);
+}
 
+void PathTrace::process_full_buffer(RenderBuffers *buffers,
+                                    DenoiseParams denoise_params,
+                                    const string &layer_view_name)
+{
   render_state_.has_denoised_result = false;
 
   if (denoise_params.use) {
@@ -1053,12 +1102,12 @@ void PathTrace::process_full_buffer_from_disk(string_view filename)
     set_denoiser_params(denoise_params);
 
     /* Number of samples doesn't matter too much, since the samples count pass will be used. */
-    denoiser_->denoise_buffer(full_frame_buffers.params, &full_frame_buffers, 0, false);
+    denoiser_->denoise_buffer(buffers->params, buffers, 0, false);
 
     render_state_.has_denoised_result = true;
   }
 
-  full_frame_state_.render_buffers = &full_frame_buffers;
+  full_frame_state_.render_buffers = buffers;
 
   progress_set_status(layer_view_name, "Finishing");
 
@@ -1139,7 +1188,7 @@ int2 PathTrace::get_render_tile_size() const
 int2 PathTrace::get_render_tile_offset() const
 {
   if (full_frame_state_.render_buffers) {
-    return make_int2(0, 0);
+    return full_frame_state_.window_offset;
   }
 
   const Tile &tile = tile_manager_.get_current_tile();
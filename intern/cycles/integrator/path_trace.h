@@ -136,8 +136,12 @@ class PathTrace {
   bool copy_render_tile_from_device();
 
   /* Read given full-frame file from disk, perform needed processing and write it to the software
-   * via the write callback. */
-  void process_full_buffer_from_disk(string_view filename);
+   * via the write callback.
+   *
+   * When the band height is positive and smaller than the frame, the file is processed and
+   * written in horizontal bands of that many rows, so that the full frame never needs to be in
+   * memory. Bands are denoised with extra rows around them to avoid seams. */
+  void process_full_buffer_from_disk(string_view filename, int band_height = 0);
 
   /* Get number of samples in the current big tile render buffers. */
   int get_num_render_tile_samples() const;
@@ -351,9 +355,17 @@ class PathTrace {
    * Used by `ready_to_reset()` to implement logic which feels the most interactive. */
   bool did_draw_after_reset_ = true;
 
+  /* Process full-frame or band buffers read from disk and write them to the software. */
+  void process_full_buffer(RenderBuffers *buffers,
+                           DenoiseParams denoise_params,
+                           const string &layer_view_name);
+
   /* State of the full frame processing and writing to the software. */
   struct {
     RenderBuffers *render_buffers = nullptr;
+
+    /* Offset of the buffer window in the full frame, non-zero when processing in bands. */
+    int2 window_offset = make_int2(0, 0);
   } full_frame_state_;
 };
 
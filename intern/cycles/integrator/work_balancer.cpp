@@ -38,50 +38,70 @@ static double calculate_total_time(const vector<WorkBalanceInfo> &work_balance_i
   return total_time;
 }
 
-/* The balance is based on equalizing time which devices spent performing a task. Assume that
- * average of the observed times is usable for estimating whether more or less work is to be
- * scheduled, and how difference in the work scheduling is needed. */
+static double calculate_max_time(const vector<WorkBalanceInfo> &work_balance_infos)
+{
+  double max_time = 0;
+  for (const WorkBalanceInfo &info : work_balance_infos) {
+    max_time = max(max_time, info.time_spent);
+  }
+  return max_time;
+}
+
+/* The balance is based on the throughput of every device: the fraction of the work it completes
+ * per second. Assuming that the time scales linearly with the amount of work, weights that are
+ * proportional to the throughput make all devices finish at the same time. This converges in a
+ * single step even for devices with very different performance, like a CPU next to several GPUs,
+ * where equalizing the times step by step leaves the faster devices idle for many rebalances.
+ *
+ * The new weights are blended with the previous ones, to not oscillate on noisy timing. */
 
 bool work_balance_do_rebalance(vector<WorkBalanceInfo> &work_balance_infos)
 {
   const int num_infos = work_balance_infos.size();
 
   const double total_time = calculate_total_time(work_balance_infos);
-  const double time_average = total_time / num_infos;
-
-  double total_weight = 0;
-  vector<double> new_weights;
-  new_weights.reserve(num_infos);
+  const double max_time = calculate_max_time(work_balance_infos);
+  if (max_time == 0.0) {
+    return false;
+  }
 
-  /* Equalize the overall average time. This means that we don't make it so every work will perform
-   * amount of work based on the current average, but that after the weights changes the time will
-   * equalize.
-   * Can think of it that if one of the devices is 10% faster than another, then one device needs
-   * to do 5% less of the current work, and another needs to do 5% more. */
-  const double lerp_weight = 1.0 / num_infos;
+  /* All devices wait for the slowest one, so the idle fraction of the total device time is how
+   * much can be gained by rebalancing. Skip small gains, since rebalancing requires copying the
+   * render buffers between the devices. */
+  const double time_average = total_time / num_infos;
+  const double idle_fraction = 1.0 - time_average / max_time;
+  if (idle_fraction < 0.02) {
+    return false;
+  }
 
-  bool has_big_difference = false;
+  double total_throughput = 0;
+  vector<double> throughputs;
+  throughputs.reserve(num_infos);
 
   for (const WorkBalanceInfo &info : work_balance_infos) {
-    const double time_target = mix(info.time_spent, time_average, lerp_weight);
-    const double new_weight = info.weight * time_target / info.time_spent;
-    new_weights.push_back(new_weight);
-    total_weight += new_weight;
-
-    if (std::fabs(1.0 - time_target / time_average) > 0.02) {
-      has_big_difference = true;
-    }
+    /* Devices which did not report time (for example, due to an error) keep their weight, which
+     * is equivalent to assuming average performance. */
+    const double time_spent = (info.time_spent > 0.0) ? info.time_spent : time_average;
+    const double throughput = info.weight / time_spent;
+    throughputs.push_back(throughput);
+    total_throughput += throughput;
   }
 
-  if (!has_big_difference) {
-    return false;
-  }
+  static const double kNewWeightFactor = 0.75;
 
-  const double total_weight_inv = 1.0 / total_weight;
+  const double total_throughput_inv = 1.0 / total_throughput;
+  double total_weight = 0;
   for (int i = 0; i < num_infos; ++i) {
     WorkBalanceInfo &info = work_balance_infos[i];
-    info.weight = new_weights[i] * total_weight_inv;
+    info.weight = mix(info.weight, throughputs[i] * total_throughput_inv, kNewWeightFactor);
     info.time_spent = 0;
+    total_weight += info.weight;
+  }
+
+  /* Compensate for the round-off errors. */
+  const double total_weight_inv = 1.0 / total_weight;
+  for (WorkBalanceInfo &info : work_balance_infos) {
+    info.weight *= total_weight_inv;
   }
 
   return true;
@@ -18,7 +18,14 @@ CCL_NAMESPACE_BEGIN
 
 Attribute::Attribute(
     ustring name, TypeDesc type, AttributeElement element, Geometry *geom, AttributePrimitive prim)
-    : name(name), std(ATTR_STD_NONE), type(type), element(element), flags(0), modified(true)
+    : name(name),
+      std(ATTR_STD_NONE),
+      type(type),
+      element(element),
+      flags(0),
+      modified(true),
+      external_data(NULL),
+      external_size(0)
 {
   /* string and matrix not supported! */
   assert(type == TypeDesc::TypeFloat || type == TypeDesc::TypeColor ||
@@ -47,6 +54,7 @@ Attribute::~Attribute()
 void Attribute::resize(Geometry *geom, AttributePrimitive prim, bool reserve_only)
 {
   if (element != ATTR_ELEMENT_VOXEL) {
+    make_data_mutable();
     if (reserve_only) {
       buffer.reserve(buffer_size(geom, prim));
     }
@@ -59,13 +67,45 @@ void Attribute::resize(Geometry *geom, AttributePrimitive prim, bool reserve_onl
 void Attribute::resize(size_t num_elements)
 {
   if (element != ATTR_ELEMENT_VOXEL) {
+    make_data_mutable();
     buffer.resize(num_elements * data_sizeof(), 0);
   }
 }
 
+void Attribute::set_external_data(const void *data,
+                                  size_t size,
+                                  std::shared_ptr<const void> owner)
+{
+  assert(element != ATTR_ELEMENT_VOXEL);
+  assert(size % data_sizeof() == 0);
+
+  buffer.clear();
+  buffer.shrink_to_fit();
+  external_data = (const char *)data;
+  external_size = size;
+  external_owner = std::move(owner);
+  modified = true;
+}
+
+void Attribute::make_data_mutable()
+{
+  if (external_data == NULL) {
+    return;
+  }
+
+  buffer.resize(external_size);
+  if (external_size) {
+    memcpy(buffer.data(), external_data, external_size);
+  }
+  external_data = NULL;
+  external_size = 0;
+  external_owner.reset();
+}
+
 void Attribute::add(const float &f)
 {
   assert(data_sizeof() == sizeof(float));
+  make_data_mutable();
 
   char *data = (char *)&f;
   size_t size = sizeof(f);
@@ -80,6 +120,7 @@ void Attribute::add(const float &f)
 void Attribute::add(const uchar4 &f)
 {
   assert(data_sizeof() == sizeof(uchar4));
+  make_data_mutable();
 
   char *data = (char *)&f;
   size_t size = sizeof(f);
@@ -94,6 +135,7 @@ void Attribute::add(const uchar4 &f)
 void Attribute::add(const float2 &f)
 {
   assert(data_sizeof() == sizeof(float2));
+  make_data_mutable();
 
   char *data = (char *)&f;
   size_t size = sizeof(f);
@@ -108,6 +150,7 @@ void Attribute::add(const float2 &f)
 void Attribute::add(const float3 &f)
 {
   assert(data_sizeof() == sizeof(float3));
+  make_data_mutable();
 
   char *data = (char *)&f;
   size_t size = sizeof(f);
@@ -122,6 +165,7 @@ void Attribute::add(const float3 &f)
 void Attribute::add(const Transform &f)
 {
   assert(data_sizeof() == sizeof(Transform));
+  make_data_mutable();
 
   char *data = (char *)&f;
   size_t size = sizeof(f);
@@ -136,6 +180,7 @@ void Attribute::add(const Transform &f)
 void Attribute::add(const char *data)
 {
   size_t size = data_sizeof();
+  make_data_mutable();
 
   for (size_t i = 0; i < size; i++) {
     buffer.push_back(data[i]);
@@ -152,14 +197,28 @@ void Attribute::set_data_from(Attribute &&other)
 
   this->flags = other.flags;
 
-  if (this->buffer.size() != other.buffer.size()) {
-    this->buffer = std::move(other.buffer);
+  const Attribute &const_this = *this;
+  const Attribute &const_other = other;
+
+  if (const_this.data_size() != const_other.data_size() ||
+      (const_this.data() != const_other.data() &&
+       memcmp(const_this.data(), const_other.data(), const_other.data_size()) != 0))
+  {
     modified = true;
   }
-  else if (memcmp(this->data(), other.data(), other.buffer.size()) != 0) {
-    this->buffer = std::move(other.buffer);
-    modified = true;
+  else if (const_this.external_data == const_other.external_data) {
+    /* Same data and storage, keep what is there. */
+    return;
   }
+
+  /* Take over the storage even when the data is equal, to release references to external data
+   * that may no longer be needed. */
+  this->buffer = std::move(other.buffer);
+  this->external_data = other.external_data;
+  this->external_size = other.external_size;
+  this->external_owner = std::move(other.external_owner);
+  other.external_data = NULL;
+  other.external_size = 0;
 }
 
 size_t Attribute::data_sizeof() const
@@ -195,7 +254,7 @@ size_t Attribute::data_sizeof() const
 size_t Attribute::element_size(Geometry *geom, AttributePrimitive prim) const
 {
   if (flags & ATTR_FINAL_SIZE) {
-    return buffer.size() / data_sizeof();
+    return data_size() / data_sizeof();
   }
 
   size_t size = 0;
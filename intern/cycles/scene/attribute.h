@@ -5,6 +5,8 @@
 #ifndef __ATTRIBUTE_H__
 #define __ATTRIBUTE_H__
 
+#include <memory>
+
 #include "scene/image.h"
 
 #include "kernel/types.h"
@@ -54,6 +56,13 @@ class Attribute {
 
   bool modified;
 
+  /* Read-only data owned outside of Cycles, referenced instead of copying it into the buffer.
+   * The owner keeps the data alive and unchanged for as long as it is referenced. Write access
+   * to the data first copies it into the buffer. */
+  const char *external_data;
+  size_t external_size;
+  std::shared_ptr<const void> external_owner;
+
   Attribute(ustring name,
             TypeDesc type,
             AttributeElement element,
@@ -72,8 +81,18 @@ class Attribute {
   size_t element_size(Geometry *geom, AttributePrimitive prim) const;
   size_t buffer_size(Geometry *geom, AttributePrimitive prim) const;
 
+  void set_external_data(const void *data, size_t size, std::shared_ptr<const void> owner);
+  void make_data_mutable();
+
+  /* Size of the data in bytes, whether it is stored in the buffer or externally. */
+  size_t data_size() const
+  {
+    return (external_data) ? external_size : buffer.size();
+  }
+
   char *data()
   {
+    make_data_mutable();
     return (buffer.size()) ? &buffer[0] : NULL;
   }
   float2 *data_float2()
@@ -116,6 +135,9 @@ class Attribute {
 
   const char *data() const
   {
+    if (external_data) {
+      return external_data;
+    }
     return (buffer.size()) ? &buffer[0] : NULL;
   }
   const float2 *data_float2() const
@@ -138,6 +160,11 @@ class Attribute {
     assert(data_sizeof() == sizeof(float));
     return (const float *)data();
   }
+  const uchar4 *data_uchar4() const
+  {
+    assert(data_sizeof() == sizeof(uchar4));
+    return (const uchar4 *)data();
+  }
   const Transform *data_transform() const
   {
     assert(data_sizeof() == sizeof(Transform));
@@ -2,6 +2,8 @@
  *
  * SPDX-License-Identifier: Apache-2.0 */
 
+#include <atomic>
+
 #include "bvh/bvh.h"
 #include "bvh/bvh2.h"
 
@@ -784,7 +786,10 @@ void GeometryManager::device_update(Device *device,
                                    dicing_camera->get_full_height());
     dicing_camera->update(scene);
 
-    size_t i = 0;
+    /* Meshes are independent of each other, tessellate them in parallel. */
+    std::atomic<uint> num_tessellated = 0;
+    TaskPool pool;
+
     foreach (Geometry *geom, scene->geometry) {
       if (!(geom->is_modified() && geom->is_mesh())) {
         continue;
@@ -792,29 +797,32 @@ void GeometryManager::device_update(Device *device,
 
       Mesh *mesh = static_cast<Mesh *>(geom);
       if (mesh->need_tesselation()) {
-        string msg = "Tessellating ";
-        if (mesh->name == "") {
-          msg += string_printf("%u/%u", (uint)(i + 1), (uint)total_tess_needed);
-        }
-        else {
-          msg += string_printf(
-              "%s %u/%u", mesh->name.c_str(), (uint)(i + 1), (uint)total_tess_needed);
-        }
+        mesh->subd_params->camera = dicing_camera;
 
-        progress.set_status("Updating Mesh", msg);
+        pool.push([mesh, total_tess_needed, &num_tessellated, &progress]() {
+          if (progress.get_cancel()) {
+            return;
+          }
 
-        mesh->subd_params->camera = dicing_camera;
-        DiagSplit dsplit(*mesh->subd_params);
-        mesh->tessellate(&dsplit);
+          const uint i = num_tessellated++;
+          string msg = "Tessellating ";
+          if (mesh->name == "") {
+            msg += string_printf("%u/%u", i + 1, (uint)total_tess_needed);
+          }
+          else {
+            msg += string_printf("%s %u/%u", mesh->name.c_str(), i + 1, (uint)total_tess_needed);
+          }
 
-        i++;
+          progress.set_status("Updating Mesh", msg);
 
-        if (progress.get_cancel()) {
-          return;
-        }
+          DiagSplit dsplit(*mesh->subd_params);
+          mesh->tessellate(&dsplit);
+        });
       }
     }
 
+    pool.wait_work();
+
     if (progress.get_cancel()) {
       return;
     }
@@ -1119,6 +1127,11 @@ void GeometryManager::collect_statistics(const Scene *scene, RenderStats *stats)
   foreach (Geometry *geometry, scene->geometry) {
     stats->mesh.geometry.add_entry(
         NamedSizeEntry(string(geometry->name.c_str()), geometry->get_total_size_in_bytes()));
+
+    const size_t bvh_size = (geometry->bvh) ? geometry->bvh->memory_size() : 0;
+    if (bvh_size) {
+      stats->mesh.bvh.add_entry(NamedSizeEntry(string(geometry->name.c_str()), bvh_size));
+    }
   }
 }
 
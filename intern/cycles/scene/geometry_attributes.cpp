@@ -301,13 +301,16 @@ void GeometryManager::update_attribute_element_offset(Geometry *geom,
     AttributeElement &element = desc.element;
     int &offset = desc.offset;
 
+    /* Read through a const attribute, to not copy data that is stored externally. */
+    const Attribute *const_attr = mattr;
+
     if (mattr->element == ATTR_ELEMENT_VOXEL) {
       /* store slot in offset value */
       ImageHandle &handle = mattr->data_voxel();
       offset = handle.svm_slot();
     }
     else if (mattr->element == ATTR_ELEMENT_CORNER_BYTE) {
-      uchar4 *data = mattr->data_uchar4();
+      const uchar4 *data = const_attr->data_uchar4();
       offset = attr_uchar4_offset;
 
       assert(attr_uchar4.size() >= offset + size);
@@ -320,7 +323,7 @@ void GeometryManager::update_attribute_element_offset(Geometry *geom,
       attr_uchar4_offset += size;
     }
     else if (mattr->type == TypeDesc::TypeFloat) {
-      float *data = mattr->data_float();
+      const float *data = const_attr->data_float();
       offset = attr_float_offset;
 
       assert(attr_float.size() >= offset + size);
@@ -333,7 +336,7 @@ void GeometryManager::update_attribute_element_offset(Geometry *geom,
       attr_float_offset += size;
     }
     else if (mattr->type == TypeFloat2) {
-      float2 *data = mattr->data_float2();
+      const float2 *data = const_attr->data_float2();
       offset = attr_float2_offset;
 
       assert(attr_float2.size() >= offset + size);
@@ -346,7 +349,7 @@ void GeometryManager::update_attribute_element_offset(Geometry *geom,
       attr_float2_offset += size;
     }
     else if (mattr->type == TypeDesc::TypeMatrix) {
-      Transform *tfm = mattr->data_transform();
+      const Transform *tfm = const_attr->data_transform();
       offset = attr_float4_offset;
 
       assert(attr_float4.size() >= offset + size * 3);
@@ -359,7 +362,7 @@ void GeometryManager::update_attribute_element_offset(Geometry *geom,
       attr_float4_offset += size * 3;
     }
     else if (mattr->type == TypeFloat4 || mattr->type == TypeRGBA) {
-      float4 *data = mattr->data_float4();
+      const float4 *data = const_attr->data_float4();
       offset = attr_float4_offset;
 
       assert(attr_float4.size() >= offset + size);
@@ -372,7 +375,7 @@ void GeometryManager::update_attribute_element_offset(Geometry *geom,
       attr_float4_offset += size;
     }
     else {
-      float3 *data = mattr->data_float3();
+      const float3 *data = const_attr->data_float3();
       offset = attr_float3_offset;
 
       assert(attr_float3.size() >= offset + size);
@@ -71,12 +71,15 @@ void Geometry::compute_bvh(Device *device,
     vector<Object *> objects;
     objects.push_back(&object);
 
-    if (bvh && !need_update_rebuild) {
+    /* Refit while the topology is unchanged, unless earlier refits degraded the BVH too much for
+     * efficient traversal. */
+    if (bvh && !need_update_rebuild && !bvh->refit_degraded()) {
       progress->set_status(msg, "Refitting BVH");
 
       bvh->replace_geometry(geometry, objects);
 
       device->build_bvh(bvh, *progress, true);
+      bvh->num_refits++;
     }
     else {
       progress->set_status(msg, "Building BVH");
@@ -10,6 +10,7 @@
 #include "scene/scene.h"
 #include "scene/stats.h"
 
+#include "util/algorithm.h"
 #include "util/foreach.h"
 #include "util/image.h"
 #include "util/image_impl.h"
@@ -63,6 +64,75 @@ const char *name_from_type(ImageDataType type)
   return "";
 }
 
+/* Images are not scaled below this resolution to fit the texture memory budget. */
+const int TEXTURE_BUDGET_MIN_SIZE = 128;
+
+bool image_type_is_nanovdb(const ImageDataType type)
+{
+  return (type == IMAGE_DATA_TYPE_NANOVDB_FLOAT || type == IMAGE_DATA_TYPE_NANOVDB_FLOAT3 ||
+          type == IMAGE_DATA_TYPE_NANOVDB_FPN || type == IMAGE_DATA_TYPE_NANOVDB_FP16);
+}
+
+/* Same scale factor as used when loading the image with the given resolution limit. */
+float image_scale_factor(const ImageMetaData &metadata, const int texture_limit)
+{
+  const size_t max_size = max(max(metadata.width, metadata.height), metadata.depth);
+  float scale_factor = 1.0f;
+  if (texture_limit > 0 && max_size > texture_limit) {
+    while (max_size * scale_factor > texture_limit) {
+      scale_factor *= 0.5f;
+    }
+  }
+  return scale_factor;
+}
+
+size_t image_scaled_max_size(const ImageMetaData &metadata, const int texture_limit)
+{
+  const size_t max_size = max(max(metadata.width, metadata.height), metadata.depth);
+  return max((size_t)((float)max_size * image_scale_factor(metadata, texture_limit)), (size_t)1);
+}
+
+/* Estimate of the device memory used by the image texture when loaded with the given resolution
+ * limit, before its pixels are loaded. */
+size_t image_texture_memory_size(const ImageMetaData &metadata, const int texture_limit)
+{
+  if (image_type_is_nanovdb(metadata.type)) {
+    return metadata.byte_size;
+  }
+
+  size_t element_size = 0;
+  switch (metadata.type) {
+    case IMAGE_DATA_TYPE_FLOAT4:
+      element_size = sizeof(float) * 4;
+      break;
+    case IMAGE_DATA_TYPE_BYTE4:
+      element_size = sizeof(uchar) * 4;
+      break;
+    case IMAGE_DATA_TYPE_HALF4:
+    case IMAGE_DATA_TYPE_USHORT4:
+      element_size = sizeof(uint16_t) * 4;
+      break;
+    case IMAGE_DATA_TYPE_FLOAT:
+      element_size = sizeof(float);
+      break;
+    case IMAGE_DATA_TYPE_BYTE:
+      element_size = sizeof(uchar);
+      break;
+    case IMAGE_DATA_TYPE_HALF:
+    case IMAGE_DATA_TYPE_USHORT:
+      element_size = sizeof(uint16_t);
+      break;
+    default:
+      return 0;
+  }
+
+  const float scale_factor = image_scale_factor(metadata, texture_limit);
+  const size_t width = max((size_t)((float)metadata.width * scale_factor), (size_t)1);
+  const size_t height = max((size_t)((float)metadata.height * scale_factor), (size_t)1);
+  const size_t depth = max((size_t)((float)metadata.depth * scale_factor), (size_t)1);
+  return width * height * depth * element_size;
+}
+
 }  // namespace
 
 /* Image Handle */
@@ -473,6 +543,7 @@ size_t ImageManager::add_image_slot(ImageLoader *loader,
   img->need_load = !(osl_texture_system && !img->loader->osl_filepath().empty());
   img->builtin = builtin;
   img->users = 1;
+  img->texture_limit = 0;
   img->mem = NULL;
 
   images[slot] = img;
@@ -685,7 +756,9 @@ void ImageManager::device_load_image(Device *device, Scene *scene, size_t slot,
 
   progress->set_status("Updating Images", "Loading " + img->loader->name());
 
-  const int texture_limit = scene->params.texture_limit;
+  /* Limit from the texture memory budget, which is never larger than the scene limit. */
+  const int texture_limit = (img->texture_limit > 0) ? img->texture_limit :
+                                                       scene->params.texture_limit;
 
   load_image_metadata(img);
   ImageDataType type = img->metadata.type;
@@ -851,6 +924,10 @@ void ImageManager::device_update(Device *device, Scene *scene, Progress &progres
     }
   });
 
+  if (scene->params.texture_memory_budget > 0) {
+    device_update_texture_budget(scene);
+  }
+
   TaskPool pool;
   for (size_t slot = 0; slot < images.size(); slot++) {
     Image *img = images[slot];
@@ -868,6 +945,76 @@ void ImageManager::device_update(Device *device, Scene *scene, Progress &progres
   need_update_ = false;
 }
 
+void ImageManager::device_update_texture_budget(Scene *scene)
+{
+  struct BudgetImage {
+    Image *img;
+    int texture_limit;
+    size_t size;
+  };
+
+  /* Images that are used and loaded by us, rather than by OSL on demand. */
+  vector<BudgetImage> budget_images;
+  TaskPool pool;
+  for (Image *img : images) {
+    if (img && img->users > 0 && (img->need_load || img->mem)) {
+      budget_images.push_back({img, scene->params.texture_limit, 0});
+      if (img->need_metadata) {
+        pool.push(function_bind(&ImageManager::load_image_metadata, this, img));
+      }
+    }
+  }
+  pool.wait_work();
+
+  size_t total_size = 0;
+  for (BudgetImage &budget_image : budget_images) {
+    budget_image.size = image_texture_memory_size(budget_image.img->metadata,
+                                                  budget_image.texture_limit);
+    total_size += budget_image.size;
+  }
+
+  /* Halve the resolution of the largest image until all of them fit, similar to dropping the
+   * most detailed mip level of the largest texture first. Images that can't be scaled down any
+   * further are moved out of the heap. */
+  const size_t budget = scene->params.texture_memory_budget;
+  const auto compare = [](const BudgetImage &a, const BudgetImage &b) { return a.size < b.size; };
+  auto heap_end = budget_images.end();
+  std::make_heap(budget_images.begin(), heap_end, compare);
+
+  while (total_size > budget && heap_end != budget_images.begin()) {
+    std::pop_heap(budget_images.begin(), heap_end, compare);
+    BudgetImage &budget_image = *(heap_end - 1);
+    const ImageMetaData &metadata = budget_image.img->metadata;
+
+    const size_t max_size = image_scaled_max_size(metadata, budget_image.texture_limit);
+    if (image_type_is_nanovdb(metadata.type) || max_size <= TEXTURE_BUDGET_MIN_SIZE) {
+      --heap_end;
+      continue;
+    }
+
+    total_size -= budget_image.size;
+    budget_image.texture_limit = max_size / 2;
+    budget_image.size = image_texture_memory_size(metadata, budget_image.texture_limit);
+    total_size += budget_image.size;
+    std::push_heap(budget_images.begin(), heap_end, compare);
+  }
+
+  VLOG_INFO << "Estimated image texture memory " << string_human_readable_size(total_size)
+            << " with a budget of " << string_human_readable_size(budget) << ".";
+
+  for (const BudgetImage &budget_image : budget_images) {
+    Image *img = budget_image.img;
+    const int texture_limit = (budget_image.texture_limit == scene->params.texture_limit) ?
+                                  0 :
+                                  budget_image.texture_limit;
+    if (img->texture_limit != texture_limit) {
+      /* Reload images that were already loaded at a different resolution. */
+      img->texture_limit = texture_limit;
+      img->need_load = true;
+    }
+  }
+}
+
 void ImageManager::device_update_slot(Device *device,
                                       Scene *scene,
                                       size_t slot,
@@ -210,6 +210,9 @@ class ImageManager {
 
     int users;
     thread_mutex mutex;
+
+    /* Resolution limit to fit the texture memory budget, 0 to use the scene limit. */
+    int texture_limit;
   };
 
  private:
@@ -233,6 +236,7 @@ class ImageManager {
   template<TypeDesc::BASETYPE FileFormat, typename StorageType>
   bool file_load_image(Image *img, int texture_limit);
 
+  void device_update_texture_budget(Scene *scene);
   void device_load_image(Device *device, Scene *scene, size_t slot, Progress *progress);
   void device_free_image(Device *device, size_t slot);
 
@@ -7,6 +7,7 @@
 #include "scene/object.h"
 
 #include "util/progress.h"
+#include "util/tbb.h"
 
 CCL_NAMESPACE_BEGIN
 
@@ -266,10 +267,34 @@ bool LightTree::triangle_usable_as_light(Mesh *mesh, int prim_id)
 void LightTree::add_mesh(Scene *scene, Mesh *mesh, int object_id)
 {
   size_t mesh_num_triangles = mesh->num_triangles();
-  for (size_t i = 0; i < mesh_num_triangles; i++) {
-    if (triangle_usable_as_light(mesh, i)) {
-      emitters_.emplace_back(scene, i, object_id);
+  if (mesh_num_triangles <= MIN_EMITTERS_PER_THREAD) {
+    for (size_t i = 0; i < mesh_num_triangles; i++) {
+      if (triangle_usable_as_light(mesh, i)) {
+        emitters_.emplace_back(scene, i, object_id);
+      }
+    }
+    return;
+  }
+
+  /* Computing the measure of every triangle is the most expensive part of building the tree for
+   * large emissive meshes, so create the emitters in parallel. Every chunk fills its own array,
+   * which are then appended in order to keep the result independent of the thread scheduling. */
+  const size_t num_chunks = divide_up(mesh_num_triangles, MIN_EMITTERS_PER_THREAD);
+  vector<vector<LightTreeEmitter>> chunk_emitters(num_chunks);
+  parallel_for(size_t(0), num_chunks, [&](const size_t chunk) {
+    const size_t chunk_start = chunk * MIN_EMITTERS_PER_THREAD;
+    const size_t chunk_end = min(chunk_start + MIN_EMITTERS_PER_THREAD, mesh_num_triangles);
+    vector<LightTreeEmitter> &emitters = chunk_emitters[chunk];
+    emitters.reserve(chunk_end - chunk_start);
+    for (size_t i = chunk_start; i < chunk_end; i++) {
+      if (triangle_usable_as_light(mesh, i)) {
+        emitters.emplace_back(scene, i, object_id);
+      }
     }
+  });
+
+  for (vector<LightTreeEmitter> &emitters : chunk_emitters) {
+    std::move(emitters.begin(), emitters.end(), std::back_inserter(emitters_));
   }
 }
 
@@ -510,6 +535,85 @@ void LightTree::recursive_build(const Child child,
   }
 }
 
+/* Ranges of emitters larger than this are binned in parallel chunks of this size. The chunk size
+ * does not depend on the number of threads so that the result is deterministic. */
+static constexpr int LIGHT_TREE_BIN_CHUNK_SIZE = 16384;
+
+static BoundBox compute_centroid_bbox(const LightTreeEmitter *emitters,
+                                      const int start,
+                                      const int end)
+{
+  auto grow_range = [emitters](const int range_start, const int range_end) {
+    BoundBox bbox = BoundBox::empty;
+    for (int i = range_start; i < range_end; i++) {
+      bbox.grow(emitters[i].centroid);
+    }
+    return bbox;
+  };
+
+  if (end - start <= LIGHT_TREE_BIN_CHUNK_SIZE) {
+    return grow_range(start, end);
+  }
+
+  const int num_chunks = divide_up(end - start, LIGHT_TREE_BIN_CHUNK_SIZE);
+  vector<BoundBox> chunk_bbox(num_chunks);
+  parallel_for(0, num_chunks, [&](const int chunk) {
+    const int chunk_start = start + chunk * LIGHT_TREE_BIN_CHUNK_SIZE;
+    chunk_bbox[chunk] = grow_range(chunk_start, min(chunk_start + LIGHT_TREE_BIN_CHUNK_SIZE, end));
+  });
+
+  BoundBox centroid_bbox = BoundBox::empty;
+  for (const BoundBox &bbox : chunk_bbox) {
+    centroid_bbox.grow(bbox);
+  }
+  return centroid_bbox;
+}
+
+static LightTreeBuckets fill_buckets(const LightTreeEmitter *emitters,
+                                     const int start,
+                                     const int end,
+                                     const int dim,
+                                     const float centroid_min,
+                                     const float inv_extent)
+{
+  auto fill_range = [=](const int range_start, const int range_end) {
+    LightTreeBuckets buckets;
+    for (int i = range_start; i < range_end; i++) {
+      const LightTreeEmitter *emitter = emitters + i;
+
+      /* Place emitter into the appropriate bucket, where the centroid box is split into equal
+       * partitions. */
+      int bucket_idx = LightTreeBucket::num_buckets * (emitter->centroid[dim] - centroid_min) *
+                       inv_extent;
+      bucket_idx = clamp(bucket_idx, 0, LightTreeBucket::num_buckets - 1);
+
+      buckets[bucket_idx].add(*emitter);
+    }
+    return buckets;
+  };
+
+  if (end - start <= LIGHT_TREE_BIN_CHUNK_SIZE) {
+    return fill_range(start, end);
+  }
+
+  const int num_chunks = divide_up(end - start, LIGHT_TREE_BIN_CHUNK_SIZE);
+  vector<LightTreeBuckets> chunk_buckets(num_chunks);
+  parallel_for(0, num_chunks, [&](const int chunk) {
+    const int chunk_start = start + chunk * LIGHT_TREE_BIN_CHUNK_SIZE;
+    chunk_buckets[chunk] = fill_range(chunk_start,
+                                      min(chunk_start + LIGHT_TREE_BIN_CHUNK_SIZE, end));
+  });
+
+  /* Merge in chunk order, so the floating point sums do not depend on the thread scheduling. */
+  LightTreeBuckets buckets = chunk_buckets.front();
+  for (int chunk = 1; chunk < num_chunks; chunk++) {
+    for (int i = 0; i < LightTreeBucket::num_buckets; i++) {
+      buckets[i] = buckets[i] + chunk_buckets[chunk][i];
+    }
+  }
+  return buckets;
+}
+
 bool LightTree::should_split(LightTreeEmitter *emitters,
                              const int start,
                              int &middle,
@@ -530,10 +634,7 @@ bool LightTree::should_split(LightTreeEmitter *emitters,
 
   middle = (start + end) / 2;
 
-  BoundBox centroid_bbox = BoundBox::empty;
-  for (int i = start; i < end; i++) {
-    centroid_bbox.grow((emitters + i)->centroid);
-  }
+  const BoundBox centroid_bbox = compute_centroid_bbox(emitters, start, end);
 
   const float3 extent = centroid_bbox.size();
   const float max_extent = max4(extent.x, extent.y, extent.z, 0.0f);
@@ -551,18 +652,8 @@ bool LightTree::should_split(LightTreeEmitter *emitters,
     const float inv_extent = 1 / (centroid_bbox.size()[dim]);
 
     /* Fill in buckets with emitters. */
-    std::array<LightTreeBucket, LightTreeBucket::num_buckets> buckets;
-    for (int i = start; i < end; i++) {
-      const LightTreeEmitter *emitter = emitters + i;
-
-      /* Place emitter into the appropriate bucket, where the centroid box is split into equal
-       * partitions. */
-      int bucket_idx = LightTreeBucket::num_buckets *
-                       (emitter->centroid[dim] - centroid_bbox.min[dim]) * inv_extent;
-      bucket_idx = clamp(bucket_idx, 0, LightTreeBucket::num_buckets - 1);
-
-      buckets[bucket_idx].add(*emitter);
-    }
+    const LightTreeBuckets buckets = fill_buckets(
+        emitters, start, end, dim, centroid_bbox.min[dim], inv_extent);
 
     /* Precompute the left bucket measure cumulatively. */
     std::array<LightTreeBucket, LightTreeBucket::num_buckets - 1> left_buckets;
@@ -13,6 +13,7 @@
 #include "util/types.h"
 #include "util/vector.h"
 
+#include <array>
 #include <variant>
 
 CCL_NAMESPACE_BEGIN
@@ -237,6 +238,8 @@ struct LightTreeBucket {
 
 LightTreeBucket operator+(const LightTreeBucket &a, const LightTreeBucket &b);
 
+using LightTreeBuckets = std::array<LightTreeBucket, LightTreeBucket::num_buckets>;
+
 /* Light Tree Node */
 struct LightTreeNode {
   LightTreeMeasure measure;
@@ -71,6 +71,8 @@ class SceneParams {
   int hair_subdivisions;
   CurveShapeType hair_shape;
   int texture_limit;
+  /* Estimated image texture memory in bytes that images are scaled down to fit, 0 for none. */
+  size_t texture_memory_budget;
 
   bool background;
 
@@ -86,6 +88,7 @@ class SceneParams {
     hair_subdivisions = 3;
     hair_shape = CURVE_RIBBON;
     texture_limit = 0;
+    texture_memory_budget = 0;
     background = true;
   }
 
@@ -98,7 +101,8 @@ class SceneParams {
              use_bvh_unaligned_nodes == params.use_bvh_unaligned_nodes &&
              num_bvh_time_steps == params.num_bvh_time_steps &&
              hair_subdivisions == params.hair_subdivisions && hair_shape == params.hair_shape &&
-             texture_limit == params.texture_limit);
+             texture_limit == params.texture_limit &&
+             texture_memory_budget == params.texture_memory_budget);
   }
 
   int curve_subdivisions()
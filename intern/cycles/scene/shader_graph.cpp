@@ -746,6 +746,23 @@ void ShaderGraph::break_cycles(ShaderNode *node, vector<bool> &visited, vector<b
   on_stack[node->id] = false;
 }
 
+static void shader_node_hash(MD5Hash &md5, ShaderNode *node)
+{
+  node->hash(md5);
+  foreach (ShaderInput *input, node->inputs) {
+    int link_id = (input->link) ? input->link->parent->id : 0;
+    md5.append((uint8_t *)&link_id, sizeof(link_id));
+    md5.append((input->link) ? input->link->name().c_str() : "");
+  }
+
+  if (node->special_type == SHADER_SPECIAL_TYPE_OSL) {
+    /* Hash takes into account socket values, to detect changes
+     * in the code of the node we need an exception. */
+    OSLNode *oslnode = static_cast<OSLNode *>(node);
+    md5.append(oslnode->bytecode_hash);
+  }
+}
+
 void ShaderGraph::compute_displacement_hash()
 {
   /* Compute hash of all nodes linked to displacement, to detect if we need
@@ -762,22 +779,26 @@ void ShaderGraph::compute_displacement_hash()
 
   MD5Hash md5;
   foreach (ShaderNode *node, nodes_displace) {
-    node->hash(md5);
-    foreach (ShaderInput *input, node->inputs) {
-      int link_id = (input->link) ? input->link->parent->id : 0;
-      md5.append((uint8_t *)&link_id, sizeof(link_id));
-      md5.append((input->link) ? input->link->name().c_str() : "");
-    }
+    shader_node_hash(md5, node);
+  }
 
-    if (node->special_type == SHADER_SPECIAL_TYPE_OSL) {
-      /* Hash takes into account socket values, to detect changes
-       * in the code of the node we need an exception. */
-      OSLNode *oslnode = static_cast<OSLNode *>(node);
-      md5.append(oslnode->bytecode_hash);
+  displacement_hash = md5.get_hex();
+}
+
+void ShaderGraph::compute_hash()
+{
+  /* Compute hash of the entire graph, used to reuse the compiled shader when a graph with the
+   * same nodes is compiled again. Must be done before finalizing, as that modifies the graph. */
+  MD5Hash md5;
+  foreach (ShaderNode *node, nodes) {
+    if (node->has_scene_dependency()) {
+      hash = "";
+      return;
     }
+    shader_node_hash(md5, node);
   }
 
-  displacement_hash = md5.get_hex();
+  hash = md5.get_hex();
 }
 
 void ShaderGraph::clean(Scene *scene)
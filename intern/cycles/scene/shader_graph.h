@@ -208,6 +208,12 @@ class ShaderNode : public Node {
   {
     return false;
   }
+  /* Compiling the node depends on scene state outside of the graph, like image slots or film
+   * passes, so its compiled program can not be reused for another graph with the same hash. */
+  virtual bool has_scene_dependency()
+  {
+    return false;
+  }
   vector<ShaderInput *> inputs;
   vector<ShaderOutput *> outputs;
 
@@ -298,6 +304,9 @@ class ShaderGraph : public NodeOwner {
   bool finalized;
   bool simplified;
   string displacement_hash;
+  /* Hash of the nodes and links before finalizing, empty when it was not computed or when the
+   * graph has nodes with a scene dependency. */
+  string hash;
 
   ShaderGraph();
   ~ShaderGraph();
@@ -314,6 +323,7 @@ class ShaderGraph : public NodeOwner {
 
   void remove_proxy_nodes();
   void compute_displacement_hash();
+  void compute_hash();
   void simplify(Scene *scene);
   void finalize(Scene *scene, bool do_bump = false, bool bump_in_object_space = false);
 
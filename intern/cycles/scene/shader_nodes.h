@@ -83,6 +83,11 @@ class ImageSlotTextureNode : public TextureNode {
     return TextureNode::equals(other) && handle == other_node.handle;
   }
 
+  bool has_scene_dependency()
+  {
+    return true;
+  }
+
   ImageHandle handle;
 };
 
@@ -170,6 +175,11 @@ class SkyTextureNode : public TextureNode {
 
   void simplify_settings(Scene *scene);
 
+  bool has_scene_dependency()
+  {
+    return true;
+  }
+
   float get_sun_size()
   {
     /* Clamping for numerical precision. */
@@ -211,6 +221,11 @@ class OutputAOVNode : public ShaderNode {
     return false;
   }
 
+  bool has_scene_dependency()
+  {
+    return true;
+  }
+
   int offset;
   bool is_color;
 };
@@ -361,6 +376,11 @@ class PointDensityTextureNode : public ShaderNode {
     return true;
   }
 
+  bool has_scene_dependency()
+  {
+    return true;
+  }
+
   /* Parameters. */
   NODE_SOCKET_API(ustring, filename)
   NODE_SOCKET_API(NodeTexVoxelSpace, space)
@@ -387,6 +407,11 @@ class IESLightNode : public TextureNode {
   ~IESLightNode();
   ShaderNode *clone(ShaderGraph *graph) const;
 
+  bool has_scene_dependency()
+  {
+    return true;
+  }
+
   NODE_SOCKET_API(ustring, filename)
   NODE_SOCKET_API(ustring, ies)
 
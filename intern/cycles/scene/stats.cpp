@@ -39,6 +39,37 @@ bool namedSampleCountPairComparator(const NamedSampleCountPair &a, const NamedSa
   return a.samples > b.samples;
 }
 
+/* Quote and escape string for use in a JSON document. */
+string json_string(const string &str)
+{
+  string result = "\"";
+  for (const char c : str) {
+    switch (c) {
+      case '"':
+        result += "\\\"";
+        break;
+      case '\\':
+        result += "\\\\";
+        break;
+      case '\n':
+        result += "\\n";
+        break;
+      case '\t':
+        result += "\\t";
+        break;
+      default:
+        if (static_cast<unsigned char>(c) < 0x20) {
+          result += string_printf("\\u%04x", c);
+        }
+        else {
+          result += c;
+        }
+        break;
+    }
+  }
+  return result + "\"";
+}
+
 }  // namespace
 
 NamedSizeEntry::NamedSizeEntry() : name(""), size(0) {}
@@ -79,6 +110,19 @@ string NamedSizeStats::full_report(int indent_level)
   return result;
 }
 
+string NamedSizeStats::json_report()
+{
+  string result = string_printf("{\"total_size\": %llu, \"entries\": [",
+                                (unsigned long long)total_size);
+  for (size_t i = 0; i < entries.size(); i++) {
+    result += string_printf("%s{\"name\": %s, \"size\": %llu}",
+                            (i == 0) ? "" : ", ",
+                            json_string(entries[i].name).c_str(),
+                            (unsigned long long)entries[i].size);
+  }
+  return result + "]}";
+}
+
 string NamedTimeStats::full_report(int indent_level)
 {
   const string indent(indent_level * kIndentNumSpaces, ' ');
@@ -93,6 +137,18 @@ string NamedTimeStats::full_report(int indent_level)
   return result;
 }
 
+string NamedTimeStats::json_report()
+{
+  string result = string_printf("{\"total_time\": %f, \"entries\": [", total_time);
+  for (size_t i = 0; i < entries.size(); i++) {
+    result += string_printf("%s{\"name\": %s, \"time\": %f}",
+                            (i == 0) ? "" : ", ",
+                            json_string(entries[i].name).c_str(),
+                            entries[i].time);
+  }
+  return result + "]}";
+}
+
 /* Named time sample statistics. */
 
 NamedNestedSampleStats::NamedNestedSampleStats() : name(""), self_samples(0), sum_samples(0) {}
@@ -146,6 +202,21 @@ string NamedNestedSampleStats::full_report(int indent_level, uint64_t total_samp
   return result;
 }
 
+string NamedNestedSampleStats::json_report()
+{
+  update_sum();
+
+  string result = string_printf("{\"name\": %s, \"total_time\": %f, \"self_time\": %f",
+                                json_string(name).c_str(),
+                                sum_samples * 0.001,
+                                self_samples * 0.001);
+  result += ", \"entries\": [";
+  for (size_t i = 0; i < entries.size(); i++) {
+    result += ((i == 0) ? "" : ", ") + entries[i].json_report();
+  }
+  return result + "]}";
+}
+
 /* Named sample count pairs. */
 
 NamedSampleCountPair::NamedSampleCountPair(const ustring &name, uint64_t samples, uint64_t hits)
@@ -198,6 +269,22 @@ string NamedSampleCountStats::full_report(int indent_level)
   return result;
 }
 
+string NamedSampleCountStats::json_report()
+{
+  string result = "[";
+  bool first = true;
+  foreach (entry_map::const_reference entry, entries) {
+    const NamedSampleCountPair &pair = entry.second;
+    result += string_printf("%s{\"name\": %s, \"time\": %f, \"hits\": %llu}",
+                            first ? "" : ", ",
+                            json_string(pair.name.string()).c_str(),
+                            pair.samples * 0.001,
+                            (unsigned long long)pair.hits);
+    first = false;
+  }
+  return result + "]";
+}
+
 /* Mesh statistics. */
 
 MeshStats::MeshStats() {}
@@ -207,6 +294,9 @@ string MeshStats::full_report(int indent_level)
   const string indent(indent_level * kIndentNumSpaces, ' ');
   string result = "";
   result += indent + "Geometry:\n" + geometry.full_report(indent_level + 1);
+  if (bvh.total_size) {
+    result += indent + "BVH:\n" + bvh.full_report(indent_level + 1);
+  }
   return result;
 }
 
@@ -227,6 +317,8 @@ string ImageStats::full_report(int indent_level)
 RenderStats::RenderStats()
 {
   has_profiling = false;
+  render_time = 0.0;
+  num_pixel_samples = 0;
 }
 
 void RenderStats::collect_profiling(Scene *scene, Profiler &prof)
@@ -298,6 +390,28 @@ string RenderStats::full_report()
   return result;
 }
 
+string RenderStats::json_report(SceneUpdateStats *update_stats)
+{
+  const double samples_per_second = (render_time > 0.0) ? num_pixel_samples / render_time : 0.0;
+
+  string result = "{";
+  result += string_printf("\"render_time\": %f, ", render_time);
+  result += string_printf("\"pixel_samples\": %llu, ", (unsigned long long)num_pixel_samples);
+  result += string_printf("\"pixel_samples_per_second\": %f, ", samples_per_second);
+  result += "\"geometry\": " + mesh.geometry.json_report() + ", ";
+  result += "\"bvh\": " + mesh.bvh.json_report() + ", ";
+  result += "\"textures\": " + image.textures.json_report();
+  if (has_profiling) {
+    result += ", \"kernel\": " + kernel.json_report();
+    result += ", \"shaders\": " + shaders.json_report();
+    result += ", \"objects\": " + objects.json_report();
+  }
+  if (update_stats) {
+    result += ", \"update_times\": " + update_stats->json_report();
+  }
+  return result + "}";
+}
+
 NamedTimeStats::NamedTimeStats() : total_time(0.0) {}
 
 string UpdateTimeStats::full_report(int indent_level)
@@ -328,6 +442,27 @@ string SceneUpdateStats::full_report()
   return result;
 }
 
+string SceneUpdateStats::json_report()
+{
+  string result = "{";
+  result += "\"scene\": " + scene.times.json_report();
+  result += ", \"geometry\": " + geometry.times.json_report();
+  result += ", \"light\": " + light.times.json_report();
+  result += ", \"object\": " + object.times.json_report();
+  result += ", \"image\": " + image.times.json_report();
+  result += ", \"background\": " + background.times.json_report();
+  result += ", \"bake\": " + bake.times.json_report();
+  result += ", \"camera\": " + camera.times.json_report();
+  result += ", \"film\": " + film.times.json_report();
+  result += ", \"integrator\": " + integrator.times.json_report();
+  result += ", \"osl\": " + osl.times.json_report();
+  result += ", \"particles\": " + particles.times.json_report();
+  result += ", \"svm\": " + svm.times.json_report();
+  result += ", \"tables\": " + tables.times.json_report();
+  result += ", \"procedurals\": " + procedurals.times.json_report();
+  return result + "}";
+}
+
 void SceneUpdateStats::clear()
 {
   geometry.times.clear();
@@ -13,6 +13,8 @@
 
 CCL_NAMESPACE_BEGIN
 
+class SceneUpdateStats;
+
 /* Named statistics entry, which corresponds to a size. There is no real
  * semantic around the units of size, it just should be the same for all
  * entries.
@@ -52,6 +54,9 @@ class NamedSizeStats {
   /* Generate full human-readable report. */
   string full_report(int indent_level = 0);
 
+  /* Generate report as JSON object. */
+  string json_report();
+
   /* Total size of all entries. */
   size_t total_size;
 
@@ -75,6 +80,9 @@ class NamedTimeStats {
   /* Generate full human-readable report. */
   string full_report(int indent_level = 0);
 
+  /* Generate report as JSON object. */
+  string json_report();
+
   /* Total time of all entries. */
   double total_time;
 
@@ -102,6 +110,9 @@ class NamedNestedSampleStats {
 
   string full_report(int indent_level = 0, uint64_t total_samples = 0);
 
+  /* Generate report as JSON object, with times in seconds. */
+  string json_report();
+
   string name;
 
   /* self_samples contains only the samples that this specific event got,
@@ -131,6 +142,9 @@ class NamedSampleCountStats {
   string full_report(int indent_level = 0);
   void add(const ustring &name, uint64_t samples, uint64_t hits);
 
+  /* Generate report as JSON array, with times in seconds. */
+  string json_report();
+
   typedef unordered_map<ustring, NamedSampleCountPair, ustringHash> entry_map;
   entry_map entries;
 };
@@ -148,6 +162,10 @@ class MeshStats {
    * memory like BVH.
    */
   NamedSizeStats geometry;
+
+  /* Memory of the acceleration structures of each geometry, for the BVH layouts which can
+   * report it. */
+  NamedSizeStats bvh;
 };
 
 /* Statistics about images held in memory. */
@@ -169,11 +187,19 @@ class RenderStats {
   /* Return full report as string. */
   string full_report();
 
+  /* Return all statistics as a JSON object, for automated processing like farm monitoring.
+   * Scene update times are included when given. */
+  string json_report(SceneUpdateStats *update_stats = nullptr);
+
   /* Collect kernel sampling information from Stats. */
   void collect_profiling(Scene *scene, Profiler &prof);
 
   bool has_profiling;
 
+  /* Time spent on rendering, and the number of pixel samples rendered in that time. */
+  double render_time;
+  uint64_t num_pixel_samples;
+
   MeshStats mesh;
   ImageStats image;
   NamedNestedSampleStats kernel;
@@ -211,6 +237,9 @@ class SceneUpdateStats {
 
   string full_report();
 
+  /* Generate report as JSON object. */
+  string json_report();
+
   void clear();
 };
 
@@ -16,6 +16,7 @@
 
 #include "util/foreach.h"
 #include "util/log.h"
+#include "util/md5.h"
 #include "util/progress.h"
 #include "util/task.h"
 
@@ -29,6 +30,69 @@ SVMShaderManager::~SVMShaderManager() {}
 
 void SVMShaderManager::reset(Scene * /*scene*/) {}
 
+void SVMShaderManager::CompiledShader::store(const Shader *shader, const array<int4> &nodes)
+{
+  svm_nodes = nodes;
+
+  has_surface = shader->has_surface;
+  has_surface_transparent = shader->has_surface_transparent;
+  has_surface_raytrace = shader->has_surface_raytrace;
+  has_surface_bssrdf = shader->has_surface_bssrdf;
+  has_bump = shader->has_bump;
+  has_bssrdf_bump = shader->has_bssrdf_bump;
+  has_volume = shader->has_volume;
+  has_displacement = shader->has_displacement;
+  has_surface_spatial_varying = shader->has_surface_spatial_varying;
+  has_volume_spatial_varying = shader->has_volume_spatial_varying;
+  has_volume_attribute_dependency = shader->has_volume_attribute_dependency;
+
+  emission_estimate = shader->emission_estimate;
+  emission_sampling = shader->emission_sampling;
+  emission_is_constant = shader->emission_is_constant;
+}
+
+void SVMShaderManager::CompiledShader::restore(Shader *shader, array<int4> &nodes) const
+{
+  nodes = svm_nodes;
+
+  shader->has_surface = has_surface;
+  shader->has_surface_transparent = has_surface_transparent;
+  shader->has_surface_raytrace = has_surface_raytrace;
+  shader->has_surface_bssrdf = has_surface_bssrdf;
+  shader->has_bump = has_bump;
+  shader->has_bssrdf_bump = has_bssrdf_bump;
+  shader->has_volume = has_volume;
+  shader->has_displacement = has_displacement;
+  shader->has_surface_spatial_varying = has_surface_spatial_varying;
+  shader->has_volume_spatial_varying = has_volume_spatial_varying;
+  shader->has_volume_attribute_dependency = has_volume_attribute_dependency;
+
+  shader->emission_estimate = emission_estimate;
+  shader->emission_sampling = emission_sampling;
+  shader->emission_is_constant = emission_is_constant;
+}
+
+string SVMShaderManager::compiled_shader_key(Shader *shader, const bool background)
+{
+  ShaderGraph *graph = shader->graph;
+
+  /* The graph hash is computed before finalizing, a finalized graph keeps the hash it had when
+   * it was compiled. Graphs finalized elsewhere have no hash and are always compiled. */
+  if (!graph->finalized) {
+    graph->compute_hash();
+  }
+  if (graph->hash.empty()) {
+    return "";
+  }
+
+  /* Shader settings like the displacement method affect the compiled program too. */
+  MD5Hash md5;
+  md5.append(graph->hash);
+  shader->hash(md5);
+  md5.append((const uint8_t *)&background, sizeof(background));
+  return md5.get_hex();
+}
+
 void SVMShaderManager::device_update_shader(Scene *scene,
                                             Shader *shader,
                                             Progress *progress,
@@ -39,14 +103,41 @@ void SVMShaderManager::device_update_shader(Scene *scene,
   }
   assert(shader->graph);
 
+  const bool background = (shader == scene->background->get_shader(scene));
+  const string key = compiled_shader_key(shader, background);
+
+  /* Reuse the program of a shader with the same graph and settings, either from a previous
+   * update or compiled by another shader in this update. */
+  if (!key.empty()) {
+    thread_scoped_lock lock(compiled_shaders_mutex_);
+    auto it = used_compiled_shaders_.find(key);
+    if (it == used_compiled_shaders_.end()) {
+      auto prev_it = compiled_shaders_.find(key);
+      if (prev_it != compiled_shaders_.end()) {
+        it = used_compiled_shaders_.emplace(key, std::move(prev_it->second)).first;
+        compiled_shaders_.erase(prev_it);
+      }
+    }
+    if (it != used_compiled_shaders_.end()) {
+      it->second.restore(shader, *svm_nodes);
+      VLOG_WORK << "Reused compiled shader " << shader->name;
+      return;
+    }
+  }
+
   SVMCompiler::Summary summary;
   SVMCompiler compiler(scene);
-  compiler.background = (shader == scene->background->get_shader(scene));
+  compiler.background = background;
   compiler.compile(shader, *svm_nodes, 0, &summary);
 
   VLOG_WORK << "Compilation summary:\n"
             << "Shader name: " << shader->name << "\n"
             << summary.full_report();
+
+  if (!key.empty()) {
+    thread_scoped_lock lock(compiled_shaders_mutex_);
+    used_compiled_shaders_[key].store(shader, *svm_nodes);
+  }
 }
 
 void SVMShaderManager::device_update_specific(Device *device,
@@ -86,6 +177,10 @@ void SVMShaderManager::device_update_specific(Device *device,
   }
   task_pool.wait_work();
 
+  /* Keep only the programs used by the current shaders for the next update. */
+  compiled_shaders_.swap(used_compiled_shaders_);
+  used_compiled_shaders_.clear();
+
   if (progress.get_cancel()) {
     return;
   }
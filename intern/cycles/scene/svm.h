@@ -10,6 +10,7 @@
 #include "scene/shader_graph.h"
 
 #include "util/array.h"
+#include "util/map.h"
 #include "util/set.h"
 #include "util/string.h"
 #include "util/thread.h"
@@ -45,6 +46,40 @@ class SVMShaderManager : public ShaderManager {
                             Shader *shader,
                             Progress *progress,
                             array<int4> *svm_nodes);
+
+  /* Compiled program of a shader, along with the shader properties that are computed while
+   * compiling, so they can be restored when the program is reused. */
+  struct CompiledShader {
+    array<int4> svm_nodes;
+
+    bool has_surface;
+    bool has_surface_transparent;
+    bool has_surface_raytrace;
+    bool has_surface_bssrdf;
+    bool has_bump;
+    bool has_bssrdf_bump;
+    bool has_volume;
+    bool has_displacement;
+    bool has_surface_spatial_varying;
+    bool has_volume_spatial_varying;
+    bool has_volume_attribute_dependency;
+
+    float3 emission_estimate;
+    EmissionSampling emission_sampling;
+    bool emission_is_constant;
+
+    void store(const Shader *shader, const array<int4> &nodes);
+    void restore(Shader *shader, array<int4> &nodes) const;
+  };
+
+  /* Key of the compiled shader cache, empty if the shader can not be cached. */
+  string compiled_shader_key(Shader *shader, bool background);
+
+  /* Programs compiled in the previous update, and the ones used by the current update. Only the
+   * programs used by the last update are kept, which bounds the cache to the scene shaders. */
+  unordered_map<string, CompiledShader> compiled_shaders_;
+  unordered_map<string, CompiledShader> used_compiled_shaders_;
+  thread_mutex compiled_shaders_mutex_;
 };
 
 /* Graph Compiler */
@@ -183,9 +183,8 @@ bool DenoiseTask::load_input_pixels(int layer)
   image.read_pixels(image_layer, buffers.params, buffer_data);
 
   /* Load previous image */
-  if (frame > 0 && !image.read_previous_pixels(image_layer, buffers.params, buffer_data)) {
-    error = "Failed to read neighbor frame pixels";
-    return false;
+  if (frame > 0) {
+    image.read_previous_pixels(image_layer, buffers.params, buffer_data);
   }
 
   /* Copy to device */
@@ -212,16 +211,29 @@ bool DenoiseTask::load()
     return false;
   }
 
-  /* Use previous frame output as input for subsequent frames. */
-  if (frame > 0 && !image.load_previous(denoiser->output[frame - 1], error)) {
-    return false;
-  }
-
   if (image.layers.empty()) {
     error = "No image layers found to denoise in " + center_filepath;
     return false;
   }
 
+  return true;
+}
+
+bool DenoiseTask::prepare(const DenoiseTask *previous)
+{
+  /* Use previous frame output as input for subsequent frames, from memory when possible to avoid
+   * reading back the file that was just written. */
+  if (frame > 0) {
+    if (previous && previous->frame == frame - 1) {
+      if (!image.use_previous(previous->image, error)) {
+        return false;
+      }
+    }
+    else if (!image.load_previous(denoiser->output[frame - 1], error)) {
+      return false;
+    }
+  }
+
   /* Enable temporal denoising for frames after the first (which will use the output from the
    * previous frames). */
   DenoiseParams params = denoiser->denoiser->get_params();
@@ -320,6 +332,7 @@ DenoiseImage::DenoiseImage()
   height = 0;
   num_channels = 0;
   samples = 0;
+  previous_num_channels = 0;
 }
 
 DenoiseImage::~DenoiseImage()
@@ -329,7 +342,8 @@ DenoiseImage::~DenoiseImage()
 
 void DenoiseImage::close_input()
 {
-  in_previous.reset();
+  previous_pixels.clear();
+  previous_num_channels = 0;
 }
 
 void DenoiseImage::free()
@@ -436,20 +450,13 @@ void DenoiseImage::read_pixels(const DenoiseImageLayer &layer,
   }
 }
 
-bool DenoiseImage::read_previous_pixels(const DenoiseImageLayer &layer,
+void DenoiseImage::read_previous_pixels(const DenoiseImageLayer &layer,
                                         const BufferParams &params,
                                         float *input_pixels)
 {
-  /* Load pixels from neighboring frames, and copy them into device buffer
-   * with channels reshuffled. */
-  const size_t num_pixels = (size_t)width * (size_t)height;
-  const int num_channels = in_previous->spec().nchannels;
-
-  array<float> neighbor_pixels(num_pixels * num_channels);
-
-  if (!in_previous->read_image(0, 0, 0, num_channels, TypeDesc::FLOAT, neighbor_pixels.data())) {
-    return false;
-  }
+  /* Copy pixels from neighboring frames into device buffer with channels reshuffled. */
+  const int num_channels = previous_num_channels;
+  const array<float> &neighbor_pixels = previous_pixels;
 
   const int *output_to_image_channel = layer.previous_output_to_image_channel.data();
 
@@ -461,8 +468,6 @@ bool DenoiseImage::read_previous_pixels(const DenoiseImageLayer &layer,
           neighbor_pixels[((size_t)i) * num_channels + image_channel];
     }
   }
-
-  return true;
 }
 
 bool DenoiseImage::load(const string &in_filepath, string &error)
@@ -531,7 +536,37 @@ bool DenoiseImage::load_previous(const string &filepath, string &error)
     }
   }
 
-  in_previous = std::move(in_neighbor);
+  const size_t num_pixels = (size_t)width * (size_t)height;
+  previous_num_channels = neighbor_spec.nchannels;
+  previous_pixels.resize(num_pixels * previous_num_channels);
+
+  if (!in_neighbor->read_image(
+          0, 0, 0, previous_num_channels, TypeDesc::FLOAT, previous_pixels.data()))
+  {
+    error = "Failed to read neighbor frame pixels: " + filepath;
+    return false;
+  }
+
+  return true;
+}
+
+bool DenoiseImage::use_previous(const DenoiseImage &previous, string &error)
+{
+  if (previous.width != width || previous.height != height) {
+    error = "Neighbor frame has different dimensions";
+    return false;
+  }
+
+  /* The denoised output has the same channels as the input image of the previous frame. */
+  for (DenoiseImageLayer &layer : layers) {
+    if (!layer.match_channels(in_spec.channelnames, previous.in_spec.channelnames)) {
+      error = "Neighbor frame misses denoising data passes";
+      return false;
+    }
+  }
+
+  previous_num_channels = previous.num_channels;
+  previous_pixels = previous.pixels;
 
   return true;
 }
@@ -628,35 +663,87 @@ bool DenoiserPipeline::run()
 {
   assert(input.size() == output.size());
 
-  int num_frames = output.size();
+  /* Skip empty output paths. */
+  vector<int> frames;
+  for (int frame = 0; frame < output.size(); frame++) {
+    if (!output[frame].empty()) {
+      frames.push_back(frame);
+    }
+  }
 
-  for (int frame = 0; frame < num_frames; frame++) {
-    /* Skip empty output paths. */
-    if (output[frame].empty()) {
-      continue;
+  /* Tasks report failure through their error message, set by any stage which failed. */
+  TaskPool load_pool;
+  TaskPool save_pool;
+  unique_ptr<DenoiseTask> next_task;
+  unique_ptr<DenoiseTask> previous_task;
+  unique_ptr<DenoiseTask> saving_task;
+
+  auto push_load = [&](const int frame) {
+    next_task = make_unique<DenoiseTask>(device, this, frame);
+    DenoiseTask *task = next_task.get();
+    load_pool.push([task]() { task->load(); });
+  };
+
+  auto wait_save = [&]() {
+    save_pool.wait_work();
+    if (saving_task && !saving_task->error.empty() && error.empty()) {
+      error = saving_task->error;
     }
+    saving_task.reset();
+    return error.empty();
+  };
 
-    /* Execute task. */
-    DenoiseTask task(device, this, frame);
-    if (!task.load()) {
-      error = task.error;
-      return false;
+  bool ok = true;
+
+  if (!frames.empty()) {
+    push_load(frames[0]);
+  }
+
+  for (int i = 0; i < frames.size() && ok; i++) {
+    load_pool.wait_work();
+    unique_ptr<DenoiseTask> task = std::move(next_task);
+
+    /* Read the next frame while this one is denoised. */
+    if (i + 1 < frames.size()) {
+      push_load(frames[i + 1]);
     }
 
-    if (!task.exec()) {
-      error = task.error;
-      return false;
+    if (!task->error.empty() || !task->prepare(previous_task.get())) {
+      error = task->error;
+      ok = false;
+      break;
     }
 
-    if (!task.save()) {
-      error = task.error;
-      return false;
+    /* The previous frame is no longer needed as input, write it while this one is denoised. */
+    if (!wait_save()) {
+      ok = false;
+      break;
+    }
+    if (previous_task) {
+      saving_task = std::move(previous_task);
+      DenoiseTask *save_task = saving_task.get();
+      save_pool.push([save_task]() { save_task->save(); });
     }
 
-    task.free();
+    if (!task->exec()) {
+      error = task->error;
+      ok = false;
+      break;
+    }
+
+    previous_task = std::move(task);
   }
 
-  return true;
+  /* Finish reading ahead before its task gets freed, and write the remaining frames. */
+  load_pool.wait_work();
+  ok = wait_save() && ok;
+
+  if (ok && previous_task && !previous_task->save()) {
+    error = previous_task->error;
+    ok = false;
+  }
+
+  return ok;
 }
 
 CCL_NAMESPACE_END
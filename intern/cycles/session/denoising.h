@@ -28,6 +28,8 @@ class DenoiserPipeline {
   DenoiserPipeline(DeviceInfo &denoiser_device_info, const DenoiseParams &params);
   ~DenoiserPipeline();
 
+  /* Frames are denoised in a pipeline: while one frame is denoised on the device, the next
+   * frame is read and the previous one is written on other threads. */
   bool run();
 
   /* Error message after running, in case of failure. */
@@ -99,9 +101,12 @@ class DenoiseImage {
   /* Pixel buffer with interleaved channels. */
   array<float> pixels;
 
-  /* Image file handles */
+  /* Image file specification */
   ImageSpec in_spec;
-  unique_ptr<ImageInput> in_previous;
+
+  /* Pixels of the denoised previous frame, with interleaved channels. */
+  array<float> previous_pixels;
+  int previous_num_channels;
 
   /* Render layers */
   vector<DenoiseImageLayer> layers;
@@ -114,13 +119,15 @@ class DenoiseImage {
 
   /* Load neighboring frames. */
   bool load_previous(const string &in_filepath, string &error);
+  /* Use denoised pixels of the previous frame which is still in memory. */
+  bool use_previous(const DenoiseImage &previous, string &error);
 
   /* Load subset of pixels from file buffer into input buffer, as needed for denoising
    * on the device. Channels are reshuffled following the provided mapping. */
   void read_pixels(const DenoiseImageLayer &layer,
                    const BufferParams &params,
                    float *input_pixels);
-  bool read_previous_pixels(const DenoiseImageLayer &layer,
+  void read_previous_pixels(const DenoiseImageLayer &layer,
                             const BufferParams &params,
                             float *input_pixels);
 
@@ -142,8 +149,11 @@ class DenoiseTask {
   DenoiseTask(Device *device, DenoiserPipeline *denoiser, int frame);
   ~DenoiseTask();
 
-  /* Task stages */
+  /* Task stages. Loading only reads the input image and can run on a different thread than the
+   * other stages. Preparing sets up the device buffers, using the denoised previous frame from
+   * memory when it was the task executed before this one. */
   bool load();
+  bool prepare(const DenoiseTask *previous);
   bool exec();
   bool save();
   void free();
@@ -755,6 +755,11 @@ void Session::device_free()
 
 void Session::collect_statistics(RenderStats *render_stats)
 {
+  double total_time, render_time;
+  progress.get_time(total_time, render_time);
+  render_stats->render_time = render_time;
+  render_stats->num_pixel_samples = progress.get_pixel_samples();
+
   scene->collect_statistics(render_stats);
   if (params.use_profiling && (params.device.type == DEVICE_CPU)) {
     render_stats->collect_profiling(scene, profiler);
@@ -767,7 +772,10 @@ void Session::collect_statistics(RenderStats *render_stats)
 
 void Session::process_full_buffer_from_disk(string_view filename)
 {
-  path_trace_->process_full_buffer_from_disk(filename);
+  const int band_height = params.use_streaming_tiles ?
+                              tile_manager_.compute_render_tile_size(params.tile_size) :
+                              0;
+  path_trace_->process_full_buffer_from_disk(filename, band_height);
 }
 
 CCL_NAMESPACE_END
@@ -59,6 +59,10 @@ class SessionParams {
   bool use_auto_tile;
   int tile_size;
 
+  /* Process the tiles file written to disk in bands of the tile size, rather than reading the
+   * full frame into memory for denoising and output. */
+  bool use_streaming_tiles;
+
   bool use_resolution_divider;
 
   ShadingSystem shadingsystem;
@@ -82,6 +86,7 @@ class SessionParams {
 
     use_auto_tile = true;
     tile_size = 2048;
+    use_streaming_tiles = false;
 
     use_resolution_divider = true;
 
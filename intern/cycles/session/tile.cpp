@@ -626,27 +626,40 @@ void TileManager::finish_write_tiles()
   write_state_.filename = "";
 }
 
-bool TileManager::read_full_buffer_from_disk(const string_view filename,
-                                             RenderBuffers *buffers,
-                                             DenoiseParams *denoise_params)
+/* Open tiles file and read the buffer and denoise parameters from its metadata. */
+static unique_ptr<ImageInput> open_full_buffer_file(const string_view filename,
+                                                    BufferParams *buffer_params,
+                                                    DenoiseParams *denoise_params)
 {
   unique_ptr<ImageInput> in(ImageInput::open(filename));
   if (!in) {
     LOG(ERROR) << "Error opening tile file " << filename;
-    return false;
+    return nullptr;
   }
 
   const ImageSpec &image_spec = in->spec();
 
-  BufferParams buffer_params;
-  if (!buffer_params_from_image_spec_atttributes(&buffer_params, image_spec)) {
-    return false;
+  if (!buffer_params_from_image_spec_atttributes(buffer_params, image_spec)) {
+    return nullptr;
   }
-  buffers->reset(buffer_params);
 
   if (!node_from_image_spec_atttributes(denoise_params, image_spec, ATTR_DENOISE_SOCKET_PREFIX)) {
+    return nullptr;
+  }
+
+  return in;
+}
+
+bool TileManager::read_full_buffer_from_disk(const string_view filename,
+                                             RenderBuffers *buffers,
+                                             DenoiseParams *denoise_params)
+{
+  BufferParams buffer_params;
+  unique_ptr<ImageInput> in = open_full_buffer_file(filename, &buffer_params, denoise_params);
+  if (!in) {
     return false;
   }
+  buffers->reset(buffer_params);
 
   const int num_channels = in->spec().nchannels;
   if (!in->read_image(0, 0, 0, num_channels, TypeDesc::FLOAT, buffers->buffer.data())) {
@@ -662,4 +675,76 @@ bool TileManager::read_full_buffer_from_disk(const string_view filename,
   return true;
 }
 
+bool TileManager::read_full_buffer_params_from_disk(const string_view filename,
+                                                    BufferParams *buffer_params,
+                                                    DenoiseParams *denoise_params)
+{
+  unique_ptr<ImageInput> in = open_full_buffer_file(filename, buffer_params, denoise_params);
+  if (!in) {
+    return false;
+  }
+
+  if (!in->close()) {
+    LOG(ERROR) << "Error closing tile file " << in->geterror();
+    return false;
+  }
+
+  return true;
+}
+
+bool TileManager::read_full_buffer_rows_from_disk(const string_view filename,
+                                                  const int y,
+                                                  const int height,
+                                                  const int overlap,
+                                                  RenderBuffers *buffers)
+{
+  BufferParams buffer_params;
+  DenoiseParams denoise_params;
+  unique_ptr<ImageInput> in = open_full_buffer_file(filename, &buffer_params, &denoise_params);
+  if (!in) {
+    return false;
+  }
+
+  const ImageSpec &image_spec = in->spec();
+
+  /* Tiled files can only be read at image tile boundaries, so round the overlap outwards. */
+  const int tile_height = max(image_spec.tile_height, 1);
+  const int row_begin = max(y - overlap, 0) / tile_height * tile_height;
+  const int row_end = min(align_up(y + height + overlap, tile_height), buffer_params.height);
+
+  /* Rows outside of the requested ones are stored as the overscan of the buffer window. */
+  buffer_params.full_y += row_begin;
+  buffer_params.height = row_end - row_begin;
+  buffer_params.window_y = y - row_begin;
+  buffer_params.window_height = height;
+  buffer_params.update_offset_stride();
+
+  buffers->reset(buffer_params);
+
+  const int num_channels = image_spec.nchannels;
+  if (!in->read_tiles(0,
+                      0,
+                      image_spec.x,
+                      image_spec.x + image_spec.width,
+                      image_spec.y + row_begin,
+                      image_spec.y + row_end,
+                      0,
+                      1,
+                      0,
+                      num_channels,
+                      TypeDesc::FLOAT,
+                      buffers->buffer.data()))
+  {
+    LOG(ERROR) << "Error reading pixels from the tile file " << in->geterror();
+    return false;
+  }
+
+  if (!in->close()) {
+    LOG(ERROR) << "Error closing tile file " << in->geterror();
+    return false;
+  }
+
+  return true;
+}
+
 CCL_NAMESPACE_END
@@ -104,6 +104,24 @@ class TileManager {
                                   RenderBuffers *buffers,
                                   DenoiseParams *denoise_params);
 
+  /* Read parameters of the full frame render buffer from tiles file on disk, without reading any
+   * of its pixels.
+   *
+   * Returns true on success. */
+  bool read_full_buffer_params_from_disk(string_view filename,
+                                         BufferParams *buffer_params,
+                                         DenoiseParams *denoise_params);
+
+  /* Read rows [y, y + height) of the full frame render buffer from tiles file on disk.
+   *
+   * At least `overlap` rows around them are read as well where available, and are stored outside
+   * of the buffer window. This allows to process the full frame in bands, with the memory usage
+   * depending on the band size rather than on the frame size.
+   *
+   * Returns true on success. */
+  bool read_full_buffer_rows_from_disk(
+      string_view filename, int y, int height, int overlap, RenderBuffers *buffers);
+
   /* Compute valid tile size compatible with image saving. */
   int compute_render_tile_size(const int suggested_tile_size) const;
 
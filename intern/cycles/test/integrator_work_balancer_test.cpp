@@ -0,0 +1,49 @@
+/* SPDX-FileCopyrightText: 2011-2022 Blender Foundation
+ *
+ * SPDX-License-Identifier: Apache-2.0 */
+
+#include "testing/testing.h"
+
+#include "integrator/work_balancer.h"
+
+CCL_NAMESPACE_BEGIN
+
+TEST(work_balance_do_rebalance, Balanced)
+{
+  vector<WorkBalanceInfo> infos(2);
+  work_balance_do_initial(infos);
+  infos[0].time_spent = 1.0;
+  infos[1].time_spent = 1.005;
+
+  EXPECT_FALSE(work_balance_do_rebalance(infos));
+  EXPECT_DOUBLE_EQ(infos[0].weight, 0.5);
+  EXPECT_DOUBLE_EQ(infos[1].weight, 0.5);
+}
+
+TEST(work_balance_do_rebalance, Heterogeneous)
+{
+  /* One slow device next to three devices which are ten times faster. */
+  vector<WorkBalanceInfo> infos(4);
+  work_balance_do_initial(infos);
+
+  for (int iteration = 0; iteration < 8; iteration++) {
+    infos[0].time_spent = infos[0].weight * 10.0;
+    for (int i = 1; i < 4; i++) {
+      infos[i].time_spent = infos[i].weight;
+    }
+    work_balance_do_rebalance(infos);
+  }
+
+  double total_weight = 0.0;
+  for (const WorkBalanceInfo &info : infos) {
+    total_weight += info.weight;
+  }
+  EXPECT_NEAR(total_weight, 1.0, 1e-9);
+
+  EXPECT_NEAR(infos[0].weight, 1.0 / 31.0, 2e-3);
+  for (int i = 1; i < 4; i++) {
+    EXPECT_NEAR(infos[i].weight, 10.0 / 31.0, 2e-3);
+  }
+}
+
+CCL_NAMESPACE_END
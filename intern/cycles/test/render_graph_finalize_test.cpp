@@ -1537,4 +1537,46 @@ TEST_F(RenderGraph, constant_fold_convert_color_float_color)
   graph.finalize(scene);
 }
 
+/*
+ * Tests:
+ *  - Graphs with the same nodes, settings and links have the same hash.
+ *  - Changing a node setting changes the hash.
+ *  - Graphs with nodes that depend on the scene are not hashed.
+ */
+TEST_F(RenderGraph, graph_hash)
+{
+  EXPECT_ANY_MESSAGE(log);
+
+  auto build_graph = [](ShaderGraph *graph, const float value) {
+    ShaderGraphBuilder graph_builder(graph);
+    graph_builder.add_attribute("Attribute")
+        .add_node(ShaderNodeBuilder<MathNode>(*graph, "Math")
+                      .set_param("math_type", NODE_MATH_ADD)
+                      .set("Value2", value))
+        .add_connection("Attribute::Fac", "Math::Value1")
+        .output_value("Math::Value");
+  };
+
+  build_graph(&graph, 0.5f);
+  graph.compute_hash();
+  EXPECT_FALSE(graph.hash.empty());
+
+  ShaderGraph same_graph;
+  build_graph(&same_graph, 0.5f);
+  same_graph.compute_hash();
+  EXPECT_EQ(graph.hash, same_graph.hash);
+
+  ShaderGraph other_graph;
+  build_graph(&other_graph, 0.25f);
+  other_graph.compute_hash();
+  EXPECT_NE(graph.hash, other_graph.hash);
+
+  ShaderGraph image_graph;
+  ShaderGraphBuilder(&image_graph)
+      .add_node(ShaderNodeBuilder<ImageTextureNode>(image_graph, "Image"))
+      .output_color("Image::Color");
+  image_graph.compute_hash();
+  EXPECT_TRUE(image_graph.hash.empty());
+}
+
 CCL_NAMESPACE_END
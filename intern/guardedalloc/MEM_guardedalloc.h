@@ -187,6 +187,41 @@ extern void (*MEM_reset_peak_memory)(void);
 /** Get the peak memory usage in bytes, including `mmap` allocations. */
 extern size_t (*MEM_get_peak_memory)(void) ATTR_WARN_UNUSED_RESULT;
 
+/**
+ * Subsystems that memory usage can be attributed to, see #MEM_tag_set.
+ * Stored per allocation, so at most 256 tags can be used.
+ */
+typedef enum eMEMTag {
+  /** Memory that isn't attributed to any subsystem. This is the default. */
+  MEM_TAG_UNTAGGED = 0,
+  MEM_TAG_DEPSGRAPH,
+  MEM_TAG_GEOMETRY,
+  MEM_TAG_GPU_STAGING,
+  MEM_TAG_UNDO,
+  MEM_TAG_IMAGE_CACHE,
+} eMEMTag;
+#define MEM_TAG_NUM (MEM_TAG_IMAGE_CACHE + 1)
+
+/**
+ * Attribute all allocations that are done by the current thread from now on to the given tag.
+ * Freeing memory always subtracts its size from the tag it was allocated with.
+ *
+ * 
+ote Tags are not propagated to other threads, e.g. to tasks started from the current thread.
+ * Only the lock-free allocator keeps track of tags, with the guarded allocator all memory is
+ * reported as #MEM_TAG_UNTAGGED.
+ *
+ * 
+eturn The previous tag of the current thread, to restore it afterwards.
+ */
+eMEMTag MEM_tag_set(eMEMTag tag);
+/** Get the tag that allocations of the current thread are attributed to. */
+eMEMTag MEM_tag_get(void);
+/** Memory in use that is attributed to the given tag. */
+size_t MEM_get_memory_in_use_by_tag(eMEMTag tag);
+/** Human readable name of the tag, for reports. */
+const char *MEM_tag_name(eMEMTag tag);
+
 #ifdef __cplusplus
 #  define MEM_SAFE_FREE(v) \
     do { \
@@ -447,6 +482,24 @@ template<typename T, typename... Args> T &MEM_construct_leak_detection_data(Args
   return *data;
 }
 
+/**
+ * Attribute allocations done by the current thread to a tag while this is in scope,
+ * see #MEM_tag_set.
+ */
+class MEM_TagScope {
+ private:
+  eMEMTag previous_tag_;
+
+ public:
+  explicit MEM_TagScope(const eMEMTag tag) : previous_tag_(MEM_tag_set(tag)) {}
+  ~MEM_TagScope()
+  {
+    MEM_tag_set(previous_tag_);
+  }
+  MEM_TagScope(const MEM_TagScope &other) = delete;
+  MEM_TagScope &operator=(const MEM_TagScope &other) = delete;
+};
+
 #endif /* __cplusplus */
 
 #endif /* __MEM_GUARDEDALLOC_H__ */
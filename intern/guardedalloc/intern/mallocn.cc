@@ -201,3 +201,45 @@ void MEM_use_guarded_allocator()
   MEM_name_ptr_set = MEM_guarded_name_ptr_set;
 #endif
 }
+
+eMEMTag MEM_tag_set(const eMEMTag tag)
+{
+  return eMEMTag(memory_usage_tag_set(uint8_t(tag)));
+}
+
+eMEMTag MEM_tag_get()
+{
+  return eMEMTag(memory_usage_tag_get());
+}
+
+size_t MEM_get_memory_in_use_by_tag(const eMEMTag tag)
+{
+  if (tag != MEM_TAG_UNTAGGED) {
+    return memory_usage_current_by_tag(uint8_t(tag));
+  }
+  /* Untagged memory is whatever isn't attributed to any other tag. */
+  int64_t mem_in_use = int64_t(MEM_get_memory_in_use());
+  for (int other_tag = MEM_TAG_UNTAGGED + 1; other_tag < MEM_TAG_NUM; other_tag++) {
+    mem_in_use -= int64_t(memory_usage_current_by_tag(uint8_t(other_tag)));
+  }
+  return mem_in_use > 0 ? size_t(mem_in_use) : 0;
+}
+
+const char *MEM_tag_name(const eMEMTag tag)
+{
+  switch (tag) {
+    case MEM_TAG_UNTAGGED:
+      return "Untagged";
+    case MEM_TAG_DEPSGRAPH:
+      return "Depsgraph";
+    case MEM_TAG_GEOMETRY:
+      return "Geometry";
+    case MEM_TAG_GPU_STAGING:
+      return "GPU Staging";
+    case MEM_TAG_UNDO:
+      return "Undo";
+    case MEM_TAG_IMAGE_CACHE:
+      return "Image Cache";
+  }
+  return "Unknown";
+}
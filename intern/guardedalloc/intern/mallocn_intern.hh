@@ -89,12 +89,16 @@ extern bool leak_detector_has_run;
 extern char free_after_leak_detection_message[];
 
 void memory_usage_init(void);
-void memory_usage_block_alloc(size_t size);
-void memory_usage_block_free(size_t size);
+/** \return The tag the allocation is attributed to, it has to be passed in when it is freed. */
+uint8_t memory_usage_block_alloc(size_t size);
+void memory_usage_block_free(size_t size, uint8_t tag);
 size_t memory_usage_block_num(void);
 size_t memory_usage_current(void);
 size_t memory_usage_peak(void);
 void memory_usage_peak_reset(void);
+uint8_t memory_usage_tag_set(uint8_t tag);
+uint8_t memory_usage_tag_get(void);
+size_t memory_usage_current_by_tag(uint8_t tag);
 
 /**
  * Clear the listbase of allocated memory blocks.
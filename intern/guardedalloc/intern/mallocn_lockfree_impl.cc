@@ -67,12 +67,22 @@ enum {
   MEMHEAD_FLAG_MASK = (1 << 2) - 1
 };
 
+/**
+ * The #eMEMTag of the block is stored in the highest byte of `len`, allocations never get close
+ * to that size.
+ */
+static_assert(sizeof(size_t) == 8, "The memory tag is stored in the upper bits of the length");
+#define MEMHEAD_TAG_SHIFT 56
+#define MEMHEAD_TAG_MASK (size_t(0xff) << MEMHEAD_TAG_SHIFT)
+
 #define MEMHEAD_FROM_PTR(ptr) (((MemHead *)ptr) - 1)
 #define PTR_FROM_MEMHEAD(memhead) (memhead + 1)
 #define MEMHEAD_ALIGNED_FROM_PTR(ptr) (((MemHeadAligned *)ptr) - 1)
 #define MEMHEAD_IS_ALIGNED(memhead) ((memhead)->len & size_t(MEMHEAD_FLAG_ALIGN))
 #define MEMHEAD_IS_FROM_CPP_NEW(memhead) ((memhead)->len & size_t(MEMHEAD_FLAG_FROM_CPP_NEW))
-#define MEMHEAD_LEN(memhead) ((memhead)->len & ~size_t(MEMHEAD_FLAG_MASK))
+#define MEMHEAD_LEN(memhead) ((memhead)->len & ~(size_t(MEMHEAD_FLAG_MASK) | MEMHEAD_TAG_MASK))
+#define MEMHEAD_TAG(memhead) uint8_t((memhead)->len >> MEMHEAD_TAG_SHIFT)
+#define MEMHEAD_TAG_BITS(tag) (size_t(tag) << MEMHEAD_TAG_SHIFT)
 
 #ifdef __GNUC__
 __attribute__((format(printf, 1, 0)))
@@ -160,7 +170,7 @@ void MEM_lockfree_freeN(void *vmemh, AllocationType allocation_type)
         "Attempt to use C-style MEM_freeN on a pointer created with CPP-style MEM_new or new\n");
   }
 
-  memory_usage_block_free(len);
+  memory_usage_block_free(len, MEMHEAD_TAG(memh));
 
   if (UNLIKELY(malloc_debug_memset && len)) {
     memset(memh + 1, 255, len);
@@ -300,8 +310,8 @@ void *MEM_lockfree_callocN(size_t len, const char *str)
   memh = (MemHead *)calloc(1, len + sizeof(MemHead));
 
   if (LIKELY(memh)) {
-    memh->len = len;
-    memory_usage_block_alloc(len);
+    const uint8_t tag = memory_usage_block_alloc(len);
+    memh->len = len | MEMHEAD_TAG_BITS(tag);
 
     return PTR_FROM_MEMHEAD(memh);
   }
@@ -357,8 +367,8 @@ void *MEM_lockfree_mallocN(size_t len, const char *str)
 #endif /* WITH_MEM_VALGRIND */
     }
 
-    memh->len = len;
-    memory_usage_block_alloc(len);
+    const uint8_t tag = memory_usage_block_alloc(len);
+    memh->len = len | MEMHEAD_TAG_BITS(tag);
 
     return PTR_FROM_MEMHEAD(memh);
   }
@@ -441,11 +451,12 @@ void *MEM_lockfree_mallocN_aligned(size_t len,
 #endif /* WITH_MEM_VALGRIND */
     }
 
+    const uint8_t tag = memory_usage_block_alloc(len);
     memh->len = len | size_t(MEMHEAD_FLAG_ALIGN) |
                 size_t(allocation_type == AllocationType::NEW_DELETE ? MEMHEAD_FLAG_FROM_CPP_NEW :
-                                                                       0);
+                                                                       0) |
+                MEMHEAD_TAG_BITS(tag);
     memh->alignment = short(alignment);
-    memory_usage_block_alloc(len);
 
     return PTR_FROM_MEMHEAD(memh);
   }
@@ -502,6 +513,11 @@ void MEM_lockfree_printmemlist_stats()
 {
   printf("\ntotal memory len: %.3f MB\n", double(memory_usage_current()) / double(1024 * 1024));
   printf("peak memory len: %.3f MB\n", double(memory_usage_peak()) / double(1024 * 1024));
+  for (uint8_t tag = 0; tag < MEM_TAG_NUM; tag++) {
+    printf("  %s: %.3f MB\n",
+           MEM_tag_name(eMEMTag(tag)),
+           double(MEM_get_memory_in_use_by_tag(eMEMTag(tag))) / double(1024 * 1024));
+  }
   printf(
       "\nFor more detailed per-block statistics run Blender with memory debugging command line "
       "argument.\n");
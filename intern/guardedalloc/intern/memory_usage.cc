@@ -54,6 +54,13 @@ struct alignas(128) Local {
    * accurate, but it's still good enough for practical purposes.
    */
   std::atomic<int64_t> mem_in_use_during_peak_update = 0;
+  /**
+   * Number of bytes per #eMEMTag, except for #MEM_TAG_UNTAGGED which is derived from the total.
+   * Like #mem_in_use this can be negative when memory is freed by another thread.
+   */
+  std::atomic<int64_t> mem_in_use_by_tag[MEM_TAG_NUM] = {};
+  /** Tag that allocations of this thread are attributed to, only accessed by this thread. */
+  uint8_t tag = MEM_TAG_UNTAGGED;
 
   Local();
   ~Local();
@@ -90,6 +97,10 @@ struct Global {
    * Number of blocks that are not tracked by #Local, for the same reason as above.
    */
   std::atomic<int64_t> blocks_num_outside_locals = 0;
+  /**
+   * Number of bytes per tag that are not tracked by #Local, for the same reason as above.
+   */
+  std::atomic<int64_t> mem_in_use_by_tag_outside_locals[MEM_TAG_NUM] = {};
   /**
    * Peak memory usage since the last reset.
    */
@@ -152,6 +163,10 @@ Local::~Local()
   /* Don't forget the memory counts stored locally. */
   this->global->blocks_num_outside_locals.fetch_add(this->blocks_num, std::memory_order_relaxed);
   this->global->mem_in_use_outside_locals.fetch_add(this->mem_in_use, std::memory_order_relaxed);
+  for (int tag_i = 0; tag_i < MEM_TAG_NUM; tag_i++) {
+    this->global->mem_in_use_by_tag_outside_locals[tag_i].fetch_add(
+        this->mem_in_use_by_tag[tag_i], std::memory_order_relaxed);
+  }
 
   if (this->is_main) {
     /* The main thread started shutting down. Use global counters from now on to avoid accessing
@@ -185,7 +200,7 @@ void memory_usage_init()
   get_local_data();
 }
 
-void memory_usage_block_alloc(const size_t size)
+uint8_t memory_usage_block_alloc(const size_t size)
 {
   if (LIKELY(use_local_counters.load(std::memory_order_relaxed))) {
     Local &local = get_local_data();
@@ -195,35 +210,83 @@ void memory_usage_block_alloc(const size_t size)
      * time, which is very rare compared to doing allocations. */
     local.blocks_num.fetch_add(1, std::memory_order_relaxed);
     local.mem_in_use.fetch_add(int64_t(size), std::memory_order_relaxed);
+    const uint8_t tag = local.tag;
+    if (tag != MEM_TAG_UNTAGGED) {
+      local.mem_in_use_by_tag[tag].fetch_add(int64_t(size), std::memory_order_relaxed);
+    }
 
     /* If a certain amount of new memory has been allocated, update the peak. */
     if (local.mem_in_use - local.mem_in_use_during_peak_update > peak_update_threshold) {
       update_global_peak();
     }
+    return tag;
   }
-  else {
-    Global &global = get_global();
-    /* Increase global memory counts. */
-    global.blocks_num_outside_locals.fetch_add(1, std::memory_order_relaxed);
-    global.mem_in_use_outside_locals.fetch_add(int64_t(size), std::memory_order_relaxed);
-  }
+  Global &global = get_global();
+  /* Increase global memory counts. */
+  global.blocks_num_outside_locals.fetch_add(1, std::memory_order_relaxed);
+  global.mem_in_use_outside_locals.fetch_add(int64_t(size), std::memory_order_relaxed);
+  return MEM_TAG_UNTAGGED;
 }
 
-void memory_usage_block_free(const size_t size)
+void memory_usage_block_free(const size_t size, const uint8_t tag)
 {
+  assert(tag < MEM_TAG_NUM);
   if (LIKELY(use_local_counters)) {
     /* Decrease local memory counts. See comment in #memory_usage_block_alloc for details regarding
      * thread synchronization. */
     Local &local = get_local_data();
     local.mem_in_use.fetch_sub(int64_t(size), std::memory_order_relaxed);
     local.blocks_num.fetch_sub(1, std::memory_order_relaxed);
+    if (tag != MEM_TAG_UNTAGGED) {
+      local.mem_in_use_by_tag[tag].fetch_sub(int64_t(size), std::memory_order_relaxed);
+    }
   }
   else {
     Global &global = get_global();
     /* Decrease global memory counts. */
     global.blocks_num_outside_locals.fetch_sub(1, std::memory_order_relaxed);
     global.mem_in_use_outside_locals.fetch_sub(int64_t(size), std::memory_order_relaxed);
+    if (tag != MEM_TAG_UNTAGGED) {
+      global.mem_in_use_by_tag_outside_locals[tag].fetch_sub(int64_t(size),
+                                                             std::memory_order_relaxed);
+    }
+  }
+}
+
+uint8_t memory_usage_tag_set(const uint8_t tag)
+{
+  assert(tag < MEM_TAG_NUM);
+  if (UNLIKELY(!use_local_counters.load(std::memory_order_relaxed))) {
+    /* Allocations aren't attributed to tags anymore during shutdown. */
+    return MEM_TAG_UNTAGGED;
+  }
+  Local &local = get_local_data();
+  const uint8_t previous_tag = local.tag;
+  local.tag = tag;
+  return previous_tag;
+}
+
+uint8_t memory_usage_tag_get()
+{
+  if (UNLIKELY(!use_local_counters.load(std::memory_order_relaxed))) {
+    return MEM_TAG_UNTAGGED;
+  }
+  return get_local_data().tag;
+}
+
+size_t memory_usage_current_by_tag(const uint8_t tag)
+{
+  /* Untagged memory isn't counted separately to keep the overhead of most allocations low. */
+  assert(tag != MEM_TAG_UNTAGGED && tag < MEM_TAG_NUM);
+  Global &global = get_global();
+  std::lock_guard lock{global.locals_mutex};
+
+  int64_t mem_in_use = global.mem_in_use_by_tag_outside_locals[tag];
+  for (const Local *local : global.locals) {
+    mem_in_use += local->mem_in_use_by_tag[tag];
   }
+  /* Tags are read one after another, so concurrent frees could make this negative briefly. */
+  return size_t(std::max<int64_t>(mem_in_use, 0));
 }
 
 size_t memory_usage_block_num()
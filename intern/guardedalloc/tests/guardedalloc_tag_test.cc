@@ -0,0 +1,57 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: Apache-2.0 */
+
+#include "testing/testing.h"
+
+#include "MEM_guardedalloc.h"
+#include "guardedalloc_test_base.h"
+
+TEST_F(LockFreeAllocatorTest, MEM_tag_set)
+{
+  EXPECT_EQ(MEM_tag_get(), MEM_TAG_UNTAGGED);
+  const eMEMTag previous_tag = MEM_tag_set(MEM_TAG_UNDO);
+  EXPECT_EQ(previous_tag, MEM_TAG_UNTAGGED);
+  EXPECT_EQ(MEM_tag_get(), MEM_TAG_UNDO);
+  {
+    MEM_TagScope scope(MEM_TAG_GEOMETRY);
+    EXPECT_EQ(MEM_tag_get(), MEM_TAG_GEOMETRY);
+  }
+  EXPECT_EQ(MEM_tag_get(), MEM_TAG_UNDO);
+  MEM_tag_set(previous_tag);
+  EXPECT_EQ(MEM_tag_get(), MEM_TAG_UNTAGGED);
+}
+
+TEST_F(LockFreeAllocatorTest, MEM_get_memory_in_use_by_tag)
+{
+  const size_t geometry_before = MEM_get_memory_in_use_by_tag(MEM_TAG_GEOMETRY);
+  const size_t undo_before = MEM_get_memory_in_use_by_tag(MEM_TAG_UNDO);
+
+  void *geometry_data;
+  void *undo_data;
+  {
+    MEM_TagScope scope(MEM_TAG_GEOMETRY);
+    geometry_data = MEM_mallocN(1000, __func__);
+  }
+  {
+    MEM_TagScope scope(MEM_TAG_UNDO);
+    undo_data = MEM_mallocN_aligned(2000, 64, __func__);
+  }
+  EXPECT_EQ(MEM_allocN_len(geometry_data), 1000);
+  EXPECT_EQ(MEM_allocN_len(undo_data), 2000);
+  EXPECT_EQ(MEM_get_memory_in_use_by_tag(MEM_TAG_GEOMETRY), geometry_before + 1000);
+  EXPECT_EQ(MEM_get_memory_in_use_by_tag(MEM_TAG_UNDO), undo_before + 2000);
+
+  /* Reallocating keeps the tag of the thread doing it, freeing uses the tag of the block. */
+  {
+    MEM_TagScope scope(MEM_TAG_UNDO);
+    geometry_data = MEM_reallocN(geometry_data, 500);
+  }
+  EXPECT_EQ(MEM_get_memory_in_use_by_tag(MEM_TAG_GEOMETRY), geometry_before);
+  EXPECT_EQ(MEM_get_memory_in_use_by_tag(MEM_TAG_UNDO), undo_before + 2500);
+
+  MEM_freeN(geometry_data);
+  MEM_freeN(undo_data);
+  EXPECT_EQ(MEM_get_memory_in_use_by_tag(MEM_TAG_GEOMETRY), geometry_before);
+  EXPECT_EQ(MEM_get_memory_in_use_by_tag(MEM_TAG_UNDO), undo_before);
+}
@@ -453,6 +453,13 @@ void FallbackImpl::cpuProcessorRelease(OCIO_ConstCPUProcessorRcPtr *cpu_processo
   delete (FallbackProcessor *)(cpu_processor);
 }
 
+OCIO_ConstCPUProcessorRcPtr *FallbackImpl::cpuProcessorCopy(
+    OCIO_ConstCPUProcessorRcPtr *cpu_processor)
+{
+  FallbackProcessor *fallback_processor = (FallbackProcessor *)cpu_processor;
+  return (OCIO_ConstCPUProcessorRcPtr *)new FallbackProcessor(*fallback_processor);
+}
+
 const char *FallbackImpl::colorSpaceGetName(OCIO_ConstColorSpaceRcPtr *cs)
 {
   if (cs == COLORSPACE_LINEAR) {
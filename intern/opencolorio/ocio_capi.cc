@@ -225,6 +225,11 @@ void OCIO_cpuProcessorRelease(OCIO_ConstCPUProcessorRcPtr *cpu_processor)
   impl->cpuProcessorRelease(cpu_processor);
 }
 
+OCIO_ConstCPUProcessorRcPtr *OCIO_cpuProcessorCopy(OCIO_ConstCPUProcessorRcPtr *cpu_processor)
+{
+  return impl->cpuProcessorCopy(cpu_processor);
+}
+
 const char *OCIO_colorSpaceGetName(OCIO_ConstColorSpaceRcPtr *cs)
 {
   return impl->colorSpaceGetName(cs);
@@ -161,6 +161,11 @@ void OCIO_cpuProcessorApplyRGBA(OCIO_ConstCPUProcessorRcPtr *cpu_processor, floa
 void OCIO_cpuProcessorApplyRGBA_predivide(OCIO_ConstCPUProcessorRcPtr *cpu_processor,
                                           float *pixel);
 void OCIO_cpuProcessorRelease(OCIO_ConstCPUProcessorRcPtr *processor);
+/**
+ * Create a new handle to the same CPU processor, which has to be released separately. Cheap, the
+ * processor itself is shared.
+ */
+OCIO_ConstCPUProcessorRcPtr *OCIO_cpuProcessorCopy(OCIO_ConstCPUProcessorRcPtr *cpu_processor);
 
 const char *OCIO_colorSpaceGetName(OCIO_ConstColorSpaceRcPtr *cs);
 const char *OCIO_colorSpaceGetDescription(OCIO_ConstColorSpaceRcPtr *cs);
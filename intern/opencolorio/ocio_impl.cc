@@ -659,6 +659,13 @@ void OCIOImpl::cpuProcessorRelease(OCIO_ConstCPUProcessorRcPtr *cpu_processor)
   MEM_delete(cpu_processor);
 }
 
+OCIO_ConstCPUProcessorRcPtr *OCIOImpl::cpuProcessorCopy(OCIO_ConstCPUProcessorRcPtr *cpu_processor)
+{
+  ConstCPUProcessorRcPtr *copy = MEM_new<ConstCPUProcessorRcPtr>(__func__);
+  *copy = *(ConstCPUProcessorRcPtr *)cpu_processor;
+  return (OCIO_ConstCPUProcessorRcPtr *)copy;
+}
+
 const char *OCIOImpl::colorSpaceGetName(OCIO_ConstColorSpaceRcPtr *cs)
 {
   return (*(ConstColorSpaceRcPtr *)cs)->getName();
@@ -73,6 +73,8 @@ class IOCIOImpl {
   virtual void cpuProcessorApplyRGBA_predivide(OCIO_ConstCPUProcessorRcPtr *cpu_processor,
                                                float *pixel) = 0;
   virtual void cpuProcessorRelease(OCIO_ConstCPUProcessorRcPtr *cpu_processor) = 0;
+  virtual OCIO_ConstCPUProcessorRcPtr *cpuProcessorCopy(
+      OCIO_ConstCPUProcessorRcPtr *cpu_processor) = 0;
 
   virtual const char *colorSpaceGetName(OCIO_ConstColorSpaceRcPtr *cs) = 0;
   virtual const char *colorSpaceGetDescription(OCIO_ConstColorSpaceRcPtr *cs) = 0;
@@ -192,6 +194,7 @@ class FallbackImpl : public IOCIOImpl {
   void cpuProcessorApplyRGBA(OCIO_ConstCPUProcessorRcPtr *cpu_processor, float *pixel);
   void cpuProcessorApplyRGBA_predivide(OCIO_ConstCPUProcessorRcPtr *cpu_processor, float *pixel);
   void cpuProcessorRelease(OCIO_ConstCPUProcessorRcPtr *cpu_processor);
+  OCIO_ConstCPUProcessorRcPtr *cpuProcessorCopy(OCIO_ConstCPUProcessorRcPtr *cpu_processor);
 
   const char *colorSpaceGetName(OCIO_ConstColorSpaceRcPtr *cs);
   const char *colorSpaceGetDescription(OCIO_ConstColorSpaceRcPtr *cs);
@@ -286,6 +289,7 @@ class OCIOImpl : public IOCIOImpl {
   void cpuProcessorApplyRGBA(OCIO_ConstCPUProcessorRcPtr *cpu_processor, float *pixel);
   void cpuProcessorApplyRGBA_predivide(OCIO_ConstCPUProcessorRcPtr *cpu_processor, float *pixel);
   void cpuProcessorRelease(OCIO_ConstCPUProcessorRcPtr *cpu_processor);
+  OCIO_ConstCPUProcessorRcPtr *cpuProcessorCopy(OCIO_ConstCPUProcessorRcPtr *cpu_processor);
 
   const char *colorSpaceGetName(OCIO_ConstColorSpaceRcPtr *cs);
   const char *colorSpaceGetDescription(OCIO_ConstColorSpaceRcPtr *cs);
@@ -12,13 +12,39 @@
 #include <opensubdiv/osd/cpuEvaluator.h>
 #include <opensubdiv/osd/cpuPatchTable.h>
 #include <opensubdiv/osd/cpuVertexBuffer.h>
+#ifdef OPENSUBDIV_HAS_TBB
+#  include <opensubdiv/osd/tbbEvaluator.h>
+#endif
 
 using OpenSubdiv::Far::StencilTable;
-using OpenSubdiv::Osd::CpuEvaluator;
+using OpenSubdiv::Osd::BufferDescriptor;
 using OpenSubdiv::Osd::CpuVertexBuffer;
 
 namespace blender::opensubdiv {
 
+#ifdef OPENSUBDIV_HAS_TBB
+// Applies stencils in parallel. This is done for all refined vertices whenever the coarse
+// positions change, while patches are evaluated for a few points at a time from code that is
+// already multi-threaded, so those keep using the serial evaluator.
+class CpuEvaluator : public OpenSubdiv::Osd::CpuEvaluator {
+ public:
+  template<typename SRC_BUFFER, typename DST_BUFFER, typename STENCIL_TABLE>
+  static bool EvalStencils(SRC_BUFFER *src_buffer,
+                           const BufferDescriptor &src_desc,
+                           DST_BUFFER *dst_buffer,
+                           const BufferDescriptor &dst_desc,
+                           const STENCIL_TABLE *stencil_table,
+                           const CpuEvaluator * /*instance*/ = NULL,
+                           void * /*device_context*/ = NULL)
+  {
+    return OpenSubdiv::Osd::TbbEvaluator::EvalStencils(
+        src_buffer, src_desc, dst_buffer, dst_desc, stencil_table);
+  }
+};
+#else
+using OpenSubdiv::Osd::CpuEvaluator;
+#endif
+
 // NOTE: Define as a class instead of typedef to make it possible
 // to have anonymous class in opensubdiv_evaluator_internal.h
 class CpuEvalOutput : public VolatileEvalOutput<CpuVertexBuffer,
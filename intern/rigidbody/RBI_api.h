@@ -75,6 +75,9 @@ void RB_dworld_step_simulation(rbDynamicsWorld *world,
                                int maxSubSteps,
                                float timeSubStep);
 
+/* Number of pairs of bodies with contact points after the last simulation step */
+int RB_dworld_get_num_contact_pairs(rbDynamicsWorld *world);
+
 /* Export -------------------------- */
 
 /* Exports the dynamics world to physics simulator's serialisation format */
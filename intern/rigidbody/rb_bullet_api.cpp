@@ -199,6 +199,19 @@ void RB_dworld_step_simulation(rbDynamicsWorld *world,
   world->dynamicsWorld->stepSimulation(timeStep, maxSubSteps, timeSubStep);
 }
 
+int RB_dworld_get_num_contact_pairs(rbDynamicsWorld *world)
+{
+  btDispatcher *dispatcher = world->dynamicsWorld->getDispatcher();
+  int num_pairs = 0;
+
+  for (int i = 0; i < dispatcher->getNumManifolds(); i++) {
+    if (dispatcher->getManifoldByIndexInternal(i)->getNumContacts() > 0) {
+      num_pairs++;
+    }
+  }
+  return num_pairs;
+}
+
 /* Export -------------------------- */
 
 /**
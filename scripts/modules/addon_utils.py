@@ -396,6 +396,10 @@ def enable(module_name, *, default_set=False, persistent=False, handle_error=Non
     # Split registering up into 3 steps so we can undo
     # if it fails par way through.
 
+    if (use_time := _bpy.app.debug_startup):
+        import time
+        time_import = time.time()
+
     # Disable the context: using the context at all
     # while loading an addon is really bad, don't do it!
     with RestrictBlend():
@@ -483,6 +487,9 @@ def enable(module_name, *, default_set=False, persistent=False, handle_error=Non
         owner_id_prev = _bl_owner_id_get()
         _bl_owner_id_set(module_name)
 
+        if use_time:
+            time_register = time.time()
+
         # 3) Try run the modules register function.
         try:
             mod.register()
@@ -503,6 +510,12 @@ def enable(module_name, *, default_set=False, persistent=False, handle_error=Non
     if _bpy.app.debug_python:
         print("\taddon_utils.enable", mod.__name__)
 
+    if use_time:
+        time_end = time.time()
+        print("Add-on {:s}: import {:.4f} s, register {:.4f} s".format(
+            mod.__name__, time_register - time_import, time_end - time_register,
+        ))
+
     return mod
 
 
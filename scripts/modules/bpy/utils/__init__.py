@@ -124,7 +124,7 @@ def execfile(filepath, *, mod=None):
 
 
 def _test_import(module_name, loaded_modules):
-    use_time = _bpy.app.debug_python
+    use_time = _bpy.app.debug_python or _bpy.app.debug_startup
 
     if module_name in loaded_modules:
         return None
@@ -211,7 +211,8 @@ def load_scripts(*, reload_scripts=False, refresh_scripts=False, extensions=True
     :arg extensions: Loads additional scripts (add-ons & app-templates).
     :type extensions: bool
     """
-    use_time = use_class_register_check = _bpy.app.debug_python
+    use_class_register_check = _bpy.app.debug_python
+    use_time = use_class_register_check or _bpy.app.debug_startup
     use_user = not _is_factory_startup
 
     if use_time:
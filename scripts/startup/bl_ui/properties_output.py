@@ -470,6 +470,9 @@ class RENDER_PT_encoding_video(RenderOutputButtonsPanel, Panel):
         if use_crf:
             layout.prop(ffmpeg, "constant_rate_factor")
 
+        if needs_codec and ffmpeg.codec in {'H264', 'AV1'}:
+            layout.prop(ffmpeg, "use_hardware_encoder")
+
         # Encoding speed
         layout.prop(ffmpeg, "ffmpeg_preset")
         # I-frames
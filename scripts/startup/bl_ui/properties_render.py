@@ -1161,6 +1161,7 @@ class RENDER_PT_eevee_performance_memory(RenderButtonsPanel, Panel):
         props = scene.eevee
 
         layout.prop(props, "shadow_pool_size", text="Shadow Pool")
+        layout.prop(props, "use_shadow_static_cache")
         layout.prop(props, "gi_irradiance_pool_size", text="Light Probes Volume Pool")
 
 
@@ -820,6 +820,7 @@ class NODE_PT_backdrop(Panel):
         col.prop(snode, "backdrop_zoom", text="Zoom")
 
         col.prop(snode, "backdrop_offset", text="Offset")
+        col.prop(snode, "use_backdrop_visible_region")
 
         col.separator()
 
@@ -2402,6 +2402,22 @@ class SEQUENCER_PT_cache_settings(SequencerButtonsPanel, Panel):
         col.prop(ed, "use_cache_composite", text="Composite")
         col.prop(ed, "use_cache_final", text="Final")
 
+        if context.preferences.system.use_sequencer_disk_cache:
+            col = layout.column(heading="Disk Cache", align=True)
+            col.label(
+                text=rpt_("{:d} hits, {:d} misses").format(ed.disk_cache_hits, ed.disk_cache_misses),
+                translate=False,
+            )
+            col.label(
+                text=rpt_("{:d} pending, {:d} skipped writes").format(
+                    ed.disk_cache_pending_writes, ed.disk_cache_skipped_writes),
+                translate=False,
+            )
+            col.label(
+                text=rpt_("Compression ratio {:.2f}").format(ed.disk_cache_compression_ratio),
+                translate=False,
+            )
+
 
 class SEQUENCER_PT_cache_view_settings(SequencerButtonsPanel, Panel):
     bl_label = "Display"
@@ -785,6 +785,7 @@ class USERPREF_PT_system_memory(SystemPanel, CenterAlignMixIn, Panel):
         col = layout.column()
         col.prop(edit, "undo_steps", text="Undo Steps")
         col.prop(edit, "undo_memory_limit", text="Undo Memory Limit")
+        col.prop(edit, "undo_compress_steps", text="Compress Undo Steps")
         col.prop(edit, "use_global_undo")
 
         layout.separator()
@@ -832,6 +833,8 @@ class USERPREF_PT_system_video_sequencer(SystemPanel, CenterAlignMixIn, Panel):
         layout.separator()
 
         layout.prop(system, "sequencer_proxy_setup")
+        layout.prop(system, "use_sequencer_hardware_decoding")
+        layout.prop(system, "use_sequencer_gpu_preview")
 
 
 # -----------------------------------------------------------------------------
@@ -907,6 +910,10 @@ class USERPREF_PT_viewport_textures(ViewportPanel, CenterAlignMixIn, Panel):
 
         col = layout.column()
         col.prop(system, "gl_texture_limit", text="Limit Size")
+        col.prop(system, "use_texture_streaming")
+        sub = col.column()
+        sub.active = system.use_texture_streaming
+        sub.prop(system, "texture_streaming_budget", text="Budget")
         col.prop(system, "anisotropic_filter")
         col.prop(system, "gl_clip_alpha", slider=True)
         col.prop(system, "image_draw_method", text="Image Display Method")
@@ -2889,6 +2896,9 @@ class USERPREF_PT_experimental_prototypes(ExperimentalPanel, Panel):
                 ({"property": "enable_overlay_next"}, ("blender/blender/issues/102179", "#102179")),
                 ({"property": "use_animation_baklava"}, ("/blender/blender/issues/120406", "#120406")),
                 ({"property": "enable_new_cpu_compositor"}, ("/blender/blender/issues/125968", "#125968")),
+                ({"property": "use_incremental_save"}, None),
+                ({"property": "use_async_save"}, None),
+                ({"property": "use_viewport_mesh_lod"}, None),
             ),
         )
 
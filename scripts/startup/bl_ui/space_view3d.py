@@ -3910,6 +3910,7 @@ class VIEW3D_MT_sculpt(Menu):
 
         # Rebuild BVH
         layout.operator("sculpt.optimize")
+        layout.operator("sculpt.sort_mesh_by_bvh")
 
         layout.operator(
             "sculpt.dynamic_topology_toggle", text="Dynamic Topology",
@@ -7365,6 +7366,7 @@ class VIEW3D_PT_overlay_guides(Panel):
         sub = split.column()
         sub.prop(overlay, "show_text", text="Text Info")
         sub.prop(overlay, "show_stats", text="Statistics")
+        sub.prop(overlay, "show_gpu_timings", text="GPU Timings")
         if view.region_3d.view_perspective == 'CAMERA':
             sub.prop(overlay, "show_camera_guides", text="Camera Guides")
 
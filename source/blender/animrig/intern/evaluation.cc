@@ -142,6 +142,8 @@ static EvaluationResult evaluate_keyframe_data(PointerRNA &animated_id_ptr,
   }
 
   EvaluationResult evaluation_result;
+  PathResolvedRNA anim_rna;
+  const char *resolved_rna_path = nullptr;
   for (FCurve *fcu : channelbag_for_slot->fcurves()) {
     /* Blatant copy of animsys_evaluate_fcurves(). */
 
@@ -149,9 +151,8 @@ static EvaluationResult evaluate_keyframe_data(PointerRNA &animated_id_ptr,
       continue;
     }
 
-    PathResolvedRNA anim_rna;
-    if (!BKE_animsys_rna_path_resolve(
-            &animated_id_ptr, fcu->rna_path, fcu->array_index, &anim_rna))
+    if (!BKE_animsys_rna_path_resolve_reuse(
+            &animated_id_ptr, fcu->rna_path, fcu->array_index, &resolved_rna_path, &anim_rna))
     {
       printf("Cannot resolve RNA path %s[%d] on ID %s\n",
              fcu->rna_path,
@@ -959,7 +959,38 @@ void blf_font_boundbox(
     FontBLF *font, const char *str, const size_t str_len, rcti *r_box, ResultBLF *r_info)
 {
   GlyphCacheBLF *gc = blf_glyph_cache_acquire(font);
-  blf_font_boundbox_ex(font, gc, str, str_len, r_box, r_info, 0);
+
+  /* Only short strings are cached, longer ones are rarely measured repeatedly. */
+  const size_t len = BLI_strnlen(str,
+                                 std::min<size_t>(str_len, STRING_BOUNDS_CACHE_STR_LEN_MAX + 1));
+  if (len > STRING_BOUNDS_CACHE_STR_LEN_MAX) {
+    blf_font_boundbox_ex(font, gc, str, str_len, r_box, r_info, 0);
+    blf_glyph_cache_release(font);
+    return;
+  }
+
+  StringBoundsKey key{std::string(str, len), font->flags & BLF_LAYOUT_FLAGS};
+  if (const StringBoundsBLF *bounds = gc->string_bounds.lookup_ptr(key)) {
+    *r_box = bounds->box;
+    if (r_info) {
+      r_info->lines = 1;
+      r_info->width = bounds->width;
+    }
+    blf_glyph_cache_release(font);
+    return;
+  }
+
+  ResultBLF info;
+  blf_font_boundbox_ex(font, gc, str, len, r_box, &info, 0);
+  if (r_info) {
+    *r_info = info;
+  }
+
+  if (gc->string_bounds.size() >= STRING_BOUNDS_CACHE_SIZE_MAX) {
+    gc->string_bounds.clear();
+  }
+  gc->string_bounds.add_new(std::move(key), {*r_box, info.width});
+
   blf_glyph_cache_release(font);
 }
 
@@ -9,12 +9,15 @@
 #pragma once
 
 #include <mutex>
+#include <string>
 
 #include "BLF_api.hh"
 
 #include "BLI_map.hh"
 #include "BLI_vector.hh"
 
+#include "DNA_vec_types.h"
+
 #include "GPU_texture.hh"
 #include "GPU_vertex_buffer.hh"
 
@@ -94,6 +97,16 @@ inline ft_pix ft_pix_from_float(float v)
 /** A value in the kerning cache that indicates it is not yet set. */
 #define KERNING_ENTRY_UNSET INT_MAX
 
+/** Longest string (in bytes) whose bounds are stored in #GlyphCacheBLF.string_bounds. */
+#define STRING_BOUNDS_CACHE_STR_LEN_MAX 256
+/** Number of strings in #GlyphCacheBLF.string_bounds before it is cleared. */
+#define STRING_BOUNDS_CACHE_SIZE_MAX 4096
+
+/** Font flags that change the glyphs or their positions, others only affect drawing. */
+#define BLF_LAYOUT_FLAGS \
+  (BLF_MONOCHROME | BLF_HINTING_NONE | BLF_HINTING_SLIGHT | BLF_HINTING_FULL | BLF_MONOSPACED | \
+   BLF_RENDER_SUBPIXELAA)
+
 struct BatchBLF {
   /** Can only batch glyph from the same font. */
   FontBLF *font;
@@ -133,6 +146,27 @@ struct GlyphCacheKey {
   }
 };
 
+struct StringBoundsKey {
+  std::string str;
+  /** The font flags that affect the glyph positions, see #BLF_LAYOUT_FLAGS. */
+  int flags;
+  friend bool operator==(const StringBoundsKey &a, const StringBoundsKey &b)
+  {
+    return a.flags == b.flags && a.str == b.str;
+  }
+  uint64_t hash() const
+  {
+    return blender::get_default_hash(str, flags);
+  }
+};
+
+/** Measurement of a string without word wrapping, see #blf_font_boundbox. */
+struct StringBoundsBLF {
+  rcti box;
+  /** The pen position after the last glyph, for #ResultBLF.width. */
+  int width;
+};
+
 struct GlyphCacheBLF {
   /** Font size. */
   float size;
@@ -151,6 +185,12 @@ struct GlyphCacheBLF {
   /** The glyphs. */
   blender::Map<GlyphCacheKey, std::unique_ptr<GlyphBLF>> glyphs;
 
+  /**
+   * Bounds of recently measured short strings. The UI measures the same labels many times per
+   * redraw, this avoids stepping over their glyphs and kerning again every time.
+   */
+  blender::Map<StringBoundsKey, StringBoundsBLF> string_bounds;
+
   /** Texture array, to draw the glyphs. */
   GPUTexture *texture;
   char *bitmap_result;
@@ -270,6 +270,19 @@ bool BKE_animsys_rna_path_resolve(struct PointerRNA *ptr,
                                   const char *rna_path,
                                   int array_index,
                                   struct PathResolvedRNA *r_result);
+/**
+ * Same as #BKE_animsys_rna_path_resolve, but reuses the previous resolution when the path is the
+ * same as the previously resolved one, which is common for consecutive F-Curves animating the
+ * elements of an array property (`location[0]`, `location[1]`, ...).
+ *
+ * \param r_prev_rna_path: The path  r_result was last resolved for, or null. Updated to
+ *  rna_path on success, and cleared on failure.
+ */
+bool BKE_animsys_rna_path_resolve_reuse(struct PointerRNA *ptr,
+                                        const char *rna_path,
+                                        int array_index,
+                                        const char **r_prev_rna_path,
+                                        struct PathResolvedRNA *r_result);
 bool BKE_animsys_read_from_rna_path(struct PathResolvedRNA *anim_rna, float *r_value);
 /**
  * Write the given value to a setting using RNA, and return success.
@@ -41,6 +41,14 @@ class BlobReader {
    */
   [[nodiscard]] virtual bool read_as_stream(const BlobSlice &slice,
                                             FunctionRef<bool(std::istream &)> fn) const;
+
+  /**
+   * Provides access to the data of the given slice without copying it, if the reader supports
+   * that (e.g. because the blob is memory-mapped). The returned sharing info keeps the data alive.
+   * The data may be modified by the owner once it's mutable, without affecting the stored blob.
+   * \return The shared data, or none if the data has to be read with #read instead.
+   */
+  virtual std::optional<ImplicitSharingInfoAndData> read_shared(const BlobSlice &slice) const;
 };
 
 /**
@@ -64,6 +72,20 @@ class BlobWriter {
                                     FunctionRef<void(std::ostream &)> fn);
 };
 
+/**
+ * How arrays are encoded when they are written to blobs.
+ */
+enum class BlobCompression {
+  /** Store the raw array data. */
+  None,
+  /**
+   * Group the bytes of the array elements by their position within an element and compress the
+   * result with Zstandard. This is lossless, and works well for attributes whose values change
+   * smoothly over the geometry. The array is split into chunks that are decoded in parallel.
+   */
+  ZstdShuffle,
+};
+
 /**
  * Allows deduplicating data before it's written.
  */
@@ -89,13 +111,24 @@ class BlobWriteSharing : NonCopyable, NonMovable {
    */
   Map<const ImplicitSharingInfo *, StoredByRuntimeValue> stored_by_runtime_;
 
+  struct StoredByContentHashValue {
+    BlobSlice slice;
+    /** Only used when the data was compressed, see #BlobCompression::ZstdShuffle. */
+    int64_t element_size = 0;
+    Vector<int64_t> compressed_chunk_sizes;
+  };
+
   /**
    * Remembers where data was stored based on the hash of the data. This allows us to skip writing
    * the same array again if it has the same hash.
    */
-  Map<uint64_t, BlobSlice> slice_by_content_hash_;
+  Map<uint64_t, StoredByContentHashValue> stored_by_content_hash_;
+
+  /** Encoding used for data passed to #write_deduplicated. */
+  BlobCompression compression_;
 
  public:
+  explicit BlobWriteSharing(BlobCompression compression = BlobCompression::None);
   ~BlobWriteSharing();
 
   /**
@@ -112,9 +145,10 @@ class BlobWriteSharing : NonCopyable, NonMovable {
    * Checks if the given data was written before. If it was, it's not written again, but a
    * reference to the previously written data is returned. If the data is new, it's written now.
    * Its hash is remembered so that the same data won't be written again.
+   * \param element_size: Size of the array elements, used to improve compression.
    */
   [[nodiscard]] std::shared_ptr<io::serialize::DictionaryValue> write_deduplicated(
-      BlobWriter &writer, const void *data, int64_t size_in_bytes);
+      BlobWriter &writer, const void *data, int64_t size_in_bytes, int64_t element_size = 1);
 };
 
 /**
@@ -148,14 +182,23 @@ class BlobReadSharing : NonCopyable, NonMovable {
  * A specific #BlobReader that reads from disk.
  */
 class DiskBlobReader : public BlobReader {
+ public:
+  struct MappedFile;
+
  private:
   const std::string blobs_dir_;
   mutable std::mutex mutex_;
   mutable Map<std::string, std::unique_ptr<fstream>> open_input_streams_;
+  /**
+   * Blob files that are memory-mapped for #read_shared. The mappings are kept alive by the shared
+   * data referencing them, so they may outlive the reader.
+   */
+  mutable Map<std::string, std::shared_ptr<MappedFile>> mapped_files_;
 
  public:
   DiskBlobReader(std::string blobs_dir);
   [[nodiscard]] bool read(const BlobSlice &slice, void *r_data) const override;
+  std::optional<ImplicitSharingInfoAndData> read_shared(const BlobSlice &slice) const override;
 };
 
 /**
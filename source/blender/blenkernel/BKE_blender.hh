@@ -50,6 +50,14 @@ void BKE_blender_userdef_app_template_data_set_and_free(UserDef *userdef);
  */
 void BKE_blender_userdef_data_free(UserDef *userdef, bool clear_fonts);
 
+/**
+ * Startup timing, printed with `--debug-startup`.
+ * Begin measuring at the very start of the application, each phase then ends where the next
+ * begins, so all phases together cover the whole startup.
+ */
+void BKE_blender_startup_timing_begin();
+void BKE_blender_startup_phase_end(const char *phase);
+
 /* Blenders' own atexit (avoids leaking) */
 void BKE_blender_atexit_register(void (*func)(void *user_data), void *user_data);
 void BKE_blender_atexit_unregister(void (*func)(void *user_data), const void *user_data);
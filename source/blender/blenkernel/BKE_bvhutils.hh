@@ -185,3 +185,8 @@ BVHCache *bvhcache_init();
  * Frees a BVH-cache.
  */
 void bvhcache_free(BVHCache *bvh_cache);
+/**
+ * Keep the cached trees after the vertex positions changed but not the topology, they are refit
+ * to the new positions when they are requested again.
+ */
+void bvhcache_tag_positions_changed(BVHCache *bvh_cache);
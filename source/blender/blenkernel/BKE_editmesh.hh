@@ -30,6 +30,19 @@ struct Mesh;
 struct Object;
 struct Scene;
 
+/**
+ * The kind of change made to a #BMEditMesh since the last depsgraph evaluation.
+ * Used to update only the draw buffers that depend on the modified data.
+ * Ordered from least to greatest, updates accumulate with `std::max`.
+ */
+enum eEditMeshUpdateType : int8_t {
+  BKE_EDITMESH_UPDATE_NONE = 0,
+  /** Only vertex coordinates were modified (e.g. while transforming). */
+  BKE_EDITMESH_UPDATE_DEFORM = 1,
+  /** Topology or any other data may have changed. */
+  BKE_EDITMESH_UPDATE_ALL = 2,
+};
+
 /**
  * This structure is used for mesh edit-mode.
  *
@@ -64,10 +77,22 @@ struct BMEditMesh {
    * Set #Main.is_memfile_undo_flush_needed when enabling.
    */
   char needs_flush_to_id;
+
+  /**
+   * Accumulated change since the last evaluation, see #BKE_editmesh_update_tag.
+   * Reset when the batch cache of the evaluated mesh is tagged dirty.
+   */
+  eEditMeshUpdateType pending_update = BKE_EDITMESH_UPDATE_NONE;
 };
 
 /* editmesh.cc */
 
+/**
+ * Accumulate the kind of change made to the edit-mesh before tagging it for a depsgraph update.
+ * Changes that are not tagged are treated as #BKE_EDITMESH_UPDATE_ALL.
+ */
+void BKE_editmesh_update_tag(BMEditMesh *em, eEditMeshUpdateType update_type);
+
 void BKE_editmesh_looptris_calc_ex(BMEditMesh *em, const BMeshCalcTessellation_Params *params);
 void BKE_editmesh_looptris_calc(BMEditMesh *em);
 void BKE_editmesh_looptris_calc_with_partial_ex(BMEditMesh *em,
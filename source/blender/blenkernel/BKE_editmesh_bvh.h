@@ -38,6 +38,13 @@ BMBVHTree *BKE_bmbvh_new(struct BMesh *bm,
                          int flag,
                          const float (*cos_cage)[3],
                          bool cos_cage_free);
+/**
+ * Refit the tree to new vertex coordinates, which is much faster than building a new tree.
+ * The looptris and the faces they belong to must not have changed since the tree was built.
+ *
+ * \note The tree isn't rebalanced, so after large deformations a new tree may be faster to query.
+ */
+void BKE_bmbvh_update_coords(BMBVHTree *tree, const float (*cos_cage)[3], bool cos_cage_free);
 void BKE_bmbvh_free(BMBVHTree *tree);
 struct BVHTree *BKE_bmbvh_tree_get(BMBVHTree *tree);
 
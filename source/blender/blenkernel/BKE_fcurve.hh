@@ -610,6 +610,11 @@ float evaluate_fcurve_driver(PathResolvedRNA *anim_rna,
  * Checks if the curve has valid keys, drivers or modifiers that produce an actual curve.
  */
 bool BKE_fcurve_is_empty(const FCurve *fcu);
+/**
+ * Checks if the curve evaluates to the same value on every frame, e.g. when all its keys hold
+ * the same value. Curves with drivers or modifiers are never considered constant.
+ */
+bool BKE_fcurve_is_constant(const FCurve *fcu);
 /**
  * Calculate the value of the given F-Curve at the given frame,
  * and store it's value in #FCurve.curval.
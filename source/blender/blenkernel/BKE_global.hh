@@ -221,6 +221,11 @@ enum {
   G_FLAG_GPU_BACKEND_FALLBACK = (1 << 17),
   G_FLAG_GPU_BACKEND_FALLBACK_QUIET = (1 << 18),
 
+  /**
+   * Launched with `--load-active-scene-only`: in background mode, files are opened with
+   * #BLO_READ_SKIP_UNREACHABLE_IDS.
+   */
+  G_FLAG_READ_ACTIVE_SCENE_ONLY = (1 << 19),
 };
 
 #define G_FLAG_INTERNET_OVERRIDE_PREF_ANY \
@@ -231,7 +236,7 @@ enum {
   (G_FLAG_SCRIPT_AUTOEXEC | G_FLAG_SCRIPT_OVERRIDE_PREF | G_FLAG_INTERNET_ALLOW | \
    G_FLAG_INTERNET_OVERRIDE_PREF_ONLINE | G_FLAG_INTERNET_OVERRIDE_PREF_OFFLINE | \
    G_FLAG_EVENT_SIMULATE | G_FLAG_USERPREF_NO_SAVE_ON_EXIT | G_FLAG_GPU_BACKEND_FALLBACK | \
-   G_FLAG_GPU_BACKEND_FALLBACK_QUIET | \
+   G_FLAG_GPU_BACKEND_FALLBACK_QUIET | G_FLAG_READ_ACTIVE_SCENE_ONLY | \
 \
    /* #BPY_python_reset is responsible for resetting these flags on file load. */ \
    G_FLAG_SCRIPT_AUTOEXEC_FAIL | G_FLAG_SCRIPT_AUTOEXEC_FAIL_QUIET)
@@ -268,13 +273,15 @@ enum {
   G_DEBUG_XR = (1 << 21),                    /* XR/OpenXR messages */
   G_DEBUG_XR_TIME = (1 << 22),               /* XR/OpenXR timing messages */
 
-  G_DEBUG_GHOST = (1 << 23),  /* Debug GHOST module. */
-  G_DEBUG_WINTAB = (1 << 24), /* Debug Wintab. */
+  G_DEBUG_GHOST = (1 << 23),   /* Debug GHOST module. */
+  G_DEBUG_WINTAB = (1 << 24),  /* Debug Wintab. */
+  G_DEBUG_STARTUP = (1 << 25), /* Startup timing per phase and add-on. */
 };
 
 #define G_DEBUG_ALL \
   (G_DEBUG | G_DEBUG_FFMPEG | G_DEBUG_PYTHON | G_DEBUG_EVENTS | G_DEBUG_WM | G_DEBUG_JOBS | \
-   G_DEBUG_FREESTYLE | G_DEBUG_DEPSGRAPH | G_DEBUG_IO | G_DEBUG_GHOST | G_DEBUG_WINTAB)
+   G_DEBUG_FREESTYLE | G_DEBUG_DEPSGRAPH | G_DEBUG_IO | G_DEBUG_GHOST | G_DEBUG_WINTAB | \
+   G_DEBUG_STARTUP)
 
 /** #Global.fileflags */
 enum {
@@ -96,6 +96,12 @@ class Drawing : public ::GreasePencilDrawing {
   Span<float3> curve_plane_normals() const;
   void tag_texture_matrices_changed();
   void tag_positions_changed();
+  /**
+   * Like #tag_positions_changed, but when only the positions of some curves changed. Existing
+   * fill triangles and normals of the other curves are kept, which is much faster for drawings
+   * with many strokes. The topology must not have changed.
+   */
+  void tag_positions_changed(const IndexMask &changed_curves);
   void tag_topology_changed();
 
   /**
@@ -354,6 +354,13 @@ void BKE_image_free_all_gputextures(struct Main *bmain);
  */
 void BKE_image_free_anim_gputextures(struct Main *bmain);
 void BKE_image_free_old_gputextures(struct Main *bmain);
+/**
+ * Increase the resolution of streamed image textures that have been drawn recently, within the
+ * texture streaming budget of the preferences. Needs an active GPU context.
+ *
+ * \return true when there are textures left to stream in, and another redraw is needed.
+ */
+bool BKE_image_stream_gputextures(struct Main *bmain);
 
 /**
  * Pack image to memory.
@@ -523,6 +530,16 @@ void BKE_image_file_format_set(struct Image *image,
                                int ftype,
                                const struct ImbFormatOptions *options);
 bool BKE_image_has_loaded_ibuf(struct Image *image);
+/**
+ * Load the buffers of many images at once, distinct images are loaded in parallel. Already loaded
+ * images are quick to skip. Only single file and UDIM images are loaded, including all tiles.
+ */
+void BKE_image_load_parallel(struct Image **images, int images_num);
+/**
+ * Load the images used by the shader nodes of materials and worlds with #BKE_image_load_parallel,
+ * instead of one by one on first use when the materials are synced for drawing.
+ */
+void BKE_image_load_shader_images(struct Main *bmain);
 /**
  * References the result, #BKE_image_release_ibuf is to be called to de-reference.
  * Use lock=NULL when calling #BKE_image_release_ibuf().
@@ -182,6 +182,12 @@ struct Main {
    */
   bool is_read_invalid;
 
+  /**
+   * When set, only some of the IDs of the blend-file were read (see
+   * #BLO_READ_SKIP_UNREACHABLE_IDS). Saving such a Main would lose the unread data.
+   */
+  bool is_partially_read;
+
   /**
    * True if this main is the 'GMAIN' of current Blender.
    *
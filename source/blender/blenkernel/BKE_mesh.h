@@ -41,6 +41,11 @@ enum eMeshBatchDirtyMode {
   BKE_MESH_BATCH_DIRTY_SHADING,
   BKE_MESH_BATCH_DIRTY_UVEDIT_ALL,
   BKE_MESH_BATCH_DIRTY_UVEDIT_SELECT,
+  /**
+   * Only vertex positions changed, the topology and all other attributes are unchanged.
+   * Buffers that don't depend on positions (indices, selection, UVs...) are kept.
+   */
+  BKE_MESH_BATCH_DIRTY_DEFORM,
 };
 
 /* `mesh.cc` */
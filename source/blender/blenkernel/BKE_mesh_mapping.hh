@@ -278,6 +278,7 @@ namespace blender::bke::mesh {
 
 Array<int> build_corner_to_face_map(OffsetIndices<int> faces);
 
+Array<int> build_vert_to_edge_indices(Span<int2> edges, OffsetIndices<int> offsets);
 GroupedSpan<int> build_vert_to_edge_map(Span<int2> edges,
                                         int verts_num,
                                         Array<int> &r_offsets,
@@ -299,11 +300,16 @@ GroupedSpan<int> build_vert_to_corner_map(Span<int> corner_verts,
                                           Array<int> &r_offsets,
                                           Array<int> &r_indices);
 
+Array<int> build_edge_to_corner_indices(Span<int> corner_edges, OffsetIndices<int> offsets);
 GroupedSpan<int> build_edge_to_corner_map(Span<int> corner_edges,
                                           int edges_num,
                                           Array<int> &r_offsets,
                                           Array<int> &r_indices);
 
+void build_edge_to_face_indices(OffsetIndices<int> faces,
+                                Span<int> corner_edges,
+                                OffsetIndices<int> offsets,
+                                MutableSpan<int> face_indices);
 GroupedSpan<int> build_edge_to_face_map(OffsetIndices<int> faces,
                                         Span<int> corner_edges,
                                         int edges_num,
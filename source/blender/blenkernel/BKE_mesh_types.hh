@@ -210,6 +210,19 @@ struct MeshRuntime {
   SharedCache<Array<int>> vert_to_corner_map_cache;
   /** Cache of face indices for each face corner. */
   SharedCache<Array<int>> corner_to_face_map_cache;
+  /** Cache of offsets for the vert to edge map. */
+  SharedCache<Array<int>> vert_to_edge_offset_cache;
+  /** Cache of indices for vert to edge map. */
+  SharedCache<Array<int>> vert_to_edge_map_cache;
+  /**
+   * Cache of offsets for edge to face/corner maps. The same offsets array is used to group
+   * indices for both the edge to face and edge to corner maps.
+   */
+  SharedCache<Array<int>> edge_to_face_offset_cache;
+  /** Cache of indices for edge to face map. */
+  SharedCache<Array<int>> edge_to_face_map_cache;
+  /** Cache of indices for edge to corner map. */
+  SharedCache<Array<int>> edge_to_corner_map_cache;
   /** Cache of data about edges not used by faces. See #Mesh::loose_edges(). */
   SharedCache<LooseEdgeCache> loose_edges_cache;
   /** Cache of data about vertices not used by edges. See #Mesh::loose_verts(). */
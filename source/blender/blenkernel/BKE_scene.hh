@@ -7,6 +7,8 @@
  * \ingroup bke
  */
 
+#include "BLI_function_ref.hh"
+#include "BLI_span.hh"
 #include "BLI_sys_types.h"
 
 struct Base;
@@ -192,6 +194,24 @@ void BKE_scene_graph_update_for_newframe(Depsgraph *depsgraph);
  */
 void BKE_scene_graph_update_for_newframe_ex(Depsgraph *depsgraph, bool clear_recalc);
 
+/**
+ * Evaluate the scene at all \a frames using up to \a max_graphs independent depsgraphs of the
+ * same scene and view layer as \a depsgraph, evaluated concurrently. Every new depsgraph is built
+ * on the calling thread with \a build_fn (e.g. #DEG_graph_build_from_view_layer), then each of
+ * them evaluates a subset of the frames in increasing order and \a fn is called from a worker
+ * thread with the evaluated depsgraph of every frame.
+ *
+ * Meant for exporters and bakes of content that doesn't depend on the previous frame: frame
+ * change handlers are not run, nothing is written back to original data and simulations are not
+ * stepped. \a fn must be thread-safe, it's called concurrently and not in the order of frames.
+ */
+void BKE_scene_graph_evaluate_frames_parallel(
+    Depsgraph *depsgraph,
+    blender::Span<float> frames,
+    int max_graphs,
+    blender::FunctionRef<void(Depsgraph *graph)> build_fn,
+    blender::FunctionRef<void(Depsgraph *graph, float frame)> fn);
+
 /**
  * Ensures given scene/view_layer pair has a valid, up-to-date depsgraph.
  *
@@ -4,6 +4,8 @@
 
 #pragma once
 
+#include <cstdint>
+
 #include "BLI_map.hh"
 #include "BLI_timeit.hh"
 #include "BLI_utility_mixins.hh"
@@ -19,6 +21,10 @@ class CompositorRuntime {
    * evaluation. */
   Map<bNodeInstanceKey, timeit::Nanoseconds> per_node_execution_time;
 
+  /* Per-node instance total size in bytes of the buffers allocated for the results of the
+   * corresponding node, during the last tree evaluation. */
+  Map<bNodeInstanceKey, int64_t> per_node_memory_usage;
+
   /* A dependency graph used for interactive compositing. This is initialized the first time it is
    * needed, and then kept persistent for the lifetime of the scene. This is done to allow the
    * compositor to track changes to resources its uses as well as reduce the overhead of creating
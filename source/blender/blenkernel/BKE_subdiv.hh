@@ -16,6 +16,9 @@ struct MultiresModifierData;
 struct OpenSubdiv_Converter;
 struct OpenSubdiv_Evaluator;
 class OpenSubdiv_TopologyRefiner;
+namespace blender {
+class ImplicitSharingInfo;
+}
 
 namespace blender::bke::subdiv {
 
@@ -182,6 +185,15 @@ struct Subdiv {
      */
     int *face_ptex_offset;
   } cache_;
+
+  /* Implicitly shared arrays of the mesh the topology refiner was last created from or compared
+   * with, see #update_from_mesh(). A user is held for each of them so they can't be modified in
+   * place: a mesh that still uses all of them has the same topology. */
+  struct {
+    const ImplicitSharingInfo **sharing_infos;
+    int sharing_infos_num;
+    int verts_num;
+  } mesh_topology_;
 };
 
 /* --------------------------------------------------------------------
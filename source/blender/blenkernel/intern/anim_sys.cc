@@ -392,6 +392,31 @@ bool BKE_animsys_rna_path_resolve(
   return true;
 }
 
+bool BKE_animsys_rna_path_resolve_reuse(PointerRNA *ptr,
+                                        const char *rna_path,
+                                        const int array_index,
+                                        const char **r_prev_rna_path,
+                                        PathResolvedRNA *r_result)
+{
+  if (rna_path != nullptr && *r_prev_rna_path != nullptr && STREQ(rna_path, *r_prev_rna_path)) {
+    /* Only the array index can differ from the previous resolution. */
+    const int array_len = RNA_property_array_length(&r_result->ptr, r_result->prop);
+    if (array_len && array_index >= array_len) {
+      *r_prev_rna_path = nullptr;
+      return false;
+    }
+    r_result->prop_index = array_len ? array_index : -1;
+    return true;
+  }
+
+  if (!BKE_animsys_rna_path_resolve(ptr, rna_path, array_index, r_result)) {
+    *r_prev_rna_path = nullptr;
+    return false;
+  }
+  *r_prev_rna_path = rna_path;
+  return true;
+}
+
 /* less than 1.0 evaluates to false, use epsilon to avoid float error */
 #define ANIMSYS_FLOAT_AS_BOOL(value) ((value) > (1.0f - FLT_EPSILON))
 
@@ -570,19 +595,37 @@ static void animsys_evaluate_fcurves(PointerRNA *ptr,
                                      const AnimationEvalContext *anim_eval_context,
                                      bool flush_to_original)
 {
+  /* The original data-block is written to as well, reusing its path resolution in the same
+   * way as for the evaluated one. */
+  PointerRNA ptr_orig;
+  if (flush_to_original && !animsys_construct_orig_pointer_rna(ptr, &ptr_orig)) {
+    flush_to_original = false;
+  }
+
   /* Calculate then execute each curve. */
+  PathResolvedRNA anim_rna;
+  const char *resolved_rna_path = nullptr;
+  PathResolvedRNA orig_anim_rna;
+  const char *orig_resolved_rna_path = nullptr;
   for (FCurve *fcu : fcurves) {
 
     if (!is_fcurve_evaluatable(fcu)) {
       continue;
     }
 
-    PathResolvedRNA anim_rna;
-    if (BKE_animsys_rna_path_resolve(ptr, fcu->rna_path, fcu->array_index, &anim_rna)) {
+    if (BKE_animsys_rna_path_resolve_reuse(
+            ptr, fcu->rna_path, fcu->array_index, &resolved_rna_path, &anim_rna))
+    {
       const float curval = calculate_fcurve(&anim_rna, fcu, anim_eval_context);
       BKE_animsys_write_to_rna_path(&anim_rna, curval);
-      if (flush_to_original) {
-        animsys_write_orig_anim_rna(ptr, fcu->rna_path, fcu->array_index, curval);
+      if (flush_to_original &&
+          BKE_animsys_rna_path_resolve_reuse(&ptr_orig,
+                                             fcu->rna_path,
+                                             fcu->array_index,
+                                             &orig_resolved_rna_path,
+                                             &orig_anim_rna))
+      {
+        BKE_animsys_write_to_rna_path(&orig_anim_rna, curval);
       }
     }
   }
@@ -752,6 +795,8 @@ static void animsys_evaluate_drivers(PointerRNA *ptr,
   /* drivers are stored as F-Curves, but we cannot use the standard code, as we need to check if
    * the depsgraph requested that this driver be evaluated...
    */
+  PathResolvedRNA anim_rna;
+  const char *resolved_rna_path = nullptr;
   LISTBASE_FOREACH (FCurve *, fcu, &adt->drivers) {
     ChannelDriver *driver = fcu->driver;
     bool ok = false;
@@ -764,8 +809,9 @@ static void animsys_evaluate_drivers(PointerRNA *ptr,
         /* evaluate this using values set already in other places
          * NOTE: for 'layering' option later on, we should check if we should remove old value
          * before adding new to only be done when drivers only changed. */
-        PathResolvedRNA anim_rna;
-        if (BKE_animsys_rna_path_resolve(ptr, fcu->rna_path, fcu->array_index, &anim_rna)) {
+        if (BKE_animsys_rna_path_resolve_reuse(
+                ptr, fcu->rna_path, fcu->array_index, &resolved_rna_path, &anim_rna))
+        {
           const float curval = calculate_fcurve(&anim_rna, fcu, anim_eval_context);
           ok = BKE_animsys_write_to_rna_path(&anim_rna, curval);
         }
@@ -851,11 +897,14 @@ void animsys_evaluate_action_group(PointerRNA *ptr,
     return;
   }
 
+  PathResolvedRNA anim_rna;
+  const char *resolved_rna_path = nullptr;
   const auto visit_fcurve = [&](FCurve *fcu) {
     /* check if this curve should be skipped */
     if ((fcu->flag & (FCURVE_MUTED | FCURVE_DISABLED)) == 0 && !BKE_fcurve_is_empty(fcu)) {
-      PathResolvedRNA anim_rna;
-      if (BKE_animsys_rna_path_resolve(ptr, fcu->rna_path, fcu->array_index, &anim_rna)) {
+      if (BKE_animsys_rna_path_resolve_reuse(
+              ptr, fcu->rna_path, fcu->array_index, &resolved_rna_path, &anim_rna))
+      {
         const float curval = calculate_fcurve(&anim_rna, fcu, anim_eval_context);
         BKE_animsys_write_to_rna_path(&anim_rna, curval);
       }
@@ -1606,6 +1655,25 @@ static NlaEvalChannel *nlaevalchan_verify(PointerRNA *ptr, NlaEvalData *nlaeval,
   return *p_path_nec = nec;
 }
 
+/**
+ * Like #nlaevalchan_verify, reusing the channel of the previous path when it's the same. F-Curves
+ * of the elements of an array property are usually consecutive, so this avoids hashing the path
+ * for every element.
+ */
+static NlaEvalChannel *nlaevalchan_verify_reuse(PointerRNA *ptr,
+                                                NlaEvalData *nlaeval,
+                                                const char *path,
+                                                const char **r_prev_path,
+                                                NlaEvalChannel **r_prev_nec)
+{
+  if (path != nullptr && *r_prev_path != nullptr && STREQ(path, *r_prev_path)) {
+    return *r_prev_nec;
+  }
+  *r_prev_path = path;
+  *r_prev_nec = nlaevalchan_verify(ptr, nlaeval, path);
+  return *r_prev_nec;
+}
+
 /* ---------------------- */
 
 /** \returns true if a solution exists and the output was written to. */
@@ -2665,6 +2733,9 @@ static void nlasnapshot_from_action(PointerRNA *ptr,
   const float modified_evaltime = evaluate_time_fmodifiers(
       &storage, modifiers, nullptr, 0.0f, evaltime);
 
+  const char *prev_rna_path = nullptr;
+  NlaEvalChannel *prev_nec = nullptr;
+
 #ifdef WITH_ANIM_BAKLAVA
   /* NOTE: This whole block of ugly code will disappear when the slotted Actions feature goes out
    * of Experimental.
@@ -2693,7 +2764,8 @@ static void nlasnapshot_from_action(PointerRNA *ptr,
       continue;
     }
 
-    NlaEvalChannel *nec = nlaevalchan_verify(ptr, channels, fcu->rna_path);
+    NlaEvalChannel *nec = nlaevalchan_verify_reuse(
+        ptr, channels, fcu->rna_path, &prev_rna_path, &prev_nec);
 
     /* Invalid path or property cannot be animated. */
     if (nec == nullptr) {
@@ -3127,13 +3199,18 @@ void nlasnapshot_blend_strip_no_blend(PointerRNA *ptr,
 void nladata_flush_channels(PointerRNA *ptr,
                             NlaEvalData *channels,
                             NlaEvalSnapshot *snapshot,
-                            const bool flush_to_original)
+                            bool flush_to_original)
 {
   /* sanity checks */
   if (channels == nullptr) {
     return;
   }
 
+  PointerRNA ptr_orig;
+  if (flush_to_original && !animsys_construct_orig_pointer_rna(ptr, &ptr_orig)) {
+    flush_to_original = false;
+  }
+
   /* for each channel with accumulated values, write its value on the property it affects */
   LISTBASE_FOREACH (NlaEvalChannel *, nec, &channels->channels) {
     /**
@@ -3148,6 +3225,9 @@ void nladata_flush_channels(PointerRNA *ptr,
     NlaEvalChannelSnapshot *nec_snapshot = nlaeval_snapshot_find_channel(snapshot, nec);
 
     PathResolvedRNA rna = {nec->key.ptr, nec->key.prop, -1};
+    /* The path of the original data is only resolved once for all elements. */
+    const char *orig_resolved_rna_path = nullptr;
+    PathResolvedRNA orig_rna;
 
     for (int i = 0; i < nec_snapshot->length; i++) {
       if (BLI_BITMAP_TEST(nec->domain.ptr, i)) {
@@ -3156,8 +3236,11 @@ void nladata_flush_channels(PointerRNA *ptr,
           rna.prop_index = i;
         }
         BKE_animsys_write_to_rna_path(&rna, value);
-        if (flush_to_original) {
-          animsys_write_orig_anim_rna(ptr, nec->rna_path, rna.prop_index, value);
+        if (flush_to_original &&
+            BKE_animsys_rna_path_resolve_reuse(
+                &ptr_orig, nec->rna_path, rna.prop_index, &orig_resolved_rna_path, &orig_rna))
+        {
+          BKE_animsys_write_to_rna_path(&orig_rna, value);
         }
       }
     }
@@ -3176,6 +3259,9 @@ static void nla_eval_domain_action(PointerRNA *ptr,
     return;
   }
 
+  const char *prev_rna_path = nullptr;
+  NlaEvalChannel *prev_nec = nullptr;
+
 #ifdef WITH_ANIM_BAKLAVA
   /* NOTE: This whole block of ugly code will disappear when the slotted Actions feature goes out
    * of Experimental.
@@ -3205,7 +3291,8 @@ static void nla_eval_domain_action(PointerRNA *ptr,
       continue;
     }
 
-    NlaEvalChannel *nec = nlaevalchan_verify(ptr, channels, fcu->rna_path);
+    NlaEvalChannel *nec = nlaevalchan_verify_reuse(
+        ptr, channels, fcu->rna_path, &prev_rna_path, &prev_nec);
 
     if (nec != nullptr) {
       /* For quaternion properties, enable all sub-channels. */
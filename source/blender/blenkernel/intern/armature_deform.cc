@@ -17,12 +17,14 @@
 
 #include "MEM_guardedalloc.h"
 
+#include "BLI_array.hh"
 #include "BLI_listbase.h"
 #include "BLI_math_matrix.h"
 #include "BLI_math_rotation.h"
 #include "BLI_math_vector.h"
 #include "BLI_task.h"
 #include "BLI_utildefines.h"
+#include "BLI_vector.hh"
 
 #include "DNA_armature_types.h"
 #include "DNA_gpencil_legacy_types.h"
@@ -202,6 +204,7 @@ static float dist_bone_deform(const bPoseChannel *pchan,
 }
 
 static void pchan_bone_deform(const bPoseChannel *pchan,
+                              const bool use_bbone,
                               const float weight,
                               float vec[3],
                               DualQuat *dq,
@@ -210,13 +213,11 @@ static void pchan_bone_deform(const bPoseChannel *pchan,
                               const bool full_deform,
                               float *contrib)
 {
-  const Bone *bone = pchan->bone;
-
   if (!weight) {
     return;
   }
 
-  if (bone->segments > 1 && pchan->runtime.bbone_segments == bone->segments) {
+  if (use_bbone) {
     b_bone_deform(pchan, co, weight, vec, dq, mat, full_deform);
   }
   else {
@@ -235,6 +236,16 @@ static void pchan_bone_deform(const bPoseChannel *pchan,
  * #BKE_armature_deform_coords and related functions.
  * \{ */
 
+/** Deformation data of a vertex group, resolved once per evaluation rather than per weight. */
+struct ArmatureDeformGroup {
+  /** Deforming pose channel with the name of the group, null if there is none. */
+  const bPoseChannel *pchan = nullptr;
+  /** Whether the bone deforms with its B-Bone segments. */
+  bool use_bbone = false;
+  /** Whether the weight is multiplied by the bone's envelope. */
+  bool use_envelope_multiply = false;
+};
+
 struct ArmatureUserdata {
   const Object *ob_arm;
   const Mesh *me_target;
@@ -252,8 +263,11 @@ struct ArmatureUserdata {
   const MDeformVert *dverts;
   int dverts_len;
 
-  bPoseChannel **pchan_from_defbase;
-  int defbase_len;
+  /** Indexed by vertex group index, empty when vertex groups aren't used. */
+  blender::Span<ArmatureDeformGroup> deform_groups;
+
+  /** Deforming pose channels used for envelope deformation, gathered once for all vertices. */
+  blender::Span<const bPoseChannel *> envelope_pchans;
 
   float premat[4][4];
   float postmat[4][4];
@@ -277,7 +291,6 @@ static void armature_vert_task_with_dvert(const ArmatureUserdata *data,
   const int armature_def_nr = data->armature_def_nr;
 
   DualQuat sumdq, *dq = nullptr;
-  const bPoseChannel *pchan;
   float *co, dco[3];
   float sumvec[3], summat[3][3];
   float *vec = nullptr, (*smat)[3] = nullptr;
@@ -344,38 +357,35 @@ static void armature_vert_task_with_dvert(const ArmatureUserdata *data,
     uint j;
     for (j = dvert->totweight; j != 0; j--, dw++) {
       const uint index = dw->def_nr;
-      if (index < data->defbase_len && (pchan = data->pchan_from_defbase[index])) {
+      if (index >= data->deform_groups.size()) {
+        continue;
+      }
+      const ArmatureDeformGroup &group = data->deform_groups[index];
+      if (group.pchan) {
         float weight = dw->weight;
-        const Bone *bone = pchan->bone;
 
         deformed = 1;
 
-        if (bone && bone->flag & BONE_MULT_VG_ENV) {
+        if (group.use_envelope_multiply) {
+          const Bone *bone = group.pchan->bone;
           weight *= distfactor_to_bone(
               co, bone->arm_head, bone->arm_tail, bone->rad_head, bone->rad_tail, bone->dist);
         }
 
-        pchan_bone_deform(pchan, weight, vec, dq, smat, co, full_deform, &contrib);
+        pchan_bone_deform(
+            group.pchan, group.use_bbone, weight, vec, dq, smat, co, full_deform, &contrib);
       }
     }
     /* If there are vertex-groups but not groups with bones (like for soft-body groups). */
     if (deformed == 0 && use_envelope) {
-      for (pchan = static_cast<const bPoseChannel *>(data->ob_arm->pose->chanbase.first); pchan;
-           pchan = pchan->next)
-      {
-        if (!(pchan->bone->flag & BONE_NO_DEFORM)) {
-          contrib += dist_bone_deform(pchan, vec, dq, smat, co, full_deform);
-        }
+      for (const bPoseChannel *pchan : data->envelope_pchans) {
+        contrib += dist_bone_deform(pchan, vec, dq, smat, co, full_deform);
       }
     }
   }
   else if (use_envelope) {
-    for (pchan = static_cast<const bPoseChannel *>(data->ob_arm->pose->chanbase.first); pchan;
-         pchan = pchan->next)
-    {
-      if (!(pchan->bone->flag & BONE_NO_DEFORM)) {
-        contrib += dist_bone_deform(pchan, vec, dq, smat, co, full_deform);
-      }
+    for (const bPoseChannel *pchan : data->envelope_pchans) {
+      contrib += dist_bone_deform(pchan, vec, dq, smat, co, full_deform);
     }
   }
 
@@ -493,11 +503,10 @@ static void armature_deform_coords_impl(const Object *ob_arm,
                                         const BMEditMesh *em_target)
 {
   const bArmature *arm = static_cast<const bArmature *>(ob_arm->data);
-  bPoseChannel **pchan_from_defbase = nullptr;
+  blender::Array<ArmatureDeformGroup> deform_groups;
   const bool use_envelope = (deformflag & ARM_DEF_ENVELOPE) != 0;
   const bool use_quaternion = (deformflag & ARM_DEF_QUATERNION) != 0;
   const bool invert_vgroup = (deformflag & ARM_DEF_INVERT_VGROUP) != 0;
-  int defbase_len = 0; /* safety for vertexgroup index overflow */
   bool use_dverts = false;
   int armature_def_nr = -1;
   int cd_dvert_offset = -1;
@@ -517,7 +526,6 @@ static void armature_deform_coords_impl(const Object *ob_arm,
   if (BKE_object_supports_vertex_groups(ob_target)) {
     /* Collect the vertex group names from the evaluated data. */
     armature_def_nr = BLI_findstringindex(defbase, defgrp_name, offsetof(bDeformGroup, name));
-    defbase_len = BLI_listbase_count(defbase);
 
     /* get a vertex-deform-index to posechannel array */
     if (deformflag & ARM_DEF_VGROUP) {
@@ -534,26 +542,35 @@ static void armature_deform_coords_impl(const Object *ob_arm,
       }
 
       if (use_dverts) {
-        pchan_from_defbase = static_cast<bPoseChannel **>(
-            MEM_callocN(sizeof(*pchan_from_defbase) * defbase_len, "defnrToBone"));
-        /* TODO(sergey): Some considerations here:
-         *
-         * - Check whether keeping this consistent across frames gives speedup.
-         */
+        /* The size of the array is also the safety for vertex group index overflow. */
+        deform_groups.reinitialize(BLI_listbase_count(defbase));
         int i;
-        LISTBASE_FOREACH_INDEX (bDeformGroup *, dg, defbase, i) {
-          pchan_from_defbase[i] = BKE_pose_channel_find_name(ob_arm->pose, dg->name);
+        LISTBASE_FOREACH_INDEX (const bDeformGroup *, dg, defbase, i) {
+          const bPoseChannel *pchan = BKE_pose_channel_find_name(ob_arm->pose, dg->name);
           /* exclude non-deforming bones */
-          if (pchan_from_defbase[i]) {
-            if (pchan_from_defbase[i]->bone->flag & BONE_NO_DEFORM) {
-              pchan_from_defbase[i] = nullptr;
-            }
+          if (pchan == nullptr || (pchan->bone->flag & BONE_NO_DEFORM)) {
+            continue;
           }
+          const Bone *bone = pchan->bone;
+          ArmatureDeformGroup &group = deform_groups[i];
+          group.pchan = pchan;
+          group.use_bbone = bone->segments > 1 && pchan->runtime.bbone_segments == bone->segments;
+          group.use_envelope_multiply = (bone->flag & BONE_MULT_VG_ENV) != 0;
         }
       }
     }
   }
 
+  /* Avoid walking the list of pose channels and checking their flags for every vertex. */
+  blender::Vector<const bPoseChannel *> envelope_pchans;
+  if (use_envelope) {
+    LISTBASE_FOREACH (const bPoseChannel *, pchan, &ob_arm->pose->chanbase) {
+      if (!(pchan->bone->flag & BONE_NO_DEFORM)) {
+        envelope_pchans.append(pchan);
+      }
+    }
+  }
+
   ArmatureUserdata data{};
   data.ob_arm = ob_arm;
   data.me_target = me_target;
@@ -567,8 +584,8 @@ static void armature_deform_coords_impl(const Object *ob_arm,
   data.armature_def_nr = armature_def_nr;
   data.dverts = dverts.data();
   data.dverts_len = dverts.size();
-  data.pchan_from_defbase = pchan_from_defbase;
-  data.defbase_len = defbase_len;
+  data.deform_groups = deform_groups;
+  data.envelope_pchans = envelope_pchans;
   data.bmesh.cd_dvert_offset = cd_dvert_offset;
 
   float obinv[4][4];
@@ -600,10 +617,6 @@ static void armature_deform_coords_impl(const Object *ob_arm,
     settings.min_iter_per_thread = 32;
     BLI_task_parallel_range(0, vert_coords_len, &data, armature_vert_task, &settings);
   }
-
-  if (pchan_from_defbase) {
-    MEM_freeN(pchan_from_defbase);
-  }
 }
 
 void BKE_armature_deform_coords_with_gpencil_stroke(const Object *ob_arm,
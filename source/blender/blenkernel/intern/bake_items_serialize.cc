@@ -16,7 +16,9 @@
 #include "BLI_endian_defines.h"
 #include "BLI_endian_switch.h"
 #include "BLI_math_matrix_types.hh"
+#include "BLI_mmap.h"
 #include "BLI_path_util.h"
+#include "BLI_task.hh"
 
 #include "DNA_material_types.h"
 #include "DNA_volume_types.h"
@@ -24,9 +26,17 @@
 #include "RNA_access.hh"
 #include "RNA_enum_types.hh"
 
+#include <fcntl.h>
 #include <fmt/format.h>
 #include <sstream>
 #include <xxhash.h>
+#include <zstd.h>
+
+#ifdef _WIN32
+#  include <io.h>
+#else
+#  include <unistd.h>
+#endif
 
 #ifdef WITH_OPENVDB
 #  include <openvdb/io/Stream.h>
@@ -85,6 +95,23 @@ bool BlobReader::read_as_stream(const BlobSlice &slice, FunctionRef<bool(std::is
   return true;
 }
 
+std::optional<ImplicitSharingInfoAndData> BlobReader::read_shared(
+    const BlobSlice & /*slice*/) const
+{
+  return std::nullopt;
+}
+
+struct DiskBlobReader::MappedFile : NonCopyable, NonMovable {
+  BLI_mmap_file *mmap_file = nullptr;
+
+  ~MappedFile()
+  {
+    if (mmap_file) {
+      BLI_mmap_free(mmap_file);
+    }
+  }
+};
+
 DiskBlobReader::DiskBlobReader(std::string blobs_dir) : blobs_dir_(std::move(blobs_dir)) {}
 
 [[nodiscard]] bool DiskBlobReader::read(const BlobSlice &slice, void *r_data) const
@@ -108,6 +135,44 @@ DiskBlobReader::DiskBlobReader(std::string blobs_dir) : blobs_dir_(std::move(blo
   return true;
 }
 
+std::optional<ImplicitSharingInfoAndData> DiskBlobReader::read_shared(
+    const BlobSlice &slice) const
+{
+  if (slice.range.is_empty()) {
+    return std::nullopt;
+  }
+
+  char blob_path[FILE_MAX];
+  BLI_path_join(blob_path, sizeof(blob_path), blobs_dir_.c_str(), slice.name.c_str());
+
+  std::shared_ptr<MappedFile> mapped_file;
+  {
+    std::lock_guard lock{mutex_};
+    mapped_file = mapped_files_.lookup_or_add_cb_as(blob_path, [&]() {
+      auto new_mapped_file = std::make_shared<MappedFile>();
+      const int file = BLI_open(blob_path, O_BINARY | O_RDONLY, 0);
+      if (file != -1) {
+        /* The mapping stays valid after the file is closed. */
+        new_mapped_file->mmap_file = BLI_mmap_open(file);
+        close(file);
+      }
+      return new_mapped_file;
+    });
+  }
+  if (!mapped_file->mmap_file) {
+    return std::nullopt;
+  }
+  const int64_t file_size = int64_t(BLI_mmap_get_length(mapped_file->mmap_file));
+  if (slice.range.one_after_last() > file_size) {
+    return std::nullopt;
+  }
+  const char *data = static_cast<const char *>(BLI_mmap_get_pointer(mapped_file->mmap_file));
+  /* Pages are copy-on-write, so owners of the data can modify it once it's mutable. */
+  const ImplicitSharingInfo *sharing_info =
+      new ImplicitSharedValue<std::shared_ptr<MappedFile>>(std::move(mapped_file));
+  return ImplicitSharingInfoAndData{sharing_info, data + slice.range.start()};
+}
+
 DiskBlobWriter::DiskBlobWriter(std::string blob_dir, std::string base_name)
     : blob_dir_(std::move(blob_dir)), base_name_(std::move(base_name))
 {
@@ -146,6 +211,10 @@ BlobSlice DiskBlobWriter::write_as_stream(const StringRef file_extension,
   return {file_name, {0, written_bytes_num}};
 }
 
+BlobWriteSharing::BlobWriteSharing(const BlobCompression compression) : compression_(compression)
+{
+}
+
 BlobWriteSharing::~BlobWriteSharing()
 {
   for (const ImplicitSharingInfo *sharing_info : stored_by_runtime_.keys()) {
@@ -190,13 +259,115 @@ DictionaryValuePtr BlobWriteSharing::write_implicitly_shared(
       });
 }
 
+/**
+ * Number of array elements that are compressed together. Chunks are compressed and decompressed
+ * independently, so that multiple threads can work on the same array.
+ */
+static int64_t compressed_chunk_elements_num(const int64_t element_size)
+{
+  return std::max<int64_t>(1, (int64_t(1) << 20) / element_size);
+}
+
+/**
+ * Reorder the bytes so that the first bytes of all elements come first, then the second bytes,
+ * etc. Corresponding bytes of neighboring elements are often similar, so this makes the data
+ * compress better.
+ */
+static void shuffle_bytes(const Span<uint8_t> src, const int64_t element_size, uint8_t *dst)
+{
+  const int64_t elements_num = src.size() / element_size;
+  for (const int64_t i : IndexRange(elements_num)) {
+    for (const int64_t byte : IndexRange(element_size)) {
+      dst[byte * elements_num + i] = src[i * element_size + byte];
+    }
+  }
+}
+
+static void unshuffle_bytes(const Span<uint8_t> src, const int64_t element_size, uint8_t *dst)
+{
+  const int64_t elements_num = src.size() / element_size;
+  for (const int64_t byte : IndexRange(element_size)) {
+    for (const int64_t i : IndexRange(elements_num)) {
+      dst[i * element_size + byte] = src[byte * elements_num + i];
+    }
+  }
+}
+
+static std::optional<Vector<int64_t>> write_compressed(BlobWriter &writer,
+                                                       const Span<uint8_t> data,
+                                                       const int64_t element_size,
+                                                       BlobSlice &r_slice)
+{
+  const int64_t chunk_size = compressed_chunk_elements_num(element_size) * element_size;
+  const int64_t chunks_num = divide_ceil_u(data.size(), chunk_size);
+  Array<Vector<uint8_t>> compressed_chunks(chunks_num);
+  std::atomic<bool> success = true;
+  threading::parallel_for(IndexRange(chunks_num), 1, [&](const IndexRange range) {
+    Vector<uint8_t> shuffled;
+    for (const int64_t chunk : range) {
+      const Span<uint8_t> chunk_data = data.slice_safe(chunk * chunk_size, chunk_size);
+      shuffled.resize(chunk_data.size());
+      shuffle_bytes(chunk_data, element_size, shuffled.data());
+      Vector<uint8_t> &compressed = compressed_chunks[chunk];
+      compressed.resize(ZSTD_compressBound(shuffled.size()));
+      const size_t compressed_size = ZSTD_compress(compressed.data(),
+                                                   compressed.size(),
+                                                   shuffled.data(),
+                                                   shuffled.size(),
+                                                   ZSTD_CLEVEL_DEFAULT);
+      if (ZSTD_isError(compressed_size)) {
+        success = false;
+        return;
+      }
+      compressed.resize(compressed_size);
+    }
+  });
+  if (!success) {
+    return std::nullopt;
+  }
+
+  Vector<int64_t> compressed_chunk_sizes;
+  Vector<uint8_t> buffer;
+  for (const Vector<uint8_t> &compressed : compressed_chunks) {
+    compressed_chunk_sizes.append(compressed.size());
+    buffer.extend(compressed);
+  }
+  r_slice = writer.write(buffer.data(), buffer.size());
+  return compressed_chunk_sizes;
+}
+
 std::shared_ptr<io::serialize::DictionaryValue> BlobWriteSharing::write_deduplicated(
-    BlobWriter &writer, const void *data, const int64_t size_in_bytes)
+    BlobWriter &writer, const void *data, const int64_t size_in_bytes, const int64_t element_size)
 {
   const uint64_t content_hash = XXH3_64bits(data, size_in_bytes);
-  const BlobSlice slice = slice_by_content_hash_.lookup_or_add_cb(
-      content_hash, [&]() { return writer.write(data, size_in_bytes); });
-  return slice.serialize();
+  const StoredByContentHashValue &stored = stored_by_content_hash_.lookup_or_add_cb(
+      content_hash, [&]() {
+        StoredByContentHashValue value;
+        if (compression_ == BlobCompression::ZstdShuffle && size_in_bytes > 0 &&
+            size_in_bytes % element_size == 0)
+        {
+          const Span<uint8_t> bytes(static_cast<const uint8_t *>(data), size_in_bytes);
+          if (std::optional<Vector<int64_t>> chunk_sizes = write_compressed(
+                  writer, bytes, element_size, value.slice))
+          {
+            value.element_size = element_size;
+            value.compressed_chunk_sizes = std::move(*chunk_sizes);
+            return value;
+          }
+        }
+        value.slice = writer.write(data, size_in_bytes);
+        return value;
+      });
+  std::shared_ptr<DictionaryValue> io_data = stored.slice.serialize();
+  if (!stored.compressed_chunk_sizes.is_empty()) {
+    io_data->append_str("compression", "zstd_shuffle");
+    io_data->append_int("element_size", stored.element_size);
+    ArrayValue &io_chunk_sizes = *io_data->append_array("chunk_sizes");
+    for (const int64_t chunk_size : stored.compressed_chunk_sizes) {
+      io_chunk_sizes.append_int(chunk_size);
+    }
+  }
+  return io_data;
 }
 
 std::optional<ImplicitSharingInfoAndData> BlobReadSharing::read_shared(
@@ -273,32 +444,109 @@ static std::shared_ptr<DictionaryValue> write_blob_raw_data_with_endian(
     BlobWriter &blob_writer,
     BlobWriteSharing &blob_sharing,
     const void *data,
-    const int64_t size_in_bytes)
+    const int64_t size_in_bytes,
+    const int64_t element_size)
 {
-  auto io_data = blob_sharing.write_deduplicated(blob_writer, data, size_in_bytes);
+  auto io_data = blob_sharing.write_deduplicated(blob_writer, data, size_in_bytes, element_size);
   if (ENDIAN_ORDER == B_ENDIAN) {
     io_data->append_str("endian", get_endian_io_name(ENDIAN_ORDER));
   }
   return io_data;
 }
 
+[[nodiscard]] static bool read_blob_zstd_shuffle(const BlobReader &blob_reader,
+                                                 const DictionaryValue &io_data,
+                                                 const BlobSlice &slice,
+                                                 const int64_t bytes_num,
+                                                 void *r_data)
+{
+  const std::optional<int64_t> element_size = io_data.lookup_int("element_size");
+  const ArrayValue *io_chunk_sizes = io_data.lookup_array("chunk_sizes");
+  if (!element_size || *element_size <= 0 || !io_chunk_sizes) {
+    return false;
+  }
+  if (bytes_num % *element_size != 0) {
+    return false;
+  }
+  const int64_t chunk_size = compressed_chunk_elements_num(*element_size) * *element_size;
+  const int64_t chunks_num = divide_ceil_u(bytes_num, chunk_size);
+  if (io_chunk_sizes->elements().size() != chunks_num) {
+    return false;
+  }
+  Array<int64_t> chunk_offsets(chunks_num + 1);
+  chunk_offsets[0] = 0;
+  for (const int64_t chunk : IndexRange(chunks_num)) {
+    const IntValue *io_chunk_size = io_chunk_sizes->elements()[chunk]->as_int_value();
+    if (!io_chunk_size || io_chunk_size->value() < 0) {
+      return false;
+    }
+    chunk_offsets[chunk + 1] = chunk_offsets[chunk] + io_chunk_size->value();
+  }
+  if (chunk_offsets.last() != slice.range.size()) {
+    return false;
+  }
+
+  Array<uint8_t> compressed(slice.range.size(), NoInitialization());
+  if (!blob_reader.read(slice, compressed.data())) {
+    return false;
+  }
+  std::atomic<bool> success = true;
+  threading::parallel_for(IndexRange(chunks_num), 1, [&](const IndexRange range) {
+    Vector<uint8_t> shuffled;
+    for (const int64_t chunk : range) {
+      const int64_t chunk_start = chunk * chunk_size;
+      const IndexRange chunk_range(chunk_start, std::min(chunk_size, bytes_num - chunk_start));
+      shuffled.resize(chunk_range.size());
+      const size_t decompressed_size = ZSTD_decompress(
+          shuffled.data(),
+          shuffled.size(),
+          compressed.data() + chunk_offsets[chunk],
+          chunk_offsets[chunk + 1] - chunk_offsets[chunk]);
+      if (ZSTD_isError(decompressed_size) || decompressed_size != chunk_range.size()) {
+        success = false;
+        return;
+      }
+      unshuffle_bytes(
+          shuffled, *element_size, static_cast<uint8_t *>(r_data) + chunk_range.start());
+    }
+  });
+  return success;
+}
+
 /**
- * Read data of an into an array and optionally perform an endian switch if necessary.
+ * Read the data of a blob that has been written with #BlobWriteSharing::write_deduplicated.
  */
-[[nodiscard]] static bool read_blob_raw_data_with_endian(const BlobReader &blob_reader,
-                                                         const DictionaryValue &io_data,
-                                                         const int64_t element_size,
-                                                         const int64_t elements_num,
-                                                         void *r_data)
+[[nodiscard]] static bool read_blob_data(const BlobReader &blob_reader,
+                                         const DictionaryValue &io_data,
+                                         const int64_t bytes_num,
+                                         void *r_data)
 {
   const std::optional<BlobSlice> slice = BlobSlice::deserialize(io_data);
   if (!slice) {
     return false;
   }
-  if (slice->range.size() != element_size * elements_num) {
+  if (const std::optional<StringRefNull> compression = io_data.lookup_str("compression")) {
+    if (*compression == "zstd_shuffle") {
+      return read_blob_zstd_shuffle(blob_reader, io_data, *slice, bytes_num, r_data);
+    }
     return false;
   }
-  if (!blob_reader.read(*slice, r_data)) {
+  if (slice->range.size() != bytes_num) {
+    return false;
+  }
+  return blob_reader.read(*slice, r_data);
+}
+
+/**
+ * Read data of an into an array and optionally perform an endian switch if necessary.
+ */
+[[nodiscard]] static bool read_blob_raw_data_with_endian(const BlobReader &blob_reader,
+                                                         const DictionaryValue &io_data,
+                                                         const int64_t element_size,
+                                                         const int64_t elements_num,
+                                                         void *r_data)
+{
+  if (!read_blob_data(blob_reader, io_data, element_size * elements_num, r_data)) {
     return false;
   }
   const StringRefNull stored_endian = io_data.lookup_str("endian").value_or("little");
@@ -328,9 +576,10 @@ static std::shared_ptr<DictionaryValue> write_blob_raw_data_with_endian(
 static std::shared_ptr<DictionaryValue> write_blob_raw_bytes(BlobWriter &blob_writer,
                                                              BlobWriteSharing &blob_sharing,
                                                              const void *data,
-                                                             const int64_t size_in_bytes)
+                                                             const int64_t size_in_bytes,
+                                                             const int64_t element_size = 1)
 {
-  return blob_sharing.write_deduplicated(blob_writer, data, size_in_bytes);
+  return blob_sharing.write_deduplicated(blob_writer, data, size_in_bytes, element_size);
 }
 
 /** Read bytes ignoring endianness. */
@@ -339,14 +588,7 @@ static std::shared_ptr<DictionaryValue> write_blob_raw_bytes(BlobWriter &blob_wr
                                               const int64_t bytes_num,
                                               void *r_data)
 {
-  const std::optional<BlobSlice> slice = BlobSlice::deserialize(io_data);
-  if (!slice) {
-    return false;
-  }
-  if (slice->range.size() != bytes_num) {
-    return false;
-  }
-  return blob_reader.read(*slice, r_data);
+  return read_blob_data(blob_reader, io_data, bytes_num, r_data);
 }
 
 static std::shared_ptr<DictionaryValue> write_blob_simple_gspan(BlobWriter &blob_writer,
@@ -356,10 +598,11 @@ static std::shared_ptr<DictionaryValue> write_blob_simple_gspan(BlobWriter &blob
   const CPPType &type = data.type();
   BLI_assert(type.is_trivial());
   if (type.size() == 1 || type.is<ColorGeometry4b>()) {
-    return write_blob_raw_bytes(blob_writer, blob_sharing, data.data(), data.size_in_bytes());
+    return write_blob_raw_bytes(
+        blob_writer, blob_sharing, data.data(), data.size_in_bytes(), type.size());
   }
   return write_blob_raw_data_with_endian(
-      blob_writer, blob_sharing, data.data(), data.size_in_bytes());
+      blob_writer, blob_sharing, data.data(), data.size_in_bytes(), type.size());
 }
 
 [[nodiscard]] static bool read_blob_simple_gspan(const BlobReader &blob_reader,
@@ -398,6 +641,44 @@ static std::shared_ptr<DictionaryValue> write_blob_simple_gspan(BlobWriter &blob
   return false;
 }
 
+/**
+ * Reference the data in the blob directly instead of copying it, which is possible when the
+ * reader supports it and the stored data can be used as is.
+ */
+static std::optional<ImplicitSharingInfoAndData> read_blob_simple_gspan_mapped(
+    const BlobReader &blob_reader,
+    const DictionaryValue &io_data,
+    const CPPType &type,
+    const int64_t size)
+{
+  const bool is_raw_bytes = type.size() == 1 || type.is<ColorGeometry4b>();
+  if (!is_raw_bytes) {
+    const StringRefNull stored_endian = io_data.lookup_str("endian").value_or("little");
+    if (stored_endian != get_endian_io_name(ENDIAN_ORDER)) {
+      return std::nullopt;
+    }
+  }
+  if (io_data.lookup("compression")) {
+    return std::nullopt;
+  }
+  const std::optional<BlobSlice> slice = BlobSlice::deserialize(io_data);
+  if (!slice) {
+    return std::nullopt;
+  }
+  if (slice->range.size() != type.size() * size) {
+    return std::nullopt;
+  }
+  std::optional<ImplicitSharingInfoAndData> mapped_data = blob_reader.read_shared(*slice);
+  if (!mapped_data) {
+    return std::nullopt;
+  }
+  if (uintptr_t(mapped_data->data) % type.alignment() != 0) {
+    mapped_data->sharing_info->remove_user_and_delete_if_last();
+    return std::nullopt;
+  }
+  return mapped_data;
+}
+
 static std::shared_ptr<DictionaryValue> write_blob_shared_simple_gspan(
     BlobWriter &blob_writer,
     BlobWriteSharing &blob_sharing,
@@ -419,6 +700,11 @@ static std::shared_ptr<DictionaryValue> write_blob_shared_simple_gspan(
   const char *func = __func__;
   const std::optional<ImplicitSharingInfoAndData> sharing_info_and_data = blob_sharing.read_shared(
       io_data, [&]() -> std::optional<ImplicitSharingInfoAndData> {
+        if (std::optional<ImplicitSharingInfoAndData> mapped_data = read_blob_simple_gspan_mapped(
+                blob_reader, io_data, cpp_type, size))
+        {
+          return mapped_data;
+        }
         void *data_mem = MEM_mallocN_aligned(size * cpp_type.size(), cpp_type.alignment(), func);
         if (!read_blob_simple_gspan(blob_reader, io_data, {cpp_type, data_mem, size})) {
           MEM_freeN(data_mem);
@@ -16,6 +16,7 @@
 
 #include "BLI_listbase.h"
 #include "BLI_string.h"
+#include "BLI_time.h"
 #include "BLI_utildefines.h"
 
 #include "IMB_imbuf.hh"
@@ -450,6 +451,32 @@ void BKE_blender_userdef_app_template_data_set_and_free(UserDef *userdef)
 
 /** \} */
 
+/* -------------------------------------------------------------------- */
+/** \name Blender Startup Timing
+ * \{ */
+
+static double startup_begin_time = 0.0;
+static double startup_phase_begin_time = 0.0;
+
+void BKE_blender_startup_timing_begin()
+{
+  startup_begin_time = startup_phase_begin_time = BLI_time_now_seconds();
+}
+
+void BKE_blender_startup_phase_end(const char *phase)
+{
+  const double time = BLI_time_now_seconds();
+  if (G.debug & G_DEBUG_STARTUP) {
+    printf("Startup: %-36s %8.4f s (total %.4f s)\n",
+           phase,
+           time - startup_phase_begin_time,
+           time - startup_begin_time);
+  }
+  startup_phase_begin_time = time;
+}
+
+/** \} */
+
 /* -------------------------------------------------------------------- */
 /** \name Blender's AtExit
  *
@@ -5,12 +5,14 @@
 /** \file
  * \ingroup bke
  */
+#include <algorithm>
 #include <array>
 #include <optional>
 
 #include "MEM_guardedalloc.h"
 
 #include "DNA_brush_types.h"
+#include "DNA_color_types.h"
 #include "DNA_defaults.h"
 #include "DNA_material_types.h"
 #include "DNA_scene_types.h"
@@ -1498,6 +1500,72 @@ void BKE_brush_randomize_texture_coords(UnifiedPaintSettings *ups, bool mask)
   }
 }
 
+/**
+ * Multiply the factors by the falloff of the distances relative to the brush radius, where the
+ * falloff function is given the normalized distance from the radius. The loop is written without
+ * branches so that compilers can vectorize it, the falloff is computed for all distances and only
+ * selected for the ones inside the radius.
+ */
+template<typename Fn>
+static void brush_apply_curve_falloff(const blender::Span<float> distances,
+                                      const float brush_radius,
+                                      const blender::MutableSpan<float> factors,
+                                      const Fn &falloff)
+{
+  const float radius_rcp = blender::math::rcp(brush_radius);
+  for (const int i : distances.index_range()) {
+    const float distance = distances[i];
+    /* Clamp to keep the falloff functions in their domain outside of the radius. */
+    const float factor = std::max(1.0f - distance * radius_rcp, 0.0f);
+    factors[i] = distance < brush_radius ? factors[i] * falloff(factor) : 0.0f;
+  }
+}
+
+/**
+ * Same as evaluating the custom curve with #BKE_curvemapping_evaluateF for each distance, but
+ * without the per-call range checks when the curve table covers the whole [0, 1] input range,
+ * which is the case for brush curves unless their clipping was disabled.
+ */
+static void brush_apply_custom_curve_falloff(const CurveMapping *cumap,
+                                             const blender::Span<float> distances,
+                                             const float brush_radius,
+                                             const blender::MutableSpan<float> factors)
+{
+  const float radius_rcp = blender::math::rcp(brush_radius);
+  const CurveMap &cuma = cumap->cm[0];
+  if (cuma.table == nullptr || cuma.mintable > 0.0f || cuma.maxtable < 1.0f) {
+    for (const int i : distances.index_range()) {
+      const float distance = distances[i];
+      if (distance >= brush_radius) {
+        factors[i] = 0.0f;
+        continue;
+      }
+      factors[i] *= BKE_curvemapping_evaluateF(cumap, 0, distance * radius_rcp);
+    }
+    return;
+  }
+
+  const CurveMapPoint *table = cuma.table;
+  const bool use_clip = cumap->flag & CUMA_DO_CLIP;
+  const float clip_min = cumap->clipr.ymin;
+  const float clip_max = cumap->clipr.ymax;
+  for (const int i : distances.index_range()) {
+    const float distance = distances[i];
+    if (distance >= brush_radius) {
+      factors[i] = 0.0f;
+      continue;
+    }
+    const float table_index = (distance * radius_rcp - cuma.mintable) * cuma.range;
+    const int index = std::clamp(int(table_index), 0, CM_TABLE - 1);
+    const float t = table_index - float(index);
+    float value = (1.0f - t) * table[index].y + t * table[index + 1].y;
+    if (use_clip) {
+      value = std::clamp(value, clip_min, clip_max);
+    }
+    factors[i] *= value;
+  }
+}
+
 void BKE_brush_calc_curve_factors(const eBrushCurvePreset preset,
                                   const CurveMapping *cumap,
                                   const blender::Span<float> distances,
@@ -1506,116 +1574,57 @@ void BKE_brush_calc_curve_factors(const eBrushCurvePreset preset,
 {
   BLI_assert(factors.size() == distances.size());
 
-  const float radius_rcp = blender::math::rcp(brush_radius);
   switch (preset) {
     case BRUSH_CURVE_CUSTOM: {
-      for (const int i : distances.index_range()) {
-        const float distance = distances[i];
-        if (distance >= brush_radius) {
-          factors[i] = 0.0f;
-          continue;
-        }
-        factors[i] *= BKE_curvemapping_evaluateF(cumap, 0, distance * radius_rcp);
-      }
+      brush_apply_custom_curve_falloff(cumap, distances, brush_radius, factors);
       break;
     }
     case BRUSH_CURVE_SHARP: {
-      for (const int i : distances.index_range()) {
-        const float distance = distances[i];
-        if (distance >= brush_radius) {
-          factors[i] = 0.0f;
-          continue;
-        }
-        const float factor = 1.0f - distance * radius_rcp;
-        factors[i] *= factor * factor;
-      }
+      brush_apply_curve_falloff(
+          distances, brush_radius, factors, [](const float factor) { return factor * factor; });
       break;
     }
     case BRUSH_CURVE_SMOOTH: {
-      for (const int i : distances.index_range()) {
-        const float distance = distances[i];
-        if (distance >= brush_radius) {
-          factors[i] = 0.0f;
-          continue;
-        }
-        const float factor = 1.0f - distance * radius_rcp;
-        factors[i] *= 3.0f * factor * factor - 2.0f * factor * factor * factor;
-      }
+      brush_apply_curve_falloff(distances, brush_radius, factors, [](const float factor) {
+        return 3.0f * factor * factor - 2.0f * factor * factor * factor;
+      });
       break;
     }
     case BRUSH_CURVE_SMOOTHER: {
-      for (const int i : distances.index_range()) {
-        const float distance = distances[i];
-        if (distance >= brush_radius) {
-          factors[i] = 0.0f;
-          continue;
-        }
-        const float factor = 1.0f - distance * radius_rcp;
-        factors[i] *= pow3f(factor) * (factor * (factor * 6.0f - 15.0f) + 10.0f);
-      }
+      brush_apply_curve_falloff(distances, brush_radius, factors, [](const float factor) {
+        return pow3f(factor) * (factor * (factor * 6.0f - 15.0f) + 10.0f);
+      });
       break;
     }
     case BRUSH_CURVE_ROOT: {
-      for (const int i : distances.index_range()) {
-        const float distance = distances[i];
-        if (distance >= brush_radius) {
-          factors[i] = 0.0f;
-          continue;
-        }
-        const float factor = 1.0f - distance * radius_rcp;
-        factors[i] *= sqrtf(factor);
-      }
+      brush_apply_curve_falloff(
+          distances, brush_radius, factors, [](const float factor) { return sqrtf(factor); });
       break;
     }
     case BRUSH_CURVE_LIN: {
-      for (const int i : distances.index_range()) {
-        const float distance = distances[i];
-        if (distance >= brush_radius) {
-          factors[i] = 0.0f;
-          continue;
-        }
-        const float factor = 1.0f - distance * radius_rcp;
-        factors[i] *= factor;
-      }
+      brush_apply_curve_falloff(
+          distances, brush_radius, factors, [](const float factor) { return factor; });
       break;
     }
     case BRUSH_CURVE_CONSTANT: {
       break;
     }
     case BRUSH_CURVE_SPHERE: {
-      for (const int i : distances.index_range()) {
-        const float distance = distances[i];
-        if (distance >= brush_radius) {
-          factors[i] = 0.0f;
-          continue;
-        }
-        const float factor = 1.0f - distance * radius_rcp;
-        factors[i] *= sqrtf(2 * factor - factor * factor);
-      }
+      brush_apply_curve_falloff(distances, brush_radius, factors, [](const float factor) {
+        return sqrtf(2 * factor - factor * factor);
+      });
       break;
     }
     case BRUSH_CURVE_POW4: {
-      for (const int i : distances.index_range()) {
-        const float distance = distances[i];
-        if (distance >= brush_radius) {
-          factors[i] = 0.0f;
-          continue;
-        }
-        const float factor = 1.0f - distance * radius_rcp;
-        factors[i] *= factor * factor * factor * factor;
-      }
+      brush_apply_curve_falloff(distances, brush_radius, factors, [](const float factor) {
+        return factor * factor * factor * factor;
+      });
       break;
     }
     case BRUSH_CURVE_INVSQUARE: {
-      for (const int i : distances.index_range()) {
-        const float distance = distances[i];
-        if (distance >= brush_radius) {
-          factors[i] = 0.0f;
-          continue;
-        }
-        const float factor = 1.0f - distance * radius_rcp;
-        factors[i] *= factor * (2.0f - factor);
-      }
+      brush_apply_curve_falloff(distances, brush_radius, factors, [](const float factor) {
+        return factor * (2.0f - factor);
+      });
       break;
     }
   }
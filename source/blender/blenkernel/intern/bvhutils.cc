@@ -11,6 +11,7 @@
 
 #include "BLI_math_geom.h"
 #include "BLI_task.h"
+#include "BLI_task.hh"
 
 #include "BKE_attribute.hh"
 #include "BKE_bvhutils.hh"
@@ -31,6 +32,11 @@ using blender::VArray;
 
 struct BVHCacheItem {
   bool is_filled;
+  /**
+   * The vertex positions changed since the tree was built. Its structure is still valid because
+   * the topology didn't change, but the bounds of the nodes have to be updated before it's used.
+   */
+  bool positions_changed;
   BVHTree *tree;
 };
 
@@ -70,7 +76,7 @@ static bool bvhcache_find(BVHCache **bvh_cache_p,
   }
   BVHCache *bvh_cache = *bvh_cache_p;
 
-  if (bvh_cache->items[type].is_filled) {
+  if (bvh_cache->items[type].is_filled && !bvh_cache->items[type].positions_changed) {
     *r_tree = bvh_cache->items[type].tree;
     return true;
   }
@@ -140,6 +146,24 @@ void bvhcache_free(BVHCache *bvh_cache)
   MEM_freeN(bvh_cache);
 }
 
+void bvhcache_tag_positions_changed(BVHCache *bvh_cache)
+{
+  for (int index = 0; index < BVHTREE_MAX_ITEM; index++) {
+    BVHCacheItem *item = &bvh_cache->items[index];
+    if (!item->is_filled) {
+      continue;
+    }
+    if (index == BVHTREE_FROM_FACES) {
+      /* Legacy tessellated faces are rarely used, just build the tree again. */
+      BLI_bvhtree_free(item->tree);
+      item->tree = nullptr;
+      item->is_filled = false;
+      continue;
+    }
+    item->positions_changed = true;
+  }
+}
+
 /**
  * BVH-tree balancing inside a mutex lock must be run in isolation. Balancing
  * is multithreaded, and we do not want the current thread to start another task
@@ -896,6 +920,119 @@ static BitVector<> corner_tris_no_hidden_map_get(const blender::OffsetIndices<in
   return corner_tris_mask;
 }
 
+/** \} */
+
+/* -------------------------------------------------------------------- */
+/** \name Refit
+ * \{ */
+
+/**
+ * Update the bounds of all leaves of a tree after the vertex positions changed and refit the
+ * tree to them. The leaves were inserted in the order of the elements in the mask, which doesn't
+ * depend on the positions, so the position of an element in the mask is the index of its leaf.
+ * Returns false when the tree doesn't match the elements anymore.
+ */
+template<typename Fn>
+static bool bvhtree_refit(BVHTree *tree,
+                          const int elems_num,
+                          const BitSpan elems_mask,
+                          const Fn &update_leaf)
+{
+  blender::IndexMaskMemory memory;
+  const blender::IndexMask mask = elems_mask.is_empty() ?
+                                      blender::IndexMask(elems_num) :
+                                      blender::IndexMask::from_bits(elems_mask, memory);
+  if (mask.size() != BLI_bvhtree_get_len(tree)) {
+    /* The elements changed even though only the positions were tagged as changed. */
+    return false;
+  }
+  mask.foreach_index(blender::GrainSize(1024), [&](const int elem, const int leaf) {
+    update_leaf(elem, leaf);
+  });
+  BLI_bvhtree_update_tree(tree);
+  return true;
+}
+
+static bool bvhtree_from_mesh_refit(BVHTree *tree,
+                                    const Mesh &mesh,
+                                    const BVHCacheType bvh_cache_type,
+                                    const Span<float3> positions,
+                                    const Span<blender::int2> edges,
+                                    const Span<int> corner_verts,
+                                    const Span<int3> corner_tris)
+{
+  using namespace blender;
+  using namespace blender::bke;
+
+  const auto refit_verts = [&](const BitSpan mask) {
+    return bvhtree_refit(tree, positions.size(), mask, [&](const int vert, const int leaf) {
+      BLI_bvhtree_update_node(tree, leaf, positions[vert], nullptr, 1);
+    });
+  };
+  const auto refit_edges = [&](const BitSpan mask) {
+    return bvhtree_refit(tree, edges.size(), mask, [&](const int edge, const int leaf) {
+      const float co[2][3] = {{UNPACK3(positions[edges[edge][0]])},
+                              {UNPACK3(positions[edges[edge][1]])}};
+      BLI_bvhtree_update_node(tree, leaf, co[0], nullptr, 2);
+    });
+  };
+  const auto refit_corner_tris = [&](const BitSpan mask) {
+    return bvhtree_refit(tree, corner_tris.size(), mask, [&](const int tri, const int leaf) {
+      const float co[3][3] = {{UNPACK3(positions[corner_verts[corner_tris[tri][0]]])},
+                              {UNPACK3(positions[corner_verts[corner_tris[tri][1]]])},
+                              {UNPACK3(positions[corner_verts[corner_tris[tri][2]]])}};
+      BLI_bvhtree_update_node(tree, leaf, co[0], nullptr, 3);
+    });
+  };
+
+  switch (bvh_cache_type) {
+    case BVHTREE_FROM_LOOSEVERTS: {
+      return refit_verts(mesh.loose_verts().is_loose_bits);
+    }
+    case BVHTREE_FROM_LOOSEVERTS_NO_HIDDEN: {
+      int mask_bits_act_len = -1;
+      return refit_verts(loose_verts_no_hidden_mask_get(mesh, &mask_bits_act_len));
+    }
+    case BVHTREE_FROM_VERTS: {
+      return refit_verts({});
+    }
+    case BVHTREE_FROM_LOOSEEDGES: {
+      return refit_edges(mesh.loose_edges().is_loose_bits);
+    }
+    case BVHTREE_FROM_LOOSEEDGES_NO_HIDDEN: {
+      int mask_bits_act_len = -1;
+      return refit_edges(loose_edges_no_hidden_mask_get(mesh, &mask_bits_act_len));
+    }
+    case BVHTREE_FROM_EDGES: {
+      return refit_edges({});
+    }
+    case BVHTREE_FROM_CORNER_TRIS_NO_HIDDEN: {
+      const AttributeAccessor attributes = mesh.attributes();
+      int mask_bits_act_len = -1;
+      return refit_corner_tris(corner_tris_no_hidden_map_get(
+          mesh.faces(),
+          *attributes.lookup_or_default(".hide_poly", AttrDomain::Face, false),
+          corner_tris.size(),
+          &mask_bits_act_len));
+    }
+    case BVHTREE_FROM_CORNER_TRIS: {
+      return refit_corner_tris({});
+    }
+    case BVHTREE_FROM_FACES:
+    case BVHTREE_MAX_ITEM:
+      /* Trees of legacy faces are freed instead, see #bvhcache_tag_positions_changed. */
+      BLI_assert_unreachable();
+      break;
+  }
+  return false;
+}
+
+/** \} */
+
+/* -------------------------------------------------------------------- */
+/** \name Mesh BVH Building
+ * \{ */
+
 BVHTree *BKE_bvhtree_from_mesh_get(BVHTreeFromMesh *data,
                                    const Mesh *mesh,
                                    const BVHCacheType bvh_cache_type,
@@ -935,6 +1072,31 @@ BVHTree *BKE_bvhtree_from_mesh_get(BVHTreeFromMesh *data,
     return data->tree;
   }
 
+  BVHCacheItem &item = (*bvh_cache_p)->items[bvh_cache_type];
+  if (item.is_filled) {
+    /* Refitting the tree after a deformation is much cheaper than building a new one, and the
+     * query performance is usually similar since the elements stay close to their neighbors. */
+    BLI_assert(item.positions_changed);
+    bool refit = true;
+    if (item.tree) {
+      blender::threading::isolate_task([&]() {
+        refit = bvhtree_from_mesh_refit(
+            item.tree, *mesh, bvh_cache_type, positions, edges, corner_verts, corner_tris);
+      });
+    }
+    if (refit) {
+      item.positions_changed = false;
+      data->tree = item.tree;
+      data->cached = true;
+      bvhcache_unlock(*bvh_cache_p, lock_started);
+      return data->tree;
+    }
+    BLI_bvhtree_free(item.tree);
+    item.tree = nullptr;
+    item.positions_changed = false;
+    item.is_filled = false;
+  }
+
   /* Create BVHTree. */
 
   switch (bvh_cache_type) {
@@ -1585,6 +1585,14 @@ void CurvesGeometry::blend_read(BlendDataReader &reader)
   if (this->curve_offsets) {
     this->runtime->curve_offsets_sharing_info = BLO_read_shared(
         &reader, &this->curve_offsets, [&]() {
+          if (const ImplicitSharingInfo *sharing_info = BLO_read_shared_from_mapping(
+                  &reader,
+                  &this->curve_offsets,
+                  sizeof(int) * (int64_t(this->curve_num) + 1),
+                  alignof(int)))
+          {
+            return sharing_info;
+          }
           BLO_read_int32_array(&reader, this->curve_num + 1, &this->curve_offsets);
           return implicit_sharing::info_for_mem_free(this->curve_offsets);
         });
@@ -5463,6 +5463,24 @@ static void blend_read_layer_data(BlendDataReader *reader, CustomDataLayer &laye
   }
 }
 
+/**
+ * Layers of trivial types don't need any processing after reading, so they can be used in-place
+ * from a memory-mapped file.
+ */
+static const ImplicitSharingInfo *blend_read_layer_data_from_mapping(BlendDataReader *reader,
+                                                                    CustomDataLayer &layer,
+                                                                    const int count)
+{
+  const LayerTypeInfo *type_info = layerType_getInfo(eCustomDataType(layer.type));
+  if (type_info == nullptr || type_info->copy || type_info->free ||
+      (layer.flag & CD_FLAG_EXTERNAL))
+  {
+    return nullptr;
+  }
+  return BLO_read_shared_from_mapping(
+      reader, &layer.data, int64_t(type_info->size) * count, type_info->alignment);
+}
+
 void CustomData_blend_read(BlendDataReader *reader, CustomData *data, const int count)
 {
   BLO_read_struct_array(reader, CustomDataLayer, data->totlayer, &data->layers);
@@ -5488,6 +5506,11 @@ void CustomData_blend_read(BlendDataReader *reader, CustomData *data, const int
     if (CustomData_verify_versions(data, i)) {
       layer->sharing_info = BLO_read_shared(
           reader, &layer->data, [&]() -> const ImplicitSharingInfo * {
+            if (const ImplicitSharingInfo *sharing_info = blend_read_layer_data_from_mapping(
+                    reader, *layer, count))
+            {
+              return sharing_info;
+            }
             blend_read_layer_data(reader, *layer, count);
             if (layer->data == nullptr) {
               return nullptr;
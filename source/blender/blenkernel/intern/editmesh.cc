@@ -66,6 +66,11 @@ BMEditMesh *BKE_editmesh_from_object(Object *ob)
   return ((Mesh *)ob->data)->runtime->edit_mesh.get();
 }
 
+void BKE_editmesh_update_tag(BMEditMesh *em, const eEditMeshUpdateType update_type)
+{
+  em->pending_update = std::max(em->pending_update, update_type);
+}
+
 void BKE_editmesh_looptris_calc_ex(BMEditMesh *em, const BMeshCalcTessellation_Params *params)
 {
   BMesh *bm = em->bm;
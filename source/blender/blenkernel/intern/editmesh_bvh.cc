@@ -11,6 +11,7 @@
 #include "BLI_kdopbvh.h"
 #include "BLI_math_geom.h"
 #include "BLI_math_vector.h"
+#include "BLI_task.hh"
 
 #include "BKE_editmesh.hh"
 
@@ -22,6 +23,11 @@ struct BMBVHTree {
   BVHTree *tree;
 
   Span<std::array<BMLoop *, 3>> looptris;
+  /**
+   * The looptri index of each leaf of the tree, only set when faces were filtered out,
+   * otherwise the leaves match the looptris.
+   */
+  int *leaf_looptris;
 
   BMesh *bm;
 
@@ -100,6 +106,12 @@ BMBVHTree *BKE_bmbvh_new_ex(BMesh *bm,
   f_test_prev = nullptr;
   test_fn_ret = false;
 
+  if (test_fn) {
+    bmtree->leaf_looptris = static_cast<int *>(
+        MEM_mallocN(sizeof(*bmtree->leaf_looptris) * size_t(tottri), __func__));
+  }
+
+  int leaf_index = 0;
   for (const int i : looptris.index_range()) {
     if (test_fn) {
       /* NOTE: the arrays won't align now! Take care. */
@@ -112,6 +124,7 @@ BMBVHTree *BKE_bmbvh_new_ex(BMesh *bm,
       if (!test_fn_ret) {
         continue;
       }
+      bmtree->leaf_looptris[leaf_index++] = i;
     }
 
     if (cos_cage) {
@@ -166,10 +179,56 @@ BMBVHTree *BKE_bmbvh_new(BMesh *bm,
   return BKE_bmbvh_new_ex(bm, looptris, flag, cos_cage, cos_cage_free, test_fn, nullptr);
 }
 
+void BKE_bmbvh_update_coords(BMBVHTree *bmtree,
+                             const float (*cos_cage)[3],
+                             const bool cos_cage_free)
+{
+  using namespace blender;
+
+  if (bmtree->cos_cage && bmtree->cos_cage_free && bmtree->cos_cage != cos_cage) {
+    MEM_freeN((void *)bmtree->cos_cage);
+  }
+  bmtree->cos_cage = cos_cage;
+  bmtree->cos_cage_free = cos_cage_free;
+
+  if (cos_cage) {
+    BM_mesh_elem_index_ensure(bmtree->bm, BM_VERT);
+  }
+
+  const Span<std::array<BMLoop *, 3>> looptris = bmtree->looptris;
+  const int *leaf_looptris = bmtree->leaf_looptris;
+  const int leaves_num = BLI_bvhtree_get_len(bmtree->tree);
+
+  /* Each leaf is written by a single thread, only the refit of the branches has to be serial. */
+  threading::parallel_for(IndexRange(leaves_num), 1024, [&](const IndexRange range) {
+    float cos[3][3];
+    for (const int leaf : range) {
+      const int i = leaf_looptris ? leaf_looptris[leaf] : leaf;
+      if (cos_cage) {
+        copy_v3_v3(cos[0], cos_cage[BM_elem_index_get(looptris[i][0]->v)]);
+        copy_v3_v3(cos[1], cos_cage[BM_elem_index_get(looptris[i][1]->v)]);
+        copy_v3_v3(cos[2], cos_cage[BM_elem_index_get(looptris[i][2]->v)]);
+      }
+      else {
+        copy_v3_v3(cos[0], looptris[i][0]->v->co);
+        copy_v3_v3(cos[1], looptris[i][1]->v->co);
+        copy_v3_v3(cos[2], looptris[i][2]->v->co);
+      }
+      BLI_bvhtree_update_node(bmtree->tree, leaf, (float *)cos, nullptr, 3);
+    }
+  });
+
+  BLI_bvhtree_update_tree(bmtree->tree);
+}
+
 void BKE_bmbvh_free(BMBVHTree *bmtree)
 {
   BLI_bvhtree_free(bmtree->tree);
 
+  if (bmtree->leaf_looptris) {
+    MEM_freeN(bmtree->leaf_looptris);
+  }
+
   if (bmtree->cos_cage && bmtree->cos_cage_free) {
     MEM_freeN((void *)bmtree->cos_cage);
   }
@@ -2503,6 +2503,32 @@ bool BKE_fcurve_is_empty(const FCurve *fcu)
          !list_has_suitable_fmodifier(&fcu->modifiers, 0, FMI_TYPE_GENERATE_CURVE);
 }
 
+bool BKE_fcurve_is_constant(const FCurve *fcu)
+{
+  if (fcu->driver != nullptr || !BLI_listbase_is_empty(&fcu->modifiers)) {
+    return false;
+  }
+  if (fcu->bezt) {
+    /* With equal keys and handles every interpolation mode and extrapolation is flat. */
+    const float value = fcu->bezt[0].vec[1][1];
+    for (const BezTriple &bezt : blender::Span(fcu->bezt, fcu->totvert)) {
+      if (bezt.vec[0][1] != value || bezt.vec[1][1] != value || bezt.vec[2][1] != value) {
+        return false;
+      }
+    }
+    return true;
+  }
+  if (fcu->fpt) {
+    const float value = fcu->fpt[0].vec[1];
+    for (const FPoint &fpt : blender::Span(fcu->fpt, fcu->totvert)) {
+      if (fpt.vec[1] != value) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
 float calculate_fcurve(PathResolvedRNA *anim_rna,
                        FCurve *fcu,
                        const AnimationEvalContext *anim_eval_context)
@@ -3836,22 +3836,21 @@ static void fluid_modifier_processDomain(FluidModifierData *fmd,
   read_cache = false;
   bake_cache = baking_data || baking_noise || baking_mesh || baking_particles || baking_guide;
 
-  bool next_data, next_noise, next_mesh, next_particles, next_guide;
-  next_data = manta_has_data(fds->fluid, fmd, next_frame);
-  next_noise = manta_has_noise(fds->fluid, fmd, next_frame);
-  next_mesh = manta_has_mesh(fds->fluid, fmd, next_frame);
-  next_particles = manta_has_particles(fds->fluid, fmd, next_frame);
-  next_guide = manta_has_guiding(fds->fluid, fmd, next_frame, guide_parent);
-
+  /* The cache files of the previous frame are only needed to decide what to bake in replay mode,
+   * and only of the enabled cache types. Checking for files can be slow on network storage, so
+   * avoid checks of which the result is never used. */
+  const bool check_prev = !ELEM(mode, FLUID_DOMAIN_CACHE_ALL, FLUID_DOMAIN_CACHE_MODULAR) &&
+                          !is_startframe;
   bool prev_data, prev_noise, prev_mesh, prev_particles, prev_guide;
-  prev_data = manta_has_data(fds->fluid, fmd, prev_frame);
-  prev_noise = manta_has_noise(fds->fluid, fmd, prev_frame);
-  prev_mesh = manta_has_mesh(fds->fluid, fmd, prev_frame);
-  prev_particles = manta_has_particles(fds->fluid, fmd, prev_frame);
-  prev_guide = manta_has_guiding(fds->fluid, fmd, prev_frame, guide_parent);
-
-  /* Unused for now. */
-  UNUSED_VARS(next_mesh, next_guide);
+  prev_data = check_prev && manta_has_data(fds->fluid, fmd, prev_frame);
+  prev_noise = check_prev && with_smoke && with_noise &&
+               manta_has_noise(fds->fluid, fmd, prev_frame);
+  prev_mesh = check_prev && with_liquid && with_mesh &&
+              manta_has_mesh(fds->fluid, fmd, prev_frame);
+  prev_particles = check_prev && with_liquid && with_particles &&
+                   manta_has_particles(fds->fluid, fmd, prev_frame);
+  prev_guide = check_prev && with_guide &&
+               manta_has_guiding(fds->fluid, fmd, prev_frame, guide_parent);
 
   bool with_gdomain;
   with_gdomain = (fds->guide_source == FLUID_DOMAIN_GUIDE_SRC_DOMAIN);
@@ -3924,12 +3923,27 @@ static void fluid_modifier_processDomain(FluidModifierData *fmd,
 
   /* Try to read from cache and keep track of read success. */
   if (read_cache) {
+    /* Whether the next frame is cached decides whether all grids are read, only needed for the
+     * enabled cache types. */
+    const bool next_data = manta_has_data(fds->fluid, fmd, next_frame);
+    const bool next_noise = with_smoke && with_noise &&
+                            manta_has_noise(fds->fluid, fmd, next_frame);
+    const bool next_particles = with_liquid && with_particles &&
+                                manta_has_particles(fds->fluid, fmd, next_frame);
+
+    /* Frame of the last read configuration, to avoid reading the same one multiple times when
+     * the different caches are read from the same frame. */
+    int config_frame = scene_framenr;
+    auto read_config = [&](const int frame) {
+      if (frame != scene_framenr && frame != config_frame) {
+        has_config = manta_read_config(fds->fluid, fmd, frame);
+        config_frame = frame;
+      }
+    };
 
     /* Read mesh cache. */
     if (with_liquid && with_mesh) {
-      if (mesh_frame != scene_framenr) {
-        has_config = manta_read_config(fds->fluid, fmd, mesh_frame);
-      }
+      read_config(mesh_frame);
 
       /* Only load the mesh at the resolution it ways originally simulated at.
        * The mesh files don't have a header, i.e. the don't store the grid resolution. */
@@ -3940,9 +3954,7 @@ static void fluid_modifier_processDomain(FluidModifierData *fmd,
 
     /* Read particles cache. */
     if (with_liquid && with_particles) {
-      if (particles_frame != scene_framenr) {
-        has_config = manta_read_config(fds->fluid, fmd, particles_frame);
-      }
+      read_config(particles_frame);
 
       read_partial = !baking_data && !baking_particles && next_particles;
       read_all = !read_partial && with_resumable_cache;
@@ -3957,9 +3969,7 @@ static void fluid_modifier_processDomain(FluidModifierData *fmd,
 
     /* Read noise and data cache */
     if (with_smoke && with_noise) {
-      if (noise_frame != scene_framenr) {
-        has_config = manta_read_config(fds->fluid, fmd, noise_frame);
-      }
+      read_config(noise_frame);
 
       /* Only reallocate when just reading cache or when resuming during bake. */
       if (has_data && has_config && manta_needs_realloc(fds->fluid, fmd)) {
@@ -3977,9 +3987,7 @@ static void fluid_modifier_processDomain(FluidModifierData *fmd,
     }
     /* Read data cache only */
     else {
-      if (data_frame != scene_framenr) {
-        has_config = manta_read_config(fds->fluid, fmd, data_frame);
-      }
+      read_config(data_frame);
 
       if (with_smoke) {
         /* Read config and realloc fluid object if needed. */
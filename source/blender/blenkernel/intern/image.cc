@@ -23,6 +23,7 @@
 #include <string>
 
 #include "BLI_array.hh"
+#include "BLI_index_range.hh"
 #include "BLI_string_utils.hh"
 
 #include "CLG_log.h"
@@ -56,10 +57,13 @@
 #include "BLI_mempool.h"
 #include "BLI_system.h"
 #include "BLI_task.h"
+#include "BLI_task.hh"
 #include "BLI_threads.h"
 #include "BLI_time.h"
 #include "BLI_timecode.h" /* For stamp time-code format. */
 #include "BLI_utildefines.h"
+#include "BLI_vector.hh"
+#include "BLI_vector_set.hh"
 
 #include "BLT_translation.hh"
 
@@ -136,6 +140,8 @@ static void image_runtime_reset_on_copy(Image *image)
 
   image->runtime.backdrop_offset[0] = 0.0f;
   image->runtime.backdrop_offset[1] = 0.0f;
+
+  image->runtime.gpu_stream_lod = 0;
 }
 
 static void image_runtime_free_data(Image *image)
@@ -349,6 +355,7 @@ static void image_blend_write(BlendWriter *writer, ID *id, const void *id_addres
   BLI_listbase_clear(&ima->anims);
   ima->runtime.partial_update_register = nullptr;
   ima->runtime.partial_update_user = nullptr;
+  ima->runtime.gpu_stream_lod = 0;
   for (int i = 0; i < 3; i++) {
     for (int j = 0; j < 2; j++) {
       ima->gputexture[i][j] = nullptr;
@@ -4781,7 +4788,11 @@ ImBuf *BKE_image_acquire_ibuf(Image *ima, ImageUser *iuser, void **r_lock)
 
   BLI_mutex_lock(static_cast<ThreadMutex *>(ima->runtime.cache_mutex));
 
-  ibuf = image_acquire_ibuf(ima, iuser, r_lock);
+  {
+    /* Buffers loaded here are owned by the image cache. */
+    MEM_TagScope mem_tag_scope(MEM_TAG_IMAGE_CACHE);
+    ibuf = image_acquire_ibuf(ima, iuser, r_lock);
+  }
 
   BLI_mutex_unlock(static_cast<ThreadMutex *>(ima->runtime.cache_mutex));
 
@@ -5523,6 +5534,71 @@ bool BKE_image_has_loaded_ibuf(Image *image)
   return has_loaded_ibuf;
 }
 
+void BKE_image_load_parallel(Image **images, const int images_num)
+{
+  /* Buffers of the same image are loaded under the lock of that image, so only distinct images
+   * are loaded in parallel. The tiles of an UDIM image are loaded by the same task. */
+  blender::threading::parallel_for(
+      blender::IndexRange(images_num), 1, [&](const blender::IndexRange range) {
+        for (const int i : range) {
+          Image *ima = images[i];
+          if (!ELEM(ima->source, IMA_SRC_FILE, IMA_SRC_TILED)) {
+            continue;
+          }
+          LISTBASE_FOREACH (ImageTile *, tile, &ima->tiles) {
+            ImageUser iuser;
+            BKE_imageuser_default(&iuser);
+            iuser.tile = tile->tile_number;
+            /* Only loads the buffer when it's not cached yet, failed loads are cached too. */
+            ImBuf *ibuf = BKE_image_acquire_ibuf(ima, &iuser, nullptr);
+            BKE_image_release_ibuf(ima, ibuf, nullptr);
+          }
+        }
+      });
+}
+
+static void image_collect_shader_users(Image *ima,
+                                       ID * /*iuser_id*/,
+                                       ImageUser * /*iuser*/,
+                                       void *customdata)
+{
+  if (ima != nullptr) {
+    static_cast<blender::VectorSet<Image *> *>(customdata)->add(ima);
+  }
+}
+
+void BKE_image_load_shader_images(Main *bmain)
+{
+  blender::VectorSet<Image *> images;
+  LISTBASE_FOREACH (Material *, ma, &bmain->materials) {
+    if (ID_REAL_USERS(&ma->id) > 0 && ma->nodetree && ma->use_nodes) {
+      image_walk_ntree_all_users(ma->nodetree, &ma->id, &images, image_collect_shader_users);
+    }
+  }
+  LISTBASE_FOREACH (World *, world, &bmain->worlds) {
+    if (ID_REAL_USERS(&world->id) > 0 && world->nodetree && world->use_nodes) {
+      image_walk_ntree_all_users(world->nodetree, &world->id, &images, image_collect_shader_users);
+    }
+  }
+  LISTBASE_FOREACH (bNodeTree *, ntree, &bmain->nodetrees) {
+    /* Node groups used by shaders. */
+    if (ID_REAL_USERS(&ntree->id) > 0 && ntree->type == NTREE_SHADER) {
+      image_walk_ntree_all_users(ntree, &ntree->id, &images, image_collect_shader_users);
+    }
+  }
+
+  /* Avoid the overhead of the parallel loop when everything is loaded already. */
+  blender::Vector<Image *> images_to_load;
+  for (Image *ima : images) {
+    if (!BKE_image_has_loaded_ibuf(ima)) {
+      images_to_load.append(ima);
+    }
+  }
+  if (images_to_load.size() > 1) {
+    BKE_image_load_parallel(images_to_load.data(), int(images_to_load.size()));
+  }
+}
+
 ImBuf *BKE_image_get_ibuf_with_name(Image *image, const char *filepath)
 {
   BLI_assert(!BLI_path_is_rel(filepath));
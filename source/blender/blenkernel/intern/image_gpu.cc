@@ -6,6 +6,8 @@
  * \ingroup bke
  */
 
+#include <algorithm>
+
 #include "MEM_guardedalloc.h"
 
 #include "BLI_boxpack_2d.h"
@@ -13,6 +15,7 @@
 #include "BLI_listbase.h"
 #include "BLI_threads.h"
 #include "BLI_time.h"
+#include "BLI_vector.hh"
 
 #include "DNA_image_types.h"
 #include "DNA_userdef_types.h"
@@ -255,6 +258,206 @@ static GPUTexture *gpu_texture_create_tile_array(Image *ima, ImBuf *main_ibuf)
 
 /** \} */
 
+/* -------------------------------------------------------------------- */
+/** \name Texture Streaming
+ *
+ * When enabled in the preferences, material image textures are first uploaded at a low
+ * resolution so that opening a texture heavy scene doesn't stall on uploading every image at full
+ * resolution. The resolution of the textures that are drawn is then doubled at each redraw, until
+ * they reach their final resolution or the textures don't fit the streaming budget anymore.
+ * Textures that haven't been drawn recently are released first when going over budget.
+ * \{ */
+
+/** Largest dimension of a streamed texture when it is first uploaded. */
+static constexpr int stream_start_size = 256;
+/** Maximum amount of texture memory created by a single streaming step. */
+static constexpr int64_t stream_step_byte_size = 64 * 1024 * 1024;
+/** Number of seconds since the last draw after which a texture is not streamed in anymore. */
+static constexpr int stream_used_time = 2;
+
+static bool image_gpu_stream_enabled()
+{
+  /* Final renders always need full resolution textures. */
+  return (U.gpu_flag & USER_GPU_FLAG_TEXTURE_STREAMING) && !G.is_rendering;
+}
+
+static bool image_gpu_stream_supported(const Image *ima, const ImBuf *ibuf)
+{
+  /* Compressed images keep their own mip-maps, and other sources are either small or changing
+   * often enough that streaming them would only add uploads. */
+  return ima->source == IMA_SRC_FILE && ima->type == IMA_TYPE_IMAGE &&
+         !BKE_image_is_multiview(ima) && ibuf->ftype != IMB_FTYPE_DDS;
+}
+
+/** Number of times the image resolution has to be halved to respect the texture size limit. */
+static int image_gpu_stream_lod_final(const ImBuf *ibuf)
+{
+  const int size = max_ii(ibuf->x, ibuf->y);
+  const int limit = GPU_texture_size_with_limit(size);
+  int lod = 0;
+  while ((size >> lod) > limit) {
+    lod++;
+  }
+  return lod;
+}
+
+static int image_gpu_stream_lod_start(const ImBuf *ibuf)
+{
+  const int size = max_ii(ibuf->x, ibuf->y);
+  int lod = image_gpu_stream_lod_final(ibuf);
+  while ((size >> lod) > stream_start_size) {
+    lod++;
+  }
+  return lod;
+}
+
+static int64_t image_gpu_stream_texture_size(const GPUTexture *tex)
+{
+  const eGPUTextureFormat format = GPU_texture_format(tex);
+  int64_t component_size = 1;
+  if (ELEM(format, GPU_RGBA16F, GPU_R16F)) {
+    component_size = 2;
+  }
+  else if (ELEM(format, GPU_RGBA32F, GPU_R32F)) {
+    component_size = 4;
+  }
+  /* Include the mip-map chain. */
+  return int64_t(GPU_texture_width(tex)) * GPU_texture_height(tex) *
+         GPU_texture_component_len(format) * component_size * 4 / 3;
+}
+
+static void image_gpu_texture_sampling_setup(Image *ima, GPUTexture *tex)
+{
+  GPU_texture_extend_mode(tex, GPU_SAMPLER_EXTEND_MODE_REPEAT);
+
+  if (GPU_mipmap_enabled()) {
+    GPU_texture_update_mipmap_chain(tex);
+    ima->gpuflag |= IMA_GPU_MIPMAP_COMPLETE;
+    GPU_texture_mipmap_mode(tex, true, true);
+  }
+  else {
+    GPU_texture_mipmap_mode(tex, false, true);
+  }
+}
+
+/** Create the texture of a single image at its full resolution divided by `2^lod`. */
+static GPUTexture *image_gpu_stream_texture_create(Image *ima, ImBuf *ibuf, const int lod)
+{
+  const int w = max_ii(1, ibuf->x >> lod);
+  const int h = max_ii(1, ibuf->y >> lod);
+  const bool use_high_bitdepth = (ima->flag & IMA_HIGH_BITDEPTH);
+  const bool store_premultiplied = BKE_image_has_gpu_texture_premultiplied_alpha(ima, ibuf);
+
+  GPUTexture *tex = IMB_touch_gpu_texture(
+      ima->id.name + 2, ibuf, w, h, 0, use_high_bitdepth, true);
+  if (tex == nullptr) {
+    return nullptr;
+  }
+  IMB_update_gpu_texture_sub(
+      tex, ibuf, 0, 0, 0, w, h, use_high_bitdepth, true, store_premultiplied);
+  image_gpu_texture_sampling_setup(ima, tex);
+  GPU_texture_original_size_set(tex, ibuf->x, ibuf->y);
+  return tex;
+}
+
+/** Double the resolution of a streamed texture. Returns the size of the new texture. */
+static int64_t image_gpu_stream_step(Image *ima)
+{
+  ImBuf *ibuf = BKE_image_acquire_ibuf(ima, nullptr, nullptr);
+  if (ibuf == nullptr) {
+    BKE_image_release_ibuf(ima, ibuf, nullptr);
+    return 0;
+  }
+
+  const int lod = image_gpu_stream_lod_final(ibuf) + ima->runtime.gpu_stream_lod - 1;
+  GPUTexture *tex = image_gpu_stream_texture_create(ima, ibuf, lod);
+  BKE_image_release_ibuf(ima, ibuf, nullptr);
+  if (tex == nullptr) {
+    return 0;
+  }
+
+  GPU_texture_free(ima->gputexture[TEXTARGET_2D][0]);
+  ima->gputexture[TEXTARGET_2D][0] = tex;
+  ima->runtime.gpu_stream_lod--;
+  return image_gpu_stream_texture_size(tex);
+}
+
+bool BKE_image_stream_gputextures(Main *bmain)
+{
+  if (!image_gpu_stream_enabled()) {
+    return false;
+  }
+
+  const int ctime = int(BLI_time_now_seconds());
+  const int64_t budget = int64_t(U.texture_streaming_budget) * 1024 * 1024;
+
+  int64_t used_size = 0;
+  blender::Vector<Image *> candidates;
+  blender::Vector<Image *> unused;
+  LISTBASE_FOREACH (Image *, ima, &bmain->images) {
+    GPUTexture *tex = ima->gputexture[TEXTARGET_2D][0];
+    if (tex == nullptr) {
+      continue;
+    }
+    used_size += image_gpu_stream_texture_size(tex);
+    if (ctime - ima->lastused > stream_used_time) {
+      unused.append(ima);
+    }
+    else if (ima->runtime.gpu_stream_lod > 0) {
+      candidates.append(ima);
+    }
+  }
+
+  if (candidates.is_empty()) {
+    return false;
+  }
+
+  /* Make room for the textures in use by releasing the ones that aren't. They are streamed in
+   * again from a low resolution when they are drawn again. */
+  if (budget > 0) {
+    std::sort(unused.begin(), unused.end(), [](Image *a, Image *b) {
+      return a->lastused < b->lastused;
+    });
+    for (Image *ima : unused) {
+      if (used_size <= budget) {
+        break;
+      }
+      used_size -= image_gpu_stream_texture_size(ima->gputexture[TEXTARGET_2D][0]);
+      image_free_gpu(ima, true);
+    }
+  }
+
+  /* Lowest resolution textures first, they have the most visible improvement. */
+  std::stable_sort(candidates.begin(), candidates.end(), [](Image *a, Image *b) {
+    return a->runtime.gpu_stream_lod > b->runtime.gpu_stream_lod;
+  });
+
+  bool streaming_pending = false;
+  int64_t step_size = 0;
+  for (Image *ima : candidates) {
+    const int64_t current_size = image_gpu_stream_texture_size(ima->gputexture[TEXTARGET_2D][0]);
+    /* Each step quadruples the texture size. */
+    const int64_t next_size = current_size * 4;
+    if (budget > 0 && used_size - current_size + next_size > budget) {
+      continue;
+    }
+    if (step_size + next_size > stream_step_byte_size && step_size > 0) {
+      streaming_pending = true;
+      break;
+    }
+    const int64_t new_size = image_gpu_stream_step(ima);
+    if (new_size == 0) {
+      continue;
+    }
+    used_size += new_size - current_size;
+    step_size += new_size;
+    streaming_pending |= ima->runtime.gpu_stream_lod > 0;
+  }
+  return streaming_pending;
+}
+
+/** \} */
+
 /* -------------------------------------------------------------------- */
 /** \name Regular gpu texture
  * \{ */
@@ -353,7 +556,8 @@ void BKE_image_ensure_gpu_texture(Image *image, ImageUser *image_user)
 static ImageGPUTextures image_get_gpu_texture(Image *ima,
                                               ImageUser *iuser,
                                               const bool use_viewers,
-                                              const bool use_tile_mapping)
+                                              const bool use_tile_mapping,
+                                              const bool use_streaming)
 {
   ImageGPUTextures result = {};
 
@@ -408,6 +612,11 @@ static ImageGPUTextures image_get_gpu_texture(Image *ima,
     current_view = 0;
   }
   GPUTexture **tex = get_image_gpu_texture_ptr(ima, textarget, current_view);
+  const bool allow_streaming = use_streaming && image_gpu_stream_enabled();
+  if (*tex && ima->runtime.gpu_stream_lod > 0 && !allow_streaming) {
+    /* A low resolution streamed texture can't be used here. */
+    image_free_gpu(ima, true);
+  }
   if (*tex) {
     result.texture = *tex;
     result.tile_mapping = *get_image_gpu_texture_ptr(ima, TEXTARGET_TILE_MAPPING, current_view);
@@ -444,6 +653,17 @@ static ImageGPUTextures image_get_gpu_texture(Image *ima,
     *tile_mapping_tex = gpu_texture_create_tile_mapping(ima, iuser ? iuser->multiview_eye : 0);
     result.tile_mapping = *tile_mapping_tex;
   }
+  else if (allow_streaming && image_gpu_stream_supported(ima, ibuf) &&
+           image_gpu_stream_lod_start(ibuf) > image_gpu_stream_lod_final(ibuf))
+  {
+    /* Streamed single image texture, the resolution is increased by later redraws. */
+    const int lod = image_gpu_stream_lod_start(ibuf);
+    *tex = image_gpu_stream_texture_create(ima, ibuf, lod);
+    result.texture = *tex;
+    if (*tex) {
+      ima->runtime.gpu_stream_lod = lod - image_gpu_stream_lod_final(ibuf);
+    }
+  }
   else {
     /* Single image texture. */
     const bool use_high_bitdepth = (ima->flag & IMA_HIGH_BITDEPTH);
@@ -453,16 +673,7 @@ static ImageGPUTextures image_get_gpu_texture(Image *ima,
     result.texture = *tex;
 
     if (*tex) {
-      GPU_texture_extend_mode(*tex, GPU_SAMPLER_EXTEND_MODE_REPEAT);
-
-      if (GPU_mipmap_enabled()) {
-        GPU_texture_update_mipmap_chain(*tex);
-        ima->gpuflag |= IMA_GPU_MIPMAP_COMPLETE;
-        GPU_texture_mipmap_mode(*tex, true, true);
-      }
-      else {
-        GPU_texture_mipmap_mode(*tex, false, true);
-      }
+      image_gpu_texture_sampling_setup(ima, *tex);
     }
   }
 
@@ -477,19 +688,19 @@ static ImageGPUTextures image_get_gpu_texture(Image *ima,
 
 GPUTexture *BKE_image_get_gpu_texture(Image *image, ImageUser *iuser)
 {
-  return image_get_gpu_texture(image, iuser, false, false).texture;
+  return image_get_gpu_texture(image, iuser, false, false, false).texture;
 }
 
 GPUTexture *BKE_image_get_gpu_viewer_texture(Image *image, ImageUser *iuser)
 {
-  return image_get_gpu_texture(image, iuser, true, false).texture;
+  return image_get_gpu_texture(image, iuser, true, false, false).texture;
 }
 
 ImageGPUTextures BKE_image_get_gpu_material_texture(Image *image,
                                                     ImageUser *iuser,
                                                     const bool use_tile_mapping)
 {
-  return image_get_gpu_texture(image, iuser, false, use_tile_mapping);
+  return image_get_gpu_texture(image, iuser, false, use_tile_mapping, true);
 }
 
 /** \} */
@@ -553,6 +764,7 @@ static void image_free_gpu(Image *ima, const bool immediate)
   }
 
   ima->gpuflag &= ~IMA_GPU_MIPMAP_COMPLETE;
+  ima->runtime.gpu_stream_lod = 0;
 }
 
 void BKE_image_free_gputextures(Image *ima)
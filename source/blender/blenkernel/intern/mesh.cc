@@ -153,6 +153,11 @@ static void mesh_copy_data(Main *bmain,
   mesh_dst->runtime->vert_to_face_map_cache = mesh_src->runtime->vert_to_face_map_cache;
   mesh_dst->runtime->vert_to_corner_map_cache = mesh_src->runtime->vert_to_corner_map_cache;
   mesh_dst->runtime->corner_to_face_map_cache = mesh_src->runtime->corner_to_face_map_cache;
+  mesh_dst->runtime->vert_to_edge_offset_cache = mesh_src->runtime->vert_to_edge_offset_cache;
+  mesh_dst->runtime->vert_to_edge_map_cache = mesh_src->runtime->vert_to_edge_map_cache;
+  mesh_dst->runtime->edge_to_face_offset_cache = mesh_src->runtime->edge_to_face_offset_cache;
+  mesh_dst->runtime->edge_to_face_map_cache = mesh_src->runtime->edge_to_face_map_cache;
+  mesh_dst->runtime->edge_to_corner_map_cache = mesh_src->runtime->edge_to_corner_map_cache;
   if (mesh_src->runtime->bake_materials) {
     mesh_dst->runtime->bake_materials = std::make_unique<blender::bke::bake::BakeMaterialsList>(
         *mesh_src->runtime->bake_materials);
@@ -371,6 +376,14 @@ static void mesh_blend_read_data(BlendDataReader *reader, ID *id)
   if (mesh->face_offset_indices) {
     mesh->runtime->face_offsets_sharing_info = BLO_read_shared(
         reader, &mesh->face_offset_indices, [&]() {
+          if (const blender::ImplicitSharingInfo *sharing_info = BLO_read_shared_from_mapping(
+                  reader,
+                  &mesh->face_offset_indices,
+                  sizeof(int) * (int64_t(mesh->faces_num) + 1),
+                  alignof(int)))
+          {
+            return sharing_info;
+          }
           BLO_read_int32_array(reader, mesh->faces_num + 1, &mesh->face_offset_indices);
           return blender::implicit_sharing::info_for_mem_free(mesh->face_offset_indices);
         });
@@ -380,14 +380,9 @@ Array<int> build_corner_to_face_map(const OffsetIndices<int> faces)
   return map;
 }
 
-GroupedSpan<int> build_vert_to_edge_map(const Span<int2> edges,
-                                        const int verts_num,
-                                        Array<int> &r_offsets,
-                                        Array<int> &r_indices)
+Array<int> build_vert_to_edge_indices(const Span<int2> edges, const OffsetIndices<int> offsets)
 {
-  r_offsets = create_reverse_offsets(edges.cast<int>(), verts_num);
-  const OffsetIndices<int> offsets(r_offsets);
-  r_indices.reinitialize(offsets.total_size());
+  Array<int> indices(offsets.total_size());
 
   /* Version of #reverse_indices_in_groups that accounts for storing two indices for each edge. */
   int *counts = MEM_cnew_array<int>(size_t(offsets.size()), __func__);
@@ -396,11 +391,22 @@ GroupedSpan<int> build_vert_to_edge_map(const Span<int2> edges,
     for (const int64_t edge : range) {
       for (const int vert : {edges[edge][0], edges[edge][1]}) {
         const int index_in_group = atomic_fetch_and_add_int32(&counts[vert], 1);
-        r_indices[offsets[vert][index_in_group]] = int(edge);
+        indices[offsets[vert][index_in_group]] = int(edge);
       }
     }
   });
-  sort_small_groups(offsets, 1024, r_indices);
+  sort_small_groups(offsets, 1024, indices);
+  return indices;
+}
+
+GroupedSpan<int> build_vert_to_edge_map(const Span<int2> edges,
+                                        const int verts_num,
+                                        Array<int> &r_offsets,
+                                        Array<int> &r_indices)
+{
+  r_offsets = create_reverse_offsets(edges.cast<int>(), verts_num);
+  const OffsetIndices<int> offsets(r_offsets);
+  r_indices = build_vert_to_edge_indices(edges, offsets);
   return {offsets, r_indices};
 }
 
@@ -438,6 +444,12 @@ GroupedSpan<int> build_vert_to_corner_map(const Span<int> corner_verts,
   return gather_groups(corner_verts, verts_num, r_offsets, r_indices);
 }
 
+Array<int> build_edge_to_corner_indices(const Span<int> corner_edges,
+                                        const OffsetIndices<int> offsets)
+{
+  return reverse_indices_in_groups(corner_edges, offsets);
+}
+
 GroupedSpan<int> build_edge_to_corner_map(const Span<int> corner_edges,
                                           const int edges_num,
                                           Array<int> &r_offsets,
@@ -446,6 +458,14 @@ GroupedSpan<int> build_edge_to_corner_map(const Span<int> corner_edges,
   return gather_groups(corner_edges, edges_num, r_offsets, r_indices);
 }
 
+void build_edge_to_face_indices(const OffsetIndices<int> faces,
+                                const Span<int> corner_edges,
+                                const OffsetIndices<int> offsets,
+                                MutableSpan<int> face_indices)
+{
+  reverse_group_indices_in_groups(faces, corner_edges, offsets, face_indices);
+}
+
 GroupedSpan<int> build_edge_to_face_map(const OffsetIndices<int> faces,
                                         const Span<int> corner_edges,
                                         const int edges_num,
@@ -454,7 +474,7 @@ GroupedSpan<int> build_edge_to_face_map(const OffsetIndices<int> faces,
 {
   r_offsets = create_reverse_offsets(corner_edges, edges_num);
   r_indices.reinitialize(r_offsets.last());
-  reverse_group_indices_in_groups(faces, corner_edges, OffsetIndices<int>(r_offsets), r_indices);
+  build_edge_to_face_indices(faces, corner_edges, OffsetIndices<int>(r_offsets), r_indices);
   return {OffsetIndices<int>(r_offsets), r_indices};
 }
 
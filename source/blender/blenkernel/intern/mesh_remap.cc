@@ -25,6 +25,7 @@
 #include "BLI_memarena.h"
 #include "BLI_polyfill_2d.h"
 #include "BLI_rand.h"
+#include "BLI_task.hh"
 #include "BLI_utildefines.h"
 
 #include "BKE_bvhutils.hh"
@@ -104,6 +105,47 @@ static bool mesh_remap_bvhtree_query_raycast(BVHTreeFromMesh *treedata,
   return false;
 }
 
+/**
+ * Find the nearest source element of all destination vertices in parallel. Only the queries run
+ * in parallel, because defining the map items allocates from the memory arena of the map.
+ * \param r_nearest: The nearest element of every vertex, with a -1 index if none was found.
+ * \param r_hit_dist: The distance to the nearest element, #FLT_MAX if none was found.
+ */
+static void mesh_remap_bvhtree_query_nearest_verts(BVHTreeFromMesh *treedata,
+                                                   const SpaceTransform *space_transform,
+                                                   const float (*vert_positions_dst)[3],
+                                                   const float max_dist_sq,
+                                                   blender::MutableSpan<BVHTreeNearest> r_nearest,
+                                                   blender::MutableSpan<float> r_hit_dist)
+{
+  using namespace blender;
+  threading::parallel_for(r_nearest.index_range(), 512, [&](const IndexRange range) {
+    /* The previous result is only used as starting point within a range of vertices that are
+     * usually close to each other. */
+    BVHTreeNearest nearest = {0};
+    nearest.index = -1;
+    for (const int64_t i : range) {
+      float tmp_co[3];
+      copy_v3_v3(tmp_co, vert_positions_dst[i]);
+
+      /* Convert the vertex to tree coordinates, if needed. */
+      if (space_transform) {
+        BLI_space_transform_apply(space_transform, tmp_co);
+      }
+
+      if (mesh_remap_bvhtree_query_nearest(
+              treedata, &nearest, tmp_co, max_dist_sq, &r_hit_dist[i]))
+      {
+        r_nearest[i] = nearest;
+      }
+      else {
+        r_nearest[i].index = -1;
+        r_hit_dist[i] = FLT_MAX;
+      }
+    }
+  });
+}
+
 /** \} */
 
 /* -------------------------------------------------------------------- */
@@ -472,26 +514,22 @@ void BKE_mesh_remap_calc_verts_from_mesh(const int mode,
   }
   else {
     BVHTreeFromMesh treedata = {nullptr};
-    BVHTreeNearest nearest = {0};
     BVHTreeRayHit rayhit = {0};
     float hit_dist;
     float tmp_co[3], tmp_no[3];
 
     if (mode == MREMAP_MODE_VERT_NEAREST) {
       BKE_bvhtree_from_mesh_get(&treedata, me_src, BVHTREE_FROM_VERTS, 2);
-      nearest.index = -1;
-
-      for (i = 0; i < numverts_dst; i++) {
-        copy_v3_v3(tmp_co, vert_positions_dst[i]);
 
-        /* Convert the vertex to tree coordinates, if needed. */
-        if (space_transform) {
-          BLI_space_transform_apply(space_transform, tmp_co);
-        }
+      blender::Array<BVHTreeNearest> nearest_verts(numverts_dst);
+      blender::Array<float> hit_dists(numverts_dst);
+      mesh_remap_bvhtree_query_nearest_verts(
+          &treedata, space_transform, vert_positions_dst, max_dist_sq, nearest_verts, hit_dists);
 
-        if (mesh_remap_bvhtree_query_nearest(&treedata, &nearest, tmp_co, max_dist_sq, &hit_dist))
-        {
-          mesh_remap_item_define(r_map, i, hit_dist, 0, 1, &nearest.index, &full_weight);
+      for (i = 0; i < numverts_dst; i++) {
+        if (nearest_verts[i].index != -1) {
+          mesh_remap_item_define(
+              r_map, i, hit_dists[i], 0, 1, &nearest_verts[i].index, &full_weight);
         }
         else {
           /* No source for this dest vertex! */
@@ -504,19 +542,23 @@ void BKE_mesh_remap_calc_verts_from_mesh(const int mode,
       const blender::Span<blender::float3> positions_src = me_src->vert_positions();
 
       BKE_bvhtree_from_mesh_get(&treedata, me_src, BVHTREE_FROM_EDGES, 2);
-      nearest.index = -1;
+
+      blender::Array<BVHTreeNearest> nearest_edges(numverts_dst);
+      blender::Array<float> hit_dists(numverts_dst);
+      mesh_remap_bvhtree_query_nearest_verts(
+          &treedata, space_transform, vert_positions_dst, max_dist_sq, nearest_edges, hit_dists);
 
       for (i = 0; i < numverts_dst; i++) {
-        copy_v3_v3(tmp_co, vert_positions_dst[i]);
+        if (nearest_edges[i].index != -1) {
+          hit_dist = hit_dists[i];
+          copy_v3_v3(tmp_co, vert_positions_dst[i]);
 
-        /* Convert the vertex to tree coordinates, if needed. */
-        if (space_transform) {
-          BLI_space_transform_apply(space_transform, tmp_co);
-        }
+          /* Convert the vertex to tree coordinates, if needed. */
+          if (space_transform) {
+            BLI_space_transform_apply(space_transform, tmp_co);
+          }
 
-        if (mesh_remap_bvhtree_query_nearest(&treedata, &nearest, tmp_co, max_dist_sq, &hit_dist))
-        {
-          const blender::int2 &edge = edges_src[nearest.index];
+          const blender::int2 &edge = edges_src[nearest_edges[i].index];
           const float *v1cos = positions_src[edge[0]];
           const float *v2cos = positions_src[edge[1]];
 
@@ -603,19 +645,15 @@ void BKE_mesh_remap_calc_verts_from_mesh(const int mode,
         }
       }
       else {
-        nearest.index = -1;
+        blender::Array<BVHTreeNearest> nearest_tris(numverts_dst);
+        blender::Array<float> hit_dists(numverts_dst);
+        mesh_remap_bvhtree_query_nearest_verts(
+            &treedata, space_transform, vert_positions_dst, max_dist_sq, nearest_tris, hit_dists);
 
         for (i = 0; i < numverts_dst; i++) {
-          copy_v3_v3(tmp_co, vert_positions_dst[i]);
-
-          /* Convert the vertex to tree coordinates, if needed. */
-          if (space_transform) {
-            BLI_space_transform_apply(space_transform, tmp_co);
-          }
-
-          if (mesh_remap_bvhtree_query_nearest(
-                  &treedata, &nearest, tmp_co, max_dist_sq, &hit_dist))
-          {
+          const BVHTreeNearest &nearest = nearest_tris[i];
+          hit_dist = hit_dists[i];
+          if (nearest.index != -1) {
             const int face_index = tri_faces[nearest.index];
 
             if (mode == MREMAP_MODE_VERT_FACE_NEAREST) {
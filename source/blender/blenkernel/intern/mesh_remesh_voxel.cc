@@ -180,16 +180,20 @@ static openvdb::FloatGrid::Ptr remesh_voxel_level_set_create(const Mesh *mesh,
   std::vector<openvdb::Vec3s> points(mesh->verts_num);
   std::vector<openvdb::Vec3I> triangles(corner_tris.size());
 
-  for (const int i : IndexRange(mesh->verts_num)) {
-    const float3 &co = positions[i];
-    points[i] = openvdb::Vec3s(co.x, co.y, co.z);
-  }
+  blender::threading::parallel_for(positions.index_range(), 8192, [&](const IndexRange range) {
+    for (const int i : range) {
+      const float3 &co = positions[i];
+      points[i] = openvdb::Vec3s(co.x, co.y, co.z);
+    }
+  });
 
-  for (const int i : IndexRange(corner_tris.size())) {
-    const int3 &tri = corner_tris[i];
-    triangles[i] = openvdb::Vec3I(
-        corner_verts[tri[0]], corner_verts[tri[1]], corner_verts[tri[2]]);
-  }
+  blender::threading::parallel_for(corner_tris.index_range(), 8192, [&](const IndexRange range) {
+    for (const int i : range) {
+      const int3 &tri = corner_tris[i];
+      triangles[i] = openvdb::Vec3I(
+          corner_verts[tri[0]], corner_verts[tri[1]], corner_verts[tri[2]]);
+    }
+  });
 
   openvdb::math::Transform::Ptr transform = openvdb::math::Transform::createLinearTransform(
       voxel_size);
@@ -225,24 +229,30 @@ static Mesh *remesh_voxel_volume_to_mesh(const openvdb::FloatGrid::Ptr level_set
         3, triangle_loop_start, face_offsets.drop_front(quads.size()));
   }
 
-  for (const int i : vert_positions.index_range()) {
-    vert_positions[i] = float3(vertices[i].x(), vertices[i].y(), vertices[i].z());
-  }
+  threading::parallel_for(vert_positions.index_range(), 8192, [&](const IndexRange range) {
+    for (const int i : range) {
+      vert_positions[i] = float3(vertices[i].x(), vertices[i].y(), vertices[i].z());
+    }
+  });
 
-  for (const int i : IndexRange(quads.size())) {
-    const int loopstart = i * 4;
-    mesh_corner_verts[loopstart] = quads[i][0];
-    mesh_corner_verts[loopstart + 1] = quads[i][3];
-    mesh_corner_verts[loopstart + 2] = quads[i][2];
-    mesh_corner_verts[loopstart + 3] = quads[i][1];
-  }
+  threading::parallel_for(IndexRange(quads.size()), 4096, [&](const IndexRange range) {
+    for (const int i : range) {
+      const int loopstart = i * 4;
+      mesh_corner_verts[loopstart] = quads[i][0];
+      mesh_corner_verts[loopstart + 1] = quads[i][3];
+      mesh_corner_verts[loopstart + 2] = quads[i][2];
+      mesh_corner_verts[loopstart + 3] = quads[i][1];
+    }
+  });
 
-  for (const int i : IndexRange(tris.size())) {
-    const int loopstart = triangle_loop_start + i * 3;
-    mesh_corner_verts[loopstart] = tris[i][2];
-    mesh_corner_verts[loopstart + 1] = tris[i][1];
-    mesh_corner_verts[loopstart + 2] = tris[i][0];
-  }
+  threading::parallel_for(IndexRange(tris.size()), 4096, [&](const IndexRange range) {
+    for (const int i : range) {
+      const int loopstart = triangle_loop_start + i * 3;
+      mesh_corner_verts[loopstart] = tris[i][2];
+      mesh_corner_verts[loopstart + 1] = tris[i][1];
+      mesh_corner_verts[loopstart + 2] = tris[i][0];
+    }
+  });
 
   mesh_calc_edges(*mesh, false, false);
 
@@ -524,58 +534,78 @@ void mesh_remesh_reproject_attributes(const Mesh &src, Mesh &dst)
   const OffsetIndices dst_faces = dst.faces();
   const Span<int> dst_corner_verts = dst.corner_verts();
 
-  MutableAttributeAccessor dst_attributes = dst.attributes_for_write();
-
-  if (!point_ids.is_empty() || !corner_ids.is_empty()) {
-    Array<int> vert_nearest_tris(dst_positions.size());
-    find_nearest_tris_parallel(dst_positions, bvhtree, vert_nearest_tris);
-
-    if (!point_ids.is_empty()) {
-      Array<int> map(dst.verts_num);
-      find_nearest_verts(
-          src_positions, src_corner_verts, src_corner_tris, dst_positions, vert_nearest_tris, map);
-      gather_attributes(point_ids, src_attributes, AttrDomain::Point, map, dst_attributes);
-    }
+  /* The index maps of the different domains are independent, so they are built in parallel. The
+   * attributes are only written afterwards, as adding attributes is not thread-safe. */
+  Array<int> vert_map;
+  Array<int> corner_map;
+  Array<int> edge_map;
+  Array<int> face_map;
+  threading::parallel_invoke(
+      dst_positions.size() > 1024,
+      [&]() {
+        if (point_ids.is_empty() && corner_ids.is_empty()) {
+          return;
+        }
+        Array<int> vert_nearest_tris(dst_positions.size());
+        find_nearest_tris_parallel(dst_positions, bvhtree, vert_nearest_tris);
+
+        if (!point_ids.is_empty()) {
+          vert_map.reinitialize(dst.verts_num);
+          find_nearest_verts(src_positions,
+                             src_corner_verts,
+                             src_corner_tris,
+                             dst_positions,
+                             vert_nearest_tris,
+                             vert_map);
+        }
 
-    if (!corner_ids.is_empty()) {
-      const Span<int> src_tri_faces = src.corner_tri_faces();
-      Array<int> map(dst.corners_num);
-      find_nearest_corners(src_positions,
+        if (!corner_ids.is_empty()) {
+          const Span<int> src_tri_faces = src.corner_tri_faces();
+          corner_map.reinitialize(dst.corners_num);
+          find_nearest_corners(src_positions,
+                               src_faces,
+                               src_corner_verts,
+                               src_tri_faces,
+                               dst_positions,
+                               dst_corner_verts,
+                               vert_nearest_tris,
+                               corner_map);
+        }
+      },
+      [&]() {
+        if (edge_ids.is_empty()) {
+          return;
+        }
+        const Span<int2> src_edges = src.edges();
+        const Span<int> src_corner_edges = src.corner_edges();
+        const Span<int> src_tri_faces = src.corner_tri_faces();
+        const Span<int2> dst_edges = dst.edges();
+        edge_map.reinitialize(dst.edges_num);
+        find_nearest_edges(src_positions,
+                           src_edges,
                            src_faces,
-                           src_corner_verts,
+                           src_corner_edges,
                            src_tri_faces,
                            dst_positions,
-                           dst_corner_verts,
-                           vert_nearest_tris,
-                           map);
-      gather_attributes(corner_ids, src_attributes, AttrDomain::Corner, map, dst_attributes);
-    }
-  }
-
-  if (!edge_ids.is_empty()) {
-    const Span<int2> src_edges = src.edges();
-    const Span<int> src_corner_edges = src.corner_edges();
-    const Span<int> src_tri_faces = src.corner_tri_faces();
-    const Span<int2> dst_edges = dst.edges();
-    Array<int> map(dst.edges_num);
-    find_nearest_edges(src_positions,
-                       src_edges,
-                       src_faces,
-                       src_corner_edges,
-                       src_tri_faces,
-                       dst_positions,
-                       dst_edges,
-                       bvhtree,
-                       map);
-    gather_attributes(edge_ids, src_attributes, AttrDomain::Edge, map, dst_attributes);
-  }
+                           dst_edges,
+                           bvhtree,
+                           edge_map);
+      },
+      [&]() {
+        if (face_ids.is_empty()) {
+          return;
+        }
+        const Span<int> src_tri_faces = src.corner_tri_faces();
+        face_map.reinitialize(dst.faces_num);
+        find_nearest_faces(
+            src_tri_faces, dst_positions, dst_faces, dst_corner_verts, bvhtree, face_map);
+      });
 
-  if (!face_ids.is_empty()) {
-    const Span<int> src_tri_faces = src.corner_tri_faces();
-    Array<int> map(dst.faces_num);
-    find_nearest_faces(src_tri_faces, dst_positions, dst_faces, dst_corner_verts, bvhtree, map);
-    gather_attributes(face_ids, src_attributes, AttrDomain::Face, map, dst_attributes);
-  }
+  MutableAttributeAccessor dst_attributes = dst.attributes_for_write();
+  gather_attributes(point_ids, src_attributes, AttrDomain::Point, vert_map, dst_attributes);
+  gather_attributes(corner_ids, src_attributes, AttrDomain::Corner, corner_map, dst_attributes);
+  gather_attributes(edge_ids, src_attributes, AttrDomain::Edge, edge_map, dst_attributes);
+  gather_attributes(face_ids, src_attributes, AttrDomain::Face, face_map, dst_attributes);
 
   if (src.active_color_attribute) {
     BKE_id_attributes_active_color_set(&dst.id, src.active_color_attribute);
@@ -9,6 +9,8 @@
 #include "MEM_guardedalloc.h"
 
 #include "BLI_array_utils.hh"
+#include "BLI_bit_vector.hh"
+#include "BLI_index_mask.hh"
 #include "BLI_math_geom.h"
 #include "BLI_task.hh"
 
@@ -49,6 +51,13 @@ static void free_bvh_cache(MeshRuntime &mesh_runtime)
   }
 }
 
+static void tag_bvh_cache_positions_changed(MeshRuntime &mesh_runtime)
+{
+  if (mesh_runtime.bvh_cache) {
+    bvhcache_tag_positions_changed(mesh_runtime.bvh_cache);
+  }
+}
+
 static void free_batch_cache(MeshRuntime &mesh_runtime)
 {
   if (mesh_runtime.batch_cache) {
@@ -162,6 +171,62 @@ blender::GroupedSpan<int> Mesh::vert_to_corner_map() const
   return {offsets, this->runtime->vert_to_corner_map_cache.data()};
 }
 
+blender::GroupedSpan<int> Mesh::vert_to_edge_map() const
+{
+  using namespace blender;
+  this->runtime->vert_to_edge_offset_cache.ensure([&](Array<int> &r_data) {
+    r_data = Array<int>(this->verts_num + 1, 0);
+    offset_indices::build_reverse_offsets(this->edges().cast<int>(), r_data);
+  });
+  const OffsetIndices<int> offsets(this->runtime->vert_to_edge_offset_cache.data());
+  this->runtime->vert_to_edge_map_cache.ensure([&](Array<int> &r_data) {
+    r_data = bke::mesh::build_vert_to_edge_indices(this->edges(), offsets);
+  });
+  return {offsets, this->runtime->vert_to_edge_map_cache.data()};
+}
+
+blender::OffsetIndices<int> Mesh::edge_to_face_map_offsets() const
+{
+  using namespace blender;
+  this->runtime->edge_to_face_offset_cache.ensure([&](Array<int> &r_data) {
+    r_data = Array<int>(this->edges_num + 1, 0);
+    offset_indices::build_reverse_offsets(this->corner_edges(), r_data);
+  });
+  return OffsetIndices<int>(this->runtime->edge_to_face_offset_cache.data());
+}
+
+blender::GroupedSpan<int> Mesh::edge_to_face_map() const
+{
+  using namespace blender;
+  const OffsetIndices offsets = this->edge_to_face_map_offsets();
+  this->runtime->edge_to_face_map_cache.ensure([&](Array<int> &r_data) {
+    r_data.reinitialize(this->corners_num);
+    if (this->runtime->edge_to_corner_map_cache.is_cached() &&
+        this->runtime->corner_to_face_map_cache.is_cached())
+    {
+      /* The edge to face cache can be built from the edge to face corner
+       * and face corner to face maps if they are both already cached. */
+      array_utils::gather(this->runtime->corner_to_face_map_cache.data().as_span(),
+                          this->runtime->edge_to_corner_map_cache.data().as_span(),
+                          r_data.as_mutable_span());
+    }
+    else {
+      bke::mesh::build_edge_to_face_indices(this->faces(), this->corner_edges(), offsets, r_data);
+    }
+  });
+  return {offsets, this->runtime->edge_to_face_map_cache.data()};
+}
+
+blender::GroupedSpan<int> Mesh::edge_to_corner_map() const
+{
+  using namespace blender;
+  const OffsetIndices offsets = this->edge_to_face_map_offsets();
+  this->runtime->edge_to_corner_map_cache.ensure([&](Array<int> &r_data) {
+    r_data = bke::mesh::build_edge_to_corner_indices(this->corner_edges(), offsets);
+  });
+  return {offsets, this->runtime->edge_to_corner_map_cache.data()};
+}
+
 const blender::bke::LooseVertCache &Mesh::loose_verts() const
 {
   using namespace blender::bke;
@@ -319,6 +384,11 @@ void BKE_mesh_runtime_clear_geometry(Mesh *mesh)
   mesh->runtime->vert_to_face_map_cache.tag_dirty();
   mesh->runtime->vert_to_corner_map_cache.tag_dirty();
   mesh->runtime->corner_to_face_map_cache.tag_dirty();
+  mesh->runtime->vert_to_edge_offset_cache.tag_dirty();
+  mesh->runtime->vert_to_edge_map_cache.tag_dirty();
+  mesh->runtime->edge_to_face_offset_cache.tag_dirty();
+  mesh->runtime->edge_to_face_map_cache.tag_dirty();
+  mesh->runtime->edge_to_corner_map_cache.tag_dirty();
   mesh->runtime->vert_normals_cache.tag_dirty();
   mesh->runtime->face_normals_cache.tag_dirty();
   mesh->runtime->corner_normals_cache.tag_dirty();
@@ -342,6 +412,11 @@ void Mesh::tag_edges_split()
   this->runtime->vert_to_face_offset_cache.tag_dirty();
   this->runtime->vert_to_face_map_cache.tag_dirty();
   this->runtime->vert_to_corner_map_cache.tag_dirty();
+  this->runtime->vert_to_edge_offset_cache.tag_dirty();
+  this->runtime->vert_to_edge_map_cache.tag_dirty();
+  this->runtime->edge_to_face_offset_cache.tag_dirty();
+  this->runtime->edge_to_face_map_cache.tag_dirty();
+  this->runtime->edge_to_corner_map_cache.tag_dirty();
   if (this->runtime->loose_edges_cache.is_cached() &&
       this->runtime->loose_edges_cache.data().count != 0)
   {
@@ -378,6 +453,7 @@ void Mesh::tag_face_winding_changed()
   this->runtime->face_normals_cache.tag_dirty();
   this->runtime->corner_normals_cache.tag_dirty();
   this->runtime->vert_to_corner_map_cache.tag_dirty();
+  this->runtime->edge_to_corner_map_cache.tag_dirty();
   this->runtime->shrinkwrap_boundary_cache.tag_dirty();
 }
 
@@ -390,9 +466,72 @@ void Mesh::tag_positions_changed()
   this->tag_positions_changed_no_normals();
 }
 
+void Mesh::tag_positions_changed(const blender::IndexMask &changed_verts)
+{
+  using namespace blender;
+  if (changed_verts.is_empty()) {
+    return;
+  }
+  bke::MeshRuntime &runtime = *this->runtime;
+  /* When normals aren't cached, or most of them change anyway, it's cheaper to recompute them
+   * lazily when they are needed. */
+  if (!runtime.face_normals_cache.is_cached() || !runtime.vert_normals_cache.is_cached() ||
+      changed_verts.size() > this->verts_num / 4)
+  {
+    this->tag_positions_changed();
+    return;
+  }
+
+  const Span<float3> positions = this->vert_positions();
+  const OffsetIndices faces = this->faces();
+  const Span<int> corner_verts = this->corner_verts();
+  const GroupedSpan<int> vert_to_face_map = this->vert_to_face_map();
+
+  /* The normals of all faces using a moved vertex change, and with them the normals of all
+   * vertices of these faces. */
+  BitVector<> changed_verts_bits(this->verts_num);
+  changed_verts.to_bits(changed_verts_bits);
+  IndexMaskMemory memory;
+  const IndexMask changed_faces = IndexMask::from_predicate(
+      faces.index_range(), GrainSize(1024), memory, [&](const int face) {
+        for (const int vert : corner_verts.slice(faces[face])) {
+          if (changed_verts_bits[vert]) {
+            return true;
+          }
+        }
+        return false;
+      });
+  BitVector<> changed_faces_bits(faces.size());
+  changed_faces.to_bits(changed_faces_bits);
+  const IndexMask affected_verts = IndexMask::from_predicate(
+      IndexRange(this->verts_num), GrainSize(1024), memory, [&](const int vert) {
+        if (changed_verts_bits[vert]) {
+          return true;
+        }
+        for (const int face : vert_to_face_map[vert]) {
+          if (changed_faces_bits[face]) {
+            return true;
+          }
+        }
+        return false;
+      });
+
+  runtime.face_normals_cache.update([&](Vector<float3> &r_data) {
+    bke::mesh::normals_calc_faces(positions, faces, corner_verts, changed_faces, r_data);
+  });
+  const Span<float3> face_normals = runtime.face_normals_cache.data();
+  runtime.vert_normals_cache.update([&](Vector<float3> &r_data) {
+    bke::mesh::normals_calc_verts(
+        positions, faces, corner_verts, vert_to_face_map, face_normals, affected_verts, r_data);
+  });
+
+  runtime.corner_normals_cache.tag_dirty();
+  this->tag_positions_changed_no_normals();
+}
+
 void Mesh::tag_positions_changed_no_normals()
 {
-  free_bvh_cache(*this->runtime);
+  tag_bvh_cache_positions_changed(*this->runtime);
   this->runtime->corner_tris_cache.tag_dirty();
   this->runtime->bounds_cache.tag_dirty();
   this->runtime->shrinkwrap_boundary_cache.tag_dirty();
@@ -401,7 +540,7 @@ void Mesh::tag_positions_changed_no_normals()
 void Mesh::tag_positions_changed_uniformly()
 {
   /* The normals and triangulation didn't change, since all verts moved by the same amount. */
-  free_bvh_cache(*this->runtime);
+  tag_bvh_cache_positions_changed(*this->runtime);
   this->runtime->bounds_cache.tag_dirty();
 }
 
@@ -17,6 +17,7 @@
 
 #include "BLI_math_matrix.h"
 #include "BLI_task.h"
+#include "BLI_task.hh"
 
 #include "BKE_attribute.hh"
 #include "BKE_customdata.hh"
@@ -635,23 +636,26 @@ void multires_reshape_store_original_grids(MultiresReshapeContext *reshape_conte
   }
 
   const int num_grids = reshape_context->num_grids;
-  for (int grid_index = 0; grid_index < num_grids; grid_index++) {
-    MDisps *orig_grid = &orig_mdisps[grid_index];
-    /* Ignore possibly invalid/non-allocated original grids. They will be replaced with 0 original
-     * data when accessed during reshape process.
-     * Reshape process will ensure all grids are on top level, but that happens on separate set of
-     * grids which eventually replaces original one. */
-    if (orig_grid->disps != nullptr) {
-      orig_grid->disps = static_cast<float(*)[3]>(MEM_dupallocN(orig_grid->disps));
-    }
-    if (orig_grid_paint_masks != nullptr) {
-      GridPaintMask *orig_paint_mask_grid = &orig_grid_paint_masks[grid_index];
-      if (orig_paint_mask_grid->data != nullptr) {
-        orig_paint_mask_grid->data = static_cast<float *>(
-            MEM_dupallocN(orig_paint_mask_grid->data));
-      }
-    }
-  }
+  blender::threading::parallel_for(
+      blender::IndexRange(num_grids), 256, [&](const blender::IndexRange range) {
+        for (const int grid_index : range) {
+          MDisps *orig_grid = &orig_mdisps[grid_index];
+          /* Ignore possibly invalid/non-allocated original grids. They will be replaced with 0
+           * original data when accessed during reshape process.
+           * Reshape process will ensure all grids are on top level, but that happens on separate
+           * set of grids which eventually replaces original one. */
+          if (orig_grid->disps != nullptr) {
+            orig_grid->disps = static_cast<float(*)[3]>(MEM_dupallocN(orig_grid->disps));
+          }
+          if (orig_grid_paint_masks != nullptr) {
+            GridPaintMask *orig_paint_mask_grid = &orig_grid_paint_masks[grid_index];
+            if (orig_paint_mask_grid->data != nullptr) {
+              orig_paint_mask_grid->data = static_cast<float *>(
+                  MEM_dupallocN(orig_paint_mask_grid->data));
+            }
+          }
+        }
+      });
 
   reshape_context->orig.mdisps = orig_mdisps;
   reshape_context->orig.grid_paint_masks = orig_grid_paint_masks;
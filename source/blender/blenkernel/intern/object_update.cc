@@ -262,9 +262,19 @@ void BKE_object_eval_uber_transform(Depsgraph * /*depsgraph*/, Object * /*object
 void BKE_object_batch_cache_dirty_tag(Object *ob)
 {
   switch (ob->type) {
-    case OB_MESH:
-      BKE_mesh_batch_cache_dirty_tag((Mesh *)ob->data, BKE_MESH_BATCH_DIRTY_ALL);
+    case OB_MESH: {
+      Mesh *mesh = (Mesh *)ob->data;
+      eMeshBatchDirtyMode mode = BKE_MESH_BATCH_DIRTY_ALL;
+      if (BMEditMesh *em = mesh->runtime->edit_mesh.get()) {
+        /* Keep the draw buffers that don't depend on positions while transforming. */
+        if (em->pending_update == BKE_EDITMESH_UPDATE_DEFORM) {
+          mode = BKE_MESH_BATCH_DIRTY_DEFORM;
+        }
+        em->pending_update = BKE_EDITMESH_UPDATE_NONE;
+      }
+      BKE_mesh_batch_cache_dirty_tag(mesh, mode);
       break;
+    }
     case OB_LATTICE:
       BKE_lattice_batch_cache_dirty_tag((Lattice *)ob->data, BKE_LATTICE_BATCH_DIRTY_ALL);
       break;
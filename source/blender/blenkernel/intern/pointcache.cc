@@ -82,6 +82,16 @@
 
 #define LZO_OUT_LEN(size) ((size) + (size) / 16 + 64 + 3)
 
+#include <zstd.h>
+
+/** Value of the compression byte in cache files, which differs from #PTCACHE_COMPRESS_NO etc. */
+enum {
+  PTCACHE_FILE_COMPRESS_LZO = 1,
+  PTCACHE_FILE_COMPRESS_LZMA = 2,
+  /** Used for both zstd compression levels. */
+  PTCACHE_FILE_COMPRESS_ZSTD = 3,
+};
+
 #ifdef WITH_LZMA
 #  include "LzmaLib.h"
 #endif
@@ -678,7 +688,7 @@ static void ptcache_dynamicpaint_error(const ID * /*owner_id*/,
 static int ptcache_dynamicpaint_write(PTCacheFile *pf, void *dp_v)
 {
   DynamicPaintSurface *surface = (DynamicPaintSurface *)dp_v;
-  int cache_compress = PTCACHE_COMPRESS_LZO;
+  int cache_compress = PTCACHE_COMPRESS_ZSTD_FAST;
 
   /* version header */
   ptcache_file_write(pf, DPAINT_CACHE_VERSION, 1, sizeof(char[4]));
@@ -704,7 +714,7 @@ static int ptcache_dynamicpaint_write(PTCacheFile *pf, void *dp_v)
       return 0;
     }
 
-    out = (uchar *)MEM_callocN(LZO_OUT_LEN(in_len), "pointcache_lzo_buffer");
+    out = (uchar *)MEM_mallocN(LZO_OUT_LEN(in_len), "pointcache_lzo_buffer");
 
     ptcache_file_compressed_write(
         pf, (uchar *)surface->data->type_data, in_len, out, cache_compress);
@@ -1521,15 +1531,15 @@ static int ptcache_file_compressed_read(PTCacheFile *pf, uchar *result, uint len
       /* do nothing */
     }
     else {
-      in = (uchar *)MEM_callocN(sizeof(uchar) * in_len, "pointcache_compressed_buffer");
+      in = (uchar *)MEM_mallocN(sizeof(uchar) * in_len, "pointcache_compressed_buffer");
       ptcache_file_read(pf, in, in_len, sizeof(uchar));
 #ifdef WITH_LZO
-      if (compressed == 1) {
+      if (compressed == PTCACHE_FILE_COMPRESS_LZO) {
         r = lzo1x_decompress_safe(in, (lzo_uint)in_len, result, (lzo_uint *)&out_len, nullptr);
       }
 #endif
 #ifdef WITH_LZMA
-      if (compressed == 2) {
+      if (compressed == PTCACHE_FILE_COMPRESS_LZMA) {
         size_t sizeOfIt;
         size_t leni = in_len, leno = len;
         ptcache_file_read(pf, &size, 1, sizeof(uint));
@@ -1538,6 +1548,10 @@ static int ptcache_file_compressed_read(PTCacheFile *pf, uchar *result, uint len
         r = LzmaUncompress(result, &leno, in, &leni, props, sizeOfIt);
       }
 #endif
+      if (compressed == PTCACHE_FILE_COMPRESS_ZSTD) {
+        const size_t result_len = ZSTD_decompress(result, len, in, in_len);
+        r = (ZSTD_isError(result_len) || result_len != len) ? -1 : 0;
+      }
       MEM_freeN(in);
     }
   }
@@ -1570,7 +1584,7 @@ static int ptcache_file_compressed_write(
       compressed = 0;
     }
     else {
-      compressed = 1;
+      compressed = PTCACHE_FILE_COMPRESS_LZO;
     }
   }
 #endif
@@ -1595,10 +1609,24 @@ static int ptcache_file_compressed_write(
       compressed = 0;
     }
     else {
-      compressed = 2;
+      compressed = PTCACHE_FILE_COMPRESS_LZMA;
     }
   }
 #endif
+  if (ELEM(mode, PTCACHE_COMPRESS_ZSTD_FAST, PTCACHE_COMPRESS_ZSTD_SLOW)) {
+    /* The output buffers are allocated with #LZO_OUT_LEN, which is larger than the bound. */
+    BLI_assert(ZSTD_compressBound(in_len) <= LZO_OUT_LEN(in_len));
+    const int level = (mode == PTCACHE_COMPRESS_ZSTD_FAST) ? 1 : 9;
+    out_len = ZSTD_compress(out, ZSTD_compressBound(in_len), in, in_len, level);
+    if (ZSTD_isError(out_len) || (out_len >= in_len)) {
+      r = ZSTD_isError(out_len) ? -1 : 0;
+      compressed = 0;
+    }
+    else {
+      r = 0;
+      compressed = PTCACHE_FILE_COMPRESS_ZSTD;
+    }
+  }
 
   ptcache_file_write(pf, &compressed, 1, sizeof(uchar));
   if (compressed) {
@@ -1610,7 +1638,7 @@ static int ptcache_file_compressed_write(
     ptcache_file_write(pf, in, in_len, sizeof(uchar));
   }
 
-  if (compressed == 2) {
+  if (compressed == PTCACHE_FILE_COMPRESS_LZMA) {
     uint size = sizeOfIt;
     ptcache_file_write(pf, &sizeOfIt, 1, sizeof(uint));
     ptcache_file_write(pf, props, size, sizeof(uchar));
@@ -2060,7 +2088,7 @@ static int ptcache_mem_frame_to_disk(PTCacheID *pid, PTCacheMem *pm)
       for (i = 0; i < BPHYS_TOT_DATA; i++) {
         if (pm->data[i]) {
           uint in_len = pm->totpoint * ptcache_data_size[i];
-          uchar *out = (uchar *)MEM_callocN(LZO_OUT_LEN(in_len) * 4, "pointcache_lzo_buffer");
+          uchar *out = (uchar *)MEM_mallocN(LZO_OUT_LEN(in_len) * 4, "pointcache_lzo_buffer");
           ptcache_file_compressed_write(
               pf, (uchar *)(pm->data[i]), in_len, out, pid->cache->compression);
           MEM_freeN(out);
@@ -2096,7 +2124,7 @@ static int ptcache_mem_frame_to_disk(PTCacheID *pid, PTCacheMem *pm)
 
       if (pid->cache->compression) {
         uint in_len = extra->totdata * ptcache_extra_datasize[extra->type];
-        uchar *out = (uchar *)MEM_callocN(LZO_OUT_LEN(in_len) * 4, "pointcache_lzo_buffer");
+        uchar *out = (uchar *)MEM_mallocN(LZO_OUT_LEN(in_len) * 4, "pointcache_lzo_buffer");
         ptcache_file_compressed_write(
             pf, (uchar *)(extra->data), in_len, out, pid->cache->compression);
         MEM_freeN(out);
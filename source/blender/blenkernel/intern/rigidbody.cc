@@ -19,10 +19,14 @@
 
 #include "MEM_guardedalloc.h"
 
+#include "BLI_array.hh"
 #include "BLI_listbase.h"
 #include "BLI_math_matrix.h"
 #include "BLI_math_rotation.h"
 #include "BLI_math_vector.h"
+#include "BLI_task.hh"
+#include "BLI_time.h"
+#include "BLI_vector.hh"
 
 #ifdef WITH_BULLET
 #  include "RBI_api.h"
@@ -577,6 +581,25 @@ static rbCollisionShape *rigidbody_validate_sim_shape_helper(RigidBodyWorld *rbw
   return new_shape;
 }
 
+/* Children of compound shapes don't have a shape of their own, they are part of their parent's. */
+static bool rigidbody_is_compound_child(const Object *ob)
+{
+  return ob->parent != nullptr && ob->parent->rigidbody_object != nullptr &&
+         ob->parent->rigidbody_object->shape == RB_SHAPE_COMPOUND;
+}
+
+/* Store a newly created collision shape, freeing the one it replaces. */
+static void rigidbody_set_sim_shape(RigidBodyOb *rbo, rbCollisionShape *new_shape)
+{
+  /* assign new collision shape if creation was successful */
+  if (new_shape) {
+    if (rbo->shared->physics_shape) {
+      RB_shape_delete(static_cast<rbCollisionShape *>(rbo->shared->physics_shape));
+    }
+    rbo->shared->physics_shape = new_shape;
+  }
+}
+
 /* Create new physics sim collision shape for object and store it,
  * or remove the existing one first and replace...
  */
@@ -596,21 +619,59 @@ static void rigidbody_validate_sim_shape(RigidBodyWorld *rbw, Object *ob, bool r
   }
 
   /* Also don't create a shape if this object is parent of a compound shape */
-  if (ob->parent != nullptr && ob->parent->rigidbody_object != nullptr &&
-      ob->parent->rigidbody_object->shape == RB_SHAPE_COMPOUND)
-  {
+  if (rigidbody_is_compound_child(ob)) {
     return;
   }
 
   new_shape = rigidbody_validate_sim_shape_helper(rbw, ob);
+  rigidbody_set_sim_shape(rbo, new_shape);
+}
 
-  /* assign new collision shape if creation was successful */
-  if (new_shape) {
-    if (rbo->shared->physics_shape) {
-      RB_shape_delete(static_cast<rbCollisionShape *>(rbo->shared->physics_shape));
+/* Create new physics sim collision shapes for all mesh objects in the world that need one, like
+ * #rigidbody_validate_sim_shape.
+ * Building shapes from meshes (convex hulls, triangle meshes) is the expensive part of rebuilding
+ * the world, and each shape only reads its own object (and the children of compound shapes),
+ * so they are built in parallel. Only storing them is done serially.
+ */
+static void rigidbody_validate_sim_shapes(RigidBodyWorld *rbw, const bool rebuild)
+{
+  using namespace blender;
+
+  Vector<Object *> objects;
+  FOREACH_COLLECTION_OBJECT_RECURSIVE_BEGIN (rbw->group, ob) {
+    const RigidBodyOb *rbo = ob->rigidbody_object;
+    if (ob->type != OB_MESH || rbo == nullptr || rigidbody_is_compound_child(ob)) {
+      continue;
+    }
+    if (rebuild || (rbo->flag & RBO_FLAG_NEEDS_RESHAPE) ||
+        ((rbo->flag & RBO_FLAG_NEEDS_VALIDATE) && rbo->shared->physics_shape == nullptr))
+    {
+      objects.append(ob);
     }
-    rbo->shared->physics_shape = new_shape;
   }
+  FOREACH_COLLECTION_OBJECT_RECURSIVE_END;
+
+  if (objects.is_empty()) {
+    return;
+  }
+
+  const double start_time = BLI_time_now_seconds();
+  Array<rbCollisionShape *> new_shapes(objects.size());
+  /* The cost of a shape varies from nothing for primitives to a lot for big meshes. */
+  threading::parallel_for(objects.index_range(), 1, [&](const IndexRange range) {
+    for (const int i : range) {
+      new_shapes[i] = rigidbody_validate_sim_shape_helper(rbw, objects[i]);
+    }
+  });
+
+  for (const int i : objects.index_range()) {
+    rigidbody_set_sim_shape(objects[i]->rigidbody_object, new_shapes[i]);
+  }
+  CLOG_INFO(&LOG,
+            1,
+            "built %d collision shapes in %.2f ms",
+            int(objects.size()),
+            (BLI_time_now_seconds() - start_time) * 1000.0);
 }
 
 /* --------------------- */
@@ -771,7 +832,14 @@ void BKE_rigidbody_calc_center_of_mass(Object *ob, float r_center[3])
  *
  * \param rebuild: Even if an instance already exists, replace it
  */
-static void rigidbody_validate_sim_object(RigidBodyWorld *rbw, Object *ob, bool rebuild)
+/**
+ * \param rebuild_shape: Whether to rebuild the collision shape, false when the caller already
+ * built it with #rigidbody_validate_sim_shapes.
+ */
+static void rigidbody_validate_sim_object(RigidBodyWorld *rbw,
+                                          Object *ob,
+                                          bool rebuild,
+                                          bool rebuild_shape)
 {
   RigidBodyOb *rbo = (ob) ? ob->rigidbody_object : nullptr;
   float loc[3];
@@ -787,7 +855,7 @@ static void rigidbody_validate_sim_object(RigidBodyWorld *rbw, Object *ob, bool
   /* make sure collision shape exists */
   /* FIXME we shouldn't always have to rebuild collision shapes when rebuilding objects,
    * but it's needed for constraints to update correctly. */
-  if (rbo->shared->physics_shape == nullptr || rebuild) {
+  if (rbo->shared->physics_shape == nullptr || (rebuild && rebuild_shape)) {
     rigidbody_validate_sim_shape(rbw, ob, true);
   }
 
@@ -1851,6 +1919,9 @@ static void rigidbody_update_simulation(Depsgraph *depsgraph,
     FOREACH_COLLECTION_OBJECT_RECURSIVE_END;
   }
 
+  /* update collision shapes, so the objects below don't have to */
+  rigidbody_validate_sim_shapes(rbw, rebuild);
+
   /* update objects */
   FOREACH_COLLECTION_OBJECT_RECURSIVE_BEGIN (rbw->group, ob) {
     if (ob->type == OB_MESH) {
@@ -1868,7 +1939,7 @@ static void rigidbody_update_simulation(Depsgraph *depsgraph,
          * - assume object to be active? That is the default for newly added settings...
          */
         ob->rigidbody_object = BKE_rigidbody_create_object(scene, ob, RBO_TYPE_ACTIVE);
-        rigidbody_validate_sim_object(rbw, ob, true);
+        rigidbody_validate_sim_object(rbw, ob, true, true);
 
         rbo = ob->rigidbody_object;
       }
@@ -1877,20 +1948,15 @@ static void rigidbody_update_simulation(Depsgraph *depsgraph,
         /* refresh object... */
         if (rebuild) {
           /* World has been rebuilt so rebuild object */
-          /* TODO(Sybren): rigidbody_validate_sim_object() can call rigidbody_validate_sim_shape(),
-           * but neither resets the RBO_FLAG_NEEDS_RESHAPE flag nor
-           * calls RB_body_set_collision_shape().
-           * This results in the collision shape being created twice, which is unnecessary. */
-          rigidbody_validate_sim_object(rbw, ob, true);
+          rigidbody_validate_sim_object(rbw, ob, true, false);
         }
         else if (rbo->flag & RBO_FLAG_NEEDS_VALIDATE) {
-          rigidbody_validate_sim_object(rbw, ob, false);
+          rigidbody_validate_sim_object(rbw, ob, false, false);
         }
         /* refresh shape... */
         if (rbo->flag & RBO_FLAG_NEEDS_RESHAPE) {
-          /* mesh/shape data changed, so force shape refresh */
-          rigidbody_validate_sim_shape(rbw, ob, true);
-          /* now tell RB sim about it */
+          /* mesh/shape data changed, the shape was refreshed by rigidbody_validate_sim_shapes(),
+           * now tell RB sim about it */
           /* XXX: we assume that this can only get applied for active/passive shapes
            * that will be included as rigid-bodies. */
           if (rbo->shared->physics_object != nullptr && rbo->shared->physics_shape != nullptr) {
@@ -2357,13 +2423,23 @@ void BKE_rigidbody_do_simulation(Depsgraph *depsgraph, Scene *scene, float ctime
     /* update and validate simulation */
     rigidbody_update_simulation(depsgraph, scene, rbw, false);
 
+    rbDynamicsWorld *physics_world = static_cast<rbDynamicsWorld *>(rbw->shared->physics_world);
+    double step_time = 0.0;
     for (int i = 0; i < rbw->substeps_per_frame; i++) {
       rigidbody_update_external_forces(depsgraph, scene, rbw);
       rigidbody_update_kinematic_obj_substep(&kinematic_substep_targets, cur_interp_val);
-      RB_dworld_step_simulation(
-          static_cast<rbDynamicsWorld *>(rbw->shared->physics_world), substep, 0, substep);
+      const double step_start = BLI_time_now_seconds();
+      RB_dworld_step_simulation(physics_world, substep, 0, substep);
+      step_time += BLI_time_now_seconds() - step_start;
       cur_interp_val += interp_step;
     }
+    CLOG_INFO(&LOG,
+              1,
+              "frame %d: %d contact pairs, %d substeps in %.2f ms",
+              int(ctime),
+              RB_dworld_get_num_contact_pairs(physics_world),
+              rbw->substeps_per_frame,
+              step_time * 1000.0);
     rigidbody_free_substep_data(&kinematic_substep_targets);
 
     rigidbody_update_simulation_post_step(depsgraph, rbw);
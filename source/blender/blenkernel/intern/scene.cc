@@ -9,6 +9,7 @@
 /* Allow using deprecated functionality for .blend file I/O. */
 #define DNA_DEPRECATED_ALLOW
 
+#include <algorithm>
 #include <cstddef>
 #include <cstdio>
 #include <cstring>
@@ -41,11 +42,13 @@
 #include "DNA_world_types.h"
 
 #include "BKE_callbacks.hh"
+#include "BLI_array.hh"
 #include "BLI_blenlib.h"
 #include "BLI_math_rotation.h"
 #include "BLI_string.h"
 #include "BLI_string_utils.hh"
 #include "BLI_task.h"
+#include "BLI_task.hh"
 #include "BLI_threads.h"
 #include "BLI_utildefines.h"
 
@@ -2641,6 +2644,52 @@ void BKE_scene_graph_update_for_newframe(Depsgraph *depsgraph)
   BKE_scene_graph_update_for_newframe_ex(depsgraph, true);
 }
 
+void BKE_scene_graph_evaluate_frames_parallel(
+    Depsgraph *depsgraph,
+    const blender::Span<float> frames,
+    const int max_graphs,
+    const blender::FunctionRef<void(Depsgraph *graph)> build_fn,
+    const blender::FunctionRef<void(Depsgraph *graph, float frame)> fn)
+{
+  using namespace blender;
+  if (frames.is_empty()) {
+    return;
+  }
+  Main *bmain = DEG_get_bmain(depsgraph);
+  Scene *scene = DEG_get_input_scene(depsgraph);
+  ViewLayer *view_layer = DEG_get_input_view_layer(depsgraph);
+  const eEvaluationMode mode = DEG_get_mode(depsgraph);
+
+  const int graphs_num = std::max(1, std::min<int>(max_graphs, frames.size()));
+
+  /* Building accesses original data that isn't protected against concurrent access, so only
+   * the evaluation happens in parallel. */
+  Array<Depsgraph *> graphs(graphs_num);
+  for (const int i : graphs.index_range()) {
+    graphs[i] = DEG_graph_new(bmain, scene, view_layer, mode);
+    build_fn(graphs[i]);
+  }
+
+  /* Give every depsgraph an interleaved subset of the sorted frames, so each of them moves
+   * forward in time and the work is balanced even when the cost changes over the frame range. */
+  Array<float> sorted_frames(frames);
+  std::sort(sorted_frames.begin(), sorted_frames.end());
+
+  threading::parallel_for(graphs.index_range(), 1, [&](const IndexRange range) {
+    for (const int graph_index : range) {
+      Depsgraph *graph = graphs[graph_index];
+      for (int64_t i = graph_index; i < sorted_frames.size(); i += graphs_num) {
+        DEG_evaluate_on_framechange(graph, sorted_frames[i], DEG_EVALUATE_SYNC_WRITEBACK_NO);
+        fn(graph, sorted_frames[i]);
+      }
+    }
+  });
+
+  for (Depsgraph *graph : graphs) {
+    DEG_graph_free(graph);
+  }
+}
+
 void BKE_scene_view_layer_graph_evaluated_ensure(Main *bmain, Scene *scene, ViewLayer *view_layer)
 {
   Depsgraph *depsgraph = BKE_scene_ensure_depsgraph(bmain, scene, view_layer);
@@ -11,8 +11,13 @@
 #include "DNA_mesh_types.h"
 #include "DNA_modifier_types.h"
 
+#include "BLI_implicit_sharing.hh"
 #include "BLI_utildefines.h"
+#include "BLI_vector.hh"
 
+#include "BKE_attribute.hh"
+#include "BKE_customdata.hh"
+#include "BKE_mesh.hh"
 #include "BKE_subdiv_modifier.hh"
 
 #include "MEM_guardedalloc.h"
@@ -167,12 +172,120 @@ Subdiv *update_from_converter(Subdiv *subdiv,
   return new_from_converter(settings, converter);
 }
 
+/**
+ * Gather the implicit sharing info of every mesh array the topology refiner is created from, in a
+ * fixed order. Returns false when some array is not shared, so its identity can't be used to
+ * detect changes.
+ */
+static bool mesh_topology_sharing_infos_get(const Mesh *mesh,
+                                            Vector<const ImplicitSharingInfo *> &r_sharing_infos)
+{
+  if (mesh->runtime->face_offsets_sharing_info == nullptr && mesh->faces_num > 0) {
+    return false;
+  }
+  r_sharing_infos.append(mesh->runtime->face_offsets_sharing_info);
+
+  /* Creases are looked up with domain interpolation, which isn't handled here. */
+  const bke::AttributeAccessor attributes = mesh->attributes();
+  for (const StringRef name : {"crease_vert", "crease_edge"}) {
+    const std::optional<bke::AttributeMetaData> meta_data = attributes.lookup_meta_data(name);
+    if (meta_data && meta_data->domain != (name == "crease_vert" ? bke::AttrDomain::Point :
+                                                                     bke::AttrDomain::Edge))
+    {
+      return false;
+    }
+  }
+
+  const auto append_named_layer = [&](const CustomData &data, const StringRef name) {
+    const int layer_index = CustomData_get_named_layer_index_notype(&data, name);
+    if (layer_index == -1) {
+      r_sharing_infos.append(nullptr);
+      return true;
+    }
+    const CustomDataLayer &layer = data.layers[layer_index];
+    r_sharing_infos.append(layer.sharing_info);
+    return layer.sharing_info != nullptr;
+  };
+  if (!append_named_layer(mesh->edge_data, ".edge_verts") ||
+      !append_named_layer(mesh->corner_data, ".corner_vert") ||
+      !append_named_layer(mesh->corner_data, ".corner_edge") ||
+      !append_named_layer(mesh->vert_data, "crease_vert") ||
+      !append_named_layer(mesh->edge_data, "crease_edge"))
+  {
+    return false;
+  }
+
+  /* All UV maps are face-varying channels of the topology refiner. */
+  for (const CustomDataLayer &layer : Span(mesh->corner_data.layers, mesh->corner_data.totlayer)) {
+    if (layer.type == CD_PROP_FLOAT2) {
+      if (layer.sharing_info == nullptr) {
+        return false;
+      }
+      r_sharing_infos.append(layer.sharing_info);
+    }
+  }
+  return true;
+}
+
+static void mesh_topology_sharing_infos_clear(Subdiv *subdiv)
+{
+  for (const int i : IndexRange(subdiv->mesh_topology_.sharing_infos_num)) {
+    if (const ImplicitSharingInfo *sharing_info = subdiv->mesh_topology_.sharing_infos[i]) {
+      sharing_info->remove_user_and_delete_if_last();
+    }
+  }
+  MEM_SAFE_FREE(subdiv->mesh_topology_.sharing_infos);
+  subdiv->mesh_topology_.sharing_infos_num = 0;
+  subdiv->mesh_topology_.verts_num = 0;
+}
+
+static void mesh_topology_sharing_infos_set(Subdiv *subdiv,
+                                            const Span<const ImplicitSharingInfo *> sharing_infos,
+                                            const int verts_num)
+{
+  mesh_topology_sharing_infos_clear(subdiv);
+  if (sharing_infos.is_empty()) {
+    return;
+  }
+  subdiv->mesh_topology_.sharing_infos = static_cast<const ImplicitSharingInfo **>(
+      MEM_malloc_arrayN(sharing_infos.size(), sizeof(ImplicitSharingInfo *), __func__));
+  for (const int i : sharing_infos.index_range()) {
+    if (sharing_infos[i]) {
+      sharing_infos[i]->add_user();
+    }
+    subdiv->mesh_topology_.sharing_infos[i] = sharing_infos[i];
+  }
+  subdiv->mesh_topology_.sharing_infos_num = sharing_infos.size();
+  subdiv->mesh_topology_.verts_num = verts_num;
+}
+
 Subdiv *update_from_mesh(Subdiv *subdiv, const Settings *settings, const Mesh *mesh)
 {
+  /* With deforming meshes, the topology arrays are usually shared with the original mesh for
+   * every frame. Then the topology comparison, which is linear in the mesh size and computes the
+   * UV islands of every UV map, can be skipped. */
+  Vector<const ImplicitSharingInfo *> sharing_infos;
+  const bool use_sharing_infos = mesh_topology_sharing_infos_get(mesh, sharing_infos);
+  if (use_sharing_infos && subdiv != nullptr && subdiv->topology_refiner != nullptr &&
+      settings_equal(&subdiv->settings, settings) &&
+      subdiv->mesh_topology_.verts_num == mesh->verts_num &&
+      Span(subdiv->mesh_topology_.sharing_infos, subdiv->mesh_topology_.sharing_infos_num) ==
+          sharing_infos.as_span())
+  {
+    return subdiv;
+  }
+
   OpenSubdiv_Converter converter;
   converter_init_for_mesh(&converter, settings, mesh);
   subdiv = update_from_converter(subdiv, settings, &converter);
   converter_free(&converter);
+
+  if (use_sharing_infos) {
+    mesh_topology_sharing_infos_set(subdiv, sharing_infos, mesh->verts_num);
+  }
+  else {
+    mesh_topology_sharing_infos_clear(subdiv);
+  }
   return subdiv;
 }
 
@@ -196,6 +309,7 @@ void free(Subdiv *subdiv)
   if (subdiv->cache_.face_ptex_offset != nullptr) {
     MEM_freeN(subdiv->cache_.face_ptex_offset);
   }
+  mesh_topology_sharing_infos_clear(subdiv);
   MEM_freeN(subdiv);
 }
 
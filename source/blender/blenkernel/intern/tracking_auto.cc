@@ -129,6 +129,10 @@ struct AutoTrackContext {
   ListBase results_to_sync;
   int synchronized_scene_frame;
 
+  /* Background pool which loads frames ahead of the tracking step into the movie cache, so that
+   * the decoding of the next frame overlaps with the tracking of the current one. */
+  TaskPool *prefetch_task_pool;
+
   SpinLock spin_lock;
 };
 
@@ -610,6 +614,9 @@ static void reference_keyframed_image_buffers(AutoTrackContext *context)
 void BKE_autotrack_context_start(AutoTrackContext *context)
 {
   reference_keyframed_image_buffers(context);
+
+  context->prefetch_task_pool = BLI_task_pool_create_background_serial(context,
+                                                                       TASK_PRIORITY_LOW);
 }
 
 /** \} */
@@ -703,12 +710,73 @@ static void autotrack_context_reduce(const void *__restrict /*userdata*/,
   BLI_movelisttolist(&autotrack_tls_join->results, &autotrack_tls->results);
 }
 
+struct AutoTrackPrefetchData {
+  int clip_index;
+  /* Frame to be loaded, in the clip frame space. */
+  int clip_frame;
+};
+
+static void autotrack_context_prefetch_frame_cb(TaskPool *__restrict pool, void *taskdata)
+{
+  const AutoTrackContext *context = static_cast<const AutoTrackContext *>(
+      BLI_task_pool_user_data(pool));
+  const AutoTrackPrefetchData *prefetch_data = static_cast<const AutoTrackPrefetchData *>(
+      taskdata);
+  MovieClip *clip = context->autotrack_clips[prefetch_data->clip_index].clip;
+
+  /* Use the same clip user settings as the image accessor, so that the frame is found in the
+   * movie cache once tracking reaches it. */
+  MovieClipUser user;
+  BKE_movieclip_user_set_frame(&user,
+                               BKE_movieclip_remap_clip_to_scene_frame(
+                                   clip, prefetch_data->clip_frame));
+  user.render_size = MCLIP_PROXY_RENDER_SIZE_FULL;
+  user.render_flag = 0;
+
+  ImBuf *ibuf = BKE_movieclip_get_ibuf(clip, &user);
+  if (ibuf != nullptr) {
+    IMB_freeImBuf(ibuf);
+  }
+}
+
+/* Load the frames which the step following the current one will track to, while the current
+ * step is tracking. Loading of movie frames is serialized by the movie clip lock, so the tracking
+ * threads waiting for a frame which is being prefetched will not decode it once again. */
+static void autotrack_context_prefetch_next_frames(AutoTrackContext *context)
+{
+  if (context->prefetch_task_pool == nullptr) {
+    return;
+  }
+
+  const int frame_delta = context->is_backwards ? -1 : 1;
+  bool is_clip_prefetched[MAX_ACCESSOR_CLIP] = {false};
+
+  for (int i = 0; i < context->num_autotrack_markers; ++i) {
+    const libmv_Marker &libmv_marker = context->autotrack_markers[i].libmv_marker;
+    if (is_clip_prefetched[libmv_marker.clip]) {
+      continue;
+    }
+    is_clip_prefetched[libmv_marker.clip] = true;
+
+    AutoTrackPrefetchData *prefetch_data = MEM_cnew<AutoTrackPrefetchData>(__func__);
+    prefetch_data->clip_index = libmv_marker.clip;
+    prefetch_data->clip_frame = libmv_marker.frame + 2 * frame_delta;
+    BLI_task_pool_push(context->prefetch_task_pool,
+                       autotrack_context_prefetch_frame_cb,
+                       prefetch_data,
+                       true,
+                       nullptr);
+  }
+}
+
 bool BKE_autotrack_context_step(AutoTrackContext *context)
 {
   if (context->num_autotrack_markers == 0) {
     return false;
   }
 
+  autotrack_context_prefetch_next_frames(context);
+
   AutoTrackTLS tls;
   BLI_listbase_clear(&tls.results);
 
@@ -876,6 +944,11 @@ static void release_keyframed_image_buffers(AutoTrackContext *context)
 
 void BKE_autotrack_context_free(AutoTrackContext *context)
 {
+  if (context->prefetch_task_pool != nullptr) {
+    BLI_task_pool_cancel(context->prefetch_task_pool);
+    BLI_task_pool_free(context->prefetch_task_pool);
+  }
+
   if (context->autotrack != nullptr) {
     libmv_autoTrackDestroy(context->autotrack);
   }
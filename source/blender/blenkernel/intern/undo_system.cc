@@ -525,6 +525,7 @@ eUndoPushReturn BKE_undosys_step_push_with_type(UndoStack *ustack,
 
   UNDO_NESTED_ASSERT(false);
   undosys_stack_validate(ustack, false);
+  MEM_TagScope mem_tag_scope(MEM_TAG_UNDO);
   bool is_not_empty = ustack->step_active != nullptr;
   eUndoPushReturn retval = UNDO_PUSH_RET_FAILURE;
 
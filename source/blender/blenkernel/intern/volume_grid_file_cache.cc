@@ -34,6 +34,14 @@ struct GridCache {
  * Cache for a file that contains potentially multiple grids.
  */
 struct FileCache {
+  /**
+   * Protects the cache of a single file, so that different files can be loaded concurrently.
+   */
+  std::mutex mutex;
+  /**
+   * True once the meta-data of the file has been read, see #load_file_cache.
+   */
+  bool is_loaded = false;
   /**
    * Empty on success, otherwise an error message that was generated when trying to load the file.
    */
@@ -62,8 +70,14 @@ struct FileCache {
  * Singleton cache that's shared throughout the application.
  */
 struct GlobalCache {
+  /**
+   * Only protects the map itself. It is not locked while reading files.
+   */
   std::mutex mutex;
-  Map<std::string, FileCache> file_map;
+  /**
+   * File caches are never removed, so references to them stay valid.
+   */
+  Map<std::string, std::unique_ptr<FileCache>> file_map;
 };
 
 /**
@@ -76,13 +90,11 @@ static GlobalCache &get_global_cache()
 }
 
 /**
- * Tries to load the file at the given path and creates a cache for it. This only reads meta-data,
- * but not the actual trees, which will be loaded on-demand.
+ * Tries to load the file at the given path and fills its cache. This only reads meta-data, but
+ * not the actual trees, which will be loaded on-demand.
  */
-static FileCache create_file_cache(const StringRef file_path)
+static void load_file_cache(const StringRef file_path, FileCache &file_cache)
 {
-  FileCache file_cache;
-
   openvdb::io::File file(file_path);
   openvdb::GridPtrVec vdb_grids;
   try {
@@ -101,7 +113,7 @@ static FileCache create_file_cache(const StringRef file_path)
     file_cache.error_message = "Unknown error reading VDB file";
   }
   if (!file_cache.error_message.empty()) {
-    return file_cache;
+    return;
   }
 
   for (openvdb::GridBase::Ptr &vdb_grid : vdb_grids) {
@@ -112,17 +124,30 @@ static FileCache create_file_cache(const StringRef file_path)
     grid_cache.meta_data_grid = vdb_grid;
     file_cache.grids.append(std::move(grid_cache));
   }
-
-  return file_cache;
 }
 
+/**
+ * Get the cache for the given file, which is locked by the caller. The global cache is only
+ * locked during the lookup, so that reading one file does not block access to other files.
+ */
 static FileCache &get_file_cache(const StringRef file_path)
 {
   GlobalCache &global_cache = get_global_cache();
-  /* Assumes that the cache is locked already. */
-  BLI_assert(!global_cache.mutex.try_lock());
-  return global_cache.file_map.lookup_or_add_cb_as(file_path,
-                                                   [&]() { return create_file_cache(file_path); });
+  std::lock_guard lock{global_cache.mutex};
+  std::unique_ptr<FileCache> &file_cache = global_cache.file_map.lookup_or_add_cb_as(
+      file_path, []() { return std::make_unique<FileCache>(); });
+  return *file_cache;
+}
+
+static void ensure_file_cache_loaded(const StringRef file_path, FileCache &file_cache)
+{
+  /* Assumes that the file cache is locked already. */
+  BLI_assert(!file_cache.mutex.try_lock());
+  if (file_cache.is_loaded) {
+    return;
+  }
+  load_file_cache(file_path, file_cache);
+  file_cache.is_loaded = true;
 }
 
 /**
@@ -268,9 +293,9 @@ GVolumeGrid get_grid_from_file(const StringRef file_path,
                                const StringRef grid_name,
                                const int simplify_level)
 {
-  GlobalCache &global_cache = get_global_cache();
-  std::lock_guard lock{global_cache.mutex};
   FileCache &file_cache = get_file_cache(file_path);
+  std::lock_guard lock{file_cache.mutex};
+  ensure_file_cache_loaded(file_path, file_cache);
   if (GridCache *grid_cache = file_cache.grid_cache_by_name(grid_name)) {
     return get_cached_grid(file_path, *grid_cache, simplify_level);
   }
@@ -280,9 +305,9 @@ GVolumeGrid get_grid_from_file(const StringRef file_path,
 GridsFromFile get_all_grids_from_file(const StringRef file_path, const int simplify_level)
 {
   GridsFromFile result;
-  GlobalCache &global_cache = get_global_cache();
-  std::lock_guard lock{global_cache.mutex};
   FileCache &file_cache = get_file_cache(file_path);
+  std::lock_guard lock{file_cache.mutex};
+  ensure_file_cache_loaded(file_path, file_cache);
 
   if (!file_cache.error_message.empty()) {
     result.error_message = file_cache.error_message;
@@ -299,8 +324,9 @@ void unload_unused()
 {
   GlobalCache &global_cache = get_global_cache();
   std::lock_guard lock{global_cache.mutex};
-  for (FileCache &file_cache : global_cache.file_map.values()) {
-    for (GridCache &grid_cache : file_cache.grids) {
+  for (std::unique_ptr<FileCache> &file_cache : global_cache.file_map.values()) {
+    std::lock_guard file_lock{file_cache->mutex};
+    for (GridCache &grid_cache : file_cache->grids) {
       grid_cache.grid_by_simplify_level.remove_if(
           [&](const auto &item) { return item.value->is_mutable(); });
     }
@@ -26,6 +26,7 @@
 
 #  include "BLI_endian_defines.h"
 #  include "BLI_math_base.h"
+#  include "BLI_task.h"
 #  include "BLI_threads.h"
 #  include "BLI_utildefines.h"
 #  include "BLI_vector.hh"
@@ -47,8 +48,10 @@ extern "C" {
 #  include <libavutil/buffer.h>
 #  include <libavutil/channel_layout.h>
 #  include <libavutil/cpu.h>
+#  include <libavutil/hwcontext.h>
 #  include <libavutil/imgutils.h>
 #  include <libavutil/opt.h>
+#  include <libavutil/pixdesc.h>
 #  include <libavutil/rational.h>
 #  include <libavutil/samplefmt.h>
 #  include <libswscale/swscale.h>
@@ -104,6 +107,18 @@ struct FFMpegContext {
   AVFrame *img_convert_frame;
   SwsContext *img_convert_ctx;
 
+  /* Device and frame for hardware encoders that take their input in device memory. */
+  AVBufferRef *hw_device_ctx;
+  AVFrame *hw_frame;
+
+  /* When set, frames are converted and encoded in this serial pool while the next frame
+   * renders. Protected by encode_mutex. */
+  TaskPool *encode_pool;
+  ThreadMutex encode_mutex;
+  ThreadCondition encode_cond;
+  int encode_pending_frames;
+  bool encode_failed;
+
   uint8_t *audio_input_buffer;
   uint8_t *audio_deinterleave_buffer;
   int audio_input_samples;
@@ -121,6 +136,9 @@ struct FFMpegContext {
 
 #  define FFMPEG_AUTOSPLIT_SIZE 2000000000
 
+/* Maximum number of frames waiting to be encoded, each holds a copy of the rendered image. */
+#  define FFMPEG_MAX_PENDING_FRAMES 4
+
 #  define PRINT \
     if (G.debug & G_DEBUG_FFMPEG) \
     printf
@@ -395,34 +413,12 @@ static bool write_video_frame(FFMpegContext *context, AVFrame *frame, ReportList
   return success;
 }
 
-/* read and encode a frame of video from the buffer */
-static AVFrame *generate_video_frame(FFMpegContext *context, const ImBuf *image)
+/* Copy the Blender pixels into the FFMPEG data-structure, taking care of endianness and flipping
+ * the image vertically. */
+static void image_to_rgba_frame(const ImBuf *image, AVFrame *rgb_frame)
 {
-  /* For now only 8-bit/channel images are supported. */
   const uint8_t *pixels = image->byte_buffer.data;
-  if (pixels == nullptr) {
-    return nullptr;
-  }
-
-  AVCodecParameters *codec = context->video_stream->codecpar;
-  int height = codec->height;
-  AVFrame *rgb_frame;
-
-  if (context->img_convert_frame != nullptr) {
-    /* Pixel format conversion is needed. */
-    rgb_frame = context->img_convert_frame;
-  }
-  else {
-    /* The output pixel format is Blender's internal pixel format. */
-    rgb_frame = context->current_frame;
-  }
-
-  /* Ensure frame is writable. Some video codecs might have made previous frame
-   * shared (i.e. not writable). */
-  av_frame_make_writable(rgb_frame);
-
-  /* Copy the Blender pixels into the FFMPEG data-structure, taking care of endianness and flipping
-   * the image vertically. */
+  int height = rgb_frame->height;
   int linesize = rgb_frame->linesize[0];
   int linesize_src = rgb_frame->width * 4;
   for (int y = 0; y < height; y++) {
@@ -447,6 +443,12 @@ static AVFrame *generate_video_frame(FFMpegContext *context, const ImBuf *image)
 #    error ENDIAN_ORDER should either be L_ENDIAN or B_ENDIAN.
 #  endif
   }
+}
+
+/* Convert an RGBA frame to the frame passed to the encoder. */
+static AVFrame *convert_video_frame(FFMpegContext *context, AVFrame *rgb_frame)
+{
+  AVFrame *frame = rgb_frame;
 
   /* Convert to the output pixel format, if it's different that Blender's internal one. */
   if (context->img_convert_frame != nullptr) {
@@ -454,9 +456,50 @@ static AVFrame *generate_video_frame(FFMpegContext *context, const ImBuf *image)
     /* Ensure the frame we are scaling to is writable as well. */
     av_frame_make_writable(context->current_frame);
     BKE_ffmpeg_sws_scale_frame(context->img_convert_ctx, context->current_frame, rgb_frame);
+    frame = context->current_frame;
   }
 
-  return context->current_frame;
+  /* Upload to the device for hardware encoders that need it. */
+  if (context->hw_frame != nullptr) {
+    av_frame_unref(context->hw_frame);
+    if (av_hwframe_get_buffer(context->video_codec->hw_frames_ctx, context->hw_frame, 0) < 0 ||
+        av_hwframe_transfer_data(context->hw_frame, frame, 0) < 0)
+    {
+      fprintf(stderr, "Can't upload video frame to the encoder device\n");
+      return nullptr;
+    }
+    frame = context->hw_frame;
+  }
+
+  return frame;
+}
+
+/* read and encode a frame of video from the buffer */
+static AVFrame *generate_video_frame(FFMpegContext *context, const ImBuf *image)
+{
+  /* For now only 8-bit/channel images are supported. */
+  if (image->byte_buffer.data == nullptr) {
+    return nullptr;
+  }
+
+  AVFrame *rgb_frame;
+
+  if (context->img_convert_frame != nullptr) {
+    /* Pixel format conversion is needed. */
+    rgb_frame = context->img_convert_frame;
+  }
+  else {
+    /* The output pixel format is Blender's internal pixel format. */
+    rgb_frame = context->current_frame;
+  }
+
+  /* Ensure frame is writable. Some video codecs might have made previous frame
+   * shared (i.e. not writable). */
+  av_frame_make_writable(rgb_frame);
+
+  image_to_rgba_frame(image, rgb_frame);
+
+  return convert_video_frame(context, rgb_frame);
 }
 
 static AVRational calc_time_base(uint den, double num, int codec_id)
@@ -869,47 +912,33 @@ void BKE_ffmpeg_sws_scale_frame(SwsContext *ctx, AVFrame *dst, const AVFrame *sr
 #  endif
 }
 
-/* prepare a video stream for the output file */
-
-static AVStream *alloc_video_stream(FFMpegContext *context,
-                                    RenderData *rd,
-                                    AVCodecID codec_id,
-                                    AVFormatContext *of,
-                                    int rectx,
-                                    int recty,
-                                    char *error,
-                                    int error_size)
+/* First pixel format supported by the encoder that is stored in system memory. */
+static AVPixelFormat first_software_pix_fmt(const AVCodec *codec)
 {
-  AVStream *st;
-  const AVCodec *codec;
-  AVDictionary *opts = nullptr;
-
-  error[0] = '\0';
-
-  st = avformat_new_stream(of, nullptr);
-  if (!st) {
-    return nullptr;
-  }
-  st->id = 0;
-
-  /* Set up the codec context */
-
-  if (codec_id == AV_CODEC_ID_AV1) {
-    /* Use get_av1_encoder() to get the ideal (hopefully) encoder for AV1 based
-     * on given parameters, and also set up opts. */
-    codec = get_av1_encoder(context, rd, &opts, rectx, recty);
-  }
-  else {
-    codec = avcodec_find_encoder(codec_id);
-  }
-  if (!codec) {
-    fprintf(stderr, "Couldn't find valid video codec\n");
-    context->video_codec = nullptr;
-    return nullptr;
+  for (const AVPixelFormat *pix_fmt = codec->pix_fmts; pix_fmt && *pix_fmt != AV_PIX_FMT_NONE;
+       pix_fmt++)
+  {
+    const AVPixFmtDescriptor *desc = av_pix_fmt_desc_get(*pix_fmt);
+    if (desc && !(desc->flags & AV_PIX_FMT_FLAG_HWACCEL)) {
+      return *pix_fmt;
+    }
   }
+  return AV_PIX_FMT_NV12;
+}
 
-  context->video_codec = avcodec_alloc_context3(codec);
-  AVCodecContext *c = context->video_codec;
+/* Allocate a codec context for the video stream, configured from the render settings. */
+static AVCodecContext *video_codec_context_create(FFMpegContext *context,
+                                                  RenderData *rd,
+                                                  const AVCodec *codec,
+                                                  AVCodecID codec_id,
+                                                  AVFormatContext *of,
+                                                  AVStream *st,
+                                                  int rectx,
+                                                  int recty,
+                                                  AVDictionary **opts,
+                                                  bool is_hardware)
+{
+  AVCodecContext *c = avcodec_alloc_context3(codec);
 
   /* Get some values from the current render settings */
 
@@ -951,7 +980,13 @@ static AVStream *alloc_video_stream(FFMpegContext *context,
   c->max_b_frames = context->ffmpeg_max_b_frames;
 
   if (context->ffmpeg_type == FFMPEG_WEBM && context->ffmpeg_crf == 0) {
-    ffmpeg_dict_set_int(&opts, "lossless", 1);
+    ffmpeg_dict_set_int(opts, "lossless", 1);
+  }
+  else if (context->ffmpeg_crf >= 0 && is_hardware) {
+    /* Hardware encoders have no CRF mode, use their constant quality modes instead. */
+    c->bit_rate = 0;
+    c->global_quality = context->ffmpeg_crf;
+    ffmpeg_dict_set_int(opts, "cq", context->ffmpeg_crf);
   }
   else if (context->ffmpeg_crf >= 0) {
     /* As per https://trac.ffmpeg.org/wiki/Encode/VP9 we must set the bit rate to zero when
@@ -959,7 +994,7 @@ static AVStream *alloc_video_stream(FFMpegContext *context,
      * Set this to always be zero for other codecs as well.
      * We don't care about bit rate in CRF mode. */
     c->bit_rate = 0;
-    ffmpeg_dict_set_int(&opts, "crf", context->ffmpeg_crf);
+    ffmpeg_dict_set_int(opts, "crf", context->ffmpeg_crf);
   }
   else {
     c->bit_rate = context->ffmpeg_video_bitrate * 1000;
@@ -968,7 +1003,8 @@ static AVStream *alloc_video_stream(FFMpegContext *context,
     c->rc_buffer_size = rd->ffcodecdata.rc_buffer_size * 1024;
   }
 
-  if (context->ffmpeg_preset) {
+  /* Preset names of hardware encoders differ per vendor, keep their defaults. */
+  if (context->ffmpeg_preset && !is_hardware) {
     /* 'preset' is used by h.264, 'deadline' is used by WEBM/VP9. I'm not
      * setting those properties conditionally based on the video codec,
      * as the FFmpeg encoder simply ignores unknown settings anyway. */
@@ -993,16 +1029,19 @@ static AVStream *alloc_video_stream(FFMpegContext *context,
     /* "codec_id != AV_CODEC_ID_AV1" is required due to "preset" already being set by an AV1 codec.
      */
     if (preset_name != nullptr && codec_id != AV_CODEC_ID_AV1) {
-      av_dict_set(&opts, "preset", preset_name, 0);
+      av_dict_set(opts, "preset", preset_name, 0);
     }
     if (deadline_name != nullptr) {
-      av_dict_set(&opts, "deadline", deadline_name, 0);
+      av_dict_set(opts, "deadline", deadline_name, 0);
     }
   }
 
   /* Be sure to use the correct pixel format(e.g. RGB, YUV) */
 
-  if (codec->pix_fmts) {
+  if (is_hardware) {
+    c->pix_fmt = first_software_pix_fmt(codec);
+  }
+  else if (codec->pix_fmts) {
     c->pix_fmt = codec->pix_fmts[0];
   }
   else {
@@ -1082,24 +1121,177 @@ static AVStream *alloc_video_stream(FFMpegContext *context,
     c->thread_type = FF_THREAD_SLICE;
   }
 
-  int ret = avcodec_open2(c, codec, &opts);
+  return c;
+}
 
-  if (ret < 0) {
-    char error_str[AV_ERROR_MAX_STRING_SIZE];
-    av_make_error_string(error_str, AV_ERROR_MAX_STRING_SIZE, ret);
-    fprintf(stderr, "Couldn't initialize video codec: %s\n", error_str);
-    BLI_strncpy(error, IMB_ffmpeg_last_error(), error_size);
+/* Hardware encoders in order of preference. Encoders that are not available on the system fail to
+ * open, and the next one is tried. */
+static const char *h264_hardware_encoders[] = {
+    "h264_nvenc", "h264_qsv", "h264_videotoolbox", "h264_amf", "h264_vaapi", nullptr};
+static const char *av1_hardware_encoders[] = {
+    "av1_nvenc", "av1_qsv", "av1_amf", "av1_vaapi", nullptr};
+
+/* Set up frames in device memory, for encoders that can't take frames from system memory. */
+static bool video_codec_hw_frames_init(FFMpegContext *context,
+                                       AVCodecContext *c,
+                                       AVHWDeviceType device_type,
+                                       AVPixelFormat hw_pix_fmt)
+{
+  if (av_hwdevice_ctx_create(&context->hw_device_ctx, device_type, nullptr, nullptr, 0) < 0) {
+    return false;
+  }
+  AVBufferRef *frames_ref = av_hwframe_ctx_alloc(context->hw_device_ctx);
+  if (frames_ref == nullptr) {
+    return false;
+  }
+  AVHWFramesContext *frames = (AVHWFramesContext *)frames_ref->data;
+  frames->format = hw_pix_fmt;
+  frames->sw_format = AV_PIX_FMT_NV12;
+  frames->width = c->width;
+  frames->height = c->height;
+  frames->initial_pool_size = 8;
+  if (av_hwframe_ctx_init(frames_ref) < 0) {
+    av_buffer_unref(&frames_ref);
+    return false;
+  }
+  c->pix_fmt = hw_pix_fmt;
+  c->hw_frames_ctx = frames_ref;
+  return true;
+}
+
+/* Open the first hardware encoder that works on this system, nullptr if there is none. */
+static AVCodecContext *open_hardware_video_codec(FFMpegContext *context,
+                                                 RenderData *rd,
+                                                 AVCodecID codec_id,
+                                                 AVFormatContext *of,
+                                                 AVStream *st,
+                                                 int rectx,
+                                                 int recty)
+{
+  /* Lossless and alpha output are only supported by the software encoders. */
+  if (context->ffmpeg_crf == 0 || rd->im_format.planes == R_IMF_PLANES_RGBA) {
+    return nullptr;
+  }
+
+  const char **encoder_names = nullptr;
+  if (codec_id == AV_CODEC_ID_H264) {
+    encoder_names = h264_hardware_encoders;
+  }
+  else if (codec_id == AV_CODEC_ID_AV1) {
+    encoder_names = av1_hardware_encoders;
+  }
+  else {
+    return nullptr;
+  }
+
+  for (; *encoder_names; encoder_names++) {
+    const AVCodec *codec = avcodec_find_encoder_by_name(*encoder_names);
+    if (codec == nullptr) {
+      continue;
+    }
+
+    AVDictionary *opts = nullptr;
+    AVCodecContext *c = video_codec_context_create(
+        context, rd, codec, codec_id, of, st, rectx, recty, &opts, true);
+    bool success = true;
+    if (BLI_str_endswith(codec->name, "_vaapi")) {
+      success = video_codec_hw_frames_init(
+          context, c, AV_HWDEVICE_TYPE_VAAPI, AV_PIX_FMT_VAAPI);
+    }
+    if (success) {
+      success = avcodec_open2(c, codec, &opts) >= 0;
+    }
     av_dict_free(&opts);
+
+    if (success) {
+      PRINT("Using hardware encoder %s\n", codec->name);
+      return c;
+    }
+
+    PRINT("Hardware encoder %s is not available\n", codec->name);
     avcodec_free_context(&c);
-    context->video_codec = nullptr;
+    av_buffer_unref(&context->hw_device_ctx);
+  }
+
+  return nullptr;
+}
+
+/* prepare a video stream for the output file */
+
+static AVStream *alloc_video_stream(FFMpegContext *context,
+                                    RenderData *rd,
+                                    AVCodecID codec_id,
+                                    AVFormatContext *of,
+                                    int rectx,
+                                    int recty,
+                                    char *error,
+                                    int error_size)
+{
+  AVStream *st;
+  const AVCodec *codec;
+  AVDictionary *opts = nullptr;
+
+  error[0] = '\0';
+
+  st = avformat_new_stream(of, nullptr);
+  if (!st) {
     return nullptr;
   }
-  av_dict_free(&opts);
+  st->id = 0;
+
+  /* Set up the codec context */
+
+  AVCodecContext *c = nullptr;
+  if (rd->ffcodecdata.flags & FFMPEG_USE_HW_ENCODER) {
+    c = open_hardware_video_codec(context, rd, codec_id, of, st, rectx, recty);
+  }
+
+  if (c == nullptr) {
+    if (codec_id == AV_CODEC_ID_AV1) {
+      /* Use get_av1_encoder() to get the ideal (hopefully) encoder for AV1 based
+       * on given parameters, and also set up opts. */
+      codec = get_av1_encoder(context, rd, &opts, rectx, recty);
+    }
+    else {
+      codec = avcodec_find_encoder(codec_id);
+    }
+    if (!codec) {
+      fprintf(stderr, "Couldn't find valid video codec\n");
+      context->video_codec = nullptr;
+      return nullptr;
+    }
+
+    c = video_codec_context_create(
+        context, rd, codec, codec_id, of, st, rectx, recty, &opts, false);
+
+    int ret = avcodec_open2(c, codec, &opts);
+
+    if (ret < 0) {
+      char error_str[AV_ERROR_MAX_STRING_SIZE];
+      av_make_error_string(error_str, AV_ERROR_MAX_STRING_SIZE, ret);
+      fprintf(stderr, "Couldn't initialize video codec: %s\n", error_str);
+      BLI_strncpy(error, IMB_ffmpeg_last_error(), error_size);
+      av_dict_free(&opts);
+      avcodec_free_context(&c);
+      context->video_codec = nullptr;
+      return nullptr;
+    }
+    av_dict_free(&opts);
+  }
+  context->video_codec = c;
+
+  /* Pixel format of the frames in system memory, uploaded to the device by the encoder or
+   * by #convert_video_frame. */
+  AVPixelFormat pix_fmt = c->pix_fmt;
+  if (c->hw_frames_ctx != nullptr) {
+    pix_fmt = ((AVHWFramesContext *)c->hw_frames_ctx->data)->sw_format;
+    context->hw_frame = av_frame_alloc();
+  }
 
   /* FFMPEG expects its data in the output pixel format. */
-  context->current_frame = alloc_picture(c->pix_fmt, c->width, c->height);
+  context->current_frame = alloc_picture(pix_fmt, c->width, c->height);
 
-  if (c->pix_fmt == AV_PIX_FMT_RGBA) {
+  if (pix_fmt == AV_PIX_FMT_RGBA) {
     /* Output pixel format is the same we use internally, no conversion necessary. */
     context->img_convert_frame = nullptr;
     context->img_convert_ctx = nullptr;
@@ -1108,7 +1300,7 @@ static AVStream *alloc_video_stream(FFMpegContext *context,
     /* Output pixel format is different, allocate frame for conversion. */
     context->img_convert_frame = alloc_picture(AV_PIX_FMT_RGBA, c->width, c->height);
     context->img_convert_ctx = BKE_ffmpeg_sws_get_context(
-        c->width, c->height, AV_PIX_FMT_RGBA, c->pix_fmt, SWS_BICUBIC);
+        c->width, c->height, AV_PIX_FMT_RGBA, pix_fmt, SWS_BICUBIC);
   }
 
   avcodec_parameters_from_context(st->codecpar, c);
@@ -1692,6 +1884,17 @@ bool BKE_ffmpeg_start(void *context_v,
         scene, specs, preview ? rd->psfra : rd->sfra, rd->ffcodecdata.audio_volume);
   }
 #  endif
+
+  /* Encode in the background while the next frame renders. With autosplit the file size has to
+   * be checked after every frame, so it's encoded immediately. */
+  if (success && context->video_stream && !context->ffmpeg_autosplit) {
+    BLI_mutex_init(&context->encode_mutex);
+    BLI_condition_init(&context->encode_cond);
+    context->encode_pending_frames = 0;
+    context->encode_failed = false;
+    context->encode_pool = BLI_task_pool_create_background_serial(context, TASK_PRIORITY_HIGH);
+  }
+
   return success;
 }
 
@@ -1712,6 +1915,82 @@ static void write_audio_frames(FFMpegContext *context, double to_pts)
 }
 #  endif
 
+struct EncodeFrameTask {
+  AVFrame *rgb_frame;
+  /* Time up to which audio is encoded after this frame. */
+  double audio_to_pts;
+};
+
+static void encode_frame_task_run(TaskPool *__restrict pool, void *taskdata)
+{
+  FFMpegContext *context = static_cast<FFMpegContext *>(BLI_task_pool_user_data(pool));
+  EncodeFrameTask *task = static_cast<EncodeFrameTask *>(taskdata);
+
+  /* Only this task writes to encode_failed, and tasks run one after the other. */
+  bool success = !context->encode_failed;
+  if (success) {
+    AVFrame *avframe = convert_video_frame(context, task->rgb_frame);
+    success = (avframe && write_video_frame(context, avframe, nullptr));
+#  ifdef WITH_AUDASPACE
+    write_audio_frames(context, task->audio_to_pts);
+#  endif
+  }
+
+  BLI_mutex_lock(&context->encode_mutex);
+  context->encode_failed |= !success;
+  context->encode_pending_frames--;
+  BLI_condition_notify_all(&context->encode_cond);
+  BLI_mutex_unlock(&context->encode_mutex);
+}
+
+static void encode_frame_task_free(TaskPool *__restrict /*pool*/, void *taskdata)
+{
+  EncodeFrameTask *task = static_cast<EncodeFrameTask *>(taskdata);
+  delete_picture(task->rgb_frame);
+  MEM_delete(task);
+}
+
+/* Copy the image and queue it for encoding in the background. */
+static bool append_video_frame_background(FFMpegContext *context,
+                                          const ImBuf *image,
+                                          double audio_to_pts)
+{
+  /* For now only 8-bit/channel images are supported. */
+  if (image->byte_buffer.data == nullptr) {
+    return false;
+  }
+
+  AVCodecContext *c = context->video_codec;
+  AVFrame *rgb_frame = alloc_picture(AV_PIX_FMT_RGBA, c->width, c->height);
+  if (rgb_frame == nullptr) {
+    return false;
+  }
+  image_to_rgba_frame(image, rgb_frame);
+
+  BLI_mutex_lock(&context->encode_mutex);
+  while (context->encode_pending_frames >= FFMPEG_MAX_PENDING_FRAMES && !context->encode_failed)
+  {
+    BLI_condition_wait(&context->encode_cond, &context->encode_mutex);
+  }
+  const bool failed = context->encode_failed;
+  if (!failed) {
+    context->encode_pending_frames++;
+  }
+  BLI_mutex_unlock(&context->encode_mutex);
+
+  if (failed) {
+    delete_picture(rgb_frame);
+    return false;
+  }
+
+  EncodeFrameTask *task = MEM_new<EncodeFrameTask>(__func__);
+  task->rgb_frame = rgb_frame;
+  task->audio_to_pts = audio_to_pts;
+  BLI_task_pool_push(
+      context->encode_pool, encode_frame_task_run, task, true, encode_frame_task_free);
+  return true;
+}
+
 bool BKE_ffmpeg_append(void *context_v,
                        RenderData *rd,
                        int start_frame,
@@ -1727,14 +2006,24 @@ bool BKE_ffmpeg_append(void *context_v,
   PRINT("Writing frame %i, render width=%d, render height=%d\n", frame, image->x, image->y);
 
   if (context->video_stream) {
+    /* Add +1 frame because we want to encode audio up until the next video frame. */
+    const double audio_to_pts = (frame - start_frame + 1) /
+                                (double(rd->frs_sec) / double(rd->frs_sec_base));
+
+    if (context->encode_pool) {
+      success = append_video_frame_background(context, image, audio_to_pts);
+      if (!success) {
+        BKE_report(reports, RPT_ERROR, "Error writing frame");
+      }
+      return success;
+    }
+
     avframe = generate_video_frame(context, image);
     success = (avframe && write_video_frame(context, avframe, reports));
 #  ifdef WITH_AUDASPACE
-    /* Add +1 frame because we want to encode audio up until the next video frame. */
-    write_audio_frames(
-        context, (frame - start_frame + 1) / (double(rd->frs_sec) / double(rd->frs_sec_base)));
+    write_audio_frames(context, audio_to_pts);
 #  else
-    UNUSED_VARS(start_frame);
+    UNUSED_VARS(audio_to_pts);
 #  endif
 
     if (context->ffmpeg_autosplit) {
@@ -1754,6 +2043,18 @@ static void end_ffmpeg_impl(FFMpegContext *context, int is_autosplit)
 {
   PRINT("Closing FFMPEG...\n");
 
+  /* Finish encoding frames that are still queued, before flushing the encoder. */
+  if (context->encode_pool) {
+    BLI_task_pool_work_and_wait(context->encode_pool);
+    BLI_task_pool_free(context->encode_pool);
+    context->encode_pool = nullptr;
+    BLI_condition_end(&context->encode_cond);
+    BLI_mutex_end(&context->encode_mutex);
+    if (context->encode_failed) {
+      fprintf(stderr, "Error writing frames in the background\n");
+    }
+  }
+
 #  ifdef WITH_AUDASPACE
   if (is_autosplit == false) {
     if (context->audio_mixdown_device) {
@@ -1799,6 +2100,9 @@ static void end_ffmpeg_impl(FFMpegContext *context, int is_autosplit)
     delete_picture(context->img_convert_frame);
     context->img_convert_frame = nullptr;
   }
+  if (context->hw_frame != nullptr) {
+    av_frame_free(&context->hw_frame);
+  }
 
   if (context->outfile != nullptr && context->outfile->oformat) {
     if (!(context->outfile->oformat->flags & AVFMT_NOFILE)) {
@@ -1814,6 +2118,9 @@ static void end_ffmpeg_impl(FFMpegContext *context, int is_autosplit)
     avcodec_free_context(&context->audio_codec);
     context->audio_codec = nullptr;
   }
+  if (context->hw_device_ctx != nullptr) {
+    av_buffer_unref(&context->hw_device_ctx);
+  }
 
   if (context->outfile != nullptr) {
     avformat_free_context(context->outfile);
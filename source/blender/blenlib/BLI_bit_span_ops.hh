@@ -106,6 +106,63 @@ inline bool any_set_expr(ExprFn &&expr, const FirstBitSpanT &first_arg, const Bi
   }
 }
 
+/**
+ * Evaluates the expression on one or more bit spans and returns the number of 1 bits in the
+ * result.
+ *
+ * The expected type for the expression is:
+ *   (BitInt ...one_or_more_args) -> BitInt
+ */
+template<typename ExprFn, typename FirstBitSpanT, typename... BitSpanT>
+inline int64_t count_set_bits_expr(ExprFn &&expr,
+                                   const FirstBitSpanT &first_arg,
+                                   const BitSpanT &...args)
+{
+  const int64_t size = first_arg.size();
+  BLI_assert(((size == args.size()) && ...));
+  if (size == 0) {
+    return 0;
+  }
+
+  if constexpr (all_bounded_spans<FirstBitSpanT, BitSpanT...>) {
+    const BitInt *first_data = first_arg.data();
+    const int64_t full_ints_num = first_arg.full_ints_num();
+    /* Count full ints without any masking. Using separate accumulators keeps the loop free of a
+     * dependency chain so that multiple population counts can be in flight at once. */
+    int64_t counts[4] = {0, 0, 0, 0};
+    int64_t int_i = 0;
+    for (; int_i + 3 < full_ints_num; int_i += 4) {
+      counts[0] += count_bits_uint64(expr(first_data[int_i], args.data()[int_i]...));
+      counts[1] += count_bits_uint64(expr(first_data[int_i + 1], args.data()[int_i + 1]...));
+      counts[2] += count_bits_uint64(expr(first_data[int_i + 2], args.data()[int_i + 2]...));
+      counts[3] += count_bits_uint64(expr(first_data[int_i + 3], args.data()[int_i + 3]...));
+    }
+    for (; int_i < full_ints_num; int_i++) {
+      counts[0] += count_bits_uint64(expr(first_data[int_i], args.data()[int_i]...));
+    }
+    int64_t count = counts[0] + counts[1] + counts[2] + counts[3];
+    /* Count the remaining bits. */
+    if (const int64_t final_bits = first_arg.final_bits_num()) {
+      const BitInt result = expr(first_data[full_ints_num] >> first_arg.offset(),
+                                 (args.data()[full_ints_num] >> args.offset())...);
+      count += count_bits_uint64(result & mask_first_n_bits(final_bits));
+    }
+    return count;
+  }
+  else {
+    /* Fallback or arbitrary bit spans. This could be implemented more efficiently but adds more
+     * complexity and is not necessary yet. */
+    int64_t count = 0;
+    for (const int64_t i : IndexRange(size)) {
+      const BitInt result = expr(BitInt(first_arg[i].test()), BitInt(args[i].test())...);
+      if (result & 1) {
+        count++;
+      }
+    }
+    return count;
+  }
+}
+
 /**
  * Evaluates the expression on one or more bit spans and calls the `handle` function for each bit
  * index where the result is 1.
@@ -179,6 +236,14 @@ inline bool any_set_expr(ExprFn &&expr, const FirstBitSpanT &first_arg, const Bi
   return detail::any_set_expr(expr, to_best_bit_span(first_arg), to_best_bit_span(args)...);
 }
 
+template<typename ExprFn, typename FirstBitSpanT, typename... BitSpanT>
+inline int64_t count_set_bits_expr(ExprFn &&expr,
+                                   const FirstBitSpanT &first_arg,
+                                   const BitSpanT &...args)
+{
+  return detail::count_set_bits_expr(expr, to_best_bit_span(first_arg), to_best_bit_span(args)...);
+}
+
 template<typename ExprFn, typename HandleFn, typename FirstBitSpanT, typename... BitSpanT>
 inline void foreach_1_index_expr(ExprFn &&expr,
                                  HandleFn &&handle,
@@ -225,6 +290,14 @@ inline void inplace_and(FirstBitSpanT &first_arg, const BitSpanT &...args)
   mix_into_first_expr([](const auto... x) { return (x & ...); }, first_arg, args...);
 }
 
+/** Unset all bits in the first span that are set in any of the other spans. */
+template<typename FirstBitSpanT, typename... BitSpanT>
+inline void inplace_and_not(FirstBitSpanT &first_arg, const BitSpanT &...args)
+{
+  mix_into_first_expr(
+      [](const BitInt a, const auto... x) { return a & ~(x | ...); }, first_arg, args...);
+}
+
 template<typename... BitSpanT>
 inline void operator|=(MutableBitSpan first_arg, const BitSpanT &...args)
 {
@@ -269,6 +342,18 @@ template<typename BitSpanT> inline bool any_bit_unset(const BitSpanT &arg)
   return has_common_unset_bits(arg);
 }
 
+/** Number of bits that are set, i.e. the population count of the span. */
+template<typename BitSpanT> inline int64_t count_set_bits(const BitSpanT &arg)
+{
+  return count_set_bits_expr([](const BitInt x) { return x; }, arg);
+}
+
+/** Number of bits that are set in all of the given spans. */
+template<typename... BitSpanT> inline int64_t count_common_set_bits(const BitSpanT &...args)
+{
+  return count_set_bits_expr([](const auto... x) { return (x & ...); }, args...);
+}
+
 template<typename BitSpanT, typename Fn> inline void foreach_1_index(const BitSpanT &data, Fn &&fn)
 {
   foreach_1_index_expr([](const BitInt x) { return x; }, fn, data);
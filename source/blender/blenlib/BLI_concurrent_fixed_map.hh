@@ -0,0 +1,208 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+#pragma once
+
+/** \file
+ * \ingroup bli
+ *
+ * A #ConcurrentFixedMap is an open-addressing hash map that multiple threads can add to and look
+ * up from at the same time without locks. It uses the same hashing and probing strategies as
+ * #Map.
+ *
+ * To make this possible without locks, the map does not grow and does not support removal. The
+ * maximum number of keys has to be known when it is constructed. That fits the common case of
+ * deduplicating keys generated from existing data in parallel, e.g. edges of faces, where an
+ * upper bound is known.
+ *
+ * Every slot has an atomic state. A thread that adds a key claims an empty slot with a
+ * compare-and-swap, then constructs the key and value and publishes them by setting the state
+ * to occupied. Other threads probing the same slot wait for that, which only takes as long as
+ * constructing the key and value.
+ *
+ * Compared to #ConcurrentMap, there are no accessors; values must not be modified concurrently
+ * after they were added, unless they are atomics themselves.
+ */
+
+#include <atomic>
+
+#include "BLI_array.hh"
+#include "BLI_hash.hh"
+#include "BLI_hash_tables.hh"
+#include "BLI_memory_utils.hh"
+#include "BLI_probing_strategies.hh"
+#include "BLI_utility_mixins.hh"
+
+namespace blender {
+
+template<typename Key,
+         typename Value,
+         typename ProbingStrategy = DefaultProbingStrategy,
+         typename Hash = DefaultHash<Key>,
+         typename IsEqual = DefaultEquality<Key>>
+class ConcurrentFixedMap : NonCopyable, NonMovable {
+ private:
+  enum class SlotState : uint8_t {
+    Empty = 0,
+    /** A thread is constructing the key and value. */
+    Pending = 1,
+    Occupied = 2,
+  };
+
+  struct Slot {
+    std::atomic<SlotState> state{SlotState::Empty};
+    TypedBuffer<Key> key;
+    TypedBuffer<Value> value;
+  };
+
+  Array<Slot> slots_;
+  uint64_t slot_mask_;
+  std::atomic<int64_t> size_ = 0;
+#ifndef NDEBUG
+  int64_t max_size_;
+#endif
+
+ public:
+  /**
+   * \param max_size: The largest number of keys that will be added to the map.
+   */
+  explicit ConcurrentFixedMap(const int64_t max_size)
+      : slots_(LoadFactor::compute_total_slots(std::max<int64_t>(max_size, 1), 1, 2))
+  {
+    slot_mask_ = uint64_t(slots_.size() - 1);
+#ifndef NDEBUG
+    max_size_ = max_size;
+#endif
+  }
+
+  ~ConcurrentFixedMap()
+  {
+    for (Slot &slot : slots_) {
+      if (slot.state.load(std::memory_order_relaxed) == SlotState::Occupied) {
+        slot.key.ref().~Key();
+        slot.value.ref().~Value();
+      }
+    }
+  }
+
+  /**
+   * Get the value for the key, or add a value created by \a create_value() if the key does not
+   * exist yet. When multiple threads add the same key at the same time, only one of them calls
+   * \a create_value.
+   *
+   * \return The stored value and whether it was added by this call.
+   */
+  template<typename CreateValueF>
+  std::pair<const Value &, bool> lookup_or_add_cb(const Key &key, const CreateValueF &create_value)
+  {
+    const uint64_t hash = Hash{}(key);
+    SLOT_PROBING_BEGIN (ProbingStrategy, hash, slot_mask_, slot_index) {
+      Slot &slot = slots_[slot_index];
+      SlotState state = slot.state.load(std::memory_order_acquire);
+      if (state == SlotState::Empty) {
+        if (slot.state.compare_exchange_strong(
+                state, SlotState::Pending, std::memory_order_acquire))
+        {
+          new (slot.key.ptr()) Key(key);
+          new (slot.value.ptr()) Value(create_value());
+          slot.state.store(SlotState::Occupied, std::memory_order_release);
+          [[maybe_unused]] const int64_t new_size = size_.fetch_add(1,
+                                                                    std::memory_order_relaxed);
+          BLI_assert_msg(new_size < max_size_, "More keys added than the map was created for");
+          return {slot.value.ref(), true};
+        }
+        /* Another thread claimed the slot, continue with its new state. */
+      }
+      if (state == SlotState::Pending) {
+        state = this->wait_until_occupied(slot);
+      }
+      if (IsEqual{}(key, slot.key.ref())) {
+        return {slot.value.ref(), false};
+      }
+    }
+    SLOT_PROBING_END();
+  }
+
+  /**
+   * Add the key-value-pair if the key does not exist yet.
+   * \return True if it was added.
+   */
+  bool add(const Key &key, const Value &value)
+  {
+    return this->lookup_or_add_cb(key, [&]() { return value; }).second;
+  }
+
+  /**
+   * Get a pointer to the value for the key, or null when it does not exist. This can be called
+   * while other threads add keys, those may or may not be found.
+   */
+  const Value *lookup_ptr(const Key &key) const
+  {
+    const uint64_t hash = Hash{}(key);
+    SLOT_PROBING_BEGIN (ProbingStrategy, hash, slot_mask_, slot_index) {
+      const Slot &slot = slots_[slot_index];
+      SlotState state = slot.state.load(std::memory_order_acquire);
+      if (state == SlotState::Empty) {
+        return nullptr;
+      }
+      if (state == SlotState::Pending) {
+        state = this->wait_until_occupied(slot);
+      }
+      if (IsEqual{}(key, slot.key.ref())) {
+        return &slot.value.ref();
+      }
+    }
+    SLOT_PROBING_END();
+  }
+
+  const Value &lookup(const Key &key) const
+  {
+    const Value *value = this->lookup_ptr(key);
+    BLI_assert(value != nullptr);
+    return *value;
+  }
+
+  bool contains(const Key &key) const
+  {
+    return this->lookup_ptr(key) != nullptr;
+  }
+
+  /**
+   * Number of keys in the map. While other threads add keys, this is only approximate.
+   */
+  int64_t size() const
+  {
+    return size_.load(std::memory_order_relaxed);
+  }
+
+  bool is_empty() const
+  {
+    return this->size() == 0;
+  }
+
+  /**
+   * Call the function for every key-value-pair. Must not be called while keys are added. The
+   * order is arbitrary.
+   */
+  template<typename Fn> void foreach_item(const Fn &fn) const
+  {
+    for (const Slot &slot : slots_) {
+      if (slot.state.load(std::memory_order_relaxed) == SlotState::Occupied) {
+        fn(slot.key.ref(), slot.value.ref());
+      }
+    }
+  }
+
+ private:
+  static SlotState wait_until_occupied(const Slot &slot)
+  {
+    SlotState state;
+    while ((state = slot.state.load(std::memory_order_acquire)) != SlotState::Occupied) {
+      /* Pass, constructing a key and value is expected to be very short. */
+    }
+    return state;
+  }
+};
+
+}  // namespace blender
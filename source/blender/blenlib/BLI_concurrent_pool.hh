@@ -0,0 +1,149 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup bli
+ *
+ * A `blender::ConcurrentPool` is a thread-safe version of `blender::Pool`. Elements can be
+ * constructed and destructed from multiple threads at the same time.
+ *
+ * Every thread has its own list of free elements and allocates its own chunks, so the common case
+ * of constructing and destructing elements does not lock. Threads that free many more elements
+ * than they construct hand batches of free elements over to a shared list, from which threads
+ * that run out of free elements steal them before allocating a new chunk. Only those hand-overs
+ * take a lock.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <mutex>
+
+#include "BLI_enumerable_thread_specific.hh"
+#include "BLI_stack.hh"
+#include "BLI_utility_mixins.hh"
+#include "BLI_vector.hh"
+
+namespace blender {
+
+template<typename T, int64_t ChunkLen = 64> class ConcurrentPool : NonCopyable, NonMovable {
+ private:
+  using Chunk = TypedBuffer<T, ChunkLen>;
+
+  /** Number of free elements that are moved to the shared list at once. */
+  static constexpr int64_t BatchLen = ChunkLen * 2;
+
+  struct ThreadData {
+    /** Chunks allocated by this thread. They may contain elements used by other threads. */
+    Vector<std::unique_ptr<Chunk>> chunks;
+    /** Freed elements to be used for the next allocations on this thread. */
+    Stack<T *, 0> free_list;
+    /**
+     * Number of elements constructed minus number of elements destructed on this thread. Can be
+     * negative when elements are destructed on a different thread than they were constructed on.
+     */
+    int64_t size = 0;
+  };
+
+  threading::EnumerableThreadSpecific<ThreadData> thread_data_;
+
+  /** Batches of free elements that any thread can take when it runs out of free elements. */
+  Vector<Vector<T *>> shared_free_batches_;
+  /** Size of #shared_free_batches_, to avoid locking when there is nothing to steal. */
+  std::atomic<int64_t> shared_free_batches_num_ = 0;
+  std::mutex shared_mutex_;
+
+ public:
+  ~ConcurrentPool()
+  {
+    /* All elements need to be freed before freeing the pool. */
+    BLI_assert(this->size() == 0);
+  }
+
+  /**
+   * Construct an object inside this pool's memory. Can be called from multiple threads at the
+   * same time.
+   */
+  template<typename... ForwardT> T &construct(ForwardT &&...value)
+  {
+    ThreadData &data = thread_data_.local();
+    if (data.free_list.is_empty()) {
+      this->refill_free_list(data);
+    }
+    T *ptr = data.free_list.pop();
+    new (ptr) T(std::forward<ForwardT>(value)...);
+    data.size++;
+    return *ptr;
+  }
+
+  /**
+   * Destroy the given element inside this memory pool. Memory will be reused by next element
+   * construction. The element may have been constructed on a different thread. This invokes
+   * undefined behavior if the item is not from this pool.
+   */
+  void destruct(T &value)
+  {
+    value.~T();
+    ThreadData &data = thread_data_.local();
+    data.free_list.push(&value);
+    data.size--;
+    if (data.free_list.size() >= BatchLen * 2) {
+      this->share_free_batch(data);
+    }
+  }
+
+  /**
+   * Return the number of constructed elements in this pool. Must not be called while other
+   * threads construct or destruct elements.
+   */
+  int64_t size()
+  {
+    int64_t size = 0;
+    for (const ThreadData &data : thread_data_) {
+      size += data.size;
+    }
+    return size;
+  }
+
+  /**
+   * Returns true when the pool contains no elements, otherwise false. Must not be called while
+   * other threads construct or destruct elements.
+   */
+  bool is_empty()
+  {
+    return this->size() == 0;
+  }
+
+ private:
+  void refill_free_list(ThreadData &data)
+  {
+    if (shared_free_batches_num_.load(std::memory_order_relaxed) > 0) {
+      std::lock_guard lock{shared_mutex_};
+      if (!shared_free_batches_.is_empty()) {
+        const Vector<T *> batch = shared_free_batches_.pop_last();
+        shared_free_batches_num_.store(shared_free_batches_.size(), std::memory_order_relaxed);
+        data.free_list.push_multiple(batch);
+        return;
+      }
+    }
+    data.chunks.append(std::make_unique<Chunk>());
+    T *chunk_start = data.chunks.last()->ptr();
+    for (auto i : IndexRange(ChunkLen)) {
+      data.free_list.push(chunk_start + i);
+    }
+  }
+
+  void share_free_batch(ThreadData &data)
+  {
+    Vector<T *> batch(BatchLen);
+    for (T *&ptr : batch) {
+      ptr = data.free_list.pop();
+    }
+    std::lock_guard lock{shared_mutex_};
+    shared_free_batches_.append(std::move(batch));
+    shared_free_batches_num_.store(shared_free_batches_.size(), std::memory_order_relaxed);
+  }
+};
+
+}  // namespace blender
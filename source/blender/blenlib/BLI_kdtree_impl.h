@@ -44,6 +44,21 @@ int BLI_kdtree_nd_(find_nearest_n)(const KDTree *tree,
                                    KDTreeNearest *r_nearest,
                                    uint nearest_len_capacity) ATTR_NONNULL(1, 2, 3);
 
+/**
+ * Find the \a nearest_len_capacity nearest points for each of the \a co_len points in \a co,
+ * running the queries in parallel.
+ *
+ * \param r_nearest: An array sized at least `co_len * nearest_len_capacity`. The results of each
+ * query are stored in consecutive ranges of \a nearest_len_capacity elements.
+ * \param r_nearest_len: Optional array sized \a co_len, the number of points found per query.
+ */
+void BLI_kdtree_nd_(find_nearest_n_batch)(const KDTree *tree,
+                                          const float (*co)[KD_DIMS],
+                                          int co_len,
+                                          KDTreeNearest *r_nearest,
+                                          uint nearest_len_capacity,
+                                          int *r_nearest_len) ATTR_NONNULL(1, 2, 4);
+
 int BLI_kdtree_nd_(range_search)(const KDTree *tree,
                                  const float co[KD_DIMS],
                                  KDTreeNearest **r_nearest,
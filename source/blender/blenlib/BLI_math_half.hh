@@ -0,0 +1,33 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+#pragma once
+
+/** \file
+ * \ingroup bli
+ *
+ * Conversion between single precision floats and IEEE 754 half precision floats stored as 16 bit
+ * integers.
+ */
+
+#include <cstdint>
+
+namespace blender::math {
+
+/**
+ * Convert a float to a half float, rounding to the nearest representable value with ties to even.
+ * Values too large to be represented become infinities and NaN values are preserved.
+ */
+uint16_t float_to_half(float value);
+
+/** Convert a half float to a float, which is always exact. */
+float half_to_float(uint16_t value);
+
+/** Convert the given number of floats to half floats. */
+void float_to_half_array(const float *src, uint16_t *dst, int64_t size);
+
+/** Convert the given number of half floats to floats. */
+void half_to_float_array(const uint16_t *src, float *dst, int64_t size);
+
+}  // namespace blender::math
@@ -131,22 +131,35 @@ class RandomNumberGenerator {
   void get_bytes(MutableSpan<char> r_bytes);
 
   /**
-   * Simulate getting \a n random values.
+   * Simulate getting \a n random values. This takes logarithmic time, so different parts of one
+   * deterministic sequence can be generated in parallel by skipping to their start.
    */
   void skip(int64_t n)
   {
-    while (n--) {
-      this->step();
+    /* Compose the affine step `x * multiplier + addend` with itself by repeated squaring. */
+    uint64_t step_multiplier = multiplier;
+    uint64_t step_addend = addend;
+    uint64_t total_multiplier = 1;
+    uint64_t total_addend = 0;
+    while (n > 0) {
+      if (n & 1) {
+        total_multiplier *= step_multiplier;
+        total_addend = total_addend * step_multiplier + step_addend;
+      }
+      step_addend *= step_multiplier + 1;
+      step_multiplier *= step_multiplier;
+      n >>= 1;
     }
+    x_ = (total_multiplier * x_ + total_addend) & mask;
   }
 
  private:
+  static constexpr uint64_t multiplier = 0x5DEECE66Dll;
+  static constexpr uint64_t addend = 0xB;
+  static constexpr uint64_t mask = 0x0000FFFFFFFFFFFFll;
+
   void step()
   {
-    constexpr uint64_t multiplier = 0x5DEECE66Dll;
-    constexpr uint64_t addend = 0xB;
-    constexpr uint64_t mask = 0x0000FFFFFFFFFFFFll;
-
     x_ = (multiplier * x_ + addend) & mask;
   }
 };
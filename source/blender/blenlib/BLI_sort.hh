@@ -8,12 +8,19 @@
  * \ingroup bli
  */
 
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+#include <type_traits>
+
 #ifdef WITH_TBB
 #  include <tbb/parallel_sort.h>
-#else
-#  include <algorithm>
 #endif
 
+#include "BLI_array.hh"
+#include "BLI_span.hh"
+#include "BLI_task.hh"
+
 namespace blender {
 
 #ifdef WITH_TBB
@@ -31,4 +38,174 @@ void parallel_sort(RandomAccessIterator begin, RandomAccessIterator end, const C
 }
 #endif
 
+namespace detail {
+
+/**
+ * Stable LSD radix sort of 32 bit keys, using 8 bit digits. The \a values are reordered along with
+ * the keys, they may be empty.
+ */
+void radix_sort_uint32(MutableSpan<uint32_t> keys, MutableSpan<int> values);
+
+template<typename Key> inline constexpr bool is_radix_sort_key_v =
+    std::is_same_v<Key, int32_t> || std::is_same_v<Key, uint32_t> || std::is_same_v<Key, float>;
+
+/** Map a key to an unsigned integer with the same order. */
+template<typename Key> inline uint32_t radix_sort_key_to_uint(const Key key)
+{
+  static_assert(is_radix_sort_key_v<Key>);
+  uint32_t bits;
+  memcpy(&bits, &key, sizeof(bits));
+  if constexpr (std::is_same_v<Key, int32_t>) {
+    return bits ^ 0x80000000u;
+  }
+  else if constexpr (std::is_same_v<Key, float>) {
+    /* Negative values are reversed, positive values are moved above them. */
+    return (bits & 0x80000000u) ? ~bits : (bits ^ 0x80000000u);
+  }
+  return bits;
+}
+
+template<typename Key> inline Key radix_sort_uint_to_key(const uint32_t value)
+{
+  uint32_t bits = value;
+  if constexpr (std::is_same_v<Key, int32_t>) {
+    bits = value ^ 0x80000000u;
+  }
+  else if constexpr (std::is_same_v<Key, float>) {
+    bits = (value & 0x80000000u) ? (value ^ 0x80000000u) : ~value;
+  }
+  Key key;
+  memcpy(&key, &bits, sizeof(key));
+  return key;
+}
+
+template<typename T, typename Compare>
+void parallel_merge(Span<T> a, Span<T> b, MutableSpan<T> dst, const Compare &comp)
+{
+  BLI_assert(a.size() + b.size() == dst.size());
+  if (dst.size() < 8192) {
+    std::merge(a.begin(), a.end(), b.begin(), b.end(), dst.begin(), comp);
+    return;
+  }
+  /* Split the larger range in half and find the matching split in the other. Equal elements of
+   * #a always end up before those of #b, which keeps the merge stable. */
+  int64_t a_split, b_split;
+  if (a.size() >= b.size()) {
+    a_split = a.size() / 2;
+    b_split = std::lower_bound(b.begin(), b.end(), a[a_split], comp) - b.begin();
+  }
+  else {
+    b_split = b.size() / 2;
+    a_split = std::upper_bound(a.begin(), a.end(), b[b_split], comp) - a.begin();
+  }
+  const int64_t dst_split = a_split + b_split;
+  threading::parallel_invoke(
+      [&]() {
+        parallel_merge(
+            a.take_front(a_split), b.take_front(b_split), dst.take_front(dst_split), comp);
+      },
+      [&]() {
+        parallel_merge(
+            a.drop_front(a_split), b.drop_front(b_split), dst.drop_front(dst_split), comp);
+      });
+}
+
+}  // namespace detail
+
+/**
+ * Sort integer or floating point values with a parallel radix sort, which is faster than
+ * #parallel_sort for large arrays.
+ */
+template<typename Key> void parallel_radix_sort(MutableSpan<Key> keys)
+{
+  static_assert(detail::is_radix_sort_key_v<Key>);
+  MutableSpan<uint32_t> bits(reinterpret_cast<uint32_t *>(keys.data()), keys.size());
+  if constexpr (!std::is_same_v<Key, uint32_t>) {
+    threading::parallel_for(keys.index_range(), 4096, [&](const IndexRange range) {
+      for (const int64_t i : range) {
+        bits[i] = detail::radix_sort_key_to_uint(keys[i]);
+      }
+    });
+  }
+  detail::radix_sort_uint32(bits, {});
+  if constexpr (!std::is_same_v<Key, uint32_t>) {
+    threading::parallel_for(keys.index_range(), 4096, [&](const IndexRange range) {
+      for (const int64_t i : range) {
+        keys[i] = detail::radix_sort_uint_to_key<Key>(bits[i]);
+      }
+    });
+  }
+}
+
+/**
+ * Reorder \a indices so that `keys[indices[i]]` is ascending, with a parallel radix sort. The
+ * order of indices with equal keys is kept. For floating point keys, zero and negative zero are
+ * considered equal, like when comparing them.
+ */
+template<typename Key>
+void parallel_radix_sort_indices_by_key(const Span<Key> keys, MutableSpan<int> indices)
+{
+  static_assert(detail::is_radix_sort_key_v<Key>);
+  Array<uint32_t> bits(indices.size(), NoInitialization());
+  threading::parallel_for(indices.index_range(), 4096, [&](const IndexRange range) {
+    for (const int64_t i : range) {
+      Key key = keys[indices[i]];
+      if constexpr (std::is_same_v<Key, float>) {
+        if (key == 0.0f) {
+          key = 0.0f;
+        }
+      }
+      bits[i] = detail::radix_sort_key_to_uint(key);
+    }
+  });
+  detail::radix_sort_uint32(bits, indices);
+}
+
+/**
+ * Sort with a parallel merge sort. Unlike #parallel_sort, the order of elements that compare
+ * equal is kept.
+ */
+template<typename T, typename Compare>
+void parallel_stable_sort(MutableSpan<T> data, const Compare &comp)
+{
+  constexpr int64_t chunk_size = 8192;
+  if (data.size() <= chunk_size) {
+    std::stable_sort(data.begin(), data.end(), comp);
+    return;
+  }
+  const int64_t chunks_num = (data.size() + chunk_size - 1) / chunk_size;
+  threading::parallel_for(IndexRange(chunks_num), 1, [&](const IndexRange range) {
+    for (const int64_t chunk : range) {
+      MutableSpan<T> chunk_data = data.slice_safe(chunk * chunk_size, chunk_size);
+      std::stable_sort(chunk_data.begin(), chunk_data.end(), comp);
+    }
+  });
+
+  /* Merge sorted runs of increasing size, alternating between the data and the buffer. */
+  Array<T> buffer(data.size());
+  MutableSpan<T> src = data;
+  MutableSpan<T> dst = buffer;
+  for (int64_t run_size = chunk_size; run_size < data.size(); run_size *= 2) {
+    const int64_t pairs_num = (data.size() + run_size * 2 - 1) / (run_size * 2);
+    threading::parallel_for(IndexRange(pairs_num), 1, [&](const IndexRange range) {
+      for (const int64_t pair : range) {
+        const IndexRange pair_range = IndexRange(pair * run_size * 2, run_size * 2)
+                                          .intersect(data.index_range());
+        const Span<T> runs = src.slice(pair_range);
+        const int64_t a_size = std::min(run_size, runs.size());
+        detail::parallel_merge(
+            runs.take_front(a_size), runs.drop_front(a_size), dst.slice(pair_range), comp);
+      }
+    });
+    std::swap(src, dst);
+  }
+  if (src.data() != data.data()) {
+    threading::parallel_for(data.index_range(), 4096, [&](const IndexRange range) {
+      std::move(src.begin() + range.start(),
+                src.begin() + range.one_after_last(),
+                data.begin() + range.start());
+    });
+  }
+}
+
 }  // namespace blender
@@ -131,6 +131,63 @@ ThreadMutex *BLI_task_pool_user_mutex(TaskPool *pool);
 
 /** \} */
 
+/* -------------------------------------------------------------------- */
+/** \name Task Pool Statistics
+ *
+ * Optional instrumentation of task pools, to find out whether slow operations are caused by
+ * contention or by a lack of parallelism. Collecting statistics adds a small overhead to every
+ * task, so it is disabled by default.
+ * \{ */
+
+typedef struct TaskPoolStats {
+  /** Time since the statistics were enabled or reset, in seconds. */
+  double elapsed_time;
+  uint64_t pools_created;
+  uint64_t tasks_pushed;
+  uint64_t tasks_run;
+  /** Tasks that ran on a different thread than the one that pushed them. */
+  uint64_t tasks_stolen;
+  /** Largest number of tasks that were pushed to a single pool but did not start running yet. */
+  uint64_t max_pending_tasks;
+  /** Total time spent running tasks on all threads, in seconds. */
+  double task_time;
+  uint64_t waits;
+  /**
+   * Total time spent in #BLI_task_pool_work_and_wait, in seconds. Waiting threads may run tasks
+   * themselves, that time is included.
+   */
+  double wait_time;
+  double main_thread_wait_time;
+} TaskPoolStats;
+
+typedef struct TaskPoolThreadStats {
+  uint64_t tasks_run;
+  /** Time spent running tasks, in seconds. The idle time is the elapsed time minus this. */
+  double busy_time;
+} TaskPoolThreadStats;
+
+/**
+ * Enabling statistics also clears the previously collected ones.
+ * \param use_trace: Also record the start and duration of every task and wait, so that they can
+ * be written with #BLI_task_pool_stats_write_trace.
+ */
+void BLI_task_pool_stats_enable(bool use_trace);
+void BLI_task_pool_stats_disable(void);
+bool BLI_task_pool_stats_is_enabled(void);
+void BLI_task_pool_stats_get(TaskPoolStats *r_stats);
+/**
+ * Get statistics for every thread that ran tasks, indexed by the task scheduler's thread index.
+ * \return The number of threads written to \a r_threads.
+ */
+int BLI_task_pool_stats_get_threads(TaskPoolThreadStats *r_threads, int threads_len);
+/**
+ * Write the recorded tasks and waits as JSON in the Trace Event Format, which can be opened in
+ * `chrome://tracing` or Perfetto.
+ */
+bool BLI_task_pool_stats_write_trace(const char *filepath);
+
+/** \} */
+
 /* -------------------------------------------------------------------- */
 /** \name Parallel for Routines
  * \{ */
@@ -0,0 +1,51 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+#pragma once
+
+/** \file
+ * \ingroup bli
+ *
+ * A #TransientAllocator allocates from a thread-local arena while a #TransientAllocationScope is
+ * active on the current thread. It is meant for the many short-lived temporary containers
+ * created during evaluation, e.g. `Vector<int, 16, TransientAllocator>`, that would otherwise
+ * each go through #MEM_mallocN and contend with other threads for the global allocator.
+ *
+ * Freeing arena memory does nothing, it is reused when the outermost scope on the thread ends.
+ * The arena keeps its memory for the next scope, so code that opens a scope every time it is
+ * evaluated (e.g. every frame during playback) reaches a steady state without allocating.
+ *
+ * Outside of a scope and for very large allocations it falls back to the guarded allocator, so it
+ * is always safe to use. Memory allocated in a scope must be freed before that scope ends, it may
+ * be freed on other threads though.
+ */
+
+#include <cstddef>
+
+#include "BLI_utility_mixins.hh"
+
+namespace blender {
+
+class TransientAllocator {
+ public:
+  void *allocate(size_t size, size_t alignment, const char *name);
+  void deallocate(void *ptr);
+};
+
+/**
+ * While an instance is alive, #TransientAllocator allocates from the arena of the current thread.
+ * Scopes can be nested, the arena is only reset when the outermost one ends.
+ */
+class TransientAllocationScope : NonCopyable, NonMovable {
+ public:
+  TransientAllocationScope();
+  ~TransientAllocationScope();
+};
+
+/**
+ * True when a #TransientAllocationScope is active on the current thread.
+ */
+bool transient_allocation_scope_is_active();
+
+}  // namespace blender
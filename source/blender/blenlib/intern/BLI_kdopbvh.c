@@ -1557,6 +1557,23 @@ static float calc_nearest_point_squared(const float proj[3], BVHNode *node, floa
   return len_squared_v3v3(proj, nearest);
 }
 
+/**
+ * Insert a child into arrays sorted by ascending distance. Children with the same distance stay
+ * in the order they are inserted in.
+ */
+static void bvhnode_insert_sorted_by_dist(
+    BVHNode **children, float *dists, const int num, BVHNode *child, const float dist)
+{
+  int i = num;
+  while (i > 0 && dists[i - 1] > dist) {
+    children[i] = children[i - 1];
+    dists[i] = dists[i - 1];
+    i--;
+  }
+  children[i] = child;
+  dists[i] = dist;
+}
+
 /* Depth first search method */
 static void dfs_find_nearest_dfs(BVHNearestData *data, BVHNode *node)
 {
@@ -1570,30 +1587,30 @@ static void dfs_find_nearest_dfs(BVHNearestData *data, BVHNode *node)
     }
   }
   else {
-    /* Better heuristic to pick the closest node to dive on */
-    int i;
+    /* Test all children first and dive into the closest ones first. That makes it more likely
+     * that the nearest distance shrinks early, so that more of the remaining children can be
+     * skipped. This matters most for trees with many children per node. */
+    BVHNode *sorted_children[MAX_TREETYPE];
+    float sorted_dists[MAX_TREETYPE];
+    int sorted_num = 0;
     float nearest[3];
 
-    if (data->proj[node->main_axis] <= node->children[0]->bv[node->main_axis * 2 + 1]) {
-
-      for (i = 0; i != node->node_num; i++) {
-        if (calc_nearest_point_squared(data->proj, node->children[i], nearest) >=
-            data->nearest.dist_sq)
-        {
-          continue;
-        }
-        dfs_find_nearest_dfs(data, node->children[i]);
+    /* Better heuristic to pick the closest node to dive on when distances are equal. */
+    const bool forward = data->proj[node->main_axis] <=
+                         node->children[0]->bv[node->main_axis * 2 + 1];
+    for (int i = 0; i != node->node_num; i++) {
+      BVHNode *child = node->children[forward ? i : node->node_num - 1 - i];
+      const float dist_sq = calc_nearest_point_squared(data->proj, child, nearest);
+      if (dist_sq < data->nearest.dist_sq) {
+        bvhnode_insert_sorted_by_dist(sorted_children, sorted_dists, sorted_num, child, dist_sq);
+        sorted_num++;
       }
     }
-    else {
-      for (i = node->node_num - 1; i >= 0; i--) {
-        if (calc_nearest_point_squared(data->proj, node->children[i], nearest) >=
-            data->nearest.dist_sq)
-        {
-          continue;
-        }
-        dfs_find_nearest_dfs(data, node->children[i]);
+    for (int i = 0; i < sorted_num; i++) {
+      if (sorted_dists[i] >= data->nearest.dist_sq) {
+        break;
       }
+      dfs_find_nearest_dfs(data, sorted_children[i]);
     }
   }
 }
@@ -1876,19 +1893,18 @@ static float fast_ray_nearest_hit(const BVHRayCastData *data, const BVHNode *nod
   return max_fff(t1x, t1y, t1z);
 }
 
-static void dfs_raycast(BVHRayCastData *data, BVHNode *node)
+static float ray_bv_nearest_hit(const BVHRayCastData *data, const BVHNode *node)
 {
-  int i;
-
-  /* ray-bv is really fast.. and simple tests revealed its worth to test it
-   * before calling the ray-primitive functions */
   /* XXX: temporary solution for particles until fast_ray_nearest_hit supports ray.radius */
-  float dist = (data->ray.radius == 0.0f) ? fast_ray_nearest_hit(data, node) :
-                                            ray_nearest_hit(data, node->bv);
-  if (dist >= data->hit.dist) {
-    return;
-  }
+  return (data->ray.radius == 0.0f) ? fast_ray_nearest_hit(data, node) :
+                                      ray_nearest_hit(data, node->bv);
+}
 
+/**
+ * Visit a node whose bounds are hit by the ray at the given distance.
+ */
+static void dfs_raycast_node(BVHRayCastData *data, BVHNode *node, const float dist)
+{
   if (node->node_num == 0) {
     if (data->callback) {
       data->callback(data->userdata, node->index, &data->ray, &data->hit);
@@ -1898,20 +1914,43 @@ static void dfs_raycast(BVHRayCastData *data, BVHNode *node)
       data->hit.dist = dist;
       madd_v3_v3v3fl(data->hit.co, data->ray.origin, data->ray.direction, dist);
     }
+    return;
   }
-  else {
-    /* pick loop direction to dive into the tree (based on ray direction and split axis) */
-    if (data->ray_dot_axis[node->main_axis] > 0.0f) {
-      for (i = 0; i != node->node_num; i++) {
-        dfs_raycast(data, node->children[i]);
-      }
+
+  /* Test the bounds of all children first and dive into them front to back. Hits in the near
+   * children shrink the hit distance, which allows skipping the far ones without descending into
+   * them. This matters most for trees with many children per node. */
+  BVHNode *sorted_children[MAX_TREETYPE];
+  float sorted_dists[MAX_TREETYPE];
+  int sorted_num = 0;
+
+  /* Pick loop direction based on ray direction and split axis, used when distances are equal. */
+  const bool forward = data->ray_dot_axis[node->main_axis] > 0.0f;
+  for (int i = 0; i != node->node_num; i++) {
+    BVHNode *child = node->children[forward ? i : node->node_num - 1 - i];
+    /* ray-bv is really fast.. and simple tests revealed its worth to test it
+     * before calling the ray-primitive functions */
+    const float child_dist = ray_bv_nearest_hit(data, child);
+    if (child_dist < data->hit.dist) {
+      bvhnode_insert_sorted_by_dist(sorted_children, sorted_dists, sorted_num, child, child_dist);
+      sorted_num++;
     }
-    else {
-      for (i = node->node_num - 1; i >= 0; i--) {
-        dfs_raycast(data, node->children[i]);
-      }
+  }
+  for (int i = 0; i < sorted_num; i++) {
+    if (sorted_dists[i] >= data->hit.dist) {
+      break;
     }
+    dfs_raycast_node(data, sorted_children[i], sorted_dists[i]);
+  }
+}
+
+static void dfs_raycast(BVHRayCastData *data, BVHNode *node)
+{
+  const float dist = ray_bv_nearest_hit(data, node);
+  if (dist >= data->hit.dist) {
+    return;
   }
+  dfs_raycast_node(data, node, dist);
 }
 
 /**
@@ -93,8 +93,11 @@
 
 #include "MEM_guardedalloc.h"
 
+#include "BLI_array.hh"
 #include "BLI_listbase.h"
 #include "BLI_mempool.h"
+#include "BLI_task.hh"
+#include "BLI_vector.hh"
 
 #include "BLI_array_store.h" /* Own include. */
 #include "BLI_ghash.h"       /* Only for #BLI_array_store_is_valid. */
@@ -182,6 +185,20 @@ struct BChunkList;
 #  define HASH_TABLE_KEY_FALLBACK ((hash_key)-2)
 #endif
 
+/**
+ * Calculate the hashes of large arrays (and the keys of the reference chunks) using multiple
+ * threads. The result is identical to the single threaded calculation.
+ */
+#define USE_HASH_TABLE_PARALLEL
+#ifdef USE_HASH_TABLE_PARALLEL
+/** Minimum number of hashes to calculate before using multiple threads. */
+#  define BCHUNK_HASH_PARALLEL_THRESHOLD 65536
+#  define BCHUNK_HASH_PARALLEL_GRAIN_SIZE 8192
+/** Minimum number of reference chunks without a cached key before using multiple threads. */
+#  define BCHUNK_KEY_PARALLEL_THRESHOLD 256
+#  define BCHUNK_KEY_PARALLEL_GRAIN_SIZE 64
+#endif
+
 /**
  * Ensure duplicate entries aren't added to temporary hash table
  * needed for arrays where many values match (an array of booleans all true/false for e.g.).
@@ -813,10 +830,10 @@ static hash_key hash_data(const uchar *key, size_t n)
 #undef HASH_INIT
 
 #ifdef USE_HASH_TABLE_ACCUMULATE
-static void hash_array_from_data(const BArrayInfo *info,
-                                 const uchar *data_slice,
-                                 const size_t data_slice_len,
-                                 hash_key *hash_array)
+static void hash_array_from_data_single_threaded(const BArrayInfo *info,
+                                                 const uchar *data_slice,
+                                                 const size_t data_slice_len,
+                                                 hash_key *hash_array)
 {
   if (info->chunk_stride != 1) {
     for (size_t i = 0, i_step = 0; i_step < data_slice_len; i++, i_step += info->chunk_stride) {
@@ -831,6 +848,30 @@ static void hash_array_from_data(const BArrayInfo *info,
   }
 }
 
+static void hash_array_from_data(const BArrayInfo *info,
+                                 const uchar *data_slice,
+                                 const size_t data_slice_len,
+                                 hash_key *hash_array)
+{
+#  ifdef USE_HASH_TABLE_PARALLEL
+  const size_t hash_array_len = data_slice_len / info->chunk_stride;
+  if (hash_array_len >= BCHUNK_HASH_PARALLEL_THRESHOLD) {
+    blender::threading::parallel_for(
+        blender::IndexRange(int64_t(hash_array_len)),
+        BCHUNK_HASH_PARALLEL_GRAIN_SIZE,
+        [&](const blender::IndexRange range) {
+          const size_t i_start = size_t(range.start());
+          hash_array_from_data_single_threaded(info,
+                                               &data_slice[i_start * info->chunk_stride],
+                                               size_t(range.size()) * info->chunk_stride,
+                                               &hash_array[i_start]);
+        });
+    return;
+  }
+#  endif
+  hash_array_from_data_single_threaded(info, data_slice, data_slice_len, hash_array);
+}
+
 /**
  * Similar to hash_array_from_data,
  * but able to step into the next chunk if we run-out of data.
@@ -876,6 +917,42 @@ static void hash_accum(hash_key *hash_array, const size_t hash_array_len, size_t
   }
 
   const size_t hash_array_search_len = hash_array_len - iter_steps;
+
+#  ifdef USE_HASH_TABLE_PARALLEL
+  if (hash_array_search_len >= BCHUNK_HASH_PARALLEL_THRESHOLD) {
+    /* Each step only reads values ahead of the one being written, which haven't been written
+     * to in this step yet. Writing into a second buffer gives the same result while allowing the
+     * values to be calculated in any order. */
+    hash_key *hash_array_src = hash_array;
+    hash_key *hash_array_dst = static_cast<hash_key *>(
+        MEM_mallocN(sizeof(*hash_array) * hash_array_len, __func__));
+    /* The tail isn't accumulated, ensure it's set in both buffers. */
+    memcpy(hash_array_dst, hash_array_src, sizeof(*hash_array) * hash_array_len);
+    hash_key *hash_array_tmp = hash_array_dst;
+    while (iter_steps != 0) {
+      const size_t hash_offset = iter_steps;
+      blender::threading::parallel_for(
+          blender::IndexRange(int64_t(hash_array_search_len)),
+          BCHUNK_HASH_PARALLEL_GRAIN_SIZE,
+          [&](const blender::IndexRange range) {
+            for (const int64_t i_range : range) {
+              const size_t i = size_t(i_range);
+              const hash_key value = hash_array_src[i];
+              hash_array_dst[i] = value +
+                                  ((hash_array_src[i + hash_offset] << 3) ^ (value >> 1));
+            }
+          });
+      std::swap(hash_array_src, hash_array_dst);
+      iter_steps -= 1;
+    }
+    if (hash_array_src != hash_array) {
+      memcpy(hash_array, hash_array_src, sizeof(*hash_array) * hash_array_search_len);
+    }
+    MEM_freeN(hash_array_tmp);
+    return;
+  }
+#  endif
+
   while (iter_steps != 0) {
     const size_t hash_offset = iter_steps;
     for (size_t i = 0; i < hash_array_search_len; i++) {
@@ -962,6 +1039,54 @@ static hash_key key_from_chunk_ref(const BArrayInfo *info,
   return key;
 }
 
+#  if defined(USE_HASH_TABLE_PARALLEL) && defined(USE_HASH_TABLE_KEY_CACHE)
+/**
+ * Calculate the cached keys of the chunks that will be added to the table in parallel,
+ * so #key_from_chunk_ref only has to read the cache.
+ * Chunks smaller than the read-ahead aren't cached and remain calculated on demand.
+ */
+static void key_cache_ensure_from_chunk_refs(const BArrayInfo *info,
+                                             const BChunkRef *cref,
+                                             const BChunkRef *cref_last,
+                                             size_t chunk_list_bytes_remaining)
+{
+  blender::Vector<BChunk *> chunks;
+  while ((cref != cref_last) && (chunk_list_bytes_remaining >= info->accum_read_ahead_bytes)) {
+    BChunk *chunk = cref->link;
+    if ((chunk->key == HASH_TABLE_KEY_UNSET) && (info->accum_read_ahead_bytes <= chunk->data_len))
+    {
+      chunks.append(chunk);
+    }
+    chunk_list_bytes_remaining -= chunk->data_len;
+    cref = cref->next;
+  }
+  if (chunks.size() < BCHUNK_KEY_PARALLEL_THRESHOLD) {
+    return;
+  }
+
+  /* The same chunk may be used multiple times, only write the cache once all keys are known. */
+  blender::Array<hash_key> keys(chunks.size());
+  blender::threading::parallel_for(
+      chunks.index_range(), BCHUNK_KEY_PARALLEL_GRAIN_SIZE, [&](const blender::IndexRange range) {
+        blender::Array<hash_key> hash_store(int64_t(info->accum_read_ahead_len));
+        for (const int64_t i : range) {
+          hash_array_from_data(
+              info, chunks[i]->data, info->accum_read_ahead_bytes, hash_store.data());
+          hash_accum_single(hash_store.data(), size_t(hash_store.size()), info->accum_steps);
+          keys[i] = hash_store[0];
+        }
+      });
+
+  for (const int64_t i : chunks.index_range()) {
+    hash_key key = keys[i];
+    if (UNLIKELY(key == HASH_TABLE_KEY_UNSET)) {
+      key = HASH_TABLE_KEY_FALLBACK;
+    }
+    chunks[i]->key = key;
+  }
+}
+#  endif
+
 static const BChunkRef *table_lookup(const BArrayInfo *info,
                                      BTableRef **table,
                                      const size_t table_len,
@@ -1317,6 +1442,12 @@ static BChunkList *bchunk_list_from_data_merge(const BArrayInfo *info,
       }
 #endif
 
+#if defined(USE_HASH_TABLE_ACCUMULATE) && defined(USE_HASH_TABLE_PARALLEL) && \
+    defined(USE_HASH_TABLE_KEY_CACHE)
+      key_cache_ensure_from_chunk_refs(
+          info, cref, chunk_list_reference_last, chunk_list_reference_bytes_remaining);
+#endif
+
       while ((cref != chunk_list_reference_last) &&
              (chunk_list_reference_bytes_remaining >= info->accum_read_ahead_bytes))
       {
@@ -110,6 +110,26 @@ static void memory_close_mmap(FileReader *reader)
   MEM_freeN(mem);
 }
 
+static void memory_close_mmap_file(FileReader *reader)
+{
+  /* The mapping is owned by the caller. */
+  MEM_freeN(reader);
+}
+
+FileReader *BLI_filereader_new_mmap_file(BLI_mmap_file *mmap)
+{
+  MemoryReader *mem = MEM_callocN(sizeof(MemoryReader), __func__);
+
+  mem->mmap = mmap;
+  mem->length = BLI_mmap_get_length(mmap);
+
+  mem->reader.read = memory_read_mmap;
+  mem->reader.seek = memory_seek;
+  mem->reader.close = memory_close_mmap_file;
+
+  return (FileReader *)mem;
+}
+
 FileReader *BLI_filereader_new_mmap(int filedes)
 {
   BLI_mmap_file *mmap = BLI_mmap_open(filedes);
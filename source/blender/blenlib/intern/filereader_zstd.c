@@ -11,6 +11,7 @@
 
 #include "BLI_filereader.h"
 #include "BLI_math_base.h"
+#include "BLI_task.h"
 
 #ifdef __BIG_ENDIAN__
 #  include "BLI_endian_switch.h"
@@ -18,6 +19,12 @@
 
 #include "MEM_guardedalloc.h"
 
+/**
+ * Upper limit of frames that are decompressed together when the seekable reader has to load
+ * new data. With the default 1mb frames written by `writefile.cc` this bounds the cache size.
+ */
+#define ZSTD_READ_AHEAD_FRAMES_MAX 16
+
 typedef struct {
   FileReader reader;
 
@@ -32,8 +39,18 @@ typedef struct {
     size_t *compressed_ofs;
     size_t *uncompressed_ofs;
 
+    /**
+     * Decompressed content of the frames `[cached_frame, cached_frame + cached_frames_num)`,
+     * stored contiguously just like in the uncompressed stream.
+     */
     char *cached_content;
     int cached_frame;
+    int cached_frames_num;
+
+    /** Number of frames that are decompressed ahead (in parallel) on a cache miss. */
+    int read_ahead_num;
+    /** One decompression context per read-ahead slot, created on demand. */
+    ZSTD_DCtx **read_ahead_ctx;
   } seek;
 } ZstdReader;
 
@@ -130,6 +147,14 @@ static bool zstd_read_seek_table(ZstdReader *zstd)
   }
 
   zstd->seek.cached_frame = -1;
+  zstd->seek.cached_frames_num = 0;
+
+  /* One frame per thread, the task scheduler reports a single thread when it is not
+   * initialized (e.g. in the thumbnail extractor), which keeps decompression serial. */
+  zstd->seek.read_ahead_num = max_ii(
+      1, min_iii(BLI_task_scheduler_num_threads(), ZSTD_READ_AHEAD_FRAMES_MAX, (int)frames_num));
+  zstd->seek.read_ahead_ctx = MEM_calloc_arrayN(
+      zstd->seek.read_ahead_num, sizeof(ZSTD_DCtx *), __func__);
 
   return true;
 }
@@ -157,19 +182,74 @@ static int zstd_frame_from_pos(ZstdReader *zstd, size_t pos)
   return low;
 }
 
-/* Ensure that the currently loaded frame is the correct one. */
+typedef struct ZstdDecompressData {
+  ZstdReader *zstd;
+  const char *compressed_data;
+  char *uncompressed_data;
+  bool error;
+} ZstdDecompressData;
+
+static void zstd_decompress_frame_task(void *__restrict userdata,
+                                       const int index,
+                                       const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  ZstdDecompressData *data = (ZstdDecompressData *)userdata;
+  ZstdReader *zstd = data->zstd;
+
+  const int frame = zstd->seek.cached_frame + index;
+  const size_t compressed_ofs = zstd->seek.compressed_ofs[frame] -
+                                zstd->seek.compressed_ofs[zstd->seek.cached_frame];
+  const size_t compressed_size = zstd->seek.compressed_ofs[frame + 1] -
+                                 zstd->seek.compressed_ofs[frame];
+  const size_t uncompressed_ofs = zstd->seek.uncompressed_ofs[frame] -
+                                  zstd->seek.uncompressed_ofs[zstd->seek.cached_frame];
+  const size_t uncompressed_size = zstd->seek.uncompressed_ofs[frame + 1] -
+                                   zstd->seek.uncompressed_ofs[frame];
+
+  /* Every slot owns its context, contexts are not thread-safe. */
+  if (zstd->seek.read_ahead_ctx[index] == NULL) {
+    zstd->seek.read_ahead_ctx[index] = ZSTD_createDCtx();
+  }
+
+  size_t res = ZSTD_decompressDCtx(zstd->seek.read_ahead_ctx[index],
+                                   data->uncompressed_data + uncompressed_ofs,
+                                   uncompressed_size,
+                                   data->compressed_data + compressed_ofs,
+                                   compressed_size);
+  if (ZSTD_isError(res) || res < uncompressed_size) {
+    /* Only ever set (never cleared) by the tasks, so a plain store is fine. */
+    data->error = true;
+  }
+}
+
+/**
+ * Ensure that the given frame is part of the currently loaded frames.
+ *
+ * On a cache miss, the wanted frame and the frames following it are loaded together: the
+ * compressed data of all of them is read from the base reader in one go (which is not
+ * thread-safe), then the frames are decompressed in parallel. Since reading a .blend file is
+ * mostly sequential, this keeps all cores busy instead of decoding one frame at a time.
+ */
 static const char *zstd_ensure_cache(ZstdReader *zstd, int frame)
 {
-  if (zstd->seek.cached_frame == frame) {
+  if (zstd->seek.cached_content && frame >= zstd->seek.cached_frame &&
+      frame < zstd->seek.cached_frame + zstd->seek.cached_frames_num)
+  {
     /* Cached frame matches, so just return it. */
-    return zstd->seek.cached_content;
+    return zstd->seek.cached_content + (zstd->seek.uncompressed_ofs[frame] -
+                                        zstd->seek.uncompressed_ofs[zstd->seek.cached_frame]);
   }
 
-  /* Cached frame doesn't match, so discard it and cache the wanted one instead. */
+  /* Cached frames don't match, so discard them and cache the wanted ones instead. */
   MEM_SAFE_FREE(zstd->seek.cached_content);
+  zstd->seek.cached_frame = -1;
+  zstd->seek.cached_frames_num = 0;
+
+  const int frames_num = min_ii(zstd->seek.read_ahead_num, zstd->seek.frames_num - frame);
+  const int frame_end = frame + frames_num;
 
-  size_t compressed_size = zstd->seek.compressed_ofs[frame + 1] - zstd->seek.compressed_ofs[frame];
-  size_t uncompressed_size = zstd->seek.uncompressed_ofs[frame + 1] -
+  size_t compressed_size = zstd->seek.compressed_ofs[frame_end] - zstd->seek.compressed_ofs[frame];
+  size_t uncompressed_size = zstd->seek.uncompressed_ofs[frame_end] -
                              zstd->seek.uncompressed_ofs[frame];
 
   char *uncompressed_data = MEM_mallocN(uncompressed_size, __func__);
@@ -182,15 +262,28 @@ static const char *zstd_ensure_cache(ZstdReader *zstd, int frame)
     return NULL;
   }
 
-  size_t res = ZSTD_decompressDCtx(
-      zstd->ctx, uncompressed_data, uncompressed_size, compressed_data, compressed_size);
+  /* Set before decompressing, the tasks use it to find their frame. */
+  zstd->seek.cached_frame = frame;
+
+  ZstdDecompressData data = {
+      .zstd = zstd,
+      .compressed_data = compressed_data,
+      .uncompressed_data = uncompressed_data,
+      .error = false,
+  };
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = frames_num > 1;
+  BLI_task_parallel_range(0, frames_num, &data, zstd_decompress_frame_task, &settings);
+
   MEM_freeN(compressed_data);
-  if (ZSTD_isError(res) || res < uncompressed_size) {
+  if (data.error) {
+    zstd->seek.cached_frame = -1;
     MEM_freeN(uncompressed_data);
     return NULL;
   }
 
-  zstd->seek.cached_frame = frame;
+  zstd->seek.cached_frames_num = frames_num;
   zstd->seek.cached_content = uncompressed_data;
   return uncompressed_data;
 }
@@ -289,6 +382,12 @@ static void zstd_close(FileReader *reader)
     if (zstd->seek.cached_content) {
       MEM_freeN(zstd->seek.cached_content);
     }
+    for (int i = 0; i < zstd->seek.read_ahead_num; i++) {
+      if (zstd->seek.read_ahead_ctx[i]) {
+        ZSTD_freeDCtx(zstd->seek.read_ahead_ctx[i]);
+      }
+    }
+    MEM_freeN(zstd->seek.read_ahead_ctx);
   }
   else {
     MEM_freeN((void *)zstd->in_buf.src);
@@ -563,13 +563,20 @@ static CoarseResult evaluate_coarse(const Expr &root_expression,
 
 static Span<int16_t> bits_to_indices(const BoundedBitSpan bits, LinearAllocator<> &allocator)
 {
-  /* TODO: Could first count the number of set bits. */
-  Vector<int16_t, max_segment_size> indices_vec;
+  /* Counting the set bits first is cheap compared to extracting the indices and allows writing
+   * them into the final array directly. */
+  const int64_t indices_num = bits::count_set_bits(bits);
+  if (indices_num == 0) {
+    return {};
+  }
+  MutableSpan<int16_t> indices = allocator.allocate_array<int16_t>(indices_num);
+  int64_t counter = 0;
   bits::foreach_1_index(bits, [&](const int64_t i) {
     BLI_assert(i < max_segment_size);
-    indices_vec.append_unchecked(int16_t(i));
+    indices[counter++] = int16_t(i);
   });
-  return allocator.construct_array_copy<int16_t>(indices_vec);
+  BLI_assert(counter == indices_num);
+  return indices;
 }
 
 /**
@@ -623,10 +630,7 @@ static IndexMaskSegment evaluate_exact_with_bits(const Expr &root_expression,
       case Expr::Type::Difference: {
         bits::copy_from_or(expr_result, expression_results[expression->terms[0]->index]);
         for (const Expr *term : expression->terms.as_span().drop_front(1)) {
-          bits::mix_into_first_expr(
-              [](const bits::BitInt a, const bits::BitInt b) { return a & ~b; },
-              expr_result,
-              expression_results[term->index]);
+          bits::inplace_and_not(expr_result, expression_results[term->index]);
         }
         break;
       }
@@ -10,6 +10,7 @@
 
 #include "BLI_kdtree_impl.h"
 #include "BLI_math_base.h"
+#include "BLI_task.h"
 #include "BLI_utildefines.h"
 
 #include <string.h>
@@ -48,6 +49,9 @@ struct KDTree {
 #define KD_NEAR_ALLOC_INC 100 /* alloc increment for collecting nearest */
 #define KD_FOUND_ALLOC_INC 50 /* alloc increment for collecting nearest */
 
+/** Sub-trees with fewer nodes are balanced on the current thread. */
+#define KD_BALANCE_PARALLEL_THRESHOLD 8192
+
 #define KD_NODE_UNSET ((uint)-1)
 
 /**
@@ -139,7 +143,22 @@ void BLI_kdtree_nd_(insert)(KDTree *tree, int index, const float co[KD_DIMS])
 #endif
 }
 
-static uint kdtree_balance(KDTreeNode *nodes, uint nodes_len, uint axis, const uint ofs)
+typedef struct KDTreeBalanceTaskData {
+  KDTreeNode *nodes;
+  uint nodes_len;
+  uint axis;
+  uint ofs;
+  uint *r_root;
+} KDTreeBalanceTaskData;
+
+static void kdtree_balance_task(TaskPool *__restrict pool, void *taskdata);
+
+/**
+ * \param pool: When not null, large sub-trees are balanced in separate tasks. This is possible
+ * because they only reorder their own range of nodes. The result is the same as without threading.
+ */
+static uint kdtree_balance(
+    TaskPool *pool, KDTreeNode *nodes, uint nodes_len, uint axis, const uint ofs)
 {
   KDTreeNode *node;
   float co;
@@ -188,13 +207,33 @@ static uint kdtree_balance(KDTreeNode *nodes, uint nodes_len, uint axis, const u
   node = &nodes[median];
   node->d = axis;
   axis = (axis + 1) % KD_DIMS;
-  node->left = kdtree_balance(nodes, median, axis, ofs);
-  node->right = kdtree_balance(
-      nodes + median + 1, (nodes_len - (median + 1)), axis, (median + 1) + ofs);
+
+  const uint right_len = nodes_len - (median + 1);
+  if (pool != NULL && right_len >= KD_BALANCE_PARALLEL_THRESHOLD) {
+    KDTreeBalanceTaskData *data = MEM_mallocN(sizeof(*data), __func__);
+    data->nodes = nodes + median + 1;
+    data->nodes_len = right_len;
+    data->axis = axis;
+    data->ofs = (median + 1) + ofs;
+    /* The median node isn't part of either sub-tree, so the task can write to it directly. */
+    data->r_root = &node->right;
+    BLI_task_pool_push(pool, kdtree_balance_task, data, true, NULL);
+    node->left = kdtree_balance(pool, nodes, median, axis, ofs);
+  }
+  else {
+    node->left = kdtree_balance(pool, nodes, median, axis, ofs);
+    node->right = kdtree_balance(pool, nodes + median + 1, right_len, axis, (median + 1) + ofs);
+  }
 
   return median + ofs;
 }
 
+static void kdtree_balance_task(TaskPool *__restrict pool, void *taskdata)
+{
+  const KDTreeBalanceTaskData *data = taskdata;
+  *data->r_root = kdtree_balance(pool, data->nodes, data->nodes_len, data->axis, data->ofs);
+}
+
 void BLI_kdtree_nd_(balance)(KDTree *tree)
 {
   if (tree->root != KD_NODE_ROOT_IS_INIT) {
@@ -204,7 +243,15 @@ void BLI_kdtree_nd_(balance)(KDTree *tree)
     }
   }
 
-  tree->root = kdtree_balance(tree->nodes, tree->nodes_len, 0, 0);
+  if (tree->nodes_len >= KD_BALANCE_PARALLEL_THRESHOLD * 2) {
+    TaskPool *pool = BLI_task_pool_create(NULL, TASK_PRIORITY_HIGH);
+    tree->root = kdtree_balance(pool, tree->nodes, tree->nodes_len, 0, 0);
+    BLI_task_pool_work_and_wait(pool);
+    BLI_task_pool_free(pool);
+  }
+  else {
+    tree->root = kdtree_balance(NULL, tree->nodes, tree->nodes_len, 0, 0);
+  }
 
 #ifndef NDEBUG
   tree->is_balanced = true;
@@ -594,6 +641,51 @@ int BLI_kdtree_nd_(find_nearest_n)(const KDTree *tree,
       tree, co, r_nearest, nearest_len_capacity, NULL, NULL);
 }
 
+typedef struct KDTreeFindNearestNBatchData {
+  const KDTree *tree;
+  const float (*co)[KD_DIMS];
+  KDTreeNearest *r_nearest;
+  uint nearest_len_capacity;
+  int *r_nearest_len;
+} KDTreeFindNearestNBatchData;
+
+static void kdtree_find_nearest_n_batch_fn(void *__restrict userdata,
+                                           const int iter,
+                                           const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const KDTreeFindNearestNBatchData *data = userdata;
+  const int nearest_len = BLI_kdtree_nd_(find_nearest_n)(
+      data->tree,
+      data->co[iter],
+      &data->r_nearest[(size_t)iter * data->nearest_len_capacity],
+      data->nearest_len_capacity);
+  if (data->r_nearest_len) {
+    data->r_nearest_len[iter] = nearest_len;
+  }
+}
+
+void BLI_kdtree_nd_(find_nearest_n_batch)(const KDTree *tree,
+                                          const float (*co)[KD_DIMS],
+                                          const int co_len,
+                                          KDTreeNearest *r_nearest,
+                                          const uint nearest_len_capacity,
+                                          int *r_nearest_len)
+{
+  KDTreeFindNearestNBatchData data;
+  data.tree = tree;
+  data.co = co;
+  data.r_nearest = r_nearest;
+  data.nearest_len_capacity = nearest_len_capacity;
+  data.r_nearest_len = r_nearest_len;
+
+  /* Every query uses its own traversal stack, allocated on the stack of the thread running it,
+   * so there is no shared state between queries. */
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 256;
+  BLI_task_parallel_range(0, co_len, &data, kdtree_find_nearest_n_batch_fn, &settings);
+}
+
 static int nearest_cmp_dist(const void *a, const void *b)
 {
   const KDTreeNearest *kda = a;
@@ -0,0 +1,92 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup bli
+ */
+
+#include "BLI_math_bits.h"
+#include "BLI_math_half.hh"
+
+namespace blender::math {
+
+/* The conversions operate on the bit representations of the values and rely on the floating
+ * point hardware to do the rounding of sub-normal values, see the public domain implementations by
+ * Fabian Giesen. */
+
+uint16_t float_to_half(const float value)
+{
+  /* Float bits of infinity, of the smallest float that overflows to infinity when rounded, and of
+   * the smallest normal half float. */
+  const uint32_t float_infinity = 255u << 23;
+  const uint32_t half_overflow = (127u + 16u) << 23;
+  const uint32_t half_normal_min = (127u - 14u) << 23;
+  /* Adding a float with these bits aligns the bits of sub-normal half floats to the lowest bits of
+   * the mantissa and rounds them. */
+  const uint32_t denormal_magic = ((127u - 15u) + (23u - 10u) + 1u) << 23;
+
+  uint32_t bits = float_as_uint(value);
+  const uint32_t sign = bits & 0x80000000u;
+  bits ^= sign;
+
+  uint16_t result;
+  if (bits >= half_overflow) {
+    /* Infinity if the value was infinity or too large, quiet NaN otherwise. */
+    result = bits > float_infinity ? 0x7e00u : 0x7c00u;
+  }
+  else if (bits < half_normal_min) {
+    /* Sub-normal half float or zero. */
+    const float aligned = uint_as_float(bits) + uint_as_float(denormal_magic);
+    result = uint16_t(float_as_uint(aligned) - denormal_magic);
+  }
+  else {
+    /* Normal half float. Re-bias the exponent and round the mantissa to nearest even, a mantissa
+     * overflow correctly increments the exponent, possibly up to infinity. */
+    const uint32_t mantissa_odd = (bits >> 13) & 1u;
+    bits += ((15u - 127u) << 23) + 0xfffu;
+    bits += mantissa_odd;
+    result = uint16_t(bits >> 13);
+  }
+
+  return result | uint16_t(sign >> 16);
+}
+
+float half_to_float(const uint16_t value)
+{
+  const uint32_t exponent_mask = 0x7c00u << 13;
+
+  uint32_t bits = uint32_t(value & 0x7fffu) << 13;
+  const uint32_t exponent = bits & exponent_mask;
+  /* Re-bias the exponent. */
+  bits += (127u - 15u) << 23;
+
+  if (exponent == exponent_mask) {
+    /* Infinity or NaN, set all the exponent bits. */
+    bits += (128u - 16u) << 23;
+  }
+  else if (exponent == 0) {
+    /* Zero or sub-normal, renormalize using the floating point hardware. */
+    bits += 1u << 23;
+    bits = float_as_uint(uint_as_float(bits) - uint_as_float(113u << 23));
+  }
+
+  bits |= uint32_t(value & 0x8000u) << 16;
+  return uint_as_float(bits);
+}
+
+void float_to_half_array(const float *src, uint16_t *dst, const int64_t size)
+{
+  for (int64_t i = 0; i < size; i++) {
+    dst[i] = float_to_half(src[i]);
+  }
+}
+
+void half_to_float_array(const uint16_t *src, float *dst, const int64_t size)
+{
+  for (int64_t i = 0; i < size; i++) {
+    dst[i] = half_to_float(src[i]);
+  }
+}
+
+}  // namespace blender::math
@@ -1155,7 +1155,7 @@ static inline mpq3 tti_interp(
 /**
  * Return +1, 0, -1 as a + ad is above, on, or below the oriented plane containing a, b, c in CCW
  * order. This is the same as -oriented(a, b, c, a + ad), but uses fewer arithmetic operations.
- * TODO: change arguments to `const Vert *` and use floating filters.
+ * Try #filter_tti_above first, the exact calculation is only needed when it's inconclusive.
  * The ba, ca, n, and dotbuf arguments are used as temporaries; declaring them
  * in the caller can avoid many allocations and frees of mpq3 and mpq_class structures.
  */
@@ -1180,6 +1180,44 @@ static inline int tti_above(const mpq3 &a,
   return sgn(math::dot_with_buffer(ad, n, dotbuf));
 }
 
+/**
+ * Index of the expression in #filter_tti_above, assuming the input coordinates have index 1.
+ * The differences have index 2, the cross product coordinates index 6 and the final dot product
+ * index 11.
+ */
+constexpr int index_tti_above = 11;
+
+/**
+ * Double precision version of #tti_above with an error bound, see #supremum_dot_cross.
+ * Returns 0 if the sign can't be determined reliably, in which case the exact calculation has
+ * to be done.
+ */
+static inline int filter_tti_above(const double3 &a,
+                                   const double3 &b,
+                                   const double3 &c,
+                                   const double3 &ad,
+                                   const double3 &abs_a,
+                                   const double3 &abs_ad)
+{
+  const double3 ba = b - a;
+  const double3 ca = c - a;
+  const double d = math::dot(ad, math::cross(ba, ca));
+  if (d == 0.0) {
+    return 0;
+  }
+  const double3 abs_ba = math::abs(b) + abs_a;
+  const double3 abs_ca = math::abs(c) + abs_a;
+  const double3 abs_n(abs_ba.y * abs_ca.z + abs_ba.z * abs_ca.y,
+                      abs_ba.z * abs_ca.x + abs_ba.x * abs_ca.z,
+                      abs_ba.x * abs_ca.y + abs_ba.y * abs_ca.x);
+  const double supremum = math::dot(abs_ad, abs_n);
+  const double err_bound = supremum * index_tti_above * DBL_EPSILON;
+  if (fabs(d) > err_bound) {
+    return d > 0 ? 1 : -1;
+  }
+  return 0;
+}
+
 /**
  * Given that triangles (p1, q1, r1) and (p2, q2, r2) are in canonical order,
  * use the classification chart in the Guigue and Devillers paper to find out
@@ -1193,16 +1231,22 @@ static inline int tti_above(const mpq3 &a,
  *   of the plane and at least one of q1 and r1 are off the plane.
  * Similarly for p2, q2, r2 with respect to the first triangle's plane.
  */
-static ITT_value itt_canon2(const mpq3 &p1,
-                            const mpq3 &q1,
-                            const mpq3 &r1,
-                            const mpq3 &p2,
-                            const mpq3 &q2,
-                            const mpq3 &r2,
+static ITT_value itt_canon2(const Vert *vp1,
+                            const Vert *vq1,
+                            const Vert *vr1,
+                            const Vert *vp2,
+                            const Vert *vq2,
+                            const Vert *vr2,
                             const mpq3 &n1,
                             const mpq3 &n2)
 {
   constexpr int dbg_level = 0;
+  const mpq3 &p1 = vp1->co_exact;
+  const mpq3 &q1 = vq1->co_exact;
+  const mpq3 &r1 = vr1->co_exact;
+  const mpq3 &p2 = vp2->co_exact;
+  const mpq3 &q2 = vq2->co_exact;
+  const mpq3 &r2 = vr2->co_exact;
   if (dbg_level > 0) {
     std::cout << "\ntri_tri_intersect_canon:\n";
     std::cout << "p1=" << p1 << " q1=" << q1 << " r1=" << r1 << "\n";
@@ -1218,17 +1262,33 @@ static ITT_value itt_canon2(const mpq3 &p1,
     std::cout << "n1=(" << n1[0].get_d() << "," << n1[1].get_d() << "," << n1[2].get_d() << ")\n";
     std::cout << "n2=(" << n2[0].get_d() << "," << n2[1].get_d() << "," << n2[2].get_d() << ")\n";
   }
-  mpq3 p1p2 = p2 - p1;
   mpq3 intersect_1;
   mpq3 intersect_2;
   mpq3 buf[4];
+  /* All orientation tests are relative to p1 in the direction of p2. */
+  const double3 d_p1p2 = vp2->co - vp1->co;
+  const double3 abs_d_p1 = math::abs(vp1->co);
+  const double3 abs_d_p1p2 = math::abs(vp2->co) + abs_d_p1;
+  std::optional<mpq3> p1p2;
+  auto above = [&](const Vert *b, const Vert *c) {
+    if (const int side = filter_tti_above(vp1->co, b->co, c->co, d_p1p2, abs_d_p1, abs_d_p1p2)) {
+      return side;
+    }
+#  ifdef PERFDEBUG
+    incperfcount(5); /* Orientation tests decided by exact arithmetic. */
+#  endif
+    if (!p1p2) {
+      p1p2 = p2 - p1;
+    }
+    return tti_above(p1, b->co_exact, c->co_exact, *p1p2, buf[0], buf[1], buf[2], buf[3]);
+  };
   bool no_overlap = false;
   /* Top test in classification tree. */
-  if (tti_above(p1, q1, r2, p1p2, buf[0], buf[1], buf[2], buf[3]) > 0) {
+  if (above(vq1, vr2) > 0) {
     /* Middle right test in classification tree. */
-    if (tti_above(p1, r1, r2, p1p2, buf[0], buf[1], buf[2], buf[3]) <= 0) {
+    if (above(vr1, vr2) <= 0) {
       /* Bottom right test in classification tree. */
-      if (tti_above(p1, r1, q2, p1p2, buf[0], buf[1], buf[2], buf[3]) > 0) {
+      if (above(vr1, vq2) > 0) {
         /* Overlap is [k [i l] j]. */
         if (dbg_level > 0) {
           std::cout << "overlap [k [i l] j]\n";
@@ -1257,7 +1317,7 @@ static ITT_value itt_canon2(const mpq3 &p1,
   }
   else {
     /* Middle left test in classification tree. */
-    if (tti_above(p1, q1, q2, p1p2, buf[0], buf[1], buf[2], buf[3]) < 0) {
+    if (above(vq1, vq2) < 0) {
       /* No overlap: [i j] [k l]. */
       if (dbg_level > 0) {
         std::cout << "no overlap: [i j] [k l]\n";
@@ -1266,7 +1326,7 @@ static ITT_value itt_canon2(const mpq3 &p1,
     }
     else {
       /* Bottom left test in classification tree. */
-      if (tti_above(p1, r1, q2, p1p2, buf[0], buf[1], buf[2], buf[3]) >= 0) {
+      if (above(vr1, vq2) >= 0) {
         /* Overlap is [k [i j] l]. */
         if (dbg_level > 0) {
           std::cout << "overlap [k [i j] l]\n";
@@ -1303,12 +1363,12 @@ static ITT_value itt_canon2(const mpq3 &p1,
 
 /* Helper function for intersect_tri_tri. Arguments have been canonicalized for triangle 1. */
 
-static ITT_value itt_canon1(const mpq3 &p1,
-                            const mpq3 &q1,
-                            const mpq3 &r1,
-                            const mpq3 &p2,
-                            const mpq3 &q2,
-                            const mpq3 &r2,
+static ITT_value itt_canon1(const Vert *p1,
+                            const Vert *q1,
+                            const Vert *r1,
+                            const Vert *p2,
+                            const Vert *q2,
+                            const Vert *r2,
                             const mpq3 &n1,
                             const mpq3 &n2,
                             int sp2,
@@ -1510,49 +1570,49 @@ static ITT_value intersect_tri_tri(const IMesh &tm, int t1, int t2)
   ITT_value ans;
   if (sp1 > 0) {
     if (sq1 > 0) {
-      ans = itt_canon1(r1, p1, q1, p2, r2, q2, n1, n2, sp2, sr2, sq2);
+      ans = itt_canon1(vr1, vp1, vq1, vp2, vr2, vq2, n1, n2, sp2, sr2, sq2);
     }
     else if (sr1 > 0) {
-      ans = itt_canon1(q1, r1, p1, p2, r2, q2, n1, n2, sp2, sr2, sq2);
+      ans = itt_canon1(vq1, vr1, vp1, vp2, vr2, vq2, n1, n2, sp2, sr2, sq2);
     }
     else {
-      ans = itt_canon1(p1, q1, r1, p2, q2, r2, n1, n2, sp2, sq2, sr2);
+      ans = itt_canon1(vp1, vq1, vr1, vp2, vq2, vr2, n1, n2, sp2, sq2, sr2);
     }
   }
   else if (sp1 < 0) {
     if (sq1 < 0) {
-      ans = itt_canon1(r1, p1, q1, p2, q2, r2, n1, n2, sp2, sq2, sr2);
+      ans = itt_canon1(vr1, vp1, vq1, vp2, vq2, vr2, n1, n2, sp2, sq2, sr2);
     }
     else if (sr1 < 0) {
-      ans = itt_canon1(q1, r1, p1, p2, q2, r2, n1, n2, sp2, sq2, sr2);
+      ans = itt_canon1(vq1, vr1, vp1, vp2, vq2, vr2, n1, n2, sp2, sq2, sr2);
     }
     else {
-      ans = itt_canon1(p1, q1, r1, p2, r2, q2, n1, n2, sp2, sr2, sq2);
+      ans = itt_canon1(vp1, vq1, vr1, vp2, vr2, vq2, n1, n2, sp2, sr2, sq2);
     }
   }
   else {
     if (sq1 < 0) {
       if (sr1 >= 0) {
-        ans = itt_canon1(q1, r1, p1, p2, r2, q2, n1, n2, sp2, sr2, sq2);
+        ans = itt_canon1(vq1, vr1, vp1, vp2, vr2, vq2, n1, n2, sp2, sr2, sq2);
       }
       else {
-        ans = itt_canon1(p1, q1, r1, p2, q2, r2, n1, n2, sp2, sq2, sr2);
+        ans = itt_canon1(vp1, vq1, vr1, vp2, vq2, vr2, n1, n2, sp2, sq2, sr2);
       }
     }
     else if (sq1 > 0) {
       if (sr1 > 0) {
-        ans = itt_canon1(p1, q1, r1, p2, r2, q2, n1, n2, sp2, sr2, sq2);
+        ans = itt_canon1(vp1, vq1, vr1, vp2, vr2, vq2, n1, n2, sp2, sr2, sq2);
       }
       else {
-        ans = itt_canon1(q1, r1, p1, p2, q2, r2, n1, n2, sp2, sq2, sr2);
+        ans = itt_canon1(vq1, vr1, vp1, vp2, vq2, vr2, n1, n2, sp2, sq2, sr2);
       }
     }
     else {
       if (sr1 > 0) {
-        ans = itt_canon1(r1, p1, q1, p2, q2, r2, n1, n2, sp2, sq2, sr2);
+        ans = itt_canon1(vr1, vp1, vq1, vp2, vq2, vr2, n1, n2, sp2, sq2, sr2);
       }
       else if (sr1 < 0) {
-        ans = itt_canon1(r1, p1, q1, p2, r2, q2, n1, n2, sp2, sr2, sq2);
+        ans = itt_canon1(vr1, vp1, vq1, vp2, vr2, vq2, n1, n2, sp2, sr2, sq2);
       }
       else {
         if (dbg_level > 0) {
@@ -2455,21 +2515,6 @@ class TriOverlaps {
   }
 };
 
-/**
- * Data needed for parallelization of #calc_overlap_itts.
- */
-struct OverlapIttsData {
-  Vector<std::pair<int, int>> intersect_pairs;
-  Map<std::pair<int, int>, ITT_value> &itt_map;
-  const IMesh &tm;
-  IMeshArena *arena;
-
-  OverlapIttsData(Map<std::pair<int, int>, ITT_value> &itt_map, const IMesh &tm, IMeshArena *arena)
-      : itt_map(itt_map), tm(tm), arena(arena)
-  {
-  }
-};
-
 /**
  * Return a std::pair containing a and b in canonical order:
  * With a <= b.
@@ -2482,26 +2527,6 @@ static std::pair<int, int> canon_int_pair(int a, int b)
   return std::pair<int, int>(a, b);
 }
 
-static void calc_overlap_itts_range_func(void *__restrict userdata,
-                                         const int iter,
-                                         const TaskParallelTLS *__restrict /*tls*/)
-{
-  constexpr int dbg_level = 0;
-  OverlapIttsData *data = static_cast<OverlapIttsData *>(userdata);
-  std::pair<int, int> tri_pair = data->intersect_pairs[iter];
-  int a = tri_pair.first;
-  int b = tri_pair.second;
-  if (dbg_level > 0) {
-    std::cout << "calc_overlap_itts_range_func a=" << a << ", b=" << b << "\n";
-  }
-  ITT_value itt = intersect_tri_tri(data->tm, a, b);
-  if (dbg_level > 0) {
-    std::cout << "result of intersecting " << a << " and " << b << " = " << itt << "\n";
-  }
-  BLI_assert(data->itt_map.contains(tri_pair));
-  data->itt_map.add_overwrite(tri_pair, itt);
-}
-
 /**
  * Fill in itt_map with the vector of ITT_values that result from intersecting the triangles in
  * ov. Use a canonical order for triangles: (a,b) where  a < b.
@@ -2509,25 +2534,37 @@ static void calc_overlap_itts_range_func(void *__restrict userdata,
 static void calc_overlap_itts(Map<std::pair<int, int>, ITT_value> &itt_map,
                               const IMesh &tm,
                               const TriOverlaps &ov,
-                              IMeshArena *arena)
+                              IMeshArena * /*arena*/)
 {
-  OverlapIttsData data(itt_map, tm, arena);
+  constexpr int dbg_level = 0;
   /* Put dummy values in `itt_map` initially,
-   * so map entries will exist when doing the range function.
-   * This means we won't have to protect the `itt_map.add_overwrite` function with a lock. */
+   * so map entries will exist when doing the parallel loop.
+   * This means we won't have to protect the map modifications with a lock. */
+  Vector<std::pair<int, int>> intersect_pairs;
   for (const BVHTreeOverlap &olap : ov.overlap()) {
     std::pair<int, int> key = canon_int_pair(olap.indexA, olap.indexB);
     if (!itt_map.contains(key)) {
       itt_map.add_new(key, ITT_value());
-      data.intersect_pairs.append(key);
+      intersect_pairs.append(key);
     }
   }
-  int tot_intersect_pairs = data.intersect_pairs.size();
-  TaskParallelSettings settings;
-  BLI_parallel_range_settings_defaults(&settings);
-  settings.min_iter_per_thread = 1000;
-  settings.use_threading = intersect_use_threading;
-  BLI_task_parallel_range(0, tot_intersect_pairs, &data, calc_overlap_itts_range_func, &settings);
+  /* Most pairs are decided quickly by the floating point filters, but the ones that need exact
+   * arithmetic are orders of magnitude slower, so use a small grain size to balance the work. */
+  const int grain_size = intersect_use_threading ? 64 : std::max<int>(1, intersect_pairs.size());
+  threading::parallel_for(intersect_pairs.index_range(), grain_size, [&](IndexRange range) {
+    for (const int i : range) {
+      const std::pair<int, int> &tri_pair = intersect_pairs[i];
+      if (dbg_level > 0) {
+        std::cout << "calc_overlap_itts a=" << tri_pair.first << ", b=" << tri_pair.second
+                  << "\n";
+      }
+      ITT_value itt = intersect_tri_tri(tm, tri_pair.first, tri_pair.second);
+      if (dbg_level > 0) {
+        std::cout << "result = " << itt << "\n";
+      }
+      itt_map.lookup(tri_pair) = std::move(itt);
+    }
+  });
 }
 
 /**
@@ -3176,6 +3213,10 @@ static void perfdata_init()
   perfdata->count.append(0);
   perfdata->count_name.append("final non-NONE intersects");
 
+  /* count 5. */
+  perfdata->count.append(0);
+  perfdata->count_name.append("orientation tests decided by exact arithmetic");
+
   /* max 0. */
   perfdata->max.append(0);
   perfdata->max_name.append("total faces");
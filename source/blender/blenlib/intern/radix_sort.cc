@@ -0,0 +1,100 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup bli
+ */
+
+#include "BLI_sort.hh"
+
+namespace blender::detail {
+
+static constexpr int radix_bits = 8;
+static constexpr int radix_size = 1 << radix_bits;
+static constexpr int radix_mask = radix_size - 1;
+
+void radix_sort_uint32(MutableSpan<uint32_t> keys, MutableSpan<int> values)
+{
+  const bool has_values = !values.is_empty();
+  BLI_assert(!has_values || values.size() == keys.size());
+  const int64_t size = keys.size();
+  if (size < 2) {
+    return;
+  }
+
+  /* Every block is counted and scattered by a single task. Digits of different blocks are placed
+   * in block order, which together with the in-order scatter keeps the sort stable. */
+  const int64_t blocks_num = std::clamp<int64_t>(size / (1 << 16), 1, 256);
+  const int64_t block_size = (size + blocks_num - 1) / blocks_num;
+  const auto block_range = [&](const int64_t block) {
+    return IndexRange(block * block_size, block_size).intersect(IndexRange(size));
+  };
+
+  Array<uint32_t> keys_buffer(size, NoInitialization());
+  Array<int> values_buffer(has_values ? size : 0, NoInitialization());
+  MutableSpan<uint32_t> src_keys = keys;
+  MutableSpan<uint32_t> dst_keys = keys_buffer;
+  MutableSpan<int> src_values = values;
+  MutableSpan<int> dst_values = values_buffer;
+
+  Array<int64_t> offsets(blocks_num * radix_size);
+  for (int shift = 0; shift < 32; shift += radix_bits) {
+    threading::parallel_for(IndexRange(blocks_num), 1, [&](const IndexRange range) {
+      for (const int64_t block : range) {
+        MutableSpan<int64_t> counts = offsets.as_mutable_span().slice(block * radix_size,
+                                                                      radix_size);
+        counts.fill(0);
+        for (const int64_t i : block_range(block)) {
+          counts[(src_keys[i] >> shift) & radix_mask]++;
+        }
+      }
+    });
+
+    /* Skip the pass when all keys have the same digit. */
+    const int first_digit = (src_keys[0] >> shift) & radix_mask;
+    int64_t first_digit_count = 0;
+    for (const int64_t block : IndexRange(blocks_num)) {
+      first_digit_count += offsets[block * radix_size + first_digit];
+    }
+    if (first_digit_count == size) {
+      continue;
+    }
+
+    int64_t offset = 0;
+    for (const int digit : IndexRange(radix_size)) {
+      for (const int64_t block : IndexRange(blocks_num)) {
+        const int64_t count = offsets[block * radix_size + digit];
+        offsets[block * radix_size + digit] = offset;
+        offset += count;
+      }
+    }
+
+    threading::parallel_for(IndexRange(blocks_num), 1, [&](const IndexRange range) {
+      for (const int64_t block : range) {
+        MutableSpan<int64_t> block_offsets = offsets.as_mutable_span().slice(block * radix_size,
+                                                                             radix_size);
+        for (const int64_t i : block_range(block)) {
+          const int64_t dst = block_offsets[(src_keys[i] >> shift) & radix_mask]++;
+          dst_keys[dst] = src_keys[i];
+          if (has_values) {
+            dst_values[dst] = src_values[i];
+          }
+        }
+      }
+    });
+    std::swap(src_keys, dst_keys);
+    std::swap(src_values, dst_values);
+  }
+
+  if (src_keys.data() != keys.data()) {
+    threading::parallel_for(IndexRange(size), 4096, [&](const IndexRange range) {
+      keys.slice(range).copy_from(src_keys.slice(range));
+      if (has_values) {
+        values.slice(range).copy_from(src_values.slice(range));
+      }
+    });
+  }
+}
+
+}  // namespace blender::detail
@@ -8,17 +8,24 @@
  * Task pool to run tasks in parallel.
  */
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
 #include <cstdlib>
 #include <memory>
+#include <mutex>
 #include <utility>
 
 #include "MEM_guardedalloc.h"
 
 #include "DNA_listBase.h"
 
+#include "BLI_fileops.h"
 #include "BLI_mempool.h"
 #include "BLI_task.h"
 #include "BLI_threads.h"
+#include "BLI_vector.hh"
 
 #ifdef WITH_TBB
 #  include <tbb/blocked_range.h>
@@ -26,6 +33,16 @@
 #  include <tbb/task_group.h>
 #endif
 
+/* Task Pool Statistics, see implementation at the end of the file. */
+
+static std::atomic<bool> task_stats_enabled = false;
+static int task_stats_thread_index();
+static void task_stats_task_pushed(TaskPool *pool);
+class Task;
+static void task_stats_task_run(const Task &task);
+static void task_stats_pool_created();
+static void task_stats_wait_finished(std::chrono::steady_clock::time_point start);
+
 /**
  * Task
  *
@@ -38,13 +55,22 @@ class Task {
   void *taskdata;
   bool free_taskdata;
   TaskFreeFunction freedata;
+  /** Thread the task was pushed from, only set when collecting statistics. */
+  int push_thread_index = -1;
+  /** Memory allocated by the task is attributed to the tag of the thread that pushed it. */
+  eMEMTag mem_tag;
 
   Task(TaskPool *pool,
        TaskRunFunction run,
        void *taskdata,
        bool free_taskdata,
        TaskFreeFunction freedata)
-      : pool(pool), run(run), taskdata(taskdata), free_taskdata(free_taskdata), freedata(freedata)
+      : pool(pool),
+        run(run),
+        taskdata(taskdata),
+        free_taskdata(free_taskdata),
+        freedata(freedata),
+        mem_tag(MEM_tag_get())
   {
   }
 
@@ -69,7 +95,9 @@ class Task {
         run(other.run),
         taskdata(other.taskdata),
         free_taskdata(other.free_taskdata),
-        freedata(other.freedata)
+        freedata(other.freedata),
+        push_thread_index(other.push_thread_index),
+        mem_tag(other.mem_tag)
   {
     other.pool = nullptr;
     other.run = nullptr;
@@ -89,7 +117,9 @@ class Task {
         run(other.run),
         taskdata(other.taskdata),
         free_taskdata(other.free_taskdata),
-        freedata(other.freedata)
+        freedata(other.freedata),
+        push_thread_index(other.push_thread_index),
+        mem_tag(other.mem_tag)
   {
     ((Task &)other).pool = nullptr;
     ((Task &)other).run = nullptr;
@@ -163,11 +193,19 @@ struct TaskPool {
   ListBase background_threads;
   ThreadQueue *background_queue;
   volatile bool background_is_canceling;
+
+  /** Tasks pushed but not started yet, only counted when collecting statistics. */
+  std::atomic<int64_t> pending_tasks;
 };
 
 /* Execute task. */
 void Task::operator()() const
 {
+  MEM_TagScope mem_tag_scope(mem_tag);
+  if (push_thread_index != -1) {
+    task_stats_task_run(*this);
+    return;
+  }
   run(pool, taskdata);
 }
 
@@ -373,8 +411,13 @@ static TaskPool *task_pool_create_ex(void *userdata, TaskPoolType type, eTaskPri
   pool->type = type;
   pool->use_threads = use_threads;
 
+  if (task_stats_enabled.load(std::memory_order_relaxed)) {
+    task_stats_pool_created();
+  }
+
   pool->userdata = userdata;
   BLI_mutex_init(&pool->user_mutex);
+  new (&pool->pending_tasks) std::atomic<int64_t>(0);
 
   switch (type) {
     case TASK_POOL_TBB:
@@ -454,6 +497,10 @@ void BLI_task_pool_push(TaskPool *pool,
                         TaskFreeFunction freedata)
 {
   Task task(pool, run, taskdata, free_taskdata, freedata);
+  if (task_stats_enabled.load(std::memory_order_relaxed)) {
+    task.push_thread_index = task_stats_thread_index();
+    task_stats_task_pushed(pool);
+  }
 
   switch (pool->type) {
     case TASK_POOL_TBB:
@@ -470,6 +517,11 @@ void BLI_task_pool_push(TaskPool *pool,
 
 void BLI_task_pool_work_and_wait(TaskPool *pool)
 {
+  const bool use_stats = task_stats_enabled.load(std::memory_order_relaxed);
+  const std::chrono::steady_clock::time_point start = use_stats ?
+                                                          std::chrono::steady_clock::now() :
+                                                          std::chrono::steady_clock::time_point();
+
   switch (pool->type) {
     case TASK_POOL_TBB:
     case TASK_POOL_TBB_SUSPENDED:
@@ -481,6 +533,10 @@ void BLI_task_pool_work_and_wait(TaskPool *pool)
       background_task_pool_work_and_wait(pool);
       break;
   }
+
+  if (use_stats) {
+    task_stats_wait_finished(start);
+  }
 }
 
 void BLI_task_pool_cancel(TaskPool *pool)
@@ -522,3 +578,231 @@ ThreadMutex *BLI_task_pool_user_mutex(TaskPool *pool)
 {
   return &pool->user_mutex;
 }
+
+/* Task Pool Statistics
+ *
+ * Counters are atomics shared by all threads, per thread data is indexed by the task scheduler's
+ * thread index. Trace events are stored per thread as well, so threads only contend on the
+ * mutex of their own event list when writing the trace. */
+
+using TaskStatsClock = std::chrono::steady_clock;
+
+#define TASK_STATS_MAX_THREADS 256
+/** Limit memory usage of traces when statistics are enabled for a long time. */
+#define TASK_STATS_MAX_TRACE_EVENTS_PER_THREAD (1 << 20)
+
+struct TaskStatsTraceEvent {
+  TaskStatsClock::time_point start;
+  TaskStatsClock::duration duration;
+  bool is_wait;
+};
+
+struct TaskStatsThread {
+  std::atomic<uint64_t> tasks_run = 0;
+  std::atomic<int64_t> busy_time_ns = 0;
+
+  std::mutex trace_mutex;
+  blender::Vector<TaskStatsTraceEvent> trace_events;
+};
+
+static struct TaskStats {
+  std::atomic<bool> use_trace = false;
+  TaskStatsClock::time_point start_time;
+
+  std::atomic<uint64_t> pools_created = 0;
+  std::atomic<uint64_t> tasks_pushed = 0;
+  std::atomic<uint64_t> tasks_run = 0;
+  std::atomic<uint64_t> tasks_stolen = 0;
+  std::atomic<int64_t> max_pending_tasks = 0;
+  std::atomic<int64_t> task_time_ns = 0;
+  std::atomic<uint64_t> waits = 0;
+  std::atomic<int64_t> wait_time_ns = 0;
+  std::atomic<int64_t> main_thread_wait_time_ns = 0;
+
+  TaskStatsThread threads[TASK_STATS_MAX_THREADS];
+} task_stats;
+
+static int task_stats_thread_index()
+{
+#ifdef WITH_TBB
+  /* Negative for threads that are not part of the task arena. */
+  const int index = tbb::this_task_arena::current_thread_index();
+  return std::clamp(index, 0, TASK_STATS_MAX_THREADS - 1);
+#else
+  return 0;
+#endif
+}
+
+static int64_t task_stats_duration_ns(const TaskStatsClock::duration duration)
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count();
+}
+
+static void task_stats_add_trace_event(TaskStatsThread &thread,
+                                       const TaskStatsClock::time_point start,
+                                       const TaskStatsClock::duration duration,
+                                       const bool is_wait)
+{
+  std::lock_guard lock{thread.trace_mutex};
+  if (thread.trace_events.size() < TASK_STATS_MAX_TRACE_EVENTS_PER_THREAD) {
+    thread.trace_events.append({start, duration, is_wait});
+  }
+}
+
+static void task_stats_pool_created()
+{
+  task_stats.pools_created.fetch_add(1, std::memory_order_relaxed);
+}
+
+static void task_stats_task_pushed(TaskPool *pool)
+{
+  task_stats.tasks_pushed.fetch_add(1, std::memory_order_relaxed);
+  const int64_t pending = pool->pending_tasks.fetch_add(1, std::memory_order_relaxed) + 1;
+  int64_t max_pending = task_stats.max_pending_tasks.load(std::memory_order_relaxed);
+  while (pending > max_pending &&
+         !task_stats.max_pending_tasks.compare_exchange_weak(max_pending, pending))
+  {
+  }
+}
+
+static void task_stats_task_run(const Task &task)
+{
+  const int thread_index = task_stats_thread_index();
+  TaskStatsThread &thread = task_stats.threads[thread_index];
+  task.pool->pending_tasks.fetch_sub(1, std::memory_order_relaxed);
+  if (thread_index != task.push_thread_index) {
+    task_stats.tasks_stolen.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  const TaskStatsClock::time_point start = TaskStatsClock::now();
+  task.run(task.pool, task.taskdata);
+  const TaskStatsClock::duration duration = TaskStatsClock::now() - start;
+
+  /* Tasks that run while statistics are disabled again are still counted, that only changes
+   * #task_stats after they were read. */
+  const int64_t duration_ns = task_stats_duration_ns(duration);
+  task_stats.tasks_run.fetch_add(1, std::memory_order_relaxed);
+  task_stats.task_time_ns.fetch_add(duration_ns, std::memory_order_relaxed);
+  thread.tasks_run.fetch_add(1, std::memory_order_relaxed);
+  thread.busy_time_ns.fetch_add(duration_ns, std::memory_order_relaxed);
+  if (task_stats.use_trace.load(std::memory_order_relaxed)) {
+    task_stats_add_trace_event(thread, start, duration, false);
+  }
+}
+
+static void task_stats_wait_finished(const TaskStatsClock::time_point start)
+{
+  const TaskStatsClock::duration duration = TaskStatsClock::now() - start;
+  const int64_t duration_ns = task_stats_duration_ns(duration);
+  task_stats.waits.fetch_add(1, std::memory_order_relaxed);
+  task_stats.wait_time_ns.fetch_add(duration_ns, std::memory_order_relaxed);
+  if (BLI_thread_is_main()) {
+    task_stats.main_thread_wait_time_ns.fetch_add(duration_ns, std::memory_order_relaxed);
+  }
+  if (task_stats.use_trace.load(std::memory_order_relaxed)) {
+    task_stats_add_trace_event(task_stats.threads[task_stats_thread_index()], start, duration, true);
+  }
+}
+
+static double task_stats_seconds(const std::atomic<int64_t> &duration_ns)
+{
+  return double(duration_ns.load(std::memory_order_relaxed)) * 1e-9;
+}
+
+void BLI_task_pool_stats_enable(const bool use_trace)
+{
+  task_stats.start_time = TaskStatsClock::now();
+  task_stats.pools_created = 0;
+  task_stats.tasks_pushed = 0;
+  task_stats.tasks_run = 0;
+  task_stats.tasks_stolen = 0;
+  task_stats.max_pending_tasks = 0;
+  task_stats.task_time_ns = 0;
+  task_stats.waits = 0;
+  task_stats.wait_time_ns = 0;
+  task_stats.main_thread_wait_time_ns = 0;
+  for (TaskStatsThread &thread : task_stats.threads) {
+    thread.tasks_run = 0;
+    thread.busy_time_ns = 0;
+    std::lock_guard lock{thread.trace_mutex};
+    thread.trace_events.clear_and_shrink();
+  }
+  task_stats.use_trace = use_trace;
+  task_stats_enabled = true;
+}
+
+void BLI_task_pool_stats_disable()
+{
+  task_stats_enabled = false;
+  task_stats.use_trace = false;
+}
+
+bool BLI_task_pool_stats_is_enabled()
+{
+  return task_stats_enabled;
+}
+
+void BLI_task_pool_stats_get(TaskPoolStats *r_stats)
+{
+  r_stats->elapsed_time = (task_stats.start_time == TaskStatsClock::time_point()) ?
+                              0.0 :
+                              std::chrono::duration<double>(TaskStatsClock::now() -
+                                                            task_stats.start_time)
+                                  .count();
+  r_stats->pools_created = task_stats.pools_created;
+  r_stats->tasks_pushed = task_stats.tasks_pushed;
+  r_stats->tasks_run = task_stats.tasks_run;
+  r_stats->tasks_stolen = task_stats.tasks_stolen;
+  r_stats->max_pending_tasks = uint64_t(task_stats.max_pending_tasks);
+  r_stats->task_time = task_stats_seconds(task_stats.task_time_ns);
+  r_stats->waits = task_stats.waits;
+  r_stats->wait_time = task_stats_seconds(task_stats.wait_time_ns);
+  r_stats->main_thread_wait_time = task_stats_seconds(task_stats.main_thread_wait_time_ns);
+}
+
+int BLI_task_pool_stats_get_threads(TaskPoolThreadStats *r_threads, const int threads_len)
+{
+  /* Only return threads up to the last one that ran any tasks. */
+  int used_len = 0;
+  for (int i = 0; i < TASK_STATS_MAX_THREADS; i++) {
+    if (task_stats.threads[i].tasks_run > 0) {
+      used_len = i + 1;
+    }
+  }
+  const int len = std::min(used_len, threads_len);
+  for (int i = 0; i < len; i++) {
+    r_threads[i].tasks_run = task_stats.threads[i].tasks_run;
+    r_threads[i].busy_time = task_stats_seconds(task_stats.threads[i].busy_time_ns);
+  }
+  return len;
+}
+
+bool BLI_task_pool_stats_write_trace(const char *filepath)
+{
+  FILE *file = BLI_fopen(filepath, "w");
+  if (file == nullptr) {
+    return false;
+  }
+
+  fprintf(file, "{\"traceEvents\":[\n");
+  bool is_first = true;
+  for (const int i : blender::IndexRange(TASK_STATS_MAX_THREADS)) {
+    TaskStatsThread &thread = task_stats.threads[i];
+    std::lock_guard lock{thread.trace_mutex};
+    for (const TaskStatsTraceEvent &event : thread.trace_events) {
+      /* Complete events, with times in microseconds. */
+      fprintf(file,
+              "%s{\"name\":\"%s\",\"ph\":\"X\",\"pid\":0,\"tid\":%d,"
+              "\"ts\":%.3f,\"dur\":%.3f}",
+              is_first ? "" : ",\n",
+              event.is_wait ? "wait" : "task",
+              i,
+              double(task_stats_duration_ns(event.start - task_stats.start_time)) * 1e-3,
+              double(task_stats_duration_ns(event.duration)) * 1e-3);
+      is_first = false;
+    }
+  }
+  fprintf(file, "\n]}\n");
+  fclose(file);
+  return true;
+}
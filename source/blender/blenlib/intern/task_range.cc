@@ -253,20 +253,30 @@ void parallel_for_impl(const IndexRange range,
 {
 #ifdef WITH_TBB
   lazy_threading::send_hint();
+
+  /* Attribute the memory allocated by the tasks to the same subsystem as the caller. */
+  const eMEMTag mem_tag = MEM_tag_get();
+  auto tagged_function = [&](const IndexRange sub_range) {
+    MEM_TagScope mem_tag_scope(mem_tag);
+    function(sub_range);
+  };
+  const FunctionRef<void(IndexRange)> final_function =
+      mem_tag == MEM_TAG_UNTAGGED ? function : FunctionRef<void(IndexRange)>(tagged_function);
+
   switch (size_hints.type) {
     case TaskSizeHints::Type::Static: {
       const int64_t task_size = static_cast<const detail::TaskSizeHints_Static &>(size_hints).size;
       const int64_t final_grain_size = task_size == 1 ?
                                            grain_size :
                                            std::max<int64_t>(1, grain_size / task_size);
-      parallel_for_impl_static_size(range, final_grain_size, function);
+      parallel_for_impl_static_size(range, final_grain_size, final_function);
       break;
     }
     case TaskSizeHints::Type::IndividualLookup: {
       parallel_for_impl_individual_size_lookup(
           range,
           grain_size,
-          function,
+          final_function,
           static_cast<const detail::TaskSizeHints_IndividualLookup &>(size_hints));
       break;
     }
@@ -274,7 +284,7 @@ void parallel_for_impl(const IndexRange range,
       parallel_for_impl_accumulated_size_lookup(
           range,
           grain_size,
-          function,
+          final_function,
           static_cast<const detail::TaskSizeHints_AccumulatedLookup &>(size_hints));
       break;
     }
@@ -0,0 +1,163 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup bli
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+
+#include "MEM_guardedalloc.h"
+
+#include "BLI_allocator.hh"
+#include "BLI_transient_allocator.hh"
+#include "BLI_vector.hh"
+
+namespace blender {
+
+/** Allocations larger than this are passed on to the guarded allocator. */
+static constexpr int64_t max_arena_allocation_size = 4 * 1024 * 1024;
+static constexpr int64_t min_chunk_size = 64 * 1024;
+static constexpr int64_t max_chunk_size = 64 * 1024 * 1024;
+
+struct TransientArena;
+
+/** Stored right before every allocation, to know how to free it. */
+struct TransientAllocationHead {
+  /** Null when allocated with the guarded allocator. */
+  TransientArena *arena;
+  /** Offset from the start of the guarded allocation, only used without arena. */
+  int64_t offset;
+};
+
+struct TransientArenaChunk {
+  char *data;
+  int64_t size;
+};
+
+/**
+ * The chunks are allocated with the #RawAllocator because the arenas are owned by threads, which
+ * may be destructed after the guarded allocator checked for leaks.
+ */
+struct TransientArena {
+  int scope_depth = 0;
+  Vector<TransientArenaChunk, 4, RawAllocator> chunks;
+  /** Position in the last chunk. */
+  int64_t chunk_offset = 0;
+  /** Decremented on the thread that frees the memory, which may not be the owning thread. */
+  std::atomic<int64_t> live_allocations = 0;
+
+  ~TransientArena()
+  {
+    this->free_chunks();
+  }
+
+  void *allocate(const int64_t size, const int64_t alignment)
+  {
+    const int64_t head_size = int64_t(sizeof(TransientAllocationHead));
+    if (!chunks.is_empty()) {
+      const TransientArenaChunk &chunk = chunks.last();
+      const uintptr_t begin = uintptr_t(chunk.data + chunk_offset + head_size);
+      const uintptr_t aligned = (begin + uintptr_t(alignment) - 1) & ~(uintptr_t(alignment) - 1);
+      const int64_t end_offset = int64_t(aligned - uintptr_t(chunk.data)) + size;
+      if (end_offset <= chunk.size) {
+        chunk_offset = end_offset;
+        void *ptr = reinterpret_cast<void *>(aligned);
+        *(static_cast<TransientAllocationHead *>(ptr) - 1) = {this, 0};
+        live_allocations.fetch_add(1, std::memory_order_relaxed);
+        return ptr;
+      }
+    }
+    const int64_t last_chunk_size = chunks.is_empty() ? 0 : chunks.last().size;
+    this->add_chunk(std::max(size + alignment + head_size,
+                             std::clamp(last_chunk_size * 2, min_chunk_size, max_chunk_size)));
+    return this->allocate(size, alignment);
+  }
+
+  /**
+   * Called when the outermost scope ends. When more than one chunk was needed, they are replaced
+   * by a single chunk large enough for all of them, so that the next scope doesn't use more than
+   * one chunk.
+   */
+  void reset()
+  {
+    BLI_assert_msg(live_allocations.load() == 0,
+                   "Transient allocations must be freed before their scope ends");
+    if (chunks.size() > 1) {
+      int64_t total_size = 0;
+      for (const TransientArenaChunk &chunk : chunks) {
+        total_size += chunk.size;
+      }
+      this->free_chunks();
+      this->add_chunk(std::min(total_size, max_chunk_size));
+    }
+    chunk_offset = 0;
+  }
+
+ private:
+  void add_chunk(const int64_t size)
+  {
+    chunks.append({static_cast<char *>(std::malloc(size_t(size))), size});
+    chunk_offset = 0;
+  }
+
+  void free_chunks()
+  {
+    for (const TransientArenaChunk &chunk : chunks) {
+      std::free(chunk.data);
+    }
+    chunks.clear();
+  }
+};
+
+static thread_local TransientArena transient_arena;
+
+void *TransientAllocator::allocate(const size_t size, const size_t alignment, const char *name)
+{
+  const int64_t alignment_i = std::max<int64_t>(int64_t(alignment), alignof(void *));
+  if (transient_arena.scope_depth > 0 && int64_t(size) <= max_arena_allocation_size) {
+    return transient_arena.allocate(int64_t(size), alignment_i);
+  }
+  /* Leave space for the head before the returned pointer while keeping its alignment. */
+  const int64_t offset = (int64_t(sizeof(TransientAllocationHead)) + alignment_i - 1) /
+                         alignment_i * alignment_i;
+  char *data = static_cast<char *>(
+      MEM_mallocN_aligned(size + size_t(offset), size_t(alignment_i), name));
+  void *ptr = data + offset;
+  *(static_cast<TransientAllocationHead *>(ptr) - 1) = {nullptr, offset};
+  return ptr;
+}
+
+void TransientAllocator::deallocate(void *ptr)
+{
+  const TransientAllocationHead &head = *(static_cast<TransientAllocationHead *>(ptr) - 1);
+  if (head.arena) {
+    head.arena->live_allocations.fetch_sub(1, std::memory_order_relaxed);
+    return;
+  }
+  MEM_freeN(static_cast<char *>(ptr) - head.offset);
+}
+
+TransientAllocationScope::TransientAllocationScope()
+{
+  transient_arena.scope_depth++;
+}
+
+TransientAllocationScope::~TransientAllocationScope()
+{
+  BLI_assert(transient_arena.scope_depth > 0);
+  transient_arena.scope_depth--;
+  if (transient_arena.scope_depth == 0) {
+    transient_arena.reset();
+  }
+}
+
+bool transient_allocation_scope_is_active()
+{
+  return transient_arena.scope_depth > 0;
+}
+
+}  // namespace blender
@@ -236,6 +236,45 @@ TEST(bit_span, InPlaceAnd)
   }
 }
 
+TEST(bit_span, InPlaceAndNot)
+{
+  std::array<uint64_t, 100> data_1{};
+  MutableBitSpan span_1(data_1.data(), data_1.size() * BitsPerInt);
+  span_1.set_all(true);
+
+  std::array<uint64_t, 100> data_2{};
+  MutableBitSpan span_2(data_2.data(), data_2.size() * BitsPerInt);
+  for (const int i : span_2.index_range()) {
+    span_2[i].set(i % 3 == 0);
+  }
+
+  bits::inplace_and_not(span_1, span_2);
+  for (const int i : span_1.index_range()) {
+    EXPECT_EQ(span_1[i].test(), i % 3 != 0);
+  }
+}
+
+TEST(bit_span, CountSetBits)
+{
+  std::array<uint64_t, 100> data{};
+  MutableBitSpan span(data.data(), data.size() * BitsPerInt);
+  EXPECT_EQ(bits::count_set_bits(span), 0);
+  for (const int i : span.index_range()) {
+    span[i].set(i % 3 == 0);
+  }
+  EXPECT_EQ(bits::count_set_bits(span), 2134);
+  /* Unaligned and not a multiple of the integer size. */
+  EXPECT_EQ(bits::count_set_bits(span.slice(IndexRange(5, 200))), 67);
+  EXPECT_EQ(bits::count_set_bits(span.slice(IndexRange(64, 130))), 43);
+
+  std::array<uint64_t, 100> data_2{};
+  MutableBitSpan span_2(data_2.data(), data_2.size() * BitsPerInt);
+  for (const int i : span_2.index_range()) {
+    span_2[i].set(i % 2 == 0);
+  }
+  EXPECT_EQ(bits::count_common_set_bits(span, span_2), 1067);
+}
+
 TEST(bit_span, ForEach1)
 {
   std::array<uint64_t, 2> data{};
@@ -0,0 +1,74 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: Apache-2.0 */
+
+#include "testing/testing.h"
+
+#include <atomic>
+
+#include "BLI_concurrent_fixed_map.hh"
+#include "BLI_task.hh"
+
+#include "BLI_strict_flags.h" /* Keep last. */
+
+namespace blender::tests {
+
+TEST(concurrent_fixed_map, Empty)
+{
+  ConcurrentFixedMap<int, int> map(10);
+  EXPECT_EQ(map.size(), 0);
+  EXPECT_TRUE(map.is_empty());
+  EXPECT_FALSE(map.contains(3));
+  EXPECT_EQ(map.lookup_ptr(3), nullptr);
+}
+
+TEST(concurrent_fixed_map, AddLookup)
+{
+  ConcurrentFixedMap<int, float> map(5);
+  EXPECT_TRUE(map.add(1, 2.0f));
+  EXPECT_TRUE(map.add(4, 5.0f));
+  EXPECT_FALSE(map.add(1, 3.0f));
+  EXPECT_EQ(map.size(), 2);
+  EXPECT_EQ(map.lookup(1), 2.0f);
+  EXPECT_EQ(map.lookup(4), 5.0f);
+  EXPECT_FALSE(map.contains(2));
+}
+
+TEST(concurrent_fixed_map, LookupOrAddCB)
+{
+  ConcurrentFixedMap<std::string, std::string> map(3);
+  const auto [value, added] = map.lookup_or_add_cb("a", []() { return std::string("b"); });
+  EXPECT_EQ(value, "b");
+  EXPECT_TRUE(added);
+  const auto [value_2, added_2] = map.lookup_or_add_cb("a", []() { return std::string("c"); });
+  EXPECT_EQ(value_2, "b");
+  EXPECT_FALSE(added_2);
+}
+
+TEST(concurrent_fixed_map, Threaded)
+{
+  /* Every key is added from many threads, only one may create its value. */
+  const int keys_num = 10000;
+  ConcurrentFixedMap<int, int> map(keys_num);
+  std::atomic<int> created_num = 0;
+  threading::parallel_for(IndexRange(keys_num * 10), 128, [&](const IndexRange range) {
+    for (const int64_t i : range) {
+      const int key = int(i % keys_num);
+      const int value = map.lookup_or_add_cb(key, [&]() {
+                             created_num++;
+                             return key * 2;
+                           }).first;
+      EXPECT_EQ(value, key * 2);
+    }
+  });
+  EXPECT_EQ(map.size(), keys_num);
+  EXPECT_EQ(created_num, keys_num);
+  int items_num = 0;
+  map.foreach_item([&](const int key, const int value) {
+    EXPECT_EQ(value, key * 2);
+    items_num++;
+  });
+  EXPECT_EQ(items_num, keys_num);
+}
+
+}  // namespace blender::tests
@@ -0,0 +1,93 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: Apache-2.0 */
+
+#include "testing/testing.h"
+
+#include "BLI_array.hh"
+#include "BLI_concurrent_pool.hh"
+#include "BLI_task.hh"
+
+#include "BLI_strict_flags.h" /* Keep last. */
+
+namespace blender::tests {
+
+TEST(concurrent_pool, DefaultConstructor)
+{
+  ConcurrentPool<int> pool;
+  EXPECT_EQ(pool.size(), 0);
+}
+
+TEST(concurrent_pool, Allocation)
+{
+  Vector<int *> ptrs;
+  ConcurrentPool<int> pool;
+  for (int i = 0; i < 100; i++) {
+    ptrs.append(&pool.construct(i));
+  }
+  EXPECT_EQ(pool.size(), 100);
+
+  for (int *ptr : ptrs) {
+    pool.destruct(*ptr);
+  }
+  EXPECT_EQ(pool.size(), 0);
+}
+
+TEST(concurrent_pool, Reuse)
+{
+  Vector<int *> ptrs;
+  ConcurrentPool<int> pool;
+  for (int i = 0; i < 32; i++) {
+    ptrs.append(&pool.construct(i));
+  }
+
+  int *freed_ptr = ptrs[6];
+  pool.destruct(*freed_ptr);
+
+  ptrs[6] = &pool.construct(0);
+
+  EXPECT_EQ(ptrs[6], freed_ptr);
+
+  for (int *ptr : ptrs) {
+    pool.destruct(*ptr);
+  }
+}
+
+TEST(concurrent_pool, Threaded)
+{
+  ConcurrentPool<int> pool;
+  Array<int *> ptrs(100000);
+  threading::parallel_for(ptrs.index_range(), 256, [&](const IndexRange range) {
+    for (const int i : range) {
+      ptrs[i] = &pool.construct(i);
+    }
+  });
+  EXPECT_EQ(pool.size(), ptrs.size());
+  for (const int i : ptrs.index_range()) {
+    EXPECT_EQ(*ptrs[i], i);
+  }
+
+  /* Free in a different order, so that elements are likely freed on other threads than the ones
+   * that constructed them, then construct again to reuse the freed elements. */
+  threading::parallel_for(ptrs.index_range(), 256, [&](const IndexRange range) {
+    for (const int i : range) {
+      const int64_t reversed_i = ptrs.size() - 1 - i;
+      pool.destruct(*ptrs[reversed_i]);
+      ptrs[reversed_i] = nullptr;
+    }
+  });
+  EXPECT_EQ(pool.size(), 0);
+
+  threading::parallel_for(ptrs.index_range(), 256, [&](const IndexRange range) {
+    for (const int i : range) {
+      ptrs[i] = &pool.construct(i);
+    }
+  });
+  for (const int i : ptrs.index_range()) {
+    EXPECT_EQ(*ptrs[i], i);
+    pool.destruct(*ptrs[i]);
+  }
+  EXPECT_EQ(pool.size(), 0);
+}
+
+}  // namespace blender::tests
@@ -5,6 +5,9 @@
 #include "testing/testing.h"
 
 #include "BLI_kdtree.h"
+#include "BLI_math_vector.hh"
+#include "BLI_rand.hh"
+#include "BLI_vector.hh"
 
 #include <cmath>
 
@@ -54,6 +57,49 @@ static void deduplicate_test()
   }
 }
 
+static void batch_test(const int tree_size, const uint nearest_len_capacity)
+{
+  using namespace blender;
+  RandomNumberGenerator rng(tree_size);
+  Vector<float3> positions(tree_size);
+  KDTree_3d *tree = BLI_kdtree_3d_new(tree_size);
+  for (const int i : positions.index_range()) {
+    positions[i] = {rng.get_float(), rng.get_float(), rng.get_float()};
+    BLI_kdtree_3d_insert(tree, i, positions[i]);
+  }
+  BLI_kdtree_3d_balance(tree);
+
+  const int query_len = 1000;
+  Vector<float3> query(query_len);
+  for (float3 &co : query) {
+    co = {rng.get_float(), rng.get_float(), rng.get_float()};
+  }
+
+  Vector<KDTreeNearest_3d> nearest(query_len * nearest_len_capacity);
+  Vector<int> nearest_len(query_len);
+  BLI_kdtree_3d_find_nearest_n_batch(tree,
+                                     reinterpret_cast<const float(*)[3]>(query.data()),
+                                     query_len,
+                                     nearest.data(),
+                                     nearest_len_capacity,
+                                     nearest_len.data());
+
+  for (const int i : query.index_range()) {
+    EXPECT_EQ(nearest_len[i], std::min<int>(tree_size, nearest_len_capacity));
+    /* Compare the closest point against a brute force search. */
+    float min_dist_sq = FLT_MAX;
+    for (const float3 &position : positions) {
+      min_dist_sq = std::min(min_dist_sq, math::distance_squared(position, query[i]));
+    }
+    EXPECT_FLOAT_EQ(nearest[i * nearest_len_capacity].dist, std::sqrt(min_dist_sq));
+    for (int j = 1; j < nearest_len[i]; j++) {
+      EXPECT_LE(nearest[i * nearest_len_capacity + j - 1].dist,
+                nearest[i * nearest_len_capacity + j].dist);
+    }
+  }
+  BLI_kdtree_3d_free(tree);
+}
+
 TEST(kdtree, Standard)
 {
   standard_test();
@@ -63,3 +109,11 @@ TEST(kdtree, Deduplicate)
 {
   deduplicate_test();
 }
+
+TEST(kdtree, FindNearestNBatch)
+{
+  batch_test(10, 4);
+  /* Large enough to balance sub-trees in parallel. */
+  batch_test(100000, 1);
+  batch_test(100000, 8);
+}
@@ -0,0 +1,82 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: Apache-2.0 */
+
+#include "testing/testing.h"
+
+#include <cmath>
+#include <limits>
+
+#include "BLI_math_half.hh"
+
+namespace blender::math::tests {
+
+TEST(math_half, FloatToHalfExact)
+{
+  EXPECT_EQ(float_to_half(0.0f), 0x0000);
+  EXPECT_EQ(float_to_half(-0.0f), 0x8000);
+  EXPECT_EQ(float_to_half(1.0f), 0x3c00);
+  EXPECT_EQ(float_to_half(-2.0f), 0xc000);
+  EXPECT_EQ(float_to_half(0.5f), 0x3800);
+  EXPECT_EQ(float_to_half(65504.0f), 0x7bff);
+  EXPECT_EQ(float_to_half(std::ldexp(1.0f, -14)), 0x0400);
+  EXPECT_EQ(float_to_half(std::ldexp(1.0f, -24)), 0x0001);
+}
+
+TEST(math_half, FloatToHalfRounding)
+{
+  /* Ties are rounded to even. */
+  EXPECT_EQ(float_to_half(1.0f + std::ldexp(1.0f, -11)), 0x3c00);
+  EXPECT_EQ(float_to_half(1.0f + std::ldexp(3.0f, -11)), 0x3c02);
+  EXPECT_EQ(float_to_half(std::ldexp(1.0f, -25)), 0x0000);
+  EXPECT_EQ(float_to_half(std::ldexp(3.0f, -25)), 0x0002);
+  EXPECT_EQ(float_to_half(65519.0f), 0x7bff);
+}
+
+TEST(math_half, FloatToHalfSpecial)
+{
+  const float infinity = std::numeric_limits<float>::infinity();
+  EXPECT_EQ(float_to_half(65520.0f), 0x7c00);
+  EXPECT_EQ(float_to_half(1e10f), 0x7c00);
+  EXPECT_EQ(float_to_half(infinity), 0x7c00);
+  EXPECT_EQ(float_to_half(-infinity), 0xfc00);
+  EXPECT_EQ(float_to_half(std::numeric_limits<float>::quiet_NaN()) & 0x7fff, 0x7e00);
+}
+
+TEST(math_half, HalfToFloat)
+{
+  EXPECT_EQ(half_to_float(0x0000), 0.0f);
+  EXPECT_TRUE(std::signbit(half_to_float(0x8000)));
+  EXPECT_EQ(half_to_float(0x3c00), 1.0f);
+  EXPECT_EQ(half_to_float(0xc000), -2.0f);
+  EXPECT_EQ(half_to_float(0x7bff), 65504.0f);
+  EXPECT_EQ(half_to_float(0x0001), std::ldexp(1.0f, -24));
+  EXPECT_EQ(half_to_float(0x7c00), std::numeric_limits<float>::infinity());
+  EXPECT_TRUE(std::isnan(half_to_float(0x7e00)));
+}
+
+TEST(math_half, RoundTrip)
+{
+  for (int i = 0; i <= 0xffff; i++) {
+    const uint16_t half = uint16_t(i);
+    const float value = half_to_float(half);
+    if (!std::isnan(value)) {
+      EXPECT_EQ(float_to_half(value), half);
+    }
+  }
+}
+
+TEST(math_half, Arrays)
+{
+  const float src[4] = {0.25f, -1.5f, 1024.0f, 0.1f};
+  uint16_t half[4];
+  float dst[4];
+  float_to_half_array(src, half, 4);
+  half_to_float_array(half, dst, 4);
+  EXPECT_EQ(dst[0], 0.25f);
+  EXPECT_EQ(dst[1], -1.5f);
+  EXPECT_EQ(dst[2], 1024.0f);
+  EXPECT_NEAR(dst[3], 0.1f, 1e-4f);
+}
+
+}  // namespace blender::math::tests
@@ -0,0 +1,25 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: Apache-2.0 */
+
+#include "testing/testing.h"
+
+#include "BLI_rand.hh"
+
+namespace blender::tests {
+
+TEST(rand, SkipMatchesSteps)
+{
+  for (const int64_t n : {0, 1, 2, 3, 7, 64, 1000, 123457}) {
+    RandomNumberGenerator stepped(42);
+    RandomNumberGenerator skipped(42);
+    for (int64_t i = 0; i < n; i++) {
+      stepped.get_uint32();
+    }
+    skipped.skip(n);
+    EXPECT_EQ(stepped.get_uint32(), skipped.get_uint32());
+    EXPECT_EQ(stepped.get_uint64(), skipped.get_uint64());
+  }
+}
+
+}  // namespace blender::tests
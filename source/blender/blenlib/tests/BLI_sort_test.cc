@@ -0,0 +1,103 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: Apache-2.0 */
+
+#include "testing/testing.h"
+
+#include "BLI_array_utils.hh"
+#include "BLI_rand.hh"
+#include "BLI_sort.hh"
+
+namespace blender::tests {
+
+template<typename T> static Array<T> random_values(const int64_t size, const uint32_t seed)
+{
+  RandomNumberGenerator rng(seed);
+  Array<T> values(size);
+  for (T &value : values) {
+    if constexpr (std::is_same_v<T, float>) {
+      value = rng.get_float() * 200.0f - 100.0f;
+    }
+    else {
+      /* Few distinct values, to test stability. */
+      value = T(rng.get_int32(1000)) - T(std::is_signed_v<T> ? 500 : 0);
+    }
+  }
+  return values;
+}
+
+template<typename T> static void test_radix_sort(const int64_t size)
+{
+  Array<T> values = random_values<T>(size, 0);
+  Array<T> expected = values;
+  std::sort(expected.begin(), expected.end());
+  parallel_radix_sort(values.as_mutable_span());
+  EXPECT_EQ_SPAN<T>(values, expected);
+}
+
+TEST(sort, RadixSort)
+{
+  for (const int64_t size : {0, 1, 2, 100, 100000, 1000000}) {
+    test_radix_sort<int32_t>(size);
+    test_radix_sort<uint32_t>(size);
+    test_radix_sort<float>(size);
+  }
+}
+
+TEST(sort, RadixSortSpecialFloats)
+{
+  Array<float> values = {3.0f, -0.0f, FLT_MAX, -FLT_MAX, 0.0f, -1.0f, FLT_MIN, -FLT_MIN};
+  parallel_radix_sort(values.as_mutable_span());
+  EXPECT_TRUE(std::is_sorted(values.begin(), values.end()));
+}
+
+template<typename T> static void test_radix_sort_indices(const int64_t size)
+{
+  const Array<T> keys = random_values<T>(size, 1);
+  Array<int> indices(size);
+  array_utils::fill_index_range<int>(indices);
+  Array<int> expected = indices;
+  std::stable_sort(expected.begin(), expected.end(), [&](const int a, const int b) {
+    return keys[a] < keys[b];
+  });
+  parallel_radix_sort_indices_by_key(keys.as_span(), indices.as_mutable_span());
+  EXPECT_EQ_SPAN<int>(indices, expected);
+}
+
+TEST(sort, RadixSortIndicesByKey)
+{
+  for (const int64_t size : {0, 1, 2, 100, 100000, 1000000}) {
+    test_radix_sort_indices<int32_t>(size);
+    test_radix_sort_indices<uint32_t>(size);
+    test_radix_sort_indices<float>(size);
+  }
+}
+
+TEST(sort, RadixSortIndicesByKeyZero)
+{
+  const Array<float> keys = {0.0f, -0.0f, 0.0f, -1.0f};
+  Array<int> indices = {0, 1, 2, 3};
+  parallel_radix_sort_indices_by_key(keys.as_span(), indices.as_mutable_span());
+  EXPECT_EQ_SPAN<int>(indices, Span<int>({3, 0, 1, 2}));
+}
+
+TEST(sort, StableSort)
+{
+  for (const int64_t size : {0, 1, 100, 10000, 100000, 1000000}) {
+    /* Sort pairs by their first value only, the second one checks the stability. */
+    const Array<int32_t> keys = random_values<int32_t>(size, 2);
+    Array<std::pair<int, int>> values(size);
+    for (const int64_t i : values.index_range()) {
+      values[i] = {keys[i], int(i)};
+    }
+    const auto comp = [](const std::pair<int, int> &a, const std::pair<int, int> &b) {
+      return a.first < b.first;
+    };
+    Array<std::pair<int, int>> expected = values;
+    std::stable_sort(expected.begin(), expected.end(), comp);
+    parallel_stable_sort(values.as_mutable_span(), comp);
+    EXPECT_TRUE(values.as_span() == expected.as_span());
+  }
+}
+
+}  // namespace blender::tests
@@ -0,0 +1,95 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: Apache-2.0 */
+
+#include "testing/testing.h"
+
+#include "BLI_array.hh"
+#include "BLI_task.hh"
+#include "BLI_transient_allocator.hh"
+#include "BLI_vector.hh"
+
+namespace blender::tests {
+
+static bool is_aligned(void *ptr, uint alignment)
+{
+  BLI_assert(is_power_of_2(int(alignment)));
+  return (POINTER_AS_UINT(ptr) & (alignment - 1)) == 0;
+}
+
+TEST(transient_allocator, WithoutScope)
+{
+  EXPECT_FALSE(transient_allocation_scope_is_active());
+  Vector<int, 0, TransientAllocator> values;
+  for (const int i : IndexRange(1000)) {
+    values.append(i);
+  }
+  EXPECT_EQ(values[999], 999);
+}
+
+TEST(transient_allocator, NestedScopes)
+{
+  {
+    TransientAllocationScope scope;
+    EXPECT_TRUE(transient_allocation_scope_is_active());
+    {
+      TransientAllocationScope nested_scope;
+      EXPECT_TRUE(transient_allocation_scope_is_active());
+    }
+    EXPECT_TRUE(transient_allocation_scope_is_active());
+  }
+  EXPECT_FALSE(transient_allocation_scope_is_active());
+}
+
+TEST(transient_allocator, Allocation)
+{
+  TransientAllocator allocator;
+  for ([[maybe_unused]] const int iteration : IndexRange(3)) {
+    TransientAllocationScope scope;
+    Vector<void *> ptrs;
+    for (const int i : IndexRange(2000)) {
+      const uint alignment = 1u << (i % 8);
+      void *ptr = allocator.allocate(size_t(i), alignment, __func__);
+      EXPECT_TRUE(is_aligned(ptr, alignment));
+      memset(ptr, 0xFF, size_t(i));
+      ptrs.append(ptr);
+    }
+    /* Large enough to use the guarded allocator. */
+    void *large_ptr = allocator.allocate(16 * 1024 * 1024, 64, __func__);
+    EXPECT_TRUE(is_aligned(large_ptr, 64));
+    allocator.deallocate(large_ptr);
+    for (void *ptr : ptrs) {
+      allocator.deallocate(ptr);
+    }
+  }
+}
+
+TEST(transient_allocator, Containers)
+{
+  TransientAllocationScope scope;
+  Vector<int, 4, TransientAllocator> vector;
+  for (const int i : IndexRange(10000)) {
+    vector.append(i);
+  }
+  Array<float, 0, TransientAllocator> array(vector.size());
+  for (const int i : vector.index_range()) {
+    array[i] = float(vector[i]);
+  }
+  EXPECT_EQ(array[9999], 9999.0f);
+}
+
+TEST(transient_allocator, Threaded)
+{
+  threading::parallel_for(IndexRange(100), 1, [&](const IndexRange range) {
+    for (const int i : range) {
+      TransientAllocationScope scope;
+      Vector<int, 0, TransientAllocator> values;
+      for (const int j : IndexRange(i * 100)) {
+        values.append(j);
+      }
+      EXPECT_EQ(values.size(), i * 100);
+    }
+  });
+}
+
+}  // namespace blender::tests
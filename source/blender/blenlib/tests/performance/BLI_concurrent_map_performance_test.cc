@@ -0,0 +1,106 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: Apache-2.0 */
+
+#include "testing/testing.h"
+
+#include "BLI_array.hh"
+#include "BLI_concurrent_fixed_map.hh"
+#include "BLI_concurrent_map.hh"
+#include "BLI_ordered_edge.hh"
+#include "BLI_rand.hh"
+#include "BLI_task.hh"
+#include "BLI_timeit.hh"
+#include "BLI_vector.hh"
+#include "BLI_vector_set.hh"
+
+namespace blender::tests {
+
+/**
+ * Edges with many duplicates, similar to the edges of the faces of a mesh.
+ */
+static Vector<OrderedEdge> random_edges(const int64_t size)
+{
+  RandomNumberGenerator rng(0);
+  const int verts_num = int(size / 4);
+  Vector<OrderedEdge> edges;
+  edges.reserve(size);
+  for ([[maybe_unused]] const int64_t i : IndexRange(size)) {
+    const int v1 = rng.get_int32(verts_num);
+    edges.append(OrderedEdge(v1, (v1 + 1 + rng.get_int32(3)) % verts_num));
+  }
+  return edges;
+}
+
+/** Like #mesh_calc_edges: every task adds the edges of its part of the hash space. */
+static int64_t deduplicate_partitioned_vector_sets(const Span<OrderedEdge> edges)
+{
+  const int maps_num = power_of_2_max(std::max(1, BLI_system_thread_count())) * 4;
+  const uint64_t mask = uint64_t(maps_num - 1);
+  Array<VectorSet<OrderedEdge>> maps(maps_num);
+  threading::parallel_for_each(maps, [&](VectorSet<OrderedEdge> &map) {
+    const uint64_t task_index = uint64_t(&map - maps.data());
+    map.reserve(edges.size() / maps_num);
+    for (const OrderedEdge &edge : edges) {
+      if ((uint64_t(edge.v_low) & mask) == task_index) {
+        map.add(edge);
+      }
+    }
+  });
+  int64_t size = 0;
+  for (const VectorSet<OrderedEdge> &map : maps) {
+    size += map.size();
+  }
+  return size;
+}
+
+static int64_t deduplicate_concurrent_map(const Span<OrderedEdge> edges)
+{
+  ConcurrentMap<OrderedEdge, int> map;
+  std::atomic<int64_t> size = 0;
+  threading::parallel_for(edges.index_range(), 4096, [&](const IndexRange range) {
+    for (const int64_t i : range) {
+      ConcurrentMap<OrderedEdge, int>::MutableAccessor accessor;
+      if (map.add(accessor, edges[i])) {
+        size++;
+      }
+    }
+  });
+  return size;
+}
+
+static int64_t deduplicate_concurrent_fixed_map(const Span<OrderedEdge> edges)
+{
+  ConcurrentFixedMap<OrderedEdge, int> map(edges.size());
+  threading::parallel_for(edges.index_range(), 4096, [&](const IndexRange range) {
+    for (const int64_t i : range) {
+      map.add(edges[i], 0);
+    }
+  });
+  return map.size();
+}
+
+TEST(concurrent_map_performance, DeduplicateEdges)
+{
+  for (const int64_t size : {10000, 1000000, 10000000}) {
+    const Vector<OrderedEdge> edges = random_edges(size);
+    printf("Deduplicate %lld edges\n", (long long)size);
+    int64_t result_1, result_2, result_3;
+    {
+      SCOPED_TIMER("  partitioned VectorSet");
+      result_1 = deduplicate_partitioned_vector_sets(edges);
+    }
+    {
+      SCOPED_TIMER("  ConcurrentMap");
+      result_2 = deduplicate_concurrent_map(edges);
+    }
+    {
+      SCOPED_TIMER("  ConcurrentFixedMap");
+      result_3 = deduplicate_concurrent_fixed_map(edges);
+    }
+    EXPECT_EQ(result_1, result_2);
+    EXPECT_EQ(result_1, result_3);
+  }
+}
+
+}  // namespace blender::tests
@@ -0,0 +1,91 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: Apache-2.0 */
+
+#include "testing/testing.h"
+
+#include "BLI_bit_span_ops.hh"
+#include "BLI_bit_vector.hh"
+#include "BLI_index_mask.hh"
+#include "BLI_index_mask_expression.hh"
+#include "BLI_rand.hh"
+#include "BLI_timeit.hh"
+
+namespace blender::index_mask::tests {
+
+/** Typical size of a selection on a large mesh. */
+static constexpr int64_t domain_size = 50'000'000;
+
+static BitVector<> random_bits(const int64_t size, const float probability, const uint32_t seed)
+{
+  RandomNumberGenerator rng(seed);
+  BitVector<> bits(size, false);
+  for (const int64_t i : IndexRange(size)) {
+    if (rng.get_float() < probability) {
+      bits[i].set();
+    }
+  }
+  return bits;
+}
+
+TEST(index_mask_performance, bit_span_ops)
+{
+  const BitVector<> a = random_bits(domain_size, 0.5f, 0);
+  const BitVector<> b = random_bits(domain_size, 0.5f, 1);
+  BitVector<> result(domain_size);
+
+  for ([[maybe_unused]] const int i : IndexRange(3)) {
+    printf("Bit span operations on %lld bits\n", (long long)domain_size);
+    {
+      SCOPED_TIMER("  count_set_bits");
+      const int64_t count = bits::count_set_bits(a);
+      EXPECT_GT(count, 0);
+    }
+    {
+      SCOPED_TIMER("  copy_from_or");
+      bits::copy_from_or(result, a, b);
+    }
+    {
+      SCOPED_TIMER("  inplace_and");
+      bits::inplace_and(result, b);
+    }
+    {
+      SCOPED_TIMER("  inplace_and_not");
+      bits::inplace_and_not(result, a);
+    }
+  }
+}
+
+TEST(index_mask_performance, from_bits)
+{
+  for (const float probability : {0.01f, 0.5f, 0.99f}) {
+    const BitVector<> bits = random_bits(domain_size, probability, 0);
+    printf("IndexMask from %lld bits, %.0f%% set\n", (long long)domain_size, probability * 100);
+    for ([[maybe_unused]] const int i : IndexRange(3)) {
+      IndexMaskMemory memory;
+      SCOPED_TIMER("  from_bits");
+      const IndexMask mask = IndexMask::from_bits(bits, memory);
+      EXPECT_FALSE(mask.is_empty());
+    }
+  }
+}
+
+TEST(index_mask_performance, evaluate_expression)
+{
+  IndexMaskMemory input_memory;
+  const IndexMask a = IndexMask::from_bits(random_bits(domain_size, 0.5f, 0), input_memory);
+  const IndexMask b = IndexMask::from_bits(random_bits(domain_size, 0.5f, 1), input_memory);
+  const IndexMask c = IndexMask::from_bits(random_bits(domain_size, 0.5f, 2), input_memory);
+
+  ExprBuilder builder;
+  const Expr &expr = builder.subtract(&builder.merge({&a, &b}), {&builder.intersect({&b, &c})});
+
+  for ([[maybe_unused]] const int i : IndexRange(3)) {
+    IndexMaskMemory memory;
+    SCOPED_TIMER("(a | b) - (b & c)");
+    const IndexMask mask = evaluate_expression(expr, memory);
+    EXPECT_FALSE(mask.is_empty());
+  }
+}
+
+}  // namespace blender::index_mask::tests
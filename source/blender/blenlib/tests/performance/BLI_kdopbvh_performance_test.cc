@@ -0,0 +1,119 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: Apache-2.0 */
+
+#include "testing/testing.h"
+
+#include "BLI_array.hh"
+#include "BLI_kdopbvh.h"
+#include "BLI_math_geom.h"
+#include "BLI_math_vector.hh"
+#include "BLI_math_vector_types.hh"
+#include "BLI_rand.hh"
+#include "BLI_task.hh"
+#include "BLI_timeit.hh"
+#include "BLI_vector.hh"
+
+namespace blender::tests {
+
+/** Small random triangles in the unit cube, similar to the faces of a dense mesh. */
+static Vector<float3> random_triangles(const int tris_num)
+{
+  RandomNumberGenerator rng(0);
+  const float size = 2.0f / std::cbrt(float(tris_num));
+  Vector<float3> positions(tris_num * 3);
+  for (const int i : IndexRange(tris_num)) {
+    const float3 center(rng.get_float(), rng.get_float(), rng.get_float());
+    for (const int j : IndexRange(3)) {
+      positions[i * 3 + j] = center + float3(rng.get_float() - 0.5f,
+                                             rng.get_float() - 0.5f,
+                                             rng.get_float() - 0.5f) *
+                                          size;
+    }
+  }
+  return positions;
+}
+
+static void raycast_triangle_cb(void *userdata,
+                                const int index,
+                                const BVHTreeRay *ray,
+                                BVHTreeRayHit *hit)
+{
+  const float3 *positions = static_cast<const float3 *>(userdata);
+  float dist;
+  if (isect_ray_tri_v3(ray->origin,
+                       ray->direction,
+                       positions[index * 3],
+                       positions[index * 3 + 1],
+                       positions[index * 3 + 2],
+                       &dist,
+                       nullptr) &&
+      dist < hit->dist)
+  {
+    hit->index = index;
+    hit->dist = dist;
+  }
+}
+
+static void bvhtree_raycast_benchmark(const int tris_num, const int rays_num)
+{
+  printf("Triangles: %d, rays: %d\n", tris_num, rays_num);
+  const Vector<float3> positions = random_triangles(tris_num);
+
+  BVHTree *tree = BLI_bvhtree_new(tris_num, 0.0f, 4, 6);
+  {
+    SCOPED_TIMER("  insert and balance");
+    for (const int i : IndexRange(tris_num)) {
+      BLI_bvhtree_insert(tree, i, &positions[i * 3].x, 3);
+    }
+    BLI_bvhtree_balance(tree);
+  }
+
+  /* Rays from random points towards the center of the cube. */
+  RandomNumberGenerator rng(1);
+  Vector<float3> origins(rays_num);
+  Vector<float3> directions(rays_num);
+  for (const int i : IndexRange(rays_num)) {
+    origins[i] = float3(rng.get_float(), rng.get_float(), rng.get_float()) * 3.0f - 1.0f;
+    directions[i] = math::normalize(float3(0.5f) - origins[i]);
+  }
+
+  Array<int> hit_indices(rays_num);
+  {
+    SCOPED_TIMER("  ray_cast (parallel_for)");
+    threading::parallel_for(IndexRange(rays_num), 1024, [&](const IndexRange range) {
+      for (const int i : range) {
+        BVHTreeRayHit hit;
+        hit.index = -1;
+        hit.dist = FLT_MAX;
+        BLI_bvhtree_ray_cast(tree,
+                             origins[i],
+                             directions[i],
+                             0.0f,
+                             &hit,
+                             raycast_triangle_cb,
+                             const_cast<float3 *>(positions.data()));
+        hit_indices[i] = hit.index;
+      }
+    });
+  }
+  int hits_num = 0;
+  for (const int index : hit_indices) {
+    hits_num += index != -1;
+  }
+  EXPECT_GT(hits_num, 0);
+
+  BLI_bvhtree_free(tree);
+}
+
+TEST(kdopbvh_performance, RayCast100K)
+{
+  bvhtree_raycast_benchmark(100000, 1000000);
+}
+
+TEST(kdopbvh_performance, RayCast1M)
+{
+  bvhtree_raycast_benchmark(1000000, 1000000);
+}
+
+}  // namespace blender::tests
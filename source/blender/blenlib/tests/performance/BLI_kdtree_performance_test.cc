@@ -0,0 +1,81 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: Apache-2.0 */
+
+#include "testing/testing.h"
+
+#include "BLI_kdtree.h"
+#include "BLI_math_vector_types.hh"
+#include "BLI_rand.hh"
+#include "BLI_task.hh"
+#include "BLI_timeit.hh"
+#include "BLI_vector.hh"
+
+using namespace blender;
+
+static Vector<float3> random_points(const int size, const uint32_t seed)
+{
+  RandomNumberGenerator rng(seed);
+  Vector<float3> points(size);
+  for (float3 &point : points) {
+    point = {rng.get_float(), rng.get_float(), rng.get_float()};
+  }
+  return points;
+}
+
+static void kdtree_benchmark(const int tree_size, const int query_len, const uint nearest_len)
+{
+  printf("Tree size: %d, queries: %d, nearest: %u\n", tree_size, query_len, nearest_len);
+  const Vector<float3> points = random_points(tree_size, 0);
+  const Vector<float3> query = random_points(query_len, 1);
+
+  KDTree_3d *tree = BLI_kdtree_3d_new(tree_size);
+  for (const int i : points.index_range()) {
+    BLI_kdtree_3d_insert(tree, i, points[i]);
+  }
+  {
+    SCOPED_TIMER("balance");
+    BLI_kdtree_3d_balance(tree);
+  }
+
+  Vector<KDTreeNearest_3d> nearest(query_len * nearest_len);
+  {
+    SCOPED_TIMER("find_nearest_n (single-threaded loop)");
+    for (const int i : query.index_range()) {
+      BLI_kdtree_3d_find_nearest_n(tree, query[i], &nearest[i * nearest_len], nearest_len);
+    }
+  }
+  {
+    SCOPED_TIMER("find_nearest_n (parallel_for)");
+    threading::parallel_for(query.index_range(), 1024, [&](const IndexRange range) {
+      for (const int i : range) {
+        BLI_kdtree_3d_find_nearest_n(tree, query[i], &nearest[i * nearest_len], nearest_len);
+      }
+    });
+  }
+  {
+    SCOPED_TIMER("find_nearest_n_batch");
+    BLI_kdtree_3d_find_nearest_n_batch(tree,
+                                       reinterpret_cast<const float(*)[3]>(query.data()),
+                                       query_len,
+                                       nearest.data(),
+                                       nearest_len,
+                                       nullptr);
+  }
+  BLI_kdtree_3d_free(tree);
+}
+
+TEST(kdtree, FindNearest1M)
+{
+  kdtree_benchmark(1000000, 1000000, 1);
+}
+
+TEST(kdtree, FindNearestN1M)
+{
+  kdtree_benchmark(1000000, 1000000, 8);
+}
+
+TEST(kdtree, FindNearest10M)
+{
+  kdtree_benchmark(10000000, 1000000, 1);
+}
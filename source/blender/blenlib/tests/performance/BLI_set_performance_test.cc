@@ -0,0 +1,120 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: Apache-2.0 */
+
+#include "testing/testing.h"
+
+#include "BLI_array.hh"
+#include "BLI_offset_indices.hh"
+#include "BLI_rand.hh"
+#include "BLI_set.hh"
+#include "BLI_task.hh"
+#include "BLI_timeit.hh"
+#include "BLI_vector.hh"
+#include "BLI_vector_set.hh"
+
+namespace blender::tests {
+
+/** Random keys where about half of the values are duplicates. */
+static Vector<int> random_keys(const int64_t size, const uint32_t seed)
+{
+  RandomNumberGenerator rng(seed);
+  Vector<int> keys(size);
+  for (int &key : keys) {
+    key = rng.get_int32(int(size));
+  }
+  return keys;
+}
+
+template<typename SetT> static void set_benchmark(const char *name, const int64_t size)
+{
+  const Vector<int> keys = random_keys(size, 0);
+  const Vector<int> queries = random_keys(size, 1);
+  printf("%s with %lld keys\n", name, (long long)size);
+
+  SetT set;
+  {
+    SCOPED_TIMER("  add");
+    for (const int key : keys) {
+      set.add(key);
+    }
+  }
+  int64_t found = 0;
+  {
+    SCOPED_TIMER("  contains");
+    for (const int query : queries) {
+      found += set.contains(query);
+    }
+  }
+  {
+    SCOPED_TIMER("  remove");
+    for (const int key : keys) {
+      set.remove(key);
+    }
+  }
+  EXPECT_TRUE(set.is_empty());
+  EXPECT_GT(found, 0);
+}
+
+TEST(set_performance, AddContainsRemove)
+{
+  for (const int64_t size : {1000, 100000, 10000000}) {
+    set_benchmark<Set<int>>("Set", size);
+    set_benchmark<VectorSet<int>>("VectorSet", size);
+  }
+}
+
+TEST(vector_set_performance, IndexOfOrAdd)
+{
+  for (const int64_t size : {1000, 100000, 10000000}) {
+    const Vector<int> keys = random_keys(size, 0);
+    printf("VectorSet::index_of_or_add with %lld keys\n", (long long)size);
+    VectorSet<int> set;
+    int64_t sum = 0;
+    {
+      SCOPED_TIMER("  index_of_or_add");
+      for (const int key : keys) {
+        sum += set.index_of_or_add(key);
+      }
+    }
+    EXPECT_LE(set.size(), size);
+    EXPECT_GE(sum, 0);
+  }
+}
+
+TEST(offset_indices_performance, AccumulateAndIterate)
+{
+  for (const int64_t size : {1000, 1000000, 10000000}) {
+    RandomNumberGenerator rng(0);
+    Array<int> counts_to_offsets(size + 1);
+    for (const int64_t i : IndexRange(size)) {
+      counts_to_offsets[i] = rng.get_int32(8);
+    }
+    printf("OffsetIndices with %lld groups\n", (long long)size);
+
+    OffsetIndices<int> offsets;
+    {
+      SCOPED_TIMER("  accumulate_counts_to_offsets");
+      offsets = offset_indices::accumulate_counts_to_offsets(counts_to_offsets);
+    }
+    Array<int> group_by_index(offsets.total_size());
+    {
+      SCOPED_TIMER("  fill group indices (parallel_for)");
+      threading::parallel_for(offsets.index_range(), 4096, [&](const IndexRange range) {
+        for (const int64_t group : range) {
+          group_by_index.as_mutable_span().slice(offsets[group]).fill(int(group));
+        }
+      });
+    }
+    int64_t sizes_sum = 0;
+    {
+      SCOPED_TIMER("  sum group sizes");
+      for (const int64_t group : offsets.index_range()) {
+        sizes_sum += offsets[group].size();
+      }
+    }
+    EXPECT_EQ(sizes_sum, offsets.total_size());
+  }
+}
+
+}  // namespace blender::tests
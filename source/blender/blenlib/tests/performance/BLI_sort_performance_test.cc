@@ -0,0 +1,100 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: Apache-2.0 */
+
+#include "testing/testing.h"
+
+#include "BLI_array_utils.hh"
+#include "BLI_rand.hh"
+#include "BLI_sort.hh"
+#include "BLI_timeit.hh"
+
+namespace blender::tests {
+
+static Array<int> random_ints(const int64_t size)
+{
+  RandomNumberGenerator rng(0);
+  Array<int> values(size);
+  for (int &value : values) {
+    value = rng.get_int32();
+  }
+  return values;
+}
+
+static Array<float> random_floats(const int64_t size)
+{
+  RandomNumberGenerator rng(0);
+  Array<float> values(size);
+  for (float &value : values) {
+    value = rng.get_float();
+  }
+  return values;
+}
+
+template<typename T> static void benchmark_sort_values(const Span<T> values)
+{
+  printf("Sort %lld values\n", (long long)values.size());
+  {
+    Array<T> data = values;
+    SCOPED_TIMER("  parallel_sort");
+    parallel_sort(data.begin(), data.end());
+  }
+  {
+    Array<T> data = values;
+    SCOPED_TIMER("  parallel_stable_sort");
+    parallel_stable_sort(data.as_mutable_span(), std::less<T>());
+  }
+  {
+    Array<T> data = values;
+    SCOPED_TIMER("  parallel_radix_sort");
+    parallel_radix_sort(data.as_mutable_span());
+  }
+}
+
+template<typename T> static void benchmark_sort_indices(const Span<T> keys)
+{
+  printf("Sort %lld indices by key\n", (long long)keys.size());
+  Array<int> initial_indices(keys.size());
+  array_utils::fill_index_range<int>(initial_indices);
+  const auto comp = [&](const int a, const int b) {
+    if (keys[a] == keys[b]) {
+      return a < b;
+    }
+    return keys[a] < keys[b];
+  };
+  {
+    Array<int> indices = initial_indices;
+    SCOPED_TIMER("  parallel_sort");
+    parallel_sort(indices.begin(), indices.end(), comp);
+  }
+  {
+    Array<int> indices = initial_indices;
+    SCOPED_TIMER("  parallel_stable_sort");
+    parallel_stable_sort(indices.as_mutable_span(), comp);
+  }
+  {
+    Array<int> indices = initial_indices;
+    SCOPED_TIMER("  parallel_radix_sort_indices_by_key");
+    parallel_radix_sort_indices_by_key(keys, indices.as_mutable_span());
+  }
+}
+
+TEST(sort_performance, Ints)
+{
+  for (const int64_t size : {10000, 1000000, 10000000}) {
+    const Array<int> values = random_ints(size);
+    benchmark_sort_values<int>(values);
+    benchmark_sort_indices<int>(values);
+  }
+}
+
+TEST(sort_performance, Floats)
+{
+  for (const int64_t size : {10000, 1000000, 10000000}) {
+    const Array<float> values = random_floats(size);
+    benchmark_sort_values<float>(values);
+    benchmark_sort_indices<float>(values);
+  }
+}
+
+}  // namespace blender::tests
@@ -357,6 +357,31 @@ const blender::ImplicitSharingInfo *BLO_read_shared(
   return shared_data.sharing_info;
 }
 
+const blender::ImplicitSharingInfo *blo_read_shared_from_mapping_impl(BlendDataReader *reader,
+                                                                     const void **ptr_p,
+                                                                     int64_t size_in_bytes,
+                                                                     int64_t alignment);
+
+/**
+ * Try to use the data at the given (stored) address in-place from the memory-mapped blend-file,
+ * instead of copying it into newly allocated memory. This only succeeds for large blocks that
+ * need no conversion at all (same endianness and DNA layout). On success the pointer is updated
+ * and the returned sharing-info keeps the mapping alive, the data has to be treated like any
+ * other implicitly shared data (pages of the mapping are copy-on-write).
+ *
+ * Meant to be called from the #BLO_read_shared callback for trivial arrays only, since the data is
+ * not freed with the guarded allocator. When null is returned, the data has to be read as usual.
+ */
+template<typename T>
+const blender::ImplicitSharingInfo *BLO_read_shared_from_mapping(BlendDataReader *reader,
+                                                                T **data_ptr,
+                                                                const int64_t size_in_bytes,
+                                                                const int64_t alignment)
+{
+  return blo_read_shared_from_mapping_impl(
+      reader, (const void **)data_ptr, size_in_bytes, alignment);
+}
+
 int BLO_read_fileversion_get(BlendDataReader *reader);
 bool BLO_read_requires_endian_switch(BlendDataReader *reader);
 bool BLO_read_data_is_undo(BlendDataReader *reader);
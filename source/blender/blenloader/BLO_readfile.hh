@@ -6,6 +6,8 @@
 #include "BLI_listbase.h"
 #include "BLI_sys_types.h"
 
+#include "DNA_ID.h"
+
 /** \file
  * \ingroup blenloader
  * \brief external readfile function prototypes.
@@ -88,7 +90,7 @@ struct BlendFileReadWMSetupData {
 };
 
 struct BlendFileReadParams {
-  uint skip_flags : 3; /* #eBLOReadSkip */
+  uint skip_flags : 4; /* #eBLOReadSkip */
   uint is_startup : 1;
   uint is_factory_settings : 1;
 
@@ -103,12 +105,29 @@ struct BlendFileReadReport {
   /** Timing information. */
   struct {
     double whole;
+    /** Reading the data-blocks of the main file: I/O, decompression and DNA conversion. */
+    double read_data;
+    /** DNA conversion of data from older or different files (main file and libraries). */
+    double dna_conversion;
+    /** Versioning of the main file, before and after linking. */
+    double versioning;
+    /** Restoring ID pointers of all data, part of #libraries. */
+    double lib_link;
     double libraries;
     double lib_overrides;
     double lib_overrides_resync;
     double lib_overrides_recursive_resync;
   } duration;
 
+  /**
+   * Number of read data-blocks and time spent reading them per ID type (indexed like
+   * #BKE_idtype_idcode_to_index), including linked ones.
+   */
+  struct {
+    int count;
+    double duration;
+  } id_types[INDEX_ID_MAX];
+
   /** Count information. */
   struct {
     /**
@@ -150,8 +169,16 @@ enum eBLOReadSkip {
   BLO_READ_SKIP_DATA = (1 << 1),
   /** Do not attempt to re-use IDs from old bmain for unchanged ones in case of undo. */
   BLO_READ_SKIP_UNDO_OLD_MAIN = (1 << 2),
+  /**
+   * Only read local IDs that are reachable from the window-manager, workspaces, screens and the
+   * active scene, other IDs are not read at all (nor versioned). The resulting #Main is tagged
+   * with #Main.is_partially_read, and must not be saved.
+   *
+   * Meant for loading a single scene out of a large file (e.g. for background rendering).
+   */
+  BLO_READ_SKIP_UNREACHABLE_IDS = (1 << 3),
 };
-ENUM_OPERATORS(eBLOReadSkip, BLO_READ_SKIP_UNDO_OLD_MAIN)
+ENUM_OPERATORS(eBLOReadSkip, BLO_READ_SKIP_UNREACHABLE_IDS)
 #define BLO_READ_SKIP_ALL (BLO_READ_SKIP_USERDEF | BLO_READ_SKIP_DATA)
 
 /**
@@ -28,12 +28,15 @@ struct MemFileSharedStorage {
   ~MemFileSharedStorage();
 };
 
+/** Chunk data, stored once for all undo steps (see #BLO_memfile_chunk_add). */
+struct MemFileChunkBuffer;
+
 struct MemFileChunk {
   void *next, *prev;
-  const char *buf;
+  MemFileChunkBuffer *buffer;
   /** Size in bytes. */
   size_t size;
-  /** When true, this chunk doesn't own the memory, it's shared with a previous #MemFileChunk */
+  /** When true, this chunk is identical to the matching one of the previous step. */
   bool is_identical;
   /** When true, this chunk is also identical to the one in the next step (used by undo code to
    * detect unchanged IDs).
@@ -46,7 +49,10 @@ struct MemFileChunk {
 
 struct MemFile {
   ListBase chunks;
+  /** Memory used by the chunks, use #BLO_memfile_size_get while compression may be running. */
   size_t size;
+  /** Incremented for every written memfile, to know which buffers are only used by old steps. */
+  uint64_t generation;
   /**
    * Some data is not serialized into a new buffer because the undo-step can take ownership of it
    * without making a copy. This is faster and requires less memory.
@@ -107,6 +113,13 @@ void BLO_memfile_merge(MemFile *first, MemFile *second);
  * Clear is_identical_future before adding next memfile.
  */
 void BLO_memfile_clear_future(MemFile *memfile);
+/**
+ * Compress the data of \a memfile which is not used by newer memfiles, in a background thread.
+ * It is transparently decompressed when reading the memfile again.
+ */
+void BLO_memfile_compress(MemFile *memfile);
+/** Thread-safe access to #MemFile.size. */
+size_t BLO_memfile_size_get(MemFile *memfile);
 
 /* Utilities. */
 
@@ -54,6 +54,32 @@ extern bool BLO_write_file(Main *mainvar,
                            const BlendFileWriteParams *params,
                            ReportList *reports);
 
+/**
+ * Data of a file write done in two stages: #BLO_write_file_snapshot serializes Main in memory, then
+ * #BLO_write_file_snapshot_write compresses and writes it to disk, without accessing Main, so it
+ * can run on a worker thread.
+ */
+struct BlendFileWriteSnapshot;
+
+/**
+ * Same as #BLO_write_file, but only serialize \a mainvar into memory.
+ * \return nullptr on failure.
+ */
+BlendFileWriteSnapshot *BLO_write_file_snapshot(Main *mainvar,
+                                                const char *filepath,
+                                                int write_flags,
+                                                const BlendFileWriteParams *params,
+                                                ReportList *reports);
+/**
+ * Write the snapshot to its file, thread-safe.
+ * \param r_progress: When not null, updated from 0 to 1 while writing.
+ * \return Success.
+ */
+bool BLO_write_file_snapshot_write(BlendFileWriteSnapshot *snapshot,
+                                   ReportList *reports,
+                                   float *r_progress);
+void BLO_write_file_snapshot_free(BlendFileWriteSnapshot *snapshot);
+
 /**
  * \return Success.
  */
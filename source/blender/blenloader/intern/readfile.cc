@@ -58,8 +58,11 @@
 #include "BLI_map.hh"
 #include "BLI_memarena.h"
 #include "BLI_mempool.h"
+#include "BLI_mmap.h"
+#include "BLI_task.hh"
 #include "BLI_threads.h"
 #include "BLI_time.h"
+#include "BLI_vector.hh"
 
 #include "BLT_translation.hh"
 
@@ -174,6 +177,23 @@
 /** Use #GHash for #BHead name-based lookups (speeds up linking). */
 #define USE_GHASH_BHEAD
 
+/**
+ * Share large data arrays directly from the memory-mapped file instead of copying them into newly
+ * allocated memory, see #BLO_read_shared_from_mapping. Requires #USE_BHEAD_READ_ON_DEMAND.
+ *
+ * \note Disabled on WIN32, where files can't be replaced while they are mapped, which would make
+ * saving over the opened file fail for as long as any of its data is in use.
+ */
+#ifndef WIN32
+#  define USE_MMAP_SHARED_DATA
+#endif
+
+/**
+ * Blocks smaller than this are always copied, sharing them from the mapping would not save
+ * enough to be worth the extra sharing-info allocation.
+ */
+#define MMAP_SHARED_DATA_MIN_SIZE (1 << 16)
+
 /** Use #GHash for restoring pointers by name. */
 #define USE_GHASH_RESTORE_POINTER
 
@@ -182,6 +202,7 @@ static CLG_LogRef LOG_UNDO = {"blo.readfile.undo"};
 
 /* local prototypes */
 static void read_libraries(FileData *basefd, ListBase *mainlist);
+static void expand_doit_reachable(void *fdhandle, Main *mainvar, void *old);
 static void *read_struct(FileData *fd, BHead *bh, const char *blockname, const int id_type_index);
 static BHead *find_bhead_from_code_name(FileData *fd, const short idcode, const char *name);
 static BHead *find_bhead_from_idname(FileData *fd, const char *idname);
@@ -246,6 +267,13 @@ struct NewAddress {
 
   /** `nr` is "user count" for data, and ID code for libdata. */
   int nr;
+
+  /**
+   * Only for data, set when `newp` points into the memory-mapped file instead of allocated
+   * memory. Such data is never freed, and is copied into allocated memory before being returned
+   * for regular use, see #newdataadr_ensure_allocated.
+   */
+  BHead *mapped_bhead = nullptr;
 };
 
 struct OldNewMap {
@@ -313,7 +341,7 @@ static void oldnewmap_clear(OldNewMap *onm)
 {
   /* Free unused data. */
   for (NewAddress &new_addr : onm->map.values()) {
-    if (new_addr.nr == 0) {
+    if (new_addr.nr == 0 && new_addr.mapped_bhead == nullptr) {
       MEM_freeN(new_addr.newp);
     }
   }
@@ -327,6 +355,50 @@ static void oldnewmap_free(OldNewMap *onm)
 
 /** \} */
 
+/* -------------------------------------------------------------------- */
+/** \name Memory-Mapped Data Sharing
+ * \{ */
+
+/** Owns a memory-mapped blend-file, which is unmapped when the last user is removed. */
+class MappedFileSharingInfo : public blender::ImplicitSharingInfo {
+ public:
+  BLI_mmap_file *mmap;
+
+  MappedFileSharingInfo(BLI_mmap_file *mmap) : mmap(mmap) {}
+
+ private:
+  void delete_self_with_data() override
+  {
+    BLI_mmap_free(mmap);
+    MEM_delete(this);
+  }
+};
+
+/**
+ * Sharing-info for a single data block used in-place from the mapping. A separate sharing-info
+ * per block is used so that each array has its own user count (i.e. it is mutable as soon as it
+ * has a single owner, the pages of the mapping are copy-on-write).
+ */
+class MappedDataSharingInfo : public blender::ImplicitSharingInfo {
+ public:
+  const blender::ImplicitSharingInfo *file_sharing_info;
+
+  MappedDataSharingInfo(const blender::ImplicitSharingInfo *file_sharing_info)
+      : file_sharing_info(file_sharing_info)
+  {
+    file_sharing_info->add_user();
+  }
+
+ private:
+  void delete_self_with_data() override
+  {
+    file_sharing_info->remove_user_and_delete_if_last();
+    MEM_delete(this);
+  }
+};
+
+/** \} */
+
 /* -------------------------------------------------------------------- */
 /** \name Helper Functions
  * \{ */
@@ -931,6 +1003,33 @@ static BHead *blo_bhead_read_full(FileData *fd, BHead *thisblock)
 }
 #endif /* USE_BHEAD_READ_ON_DEMAND */
 
+#ifdef USE_MMAP_SHARED_DATA
+/**
+ * \return The location of the block data in the memory-mapped file when the block is large and
+ * can be used as is (no endian switch or DNA reconstruction needed), otherwise null.
+ */
+static void *blo_bhead_mapped_data(FileData *fd, BHead *bhead)
+{
+  if (fd->mmap == nullptr || bhead->len < MMAP_SHARED_DATA_MIN_SIZE) {
+    return nullptr;
+  }
+  if (fd->flags & FD_FLAGS_SWITCH_ENDIAN) {
+    return nullptr;
+  }
+  if (fd->compflags[bhead->SDNAnr] != SDNA_CMP_EQUAL) {
+    return nullptr;
+  }
+  const BHeadN *bheadn = BHEADN_FROM_BHEAD(bhead);
+  if (bheadn->has_data) {
+    return nullptr;
+  }
+  if (bheadn->file_offset + size_t(bhead->len) > BLI_mmap_get_length(fd->mmap)) {
+    return nullptr;
+  }
+  return POINTER_OFFSET(BLI_mmap_get_pointer(fd->mmap), bheadn->file_offset);
+}
+#endif
+
 const char *blo_bhead_id_name(const FileData *fd, const BHead *bhead)
 {
   return (const char *)POINTER_OFFSET(bhead, sizeof(*bhead) + fd->id_name_offset);
@@ -1212,11 +1311,16 @@ static FileData *blo_filedata_from_file_descriptor(const char *filepath,
   /* Rewind the file after reading the header. */
   rawfile->seek(rawfile, 0, SEEK_SET);
 
+  BLI_mmap_file *mmap = nullptr;
+
   /* Check if we have a regular file. */
   if (memcmp(header, "BLENDER", sizeof(header)) == 0) {
     /* Try opening the file with memory-mapped IO. */
-    file = BLI_filereader_new_mmap(filedes);
-    if (file == nullptr) {
+    mmap = BLI_mmap_open(filedes);
+    if (mmap != nullptr) {
+      file = BLI_filereader_new_mmap_file(mmap);
+    }
+    else {
       /* `mmap` failed, so just keep using `rawfile`. */
       file = rawfile;
       rawfile = nullptr;
@@ -1246,6 +1350,11 @@ static FileData *blo_filedata_from_file_descriptor(const char *filepath,
 
   FileData *fd = filedata_new(reports);
   fd->file = file;
+  if (mmap != nullptr) {
+    /* The mapping stays valid after the file descriptor is closed. */
+    fd->mmap = mmap;
+    fd->mmap_sharing_info = MEM_new<MappedFileSharingInfo>(__func__, mmap);
+  }
 
   return fd;
 }
@@ -1359,6 +1468,10 @@ void blo_filedata_free(FileData *fd)
   }
 #endif
   fd->file->close(fd->file);
+  if (fd->mmap_sharing_info) {
+    /* Data shared from the mapping may keep it alive for longer. */
+    fd->mmap_sharing_info->remove_user_and_delete_if_last();
+  }
 
   if (fd->filesdna) {
     DNA_sdna_free(fd->filesdna);
@@ -1449,16 +1562,58 @@ short BLO_version_from_file(const char *filepath)
 /** \name Old/New Pointer Map
  * \{ */
 
+#ifdef USE_MMAP_SHARED_DATA
+/**
+ * Data used in-place from the memory-mapped file is only handed out by
+ * #BLO_read_shared_from_mapping. All other accesses get a copy in allocated memory, since the
+ * data is then owned (and freed) like any other data read from the file.
+ */
+static void *newdataadr_ensure_allocated(FileData *fd, NewAddress &entry)
+{
+  if (entry.mapped_bhead == nullptr) {
+    return entry.newp;
+  }
+  BHead *bhead = entry.mapped_bhead;
+  const int alignment = DNA_struct_alignment(fd->filesdna, bhead->SDNAnr);
+  void *data = MEM_mallocN_aligned(bhead->len, alignment, "Data copied from mapped file");
+  if (UNLIKELY(!blo_bhead_read_data(fd, bhead, data))) {
+    fd->flags &= ~FD_FLAGS_FILE_OK;
+    MEM_freeN(data);
+    return nullptr;
+  }
+  entry.newp = data;
+  entry.mapped_bhead = nullptr;
+  return data;
+}
+#endif
+
 /* Only direct data-blocks. */
 static void *newdataadr(FileData *fd, const void *adr)
 {
+#ifdef USE_MMAP_SHARED_DATA
+  NewAddress *entry = fd->datamap->map.lookup_ptr(adr);
+  if (entry == nullptr) {
+    return nullptr;
+  }
+  entry->nr++;
+  return newdataadr_ensure_allocated(fd, *entry);
+#else
   return oldnewmap_lookup_and_inc(fd->datamap, adr, true);
+#endif
 }
 
 /* Only direct data-blocks. */
 static void *newdataadr_no_us(FileData *fd, const void *adr)
 {
+#ifdef USE_MMAP_SHARED_DATA
+  NewAddress *entry = fd->datamap->map.lookup_ptr(adr);
+  if (entry == nullptr) {
+    return nullptr;
+  }
+  return newdataadr_ensure_allocated(fd, *entry);
+#else
   return oldnewmap_lookup_and_inc(fd->datamap, adr, false);
+#endif
 }
 
 void *blo_read_get_new_globaldata_address(FileData *fd, const void *adr)
@@ -2464,28 +2619,142 @@ static bool direct_link_id(FileData *fd, Main *main, const int tag, ID *id, ID *
 }
 
 /* Read all data associated with a datablock into datamap. */
+/**
+ * A data block of an ID which needs its endianness switched and/or its DNA struct reconstructed.
+ * This conversion is CPU bound and independent for each block, so it is deferred in
+ * #read_data_into_datamap and done for all blocks of the ID in parallel.
+ */
+struct DeferredDataBlock {
+  /** The block, with its data read already. */
+  BHead *bhead;
+  /** Whether the block was read on demand and #bhead must be freed after conversion. */
+  bool free_bhead;
+  const char *alloc_name;
+  void *data = nullptr;
+};
+
+/**
+ * Return true if #read_struct would have to convert the data of \a bhead, i.e. more work than
+ * copying it from the file.
+ */
+static bool read_struct_needs_conversion(const FileData *fd, const BHead *bhead)
+{
+  if (bhead->len == 0 || fd->compflags[bhead->SDNAnr] == SDNA_CMP_REMOVED) {
+    return false;
+  }
+  if (fd->compflags[bhead->SDNAnr] == SDNA_CMP_NOT_EQUAL) {
+    return true;
+  }
+  return bhead->SDNAnr > SDNA_RAW_DATA_STRUCT_INDEX && (fd->flags & FD_FLAGS_SWITCH_ENDIAN);
+}
+
+/**
+ * Same as the conversion part of #read_struct, for a block which data has been read already.
+ * Only accesses read-only data of \a fd, so it can be called from multiple threads.
+ */
+static void *read_struct_convert(const FileData *fd, BHead *bh, const char *alloc_name)
+{
+  if (bh->SDNAnr > SDNA_RAW_DATA_STRUCT_INDEX && (fd->flags & FD_FLAGS_SWITCH_ENDIAN)) {
+    switch_endian_structs(fd->filesdna, bh);
+  }
+  if (fd->compflags[bh->SDNAnr] == SDNA_CMP_NOT_EQUAL) {
+    return DNA_struct_reconstruct(fd->reconstruct_info, bh->SDNAnr, bh->nr, (bh + 1), alloc_name);
+  }
+  const int alignment = DNA_struct_alignment(fd->filesdna, bh->SDNAnr);
+  void *temp = MEM_mallocN_aligned(bh->len, alignment, alloc_name);
+  memcpy(temp, (bh + 1), bh->len);
+  return temp;
+}
+
 static BHead *read_data_into_datamap(FileData *fd,
                                      BHead *bhead,
                                      const char *allocname,
                                      const int id_type_index)
 {
+  /* Blocks are read from the file sequentially, but the ones which need conversion are only
+   * converted once all blocks of the ID have been read. The results are then inserted in the
+   * datamap in file order, so that duplicate old addresses are resolved like when reading
+   * sequentially. */
+  struct PendingAddress {
+    const void *old;
+    NewAddress address;
+    /** Index in `deferred_blocks` providing the new address, or -1. */
+    int64_t deferred_index = -1;
+  };
+  blender::Vector<DeferredDataBlock> deferred_blocks;
+  blender::Vector<PendingAddress> new_addresses;
+
   bhead = blo_bhead_next(fd, bhead);
 
   while (bhead && bhead->code == BLO_CODE_DATA) {
-    void *data = read_struct(fd, bhead, allocname, id_type_index);
-    if (data) {
-      const bool is_new = oldnewmap_insert(fd->datamap, bhead->old, data, 0);
-      if (!is_new) {
-        CLOG_ERROR(&LOG,
-                   "Blendfile corruption: Invalid, or multiple `bhead` with same old address "
-                   "value (%p) for a given ID.",
-                   bhead->old);
+#ifdef USE_MMAP_SHARED_DATA
+    if (void *mapped_data = blo_bhead_mapped_data(fd, bhead)) {
+      /* Don't read the data yet, it may be shared from the mapping directly. */
+      new_addresses.append({bhead->old, NewAddress{mapped_data, 0, bhead}});
+      bhead = blo_bhead_next(fd, bhead);
+      continue;
+    }
+#endif
+    if (read_struct_needs_conversion(fd, bhead)) {
+      BHead *bhead_full = bhead;
+#ifdef USE_BHEAD_READ_ON_DEMAND
+      if (BHEADN_FROM_BHEAD(bhead)->has_data == false) {
+        bhead_full = blo_bhead_read_full(fd, bhead);
+        if (UNLIKELY(bhead_full == nullptr)) {
+          fd->flags &= ~FD_FLAGS_FILE_OK;
+          bhead = blo_bhead_next(fd, bhead);
+          continue;
+        }
       }
+#endif
+      const int64_t deferred_index = deferred_blocks.append_and_get_index(
+          {bhead_full,
+           bhead_full != bhead,
+           get_alloc_name(fd, bhead, allocname, id_type_index)});
+      new_addresses.append({bhead->old, NewAddress{nullptr, 0}, deferred_index});
+    }
+    else if (void *data = read_struct(fd, bhead, allocname, id_type_index)) {
+      new_addresses.append({bhead->old, NewAddress{data, 0}});
     }
 
     bhead = blo_bhead_next(fd, bhead);
   }
 
+  const double conversion_start_time = BLI_time_now_seconds();
+  blender::threading::parallel_for(
+      deferred_blocks.index_range(), 4, [&](const blender::IndexRange range) {
+        for (DeferredDataBlock &block : deferred_blocks.as_mutable_span().slice(range)) {
+          block.data = read_struct_convert(fd, block.bhead, block.alloc_name);
+        }
+      });
+  if (fd->reports && !deferred_blocks.is_empty()) {
+    fd->reports->duration.dna_conversion += BLI_time_now_seconds() - conversion_start_time;
+  }
+
+#ifdef USE_BHEAD_READ_ON_DEMAND
+  for (DeferredDataBlock &block : deferred_blocks) {
+    if (block.free_bhead) {
+      MEM_freeN(BHEADN_FROM_BHEAD(block.bhead));
+    }
+  }
+#endif
+
+  for (PendingAddress &item : new_addresses) {
+    if (item.deferred_index != -1) {
+      item.address.newp = deferred_blocks[item.deferred_index].data;
+    }
+    if (item.old == nullptr || item.address.newp == nullptr) {
+      continue;
+    }
+    const bool is_new = fd->datamap->map.add_overwrite(item.old, item.address);
+    if (!is_new) {
+      CLOG_ERROR(&LOG,
+                 "Blendfile corruption: Invalid, or multiple `bhead` with same old address "
+                 "value (%p) for a given ID.",
+                 item.old);
+    }
+  }
+
   return bhead;
 }
 
@@ -2863,12 +3132,12 @@ static bool read_libblock_undo_restore(
  * When reading for undo, libraries, linked datablocks and unchanged datablocks
  * will be restored from the old database. Only new or changed datablocks will
  * actually be read. */
-static BHead *read_libblock(FileData *fd,
-                            Main *main,
-                            BHead *bhead,
-                            int id_tag,
-                            const bool placeholder_set_indirect_extern,
-                            ID **r_id)
+static BHead *read_libblock_impl(FileData *fd,
+                                 Main *main,
+                                 BHead *bhead,
+                                 int id_tag,
+                                 const bool placeholder_set_indirect_extern,
+                                 ID **r_id)
 {
   const bool do_partial_undo = (fd->skip_flags & BLO_READ_SKIP_UNDO_OLD_MAIN) == 0;
 
@@ -2991,6 +3260,31 @@ static BHead *read_libblock(FileData *fd,
   return bhead;
 }
 
+/**
+ * Read an ID and its data, also gathering timing statistics per ID type in the read reports.
+ */
+static BHead *read_libblock(FileData *fd,
+                            Main *main,
+                            BHead *bhead,
+                            int id_tag,
+                            const bool placeholder_set_indirect_extern,
+                            ID **r_id)
+{
+  if (fd->reports == nullptr) {
+    return read_libblock_impl(fd, main, bhead, id_tag, placeholder_set_indirect_extern, r_id);
+  }
+
+  const int id_type_index = BKE_idtype_idcode_to_index(bhead->code);
+  const double start_time = BLI_time_now_seconds();
+  BHead *bhead_next = read_libblock_impl(
+      fd, main, bhead, id_tag, placeholder_set_indirect_extern, r_id);
+  if (id_type_index >= 0 && id_type_index < INDEX_ID_MAX) {
+    fd->reports->id_types[id_type_index].count++;
+    fd->reports->id_types[id_type_index].duration += BLI_time_now_seconds() - start_time;
+  }
+  return bhead_next;
+}
+
 /** \} */
 
 /* -------------------------------------------------------------------- */
@@ -3527,6 +3821,11 @@ BlendFileData *blo_read_file_internal(FileData *fd, const char *filepath)
     CLOG_INFO(&LOG_UNDO, 2, "UNDO: read step");
   }
 
+  /* Undo steps are always read completely. */
+  const bool use_reachable_only = !is_undo &&
+                                  (fd->skip_flags & BLO_READ_SKIP_UNREACHABLE_IDS) != 0 &&
+                                  (fd->skip_flags & BLO_READ_SKIP_DATA) == 0;
+
   /* Prevent any run of layer collections rebuild during readfile process, and the do_versions
    * calls.
    *
@@ -3580,6 +3879,8 @@ BlendFileData *blo_read_file_internal(FileData *fd, const char *filepath)
     read_undo_reuse_noundo_local_ids(fd);
   }
 
+  fd->reports->duration.read_data = BLI_time_now_seconds();
+
   while (bhead) {
     switch (bhead->code) {
       case BLO_CODE_DATA:
@@ -3607,6 +3908,10 @@ BlendFileData *blo_read_file_internal(FileData *fd, const char *filepath)
         if (fd->skip_flags & BLO_READ_SKIP_DATA) {
           bhead = blo_bhead_next(fd, bhead);
         }
+        else if (use_reachable_only) {
+          /* Only used linked data is added, when expanding local IDs below. */
+          bhead = blo_bhead_next(fd, bhead);
+        }
         else {
           /* Add link placeholder to the main of the library it belongs to.
            * The library is the most recently loaded ID_LI block, according
@@ -3625,6 +3930,16 @@ BlendFileData *blo_read_file_internal(FileData *fd, const char *filepath)
         if (fd->skip_flags & BLO_READ_SKIP_DATA) {
           bhead = blo_bhead_next(fd, bhead);
         }
+        else if (use_reachable_only) {
+          if (ELEM(bhead->code, ID_LI, ID_WM, ID_WS, ID_SCR)) {
+            /* The roots of the reachable IDs, libraries are needed to find linked data. */
+            bhead = read_libblock(
+                fd, bfd->main, bhead, ID_TAG_LOCAL | ID_TAG_NEED_EXPAND, false, nullptr);
+          }
+          else {
+            bhead = blo_bhead_next(fd, bhead);
+          }
+        }
         else {
           bhead = read_libblock(fd, bfd->main, bhead, ID_TAG_LOCAL, false, nullptr);
         }
@@ -3635,6 +3950,20 @@ BlendFileData *blo_read_file_internal(FileData *fd, const char *filepath)
     }
   }
 
+  fd->reports->duration.read_data = BLI_time_now_seconds() - fd->reports->duration.read_data;
+
+  if (use_reachable_only && !bfd->main->is_read_invalid) {
+    /* The active scene is always needed, even when no window uses it (e.g. in background mode).
+     * Then read everything the roots depend on, before versioning like for linked data. */
+    expand_doit_reachable(fd, bfd->main, bfd->curscene);
+    BLO_expand_main(fd, bfd->main, expand_doit_reachable);
+    if (bfd->main->id_map != nullptr) {
+      BKE_main_idmap_destroy(bfd->main->id_map);
+      bfd->main->id_map = nullptr;
+    }
+    bfd->main->is_partially_read = true;
+  }
+
   if (is_undo) {
     /* Move the remaining Library IDs and their linked data to the new main.
      *
@@ -3660,6 +3989,7 @@ BlendFileData *blo_read_file_internal(FileData *fd, const char *filepath)
 
   /* Do versioning before read_libraries, but skip in undo case. */
   if (!is_undo) {
+    const double versioning_start_time = BLI_time_now_seconds();
     if ((fd->skip_flags & BLO_READ_SKIP_DATA) == 0) {
       do_versions(fd, nullptr, bfd->main);
     }
@@ -3667,6 +3997,7 @@ BlendFileData *blo_read_file_internal(FileData *fd, const char *filepath)
     if ((fd->skip_flags & BLO_READ_SKIP_USERDEF) == 0) {
       do_versions_userdef(fd, bfd);
     }
+    fd->reports->duration.versioning += BLI_time_now_seconds() - versioning_start_time;
   }
 
   if (bfd->main->is_read_invalid) {
@@ -3679,8 +4010,10 @@ BlendFileData *blo_read_file_internal(FileData *fd, const char *filepath)
 
     blo_join_main(&mainlist);
 
+    const double lib_link_start_time = BLI_time_now_seconds();
     lib_link_all(fd, bfd->main);
     after_liblink_merged_bmain_process(bfd->main, fd->reports);
+    fd->reports->duration.lib_link = BLI_time_now_seconds() - lib_link_start_time;
 
     if (is_undo) {
       /* Ensure ID usages of reused 'no undo' IDs remain valid. */
@@ -3706,6 +4039,7 @@ BlendFileData *blo_read_file_internal(FileData *fd, const char *filepath)
       BKE_layer_collection_resync_allow();
 
       /* Yep, second splitting... but this is a very cheap operation, so no big deal. */
+      const double versioning_start_time = BLI_time_now_seconds();
       blo_split_main(&mainlist, bfd->main);
       LISTBASE_FOREACH (Main *, mainvar, &mainlist) {
         BLI_assert(mainvar->versionfile != 0);
@@ -3715,6 +4049,7 @@ BlendFileData *blo_read_file_internal(FileData *fd, const char *filepath)
                                   mainvar);
       }
       blo_join_main(&mainlist);
+      fd->reports->duration.versioning += BLI_time_now_seconds() - versioning_start_time;
 
       BKE_layer_collection_resync_forbid();
 
@@ -3998,7 +4333,7 @@ static void expand_doit_library(void *fdhandle, Main *mainvar, void *old)
                        RPT_WARNING,
                        RPT_("LIB: Data refers to main .blend file: '%s' from %s"),
                        idname,
-                       mainvar->curlib->runtime.filepath_abs);
+                       mainvar->curlib ? mainvar->curlib->runtime.filepath_abs : fd->relabase);
       return;
     }
 
@@ -4078,6 +4413,49 @@ static void expand_doit_library(void *fdhandle, Main *mainvar, void *old)
   }
 }
 
+/**
+ * Expand callback used when only reading reachable IDs (see #BLO_READ_SKIP_UNREACHABLE_IDS):
+ * local IDs are read the first time they are referenced by an already read ID.
+ */
+static void expand_doit_reachable(void *fdhandle, Main *mainvar, void *old)
+{
+  FileData *fd = static_cast<FileData *>(fdhandle);
+
+  if (mainvar->is_read_invalid) {
+    return;
+  }
+
+  BHead *bhead = find_bhead(fd, old);
+  if (bhead == nullptr) {
+    return;
+  }
+
+  if (bhead->code == ID_LINK_PLACEHOLDER) {
+    /* Linked data is handled the same way as when linking from a library. */
+    expand_doit_library(fdhandle, mainvar, old);
+    return;
+  }
+  if (!blo_bhead_is_id_valid_type(bhead)) {
+    return;
+  }
+
+  /* In 2.50+ file identifier for screens is patched, forward compatibility. */
+  if (bhead->code == ID_SCRN) {
+    bhead->code = ID_SCR;
+  }
+
+  if (library_id_is_yet_read(fd, mainvar, bhead) != nullptr) {
+    return;
+  }
+
+  ID *id = nullptr;
+  read_libblock(fd, mainvar, bhead, ID_TAG_LOCAL | ID_TAG_NEED_EXPAND, false, &id);
+  if (id != nullptr) {
+    /* IDs are not read in file order anymore, keep the lists sorted. */
+    id_sort_by_name(which_libbase(mainvar, GS(id->name)), id, static_cast<ID *>(id->prev));
+  }
+}
+
 static int expand_cb(LibraryIDLinkCallbackData *cb_data)
 {
   /* Embedded IDs are not known by lib_link code, so they would be remapped to `nullptr`. But there
@@ -5085,6 +5463,31 @@ blender::ImplicitSharingInfoAndData blo_read_shared_impl(
   return shared_data;
 }
 
+const blender::ImplicitSharingInfo *blo_read_shared_from_mapping_impl(BlendDataReader *reader,
+                                                                     const void **ptr_p,
+                                                                     const int64_t size_in_bytes,
+                                                                     const int64_t alignment)
+{
+#ifdef USE_MMAP_SHARED_DATA
+  FileData *fd = reader->fd;
+  NewAddress *entry = fd->datamap->map.lookup_ptr(*ptr_p);
+  if (entry == nullptr || entry->mapped_bhead == nullptr) {
+    return nullptr;
+  }
+  if (entry->mapped_bhead->len < size_in_bytes || uintptr_t(entry->newp) % alignment != 0) {
+    /* Let the regular reading code deal with unexpected sizes, mapped data is not aligned to
+     * more than what is needed by the stored data in the file. */
+    return nullptr;
+  }
+  entry->nr++;
+  *ptr_p = entry->newp;
+  return MEM_new<MappedDataSharingInfo>(__func__, fd->mmap_sharing_info);
+#else
+  UNUSED_VARS(reader, ptr_p, size_in_bytes, alignment);
+  return nullptr;
+#endif
+}
+
 bool BLO_read_data_is_undo(BlendDataReader *reader)
 {
   return (reader->fd->flags & FD_FLAGS_IS_MEMFILE);
@@ -22,6 +22,10 @@
 
 #include "BLO_readfile.hh"
 
+namespace blender {
+class ImplicitSharingInfo;
+}
+struct BLI_mmap_file;
 struct BlendFileData;
 struct BlendfileLinkAppendContext;
 struct BlendFileReadParams;
@@ -65,6 +69,14 @@ struct FileData {
 
   FileReader *file;
 
+  /**
+   * The memory-mapped file when reading an uncompressed blend-file, with #mmap_sharing_info
+   * owning it. Large data blocks may be shared directly from the mapping, each of them keeping
+   * the mapping alive beyond the lifetime of this #FileData.
+   */
+  BLI_mmap_file *mmap;
+  const blender::ImplicitSharingInfo *mmap_sharing_info;
+
   /** Whether we are undoing (< 0) or redoing (> 0), used to choose which 'unchanged' flag to use
    * to detect unchanged data from memfile. */
   int undo_direction; /* eUndoStepDir */
@@ -26,6 +26,13 @@
 
 #include "BLI_blenlib.h"
 #include "BLI_implicit_sharing.hh"
+#include "BLI_map.hh"
+#include "BLI_task.h"
+#include "BLI_vector.hh"
+
+#include <mutex>
+#include <xxhash.h>
+#include <zstd.h>
 
 #include "BLO_readfile.hh"
 #include "BLO_undofile.hh"
@@ -38,17 +45,259 @@
 
 /* **************** support for memory-write, for undo buffers *************** */
 
+/**
+ * Content-addressed storage of the chunk buffers of all #MemFile undo steps, so that identical
+ * data is only stored once, no matter at which position or in which step it appears.
+ *
+ * Buffers only used by old undo steps can be compressed in the background, see
+ * #BLO_memfile_compress.
+ */
+struct MemFileChunkBuffer {
+  /** Uncompressed, or compressed when #compressed_size is not zero. */
+  char *data;
+  /** Uncompressed size in bytes. */
+  size_t size;
+  size_t compressed_size;
+  uint64_t hash;
+  /** Number of chunks using this buffer, and pending compression tasks. */
+  int users;
+  /** Most recent #MemFile.generation using this buffer. */
+  uint64_t generation;
+  /** The memfile which size accounts for this buffer, may be null. */
+  MemFile *owner;
+  /** False for buffers not in #MemFileChunkStore.buffers, because of a hash collision. */
+  bool is_stored;
+};
+
+struct MemFileChunkStore {
+  blender::Map<uint64_t, MemFileChunkBuffer *> buffers;
+  /** Protects the store, buffer data and #MemFile.size of all memfiles. */
+  std::mutex mutex;
+  uint64_t generation_last = 0;
+  /** Background pool for compression tasks, only exists while there are stored buffers. */
+  TaskPool *compress_pool = nullptr;
+};
+
+static MemFileChunkStore &memfile_chunk_store()
+{
+  static MemFileChunkStore store;
+  return store;
+}
+
+/** Recompressing data that is unlikely to shrink much is not worth the undo latency. */
+#define MEMFILE_COMPRESS_MIN_SIZE 4096
+#define MEMFILE_COMPRESS_LEVEL 1
+
+static void memfile_buffer_decompress_locked(MemFileChunkBuffer *buffer)
+{
+  if (buffer->compressed_size == 0) {
+    return;
+  }
+  char *data = static_cast<char *>(MEM_mallocN(buffer->size, "Chunk buffer"));
+  const size_t size = ZSTD_decompress(data, buffer->size, buffer->data, buffer->compressed_size);
+  BLI_assert(size == buffer->size);
+  UNUSED_VARS_NDEBUG(size);
+  if (buffer->owner) {
+    buffer->owner->size += buffer->size - buffer->compressed_size;
+  }
+  MEM_freeN(buffer->data);
+  buffer->data = data;
+  buffer->compressed_size = 0;
+}
+
+static void memfile_buffer_release_locked(MemFileChunkStore &store, MemFileChunkBuffer *buffer)
+{
+  if (--buffer->users > 0) {
+    return;
+  }
+  if (buffer->is_stored) {
+    store.buffers.remove_contained(buffer->hash);
+  }
+  MEM_freeN(buffer->data);
+  MEM_freeN(buffer);
+}
+
+/**
+ * Return a buffer with the given content, either shared with existing chunks or newly allocated
+ * (in which case \a r_is_new is set).
+ */
+static MemFileChunkBuffer *memfile_chunk_store_add(MemFile *memfile,
+                                                   const char *buf,
+                                                   const size_t size,
+                                                   bool *r_is_new)
+{
+  const uint64_t hash = XXH3_64bits(buf, size);
+
+  MemFileChunkStore &store = memfile_chunk_store();
+  std::lock_guard lock(store.mutex);
+
+  MemFileChunkBuffer *buffer = store.buffers.lookup_default(hash, nullptr);
+  if (buffer && buffer->size == size) {
+    /* Used by the new step again, so it should not stay compressed. */
+    memfile_buffer_decompress_locked(buffer);
+    if (memcmp(buffer->data, buf, size) == 0) {
+      buffer->users++;
+      buffer->generation = memfile->generation;
+      *r_is_new = false;
+      return buffer;
+    }
+  }
+
+  MemFileChunkBuffer *buffer_new = static_cast<MemFileChunkBuffer *>(
+      MEM_mallocN(sizeof(MemFileChunkBuffer), __func__));
+  buffer_new->data = static_cast<char *>(MEM_mallocN(size, "Chunk buffer"));
+  memcpy(buffer_new->data, buf, size);
+  buffer_new->size = size;
+  buffer_new->compressed_size = 0;
+  buffer_new->hash = hash;
+  buffer_new->users = 1;
+  buffer_new->generation = memfile->generation;
+  buffer_new->owner = memfile;
+  /* Otherwise this is a hash collision, the buffer is then owned by its chunk only. */
+  buffer_new->is_stored = buffer == nullptr;
+  if (buffer_new->is_stored) {
+    store.buffers.add_new(hash, buffer_new);
+  }
+  memfile->size += size;
+  *r_is_new = true;
+  return buffer_new;
+}
+
 void BLO_memfile_free(MemFile *memfile)
 {
-  while (MemFileChunk *chunk = static_cast<MemFileChunk *>(BLI_pophead(&memfile->chunks))) {
-    if (chunk->is_identical == false) {
-      MEM_freeN((void *)chunk->buf);
+  MemFileChunkStore &store = memfile_chunk_store();
+  TaskPool *pool_to_free = nullptr;
+  {
+    std::lock_guard lock(store.mutex);
+    while (MemFileChunk *chunk = static_cast<MemFileChunk *>(BLI_pophead(&memfile->chunks))) {
+      if (chunk->buffer->owner == memfile) {
+        chunk->buffer->owner = nullptr;
+      }
+      memfile_buffer_release_locked(store, chunk->buffer);
+      MEM_freeN(chunk);
+    }
+    memfile->size = 0;
+    /* Compression tasks keep users on their buffers, so none are left when the store is empty. */
+    if (store.buffers.is_empty()) {
+      pool_to_free = store.compress_pool;
+      store.compress_pool = nullptr;
     }
-    MEM_freeN(chunk);
+  }
+  if (pool_to_free) {
+    BLI_task_pool_free(pool_to_free);
   }
   MEM_delete(memfile->shared_storage);
   memfile->shared_storage = nullptr;
-  memfile->size = 0;
+}
+
+size_t BLO_memfile_size_get(MemFile *memfile)
+{
+  MemFileChunkStore &store = memfile_chunk_store();
+  std::lock_guard lock(store.mutex);
+  return memfile->size;
+}
+
+struct MemFileCompressTask {
+  uint64_t generation;
+  blender::Vector<MemFileChunkBuffer *> buffers;
+};
+
+static void memfile_compress_task_run(TaskPool *__restrict pool, void *taskdata)
+{
+  MemFileCompressTask *task = static_cast<MemFileCompressTask *>(taskdata);
+  MemFileChunkStore &store = memfile_chunk_store();
+
+  for (MemFileChunkBuffer *&buffer : task->buffers) {
+    if (BLI_task_pool_current_canceled(pool)) {
+      break;
+    }
+    /* Uncompressed buffer data is never modified or freed while the task holds a user. */
+    const size_t bound = ZSTD_compressBound(buffer->size);
+    char *compressed = static_cast<char *>(MEM_mallocN(bound, "Chunk buffer compressed"));
+    const size_t compressed_size = ZSTD_compress(
+        compressed, bound, buffer->data, buffer->size, MEMFILE_COMPRESS_LEVEL);
+
+    std::lock_guard lock(store.mutex);
+    /* Only keep the result if it is worth it, and the buffer was not used by a newer step in the
+     * meantime. */
+    if (!ZSTD_isError(compressed_size) && compressed_size < buffer->size - buffer->size / 8 &&
+        buffer->compressed_size == 0 && buffer->generation <= task->generation && buffer->users > 1)
+    {
+      char *compressed_exact = static_cast<char *>(MEM_mallocN(compressed_size, __func__));
+      memcpy(compressed_exact, compressed, compressed_size);
+      MEM_freeN(buffer->data);
+      buffer->data = compressed_exact;
+      buffer->compressed_size = compressed_size;
+      if (buffer->owner) {
+        buffer->owner->size -= buffer->size - compressed_size;
+      }
+    }
+    MEM_freeN(compressed);
+    memfile_buffer_release_locked(store, buffer);
+    buffer = nullptr;
+  }
+}
+
+static void memfile_compress_task_free(TaskPool *__restrict /*pool*/, void *taskdata)
+{
+  MemFileCompressTask *task = static_cast<MemFileCompressTask *>(taskdata);
+  MemFileChunkStore &store = memfile_chunk_store();
+  {
+    /* Release buffers of a canceled task. */
+    std::lock_guard lock(store.mutex);
+    for (MemFileChunkBuffer *buffer : task->buffers) {
+      if (buffer) {
+        memfile_buffer_release_locked(store, buffer);
+      }
+    }
+  }
+  MEM_delete(task);
+}
+
+void BLO_memfile_compress(MemFile *memfile)
+{
+  MemFileChunkStore &store = memfile_chunk_store();
+  MemFileCompressTask *task = MEM_new<MemFileCompressTask>(__func__);
+  task->generation = memfile->generation;
+  {
+    std::lock_guard lock(store.mutex);
+    LISTBASE_FOREACH (MemFileChunk *, chunk, &memfile->chunks) {
+      MemFileChunkBuffer *buffer = chunk->buffer;
+      /* Skip buffers also used by newer steps, and chunks sharing a buffer with the previous one
+       * (the task only needs to hold a single user). */
+      if (buffer->compressed_size != 0 || buffer->size < MEMFILE_COMPRESS_MIN_SIZE ||
+          buffer->generation > memfile->generation ||
+          (!task->buffers.is_empty() && task->buffers.last() == buffer))
+      {
+        continue;
+      }
+      buffer->users++;
+      task->buffers.append(buffer);
+    }
+    if (task->buffers.is_empty()) {
+      MEM_delete(task);
+      return;
+    }
+    if (store.compress_pool == nullptr) {
+      store.compress_pool = BLI_task_pool_create_background_serial(nullptr, TASK_PRIORITY_LOW);
+    }
+  }
+  BLI_task_pool_push(
+      store.compress_pool, memfile_compress_task_run, task, false, memfile_compress_task_free);
+}
+
+/** Make the data of all chunks of \a memfile readable. */
+static void memfile_ensure_uncompressed(MemFile *memfile)
+{
+  MemFileChunkStore &store = memfile_chunk_store();
+  if (store.compress_pool) {
+    /* Pending compression of older steps is not worth delaying undo for. */
+    BLI_task_pool_cancel(store.compress_pool);
+  }
+  std::lock_guard lock(store.mutex);
+  LISTBASE_FOREACH (MemFileChunk *, chunk, &memfile->chunks) {
+    memfile_buffer_decompress_locked(chunk->buffer);
+  }
 }
 
 MemFileSharedStorage::~MemFileSharedStorage()
@@ -61,29 +310,32 @@ MemFileSharedStorage::~MemFileSharedStorage()
 
 void BLO_memfile_merge(MemFile *first, MemFile *second)
 {
-  /* We use this mapping to store the memory buffers from second memfile chunks which are not owned
-   * by it (i.e. shared with some previous memory steps). */
-  blender::Map<const char *, MemFileChunk *> buffer_to_second_memchunk;
+  /* Buffers are reference counted by the chunk store, so freeing the first memfile keeps the ones
+   * still used by the second one. But chunks of the second memfile identical to a chunk that
+   * changed in the first one are not identical to the step before the first one anymore. */
+  blender::Map<const MemFileChunkBuffer *, MemFileChunk *> buffer_to_second_memchunk;
 
-  /* First, detect all memchunks in second memfile that are not owned by it. */
   LISTBASE_FOREACH (MemFileChunk *, sc, &second->chunks) {
-    if (sc->is_identical) {
-      buffer_to_second_memchunk.add(sc->buf, sc);
-    }
+    buffer_to_second_memchunk.add(sc->buffer, sc);
   }
 
-  /* Now, check all chunks from first memfile (the one we are removing), and if a memchunk owned by
-   * it is also used by the second memfile, transfer the ownership. */
-  LISTBASE_FOREACH (MemFileChunk *, fc, &first->chunks) {
-    if (!fc->is_identical) {
-      if (MemFileChunk *sc = buffer_to_second_memchunk.lookup_default(fc->buf, nullptr)) {
-        BLI_assert(sc->is_identical);
+  {
+    MemFileChunkStore &store = memfile_chunk_store();
+    std::lock_guard lock(store.mutex);
+    LISTBASE_FOREACH (MemFileChunk *, fc, &first->chunks) {
+      MemFileChunk *sc = buffer_to_second_memchunk.lookup_default(fc->buffer, nullptr);
+      if (sc == nullptr) {
+        continue;
+      }
+      if (!fc->is_identical) {
         sc->is_identical = false;
-        fc->is_identical = true;
       }
-      /* Note that if the second memfile does not use that chunk, we assume that the first one
-       * fully owns it without sharing it with any other memfile, and hence it should be freed with
-       * it. */
+      MemFileChunkBuffer *buffer = fc->buffer;
+      if (buffer->owner == first) {
+        /* The memory of that buffer is now accounted for by the second memfile. */
+        buffer->owner = second;
+        second->size += buffer->compressed_size ? buffer->compressed_size : buffer->size;
+      }
     }
   }
 
@@ -103,6 +355,11 @@ void BLO_memfile_write_init(MemFileWriteData *mem_data,
 {
   mem_data->written_memfile = written_memfile;
   mem_data->reference_memfile = reference_memfile;
+  {
+    MemFileChunkStore &store = memfile_chunk_store();
+    std::lock_guard lock(store.mutex);
+    written_memfile->generation = ++store.generation_last;
+  }
   mem_data->reference_current_chunk = reference_memfile ? static_cast<MemFileChunk *>(
                                                               reference_memfile->chunks.first) :
                                                           nullptr;
@@ -136,7 +393,7 @@ void BLO_memfile_chunk_add(MemFileWriteData *mem_data, const char *buf, size_t s
   MemFileChunk *curchunk = static_cast<MemFileChunk *>(
       MEM_mallocN(sizeof(MemFileChunk), "MemFileChunk"));
   curchunk->size = size;
-  curchunk->buf = nullptr;
+  curchunk->buffer = nullptr;
   curchunk->is_identical = false;
   /* This is unsafe in the sense that an app handler or other code that does not
    * perform an undo push may make changes after the last undo push that
@@ -145,26 +402,20 @@ void BLO_memfile_chunk_add(MemFileWriteData *mem_data, const char *buf, size_t s
   curchunk->id_session_uid = mem_data->current_id_session_uid;
   BLI_addtail(&memfile->chunks, curchunk);
 
-  /* we compare compchunk with buf */
+  /* Identical data is shared with any existing chunk, not only with the one at the same position
+   * in the previous step. */
+  bool is_new;
+  curchunk->buffer = memfile_chunk_store_add(memfile, buf, size, &is_new);
+
+  /* Identical buffers are shared, so comparing them is enough to detect unchanged data. */
   if (*compchunk_step != nullptr) {
     MemFileChunk *compchunk = *compchunk_step;
-    if (compchunk->size == curchunk->size) {
-      if (memcmp(compchunk->buf, buf, size) == 0) {
-        curchunk->buf = compchunk->buf;
-        curchunk->is_identical = true;
-        compchunk->is_identical_future = true;
-      }
+    if (compchunk->buffer == curchunk->buffer) {
+      curchunk->is_identical = true;
+      compchunk->is_identical_future = true;
     }
     *compchunk_step = static_cast<MemFileChunk *>(compchunk->next);
   }
-
-  /* not equal... */
-  if (curchunk->buf == nullptr) {
-    char *buf_new = static_cast<char *>(MEM_mallocN(size, "Chunk buffer"));
-    memcpy(buf_new, buf, size);
-    curchunk->buf = buf_new;
-    memfile->size += size;
-  }
 }
 
 Main *BLO_memfile_main_get(MemFile *memfile, Main *bmain, Scene **r_scene)
@@ -242,7 +493,7 @@ static int64_t undo_read(FileReader *reader, void *buffer, size_t size)
         readsize = chunk->size - chunkoffset;
       }
 
-      memcpy(POINTER_OFFSET(buffer, totread), chunk->buf + chunkoffset, readsize);
+      memcpy(POINTER_OFFSET(buffer, totread), chunk->buffer->data + chunkoffset, readsize);
       totread += readsize;
       undo->reader.offset += (off64_t)readsize;
       seek += readsize;
@@ -268,6 +519,8 @@ static void undo_close(FileReader *reader)
 
 FileReader *BLO_memfile_new_filereader(MemFile *memfile, int undo_direction)
 {
+  memfile_ensure_uncompressed(memfile);
+
   UndoReader *undo = static_cast<UndoReader *>(MEM_callocN(sizeof(UndoReader), __func__));
 
   undo->memfile = memfile;
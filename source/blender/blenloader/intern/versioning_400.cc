@@ -4346,7 +4346,7 @@ void blo_do_versions_400(FileData *fd, Library * /*lib*/, Main *bmain)
         LISTBASE_FOREACH (SpaceLink *, space_link, &area->spacedata) {
           if (space_link->spacetype == SPACE_NODE) {
             SpaceNode *space_node = reinterpret_cast<SpaceNode *>(space_link);
-            space_node->flag &= ~SNODE_FLAG_UNUSED_5;
+            space_node->flag &= ~SNODE_BACKDRAW_VISIBLE_REGION;
           }
         }
       }
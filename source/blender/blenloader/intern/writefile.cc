@@ -65,6 +65,8 @@
 #include <cstdlib>
 #include <cstring>
 #include <fcntl.h>
+#include <string>
+#include <unordered_map>
 
 #ifdef WIN32
 #  include "BLI_winstuff.h"
@@ -97,6 +99,7 @@
 #include "BLI_math_base.h"
 #include "BLI_mempool.h"
 #include "BLI_set.hh"
+#include "BLI_vector.hh"
 #include "BLI_threads.h"
 
 #include "MEM_guardedalloc.h" /* MEM_freeN */
@@ -130,6 +133,7 @@
 
 #include "readfile.hh"
 
+#include <xxhash.h>
 #include <zstd.h>
 
 /* Make preferences read-only. */
@@ -162,6 +166,58 @@ struct ZstdFrame {
   uint32_t uncompressed_size;
 };
 
+/**
+ * Identifies the uncompressed content of a zstd frame, used by incremental saving to find the
+ * frames that did not change since the previous save.
+ */
+struct ZstdFrameKey {
+  uint64_t hash_low;
+  uint64_t hash_high;
+  uint32_t uncompressed_size;
+
+  friend bool operator==(const ZstdFrameKey &a, const ZstdFrameKey &b)
+  {
+    return a.hash_low == b.hash_low && a.hash_high == b.hash_high &&
+           a.uncompressed_size == b.uncompressed_size;
+  }
+
+  struct Hash {
+    size_t operator()(const ZstdFrameKey &key) const
+    {
+      return size_t(key.hash_low);
+    }
+  };
+};
+
+/** Location of a compressed frame in a saved file. */
+struct ZstdFrameLocation {
+  int64_t compressed_offset;
+  uint32_t compressed_size;
+};
+
+/* Uses the standard allocator, since this outlives any Main and is only freed on exit. */
+using ZstdFrameLocationMap =
+    std::unordered_map<ZstdFrameKey, ZstdFrameLocation, ZstdFrameKey::Hash>;
+
+/**
+ * The frames of the last file written with incremental saving (see the `use_incremental_save`
+ * experimental option). When saving the same file again, frames with identical content are copied
+ * from it instead of being compressed again.
+ */
+struct IncrementalSaveState {
+  std::string filepath;
+  /** Used to detect that the file has been modified or replaced since it was written. */
+  int64_t file_size = 0;
+  int64_t file_mtime = 0;
+  ZstdFrameLocationMap frames;
+};
+
+static IncrementalSaveState &incremental_save_state()
+{
+  static IncrementalSaveState state;
+  return state;
+}
+
 class WriteWrap {
  public:
   virtual bool open(const char *filepath) = 0;
@@ -170,6 +226,16 @@ class WriteWrap {
 
   /** Buffer output (we only want when output isn't already buffered). */
   bool use_buf = true;
+  /**
+   * Flush the buffered output after each ID, like for undo, so that the data of an unchanged ID
+   * is always passed to #write in the same chunks.
+   */
+  bool use_id_chunks = false;
+  /**
+   * The data is only kept in memory and written to disk later (see #BLO_write_file_snapshot), so
+   * the file must not be moved into place yet.
+   */
+  bool is_deferred = false;
 };
 
 class RawWriteWrap : public WriteWrap {
@@ -204,6 +270,45 @@ bool RawWriteWrap::write(const void *buf, size_t buf_len)
   return ::write(file_handle, buf, buf_len) == buf_len;
 }
 
+/** Keeps all written data in memory, to be written to a file later. */
+class MemoryWriteWrap : public WriteWrap {
+ public:
+  struct Chunk {
+    void *data;
+    size_t size;
+  };
+  blender::Vector<Chunk> chunks;
+  size_t total_size = 0;
+
+  MemoryWriteWrap()
+  {
+    is_deferred = true;
+  }
+  ~MemoryWriteWrap()
+  {
+    for (const Chunk &chunk : chunks) {
+      MEM_freeN(chunk.data);
+    }
+  }
+
+  bool open(const char * /*filepath*/) override
+  {
+    return true;
+  }
+  bool close() override
+  {
+    return true;
+  }
+  bool write(const void *buf, size_t buf_len) override
+  {
+    void *data = MEM_mallocN(buf_len, __func__);
+    memcpy(data, buf, buf_len);
+    chunks.append({data, buf_len});
+    total_size += buf_len;
+    return true;
+  }
+};
+
 class ZstdWriteWrap : public WriteWrap {
   WriteWrap &base_wrap;
 
@@ -218,6 +323,17 @@ class ZstdWriteWrap : public WriteWrap {
 
   bool write_error = false;
 
+  /** Incremental saving, see #IncrementalSaveState. */
+  bool use_incremental = false;
+  /** Frames of the previous save of the same file, can be nullptr. */
+  const ZstdFrameLocationMap *reference_frames = nullptr;
+  std::string reference_filepath;
+  int reference_file = -1;
+  ThreadMutex reference_mutex = {};
+  /** Frames written so far, protected by #mutex. */
+  ZstdFrameLocationMap written_frames;
+  int64_t written_size = 0;
+
  public:
   ZstdWriteWrap(WriteWrap &base_wrap) : base_wrap(base_wrap) {}
 
@@ -225,9 +341,19 @@ class ZstdWriteWrap : public WriteWrap {
   bool close() override;
   bool write(const void *buf, size_t buf_len) override;
 
+  /**
+   * Reuse the compressed frames of unchanged data from the previous incremental save of
+   * \a filepath. Must be called before #open.
+   */
+  void incremental_begin(const char *filepath);
+  /** Store the written frames to be reused by the next save, after the file has been moved to
+   * \a filepath. */
+  void incremental_end(const char *filepath, bool success);
+
  private:
   struct ZstdWriteBlockTask;
   void write_task(ZstdWriteBlockTask *task);
+  bool read_reference_frame(const ZstdFrameLocation &location, void *r_buf);
   void write_u32_le(uint32_t val);
   void write_seekable_frames();
 };
@@ -238,6 +364,10 @@ struct ZstdWriteWrap::ZstdWriteBlockTask {
   size_t size;
   int frame_number;
   ZstdWriteWrap *ww;
+  /** Only used for incremental saving. */
+  ZstdFrameKey key;
+  /** Same frame in the previous save, or nullptr if it needs to be compressed. */
+  const ZstdFrameLocation *reference;
 
   static void *write_task(void *userdata)
   {
@@ -247,12 +377,37 @@ struct ZstdWriteWrap::ZstdWriteBlockTask {
   }
 };
 
+bool ZstdWriteWrap::read_reference_frame(const ZstdFrameLocation &location, void *r_buf)
+{
+  BLI_mutex_lock(&reference_mutex);
+  const bool success = BLI_lseek(reference_file, location.compressed_offset, SEEK_SET) ==
+                           location.compressed_offset &&
+                       BLI_read(reference_file, r_buf, location.compressed_size) ==
+                           location.compressed_size;
+  BLI_mutex_unlock(&reference_mutex);
+  return success;
+}
+
 void ZstdWriteWrap::write_task(ZstdWriteBlockTask *task)
 {
-  size_t out_buf_len = ZSTD_compressBound(task->size);
-  void *out_buf = MEM_mallocN(out_buf_len, "Zstd out buffer");
-  size_t out_size = ZSTD_compress(
-      out_buf, out_buf_len, task->data, task->size, ZSTD_COMPRESSION_LEVEL);
+  void *out_buf = nullptr;
+  size_t out_size = 0;
+
+  if (task->reference) {
+    /* Unchanged since the previous save, copy the already compressed data. */
+    out_buf = MEM_mallocN(task->reference->compressed_size, "Zstd out buffer");
+    out_size = task->reference->compressed_size;
+    if (!read_reference_frame(*task->reference, out_buf)) {
+      MEM_freeN(out_buf);
+      out_buf = nullptr;
+    }
+  }
+  if (out_buf == nullptr) {
+    size_t out_buf_len = ZSTD_compressBound(task->size);
+    out_buf = MEM_mallocN(out_buf_len, "Zstd out buffer");
+    out_size = ZSTD_compress(
+        out_buf, out_buf_len, task->data, task->size, ZSTD_COMPRESSION_LEVEL);
+  }
 
   MEM_freeN(task->data);
 
@@ -272,6 +427,12 @@ void ZstdWriteWrap::write_task(ZstdWriteBlockTask *task)
       frameinfo->uncompressed_size = task->size;
       frameinfo->compressed_size = out_size;
       BLI_addtail(&frames, frameinfo);
+
+      if (use_incremental) {
+        written_frames.insert_or_assign(task->key,
+                                        ZstdFrameLocation{written_size, uint32_t(out_size)});
+      }
+      written_size += out_size;
     }
     else {
       write_error = true;
@@ -292,10 +453,18 @@ bool ZstdWriteWrap::open(const char *filepath)
     return false;
   }
 
+  if (reference_frames) {
+    reference_file = BLI_open(reference_filepath.c_str(), O_BINARY | O_RDONLY, 0);
+    if (reference_file == -1) {
+      reference_frames = nullptr;
+    }
+  }
+
   /* Leave one thread open for the main writing logic, unless we only have one HW thread. */
   int num_threads = max_ii(1, BLI_system_thread_count() - 1);
   BLI_threadpool_init(&threadpool, ZstdWriteBlockTask::write_task, num_threads);
   BLI_mutex_init(&mutex);
+  BLI_mutex_init(&reference_mutex);
   BLI_condition_init(&condition);
 
   return true;
@@ -342,12 +511,52 @@ void ZstdWriteWrap::write_seekable_frames()
   write_u32_le(0x8F92EAB1);
 }
 
+void ZstdWriteWrap::incremental_begin(const char *filepath)
+{
+  use_incremental = true;
+  use_id_chunks = true;
+
+  const IncrementalSaveState &state = incremental_save_state();
+  if (state.filepath != filepath) {
+    return;
+  }
+  BLI_stat_t st;
+  if (BLI_stat(filepath, &st) != 0 || int64_t(st.st_size) != state.file_size ||
+      int64_t(st.st_mtime) != state.file_mtime)
+  {
+    return;
+  }
+  reference_frames = &state.frames;
+  reference_filepath = filepath;
+}
+
+void ZstdWriteWrap::incremental_end(const char *filepath, const bool success)
+{
+  IncrementalSaveState &state = incremental_save_state();
+  BLI_stat_t st;
+  if (!success || BLI_stat(filepath, &st) != 0) {
+    /* Keep the previous state, it remains valid as long as its file is unchanged. */
+    return;
+  }
+  state.filepath = filepath;
+  state.file_size = int64_t(st.st_size);
+  state.file_mtime = int64_t(st.st_mtime);
+  state.frames = std::move(written_frames);
+}
+
 bool ZstdWriteWrap::close()
 {
   BLI_threadpool_end(&threadpool);
   BLI_freelistN(&tasks);
 
+  if (reference_file != -1) {
+    ::close(reference_file);
+    reference_file = -1;
+    reference_frames = nullptr;
+  }
+
   BLI_mutex_end(&mutex);
+  BLI_mutex_end(&reference_mutex);
   BLI_condition_end(&condition);
 
   write_seekable_frames();
@@ -369,6 +578,17 @@ bool ZstdWriteWrap::write(const void *buf, size_t buf_len)
   task->size = buf_len;
   task->frame_number = num_frames++;
   task->ww = this;
+  task->reference = nullptr;
+  if (use_incremental) {
+    const XXH128_hash_t hash = XXH3_128bits(buf, buf_len);
+    task->key = {hash.low64, hash.high64, uint32_t(buf_len)};
+    if (reference_frames) {
+      const auto it = reference_frames->find(task->key);
+      if (it != reference_frames->end()) {
+        task->reference = &it->second;
+      }
+    }
+  }
 
   BLI_mutex_lock(&mutex);
   BLI_addtail(&tasks, task);
@@ -680,6 +900,10 @@ static void mywrite_id_end(WriteData *wd, ID * /*id*/)
     mywrite_flush(wd);
     wd->mem.current_id_session_uid = MAIN_ID_SESSION_UID_UNSET;
   }
+  else if (wd->ww->use_id_chunks) {
+    /* Same as for undo, so that an unchanged ID is written in the same chunks as before. */
+    mywrite_flush(wd);
+  }
 
   wd->validation_data.per_id_addresses_set.clear();
   wd->per_id_written_shared_addresses.clear();
@@ -1592,6 +1816,31 @@ static void write_file_main_validate_post(Main *bmain, ReportList *reports)
   }
 }
 
+/**
+ * Replace \a filepath by the successfully written temporary file \a tempname.
+ */
+static bool write_file_move_into_place(const char *tempname,
+                                       const char *filepath,
+                                       const bool use_save_versions,
+                                       ReportList *reports)
+{
+  /* File save to temporary file was successful, now do reverse file history
+   * (move `.blend1` -> `.blend2`, `.blend` -> `.blend1` .. etc). */
+  if (use_save_versions) {
+    if (!do_history(filepath, reports)) {
+      BKE_report(reports, RPT_ERROR, "Version backup failed (file saved with @)");
+      return false;
+    }
+  }
+
+  if (BLI_rename_overwrite(tempname, filepath) != 0) {
+    BKE_report(reports, RPT_ERROR, "Cannot change old file (file saved with @)");
+    return false;
+  }
+
+  return true;
+}
+
 static bool BLO_write_file_impl(Main *mainvar,
                                 const char *filepath,
                                 const int write_flags,
@@ -1731,22 +1980,15 @@ static bool BLO_write_file_impl(Main *mainvar,
 
   if (err) {
     BKE_report(reports, RPT_ERROR, strerror(errno));
-    remove(tempname);
+    if (!ww.is_deferred) {
+      remove(tempname);
+    }
 
     return false;
   }
 
-  /* File save to temporary file was successful, now do reverse file history
-   * (move `.blend1` -> `.blend2`, `.blend` -> `.blend1` .. etc). */
-  if (use_save_versions) {
-    if (!do_history(filepath, reports)) {
-      BKE_report(reports, RPT_ERROR, "Version backup failed (file saved with @)");
-      return false;
-    }
-  }
-
-  if (BLI_rename_overwrite(tempname, filepath) != 0) {
-    BKE_report(reports, RPT_ERROR, "Cannot change old file (file saved with @)");
+  if (!ww.is_deferred && !write_file_move_into_place(tempname, filepath, use_save_versions, reports))
+  {
     return false;
   }
 
@@ -1771,12 +2013,116 @@ bool BLO_write_file(Main *mainvar,
 
   if (write_flags & G_FILE_COMPRESS) {
     ZstdWriteWrap zstd_wrap(raw_wrap);
-    return BLO_write_file_impl(mainvar, filepath, write_flags, params, reports, zstd_wrap);
+    /* Only compressed files benefit from incremental saving, since re-compressing the data of
+     * unchanged IDs is by far the most expensive part of writing them. */
+    const bool use_incremental = USER_EXPERIMENTAL_TEST(&U, use_incremental_save);
+    if (use_incremental) {
+      zstd_wrap.incremental_begin(filepath);
+    }
+    const bool success = BLO_write_file_impl(
+        mainvar, filepath, write_flags, params, reports, zstd_wrap);
+    if (use_incremental) {
+      zstd_wrap.incremental_end(filepath, success);
+    }
+    return success;
   }
 
   return BLO_write_file_impl(mainvar, filepath, write_flags, params, reports, raw_wrap);
 }
 
+struct BlendFileWriteSnapshot {
+  std::string filepath;
+  int write_flags;
+  bool use_save_versions;
+  MemoryWriteWrap data;
+};
+
+BlendFileWriteSnapshot *BLO_write_file_snapshot(Main *mainvar,
+                                                const char *filepath,
+                                                const int write_flags,
+                                                const BlendFileWriteParams *params,
+                                                ReportList *reports)
+{
+  BlendFileWriteSnapshot *snapshot = MEM_new<BlendFileWriteSnapshot>(__func__);
+  snapshot->filepath = filepath;
+  snapshot->write_flags = write_flags;
+  snapshot->use_save_versions = params->use_save_versions;
+  /* Same chunks as when writing directly, see #BLO_write_file. */
+  snapshot->data.use_id_chunks = (write_flags & G_FILE_COMPRESS) &&
+                                 USER_EXPERIMENTAL_TEST(&U, use_incremental_save);
+
+  if (!BLO_write_file_impl(mainvar, filepath, write_flags, params, reports, snapshot->data)) {
+    MEM_delete(snapshot);
+    return nullptr;
+  }
+  return snapshot;
+}
+
+static bool write_file_snapshot_write_impl(BlendFileWriteSnapshot *snapshot,
+                                           ReportList *reports,
+                                           float *r_progress,
+                                           WriteWrap &ww)
+{
+  char tempname[FILE_MAX + 1];
+  SNPRINTF(tempname, "%s@", snapshot->filepath.c_str());
+
+  if (ww.open(tempname) == false) {
+    BKE_reportf(
+        reports, RPT_ERROR, "Cannot open file %s for writing: %s", tempname, strerror(errno));
+    return false;
+  }
+
+  bool success = true;
+  size_t written_size = 0;
+  for (const MemoryWriteWrap::Chunk &chunk : snapshot->data.chunks) {
+    if (!ww.write(chunk.data, chunk.size)) {
+      success = false;
+      break;
+    }
+    written_size += chunk.size;
+    if (r_progress) {
+      *r_progress = float(double(written_size) / double(snapshot->data.total_size));
+    }
+  }
+  success &= ww.close();
+
+  if (!success) {
+    BKE_report(reports, RPT_ERROR, strerror(errno));
+    remove(tempname);
+    return false;
+  }
+
+  return write_file_move_into_place(
+      tempname, snapshot->filepath.c_str(), snapshot->use_save_versions, reports);
+}
+
+bool BLO_write_file_snapshot_write(BlendFileWriteSnapshot *snapshot,
+                                   ReportList *reports,
+                                   float *r_progress)
+{
+  RawWriteWrap raw_wrap;
+
+  if (snapshot->write_flags & G_FILE_COMPRESS) {
+    ZstdWriteWrap zstd_wrap(raw_wrap);
+    const char *filepath = snapshot->filepath.c_str();
+    if (snapshot->data.use_id_chunks) {
+      zstd_wrap.incremental_begin(filepath);
+    }
+    const bool success = write_file_snapshot_write_impl(snapshot, reports, r_progress, zstd_wrap);
+    if (snapshot->data.use_id_chunks) {
+      zstd_wrap.incremental_end(filepath, success);
+    }
+    return success;
+  }
+
+  return write_file_snapshot_write_impl(snapshot, reports, r_progress, raw_wrap);
+}
+
+void BLO_write_file_snapshot_free(BlendFileWriteSnapshot *snapshot)
+{
+  MEM_delete(snapshot);
+}
+
 bool BLO_write_file_mem(Main *mainvar, MemFile *compare, MemFile *current, int write_flags)
 {
   bool use_userdef = false;
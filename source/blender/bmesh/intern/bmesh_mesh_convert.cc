@@ -193,20 +193,23 @@ static Vector<MeshToBMeshLayerInfo> mesh_to_bm_copy_info_calc(const CustomData &
   return infos;
 }
 
-static void mesh_attributes_copy_to_bmesh_block(CustomData &data,
-                                                const Span<MeshToBMeshLayerInfo> copy_info,
+/**
+ * Copy the attribute values of a mesh element to the already allocated block of a BMesh element.
+ * The blocks are allocated separately from a memory pool, which isn't thread-safe, such that the
+ * copies can be done in parallel.
+ */
+static void mesh_attributes_copy_to_bmesh_block(const Span<MeshToBMeshLayerInfo> copy_info,
                                                 const int mesh_index,
-                                                BMHeader &header)
+                                                void *block)
 {
-  CustomData_bmesh_alloc_block(&data, &header.data);
   for (const MeshToBMeshLayerInfo &info : copy_info) {
     if (info.mesh_data) {
       CustomData_data_copy_value(info.type,
                                  POINTER_OFFSET(info.mesh_data, info.elem_size * mesh_index),
-                                 POINTER_OFFSET(header.data, info.bmesh_offset));
+                                 POINTER_OFFSET(block, info.bmesh_offset));
     }
     else {
-      CustomData_data_set_default_value(info.type, POINTER_OFFSET(header.data, info.bmesh_offset));
+      CustomData_data_set_default_value(info.type, POINTER_OFFSET(block, info.bmesh_offset));
     }
   }
 }
@@ -428,42 +431,58 @@ void BM_mesh_bm_from_me(BMesh *bm, const Mesh *mesh, const BMeshFromMeshParams *
   const VArraySpan sharp_edges = *attributes.lookup<bool>("sharp_edge", AttrDomain::Edge);
   const VArraySpan uv_seams = *attributes.lookup<bool>(".uv_seam", AttrDomain::Edge);
 
+  /* Creating the elements and allocating their custom data blocks modifies the shared topology
+   * and memory pools of the BMesh, so it is done serially. Everything else is done in parallel
+   * afterwards. Selection is set last since it depends on the hidden state and updates the
+   * selection counts of the BMesh. */
+
   const Span<float3> positions = mesh->vert_positions();
   Array<BMVert *> vtable(mesh->verts_num);
   for (const int i : positions.index_range()) {
     BMVert *v = vtable[i] = BM_vert_create(
         bm, keyco ? keyco[i] : positions[i], nullptr, BM_CREATE_SKIP_CD);
     BM_elem_index_set(v, i); /* set_ok */
+    CustomData_bmesh_alloc_block(&bm->vdata, &v->head.data);
+  }
+  if (is_new) {
+    bm->elem_index_dirty &= ~BM_VERT; /* Added in order, clear dirty flag. */
+  }
 
-    if (!hide_vert.is_empty() && hide_vert[i]) {
-      BM_elem_flag_enable(v, BM_ELEM_HIDDEN);
-    }
-    if (!select_vert.is_empty() && select_vert[i]) {
-      BM_vert_select_set(bm, v, true);
-    }
+  threading::parallel_for(vtable.index_range(), 1024, [&](const IndexRange range) {
+    for (const int i : range) {
+      BMVert *v = vtable[i];
+      if (!hide_vert.is_empty() && hide_vert[i]) {
+        BM_elem_flag_enable(v, BM_ELEM_HIDDEN);
+      }
 
-    if (!vert_normals.is_empty()) {
-      copy_v3_v3(v->no, vert_normals[i]);
-    }
+      if (!vert_normals.is_empty()) {
+        copy_v3_v3(v->no, vert_normals[i]);
+      }
+
+      mesh_attributes_copy_to_bmesh_block(vert_info, i, v->head.data);
 
-    mesh_attributes_copy_to_bmesh_block(bm->vdata, vert_info, i, v->head);
+      /* Set shape key original index. */
+      if (cd_shape_keyindex_offset != -1) {
+        BM_ELEM_CD_SET_INT(v, cd_shape_keyindex_offset, i);
+      }
 
-    /* Set shape key original index. */
-    if (cd_shape_keyindex_offset != -1) {
-      BM_ELEM_CD_SET_INT(v, cd_shape_keyindex_offset, i);
+      /* Set shape-key data. */
+      if (tot_shape_keys) {
+        float(*co_dst)[3] = (float(*)[3])BM_ELEM_CD_GET_VOID_P(v, cd_shape_key_offset);
+        for (int j = 0; j < tot_shape_keys; j++, co_dst++) {
+          copy_v3_v3(*co_dst, shape_key_table[j][i]);
+        }
+      }
     }
+  });
 
-    /* Set shape-key data. */
-    if (tot_shape_keys) {
-      float(*co_dst)[3] = (float(*)[3])BM_ELEM_CD_GET_VOID_P(v, cd_shape_key_offset);
-      for (int j = 0; j < tot_shape_keys; j++, co_dst++) {
-        copy_v3_v3(*co_dst, shape_key_table[j][i]);
+  if (!select_vert.is_empty()) {
+    for (const int i : vtable.index_range()) {
+      if (select_vert[i]) {
+        BM_vert_select_set(bm, vtable[i], true);
       }
     }
   }
-  if (is_new) {
-    bm->elem_index_dirty &= ~BM_VERT; /* Added in order, clear dirty flag. */
-  }
 
   const Span<blender::int2> edges = mesh->edges();
   Array<BMEdge *> etable(mesh->edges_num);
@@ -471,46 +490,50 @@ void BM_mesh_bm_from_me(BMesh *bm, const Mesh *mesh, const BMeshFromMeshParams *
     BMEdge *e = etable[i] = BM_edge_create(
         bm, vtable[edges[i][0]], vtable[edges[i][1]], nullptr, BM_CREATE_SKIP_CD);
     BM_elem_index_set(e, i); /* set_ok */
-
-    e->head.hflag = 0;
-    if (!uv_seams.is_empty() && uv_seams[i]) {
-      BM_elem_flag_enable(e, BM_ELEM_SEAM);
-    }
-    if (!hide_edge.is_empty() && hide_edge[i]) {
-      BM_elem_flag_enable(e, BM_ELEM_HIDDEN);
-    }
-    if (!select_edge.is_empty() && select_edge[i]) {
-      BM_edge_select_set(bm, e, true);
-    }
-    if (!(!sharp_edges.is_empty() && sharp_edges[i])) {
-      BM_elem_flag_enable(e, BM_ELEM_SMOOTH);
-    }
-
-    mesh_attributes_copy_to_bmesh_block(bm->edata, edge_info, i, e->head);
+    CustomData_bmesh_alloc_block(&bm->edata, &e->head.data);
   }
   if (is_new) {
     bm->elem_index_dirty &= ~BM_EDGE; /* Added in order, clear dirty flag. */
   }
 
+  threading::parallel_for(etable.index_range(), 1024, [&](const IndexRange range) {
+    for (const int i : range) {
+      BMEdge *e = etable[i];
+      e->head.hflag = 0;
+      if (!uv_seams.is_empty() && uv_seams[i]) {
+        BM_elem_flag_enable(e, BM_ELEM_SEAM);
+      }
+      if (!hide_edge.is_empty() && hide_edge[i]) {
+        BM_elem_flag_enable(e, BM_ELEM_HIDDEN);
+      }
+      if (!(!sharp_edges.is_empty() && sharp_edges[i])) {
+        BM_elem_flag_enable(e, BM_ELEM_SMOOTH);
+      }
+
+      mesh_attributes_copy_to_bmesh_block(edge_info, i, e->head.data);
+    }
+  });
+
+  if (!select_edge.is_empty()) {
+    for (const int i : etable.index_range()) {
+      if (select_edge[i]) {
+        BM_edge_select_set(bm, etable[i], true);
+      }
+    }
+  }
+
   const blender::OffsetIndices faces = mesh->faces();
   const Span<int> corner_verts = mesh->corner_verts();
   const Span<int> corner_edges = mesh->corner_edges();
 
-  /* Only needed for selection. */
-
-  Array<BMFace *> ftable;
-  if (mesh->mselect && mesh->totselect != 0) {
-    ftable.reinitialize(mesh->faces_num);
-  }
+  /* Faces that could not be created are null. */
+  Array<BMFace *> ftable(mesh->faces_num);
 
   int totloops = 0;
   for (const int i : faces.index_range()) {
     const IndexRange face = faces[i];
-    BMFace *f = bm_face_create_from_mpoly(
+    BMFace *f = ftable[i] = bm_face_create_from_mpoly(
         *bm, corner_verts.slice(face), corner_edges.slice(face), vtable, etable);
-    if (!ftable.is_empty()) {
-      ftable[i] = f;
-    }
 
     if (UNLIKELY(f == nullptr)) {
       printf(
@@ -524,44 +547,65 @@ void BM_mesh_bm_from_me(BMesh *bm, const Mesh *mesh, const BMeshFromMeshParams *
 
     /* Don't use 'i' since we may have skipped the face. */
     BM_elem_index_set(f, bm->totface - 1); /* set_ok */
+    CustomData_bmesh_alloc_block(&bm->pdata, &f->head.data);
 
-    /* Transfer flag. */
-    if (!(!sharp_faces.is_empty() && sharp_faces[i])) {
-      BM_elem_flag_enable(f, BM_ELEM_SMOOTH);
-    }
-    if (!hide_poly.is_empty() && hide_poly[i]) {
-      BM_elem_flag_enable(f, BM_ELEM_HIDDEN);
-    }
-    if (!select_poly.is_empty() && select_poly[i]) {
-      BM_face_select_set(bm, f, true);
-    }
-
-    f->mat_nr = material_indices.is_empty() ? 0 : material_indices[i];
     if (i == mesh->act_face) {
       bm->act_face = f;
     }
 
-    int j = face.start();
     BMLoop *l_first = BM_FACE_FIRST_LOOP(f);
     BMLoop *l_iter = l_first;
     do {
-      /* Don't use 'j' since we may have skipped some faces, hence some loops. */
+      /* Don't use the mesh corner index since we may have skipped faces, hence loops. */
       BM_elem_index_set(l_iter, totloops++); /* set_ok */
-
-      mesh_attributes_copy_to_bmesh_block(bm->ldata, loop_info, j, l_iter->head);
-      j++;
+      CustomData_bmesh_alloc_block(&bm->ldata, &l_iter->head.data);
     } while ((l_iter = l_iter->next) != l_first);
-
-    mesh_attributes_copy_to_bmesh_block(bm->pdata, poly_info, i, f->head);
-
-    if (params->calc_face_normal) {
-      BM_face_normal_update(f);
-    }
   }
   if (is_new) {
     bm->elem_index_dirty &= ~(BM_FACE | BM_LOOP); /* Added in order, clear dirty flag. */
   }
 
+  threading::parallel_for(ftable.index_range(), 1024, [&](const IndexRange range) {
+    for (const int i : range) {
+      BMFace *f = ftable[i];
+      if (f == nullptr) {
+        continue;
+      }
+
+      /* Transfer flag. */
+      if (!(!sharp_faces.is_empty() && sharp_faces[i])) {
+        BM_elem_flag_enable(f, BM_ELEM_SMOOTH);
+      }
+      if (!hide_poly.is_empty() && hide_poly[i]) {
+        BM_elem_flag_enable(f, BM_ELEM_HIDDEN);
+      }
+
+      f->mat_nr = material_indices.is_empty() ? 0 : material_indices[i];
+
+      int j = faces[i].start();
+      BMLoop *l_first = BM_FACE_FIRST_LOOP(f);
+      BMLoop *l_iter = l_first;
+      do {
+        mesh_attributes_copy_to_bmesh_block(loop_info, j, l_iter->head.data);
+        j++;
+      } while ((l_iter = l_iter->next) != l_first);
+
+      mesh_attributes_copy_to_bmesh_block(poly_info, i, f->head.data);
+
+      if (params->calc_face_normal) {
+        BM_face_normal_update(f);
+      }
+    }
+  });
+
+  if (!select_poly.is_empty()) {
+    for (const int i : ftable.index_range()) {
+      if (select_poly[i] && ftable[i]) {
+        BM_face_select_set(bm, ftable[i], true);
+      }
+    }
+  }
+
   /* -------------------------------------------------------------------- */
   /* MSelect clears the array elements (to avoid adding multiple times).
    *
@@ -0,0 +1,311 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+#include <complex>
+#include <cstring>
+
+#if defined(WITH_FFTW3)
+#  include <fftw3.h>
+#endif
+
+#include "BLI_array.hh"
+#include "BLI_assert.h"
+#include "BLI_fftw.hh"
+#include "BLI_index_range.hh"
+#include "BLI_math_base.hh"
+#include "BLI_math_vector.hh"
+#include "BLI_rect.h"
+#include "BLI_task.hh"
+#include "BLI_utildefines.h"
+
+#include "COM_FFTConvolution.h"
+#include "COM_MemoryBuffer.h"
+
+namespace blender::compositor {
+
+/**
+ * Kernel radius from which an FFT convolution is typically faster than a direct convolution. The
+ * cost of a direct convolution grows with the square of the radius, while the cost of an FFT
+ * convolution mostly depends on the size of the image.
+ */
+static constexpr int MIN_PREFERRED_KERNEL_RADIUS = 8;
+
+FFTConvolution::FFTConvolution(int2 size,
+                               int kernel_radius,
+                               int channels_count,
+                               Boundary boundary)
+    : size_(size),
+      kernel_radius_(kernel_radius),
+      channels_count_(channels_count),
+      boundary_(boundary)
+{
+  /* Since we will be doing a circular convolution, we need to pad the input by the kernel radius
+   * on each side to avoid the kernel affecting the pixels at the other side of the area. */
+  spatial_size_ = fftw::optimal_size_for_real_transform(size + kernel_radius * 2);
+
+  /* The FFTW real to complex transforms utilizes the hermitian symmetry of real transforms and
+   * stores only half the output since the other half is redundant, so we only allocate half of the
+   * first dimension. See Section 4.3.4 Real-data DFT Array Format in the FFTW manual for more
+   * information. */
+  frequency_size_ = int2(spatial_size_.x / 2 + 1, spatial_size_.y);
+
+#if defined(WITH_FFTW3)
+  fftw::initialize_float();
+#endif
+}
+
+FFTConvolution::~FFTConvolution()
+{
+#if defined(WITH_FFTW3)
+  if (kernel_frequency_domain_) {
+    fftwf_free(kernel_frequency_domain_);
+  }
+#endif
+}
+
+bool FFTConvolution::is_supported()
+{
+#if defined(WITH_FFTW3)
+  return true;
+#else
+  return false;
+#endif
+}
+
+bool FFTConvolution::is_preferred(int kernel_radius)
+{
+  return is_supported() && kernel_radius >= MIN_PREFERRED_KERNEL_RADIUS;
+}
+
+void FFTConvolution::set_kernel(FunctionRef<float(int2 offset)> kernel)
+{
+  this->set_kernels(
+      1, [&](const int2 offset, float *r_values) { r_values[0] = kernel(offset); });
+}
+
+void FFTConvolution::set_channel_kernels(FunctionRef<float4(int2 offset)> kernel)
+{
+  BLI_assert(channels_count_ <= 4);
+  this->set_kernels(channels_count_, [&](const int2 offset, float *r_values) {
+    const float4 values = kernel(offset);
+    for (const int i : IndexRange(channels_count_)) {
+      r_values[i] = values[i];
+    }
+  });
+}
+
+void FFTConvolution::set_kernels(int kernels_count,
+                                 FunctionRef<void(int2 offset, float *r_values)> kernel)
+{
+#if defined(WITH_FFTW3)
+  if (kernel_frequency_domain_) {
+    fftwf_free(kernel_frequency_domain_);
+  }
+  kernels_count_ = kernels_count;
+
+  const int64_t spatial_pixels_count = int64_t(spatial_size_.x) * spatial_size_.y;
+  const int64_t frequency_pixels_count = int64_t(frequency_size_.x) * frequency_size_.y;
+
+  float *kernel_spatial_domain = fftwf_alloc_real(spatial_pixels_count * kernels_count);
+  memset(kernel_spatial_domain, 0, sizeof(float) * spatial_pixels_count * kernels_count);
+  kernel_frequency_domain_ = reinterpret_cast<std::complex<float> *>(
+      fftwf_alloc_complex(frequency_pixels_count * kernels_count));
+
+  /* Compute the kernel while zero padding to match the padded spatial size. The kernel gives the
+   * weight of the input pixel at an offset from the output pixel, while a convolution weights the
+   * input pixel at the negated offset, so the kernel is flipped. It is also offset with wrap
+   * around such that it is centered at the zero point, which is the expected format for doing
+   * circular convolutions in the frequency domain. */
+  const int radius = kernel_radius_;
+  const IndexRange kernel_range = IndexRange(radius * 2 + 1);
+  threading::parallel_for(kernel_range, 1, [&](const IndexRange sub_y_range) {
+    Array<float> values(kernels_count);
+    for (const int64_t kernel_y : sub_y_range) {
+      for (const int64_t kernel_x : kernel_range) {
+        const int x = kernel_x - radius;
+        const int y = kernel_y - radius;
+        kernel(int2(x, y), values.data());
+        const int64_t output_x = mod_i(-x, spatial_size_.x);
+        const int64_t output_y = mod_i(-y, spatial_size_.y);
+        const int64_t base_index = output_x + output_y * spatial_size_.x;
+        for (const int i : IndexRange(kernels_count)) {
+          kernel_spatial_domain[base_index + spatial_pixels_count * i] = values[i];
+        }
+      }
+    }
+  });
+
+  /* Use doubles to sum the kernels since floats are not stable for large kernels. */
+  Array<double> sums(kernels_count, 0.0);
+  for (const int i : IndexRange(kernels_count)) {
+    for (const int64_t kernel_y : kernel_range) {
+      for (const int64_t kernel_x : kernel_range) {
+        const int64_t x = mod_i(radius - kernel_x, spatial_size_.x);
+        const int64_t y = mod_i(radius - kernel_y, spatial_size_.y);
+        sums[i] += kernel_spatial_domain[x + y * spatial_size_.x + spatial_pixels_count * i];
+      }
+    }
+  }
+
+  fftwf_plan forward_plan = fftwf_plan_dft_r2c_2d(
+      spatial_size_.y,
+      spatial_size_.x,
+      kernel_spatial_domain,
+      reinterpret_cast<fftwf_complex *>(kernel_frequency_domain_),
+      FFTW_ESTIMATE);
+
+  threading::parallel_for(IndexRange(kernels_count), 1, [&](const IndexRange sub_range) {
+    for (const int64_t i : sub_range) {
+      fftwf_execute_dft_r2c(forward_plan,
+                            kernel_spatial_domain + spatial_pixels_count * i,
+                            reinterpret_cast<fftwf_complex *>(kernel_frequency_domain_) +
+                                frequency_pixels_count * i);
+    }
+  });
+
+  fftwf_destroy_plan(forward_plan);
+  fftwf_free(kernel_spatial_domain);
+
+  /* Normalize the kernels in the frequency domain, which is okay since the Fourier transform is
+   * linear. The FFT is not normalized, meaning the result of the FFT followed by an inverse FFT
+   * will result in an image that is scaled by a factor of the product of the width and height, so
+   * we take that into account by dividing by that scale as well. See Section 4.8.6
+   * Multi-dimensional Transforms of the FFTW manual for more information. */
+  for (const int i : IndexRange(kernels_count)) {
+    const double scale = double(spatial_pixels_count) * sums[i];
+    const float normalization_factor = scale != 0.0 ? float(1.0 / scale) : 0.0f;
+    threading::parallel_for(IndexRange(frequency_pixels_count), 4096, [&](const IndexRange range) {
+      for (const int64_t index : range) {
+        kernel_frequency_domain_[index + frequency_pixels_count * i] *= normalization_factor;
+      }
+    });
+  }
+#else
+  UNUSED_VARS(kernels_count, kernel);
+#endif
+}
+
+void FFTConvolution::execute(const MemoryBuffer &input,
+                             MemoryBuffer &output,
+                             const rcti &area) const
+{
+#if defined(WITH_FFTW3)
+  BLI_assert(kernel_frequency_domain_);
+  BLI_assert(BLI_rcti_size_x(&area) == size_.x && BLI_rcti_size_y(&area) == size_.y);
+  BLI_assert(input.get_num_channels() >= channels_count_);
+
+  const int channels_count = channels_count_;
+  const int64_t spatial_pixels_per_channel = int64_t(spatial_size_.x) * spatial_size_.y;
+  const int64_t frequency_pixels_per_channel = int64_t(frequency_size_.x) * frequency_size_.y;
+  const int64_t spatial_pixels_count = spatial_pixels_per_channel * channels_count;
+  const int64_t frequency_pixels_count = frequency_pixels_per_channel * channels_count;
+
+  float *image_spatial_domain = fftwf_alloc_real(spatial_pixels_count);
+  std::complex<float> *image_frequency_domain = reinterpret_cast<std::complex<float> *>(
+      fftwf_alloc_complex(frequency_pixels_count));
+
+  /* Pad the area of the input by the kernel radius, storing each channel in planar format for
+   * better cache locality, that is, RRRR...GGGG...BBBB. The rest of the spatial domain is never
+   * read by the kernel for the pixels of the area, so it is zero filled. */
+  const rcti &input_rect = input.get_rect();
+  const int2 padded_size = size_ + kernel_radius_ * 2;
+  const int2 padded_origin = int2(area.xmin, area.ymin) - kernel_radius_;
+  threading::parallel_for(IndexRange(spatial_size_.y), 1, [&](const IndexRange sub_y_range) {
+    for (const int64_t y : sub_y_range) {
+      for (const int64_t x : IndexRange(spatial_size_.x)) {
+        const int64_t base_index = x + y * spatial_size_.x;
+        int2 texel = padded_origin + int2(x, y);
+        bool is_zero = x >= padded_size.x || y >= padded_size.y;
+        if (boundary_ == Boundary::Extend) {
+          texel.x = math::clamp(texel.x, input_rect.xmin, input_rect.xmax - 1);
+          texel.y = math::clamp(texel.y, input_rect.ymin, input_rect.ymax - 1);
+        }
+        else {
+          is_zero = is_zero || texel.x < input_rect.xmin || texel.x >= input_rect.xmax ||
+                    texel.y < input_rect.ymin || texel.y >= input_rect.ymax;
+        }
+
+        const float *color = is_zero ? nullptr : input.get_elem(texel.x, texel.y);
+        for (const int64_t channel : IndexRange(channels_count)) {
+          const int64_t output_index = base_index + spatial_pixels_per_channel * channel;
+          image_spatial_domain[output_index] = is_zero ? 0.0f : color[channel];
+        }
+      }
+    }
+  });
+
+  fftwf_plan forward_plan = fftwf_plan_dft_r2c_2d(
+      spatial_size_.y,
+      spatial_size_.x,
+      image_spatial_domain,
+      reinterpret_cast<fftwf_complex *>(image_frequency_domain),
+      FFTW_ESTIMATE);
+
+  threading::parallel_for(IndexRange(channels_count), 1, [&](const IndexRange sub_range) {
+    for (const int64_t channel : sub_range) {
+      fftwf_execute_dft_r2c(forward_plan,
+                            image_spatial_domain + spatial_pixels_per_channel * channel,
+                            reinterpret_cast<fftwf_complex *>(image_frequency_domain) +
+                                frequency_pixels_per_channel * channel);
+    }
+  });
+
+  /* Multiply the kernel and the image in the frequency domain to perform the convolution. The
+   * kernels are already normalized. */
+  threading::parallel_for(IndexRange(frequency_size_.y), 1, [&](const IndexRange sub_y_range) {
+    for (const int64_t channel : IndexRange(channels_count)) {
+      const int64_t kernel_offset = kernels_count_ == 1 ?
+                                        0 :
+                                        frequency_pixels_per_channel * channel;
+      for (const int64_t y : sub_y_range) {
+        for (const int64_t x : IndexRange(frequency_size_.x)) {
+          const int64_t base_index = x + y * frequency_size_.x;
+          const int64_t output_index = base_index + frequency_pixels_per_channel * channel;
+          image_frequency_domain[output_index] *=
+              kernel_frequency_domain_[base_index + kernel_offset];
+        }
+      }
+    }
+  });
+
+  /* Create a complex to real plan to transform the image to the real domain. */
+  fftwf_plan backward_plan = fftwf_plan_dft_c2r_2d(
+      spatial_size_.y,
+      spatial_size_.x,
+      reinterpret_cast<fftwf_complex *>(image_frequency_domain),
+      image_spatial_domain,
+      FFTW_ESTIMATE);
+
+  threading::parallel_for(IndexRange(channels_count), 1, [&](const IndexRange sub_range) {
+    for (const int64_t channel : sub_range) {
+      fftwf_execute_dft_c2r(backward_plan,
+                            reinterpret_cast<fftwf_complex *>(image_frequency_domain) +
+                                frequency_pixels_per_channel * channel,
+                            image_spatial_domain + spatial_pixels_per_channel * channel);
+    }
+  });
+
+  /* Copy the result to the area of the output, skipping the padding. */
+  threading::parallel_for(IndexRange(size_.y), 1, [&](const IndexRange sub_y_range) {
+    for (const int64_t y : sub_y_range) {
+      for (const int64_t x : IndexRange(size_.x)) {
+        float *color = output.get_elem(area.xmin + x, area.ymin + y);
+        const int64_t base_index = (x + kernel_radius_) + (y + kernel_radius_) * spatial_size_.x;
+        for (const int64_t channel : IndexRange(channels_count)) {
+          color[channel] = image_spatial_domain[base_index + spatial_pixels_per_channel * channel];
+        }
+      }
+    }
+  });
+
+  fftwf_destroy_plan(forward_plan);
+  fftwf_destroy_plan(backward_plan);
+  fftwf_free(image_spatial_domain);
+  fftwf_free(image_frequency_domain);
+#else
+  UNUSED_VARS(input, output, area);
+#endif
+}
+
+}  // namespace blender::compositor
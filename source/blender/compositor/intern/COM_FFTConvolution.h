@@ -0,0 +1,109 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+#pragma once
+
+#include <complex>
+
+#include "BLI_function_ref.hh"
+#include "BLI_math_vector_types.hh"
+
+#include "DNA_vec_types.h"
+
+#ifdef WITH_CXX_GUARDEDALLOC
+#  include "MEM_guardedalloc.h"
+#endif
+
+namespace blender::compositor {
+
+class MemoryBuffer;
+
+/**
+ * Convolves images with a constant size kernel in the frequency domain, which has a cost that does
+ * not depend on the kernel size, as opposed to direct convolution whose cost grows with the square
+ * of the kernel radius. It is used by operations with large kernels like the Fog Glow glare and
+ * the bokeh blurs with a constant size.
+ *
+ * The frequency domain of the kernel is computed once when setting the kernel and is then reused
+ * for all channels and all executions. The transforms are multi-threaded.
+ *
+ * The kernel is normalized by the sum of its values, such that the convolution computes a
+ * weighted average of the input. Each convolved channel can have its own kernel.
+ */
+class FFTConvolution {
+ public:
+  /** How input pixels outside of the input buffer are read. */
+  enum class Boundary {
+    /** Zero pixels. */
+    Zero,
+    /** The nearest pixel at the boundary of the input buffer. */
+    Extend,
+  };
+
+ private:
+  int2 size_;
+  int kernel_radius_;
+  int channels_count_;
+  Boundary boundary_;
+
+  /** Size of the zero padded spatial domain, which is an optimal size for the transforms. */
+  int2 spatial_size_;
+  /** Size of the frequency domain, which only stores half the first dimension, see the
+   * implementation for more information. */
+  int2 frequency_size_;
+
+  /**
+   * Frequency domain of the normalized kernel of each channel, stored in planar format. Only
+   * stores a single kernel if all channels share the same kernel.
+   */
+  std::complex<float> *kernel_frequency_domain_ = nullptr;
+  int kernels_count_ = 0;
+
+  void set_kernels(int kernels_count, FunctionRef<void(int2 offset, float *r_values)> kernel);
+
+ public:
+  /**
+   * Prepare the convolution of areas of the given size with kernels of the given radius, that is,
+   * kernels of size 2 * radius + 1. Only the first channels_count channels of the images will be
+   * convolved.
+   */
+  FFTConvolution(int2 size, int kernel_radius, int channels_count, Boundary boundary);
+  ~FFTConvolution();
+
+  /** Whether FFT convolutions are available, that is, Blender was built with FFTW. */
+  static bool is_supported();
+
+  /**
+   * Whether a convolution with a kernel of the given radius should be done in the frequency
+   * domain, that is, FFT convolutions are supported and the kernel is large enough for them to be
+   * faster than a direct convolution.
+   */
+  static bool is_preferred(int kernel_radius);
+
+  /**
+   * Set a kernel shared by all channels, the given function returns the value of the kernel at the
+   * given offset from its center, where offsets are in the [-radius, radius] range. That is the
+   * weight of the input pixel at that offset from the output pixel.
+   */
+  void set_kernel(FunctionRef<float(int2 offset)> kernel);
+
+  /**
+   * Set a kernel for each channel, the given function returns the values of the kernels of the
+   * channels at the given offset from their center, see set_kernel for more information.
+   */
+  void set_channel_kernels(FunctionRef<float4(int2 offset)> kernel);
+
+  /**
+   * Convolve the given input with the kernel, writing the result in the given area of the output.
+   * The size of the area should be the size the convolution was prepared for. Channels of the
+   * output that are not convolved are not written.
+   */
+  void execute(const MemoryBuffer &input, MemoryBuffer &output, const rcti &area) const;
+
+#ifdef WITH_CXX_GUARDEDALLOC
+  MEM_CXX_CLASS_ALLOC_FUNCS("COM:FFTConvolution")
+#endif
+};
+
+}  // namespace blender::compositor
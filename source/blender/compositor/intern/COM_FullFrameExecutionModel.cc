@@ -4,6 +4,7 @@
 
 #include "COM_FullFrameExecutionModel.h"
 
+#include "BLI_set.hh"
 #include "BLI_string.h"
 
 #include "BLT_translation.hh"
@@ -32,6 +33,12 @@ FullFrameExecutionModel::FullFrameExecutionModel(CompositorContext &context,
   priorities_.append(eCompositorPriority::High);
   priorities_.append(eCompositorPriority::Medium);
   priorities_.append(eCompositorPriority::Low);
+
+  /* Follow the precision setting of the compositor, which uses half precision for interactive
+   * compositing when set to auto. */
+  use_half_precision_storage_ = !context.is_rendering() &&
+                                context.get_render_data()->compositor_precision ==
+                                    SCE_COMPOSITOR_PRECISION_AUTO;
 }
 
 void FullFrameExecutionModel::execute(ExecutionSystem &exec_system)
@@ -75,6 +82,9 @@ Vector<MemoryBuffer *> FullFrameExecutionModel::get_input_buffers(NodeOperation
     const int offset_x = (input->get_canvas().xmin - op->get_canvas().xmin) + output_x;
     const int offset_y = (input->get_canvas().ymin - op->get_canvas().ymin) + output_y;
     MemoryBuffer *buf = active_buffers_.get_rendered_buffer(input);
+    if (buf->is_packed()) {
+      buf->unpack();
+    }
 
     rcti rect = buf->get_rect();
     BLI_rcti_translate(&rect, offset_x, offset_y);
@@ -97,6 +107,14 @@ MemoryBuffer *FullFrameExecutionModel::create_operation_buffer(NodeOperation *op
   return new MemoryBuffer(data_type, rect, is_a_single_elem);
 }
 
+static int64_t get_buffer_size_in_bytes(const MemoryBuffer &buffer)
+{
+  if (buffer.is_a_single_elem()) {
+    return buffer.get_elem_bytes_len();
+  }
+  return int64_t(buffer.get_width()) * buffer.get_height() * buffer.get_elem_bytes_len();
+}
+
 void FullFrameExecutionModel::render_operation(NodeOperation *op)
 {
   /* Output has no offset for easier image algorithms implementation on operations. */
@@ -119,6 +137,8 @@ void FullFrameExecutionModel::render_operation(NodeOperation *op)
       delete buf;
     }
   }
+  const int64_t op_buf_size = op_buf ? get_buffer_size_in_bytes(*op_buf) : 0;
+
   /* Even if operation has no resolution set the empty buffer. It will be clipped with a
    * TranslateOperation from convert resolutions if linked to an operation with resolution. */
   active_buffers_.set_rendered_buffer(op, std::unique_ptr<MemoryBuffer>(op_buf));
@@ -126,11 +146,12 @@ void FullFrameExecutionModel::render_operation(NodeOperation *op)
   operation_finished(op);
 
   /* The operation may not come from any node. For example, it may have been added to convert data
-   * type. Do not accumulate time from its execution. */
+   * type. Do not accumulate time and memory from its execution. */
   const timeit::TimePoint after_time = timeit::Clock::now();
   const bNodeInstanceKey node_instance_key = op->get_node_instance_key();
   if (context_.get_profiler() && node_instance_key != bke::NODE_INSTANCE_KEY_NONE) {
     context_.get_profiler()->set_node_evaluation_time(node_instance_key, after_time - before_time);
+    context_.get_profiler()->add_node_memory_usage(node_instance_key, op_buf_size);
   }
 }
 
@@ -157,29 +178,40 @@ void FullFrameExecutionModel::render_operations()
 }
 
 /**
- * Returns all dependencies from inputs to outputs. A dependency may be repeated when
- * several operations depend on it.
+ * Returns all dependencies of the operation ordered from inputs to outputs, without repetitions.
+ *
+ * Dependencies are ordered depth first: every input branch is rendered completely before the next
+ * one is started. Buffers of a branch are disposed as soon as the operations reading them are
+ * rendered, so far fewer intermediate buffers are alive at the same time than when rendering the
+ * operations level by level, which for large trees is what bounds the memory usage.
  */
 static Vector<NodeOperation *> get_operation_dependencies(NodeOperation *operation)
 {
-  /* Get dependencies from outputs to inputs. */
   Vector<NodeOperation *> dependencies;
-  Vector<NodeOperation *> next_outputs;
-  next_outputs.append(operation);
-  while (next_outputs.size() > 0) {
-    Vector<NodeOperation *> outputs(next_outputs);
-    next_outputs.clear();
-    for (NodeOperation *output : outputs) {
-      for (int i = 0; i < output->get_number_of_input_sockets(); i++) {
-        next_outputs.append(output->get_input_operation(i));
+  Set<NodeOperation *> visited;
+  visited.add(operation);
+
+  /* Post-order traversal, with the index of the next input to visit for each operation. */
+  Vector<std::pair<NodeOperation *, int>> stack;
+  stack.append({operation, 0});
+  while (!stack.is_empty()) {
+    NodeOperation *op = stack.last().first;
+    const int input_index = stack.last().second;
+    if (input_index < op->get_number_of_input_sockets()) {
+      stack.last().second++;
+      NodeOperation *input_op = op->get_input_operation(input_index);
+      if (visited.add(input_op)) {
+        stack.append({input_op, 0});
+      }
+    }
+    else {
+      stack.pop_last();
+      if (op != operation) {
+        dependencies.append(op);
       }
     }
-    dependencies.extend(next_outputs);
   }
 
-  /* Reverse to get dependencies from inputs to outputs. */
-  std::reverse(dependencies.begin(), dependencies.end());
-
   return dependencies;
 }
 
@@ -280,10 +312,35 @@ void FullFrameExecutionModel::operation_finished(NodeOperation *operation)
     active_buffers_.read_finished(operation->get_input_operation(i));
   }
 
+  if (use_half_precision_storage_) {
+    for (int i = 0; i < num_inputs; i++) {
+      pack_waiting_buffer(operation->get_input_operation(i));
+    }
+  }
+
   num_operations_finished_++;
   update_progress_bar();
 }
 
+void FullFrameExecutionModel::pack_waiting_buffer(NodeOperation *operation)
+{
+  /* The buffer is disposed if all reads finished. */
+  MemoryBuffer *buffer = active_buffers_.get_rendered_buffer(operation);
+  if (!buffer || buffer->is_packed() || buffer->is_a_single_elem()) {
+    return;
+  }
+
+  /* Only pack color data, since other data types like depth, vectors, and coordinates need full
+   * precision. */
+  if (operation->get_output_socket()->get_data_type() != DataType::Color ||
+      operation->get_flags().use_full_precision_storage)
+  {
+    return;
+  }
+
+  buffer->pack();
+}
+
 void FullFrameExecutionModel::update_progress_bar()
 {
   const bNodeTree *tree = context_.get_bnodetree();
@@ -43,6 +43,12 @@ class FullFrameExecutionModel : public ExecutionModel {
    */
   Vector<eCompositorPriority> priorities_;
 
+  /**
+   * Whether rendered color buffers are packed at half precision while they wait for the next
+   * operation that reads them, see #MemoryBuffer::pack.
+   */
+  bool use_half_precision_storage_;
+
  public:
   FullFrameExecutionModel(CompositorContext &context,
                           SharedOperationBuffers &shared_buffers,
@@ -66,6 +72,11 @@ class FullFrameExecutionModel : public ExecutionModel {
   void render_operation(NodeOperation *op);
 
   void operation_finished(NodeOperation *operation);
+  /**
+   * Pack the buffer of the given operation at half precision if other operations still need to
+   * read it and its data can be stored at half precision.
+   */
+  void pack_waiting_buffer(NodeOperation *operation);
 
   /**
    * Calculates given output operation area to be rendered taking into account viewer and render
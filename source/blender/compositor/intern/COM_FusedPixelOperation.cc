@@ -0,0 +1,107 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+#include <algorithm>
+
+#include "BLI_array.hh"
+
+#include "COM_FusedPixelOperation.h"
+
+namespace blender::compositor {
+
+/** Size of the tiles rendered at once, the intermediate results of a tile should stay cached. */
+static constexpr int TILE_WIDTH = 256;
+static constexpr int TILE_HEIGHT = 16;
+
+FusedPixelOperation::FusedPixelOperation(Vector<MultiThreadedOperation *> operations,
+                                         Vector<Vector<InputSource>> input_sources,
+                                         Span<DataType> input_types)
+    : operations_(std::move(operations)), input_sources_(std::move(input_sources))
+{
+  BLI_assert(operations_.size() == input_sources_.size());
+  for (const DataType data_type : input_types) {
+    this->add_input_socket(data_type);
+  }
+  this->add_output_socket(operations_.last()->get_output_socket()->get_data_type());
+}
+
+FusedPixelOperation::~FusedPixelOperation()
+{
+  for (MultiThreadedOperation *operation : operations_) {
+    delete operation;
+  }
+}
+
+void FusedPixelOperation::init_data()
+{
+  for (MultiThreadedOperation *operation : operations_) {
+    operation->init_data();
+  }
+}
+
+void FusedPixelOperation::init_execution()
+{
+  for (MultiThreadedOperation *operation : operations_) {
+    operation->init_execution();
+  }
+}
+
+void FusedPixelOperation::deinit_execution()
+{
+  for (MultiThreadedOperation *operation : operations_) {
+    operation->deinit_execution();
+  }
+}
+
+std::unique_ptr<MetaData> FusedPixelOperation::get_meta_data()
+{
+  return operations_.last()->get_meta_data();
+}
+
+void FusedPixelOperation::update_memory_buffer_partial(MemoryBuffer *output,
+                                                       const rcti &area,
+                                                       Span<MemoryBuffer *> inputs)
+{
+  const int intermediates_num = operations_.size() - 1;
+
+  /* Storage of the intermediate results, reused for all tiles of the area. */
+  Array<Array<float>> storage(intermediates_num);
+  Array<int> num_channels(intermediates_num);
+  for (const int i : IndexRange(intermediates_num)) {
+    const DataType data_type = operations_[i]->get_output_socket()->get_data_type();
+    num_channels[i] = COM_data_type_num_channels(data_type);
+    storage[i].reinitialize(TILE_WIDTH * TILE_HEIGHT * num_channels[i]);
+  }
+
+  Array<std::unique_ptr<MemoryBuffer>> results(intermediates_num);
+  Vector<MemoryBuffer *> operation_inputs;
+  for (int ymin = area.ymin; ymin < area.ymax; ymin += TILE_HEIGHT) {
+    for (int xmin = area.xmin; xmin < area.xmax; xmin += TILE_WIDTH) {
+      rcti tile;
+      BLI_rcti_init(&tile,
+                    xmin,
+                    std::min(xmin + TILE_WIDTH, area.xmax),
+                    ymin,
+                    std::min(ymin + TILE_HEIGHT, area.ymax));
+
+      for (const int i : operations_.index_range()) {
+        operation_inputs.clear();
+        for (const InputSource &source : input_sources_[i]) {
+          operation_inputs.append(source.operation_index == -1 ?
+                                      inputs[source.input_index] :
+                                      results[source.operation_index].get());
+        }
+
+        MemoryBuffer *operation_output = output;
+        if (i < intermediates_num) {
+          results[i] = std::make_unique<MemoryBuffer>(storage[i].data(), num_channels[i], tile);
+          operation_output = results[i].get();
+        }
+        operations_[i]->update_memory_buffer_area(operation_output, tile, operation_inputs);
+      }
+    }
+  }
+}
+
+}  // namespace blender::compositor
@@ -0,0 +1,54 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+#pragma once
+
+#include "BLI_vector.hh"
+
+#include "COM_MultiThreadedOperation.h"
+
+namespace blender::compositor {
+
+/**
+ * Chain of pixel operations (see #NodeOperationFlags::is_pixel_operation) rendered as a single
+ * operation. Instead of writing a full buffer for each intermediate result, the output area is
+ * split in small tiles and all operations are executed one after the other on each tile. The
+ * intermediate results of a tile stay in the CPU cache and are never stored for the full frame.
+ *
+ * The fused operations are owned by this operation and are not part of the execution system.
+ */
+class FusedPixelOperation : public MultiThreadedOperation {
+ public:
+  /** Buffer read by an input of a fused operation. */
+  struct InputSource {
+    /** Index of the fused operation whose result is read, -1 when reading an external input. */
+    int operation_index;
+    /** Index of the input socket of the fused operation when reading an external input. */
+    int input_index;
+  };
+
+ private:
+  /** Operations in execution order, the last one writes the output. */
+  Vector<MultiThreadedOperation *> operations_;
+  /** Sources of the inputs of each operation. */
+  Vector<Vector<InputSource>> input_sources_;
+
+ public:
+  FusedPixelOperation(Vector<MultiThreadedOperation *> operations,
+                      Vector<Vector<InputSource>> input_sources,
+                      Span<DataType> input_types);
+  ~FusedPixelOperation();
+
+  void init_data() override;
+  void init_execution() override;
+  void deinit_execution() override;
+  std::unique_ptr<MetaData> get_meta_data() override;
+
+ protected:
+  void update_memory_buffer_partial(MemoryBuffer *output,
+                                    const rcti &area,
+                                    Span<MemoryBuffer *> inputs) override;
+};
+
+}  // namespace blender::compositor
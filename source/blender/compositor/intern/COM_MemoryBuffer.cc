@@ -4,6 +4,9 @@
 
 #include "COM_MemoryBuffer.h"
 
+#include "BLI_math_half.hh"
+#include "BLI_task.hh"
+
 #include "IMB_colormanagement.hh"
 #include "IMB_imbuf_types.hh"
 
@@ -157,12 +160,51 @@ float MemoryBuffer::get_max_value(const rcti &rect) const
   return 0.0f;
 }
 
+/* Number of floats converted by each task when packing and unpacking buffers. */
+static constexpr int64_t PACK_GRAIN_SIZE = 1 << 16;
+
+void MemoryBuffer::pack()
+{
+  BLI_assert(owns_data_ && !is_packed());
+
+  const int64_t size = buffer_len() * num_channels_;
+  packed_buffer_ = static_cast<uint16_t *>(
+      MEM_mallocN_aligned(sizeof(uint16_t) * size, 16, "COM_MemoryBuffer packed"));
+  threading::parallel_for(IndexRange(size), PACK_GRAIN_SIZE, [&](const IndexRange range) {
+    math::float_to_half_array(
+        buffer_ + range.start(), packed_buffer_ + range.start(), range.size());
+  });
+
+  MEM_freeN(buffer_);
+  buffer_ = nullptr;
+}
+
+void MemoryBuffer::unpack()
+{
+  BLI_assert(is_packed());
+
+  const int64_t size = buffer_len() * num_channels_;
+  buffer_ = static_cast<float *>(
+      MEM_mallocN_aligned(sizeof(float) * size, 16, "COM_MemoryBuffer"));
+  threading::parallel_for(IndexRange(size), PACK_GRAIN_SIZE, [&](const IndexRange range) {
+    math::half_to_float_array(
+        packed_buffer_ + range.start(), buffer_ + range.start(), range.size());
+  });
+
+  MEM_freeN(packed_buffer_);
+  packed_buffer_ = nullptr;
+}
+
 MemoryBuffer::~MemoryBuffer()
 {
   if (buffer_ && owns_data_) {
     MEM_freeN(buffer_);
     buffer_ = nullptr;
   }
+  if (packed_buffer_) {
+    MEM_freeN(packed_buffer_);
+    packed_buffer_ = nullptr;
+  }
 }
 
 void MemoryBuffer::copy_from(const MemoryBuffer *src, const rcti &area)
@@ -68,6 +68,12 @@ class MemoryBuffer {
    */
   float *buffer_;
 
+  /**
+   * Half float copy of the data while the buffer is packed, in which case the float data is freed.
+   * See #pack.
+   */
+  uint16_t *packed_buffer_ = nullptr;
+
   /**
    * \brief the number of channels of a single value in the buffer.
    * For value buffers this is 1, vector 3 and color 4
@@ -375,6 +381,24 @@ class MemoryBuffer {
    */
   MemoryBuffer *inflate() const;
 
+  /**
+   * Store the data at half float precision and free the float data, reducing the memory used by
+   * the buffer while it is not accessed, for instance, while it waits for the next operation that
+   * reads it. The buffer must be unpacked before being accessed again. Only supported for buffers
+   * owning their data.
+   */
+  void pack();
+
+  /**
+   * Restore the float data of a packed buffer from its half float copy.
+   */
+  void unpack();
+
+  bool is_packed() const
+  {
+    return packed_buffer_ != nullptr;
+  }
+
   inline void wrap_pixel(float &x,
                          float &y,
                          MemoryBufferExtend extend_x,
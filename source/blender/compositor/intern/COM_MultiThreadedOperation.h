@@ -19,6 +19,18 @@ class MultiThreadedOperation : public NodeOperation {
    */
   int current_pass_;
 
+ public:
+  /**
+   * Executes the operation on an area of an output buffer in the calling thread. Used to render
+   * fused pixel operations, see #FusedPixelOperation.
+   */
+  void update_memory_buffer_area(MemoryBuffer *output,
+                                 const rcti &area,
+                                 Span<MemoryBuffer *> inputs)
+  {
+    update_memory_buffer_partial(output, area, inputs);
+  }
+
  protected:
   MultiThreadedOperation();
 
@@ -206,6 +206,21 @@ struct NodeOperationFlags {
    */
   bool can_be_constant : 1;
 
+  /**
+   * Whether output pixels only depend on the input pixels at the same coordinates and are
+   * rendered in a single pass, without started/finished callbacks. Such operations can be fused
+   * with the pixel operations reading them, see #FusedPixelOperation.
+   */
+  bool is_pixel_operation : 1;
+
+  /**
+   * Whether the output buffer of the operation should always be stored at full precision, even
+   * when buffers waiting to be read are packed at half precision, see #MemoryBuffer::pack. Set
+   * for operations that can output data which is not a color in color buffers, like render passes
+   * and image layers, which can store cryptomatte hashes or motion vectors.
+   */
+  bool use_full_precision_storage : 1;
+
   NodeOperationFlags()
   {
     use_render_border = false;
@@ -217,6 +232,8 @@ struct NodeOperationFlags {
     use_datatype_conversion = true;
     is_constant_operation = false;
     can_be_constant = false;
+    is_pixel_operation = false;
+    use_full_precision_storage = false;
   }
 };
 
@@ -5,11 +5,13 @@
 #include <set>
 
 #include "BLI_multi_value_map.hh"
+#include "BLI_set.hh"
 
 #include "BKE_node_runtime.hh"
 
 #include "COM_Converter.h"
 #include "COM_Debug.h"
+#include "COM_FusedPixelOperation.h"
 
 #include "COM_PreviewOperation.h"
 #include "COM_SetColorOperation.h"
@@ -90,6 +92,8 @@ void NodeOperationBuilder::convert_to_operations(ExecutionSystem *system)
   save_graphviz("compositor_prior_merging");
   merge_equal_operations();
 
+  fuse_pixel_operations();
+
   /* links not available from here on */
   /* XXX make links_ a local variable to avoid confusion! */
   links_.clear();
@@ -493,6 +497,116 @@ void NodeOperationBuilder::merge_equal_operations(NodeOperation *from, NodeOpera
   delete from;
 }
 
+static bool is_fusable_pixel_operation(const NodeOperation *operation, const bool is_rendering)
+{
+  const NodeOperationFlags flags = operation->get_flags();
+  return flags.is_pixel_operation && !flags.is_constant_operation &&
+         operation->get_number_of_output_sockets() == 1 &&
+         !operation->is_output_operation(is_rendering) &&
+         dynamic_cast<const MultiThreadedOperation *>(operation) != nullptr;
+}
+
+void NodeOperationBuilder::fuse_pixel_operations()
+{
+  const bool is_rendering = context_->is_rendering();
+
+  MultiValueMap<NodeOperation *, NodeOperationInput *> readers;
+  for (const Link &link : links_) {
+    readers.add(&link.from()->get_operation(), link.to());
+  }
+
+  /* An operation is fused into its reader when its result is only read by it. */
+  auto fuses_into_reader = [&](NodeOperation *operation) {
+    if (!is_fusable_pixel_operation(operation, is_rendering)) {
+      return false;
+    }
+    const Span<NodeOperationInput *> operation_readers = readers.lookup(operation);
+    if (operation_readers.size() != 1) {
+      return false;
+    }
+    NodeOperation *reader = &operation_readers.first()->get_operation();
+    return is_fusable_pixel_operation(reader, is_rendering) &&
+           BLI_rcti_compare(&operation->get_canvas(), &reader->get_canvas());
+  };
+
+  const Vector<NodeOperation *> operations = operations_;
+  for (NodeOperation *root : operations) {
+    if (!is_fusable_pixel_operation(root, is_rendering) || fuses_into_reader(root)) {
+      continue;
+    }
+
+    /* Gather the operations fused into the root, inputs before the operations reading them. */
+    Vector<MultiThreadedOperation *> group;
+    Map<NodeOperation *, int> group_indices;
+    auto gather = [&](auto &&gather, NodeOperation *operation) -> void {
+      for (const int i : IndexRange(operation->get_number_of_input_sockets())) {
+        NodeOperation *input_operation = operation->get_input_operation(i);
+        if (input_operation && !group_indices.contains(input_operation) &&
+            fuses_into_reader(input_operation))
+        {
+          gather(gather, input_operation);
+        }
+      }
+      group_indices.add_new(operation, group.size());
+      group.append(static_cast<MultiThreadedOperation *>(operation));
+    };
+    gather(gather, root);
+    if (group.size() < 2) {
+      continue;
+    }
+
+    Vector<Vector<FusedPixelOperation::InputSource>> input_sources;
+    Vector<NodeOperationOutput *> external_outputs;
+    Vector<DataType> external_types;
+    for (MultiThreadedOperation *operation : group) {
+      input_sources.append({});
+      Vector<FusedPixelOperation::InputSource> &sources = input_sources.last();
+      for (const int i : IndexRange(operation->get_number_of_input_sockets())) {
+        NodeOperationInput *input = operation->get_input_socket(i);
+        NodeOperationOutput *output = input->get_link();
+        BLI_assert(output != nullptr);
+        const int *operation_index = group_indices.lookup_ptr(&output->get_operation());
+        if (operation_index) {
+          sources.append({*operation_index, -1});
+          continue;
+        }
+        int input_index = external_outputs.first_index_of_try(output);
+        if (input_index == -1) {
+          input_index = external_outputs.append_and_get_index(output);
+          external_types.append(input->get_data_type());
+        }
+        sources.append({-1, input_index});
+      }
+    }
+
+    FusedPixelOperation *fused_operation = new FusedPixelOperation(
+        group, std::move(input_sources), external_types);
+    fused_operation->set_name(root->get_name());
+    fused_operation->set_node_instance_key(root->get_node_instance_key());
+    fused_operation->set_canvas(root->get_canvas());
+    add_operation(fused_operation);
+
+    /* Links inside the group are kept on the fused operations sockets but are removed from the
+     * builder, the fused operation provides the buffers of its operations itself. */
+    links_.remove_if([&](const Link &link) {
+      return group_indices.contains(&link.to()->get_operation());
+    });
+    for (Link &link : links_) {
+      if (&link.from()->get_operation() == root) {
+        link.to()->set_link(fused_operation->get_output_socket());
+        link = Link(fused_operation->get_output_socket(), link.to());
+      }
+    }
+    for (const int i : external_outputs.index_range()) {
+      add_link(external_outputs[i], fused_operation->get_input_socket(i));
+    }
+
+    for (MultiThreadedOperation *operation : group) {
+      operations_.remove_first_occurrence_and_reorder(operation);
+    }
+  }
+}
+
 Vector<NodeOperationInput *> NodeOperationBuilder::cache_output_links(
     NodeOperationOutput *output) const
 {
@@ -5,8 +5,11 @@
 #include "BLI_math_vector.h"
 #include "BLI_math_vector.hh"
 
+#include "BLI_rect.h"
+
 #include "COM_BokehBlurOperation.h"
 #include "COM_ConstantOperation.h"
+#include "COM_FFTConvolution.h"
 
 namespace blender::compositor {
 
@@ -29,6 +32,7 @@ BokehBlurOperation::BokehBlurOperation()
   sizeavailable_ = false;
 
   extend_bounds_ = false;
+  is_fft_convolved_ = false;
 }
 
 void BokehBlurOperation::init_data()
@@ -96,6 +100,42 @@ void BokehBlurOperation::get_area_of_interest(const int input_idx,
   }
 }
 
+/* Get the weight of the pixel at the given offset from the center of a kernel of the given
+ * radius. */
+static float4 get_bokeh_weight(const MemoryBuffer *bokeh_input, int2 offset, int radius)
+{
+  const int2 bokeh_size = int2(bokeh_input->get_width(), bokeh_input->get_height());
+  const float2 normalized_texel = (float2(offset) + radius + 0.5f) / (radius * 2.0f + 1.0f);
+  const float2 weight_texel = (1.0f - normalized_texel) * float2(bokeh_size - 1);
+  return bokeh_input->get_elem(int(weight_texel.x), int(weight_texel.y));
+}
+
+void BokehBlurOperation::update_memory_buffer_started(MemoryBuffer *output,
+                                                      const rcti &area,
+                                                      Span<MemoryBuffer *> inputs)
+{
+  const float max_dim = std::max(this->get_width(), this->get_height());
+  const int radius = size_ * max_dim / 100.0f;
+
+  /* The blur has a constant size, so large blurs are faster to compute for the whole area at once
+   * in the frequency domain. The pixels outside of the bounding box are then overwritten in
+   * update_memory_buffer_partial. */
+  const MemoryBuffer *image_input = inputs[IMAGE_INPUT_INDEX];
+  is_fft_convolved_ = !image_input->is_a_single_elem() && FFTConvolution::is_preferred(radius);
+  if (!is_fft_convolved_) {
+    return;
+  }
+
+  const MemoryBuffer *bokeh_input = inputs[BOKEH_INPUT_INDEX];
+  FFTConvolution convolution(int2(BLI_rcti_size_x(&area), BLI_rcti_size_y(&area)),
+                             radius,
+                             output->get_num_channels(),
+                             FFTConvolution::Boundary::Extend);
+  convolution.set_channel_kernels(
+      [&](const int2 offset) { return get_bokeh_weight(bokeh_input, offset, radius); });
+  convolution.execute(*image_input, *output, area);
+}
+
 void BokehBlurOperation::update_memory_buffer_partial(MemoryBuffer *output,
                                                       const rcti &area,
                                                       Span<MemoryBuffer *> inputs)
@@ -105,7 +145,6 @@ void BokehBlurOperation::update_memory_buffer_partial(MemoryBuffer *output,
 
   const MemoryBuffer *image_input = inputs[IMAGE_INPUT_INDEX];
   const MemoryBuffer *bokeh_input = inputs[BOKEH_INPUT_INDEX];
-  const int2 bokeh_size = int2(bokeh_input->get_width(), bokeh_input->get_height());
   MemoryBuffer *bounding_input = inputs[BOUNDING_BOX_INPUT_INDEX];
   BuffersIterator<float> it = output->iterate_with({bounding_input}, area);
   for (; !it.is_end(); ++it) {
@@ -117,13 +156,15 @@ void BokehBlurOperation::update_memory_buffer_partial(MemoryBuffer *output,
       continue;
     }
 
+    if (is_fft_convolved_) {
+      continue;
+    }
+
     float4 accumulated_color = float4(0.0f);
     float4 accumulated_weight = float4(0.0f);
     for (int yi = -radius; yi <= radius; ++yi) {
       for (int xi = -radius; xi <= radius; ++xi) {
-        const float2 normalized_texel = (float2(xi, yi) + radius + 0.5f) / (radius * 2.0f + 1.0f);
-        const float2 weight_texel = (1.0f - normalized_texel) * float2(bokeh_size - 1);
-        const float4 weight = bokeh_input->get_elem(int(weight_texel.x), int(weight_texel.y));
+        const float4 weight = get_bokeh_weight(bokeh_input, int2(xi, yi), radius);
         const float4 color = float4(image_input->get_elem_clamped(x + xi, y + yi)) * weight;
         accumulated_color += color;
         accumulated_weight += weight;
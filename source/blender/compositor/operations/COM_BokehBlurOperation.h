@@ -16,6 +16,9 @@ class BokehBlurOperation : public MultiThreadedOperation {
 
   bool extend_bounds_;
 
+  /** Whether the output was already convolved in the frequency domain, see #FFTConvolution. */
+  bool is_fft_convolved_;
+
  public:
   BokehBlurOperation();
 
@@ -35,6 +38,9 @@ class BokehBlurOperation : public MultiThreadedOperation {
   void determine_canvas(const rcti &preferred_area, rcti &r_area) override;
 
   void get_area_of_interest(int input_idx, const rcti &output_area, rcti &r_input_area) override;
+  void update_memory_buffer_started(MemoryBuffer *output,
+                                    const rcti &area,
+                                    Span<MemoryBuffer *> inputs) override;
   void update_memory_buffer_partial(MemoryBuffer *output,
                                     const rcti &area,
                                     Span<MemoryBuffer *> inputs) override;
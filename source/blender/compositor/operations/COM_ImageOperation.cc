@@ -22,6 +22,7 @@ BaseImageOperation::BaseImageOperation()
   number_of_channels_ = 0;
   rd_ = nullptr;
   view_name_ = nullptr;
+  flags_.use_full_precision_storage = true;
 }
 ImageOperation::ImageOperation() : BaseImageOperation()
 {
@@ -23,6 +23,7 @@ RenderLayersProg::RenderLayersProg(const char *pass_name, DataType type, int ele
   layer_buffer_ = nullptr;
 
   this->add_output_socket(type);
+  flags_.use_full_precision_storage = true;
 }
 
 void RenderLayersProg::init_execution()
@@ -4,7 +4,9 @@
 
 #include "BLI_math_base.hh"
 #include "BLI_math_vector.hh"
+#include "BLI_rect.h"
 
+#include "COM_FFTConvolution.h"
 #include "COM_VariableSizeBokehBlurOperation.h"
 
 namespace blender::compositor {
@@ -25,6 +27,7 @@ VariableSizeBokehBlurOperation::VariableSizeBokehBlurOperation()
   max_blur_ = 32.0f;
   threshold_ = 1.0f;
   do_size_scale_ = false;
+  is_fft_convolved_ = false;
 }
 
 struct VariableSizeBokehBlurTileData {
@@ -70,6 +73,59 @@ void VariableSizeBokehBlurOperation::get_area_of_interest(const int input_idx,
   }
 }
 
+/* Get the weight of the pixel at the given offset from the center of a bokeh of the given size.
+ * The weight is zero if the pixel is outside of the bokeh. */
+static float4 get_bokeh_weight(MemoryBuffer *bokeh_buffer, int2 offset, float size)
+{
+  if (math::max(math::abs(offset.x), math::abs(offset.y)) > size) {
+    return float4(0.0f);
+  }
+
+  const float2 normalized_texel = (float2(offset) + size + 0.5f) / (size * 2.0f + 1.0f);
+  const float2 weight_texel = 1.0f - normalized_texel;
+  return bokeh_buffer->texture_bilinear_extend(weight_texel);
+}
+
+void VariableSizeBokehBlurOperation::update_memory_buffer_started(MemoryBuffer *output,
+                                                                  const rcti &area,
+                                                                  Span<MemoryBuffer *> inputs)
+{
+  MemoryBuffer *input_buffer = inputs[0];
+  MemoryBuffer *bokeh_buffer = inputs[1];
+  MemoryBuffer *size_buffer = inputs[2];
+
+  /* If the size is constant, like in the Defocus node without a Z input, the blur is a convolution
+   * with a constant kernel, so large blurs are faster to compute for the whole area at once in the
+   * frequency domain. The pixels outside of the bounding box are then overwritten and the
+   * threshold blending is applied in update_memory_buffer_partial. */
+  is_fft_convolved_ = false;
+  if (input_buffer->is_a_single_elem() || !size_buffer->is_a_single_elem()) {
+    return;
+  }
+
+  const float max_dim = std::max(get_width(), get_height());
+  const float base_size = do_size_scale_ ? (max_dim / 100.0f) : 1.0f;
+  const float size = math::max(0.0f, *size_buffer->get_elem(0, 0) * base_size);
+  const int search_radius = math::clamp(int(size), 0, max_blur_);
+  if (size < threshold_ || !FFTConvolution::is_preferred(search_radius)) {
+    return;
+  }
+
+  FFTConvolution convolution(int2(BLI_rcti_size_x(&area), BLI_rcti_size_y(&area)),
+                             search_radius,
+                             output->get_num_channels(),
+                             FFTConvolution::Boundary::Extend);
+  convolution.set_channel_kernels([&](const int2 offset) {
+    /* The center pixel always has a unit weight. */
+    if (offset == int2(0)) {
+      return float4(1.0f);
+    }
+    return get_bokeh_weight(bokeh_buffer, offset, size);
+  });
+  convolution.execute(*input_buffer, *output, area);
+  is_fft_convolved_ = true;
+}
+
 void VariableSizeBokehBlurOperation::update_memory_buffer_partial(MemoryBuffer *output,
                                                                   const rcti &area,
                                                                   Span<MemoryBuffer *> inputs)
@@ -93,33 +149,35 @@ void VariableSizeBokehBlurOperation::update_memory_buffer_partial(MemoryBuffer *
 
     const float center_size = math::max(0.0f, *size_buffer->get_elem(it.x, it.y) * base_size);
 
-    float4 accumulated_color = float4(input_buffer->get_elem(it.x, it.y));
-    float4 accumulated_weight = float4(1.0f);
-    if (center_size >= threshold_) {
-      for (int yi = -search_radius; yi <= search_radius; ++yi) {
-        for (int xi = -search_radius; xi <= search_radius; ++xi) {
-          if (xi == 0 && yi == 0) {
-            continue;
-          }
-          const float candidate_size = math::max(
-              0.0f, *size_buffer->get_elem_clamped(it.x + xi, it.y + yi) * base_size);
-          const float size = math::min(center_size, candidate_size);
-          if (size < threshold_ || math::max(math::abs(xi), math::abs(yi)) > size) {
-            continue;
+    /* The output was already convolved if the size is constant, see
+     * update_memory_buffer_started. */
+    if (!is_fft_convolved_) {
+      float4 accumulated_color = float4(input_buffer->get_elem(it.x, it.y));
+      float4 accumulated_weight = float4(1.0f);
+      if (center_size >= threshold_) {
+        for (int yi = -search_radius; yi <= search_radius; ++yi) {
+          for (int xi = -search_radius; xi <= search_radius; ++xi) {
+            if (xi == 0 && yi == 0) {
+              continue;
+            }
+            const float candidate_size = math::max(
+                0.0f, *size_buffer->get_elem_clamped(it.x + xi, it.y + yi) * base_size);
+            const float size = math::min(center_size, candidate_size);
+            if (size < threshold_ || math::max(math::abs(xi), math::abs(yi)) > size) {
+              continue;
+            }
+
+            const float4 weight = get_bokeh_weight(bokeh_buffer, int2(xi, yi), size);
+            const float4 color = input_buffer->get_elem_clamped(it.x + xi, it.y + yi);
+            accumulated_color += color * weight;
+            accumulated_weight += weight;
           }
-
-          const float2 normalized_texel = (float2(xi, yi) + size + 0.5f) / (size * 2.0f + 1.0f);
-          const float2 weight_texel = 1.0f - normalized_texel;
-          const float4 weight = bokeh_buffer->texture_bilinear_extend(weight_texel);
-          const float4 color = input_buffer->get_elem_clamped(it.x + xi, it.y + yi);
-          accumulated_color += color * weight;
-          accumulated_weight += weight;
         }
       }
-    }
 
-    const float4 final_color = math::safe_divide(accumulated_color, accumulated_weight);
-    copy_v4_v4(it.out, final_color);
+      const float4 final_color = math::safe_divide(accumulated_color, accumulated_weight);
+      copy_v4_v4(it.out, final_color);
+    }
 
     /* blend in out values over the threshold, otherwise we get sharp, ugly transitions */
     if ((center_size > threshold_) && (center_size < threshold_ * 2.0f)) {
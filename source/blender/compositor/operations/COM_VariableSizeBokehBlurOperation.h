@@ -24,6 +24,10 @@ class VariableSizeBokehBlurOperation : public MultiThreadedOperation {
   float threshold_;
   bool do_size_scale_; /* scale size, matching 'BokehBlurNode' */
 
+  /** Whether the output was already convolved in the frequency domain, which is possible when the
+   * size is constant, see #FFTConvolution. */
+  bool is_fft_convolved_;
+
  public:
   VariableSizeBokehBlurOperation();
 
@@ -43,6 +47,9 @@ class VariableSizeBokehBlurOperation : public MultiThreadedOperation {
   }
 
   void get_area_of_interest(int input_idx, const rcti &output_area, rcti &r_input_area) override;
+  void update_memory_buffer_started(MemoryBuffer *output,
+                                    const rcti &area,
+                                    Span<MemoryBuffer *> inputs) override;
   void update_memory_buffer_partial(MemoryBuffer *output,
                                     const rcti &area,
                                     Span<MemoryBuffer *> inputs) override;
@@ -136,6 +136,16 @@ class Context {
    * executing as soon as possible. */
   virtual bool is_canceled() const;
 
+  /* Returns true if the results of node operations should be cached across evaluations, such that
+   * only the nodes that changed or depend on changed nodes are executed. See the
+   * CachedNodeResults class for more information. Defaults to false. */
+  virtual bool use_node_results_cache() const;
+
+  /* Returns true if the textures returned by get_input_texture are known to be unchanged since
+   * the last evaluation, in which case, cached results of nodes that depend on them can be used.
+   * Defaults to false. */
+  virtual bool are_input_textures_unchanged() const;
+
   /* Resets the context's internal structures like texture pool and cache manager. This should be
    * called before every evaluation. */
   void reset();
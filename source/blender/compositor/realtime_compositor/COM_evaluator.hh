@@ -4,8 +4,10 @@
 
 #pragma once
 
+#include <cstdint>
 #include <memory>
 
+#include "BLI_map.hh"
 #include "BLI_vector.hh"
 
 #include "DNA_node_types.h"
@@ -99,9 +101,26 @@ using namespace nodes::derived_node_tree_types;
  * unit. Node 5 is then added to the now empty compile unit similar to node 3. Node 6 is not a
  * pixel node, so the compile unit is considered complete and is compiled first, adding the first
  * pixel operation to the operations stream and resetting the compile unit. Finally, node 6 is
- * compiled into a node operation similar to nodes 1 and 2 and added to the operations stream. */
+ * compiled into a node operation similar to nodes 1 and 2 and added to the operations stream.
+ *
+ * During compilation, a hash is computed for every node from its parameters and the hashes of the
+ * nodes it depends on. The hashes are stable across compilations, so they are used to identify
+ * the results of node operations in the node results cache, which allows reusing the results of
+ * nodes that didn't change when the node tree is edited, see the CachedNodeResults class. */
 class Evaluator {
  private:
+  /* The hash of a node as computed by the compute_node_hash method. */
+  struct NodeHash {
+    uint64_t value;
+    /* False if the node or one of the nodes it depends on uses data that can change without the
+     * node tree changing, like images, so their results can't be cached. */
+    bool is_cacheable;
+    /* True if the node or one of the nodes it depends on uses the input textures of the context,
+     * whose contents are not part of the hash. */
+    bool uses_input_textures;
+  };
+
+
   /* A reference to the compositor context. */
   Context &context_;
   /* A derived node tree representing the compositor node tree. This is constructed when the node
@@ -117,6 +136,8 @@ class Evaluator {
   /* True if the node tree is already compiled into an operations stream that can be evaluated
    * directly. False if the node tree is not compiled yet and needs to be compiled. */
   bool is_compiled_ = false;
+  /* The hashes of the nodes that were compiled so far, see the compute_node_hash method. */
+  Map<DNode, NodeHash> node_hashes_;
 
  public:
   /* Construct an evaluator from a context. */
@@ -145,6 +166,11 @@ class Evaluator {
   /* Compile the node tree into an operations stream and evaluate it. */
   void compile_and_evaluate();
 
+  /* Compute the hash of the given node from its type, parameters, and unlinked input values as
+   * well as the hashes of the nodes linked to its inputs, which are assumed to be already computed
+   * since nodes are compiled in schedule order. */
+  void compute_node_hash(DNode node);
+
   /* Compile the given node into a node operation, map each input to the result of the output
    * linked to it, update the compile state, add the newly created operation to the operations
    * stream, and evaluate the operation. */
@@ -4,6 +4,9 @@
 
 #pragma once
 
+#include <cstdint>
+#include <optional>
+
 #include "BLI_string_ref.hh"
 
 #include "DNA_node_types.h"
@@ -32,6 +35,13 @@ class NodeOperation : public Operation {
  private:
   /* The node that this operation represents. */
   DNode node_;
+  /* A hash that identifies the node, its parameters, and the nodes it depends on, used to cache
+   * the results of the operation across evaluations. If not set, the results are not cached. See
+   * the set_results_hash method. */
+  std::optional<uint64_t> results_hash_;
+  /* True if the results depend on the input textures of the context, whose contents are not part
+   * of the results hash. */
+  bool uses_input_textures_ = false;
 
  public:
   /* Populate the output results based on the node outputs and populate the input descriptors based
@@ -48,10 +58,23 @@ class NodeOperation : public Operation {
    * output corresponding to each result. The node execution schedule is given as an input. */
   void compute_results_reference_counts(const Schedule &schedule);
 
+  /* Set the hash identifying the results of the operation, which allows caching them across
+   * evaluations if the context supports it. The uses_input_textures argument should be true if
+   * the results depend on the input textures of the context, in which case, they will only be
+   * loaded from the cache if the context reports those textures as unchanged. */
+  void set_results_hash(uint64_t hash, bool uses_input_textures);
+
  protected:
   /* Compute a node preview using the result returned from the get_preview_result method. */
   void compute_preview() override;
 
+  /* Pass the results cached in the cached node results with the results hash through to the
+   * results of the operation if available. */
+  bool load_cached_results() override;
+
+  /* Store copies of the computed results in the cached node results with the results hash. */
+  void cache_results() override;
+
   /* Returns a reference to the derived node that this operation represents. */
   const DNode &node() const;
 
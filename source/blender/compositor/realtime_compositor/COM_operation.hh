@@ -51,8 +51,9 @@ using ProcessorsVector = Vector<std::unique_ptr<SimpleOperation>>;
  *
  * The operation is evaluated by calling the evaluate method, which first adds the input processors
  * if they weren't added already and evaluates them, then it resets the results of the operation,
- * then it calls the execute method of the operation, and finally it releases the results mapped to
- * the inputs to declare that they are no longer needed. */
+ * then it calls the execute method of the operation unless its results could be loaded from the
+ * cache, and finally it releases the results mapped to the inputs to declare that they are no
+ * longer needed. */
 class Operation {
  private:
   /* A reference to the compositor context. This member references the same object in all
@@ -92,7 +93,8 @@ class Operation {
   /* Evaluate the operation by:
    * 1. Evaluating the input processors.
    * 2. Resetting the results of the operation.
-   * 3. Calling the execute method of the operation.
+   * 3. Loading the cached results of the operation if available, otherwise, calling the execute
+   *    method of the operation and caching its results.
    * 4. Releasing the results mapped to the inputs. */
   virtual void evaluate();
 
@@ -133,6 +135,17 @@ class Operation {
    * implementation and should be implemented by operations which can have previews. */
   virtual void compute_preview();
 
+  /* Set the results of the operation from results cached in a previous evaluation and return
+   * true if they are available, in which case, the execute method will not be called. This method
+   * defaults to an implementation that returns false and should be implemented by operations
+   * whose results can be cached. */
+  virtual bool load_cached_results();
+
+  /* Cache the results of the operation after it was executed, such that they can be loaded by the
+   * load_cached_results method in later evaluations. This method defaults to an empty
+   * implementation and should be implemented by operations whose results can be cached. */
+  virtual void cache_results();
+
   /* Get a reference to the result connected to the input identified by the given identifier. */
   Result &get_input(StringRef identifier) const;
 
@@ -4,6 +4,8 @@
 
 #pragma once
 
+#include <cstdint>
+
 #include "BLI_map.hh"
 #include "BLI_timeit.hh"
 
@@ -19,7 +21,8 @@ class Context;
  * Profiler
  *
  * A class that profiles the evaluation of the compositor and tracks information like the
- * evaluation time of every node. */
+ * evaluation time and the memory usage of every node. It is used by both the CPU and the GPU
+ * compositor. */
 class Profiler {
  private:
   /* Stores the evaluation time of each node instance keyed by its instance key. Note that
@@ -28,22 +31,28 @@ class Profiler {
    * evaluation time of each individual node. */
   Map<bNodeInstanceKey, timeit::Nanoseconds> nodes_evaluation_times_;
 
+  /* Stores the size in bytes of the buffers allocated for the results of each node instance keyed
+   * by its instance key. Like evaluation times, pixel-wise nodes that are compiled together are
+   * not measured. */
+  Map<bNodeInstanceKey, int64_t> nodes_memory_usages_;
+
  public:
   /* Returns a reference to the nodes evaluation times. */
   Map<bNodeInstanceKey, timeit::Nanoseconds> &get_nodes_evaluation_times();
 
+  /* Returns a reference to the nodes memory usages in bytes. */
+  Map<bNodeInstanceKey, int64_t> &get_nodes_memory_usages();
+
   /* Set the evaluation time of the node identified by the given node instance key. */
   void set_node_evaluation_time(bNodeInstanceKey node_instance_key, timeit::Nanoseconds time);
 
-  /* Finalize profiling by computing node group times. This should be called after evaluation. */
-  void finalize(const bNodeTree &node_tree);
+  /* Add the given size in bytes of a buffer allocated by the node identified by the given node
+   * instance key to its memory usage. */
+  void add_node_memory_usage(bNodeInstanceKey node_instance_key, int64_t size);
 
- private:
-  /* Computes the evaluation time of every group node inside the given tree recursively by
-   * accumulating the evaluation time of its nodes, setting the computed time to the group nodes.
-   * The time is returned since the method is called recursively. */
-  timeit::Nanoseconds accumulate_node_group_times(const bNodeTree &node_tree,
-                                                  bNodeInstanceKey instance_key);
+  /* Finalize profiling by computing node group times and memory usages. This should be called
+   * after evaluation. */
+  void finalize(const bNodeTree &node_tree);
 };
 
 }  // namespace blender::realtime_compositor
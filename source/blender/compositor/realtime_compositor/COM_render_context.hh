@@ -13,6 +13,7 @@
 #include "DNA_scene_types.h"
 
 struct RenderResult;
+struct TaskPool;
 
 namespace blender::realtime_compositor {
 
@@ -45,6 +46,11 @@ class FileOutput {
   RenderResult *render_result_;
   bool save_as_render_;
   Map<std::string, std::string> meta_data_;
+  /* A copy of the render settings of the scene as well as the image format resolved against the
+   * color management settings of the scene. Those are set in the prepare_save method and are what
+   * the write method uses, such that the scene need not be accessed while writing. */
+  Scene *write_scene_ = nullptr;
+  ImageFormatData write_format_;
 
  public:
   /* Allocate and initialize the internal render result of the file output using the give
@@ -54,7 +60,7 @@ class FileOutput {
              int2 size,
              bool save_as_render);
 
-  /* Free the internal render result. */
+  /* Free the internal render result as well as the data set by the prepare_save method. */
   ~FileOutput();
 
   /* Add an empty view with the given name. An empty view is just structure and does not hold any
@@ -76,8 +82,18 @@ class FileOutput {
   /* Add meta data that will eventually be saved to the file if the format supports it. */
   void add_meta_data(std::string key, std::string value);
 
+  /* Add the scene stamp data and the meta data to the render result and copy the settings of the
+   * scene that are needed to write the file. This should be called on the thread that evaluates
+   * the scene. */
+  void prepare_save(Scene *scene);
+
+  /* Write the file to the path, reporting any reports to the standard output. The prepare_save
+   * method should be called first. This does not access the scene, so it can be called in a
+   * different thread while the scene is evaluated for another frame. */
+  void write();
+
   /* Save the file to the path along with its meta data, reporting any reports to the standard
-   * output. */
+   * output. This is the same as calling prepare_save followed by write. */
   void save(Scene *scene);
 };
 
@@ -115,8 +131,13 @@ class RenderContext {
 
   /* Write the file outputs that were added to the context. The render pipeline code should call
    * this method after all views were evaluated to write the file outputs. See the get_file_output
-   * method for more information. */
-  void save_file_outputs(Scene *scene);
+   * method for more information.
+   *
+   * If a task pool is given, the file outputs are only prepared in the calling thread and are then
+   * moved out of the context and written in tasks of the pool, which take ownership of them. This
+   * is used by animation renders to write the file outputs of a frame while the next frame is
+   * being rendered and composited. The caller should wait for the pool before freeing it. */
+  void save_file_outputs(Scene *scene, TaskPool *task_pool = nullptr);
 };
 
 }  // namespace blender::realtime_compositor
@@ -213,9 +213,10 @@ class Result {
   void allocate_texture(Domain domain, bool from_pool = true);
 
   /* Declare the result to be a single value result, allocate a texture of an appropriate type with
-   * size 1x1 from the texture pool, and set the domain to be an identity domain. See class
-   * description for more information. */
-  void allocate_single_value();
+   * size 1x1, and set the domain to be an identity domain. See class description for more
+   * information. The texture is allocated from the texture pool unless from_pool is false, which
+   * should only be the case for persistent results, see allocate_texture(). */
+  void allocate_single_value(bool from_pool = true);
 
   /* Allocate a single value result and set its value to zero. This is called for results whose
    * value can't be computed and are considered invalid. */
@@ -362,6 +363,13 @@ class Result {
   /* Returns a reference to the domain of the result. See the Domain class. */
   const Domain &domain() const;
 
+  /* Computes the number of channels of the result based on its type. */
+  int64_t channels_count() const;
+
+  /* Computes the size in bytes of the texture of the result. Zero is returned if the result is not
+   * allocated or if it is a proxy result, since it shares the texture of its master result. */
+  int64_t size_in_bytes() const;
+
   /* Returns a reference to the allocate float data. */
   float *float_texture();
 
@@ -382,9 +390,6 @@ class Result {
    * context. See the allocate_texture method for information about the from_pool argument. */
   void allocate_data(int2 size, bool from_pool);
 
-  /* Computes the number of channels of the result based on its type. */
-  int64_t channels_count() const;
-
   /* Get a pointer to the float pixel at the given texel position. */
   float *get_float_pixel(const int2 &texel) const;
 
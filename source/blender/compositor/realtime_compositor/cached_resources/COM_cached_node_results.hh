@@ -0,0 +1,82 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "BLI_map.hh"
+#include "BLI_string_ref.hh"
+
+#include "DNA_vec_types.h"
+
+#include "COM_cached_resource.hh"
+#include "COM_result.hh"
+
+namespace blender::realtime_compositor {
+
+class Context;
+
+/* ------------------------------------------------------------------------------------------------
+ * Cached Node Results Key.
+ *
+ * Identifies the results of a node operation. The node hash identifies the node, its parameters,
+ * and the nodes it depends on, see Evaluator::compute_node_hash. The rest of the members are the
+ * context properties that affect the results of all nodes. */
+class CachedNodeResultsKey {
+ public:
+  uint64_t node_hash;
+  int frame_number;
+  rcti compositing_region;
+  ResultPrecision precision;
+
+  CachedNodeResultsKey(uint64_t node_hash, const Context &context);
+
+  uint64_t hash() const;
+};
+
+bool operator==(const CachedNodeResultsKey &a, const CachedNodeResultsKey &b);
+
+/* -------------------------------------------------------------------------------------------------
+ * Cached Node Results.
+ *
+ * A cached resource that stores copies of the results of a node operation, such that the node
+ * operation need not be executed again in later evaluations if neither the node nor the nodes it
+ * depends on changed. This is useful for interactive editing, where changing a node should only
+ * execute the nodes that depend on it. */
+class CachedNodeResults : public CachedResource {
+ public:
+  /* The copied results identified by the identifiers of their outputs. */
+  Map<std::string, Result> results;
+
+ public:
+  ~CachedNodeResults();
+
+  /* Store a persistent copy of the given result identified by the given output identifier. */
+  void add(Context &context, StringRef identifier, Result &result);
+};
+
+/* ------------------------------------------------------------------------------------------------
+ * Cached Node Results Container.
+ */
+class CachedNodeResultsContainer : CachedResourceContainer {
+ private:
+  Map<CachedNodeResultsKey, std::unique_ptr<CachedNodeResults>> map_;
+
+ public:
+  void reset() override;
+
+  /* Check if there are available cached node results with the given key in the container, if
+   * they exist, tag them as needed and return them, otherwise, return nullptr. */
+  CachedNodeResults *get(const CachedNodeResultsKey &key);
+
+  /* Add empty cached node results with the given key to the container, replacing any existing
+   * ones, tag them as needed and return them. The results should then be added by calling the
+   * CachedNodeResults::add method. */
+  CachedNodeResults &add(const CachedNodeResultsKey &key);
+};
+
+}  // namespace blender::realtime_compositor
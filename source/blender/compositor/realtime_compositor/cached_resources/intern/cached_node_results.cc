@@ -0,0 +1,146 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+#include <cstdint>
+#include <cstring>
+#include <memory>
+
+#include "BLI_hash.hh"
+#include "BLI_math_vector_types.hh"
+#include "BLI_rect.h"
+
+#include "GPU_texture.hh"
+
+#include "COM_cached_node_results.hh"
+#include "COM_context.hh"
+#include "COM_result.hh"
+
+namespace blender::realtime_compositor {
+
+/* --------------------------------------------------------------------
+ * Cached Node Results Key.
+ */
+
+CachedNodeResultsKey::CachedNodeResultsKey(uint64_t node_hash, const Context &context)
+    : node_hash(node_hash),
+      frame_number(context.get_frame_number()),
+      compositing_region(context.get_compositing_region()),
+      precision(context.get_precision())
+{
+}
+
+uint64_t CachedNodeResultsKey::hash() const
+{
+  return get_default_hash(node_hash,
+                          frame_number,
+                          int4(compositing_region.xmin,
+                               compositing_region.xmax,
+                               compositing_region.ymin,
+                               compositing_region.ymax),
+                          int(precision));
+}
+
+bool operator==(const CachedNodeResultsKey &a, const CachedNodeResultsKey &b)
+{
+  return a.node_hash == b.node_hash && a.frame_number == b.frame_number &&
+         BLI_rcti_compare(&a.compositing_region, &b.compositing_region) &&
+         a.precision == b.precision;
+}
+
+/* --------------------------------------------------------------------
+ * Cached Node Results.
+ */
+
+CachedNodeResults::~CachedNodeResults()
+{
+  for (Result &result : this->results.values()) {
+    result.release();
+  }
+}
+
+static void copy_single_value(const Result &source, Result &target)
+{
+  switch (source.type()) {
+    case ResultType::Float:
+      target.set_float_value(source.get_float_value());
+      break;
+    case ResultType::Vector:
+      target.set_vector_value(source.get_vector_value());
+      break;
+    case ResultType::Color:
+      target.set_color_value(source.get_color_value());
+      break;
+    case ResultType::Float2:
+      target.set_float2_value(source.get_float2_value());
+      break;
+    case ResultType::Float3:
+      target.set_float3_value(source.get_float3_value());
+      break;
+    case ResultType::Int2:
+      target.set_int2_value(source.get_int2_value());
+      break;
+  }
+}
+
+void CachedNodeResults::add(Context &context, StringRef identifier, Result &result)
+{
+  /* The copy is persistent, so it should not be allocated from the texture pool. */
+  Result copy = context.create_result(result.type(), result.precision());
+  if (result.is_single_value()) {
+    copy.allocate_single_value(false);
+    copy_single_value(result, copy);
+  }
+  else {
+    copy.allocate_texture(result.domain(), false);
+    if (context.use_gpu()) {
+      GPU_texture_copy(copy, result);
+    }
+    else {
+      const int2 size = result.domain().size;
+      std::memcpy(copy.float_texture(),
+                  result.float_texture(),
+                  sizeof(float) * size.x * size.y * result.channels_count());
+    }
+  }
+  copy.meta_data = result.meta_data;
+
+  this->results.add_new(identifier, copy);
+}
+
+/* --------------------------------------------------------------------
+ * Cached Node Results Container.
+ */
+
+void CachedNodeResultsContainer::reset()
+{
+  /* First, delete all cached node results that are no longer needed. */
+  map_.remove_if([](auto item) { return !item.value->needed; });
+
+  /* Second, reset the needed status of the remaining cached node results to false to ready them
+   * to track their needed status for the next evaluation. */
+  for (auto &value : map_.values()) {
+    value->needed = false;
+  }
+}
+
+CachedNodeResults *CachedNodeResultsContainer::get(const CachedNodeResultsKey &key)
+{
+  std::unique_ptr<CachedNodeResults> *cached_node_results = map_.lookup_ptr(key);
+  if (!cached_node_results) {
+    return nullptr;
+  }
+
+  (*cached_node_results)->needed = true;
+  return cached_node_results->get();
+}
+
+CachedNodeResults &CachedNodeResultsContainer::add(const CachedNodeResultsKey &key)
+{
+  std::unique_ptr<CachedNodeResults> &cached_node_results = map_.lookup_or_add_default(key);
+  cached_node_results = std::make_unique<CachedNodeResults>();
+  cached_node_results->needed = true;
+  return *cached_node_results;
+}
+
+}  // namespace blender::realtime_compositor
@@ -49,6 +49,16 @@ bool Context::is_canceled() const
   return this->get_node_tree().runtime->test_break(get_node_tree().runtime->tbh);
 }
 
+bool Context::use_node_results_cache() const
+{
+  return false;
+}
+
+bool Context::are_input_textures_unchanged() const
+{
+  return false;
+}
+
 void Context::reset()
 {
   texture_pool_.reset();
@@ -4,6 +4,15 @@
 
 #include <string>
 
+#include "MEM_guardedalloc.h"
+
+#include "BLI_hash.hh"
+#include "BLI_hash_mm2a.hh"
+#include "BLI_listbase.h"
+#include "BLI_math_vector_types.hh"
+
+#include "DNA_ID.h"
+#include "DNA_color_types.h"
 #include "DNA_node_types.h"
 
 #include "NOD_derived_node_tree.hh"
@@ -50,6 +59,7 @@ void Evaluator::evaluate()
 void Evaluator::reset()
 {
   operations_stream_.clear();
+  node_hashes_.clear();
   derived_node_tree_.reset();
 
   is_compiled_ = false;
@@ -95,6 +105,8 @@ void Evaluator::compile_and_evaluate()
       return;
     }
 
+    compute_node_hash(node);
+
     if (compile_state.should_compile_pixel_compile_unit(node)) {
       compile_and_evaluate_pixel_compile_unit(compile_state);
     }
@@ -110,6 +122,113 @@ void Evaluator::compile_and_evaluate()
   is_compiled_ = true;
 }
 
+static uint64_t hash_allocated_memory(const void *data)
+{
+  return BLI_hash_mm2(static_cast<const uchar *>(data), MEM_allocN_len(data), 0);
+}
+
+/* The curve points are stored in separately allocated arrays, so hash their values as opposed to
+ * their pointers. */
+static uint64_t hash_curve_mapping(const CurveMapping &curve_mapping)
+{
+  uint64_t hash = get_default_hash(curve_mapping.flag, curve_mapping.preset, curve_mapping.tone);
+  hash = get_default_hash(hash,
+                          float4(curve_mapping.clipr.xmin,
+                                 curve_mapping.clipr.xmax,
+                                 curve_mapping.clipr.ymin,
+                                 curve_mapping.clipr.ymax),
+                          float3(curve_mapping.black),
+                          float3(curve_mapping.white));
+  for (const CurveMap &curve_map : curve_mapping.cm) {
+    hash = get_default_hash(hash,
+                            BLI_hash_mm2(reinterpret_cast<const uchar *>(curve_map.curve),
+                                         sizeof(CurveMapPoint) * curve_map.totpoint,
+                                         0));
+  }
+  return hash;
+}
+
+/* The matte entries are stored in a list, so hash their values as opposed to their pointers. */
+static uint64_t hash_cryptomatte(const NodeCryptomatte &cryptomatte)
+{
+  uint64_t hash = get_default_hash(StringRef(cryptomatte.layer_name));
+  LISTBASE_FOREACH (const CryptomatteEntry *, entry, &cryptomatte.entries) {
+    hash = get_default_hash(hash, StringRef(entry->name), entry->encoded_hash);
+  }
+  return hash;
+}
+
+static uint64_t hash_node_storage(const bNode &node)
+{
+  if (STREQ(node.typeinfo->storagename, "CurveMapping")) {
+    return hash_curve_mapping(*static_cast<const CurveMapping *>(node.storage));
+  }
+  if (STREQ(node.typeinfo->storagename, "NodeCryptomatte")) {
+    return hash_cryptomatte(*static_cast<const NodeCryptomatte *>(node.storage));
+  }
+  return hash_allocated_memory(node.storage);
+}
+
+void Evaluator::compute_node_hash(DNode node)
+{
+  NodeHash node_hash;
+  /* Output nodes have no results to cache. */
+  node_hash.is_cacheable = !node->output_sockets().is_empty();
+  node_hash.uses_input_textures = false;
+
+  /* Images, masks, movie clips, and textures can change without the node tree changing. Scenes
+   * are used to read render passes, which are the input textures of the context. */
+  if (node->id) {
+    if (GS(node->id->name) == ID_SCE) {
+      node_hash.uses_input_textures = true;
+    }
+    else {
+      node_hash.is_cacheable = false;
+    }
+  }
+
+  /* The node tree is copied for every change, so only identifiers and values are hashed, never
+   * pointers. */
+  uint64_t hash = get_default_hash(StringRef(node->idname), node->identifier, node->is_muted());
+  for (const DTreeContext *context = node.context(); context->parent_node();
+       context = context->parent_context())
+  {
+    hash = get_default_hash(hash, context->parent_node()->identifier);
+  }
+  hash = get_default_hash(
+      hash, int2(node->custom1, node->custom2), float2(node->custom3, node->custom4));
+  if (node->storage) {
+    hash = get_default_hash(hash, hash_node_storage(*node));
+  }
+  if (node->id) {
+    hash = get_default_hash(hash, StringRef(node->id->name));
+  }
+
+  for (const bNodeSocket *input : node->input_sockets()) {
+    const DInputSocket dinput{node.context(), input};
+    const DSocket dorigin = get_input_origin_socket(dinput);
+
+    if (dorigin->is_output()) {
+      const NodeHash *origin_hash = node_hashes_.lookup_ptr(dorigin.node());
+      if (!origin_hash) {
+        node_hash.is_cacheable = false;
+        continue;
+      }
+      node_hash.is_cacheable &= origin_hash->is_cacheable;
+      node_hash.uses_input_textures |= origin_hash->uses_input_textures;
+      hash = get_default_hash(hash, origin_hash->value, StringRef(dorigin->identifier));
+      continue;
+    }
+
+    if (dorigin->default_value) {
+      hash = get_default_hash(hash, hash_allocated_memory(dorigin->default_value));
+    }
+  }
+
+  node_hash.value = hash;
+  node_hashes_.add_overwrite(node, node_hash);
+}
+
 void Evaluator::compile_and_evaluate_node(DNode node, CompileState &compile_state)
 {
   NodeOperation *operation = node->typeinfo->get_compositor_operation(context_, node);
@@ -125,6 +244,11 @@ void Evaluator::compile_and_evaluate_node(DNode node, CompileState &compile_stat
 
   operation->compute_results_reference_counts(compile_state.get_schedule());
 
+  const NodeHash &node_hash = node_hashes_.lookup(node);
+  if (node_hash.is_cacheable) {
+    operation->set_results_hash(node_hash.value, node_hash.uses_input_textures);
+  }
+
   operation->evaluate();
 }
 
@@ -23,12 +23,14 @@
 
 #include "BKE_node.hh"
 
+#include "COM_cached_node_results.hh"
 #include "COM_context.hh"
 #include "COM_input_descriptor.hh"
 #include "COM_node_operation.hh"
 #include "COM_operation.hh"
 #include "COM_result.hh"
 #include "COM_scheduler.hh"
+#include "COM_static_cache_manager.hh"
 #include "COM_utilities.hh"
 
 namespace blender::realtime_compositor {
@@ -53,8 +55,17 @@ void NodeOperation::evaluate()
   const timeit::TimePoint before_time = timeit::Clock::now();
   Operation::evaluate();
   const timeit::TimePoint after_time = timeit::Clock::now();
-  if (context().profiler()) {
-    context().profiler()->set_node_evaluation_time(node_.instance_key(), after_time - before_time);
+  if (!context().profiler()) {
+    return;
+  }
+
+  context().profiler()->set_node_evaluation_time(node_.instance_key(), after_time - before_time);
+
+  /* The results that are used by other operations are still allocated at this point, so their
+   * sizes can be measured. */
+  for (const bNodeSocket *output : node()->output_sockets()) {
+    context().profiler()->add_node_memory_usage(node_.instance_key(),
+                                                get_result(output->identifier).size_in_bytes());
   }
 }
 
@@ -99,6 +110,69 @@ void NodeOperation::compute_results_reference_counts(const Schedule &schedule)
   }
 }
 
+void NodeOperation::set_results_hash(uint64_t hash, bool uses_input_textures)
+{
+  results_hash_ = hash;
+  uses_input_textures_ = uses_input_textures;
+}
+
+bool NodeOperation::load_cached_results()
+{
+  if (!results_hash_ || !context().use_node_results_cache()) {
+    return false;
+  }
+
+  if (uses_input_textures_ && !context().are_input_textures_unchanged()) {
+    return false;
+  }
+
+  CachedNodeResults *cached_node_results = context().cache_manager().cached_node_results.get(
+      CachedNodeResultsKey(*results_hash_, context()));
+  if (!cached_node_results) {
+    return false;
+  }
+
+  /* The results were cached when other outputs were needed, so they can't be used. */
+  for (const bNodeSocket *output : this->node()->output_sockets()) {
+    if (should_compute_output(output->identifier) &&
+        !cached_node_results->results.contains(output->identifier))
+    {
+      return false;
+    }
+  }
+
+  for (const bNodeSocket *output : this->node()->output_sockets()) {
+    if (should_compute_output(output->identifier)) {
+      cached_node_results->results.lookup(output->identifier)
+          .pass_through(get_result(output->identifier));
+    }
+  }
+
+  return true;
+}
+
+void NodeOperation::cache_results()
+{
+  if (!results_hash_ || !context().use_node_results_cache()) {
+    return;
+  }
+
+  /* Avoid copying the results in every evaluation while the input textures are changing, for
+   * instance, while navigating the viewport, by only caching them once the textures are stable. */
+  if (uses_input_textures_ && !context().are_input_textures_unchanged()) {
+    return;
+  }
+
+  CachedNodeResults &cached_node_results = context().cache_manager().cached_node_results.add(
+      CachedNodeResultsKey(*results_hash_, context()));
+  for (const bNodeSocket *output : this->node()->output_sockets()) {
+    Result &result = get_result(output->identifier);
+    if (result.should_compute() && result.is_allocated()) {
+      cached_node_results.add(context(), output->identifier, result);
+    }
+  }
+}
+
 const DNode &NodeOperation::node() const
 {
   return node_;
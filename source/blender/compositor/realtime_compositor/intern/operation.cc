@@ -32,7 +32,10 @@ void Operation::evaluate()
 
   reset_results();
 
-  execute();
+  if (!load_cached_results()) {
+    execute();
+    cache_results();
+  }
 
   compute_preview();
 
@@ -141,6 +144,13 @@ void Operation::add_and_evaluate_input_processor(StringRef identifier, SimpleOpe
 
 void Operation::compute_preview(){};
 
+bool Operation::load_cached_results()
+{
+  return false;
+}
+
+void Operation::cache_results() {}
+
 Result &Operation::get_input(StringRef identifier) const
 {
   return *results_mapped_to_inputs_.lookup(identifier);
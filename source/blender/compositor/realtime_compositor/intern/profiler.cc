@@ -20,27 +20,41 @@ Map<bNodeInstanceKey, timeit::Nanoseconds> &Profiler::get_nodes_evaluation_times
   return nodes_evaluation_times_;
 }
 
+Map<bNodeInstanceKey, int64_t> &Profiler::get_nodes_memory_usages()
+{
+  return nodes_memory_usages_;
+}
+
 void Profiler::set_node_evaluation_time(bNodeInstanceKey node_instance_key,
                                         timeit::Nanoseconds time)
 {
   nodes_evaluation_times_.lookup_or_add(node_instance_key, timeit::Nanoseconds::zero()) += time;
 }
 
-timeit::Nanoseconds Profiler::accumulate_node_group_times(const bNodeTree &node_tree,
-                                                          bNodeInstanceKey instance_key)
+void Profiler::add_node_memory_usage(bNodeInstanceKey node_instance_key, int64_t size)
+{
+  nodes_memory_usages_.lookup_or_add(node_instance_key, 0) += size;
+}
+
+/* Computes the value of every group node inside the given tree recursively by accumulating the
+ * values of its nodes, setting the computed value to the group nodes. This is used for both the
+ * evaluation times and the memory usages. The value of the tree is returned since the function is
+ * called recursively. */
+template<typename T>
+static T accumulate_node_group_values(const bNodeTree &node_tree,
+                                      bNodeInstanceKey instance_key,
+                                      Map<bNodeInstanceKey, T> &values)
 {
-  timeit::Nanoseconds tree_evaluation_time = timeit::Nanoseconds::zero();
+  T tree_value = T(0);
 
   for (const bNode *node : node_tree.all_nodes()) {
     const bNodeInstanceKey node_instance_key = bke::node_instance_key(
         instance_key, &node_tree, node);
     if (!node->is_group()) {
-      /* Non-group node, no need to recurse into. Simply accumulate the node's evaluation time to
-       * the current tree's evaluation time. Note that not every node might have an evaluation
-       * time stored, so default to zero. See the documentation on nodes_evaluation_times_ for more
-       * information. */
-      tree_evaluation_time += nodes_evaluation_times_.lookup_default(node_instance_key,
-                                                                     timeit::Nanoseconds::zero());
+      /* Non-group node, no need to recurse into. Simply accumulate the node's value to the current
+       * tree's value. Note that not every node might have a value stored, so default to zero. See
+       * the documentation on Profiler::nodes_evaluation_times_ for more information. */
+      tree_value += values.lookup_default(node_instance_key, T(0));
       continue;
     }
 
@@ -50,23 +64,24 @@ timeit::Nanoseconds Profiler::accumulate_node_group_times(const bNodeTree &node_
       continue;
     }
 
-    const timeit::Nanoseconds group_execution_time = this->accumulate_node_group_times(
-        *child_tree, node_instance_key);
+    const T group_value = accumulate_node_group_values(*child_tree, node_instance_key, values);
 
-    /* Set evaluation time of the group node. */
-    this->set_node_evaluation_time(node_instance_key, group_execution_time);
+    /* Set the value of the group node. */
+    values.lookup_or_add(node_instance_key, T(0)) += group_value;
 
-    /* Add group evaluation time to the overall tree execution time. */
-    tree_evaluation_time += group_execution_time;
+    /* Add the group value to the overall tree value. */
+    tree_value += group_value;
   }
 
-  return tree_evaluation_time;
+  return tree_value;
 }
 
 void Profiler::finalize(const bNodeTree &node_tree)
 {
-  /* Compute the evaluation time of all node groups starting from the root tree. */
-  this->accumulate_node_group_times(node_tree, bke::NODE_INSTANCE_KEY_BASE);
+  /* Compute the evaluation time and memory usage of all node groups starting from the root
+   * tree. */
+  accumulate_node_group_values(node_tree, bke::NODE_INSTANCE_KEY_BASE, nodes_evaluation_times_);
+  accumulate_node_group_values(node_tree, bke::NODE_INSTANCE_KEY_BASE, nodes_memory_usages_);
 }
 
 }  // namespace blender::realtime_compositor
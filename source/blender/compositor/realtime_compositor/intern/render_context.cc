@@ -2,6 +2,7 @@
  *
  * SPDX-License-Identifier: GPL-2.0-or-later */
 
+#include <cstring>
 #include <memory>
 #include <string>
 
@@ -10,6 +11,7 @@
 #include "BLI_map.hh"
 #include "BLI_math_vector_types.hh"
 #include "BLI_string.h"
+#include "BLI_task.h"
 #include "BLI_utildefines.h"
 
 #include "MEM_guardedalloc.h"
@@ -21,6 +23,7 @@
 #include "DNA_windowmanager_types.h"
 
 #include "BKE_image.h"
+#include "BKE_image_format.h"
 #include "BKE_image_save.h"
 #include "BKE_report.hh"
 
@@ -61,6 +64,12 @@ FileOutput::FileOutput(const std::string &path,
 FileOutput::~FileOutput()
 {
   RE_FreeRenderResult(render_result_);
+
+  if (write_scene_) {
+    BLI_freelistN(&write_scene_->r.views);
+    MEM_freeN(write_scene_);
+    BKE_image_format_free(&write_format_);
+  }
 }
 
 void FileOutput::add_view(const char *view_name)
@@ -116,10 +125,9 @@ void FileOutput::add_meta_data(std::string key, std::string value)
   meta_data_.add(key, value);
 }
 
-void FileOutput::save(Scene *scene)
+void FileOutput::prepare_save(Scene *scene)
 {
-  ReportList reports;
-  BKE_reports_init(&reports, RPT_STORE);
+  BLI_assert(!write_scene_);
 
   /* Add scene stamp data as meta data as well as the custom meta data. */
   BKE_render_result_stamp_info(scene, nullptr, render_result_, false);
@@ -127,12 +135,42 @@ void FileOutput::save(Scene *scene)
     BKE_render_result_stamp_data(render_result_, field.key.c_str(), field.value.c_str());
   }
 
-  BKE_image_render_write(
-      &reports, render_result_, scene, true, path_.c_str(), &format_, save_as_render_);
+  /* Writing only needs the render settings of the scene, which are shallow copied except for the
+   * views that are needed to compute the view suffixes of the file paths. */
+  write_scene_ = MEM_cnew<Scene>("Scene For File Output Writing");
+  memcpy(&write_scene_->r, &scene->r, sizeof(RenderData));
+  BLI_duplicatelist(&write_scene_->r.views, &scene->r.views);
+
+  /* Resolve the color management settings of the format, which might follow those of the scene,
+   * and tag them as overridden such that they are used as is while writing. */
+  BKE_image_format_init_for_write(&write_format_, scene, &format_);
+  write_format_.color_management = R_IMF_COLOR_MANAGEMENT_OVERRIDE;
+}
+
+void FileOutput::write()
+{
+  BLI_assert(write_scene_);
+
+  ReportList reports;
+  BKE_reports_init(&reports, RPT_STORE);
+
+  BKE_image_render_write(&reports,
+                         render_result_,
+                         write_scene_,
+                         true,
+                         path_.c_str(),
+                         &write_format_,
+                         save_as_render_);
 
   BKE_reports_free(&reports);
 }
 
+void FileOutput::save(Scene *scene)
+{
+  prepare_save(scene);
+  write();
+}
+
 /* ------------------------------------------------------------------------------------------------
  * Render Context
  */
@@ -146,11 +184,31 @@ FileOutput &RenderContext::get_file_output(std::string path,
       path, [&]() { return std::make_unique<FileOutput>(path, format, size, save_as_render); });
 }
 
-void RenderContext::save_file_outputs(Scene *scene)
+static void write_file_output_task(TaskPool *__restrict /*pool*/, void *task_data)
+{
+  static_cast<FileOutput *>(task_data)->write();
+}
+
+static void free_file_output_task(TaskPool *__restrict /*pool*/, void *task_data)
+{
+  delete static_cast<FileOutput *>(task_data);
+}
+
+void RenderContext::save_file_outputs(Scene *scene, TaskPool *task_pool)
 {
+  if (!task_pool) {
+    for (std::unique_ptr<FileOutput> &file_output : file_outputs_.values()) {
+      file_output->save(scene);
+    }
+    return;
+  }
+
   for (std::unique_ptr<FileOutput> &file_output : file_outputs_.values()) {
-    file_output->save(scene);
+    file_output->prepare_save(scene);
+    BLI_task_pool_push(
+        task_pool, write_file_output_task, file_output.release(), true, free_file_output_task);
   }
+  file_outputs_.clear();
 }
 
 }  // namespace blender::realtime_compositor
@@ -216,12 +216,11 @@ void Result::allocate_texture(Domain domain, bool from_pool)
   domain_ = domain;
 }
 
-void Result::allocate_single_value()
+void Result::allocate_single_value(bool from_pool)
 {
-  /* Single values are stored in 1x1 textures as well as the single value members. Further, they
-   * are always allocated from the pool. */
+  /* Single values are stored in 1x1 textures as well as the single value members. */
   is_single_value_ = true;
-  this->allocate_data(int2(1), true);
+  this->allocate_data(int2(1), from_pool);
   domain_ = Domain::identity();
 }
 
@@ -791,6 +790,29 @@ int64_t Result::channels_count() const
   return 4;
 }
 
+int64_t Result::size_in_bytes() const
+{
+  if (master_ || !this->is_allocated()) {
+    return 0;
+  }
+
+  const int2 size = is_single_value_ ? int2(1) : domain_.size;
+  const int64_t pixels_count = int64_t(size.x) * int64_t(size.y);
+  switch (storage_type_) {
+    case ResultStorageType::GPU: {
+      const int64_t channel_size = precision_ == ResultPrecision::Half ? 2 : 4;
+      const int64_t channels_count = GPU_texture_component_len(GPU_texture_format(gpu_texture_));
+      return pixels_count * channels_count * channel_size;
+    }
+    case ResultStorageType::FloatCPU:
+      return pixels_count * this->channels_count() * int64_t(sizeof(float));
+    case ResultStorageType::IntegerCPU:
+      return pixels_count * this->channels_count() * int64_t(sizeof(int));
+  }
+
+  return 0;
+}
+
 float *Result::get_float_pixel(const int2 &texel) const
 {
   return float_texture_ + (texel.y * domain_.size.x + texel.x) * this->channels_count();
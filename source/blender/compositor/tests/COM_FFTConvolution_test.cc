@@ -0,0 +1,105 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+#include "testing/testing.h"
+
+#include "BLI_math_base.hh"
+#include "BLI_rect.h"
+
+#include "COM_FFTConvolution.h"
+#include "COM_MemoryBuffer.h"
+
+namespace blender::compositor::tests {
+
+static constexpr int KERNEL_RADIUS = 3;
+
+static float4 kernel_value(const int2 offset)
+{
+  return float4(1.0f,
+                float(KERNEL_RADIUS + 1 - math::abs(offset.x)),
+                offset == int2(0) ? 1.0f : 0.0f,
+                float(offset.y + KERNEL_RADIUS));
+}
+
+static void fill_input(MemoryBuffer &input)
+{
+  const rcti &rect = input.get_rect();
+  for (int y = rect.ymin; y < rect.ymax; y++) {
+    for (int x = rect.xmin; x < rect.xmax; x++) {
+      float *color = input.get_elem(x, y);
+      for (int channel = 0; channel < 4; channel++) {
+        color[channel] = float((x * 7 + y * 13 + channel * 5) % 11);
+      }
+    }
+  }
+}
+
+/* Directly compute the normalized convolution of the input at the given pixel. */
+static float4 convolve_directly(const MemoryBuffer &input,
+                                const int x,
+                                const int y,
+                                const FFTConvolution::Boundary boundary)
+{
+  const rcti &rect = input.get_rect();
+  float4 accumulated_color = float4(0.0f);
+  float4 accumulated_weight = float4(0.0f);
+  for (int yi = -KERNEL_RADIUS; yi <= KERNEL_RADIUS; yi++) {
+    for (int xi = -KERNEL_RADIUS; xi <= KERNEL_RADIUS; xi++) {
+      const float4 weight = kernel_value(int2(xi, yi));
+      accumulated_weight += weight;
+
+      int2 texel = int2(x + xi, y + yi);
+      if (boundary == FFTConvolution::Boundary::Extend) {
+        texel.x = math::clamp(texel.x, rect.xmin, rect.xmax - 1);
+        texel.y = math::clamp(texel.y, rect.ymin, rect.ymax - 1);
+      }
+      else if (texel.x < rect.xmin || texel.x >= rect.xmax || texel.y < rect.ymin ||
+               texel.y >= rect.ymax)
+      {
+        continue;
+      }
+      accumulated_color += float4(input.get_elem(texel.x, texel.y)) * weight;
+    }
+  }
+  return accumulated_color / accumulated_weight;
+}
+
+static void test_convolution(const FFTConvolution::Boundary boundary)
+{
+  if (!FFTConvolution::is_supported()) {
+    GTEST_SKIP() << "Built without FFTW.";
+  }
+
+  const rcti area = {2, 13, 3, 10};
+  MemoryBuffer input(DataType::Color, area);
+  fill_input(input);
+  MemoryBuffer output(DataType::Color, area);
+
+  FFTConvolution convolution(
+      int2(BLI_rcti_size_x(&area), BLI_rcti_size_y(&area)), KERNEL_RADIUS, 4, boundary);
+  convolution.set_channel_kernels(kernel_value);
+  convolution.execute(input, output, area);
+
+  for (int y = area.ymin; y < area.ymax; y++) {
+    for (int x = area.xmin; x < area.xmax; x++) {
+      const float4 expected_color = convolve_directly(input, x, y, boundary);
+      const float *color = output.get_elem(x, y);
+      for (int channel = 0; channel < 4; channel++) {
+        EXPECT_NEAR(color[channel], expected_color[channel], 1e-4f);
+      }
+    }
+  }
+}
+
+TEST(FFTConvolution, ZeroBoundary)
+{
+  test_convolution(FFTConvolution::Boundary::Zero);
+}
+
+TEST(FFTConvolution, ExtendBoundary)
+{
+  test_convolution(FFTConvolution::Boundary::Extend);
+}
+
+}  // namespace blender::compositor::tests
@@ -0,0 +1,61 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+#include "testing/testing.h"
+
+#include "COM_MemoryBuffer.h"
+
+namespace blender::compositor::tests {
+
+TEST(MemoryBuffer, PackUnpack)
+{
+  const rcti area = {-2, 5, 1, 4};
+  MemoryBuffer buffer(DataType::Color, area);
+  for (int y = area.ymin; y < area.ymax; y++) {
+    for (int x = area.xmin; x < area.xmax; x++) {
+      float *color = buffer.get_elem(x, y);
+      for (int channel = 0; channel < 4; channel++) {
+        /* Values that are exactly representable at half precision. */
+        color[channel] = float(x * 4 + y * 16 + channel) * 0.25f;
+      }
+    }
+  }
+
+  buffer.pack();
+  EXPECT_TRUE(buffer.is_packed());
+  EXPECT_EQ(buffer.get_buffer(), nullptr);
+
+  buffer.unpack();
+  EXPECT_FALSE(buffer.is_packed());
+  for (int y = area.ymin; y < area.ymax; y++) {
+    for (int x = area.xmin; x < area.xmax; x++) {
+      const float *color = buffer.get_elem(x, y);
+      for (int channel = 0; channel < 4; channel++) {
+        EXPECT_EQ(color[channel], float(x * 4 + y * 16 + channel) * 0.25f);
+      }
+    }
+  }
+}
+
+TEST(MemoryBuffer, PackRounding)
+{
+  MemoryBuffer buffer(DataType::Value, 2, 1);
+  buffer.get_elem(0, 0)[0] = 0.1f;
+  buffer.get_elem(1, 0)[0] = 1000.3f;
+
+  buffer.pack();
+  buffer.unpack();
+  EXPECT_NEAR(buffer.get_elem(0, 0)[0], 0.1f, 1e-4f);
+  EXPECT_NEAR(buffer.get_elem(1, 0)[0], 1000.3f, 0.5f);
+}
+
+TEST(MemoryBuffer, PackedDestruction)
+{
+  /* Packed buffers free their packed data when destructed. */
+  MemoryBuffer buffer(DataType::Vector, 4, 4);
+  buffer.clear();
+  buffer.pack();
+}
+
+}  // namespace blender::compositor::tests
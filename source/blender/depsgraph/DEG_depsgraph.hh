@@ -30,6 +30,8 @@
 
 #pragma once
 
+#include "BLI_span.hh"
+
 #include "DNA_ID.h"
 
 /* Dependency Graph */
@@ -120,6 +122,12 @@ const char *DEG_update_tag_as_string(IDRecalcFlag flag);
 /** Tag given ID for an update in all the dependency graphs. */
 void DEG_id_tag_update(ID *id, unsigned int flags);
 void DEG_id_tag_update_ex(Main *bmain, ID *id, unsigned int flags);
+/**
+ * Same as calling #DEG_id_tag_update_ex for each of the IDs, but cheaper for many IDs: the
+ * registered dependency graphs are looked up once and each of them is tagged for all IDs in one
+ * go. IDs may be repeated, they are only tagged once.
+ */
+void DEG_id_tag_update_batch(Main *bmain, blender::Span<ID *> ids, unsigned int flags);
 
 void DEG_graph_id_tag_update(Main *bmain, Depsgraph *depsgraph, ID *id, unsigned int flags);
 
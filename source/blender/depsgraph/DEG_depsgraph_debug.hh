@@ -52,6 +52,39 @@ void DEG_debug_stats_gnuplot(const Depsgraph *graph,
                              const char *label,
                              const char *output_filename);
 
+/* ************************************************ */
+/* Evaluation Traces */
+
+/**
+ * Start recording the evaluation of operations of all dependency graphs, with the thread they
+ * ran on and their start and end time. Work inside of operations can add more detailed events,
+ * e.g. geometry nodes record the execution of every node and the memory usage afterwards.
+ */
+void DEG_debug_trace_begin();
+bool DEG_debug_trace_is_recording();
+/**
+ * Stop recording and write the trace as Trace Event Format JSON, which can be opened in
+ * `chrome://tracing` or Perfetto.
+ *
+ * \note Must not be called while a dependency graph is evaluated.
+ * \return False when no trace was recorded or the file couldn't be written.
+ */
+bool DEG_debug_trace_end(const char *filepath);
+/**
+ * Add an event for work done inside an operation to the trace that is being recorded, e.g. the
+ * execution of a single geometry node. Times are from #BLI_time_now_seconds. The event is shown
+ * on the lane of the calling thread.
+ */
+void DEG_debug_trace_add_event(const char *category,
+                               blender::StringRef name,
+                               blender::StringRef details,
+                               double start_time,
+                               double end_time);
+/**
+ * Record the memory that is currently in use, which shows up as memory usage graph in the trace.
+ */
+void DEG_debug_trace_add_memory_usage(double time);
+
 /* ************************************************ */
 
 /** Compare two dependency graphs. */
@@ -17,15 +17,19 @@
 #include "DNA_modifier_types.h"
 #include "DNA_object_types.h"
 
+#include "BLI_listbase.h"
 #include "BLI_stack.h"
 #include "BLI_utildefines.h"
 
 #include "BKE_action.hh"
 #include "BKE_collection.hh"
+#include "BKE_fcurve.hh"
 #include "BKE_lib_id.hh"
 
 #include "RNA_prototypes.hh"
 
+#include "ANIM_action.hh"
+
 #include "intern/builder/deg_builder_cache.h"
 #include "intern/builder/deg_builder_remove_noop.h"
 #include "intern/depsgraph.hh"
@@ -176,6 +180,20 @@ const char *DepsgraphBuilder::get_rna_path_relative_to_scene_camera(const Scene
 /** \name Builder Finalizer.
  * \{ */
 
+bool deg_action_is_time_invariant(const bAction *action)
+{
+  const animrig::Action &wrapped_action = action->wrap();
+  if (!wrapped_action.is_action_legacy()) {
+    return false;
+  }
+  LISTBASE_FOREACH (const FCurve *, fcu, &action->curves) {
+    if (!BKE_fcurve_is_constant(fcu)) {
+      return false;
+    }
+  }
+  return true;
+}
+
 void deg_graph_build_finalize(Main *bmain, Depsgraph *graph)
 {
   deg_graph_flush_visibility_flags(graph);
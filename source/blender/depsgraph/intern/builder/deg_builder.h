@@ -15,6 +15,7 @@ struct ModifierData;
 struct Object;
 struct PointerRNA;
 struct Scene;
+struct bAction;
 struct bPoseChannel;
 
 namespace blender::deg {
@@ -57,4 +58,10 @@ bool deg_check_id_in_depsgraph(const Depsgraph *graph, ID *id_orig);
 bool deg_check_base_in_depsgraph(const Depsgraph *graph, Base *base);
 void deg_graph_build_finalize(Main *bmain, Depsgraph *graph);
 
+/**
+ * Whether the action evaluates to the same values on every frame, so it doesn't need to depend
+ * on time. Only supported for legacy actions, layered actions are always considered animated.
+ */
+bool deg_action_is_time_invariant(const bAction *action);
+
 }  // namespace blender::deg
@@ -15,10 +15,13 @@
 
 #include "MEM_guardedalloc.h"
 
+#include "BLI_array.hh"
 #include "BLI_blenlib.h"
 #include "BLI_span.hh"
 #include "BLI_string.h"
+#include "BLI_task.hh"
 #include "BLI_utildefines.h"
+#include "BLI_vector.hh"
 
 #include "DNA_action_types.h"
 #include "DNA_anim_types.h"
@@ -428,41 +431,28 @@ void DepsgraphNodeBuilder::begin_build()
  * NOTE: This is split in two, a static function and a public method of the node builder, to allow
  * the code to access the builder's data more easily. */
 
-int DepsgraphNodeBuilder::foreach_id_cow_detect_need_for_update_callback(ID *id_cow_self,
-                                                                         ID *id_pointer)
+bool DepsgraphNodeBuilder::foreach_id_cow_detect_need_for_update_callback(ID *id_pointer)
 {
   if (id_pointer->orig_id == nullptr) {
     /* `id_cow_self` uses a non-cow ID, if that ID has an evaluated copy in current depsgraph its
      * owner needs to be remapped, i.e. copy-on-eval-flushed. */
     IDNode *id_node = find_id_node(id_pointer);
-    if (id_node != nullptr && id_node->id_cow != nullptr) {
-      graph_id_tag_update(bmain_,
-                          graph_,
-                          id_cow_self->orig_id,
-                          ID_RECALC_SYNC_TO_EVAL,
-                          DEG_UPDATE_SOURCE_RELATIONS);
-      return IDWALK_RET_STOP_ITER;
-    }
+    return id_node != nullptr && id_node->id_cow != nullptr;
   }
-  else {
-    /* `id_cow_self` uses an evaluated ID, if that evaluated copy is removed from current depsgraph
-     * its owner needs to be remapped, i.e. copy-on-eval-flushed. */
-    /* NOTE: at that stage, old existing evaluated copies that are to be removed from current state
-     * of evaluated depsgraph are still valid pointers, they are freed later (typically during
-     * destruction of the builder itself). */
-    IDNode *id_node = find_id_node(id_pointer->orig_id);
-    if (id_node == nullptr) {
-      graph_id_tag_update(bmain_,
-                          graph_,
-                          id_cow_self->orig_id,
-                          ID_RECALC_SYNC_TO_EVAL,
-                          DEG_UPDATE_SOURCE_RELATIONS);
-      return IDWALK_RET_STOP_ITER;
-    }
-  }
-  return IDWALK_RET_NOP;
+  /* `id_cow_self` uses an evaluated ID, if that evaluated copy is removed from current depsgraph
+   * its owner needs to be remapped, i.e. copy-on-eval-flushed. */
+  /* NOTE: at that stage, old existing evaluated copies that are to be removed from current state
+   * of evaluated depsgraph are still valid pointers, they are freed later (typically during
+   * destruction of the builder itself). */
+  IDNode *id_node = find_id_node(id_pointer->orig_id);
+  return id_node == nullptr;
 }
 
+struct DetectNeedForUpdateData {
+  DepsgraphNodeBuilder *builder;
+  bool needs_update;
+};
+
 static int foreach_id_cow_detect_need_for_update_callback(LibraryIDLinkCallbackData *cb_data)
 {
   ID *id = *cb_data->id_pointer;
@@ -475,10 +465,12 @@ static int foreach_id_cow_detect_need_for_update_callback(LibraryIDLinkCallbackD
     return IDWALK_RET_NOP;
   }
 
-  DepsgraphNodeBuilder *builder = static_cast<DepsgraphNodeBuilder *>(cb_data->user_data);
-  ID *id_cow_self = cb_data->self_id;
-
-  return builder->foreach_id_cow_detect_need_for_update_callback(id_cow_self, id);
+  DetectNeedForUpdateData *data = static_cast<DetectNeedForUpdateData *>(cb_data->user_data);
+  if (data->builder->foreach_id_cow_detect_need_for_update_callback(id)) {
+    data->needs_update = true;
+    return IDWALK_RET_STOP_ITER;
+  }
+  return IDWALK_RET_NOP;
 }
 
 void DepsgraphNodeBuilder::update_invalid_cow_pointers()
@@ -493,6 +485,7 @@ void DepsgraphNodeBuilder::update_invalid_cow_pointers()
    * some cases. This is slightly unfortunate (as it may hide issues in other parts of Blender
    * code), but cannot really be avoided currently. */
 
+  Vector<const IDNode *> id_nodes_to_check;
   for (const IDNode *id_node : graph_->id_nodes) {
     if (id_node->previously_visible_components_mask == 0) {
       /* Newly added node/ID, no need to check it. */
@@ -523,11 +516,32 @@ void DepsgraphNodeBuilder::update_invalid_cow_pointers()
        */
       continue;
     }
-    BKE_library_foreach_ID_link(nullptr,
-                                id_node->id_cow,
-                                deg::foreach_id_cow_detect_need_for_update_callback,
-                                this,
-                                IDWALK_IGNORE_EMBEDDED_ID | IDWALK_READONLY);
+    id_nodes_to_check.append(id_node);
+  }
+
+  /* Checking the ID pointers only reads data, so it is done for all IDs in parallel, which matters
+   * for scenes with many objects. Tagging is done afterwards, it is not thread-safe. */
+  Array<bool> needs_update(id_nodes_to_check.size(), false);
+  threading::parallel_for(id_nodes_to_check.index_range(), 256, [&](const IndexRange range) {
+    for (const int64_t i : range) {
+      DetectNeedForUpdateData data = {this, false};
+      BKE_library_foreach_ID_link(nullptr,
+                                  id_nodes_to_check[i]->id_cow,
+                                  deg::foreach_id_cow_detect_need_for_update_callback,
+                                  &data,
+                                  IDWALK_IGNORE_EMBEDDED_ID | IDWALK_READONLY);
+      needs_update[i] = data.needs_update;
+    }
+  });
+
+  for (const int64_t i : id_nodes_to_check.index_range()) {
+    if (needs_update[i]) {
+      graph_id_tag_update(bmain_,
+                          graph_,
+                          id_nodes_to_check[i]->id_orig,
+                          ID_RECALC_SYNC_TO_EVAL,
+                          DEG_UPDATE_SOURCE_RELATIONS);
+    }
   }
 }
 
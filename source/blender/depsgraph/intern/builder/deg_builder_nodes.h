@@ -90,10 +90,11 @@ class DepsgraphNodeBuilder : public DepsgraphBuilder {
   virtual void end_build();
 
   /**
-   * `id_cow_self` is the user of `id_pointer`,
+   * Whether the evaluated ID using `id_pointer` needs to be flushed,
    * see also `LibraryIDLinkCallbackData` struct definition.
+   * Only reads the graph, so it can be called from multiple threads.
    */
-  int foreach_id_cow_detect_need_for_update_callback(ID *id_cow_self, ID *id_pointer);
+  bool foreach_id_cow_detect_need_for_update_callback(ID *id_pointer);
 
   IDNode *add_id_node(ID *id);
   IDNode *find_id_node(const ID *id);
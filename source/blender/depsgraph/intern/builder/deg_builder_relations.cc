@@ -1617,6 +1617,11 @@ void DepsgraphRelationBuilder::build_animdata_curves(ID *id)
     ComponentKey action_key(&adt->action->id, NodeType::ANIMATION);
     add_relation(action_key, adt_key, "Action -> Animation");
   }
+  /* Strip extents and blending depend on time even when the strip actions are constant. */
+  if (!BLI_listbase_is_empty(&adt->nla_tracks)) {
+    TimeSourceKey time_src_key;
+    add_relation(time_src_key, adt_key, "TimeSrc -> NLA");
+  }
   /* Get source operations. */
   Node *node_from = get_node(adt_key);
   BLI_assert(node_from != nullptr);
@@ -1850,11 +1855,18 @@ void DepsgraphRelationBuilder::build_action(bAction *dna_action)
   }
 #endif
 
-  if (!action.is_empty()) {
-    TimeSourceKey time_src_key;
-    ComponentKey animation_key(&dna_action->id, NodeType::ANIMATION);
-    add_relation(time_src_key, animation_key, "TimeSrc -> Animation");
+  if (action.is_empty()) {
+    return;
+  }
+  /* Actions holding the same values on every frame are only evaluated when they (or the data
+   * they animate) are tagged for update, rather than on every frame change. */
+  if (deg_action_is_time_invariant(dna_action)) {
+    graph_->time_invariant_actions.add(dna_action);
+    return;
   }
+  TimeSourceKey time_src_key;
+  ComponentKey animation_key(&dna_action->id, NodeType::ANIMATION);
+  add_relation(time_src_key, animation_key, "TimeSrc -> Animation");
 }
 
 void DepsgraphRelationBuilder::build_driver(ID *id, FCurve *fcu)
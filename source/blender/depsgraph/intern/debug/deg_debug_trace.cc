@@ -0,0 +1,195 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup depsgraph
+ *
+ * Writes evaluation traces in the Trace Event Format, which can be opened in `chrome://tracing`
+ * or https://ui.perfetto.dev to see which operations ran on which thread.
+ */
+
+#include "intern/debug/deg_debug_trace.h"
+
+#include <fstream>
+
+#include "MEM_guardedalloc.h"
+
+#include "BLI_enumerable_thread_specific.hh"
+#include "BLI_serialize.hh"
+#include "BLI_time.h"
+#include "BLI_vector.hh"
+
+#include "DEG_depsgraph_debug.hh"
+
+#include "intern/depsgraph.hh"
+#include "intern/node/deg_node_component.hh"
+#include "intern/node/deg_node_id.hh"
+#include "intern/node/deg_node_operation.hh"
+
+namespace blender::deg {
+
+std::atomic<bool> trace_is_recording = false;
+
+namespace {
+
+struct TraceEvent {
+  const char *category;
+  std::string name;
+  /** Shown when the event is selected. Names are static strings. */
+  Vector<std::pair<const char *, std::string>, 2> args;
+  int thread_id;
+  double start_time;
+  double end_time;
+};
+
+struct MemoryUsageSample {
+  double time;
+  size_t bytes;
+};
+
+struct ThreadTrace {
+  Vector<TraceEvent> events;
+  Vector<MemoryUsageSample> memory_usage;
+};
+
+struct TraceRecorder {
+  double start_time = 0.0;
+  /* Events are gathered per thread to avoid locking while evaluating. */
+  threading::EnumerableThreadSpecific<ThreadTrace> threads;
+};
+
+TraceRecorder &trace_recorder()
+{
+  static TraceRecorder recorder;
+  return recorder;
+}
+
+/* Small sequential numbers are easier to read in trace viewers than native thread handles. */
+int trace_thread_id()
+{
+  static std::atomic<int> next_id = 0;
+  static thread_local int thread_id = next_id.fetch_add(1, std::memory_order_relaxed);
+  return thread_id;
+}
+
+}  // namespace
+
+void trace_record_operation(const Depsgraph *graph,
+                            const OperationNode *operation_node,
+                            const double start_time,
+                            const double end_time)
+{
+  TraceEvent event;
+  event.category = "depsgraph";
+  event.name = operation_node->owner->name.empty() ?
+                   operation_node->identifier() :
+                   operation_node->owner->name + "/" + operation_node->identifier();
+  event.args.append({"id", operation_node->owner->owner->name});
+  /* Copied, the depsgraph might be freed before the trace is written. */
+  event.args.append({"depsgraph", graph->debug.name});
+  event.thread_id = trace_thread_id();
+  event.start_time = start_time;
+  event.end_time = end_time;
+  trace_recorder().threads.local().events.append(std::move(event));
+}
+
+}  // namespace blender::deg
+
+namespace deg = blender::deg;
+
+void DEG_debug_trace_begin()
+{
+  deg::TraceRecorder &recorder = deg::trace_recorder();
+  for (deg::ThreadTrace &thread : recorder.threads) {
+    thread.events.clear();
+    thread.memory_usage.clear();
+  }
+  recorder.start_time = BLI_time_now_seconds();
+  deg::trace_is_recording = true;
+}
+
+bool DEG_debug_trace_is_recording()
+{
+  return deg::trace_is_recording;
+}
+
+void DEG_debug_trace_add_event(const char *category,
+                               const blender::StringRef name,
+                               const blender::StringRef details,
+                               const double start_time,
+                               const double end_time)
+{
+  if (!deg::trace_is_recording) {
+    return;
+  }
+  deg::TraceEvent event;
+  event.category = category;
+  event.name = name;
+  if (!details.is_empty()) {
+    event.args.append({"details", details});
+  }
+  event.thread_id = deg::trace_thread_id();
+  event.start_time = start_time;
+  event.end_time = end_time;
+  deg::trace_recorder().threads.local().events.append(std::move(event));
+}
+
+void DEG_debug_trace_add_memory_usage(const double time)
+{
+  if (!deg::trace_is_recording) {
+    return;
+  }
+  deg::trace_recorder().threads.local().memory_usage.append({time, MEM_get_memory_in_use()});
+}
+
+bool DEG_debug_trace_end(const char *filepath)
+{
+  using namespace blender::io::serialize;
+  if (!deg::trace_is_recording) {
+    return false;
+  }
+  deg::trace_is_recording = false;
+
+  deg::TraceRecorder &recorder = deg::trace_recorder();
+  DictionaryValue root;
+  ArrayValue &trace_events = *root.append_array("traceEvents");
+  for (deg::ThreadTrace &thread : recorder.threads) {
+    for (const deg::TraceEvent &event : thread.events) {
+      DictionaryValue &value = *trace_events.append_dict();
+      value.append_str("name", event.name);
+      value.append_str("cat", event.category);
+      value.append_str("ph", "X");
+      /* Trace Event Format uses microseconds. */
+      value.append_double("ts", (event.start_time - recorder.start_time) * 1e6);
+      value.append_double("dur", (event.end_time - event.start_time) * 1e6);
+      value.append_int("pid", 0);
+      value.append_int("tid", event.thread_id);
+      DictionaryValue &args = *value.append_dict("args");
+      for (const auto &[key, arg] : event.args) {
+        args.append_str(key, arg);
+      }
+    }
+    for (const deg::MemoryUsageSample &sample : thread.memory_usage) {
+      DictionaryValue &value = *trace_events.append_dict();
+      value.append_str("name", "Memory Usage");
+      value.append_str("ph", "C");
+      value.append_double("ts", (sample.time - recorder.start_time) * 1e6);
+      value.append_int("pid", 0);
+      DictionaryValue &args = *value.append_dict("args");
+      args.append_double("MiB", double(sample.bytes) / (1024.0 * 1024.0));
+    }
+    thread.events.clear();
+    thread.memory_usage.clear();
+  }
+
+  std::ofstream os;
+  os.open(filepath, std::ios::out | std::ios::trunc);
+  if (!os.is_open()) {
+    return false;
+  }
+  JsonFormatter formatter;
+  formatter.serialize(os, root);
+  os.close();
+  return !os.fail();
+}
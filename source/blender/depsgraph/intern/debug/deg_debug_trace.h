@@ -0,0 +1,29 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup depsgraph
+ *
+ * Recording of operation evaluation timelines, see #DEG_debug_trace_begin.
+ */
+
+#pragma once
+
+#include <atomic>
+
+namespace blender::deg {
+
+struct Depsgraph;
+class OperationNode;
+
+/** True while a trace is being recorded, cheap enough to be checked for every operation. */
+extern std::atomic<bool> trace_is_recording;
+
+/** Record evaluation of the operation, times are from #BLI_time_now_seconds. */
+void trace_record_operation(const Depsgraph *graph,
+                            const OperationNode *operation_node,
+                            double start_time,
+                            double end_time);
+
+}  // namespace blender::deg
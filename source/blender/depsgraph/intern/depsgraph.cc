@@ -204,9 +204,12 @@ Relation *Depsgraph::check_nodes_connected(const Node *from,
                                            const Node *to,
                                            const char *description)
 {
-  for (Relation *rel : from->outlinks) {
-    BLI_assert(rel->from == from);
-    if (rel->to != to) {
+  /* Nodes like the time source can have relations to most other nodes, scan the shorter list to
+   * avoid quadratic graph building time. */
+  const bool use_inlinks = to->inlinks.size() < from->outlinks.size();
+  for (Relation *rel : use_inlinks ? to->inlinks : from->outlinks) {
+    BLI_assert(use_inlinks ? rel->to == to : rel->from == from);
+    if (rel->from != from || rel->to != to) {
       continue;
     }
     if (description != nullptr && !STREQ(rel->name, description)) {
@@ -237,6 +240,7 @@ void Depsgraph::clear_all_nodes()
   clear_id_nodes();
   delete time_source;
   time_source = nullptr;
+  time_invariant_actions.clear();
 }
 
 ID *Depsgraph::get_cow_id(const ID *id_orig) const
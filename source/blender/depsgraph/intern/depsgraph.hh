@@ -34,6 +34,7 @@
 struct ID;
 struct Scene;
 struct ViewLayer;
+struct bAction;
 
 namespace blender::deg {
 
@@ -119,6 +120,10 @@ struct Depsgraph {
   /* Nodes which have been tagged as "directly modified". */
   Set<OperationNode *> entry_tags;
 
+  /* Actions which evaluate to the same values on every frame, and so are not re-evaluated on
+   * frame change. Relations are updated when such an action is edited to become animated. */
+  Set<const bAction *> time_invariant_actions;
+
   /* Convenience Data ................... */
 
   /* XXX: should be collected after building (if actually needed?) */
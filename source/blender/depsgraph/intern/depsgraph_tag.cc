@@ -18,6 +18,7 @@
 #include "BLI_math_bits.h"
 #include "BLI_task.h"
 #include "BLI_utildefines.h"
+#include "BLI_vector_set.hh"
 
 #include "DNA_anim_types.h"
 #include "DNA_curve_types.h"
@@ -39,6 +40,7 @@
 #include "BKE_workspace.hh"
 
 #include "DEG_depsgraph.hh"
+#include "DEG_depsgraph_build.hh"
 #include "DEG_depsgraph_debug.hh"
 #include "DEG_depsgraph_query.hh"
 
@@ -695,6 +697,34 @@ void id_tag_update(Main *bmain, ID *id, uint flags, eUpdateSource update_source)
   id->recalc_after_undo_push |= deg_recalc_flags_effective(nullptr, flags);
 }
 
+void id_tag_update_batch(Main *bmain, Span<ID *> ids, uint flags, eUpdateSource update_source)
+{
+  VectorSet<ID *> unique_ids;
+  unique_ids.reserve(ids.size());
+  for (ID *id : ids) {
+    if (id != nullptr) {
+      unique_ids.add(id);
+    }
+  }
+
+  for (ID *id : unique_ids) {
+    graph_id_tag_update(bmain, nullptr, id, flags, update_source);
+  }
+  /* Tag one graph at a time, which keeps its ID and entry tag lookups hot. */
+  for (deg::Depsgraph *depsgraph : deg::get_all_registered_graphs(bmain)) {
+    for (ID *id : unique_ids) {
+      graph_id_tag_update(bmain, depsgraph, id, flags, update_source);
+    }
+  }
+
+  for (ID *id : unique_ids) {
+    if (update_source & DEG_UPDATE_SOURCE_USER_EDIT) {
+      BKE_lib_override_id_tag_on_deg_tag_from_user(id);
+    }
+    id->recalc_after_undo_push |= deg_recalc_flags_effective(nullptr, flags);
+  }
+}
+
 void graph_id_tag_update(
     Main *bmain, Depsgraph *graph, ID *id, uint flags, eUpdateSource update_source)
 {
@@ -715,6 +745,15 @@ void graph_id_tag_update(
   IDNode *id_node = (graph != nullptr) ? graph->find_id_node(id) : nullptr;
   if (graph != nullptr) {
     DEG_graph_id_type_tag(reinterpret_cast<::Depsgraph *>(graph), GS(id->name));
+    /* An edited action might have become animated, in which case it needs to depend on time. */
+    if (GS(id->name) == ID_AC) {
+      const bAction *action = reinterpret_cast<const bAction *>(id);
+      if (graph->time_invariant_actions.contains(action) &&
+          !deg_action_is_time_invariant(action))
+      {
+        DEG_graph_tag_relations_update(reinterpret_cast<::Depsgraph *>(graph));
+      }
+    }
   }
   if (flags == 0) {
     deg_graph_node_tag_zero(bmain, graph, id_node, update_source);
@@ -845,6 +884,11 @@ void DEG_id_tag_update_ex(Main *bmain, ID *id, uint flags)
   deg::id_tag_update(bmain, id, flags, deg::DEG_UPDATE_SOURCE_USER_EDIT);
 }
 
+void DEG_id_tag_update_batch(Main *bmain, blender::Span<ID *> ids, uint flags)
+{
+  deg::id_tag_update_batch(bmain, ids, flags, deg::DEG_UPDATE_SOURCE_USER_EDIT);
+}
+
 void DEG_id_tag_update_for_side_effect_request(Depsgraph *depsgraph, ID *id, uint flags)
 {
   BLI_assert(depsgraph != nullptr);
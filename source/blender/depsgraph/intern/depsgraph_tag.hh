@@ -20,6 +20,11 @@ NodeType geometry_tag_to_component(const ID *id);
 
 /* Tag given ID for an update in all registered dependency graphs. */
 void id_tag_update(Main *bmain, ID *id, unsigned int flags, eUpdateSource update_source);
+/* Tag given IDs for an update in all registered dependency graphs, one graph at a time. */
+void id_tag_update_batch(Main *bmain,
+                         Span<ID *> ids,
+                         unsigned int flags,
+                         eUpdateSource update_source);
 
 /* Tag given ID for an update with in a given dependency graph. */
 void graph_id_tag_update(
@@ -10,12 +10,18 @@
 
 #include "intern/eval/deg_eval.h"
 
+#include <algorithm>
+#include <limits>
+
+#include "MEM_guardedalloc.h"
+
 #include "BLI_compiler_attrs.h"
 #include "BLI_function_ref.hh"
 #include "BLI_gsqueue.h"
 #include "BLI_task.h"
 #include "BLI_time.h"
 #include "BLI_utildefines.h"
+#include "BLI_vector.hh"
 
 #include "BKE_global.hh"
 
@@ -32,6 +38,7 @@
 
 #include "atomic_ops.h"
 
+#include "intern/debug/deg_debug_trace.h"
 #include "intern/depsgraph.hh"
 #include "intern/depsgraph_relation.hh"
 #include "intern/depsgraph_tag.hh"
@@ -49,6 +56,18 @@ namespace blender::deg {
 
 namespace {
 
+/* Number of graph evaluations between updates of the critical path costs of operations. */
+#define DEG_CRITICAL_PATH_UPDATE_INTERVAL 8
+
+/* Operations whose whole chain of dependents is estimated to take less than this many seconds
+ * are evaluated by the task which scheduled them, since pushing them to the pool costs about as
+ * much as evaluating them. */
+#define DEG_INLINE_CRITICAL_PATH_COST 2e-5f
+
+/* Evaluation stages whose tagged operations are estimated to take less than this many seconds in
+ * total are evaluated on the calling thread without the task pool. */
+#define DEG_THREADED_EVALUATION_MIN_COST 2e-4
+
 struct DepsgraphEvalState;
 
 void deg_task_run_func(TaskPool *pool, void *taskdata);
@@ -83,6 +102,9 @@ struct DepsgraphEvalState {
   EvaluationStage stage;
   bool need_update_pending_parents = true;
   bool need_single_thread_pass = false;
+  /* Sum of the estimated cost of the operations to be evaluated, gathered together with the
+   * pending parents. Infinite when the cost of some of them is unknown. */
+  double estimated_cost = 0.0;
 };
 
 void evaluate_node(const DepsgraphEvalState *state, OperationNode *operation_node)
@@ -91,15 +113,20 @@ void evaluate_node(const DepsgraphEvalState *state, OperationNode *operation_nod
 
   /* Sanity checks. */
   BLI_assert_msg(!operation_node->is_noop(), "NOOP nodes should not actually be scheduled");
-  /* Perform operation. */
+  /* Perform operation. Always timed, to estimate the cost of operations for scheduling. */
+  const double start_time = BLI_time_now_seconds();
+  operation_node->evaluate(depsgraph);
+  const double duration = BLI_time_now_seconds() - start_time;
   if (state->do_stats) {
-    const double start_time = BLI_time_now_seconds();
-    operation_node->evaluate(depsgraph);
-    operation_node->stats.current_time += BLI_time_now_seconds() - start_time;
+    operation_node->stats.current_time += duration;
   }
-  else {
-    operation_node->evaluate(depsgraph);
+  if (trace_is_recording) {
+    trace_record_operation(state->graph, operation_node, start_time, start_time + duration);
   }
+  /* Running average, only this thread accesses the node now. */
+  operation_node->eval_cost = (operation_node->eval_cost == 0.0f) ?
+                                  float(duration) :
+                                  operation_node->eval_cost * 0.75f + float(duration) * 0.25f;
 
   /* Clear the flag early on, allowing partial updates without re-evaluating the same node multiple
    * times.
@@ -108,19 +135,58 @@ void evaluate_node(const DepsgraphEvalState *state, OperationNode *operation_nod
   operation_node->flag &= ~DEPSOP_FLAG_CLEAR_ON_EVAL;
 }
 
+/* Sort operations so the ones on the most expensive chains come first. */
+void sort_by_critical_path(MutableSpan<OperationNode *> nodes)
+{
+  std::stable_sort(nodes.begin(), nodes.end(), [](const OperationNode *a, const OperationNode *b) {
+    return a->critical_path_cost > b->critical_path_cost;
+  });
+}
+
+/* The critical path cost is zero until it is first computed after an evaluation. */
+bool is_cheap_to_evaluate_inline(const OperationNode *node)
+{
+  return node->critical_path_cost > 0.0f &&
+         node->critical_path_cost < DEG_INLINE_CRITICAL_PATH_COST;
+}
+
 void deg_task_run_func(TaskPool *pool, void *taskdata)
 {
   void *userdata_v = BLI_task_pool_user_data(pool);
   DepsgraphEvalState *state = (DepsgraphEvalState *)userdata_v;
 
-  /* Evaluate node. */
-  OperationNode *operation_node = reinterpret_cast<OperationNode *>(taskdata);
-  evaluate_node(state, operation_node);
+  Vector<OperationNode *, 16> nodes_to_evaluate;
+  nodes_to_evaluate.append(reinterpret_cast<OperationNode *>(taskdata));
+  Vector<OperationNode *, 16> ready_children;
+  while (!nodes_to_evaluate.is_empty()) {
+    OperationNode *operation_node = nodes_to_evaluate.pop_last();
+    /* Evaluate node. */
+    evaluate_node(state, operation_node);
 
-  /* Schedule children. */
-  schedule_children(state, operation_node, [&](OperationNode *node) {
-    BLI_task_pool_push(pool, deg_task_run_func, node, false, nullptr);
-  });
+    /* Schedule children. The one on the most expensive chain is evaluated right away by this
+     * task, and so are cheap ones which are not worth the scheduling overhead. The others are
+     * pushed to the pool with the most expensive ones first. */
+    ready_children.clear();
+    schedule_children(
+        state, operation_node, [&](OperationNode *node) { ready_children.append(node); });
+    if (ready_children.is_empty()) {
+      continue;
+    }
+    sort_by_critical_path(ready_children);
+    for (OperationNode *node : ready_children.as_span().drop_front(1)) {
+      if (is_cheap_to_evaluate_inline(node)) {
+        continue;
+      }
+      BLI_task_pool_push(pool, deg_task_run_func, node, false, nullptr);
+    }
+    /* Cheap children are evaluated first, they are popped before the most expensive one. */
+    nodes_to_evaluate.append(ready_children.first());
+    for (OperationNode *node : ready_children.as_span().drop_front(1)) {
+      if (is_cheap_to_evaluate_inline(node)) {
+        nodes_to_evaluate.append(node);
+      }
+    }
+  }
 }
 
 bool check_operation_node_visible(const DepsgraphEvalState *state, OperationNode *op_node)
@@ -138,10 +204,10 @@ bool check_operation_node_visible(const DepsgraphEvalState *state, OperationNode
     return op_node->flag & OperationFlag::DEPSOP_FLAG_AFFECTS_VISIBILITY;
   }
 
-  return comp_node->affects_visible_id;
+  return comp_node->affects_visible_id || (op_node->flag & DEPSOP_FLAG_NEEDED_BY_VISIBLE_ID);
 }
 
-void calculate_pending_parents_for_node(const DepsgraphEvalState *state, OperationNode *node)
+void calculate_pending_parents_for_node(DepsgraphEvalState *state, OperationNode *node)
 {
   /* Update counters, applies for both visible and invisible IDs. */
   node->num_links_pending = 0;
@@ -154,6 +220,11 @@ void calculate_pending_parents_for_node(const DepsgraphEvalState *state, Operati
   if ((node->flag & DEPSOP_FLAG_NEEDS_UPDATE) == 0) {
     return;
   }
+  if (!node->is_noop()) {
+    state->estimated_cost += (node->eval_cost == 0.0f) ?
+                                 std::numeric_limits<double>::infinity() :
+                                 double(node->eval_cost);
+  }
   for (Relation *rel : node->inlinks) {
     if (rel->from->type == NodeType::OPERATION && (rel->flag & RELATION_FLAG_CYCLIC) == 0) {
       OperationNode *from = (OperationNode *)rel->from;
@@ -179,6 +250,7 @@ void calculate_pending_parents_if_needed(DepsgraphEvalState *state)
     return;
   }
 
+  state->estimated_cost = 0.0;
   for (OperationNode *node : state->graph->operations) {
     calculate_pending_parents_for_node(state, node);
   }
@@ -306,6 +378,26 @@ void schedule_children(DepsgraphEvalState *state,
   }
 }
 
+/* Evaluate the current stage of the dependency graph evaluation on the calling thread. */
+void evaluate_graph_on_calling_thread(DepsgraphEvalState *state)
+{
+  GSQueue *evaluation_queue = BLI_gsqueue_new(sizeof(OperationNode *));
+  auto schedule_node_to_queue = [&](OperationNode *node) {
+    BLI_gsqueue_push(evaluation_queue, &node);
+  };
+  schedule_graph(state, schedule_node_to_queue);
+
+  while (!BLI_gsqueue_is_empty(evaluation_queue)) {
+    OperationNode *operation_node;
+    BLI_gsqueue_pop(evaluation_queue, &operation_node);
+
+    evaluate_node(state, operation_node);
+    schedule_children(state, operation_node, schedule_node_to_queue);
+  }
+
+  BLI_gsqueue_free(evaluation_queue);
+}
+
 /* Evaluate given stage of the dependency graph evaluation using multiple threads.
  *
  * NOTE: Will assign the `state->stage` to the given stage. */
@@ -317,9 +409,18 @@ void evaluate_graph_threaded_stage(DepsgraphEvalState *state,
 
   calculate_pending_parents_if_needed(state);
 
-  schedule_graph(state, [&](OperationNode *node) {
+  /* Evaluating few cheap operations is faster without waking up worker threads. */
+  if (state->estimated_cost < DEG_THREADED_EVALUATION_MIN_COST) {
+    evaluate_graph_on_calling_thread(state);
+    return;
+  }
+
+  Vector<OperationNode *> ready_nodes;
+  schedule_graph(state, [&](OperationNode *node) { ready_nodes.append(node); });
+  sort_by_critical_path(ready_nodes);
+  for (OperationNode *node : ready_nodes) {
     BLI_task_pool_push(task_pool, deg_task_run_func, node, false, nullptr);
-  });
+  }
   BLI_task_pool_work_and_wait(task_pool);
 }
 
@@ -334,21 +435,7 @@ void evaluate_graph_single_threaded_if_needed(DepsgraphEvalState *state)
 
   state->stage = EvaluationStage::SINGLE_THREADED_WORKAROUND;
 
-  GSQueue *evaluation_queue = BLI_gsqueue_new(sizeof(OperationNode *));
-  auto schedule_node_to_queue = [&](OperationNode *node) {
-    BLI_gsqueue_push(evaluation_queue, &node);
-  };
-  schedule_graph(state, schedule_node_to_queue);
-
-  while (!BLI_gsqueue_is_empty(evaluation_queue)) {
-    OperationNode *operation_node;
-    BLI_gsqueue_pop(evaluation_queue, &operation_node);
-
-    evaluate_node(state, operation_node);
-    schedule_children(state, operation_node, schedule_node_to_queue);
-  }
-
-  BLI_gsqueue_free(evaluation_queue);
+  evaluate_graph_on_calling_thread(state);
 }
 
 void depsgraph_ensure_view_layer(Depsgraph *graph)
@@ -388,6 +475,8 @@ void deg_evaluate_on_refresh(Depsgraph *graph)
 
   graph->update_count++;
 
+  MEM_TagScope mem_tag_scope(MEM_TAG_DEPSGRAPH);
+
   graph->debug.begin_graph_evaluation();
 
 #ifdef WITH_PYTHON
@@ -457,6 +546,12 @@ void deg_evaluate_on_refresh(Depsgraph *graph)
     deg_eval_stats_aggregate(graph);
   }
 
+  /* Costs change slowly, no need to update the critical paths on every evaluation. This relies
+   * on the pending parents being computed again on the next evaluation. */
+  if (graph->update_count % DEG_CRITICAL_PATH_UPDATE_INTERVAL == 1) {
+    deg_eval_stats_update_critical_path(graph);
+  }
+
   /* Clear any uncleared tags. */
   deg_graph_clear_tags(graph);
   graph->is_evaluating = false;
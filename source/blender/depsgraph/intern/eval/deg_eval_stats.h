@@ -15,4 +15,10 @@ struct Depsgraph;
 /* Aggregate operation timings to overall component and ID nodes timing. */
 void deg_eval_stats_aggregate(Depsgraph *graph);
 
+/* Cost in seconds assumed for operations which were never evaluated. */
+#define DEG_UNKNOWN_OPERATION_COST 1e-3f
+
+/* Update #OperationNode.critical_path_cost from the estimated cost of the operations. */
+void deg_eval_stats_update_critical_path(Depsgraph *graph);
+
 }  // namespace blender::deg
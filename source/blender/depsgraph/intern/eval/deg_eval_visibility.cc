@@ -127,6 +127,7 @@ void deg_graph_flush_visibility_flags(Depsgraph *graph)
   for (OperationNode *op_node : graph->operations) {
     op_node->custom_flags = 0;
     op_node->num_links_pending = 0;
+    op_node->flag &= ~DEPSOP_FLAG_NEEDED_BY_VISIBLE_ID;
     for (Relation *rel : op_node->outlinks) {
       if ((rel->to->type == NodeType::OPERATION) && (rel->flag & RELATION_FLAG_CYCLIC) == 0) {
         ++op_node->num_links_pending;
@@ -166,6 +167,8 @@ void deg_graph_flush_visibility_flags(Depsgraph *graph)
         const bool target_possibly_affects_visible_id = comp_to->possibly_affects_visible_id;
 
         bool target_affects_visible_id = comp_to->affects_visible_id;
+        bool target_needed_by_visible_id = target_affects_visible_id ||
+                                           (op_to->flag & DEPSOP_FLAG_NEEDED_BY_VISIBLE_ID);
 
         /* This is a bit arbitrary but the idea here is following:
          *
@@ -180,6 +183,7 @@ void deg_graph_flush_visibility_flags(Depsgraph *graph)
          * something else. */
         if (comp_from != comp_to && (op_to->flag & DEPSOP_FLAG_MUTE)) {
           target_affects_visible_id = false;
+          target_needed_by_visible_id = false;
         }
 
         /* Visibility component forces all components of the current ID to be considered as
@@ -199,7 +203,20 @@ void deg_graph_flush_visibility_flags(Depsgraph *graph)
         }
         else {
           comp_from->possibly_affects_visible_id |= target_possibly_affects_visible_id;
-          comp_from->affects_visible_id |= target_affects_visible_id;
+
+          /* Only the operations a visible ID actually reads from are evaluated for other IDs, and
+           * within an ID only the operations leading to a needed operation. For example when a
+           * driver reads the location of a hidden object its geometry is not evaluated, and its
+           * transform component only up to the operation the driver depends on. */
+          const bool is_demand_driven = graph->use_visibility_optimization &&
+                                        (comp_from->owner != comp_to->owner ||
+                                         !target_affects_visible_id);
+          if (!is_demand_driven) {
+            comp_from->affects_visible_id |= target_affects_visible_id;
+          }
+          else if (target_needed_by_visible_id && !comp_from->affects_visible_id) {
+            op_from->flag |= DEPSOP_FLAG_NEEDED_BY_VISIBLE_ID;
+          }
         }
       }
     }
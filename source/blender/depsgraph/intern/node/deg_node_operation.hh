@@ -233,6 +233,10 @@ enum OperationFlag {
   /* Evaluation of the node is temporarily disabled. */
   DEPSOP_FLAG_MUTE = (1 << 5),
 
+  /* The operation is needed by a visible ID, even though its component doesn't affect visible IDs
+   * as a whole. Used to only evaluate the part of an invisible ID which visible IDs read from. */
+  DEPSOP_FLAG_NEEDED_BY_VISIBLE_ID = (1 << 6),
+
   /* Set of flags which gets flushed along the relations. */
   DEPSOP_FLAG_FLUSH = (DEPSOP_FLAG_USER_MODIFIED),
 
@@ -289,6 +293,14 @@ struct OperationNode : public Node {
   /* (OperationFlag) extra settings affecting evaluation. */
   int flag;
 
+  /* Estimated time in seconds needed to evaluate this operation, running average of previous
+   * evaluations. */
+  float eval_cost;
+  /* Estimated cost of the most expensive chain of operations starting at this one. Operations
+   * with a higher cost are scheduled first, so that long chains don't end up delaying the end of
+   * the evaluation. */
+  float critical_path_cost;
+
   DEG_DEPSNODE_DECLARE;
 };
 
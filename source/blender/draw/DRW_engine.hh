@@ -182,6 +182,9 @@ void DRW_cache_free_old_subdiv();
 /* For the OpenGL evaluators and garbage collected subdivision data. */
 void DRW_subdiv_free();
 
+/* For the compute shaders used by GPU mesh extraction. */
+void DRW_mesh_extract_gpu_free();
+
 }  // namespace blender::draw
 
 /* Never use this. Only for closing blender. */
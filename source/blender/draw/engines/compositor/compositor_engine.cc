@@ -3,6 +3,7 @@
  * SPDX-License-Identifier: GPL-2.0-or-later */
 
 #include "BLI_listbase.h"
+#include "BLI_math_matrix_types.hh"
 #include "BLI_math_vector_types.hh"
 #include "BLI_rect.h"
 #include "BLI_string_ref.hh"
@@ -18,6 +19,8 @@
 #include "DNA_vec_types.h"
 #include "DNA_view3d_types.h"
 
+#include "BKE_idtype.hh"
+
 #include "DEG_depsgraph_query.hh"
 
 #include "ED_view3d.hh"
@@ -52,6 +55,8 @@ class Context : public realtime_compositor::Context {
   /* A pointer to the info message of the compositor engine. This is a char array of size
    * GPU_INFO_SIZE. The message is cleared prior to updating or evaluating the compositor. */
   char *info_message_;
+  /* See are_input_textures_unchanged(). This is updated by the engine before every evaluation. */
+  bool input_textures_unchanged_ = false;
 
  public:
   Context(realtime_compositor::TexturePool &texture_pool, char *info_message)
@@ -84,6 +89,23 @@ class Context : public realtime_compositor::Context {
     return false;
   }
 
+  /* The viewport compositor is evaluated for every redraw, including when editing the node tree,
+   * so cache node results to only execute the nodes that changed and the nodes that follow. */
+  bool use_node_results_cache() const override
+  {
+    return true;
+  }
+
+  bool are_input_textures_unchanged() const override
+  {
+    return input_textures_unchanged_;
+  }
+
+  void set_input_textures_unchanged(bool unchanged)
+  {
+    input_textures_unchanged_ = unchanged;
+  }
+
   /* The viewport compositor doesn't really support the composite output, it only displays the
    * viewer output in the viewport. Settings this to false will make the compositor use the
    * composite output as fallback viewer if no other viewer exists. */
@@ -226,6 +248,13 @@ class Engine {
   /* Stores the compositing region size at the time the last compositor evaluation happened. See
    * the update_compositing_region_size method for more information. */
   int2 last_compositing_region_size_;
+  /* True if IDs that might affect the render passes were updated since the last evaluation. See
+   * the update method for more information. */
+  bool ids_updated_ = true;
+  /* Stores whether a redraw was requested at the time of the last evaluation as well as the view
+   * projection matrix used at that time. See the update_input_textures_state method. */
+  bool last_redraw_requested_ = true;
+  float4x4 last_projection_matrix_ = float4x4::identity();
 
  public:
   Engine(char *info_message)
@@ -235,10 +264,12 @@ class Engine {
   {
   }
 
-  /* Update the compositing region size and evaluate the compositor. */
+  /* Update the compositing region size and the state of the input textures, then evaluate the
+   * compositor. */
   void draw()
   {
     update_compositing_region_size();
+    update_input_textures_state();
     evaluator_.evaluate();
   }
 
@@ -257,12 +288,50 @@ class Engine {
     evaluator_.reset();
   }
 
-  /* If the compositor node tree changed, reset the evaluator. */
+  /* Determine if the render passes are unchanged since the last evaluation, such that cached
+   * results of nodes that depend on them can be used. The passes are assumed to be changed if the
+   * view changed, if IDs were updated, or if the render engine is still accumulating samples, in
+   * which case, it requests redraws. A redraw requested in the last evaluation means the passes
+   * were updated with a new sample since. */
+  void update_input_textures_state()
+  {
+    const bool redraw_requested = DRW_viewport_is_redraw_requested();
+    const float4x4 projection_matrix = float4x4(DRW_context_state_get()->rv3d->persmat);
+
+    const bool is_unchanged = !ids_updated_ && !redraw_requested && !last_redraw_requested_ &&
+                              projection_matrix == last_projection_matrix_ &&
+                              !DRW_state_is_navigating() && !DRW_state_is_playback();
+    context_.set_input_textures_unchanged(is_unchanged);
+
+    ids_updated_ = false;
+    last_redraw_requested_ = redraw_requested;
+    last_projection_matrix_ = projection_matrix;
+  }
+
+  /* If the compositor node tree changed, reset the evaluator. Also track if IDs that might affect
+   * the render passes were updated. Node tree updates also tag the ID types that embed node
+   * trees, like scenes and materials, so those can't be distinguished from node tree updates,
+   * however, changes to them are still detected through the redraws requested by the render
+   * engine, see the update_input_textures_state method. */
   void update(const Depsgraph *depsgraph)
   {
-    if (DEG_id_type_updated(depsgraph, ID_NT)) {
+    const bool node_tree_updated = DEG_id_type_updated(depsgraph, ID_NT);
+    if (node_tree_updated) {
       evaluator_.reset();
     }
+
+    int id_type_index = 0;
+    while (const short id_type = BKE_idtype_idcode_iter_step(&id_type_index)) {
+      if (node_tree_updated &&
+          ELEM(id_type, ID_NT, ID_SCE, ID_MA, ID_WO, ID_LA, ID_TE))
+      {
+        continue;
+      }
+      if (DEG_id_type_updated(depsgraph, id_type)) {
+        ids_updated_ = true;
+        return;
+      }
+    }
   }
 };
 
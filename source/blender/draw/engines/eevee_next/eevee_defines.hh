@@ -228,6 +228,7 @@
 #define VOLUME_HIT_COUNT_SLOT 1
 /* Only during shadow rendering. */
 #define SHADOW_ATLAS_IMG_SLOT 4
+#define SHADOW_ATLAS_STATIC_IMG_SLOT 5
 
 /* Uniform Buffers. */
 /* Slot 0 is GPU_NODE_TREE_UBO_SLOT. */
@@ -255,6 +256,7 @@
 /* Only during surface capture. */
 #define CAPTURE_BUF_SLOT 5
 /* Only during shadow rendering. */
+#define SHADOW_DYNAMIC_CASTERS_BUF_SLOT 2
 #define SHADOW_RENDER_MAP_BUF_SLOT 3
 #define SHADOW_PAGE_INFO_SLOT 4
 #define SHADOW_RENDER_VIEW_BUF_SLOT 5
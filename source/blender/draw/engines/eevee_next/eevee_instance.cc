@@ -11,6 +11,7 @@
 #include <sstream>
 
 #include "BKE_global.hh"
+#include "BKE_image.h"
 #include "BKE_object.hh"
 #include "BLI_rect.h"
 #include "BLT_translation.hh"
@@ -194,6 +195,12 @@ void Instance::begin_sync()
     return;
   }
 
+  if (!shader_images_loaded_) {
+    /* Load all material images in parallel, instead of one by one as the materials are synced. */
+    BKE_image_load_shader_images(DEG_get_bmain(depsgraph));
+    shader_images_loaded_ = true;
+  }
+
   /* Needs to be first for sun light parameters. */
   world.sync();
 
@@ -78,6 +78,8 @@ class Instance {
   bool overlays_enabled_ = false;
 
   bool shaders_are_ready_ = true;
+  /** Images used by materials have been loaded ahead of the first material sync. */
+  bool shader_images_loaded_ = false;
 
   /** Info string displayed at the top of the render / viewport, or the console when baking. */
   std::string info_ = "";
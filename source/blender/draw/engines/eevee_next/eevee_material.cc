@@ -11,6 +11,7 @@
 #include "BKE_lib_id.hh"
 #include "BKE_material.h"
 #include "BKE_node.hh"
+#include "BKE_object.hh"
 #include "NOD_shader.h"
 
 #include "eevee_instance.hh"
@@ -155,6 +156,66 @@ void MaterialModule::begin_sync()
 
   material_map_.clear();
   shader_map_.clear();
+  queued_materials_.clear();
+}
+
+/**
+ * Return the approximate fraction of the camera view covered by the object bounds, in [0..1].
+ */
+static float object_screen_coverage(const Camera &camera, Object *ob)
+{
+  const std::optional<Bounds<float3>> bounds = BKE_object_boundbox_get(ob);
+  if (!bounds) {
+    return 0.0f;
+  }
+
+  const float4x4 &view_matrix = camera.data_get().viewmat;
+  const float4x4 &projection_matrix = camera.data_get().winmat;
+
+  BoundBox bb;
+  BKE_boundbox_init_from_minmax(&bb, bounds->min, bounds->max);
+
+  int corners_behind = 0;
+  float2 screen_min(FLT_MAX);
+  float2 screen_max(-FLT_MAX);
+  for (float3 l_corner : bb.vec) {
+    float3 ws_corner = math::transform_point(ob->object_to_world(), l_corner);
+    /* Split view and projection for precision. */
+    float3 vs_corner = math::transform_point(view_matrix, ws_corner);
+    if (camera.is_perspective() && vs_corner.z >= -1.0e-8f) {
+      corners_behind++;
+      continue;
+    }
+    float2 ss_corner = math::project_point(projection_matrix, vs_corner).xy();
+    screen_min = math::min(screen_min, ss_corner);
+    screen_max = math::max(screen_max, ss_corner);
+  }
+
+  if (corners_behind == 8) {
+    return 0.0f;
+  }
+  if (corners_behind > 0) {
+    /* Bounds intersect the camera plane: the object very likely surrounds the view. */
+    return 1.0f;
+  }
+
+  screen_min = math::clamp(screen_min, float2(-1.0f), float2(1.0f));
+  screen_max = math::clamp(screen_max, float2(-1.0f), float2(1.0f));
+  const float2 extent = math::max(screen_max - screen_min, float2(0.0f));
+  return (extent.x * extent.y) / 4.0f;
+}
+
+void MaterialModule::queued_material_priority_update(Object *ob, const ::Material *blender_mat)
+{
+  const Vector<GPUMaterial *> *queued = queued_materials_.lookup_ptr(blender_mat);
+  if (queued == nullptr || (ob->visibility_flag & OB_HIDE_CAMERA)) {
+    return;
+  }
+  /* Keep a non-zero priority for visible objects so they are compiled before hidden ones. */
+  const float priority = 1.0f + object_screen_coverage(inst_.camera, ob);
+  for (GPUMaterial *gpumat : *queued) {
+    DRW_shader_queue_priority_raise(gpumat, priority);
+  }
 }
 
 MaterialPass MaterialModule::material_pass_get(Object *ob,
@@ -191,6 +252,7 @@ MaterialPass MaterialModule::material_pass_get(Object *ob,
     }
     case GPU_MAT_QUEUED:
       queued_shaders_count++;
+      queued_materials_.lookup_or_add_default(blender_mat).append(matpass.gpumat);
       matpass.gpumat = inst_.shaders.material_default_shader_get(pipeline_type, geometry_type);
       break;
     case GPU_MAT_FAILED:
@@ -269,6 +331,8 @@ Material &MaterialModule::material_sync(Object *ob,
       return mat;
     });
 
+    queued_material_priority_update(ob, blender_mat);
+
     /* Volume needs to use one sub pass per object to support layering. */
     VolumeLayer *layer = hide_on_camera ? nullptr :
                                           inst_.pipelines.volume.register_and_get_layer(ob);
@@ -391,6 +455,8 @@ Material &MaterialModule::material_sync(Object *ob,
     return mat;
   });
 
+  queued_material_priority_update(ob, blender_mat);
+
   if (mat.is_alpha_blend_transparent && !hide_on_camera) {
     /* Transparent needs to use one sub pass per object to support reordering.
      * NOTE: Pre-pass needs to be created first in order to be sorted first. */
@@ -359,6 +359,12 @@ class MaterialModule {
 
   MaterialArray material_array_;
 
+  /**
+   * GPU materials waiting in the deferred compilation queue, per Blender material.
+   * Used to raise their compilation priority for each visible object using them.
+   */
+  Map<const ::Material *, Vector<GPUMaterial *>> queued_materials_;
+
   DefaultSurfaceNodeTree default_surface_ntree_;
 
   ::Material *error_mat_;
@@ -385,6 +391,9 @@ class MaterialModule {
                           eMaterialGeometry geometry_type,
                           bool has_motion);
 
+  /** Compile queued shaders of the given material first if it covers a large part of the view. */
+  void queued_material_priority_update(Object *ob, const ::Material *blender_mat);
+
   /** Return correct material or empty default material if slot is empty. */
   ::Material *material_from_slot(Object *ob, int slot);
   MaterialPass material_pass_get(Object *ob,
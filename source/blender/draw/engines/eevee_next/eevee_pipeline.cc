@@ -232,6 +232,8 @@ void ShadowPipeline::sync()
       pass.bind_image(SHADOW_ATLAS_IMG_SLOT, inst_.shadows.atlas_tx_);
       pass.bind_ssbo(SHADOW_RENDER_MAP_BUF_SLOT, &inst_.shadows.render_map_buf_);
       pass.bind_ssbo(SHADOW_PAGE_INFO_SLOT, &inst_.shadows.pages_infos_data_);
+      pass.bind_image(SHADOW_ATLAS_STATIC_IMG_SLOT, inst_.shadows.atlas_static_tx_);
+      pass.bind_ssbo(SHADOW_DYNAMIC_CASTERS_BUF_SLOT, &inst_.shadows.dynamic_casters_bits_);
     }
     pass.bind_resources(inst_.uniform_data);
     pass.bind_resources(inst_.sampling);
@@ -1439,12 +1439,18 @@ struct ShadowTileData {
   bool is_rendered;
   /** True if the tile is inside the pages_cached_buf (mutually exclusive with `is_allocated`). */
   bool is_cached;
+  /**
+   * True if the page in the static atlas contains the depth of the static casters for this tile.
+   * Only used when the static shadow cache is enabled.
+   */
+  bool has_static_depth;
 };
 /** \note Stored packed as a uint. */
 #define ShadowTileDataPacked uint
 
 enum eShadowFlag : uint32_t {
   SHADOW_NO_DATA = 0u,
+  SHADOW_HAS_STATIC_DEPTH = (1u << 12u),
   SHADOW_IS_CACHED = (1u << 27u),
   SHADOW_IS_ALLOCATED = (1u << 28u),
   SHADOW_DO_UPDATE = (1u << 29u),
@@ -1452,6 +1458,17 @@ enum eShadowFlag : uint32_t {
   SHADOW_IS_USED = (1u << 31u)
 };
 
+/**
+ * Flags stored in the high bits of the packed pages inside the render map and the clear list.
+ * They are ignored by `shadow_page_unpack()`.
+ */
+enum eShadowPageFlag : uint32_t {
+  /** Static casters also write their depth to the static atlas page. */
+  SHADOW_PAGE_STATIC_WRITE = (1u << 29u),
+  /** Page is restored from the static atlas and only the dynamic casters are rendered. */
+  SHADOW_PAGE_STATIC_RESTORE = (1u << 30u),
+};
+
 /* NOTE: Trust the input to be in valid range (max is [3,3,255]).
  * If it is in valid range, it should pack to 12bits so that `shadow_tile_pack()` can use it.
  * But sometime this is used to encode invalid pages uint3(-1) and it needs to output uint(-1). */
@@ -1475,6 +1492,7 @@ static inline ShadowTileData shadow_tile_unpack(ShadowTileDataPacked data)
   ShadowTileData tile;
   tile.page = shadow_page_unpack(data);
   /* -- 12 bits -- */
+  tile.has_static_depth = (data & SHADOW_HAS_STATIC_DEPTH) != 0;
   /* Unused bits. */
   /* -- 15 bits -- */
   BLI_STATIC_ASSERT(SHADOW_MAX_PAGE <= 4096, "Update page packing")
@@ -1500,6 +1518,7 @@ static inline ShadowTileDataPacked shadow_tile_pack(ShadowTileData tile)
   data |= (tile.is_cached ? uint(SHADOW_IS_CACHED) : 0);
   data |= (tile.is_rendered ? uint(SHADOW_IS_RENDERED) : 0);
   data |= (tile.do_update ? uint(SHADOW_DO_UPDATE) : 0);
+  data |= (tile.has_static_depth ? uint(SHADOW_HAS_STATIC_DEPTH) : 0);
   return data;
 }
 
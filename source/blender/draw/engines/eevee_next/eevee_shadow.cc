@@ -578,6 +578,10 @@ void ShadowModule::init()
                     (inst_.is_image_render() ||
                      (!inst_.is_navigating() && !inst_.is_transforming() && !inst_.is_playback() &&
                       (scene.eevee.flag & SCE_EEVEE_SHADOW_JITTERED_VIEWPORT)));
+  /* The static cache doubles the atlas memory. Only use it where it can save a lot of redraws. */
+  use_static_cache_ = enable_shadow && inst_.is_viewport() && inst_.is_playback() &&
+                      (scene.eevee.flag & SCE_EEVEE_SHADOW_STATIC_CACHE) &&
+                      (ShadowModule::shadow_technique == ShadowTechnique::ATOMIC_RASTER);
   update_lights |= assign_if_different(enabled_, enable_shadow);
   update_lights |= assign_if_different(data_.use_jitter, bool32_t(use_jitter));
   if (update_lights) {
@@ -615,6 +619,22 @@ void ShadowModule::init()
         "Error: Could not allocate shadow atlas. Most likely out of GPU memory.");
   }
 
+  if (use_static_cache_) {
+    if (atlas_static_tx_.ensure_2d_array(atlas_type, atlas_extent, atlas_layers, tex_usage)) {
+      /* The static atlas content is undefined. Render everything to fill it. */
+      do_full_update_ = true;
+    }
+    if (!atlas_static_tx_.is_valid()) {
+      use_static_cache_ = false;
+      inst_.info_append_i18n(
+          "Error: Could not allocate static shadow cache. Most likely out of GPU memory.");
+    }
+  }
+  if (!use_static_cache_) {
+    /* Keep a dummy texture bound to the shaders. Release the memory otherwise. */
+    atlas_static_tx_.ensure_2d_array(atlas_type, int2(1), 1, tex_usage);
+  }
+
   /* Read end of the swap-chain to avoid stall. */
   if (inst_.is_viewport()) {
     if (inst_.sampling.finished_viewport()) {
@@ -662,6 +682,9 @@ void ShadowModule::begin_sync()
   curr_casters_updated_.clear();
   curr_casters_.clear();
   jittered_transparent_casters_.clear();
+  past_dynamic_casters_updated_.clear();
+  curr_dynamic_casters_updated_.clear();
+  dynamic_casters_.clear();
   update_casters_ = true;
 
   {
@@ -746,19 +769,40 @@ void ShadowModule::sync_object(const Object *ob,
   shadow_ob.used = true;
   const bool is_initialized = shadow_ob.resource_handle.raw != 0;
   const bool has_jittered_transparency = has_transparent_shadows && data_.use_jitter;
+  /* Updated casters are not rendered into the static cache. This avoids invalidating the cached
+   * depth of all the pages they touch at every frame of an animation. */
+  const bool is_dynamic = use_static_cache_ && is_initialized && handle.recalc;
   if (is_shadow_caster && (handle.recalc || !is_initialized || has_jittered_transparency)) {
     if (handle.recalc && is_initialized) {
-      past_casters_updated_.append(shadow_ob.resource_handle.raw);
+      if (shadow_ob.is_dynamic) {
+        past_dynamic_casters_updated_.append(shadow_ob.resource_handle.raw);
+      }
+      else {
+        /* The static cache still contains this caster. */
+        past_casters_updated_.append(shadow_ob.resource_handle.raw);
+      }
     }
 
     if (has_jittered_transparency) {
       jittered_transparent_casters_.append(resource_handle.raw);
     }
+    else if (is_dynamic) {
+      curr_dynamic_casters_updated_.append(resource_handle.raw);
+    }
     else {
       curr_casters_updated_.append(resource_handle.raw);
     }
   }
+  else if (is_shadow_caster && shadow_ob.is_dynamic) {
+    /* Caster stopped moving. Render it into the static cache. */
+    curr_casters_updated_.append(resource_handle.raw);
+  }
   shadow_ob.resource_handle = resource_handle;
+  shadow_ob.is_dynamic = is_shadow_caster && is_dynamic;
+
+  if (shadow_ob.is_dynamic) {
+    dynamic_casters_.append(resource_handle.resource_index());
+  }
 
   if (is_shadow_caster) {
     curr_casters_.append(resource_handle.raw);
@@ -821,6 +865,22 @@ void ShadowModule::end_sync()
   past_casters_updated_.push_update();
   curr_casters_updated_.push_update();
   jittered_transparent_casters_.push_update();
+  past_dynamic_casters_updated_.push_update();
+  curr_dynamic_casters_updated_.push_update();
+
+  {
+    /* Needs to contain a bit for every resource of the manager, even if there is no dynamic caster,
+     * as the shadow shader always reads it. */
+    const int64_t word_len = divide_ceil_u(inst_.manager->resource_handle_count(), 32);
+    if (word_len > dynamic_casters_bits_.size()) {
+      dynamic_casters_bits_.resize(power_of_2_max_u(word_len));
+    }
+    dynamic_casters_bits_.as_span().fill(0u);
+    for (const uint resource_index : dynamic_casters_) {
+      dynamic_casters_bits_[resource_index / 32] |= 1u << (resource_index % 32);
+    }
+    dynamic_casters_bits_.push_update();
+  }
 
   curr_casters_.push_update();
 
@@ -913,6 +973,7 @@ void ShadowModule::end_sync()
       pass.shader_set(inst_.shaders.static_shader_get(SHADOW_TILEMAP_TAG_UPDATE));
       pass.bind_ssbo("tilemaps_buf", tilemap_pool.tilemaps_data);
       pass.bind_ssbo("tiles_buf", tilemap_pool.tiles_data);
+      pass.push_constant("invalidate_static_depth", true);
       /* Past caster transforms. */
       if (past_casters_updated_.size() > 0) {
         pass.bind_ssbo("bounds_buf", &manager.bounds_buf.previous());
@@ -925,6 +986,20 @@ void ShadowModule::end_sync()
         pass.bind_ssbo("resource_ids_buf", curr_casters_updated_);
         pass.dispatch(int3(curr_casters_updated_.size(), 1, tilemap_pool.tilemaps_data.size()));
       }
+      /* Dynamic casters do not modify the static cache. */
+      pass.push_constant("invalidate_static_depth", false);
+      if (past_dynamic_casters_updated_.size() > 0) {
+        pass.bind_ssbo("bounds_buf", &manager.bounds_buf.previous());
+        pass.bind_ssbo("resource_ids_buf", past_dynamic_casters_updated_);
+        pass.dispatch(
+            int3(past_dynamic_casters_updated_.size(), 1, tilemap_pool.tilemaps_data.size()));
+      }
+      if (curr_dynamic_casters_updated_.size() > 0) {
+        pass.bind_ssbo("bounds_buf", &manager.bounds_buf.current());
+        pass.bind_ssbo("resource_ids_buf", curr_dynamic_casters_updated_);
+        pass.dispatch(
+            int3(curr_dynamic_casters_updated_.size(), 1, tilemap_pool.tilemaps_data.size()));
+      }
       pass.barrier(GPU_BARRIER_SHADER_STORAGE);
     }
 
@@ -938,6 +1013,7 @@ void ShadowModule::end_sync()
         pass.bind_ssbo("tiles_buf", tilemap_pool.tiles_data);
         pass.bind_ssbo("bounds_buf", &manager.bounds_buf.current());
         pass.bind_ssbo("resource_ids_buf", jittered_transparent_casters_);
+        pass.push_constant("invalidate_static_depth", true);
         pass.dispatch(
             int3(jittered_transparent_casters_.size(), 1, tilemap_pool.tilemaps_data.size()));
         pass.barrier(GPU_BARRIER_SHADER_STORAGE);
@@ -1046,6 +1122,7 @@ void ShadowModule::end_sync()
         sub.bind_ssbo("dst_coord_buf", &dst_coord_buf_);
         sub.bind_ssbo("src_coord_buf", &src_coord_buf_);
         sub.bind_ssbo("render_map_buf", &render_map_buf_);
+        sub.push_constant("use_static_cache", use_static_cache_);
         sub.dispatch(int3(1, 1, SHADOW_VIEW_MAX));
         sub.barrier(GPU_BARRIER_SHADER_STORAGE);
       }
@@ -1071,6 +1148,7 @@ void ShadowModule::end_sync()
         sub.bind_ssbo("pages_infos_buf", pages_infos_data_);
         sub.bind_ssbo("dst_coord_buf", dst_coord_buf_);
         sub.bind_image("shadow_atlas_img", atlas_tx_);
+        sub.bind_image("shadow_atlas_static_img", atlas_static_tx_);
         sub.dispatch(clear_dispatch_buf_);
         sub.barrier(GPU_BARRIER_SHADER_IMAGE_ACCESS);
       }
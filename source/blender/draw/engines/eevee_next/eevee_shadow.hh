@@ -166,6 +166,8 @@ struct ShadowTileMapPool {
 struct ShadowObject {
   ResourceHandle resource_handle = {0};
   bool used = true;
+  /** Object was updated during the last sync and was not rendered into the static cache. */
+  bool is_dynamic = false;
 };
 
 /** \} */
@@ -224,6 +226,16 @@ class ShadowModule {
   StorageVectorBuffer<uint, 128> past_casters_updated_ = {"PastCastersUpdated"};
   StorageVectorBuffer<uint, 128> curr_casters_updated_ = {"CurrCastersUpdated"};
   StorageVectorBuffer<uint, 128> jittered_transparent_casters_ = {"JitteredTransparentCasters"};
+  /**
+   * Same as above but for casters that only invalidate the rendered pages and keep the static
+   * cache intact. Only used when the static cache is enabled.
+   */
+  StorageVectorBuffer<uint, 128> past_dynamic_casters_updated_ = {"PastDynamicCastersUpdated"};
+  StorageVectorBuffer<uint, 128> curr_dynamic_casters_updated_ = {"CurrDynamicCastersUpdated"};
+  /** Resource IDs of casters that are not rendered into the static cache. */
+  Vector<uint> dynamic_casters_;
+  /** Bitmap of #dynamic_casters_ indexed by resource ID. */
+  StorageArrayBuffer<uint, 16> dynamic_casters_bits_ = {"DynamicCastersBits"};
   /** List of Resource IDs (to get bounds) for getting minimum clip-maps bounds. */
   StorageVectorBuffer<uint, 128> curr_casters_ = {"CurrCasters"};
 
@@ -258,6 +270,12 @@ class ShadowModule {
   static constexpr eGPUTextureFormat atlas_type = GPU_R32UI;
   /** Atlas containing all physical pages. */
   Texture atlas_tx_ = {"shadow_atlas_tx_"};
+  /**
+   * Depth of the static casters only, using the same layout as #atlas_tx_. Allows to re-render
+   * only the dynamic casters inside pages that have been invalidated by them.
+   * Only allocated when #use_static_cache_ is true.
+   */
+  Texture atlas_static_tx_ = {"shadow_atlas_static_tx_"};
 
   /** Pool of unallocated pages waiting to be assigned to specific tiles in the tile-map atlas. */
   ShadowPageHeapBuf pages_free_data_ = {"PagesFreeBuf"};
@@ -271,6 +289,8 @@ class ShadowModule {
   int rendering_tilemap_;
   int rendering_lod_;
   bool do_full_update_ = true;
+  /** Keep the depth of static casters in #atlas_static_tx_ during animation playback. */
+  bool use_static_cache_ = false;
 
   /** \} */
 
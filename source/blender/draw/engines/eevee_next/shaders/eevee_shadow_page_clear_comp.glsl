@@ -6,6 +6,7 @@
  * Virtual shadow-mapping: Page Clear.
  *
  * Equivalent to a frame-buffer depth clear but only for pages pushed to the clear_page_buf.
+ * When using the static shadow cache, pages can be restored from the static atlas instead.
  */
 
 #pragma BLENDER_REQUIRE(gpu_shader_utildefines_lib.glsl)
@@ -17,5 +18,13 @@ void main()
   uvec3 page_co = shadow_page_unpack(page_packed);
   page_co.xy = page_co.xy * SHADOW_PAGE_RES + gl_GlobalInvocationID.xy;
 
-  imageStoreFast(shadow_atlas_img, ivec3(page_co), uvec4(floatBitsToUint(FLT_MAX)));
+  uint depth = floatBitsToUint(FLT_MAX);
+  if (flag_test(page_packed, SHADOW_PAGE_STATIC_RESTORE)) {
+    depth = imageLoadFast(shadow_atlas_static_img, ivec3(page_co)).r;
+  }
+  else if (flag_test(page_packed, SHADOW_PAGE_STATIC_WRITE)) {
+    imageStoreFast(shadow_atlas_static_img, ivec3(page_co), uvec4(depth));
+  }
+
+  imageStoreFast(shadow_atlas_img, ivec3(page_co), uvec4(depth));
 }
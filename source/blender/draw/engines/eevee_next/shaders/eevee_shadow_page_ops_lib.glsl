@@ -45,6 +45,7 @@ void shadow_page_free(inout ShadowTileData tile)
   tile.page = uvec3(-1);
   tile.is_cached = false;
   tile.is_allocated = false;
+  tile.has_static_depth = false;
 }
 
 /* Remove last page from the free heap and give ownership to the tile. */
@@ -61,6 +62,8 @@ void shadow_page_alloc(inout ShadowTileData tile)
   tile.page = shadow_page_unpack(pages_free_buf[index]);
   tile.is_allocated = true;
   tile.do_update = true;
+  /* The static atlas page contains the depth of the previous owner. */
+  tile.has_static_depth = false;
   /* Remove from heap. */
   pages_free_buf[index] = uint(-1);
 }
@@ -9,6 +9,9 @@
  * This is done in 2 pass of this same shader. One for past object bounds and one for new object
  * bounds. The bounding boxes are roughly software rasterized (just a plain rectangle) in order to
  * tag the appropriate tiles.
+ *
+ * Static casters also invalidate the static depth of the tiles. Dynamic casters keep it so that
+ * the tiles can be restored from the static atlas before rendering only the dynamic casters.
  */
 
 #pragma BLENDER_REQUIRE(gpu_shader_utildefines_lib.glsl)
@@ -100,6 +103,9 @@ void main()
       for (int x = box_min.x; x <= box_max.x; x++) {
         int tile_index = shadow_tile_offset(uvec2(x, y), tilemap.tiles_index, lod);
         atomicOr(tiles_buf[tile_index], uint(SHADOW_DO_UPDATE));
+        if (invalidate_static_depth) {
+          atomicAnd(tiles_buf[tile_index], ~uint(SHADOW_HAS_STATIC_DEPTH));
+        }
       }
     }
   }
@@ -22,6 +22,7 @@ ShadowTileDataPacked init_tile_data(ShadowTileDataPacked tile, bool do_update)
   }
   if (do_update) {
     tile |= SHADOW_DO_UPDATE;
+    tile &= ~SHADOW_HAS_STATIC_DEPTH;
   }
   tile &= ~SHADOW_IS_USED;
   return tile;
@@ -42,6 +42,12 @@ void main()
     if (all(lessThan(relative_tile_co, viewport_size))) {
       bool do_page_render = tile.is_used && tile.do_update;
       uint page_packed = shadow_page_pack(tile.page);
+      if (use_static_cache) {
+        /* Only render the dynamic casters on top of the static depth if it is still valid.
+         * Otherwise render everything and store the static casters depth for the next update. */
+        page_packed |= tile.has_static_depth ? SHADOW_PAGE_STATIC_RESTORE :
+                                               SHADOW_PAGE_STATIC_WRITE;
+      }
       /* Add page to render map. */
       int render_page_index = shadow_render_page_index_get(view_index, relative_tile_co);
       render_map_buf[render_page_index] = do_page_render ? page_packed : 0xFFFFFFFFu;
@@ -57,6 +63,9 @@ void main()
             uvec4(relative_tile_co.x, relative_tile_co.y, view_index, 0));
         /* Tag tile as rendered. Should be safe since only one thread is reading and writing.  */
         tiles_buf[tile_index] |= SHADOW_IS_RENDERED;
+        if (use_static_cache) {
+          tiles_buf[tile_index] |= SHADOW_HAS_STATIC_DEPTH;
+        }
         /* Statistics. */
         atomicAdd(statistics_buf.page_rendered_count, 1);
       }
@@ -71,6 +71,16 @@ void main()
 
   int render_page_index = shadow_render_page_index_get(view_index, tile_co);
   uint page_packed = render_map_buf[render_page_index];
+  uint page_flags = page_packed & (SHADOW_PAGE_STATIC_WRITE | SHADOW_PAGE_STATIC_RESTORE);
+  page_packed &= ~page_flags;
+
+  /* Static casters are only rendered into pages that have no cached static depth. */
+  uint caster_id = uint(resource_id);
+  uint dynamic_bits = shadow_dynamic_casters_buf[caster_id / 32u];
+  bool is_static_caster = !flag_test(dynamic_bits, 1u << (caster_id % 32u));
+  if (is_static_caster && flag_test(page_flags, SHADOW_PAGE_STATIC_RESTORE)) {
+    discard_result;
+  }
 
   ivec3 page = ivec3(shadow_page_unpack(page_packed));
   /* If the page index is invalid this page shouldn't be rendered,
@@ -83,6 +93,9 @@ void main()
 
   uint u_depth = floatBitsToUint(linear_depth);
   imageAtomicMin(shadow_atlas_img, out_texel, u_depth);
+  if (is_static_caster && flag_test(page_flags, SHADOW_PAGE_STATIC_WRITE)) {
+    imageAtomicMin(shadow_atlas_static_img, out_texel, u_depth);
+  }
 #endif
 
 #ifdef SHADOW_UPDATE_TBDR
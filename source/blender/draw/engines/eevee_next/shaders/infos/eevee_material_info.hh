@@ -279,11 +279,20 @@ GPU_SHADER_CREATE_INFO(eevee_surf_shadow_atomic)
                  Qualifier::READ,
                  "uint",
                  "render_map_buf[SHADOW_RENDER_MAP_SIZE]")
+    .storage_buf(SHADOW_DYNAMIC_CASTERS_BUF_SLOT,
+                 Qualifier::READ,
+                 "uint",
+                 "shadow_dynamic_casters_buf[]")
     .image(SHADOW_ATLAS_IMG_SLOT,
            GPU_R32UI,
            Qualifier::READ_WRITE,
            ImageType::UINT_2D_ARRAY_ATOMIC,
-           "shadow_atlas_img");
+           "shadow_atlas_img")
+    .image(SHADOW_ATLAS_STATIC_IMG_SLOT,
+           GPU_R32UI,
+           Qualifier::READ_WRITE,
+           ImageType::UINT_2D_ARRAY_ATOMIC,
+           "shadow_atlas_static_img");
 
 GPU_SHADER_CREATE_INFO(eevee_surf_shadow_tbdr)
     .additional_info("eevee_surf_shadow")
@@ -55,6 +55,7 @@ GPU_SHADER_CREATE_INFO(eevee_shadow_tag_update)
     .storage_buf(1, Qualifier::READ_WRITE, SHADOW_TILE_DATA_PACKED, "tiles_buf[]")
     .storage_buf(5, Qualifier::READ, "ObjectBounds", "bounds_buf[]")
     .storage_buf(6, Qualifier::READ, "uint", "resource_ids_buf[]")
+    .push_constant(Type::BOOL, "invalidate_static_depth")
     .additional_info("eevee_shared", "draw_view", "draw_view_culling")
     .compute_source("eevee_shadow_tag_update_comp.glsl");
 
@@ -197,6 +198,7 @@ GPU_SHADER_CREATE_INFO(eevee_shadow_tilemap_rendermap)
     .storage_buf(5, Qualifier::WRITE, SHADOW_PAGE_PACKED, "dst_coord_buf[SHADOW_RENDER_MAP_SIZE]")
     .storage_buf(6, Qualifier::WRITE, SHADOW_PAGE_PACKED, "src_coord_buf[SHADOW_RENDER_MAP_SIZE]")
     .storage_buf(7, Qualifier::WRITE, SHADOW_PAGE_PACKED, "render_map_buf[SHADOW_RENDER_MAP_SIZE]")
+    .push_constant(Type::BOOL, "use_static_cache")
     .additional_info("eevee_shared")
     .compute_source("eevee_shadow_tilemap_rendermap_comp.glsl");
 
@@ -223,7 +225,12 @@ GPU_SHADER_CREATE_INFO(eevee_shadow_page_clear)
            GPU_R32UI,
            Qualifier::READ_WRITE,
            ImageType::UINT_2D_ARRAY_ATOMIC,
-           "shadow_atlas_img");
+           "shadow_atlas_img")
+    .image(SHADOW_ATLAS_STATIC_IMG_SLOT,
+           GPU_R32UI,
+           Qualifier::READ_WRITE,
+           ImageType::UINT_2D_ARRAY_ATOMIC,
+           "shadow_atlas_static_img");
 
 /* TBDR clear implementation. */
 GPU_SHADER_CREATE_INFO(eevee_shadow_page_tile_clear)
@@ -282,6 +282,12 @@ GPUMaterial *DRW_shader_from_material(
     void *thunk,
     GPUMaterialPassReplacementCallbackFn pass_replacement_cb = nullptr);
 void DRW_shader_queue_optimize_material(GPUMaterial *mat);
+/**
+ * Raise the deferred compilation priority of a queued material.
+ * Materials with the highest priority are compiled first. Does nothing if the material is not
+ * waiting in the compilation queue.
+ */
+void DRW_shader_queue_priority_raise(GPUMaterial *mat, float priority);
 void DRW_shader_free(GPUShader *shader);
 #define DRW_SHADER_FREE_SAFE(shader) \
   do { \
@@ -747,6 +753,11 @@ DefaultTextureList *DRW_viewport_texture_list_get();
 blender::draw::TextureFromPool &DRW_viewport_pass_texture_get(const char *pass_name);
 
 void DRW_viewport_request_redraw();
+/**
+ * Returns true if a redraw of the viewport was requested, for instance, by a render engine that
+ * didn't finish accumulating its samples.
+ */
+bool DRW_viewport_is_redraw_requested();
 
 void DRW_render_to_image(RenderEngine *engine, Depsgraph *depsgraph);
 void DRW_render_object_iter(
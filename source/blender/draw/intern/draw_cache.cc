@@ -17,15 +17,20 @@
 #include "DNA_particle_types.h"
 #include "DNA_pointcloud_types.h"
 #include "DNA_scene_types.h"
+#include "DNA_userdef_types.h"
 #include "DNA_volume_types.h"
 
 #include "UI_resources.hh"
 
+#include "BLI_math_matrix.hh"
 #include "BLI_utildefines.h"
 
+#include "BKE_mesh_types.hh"
 #include "BKE_object.hh"
 #include "BKE_paint.hh"
 
+#include "ED_view3d.hh"
+
 #include "GPU_batch.hh"
 #include "GPU_batch_utils.hh"
 #include "GPU_capabilities.hh"
@@ -33,6 +38,7 @@
 #include "MEM_guardedalloc.h"
 
 #include "draw_cache.hh"
+#include "draw_cache_extract.hh"
 #include "draw_cache_impl.hh"
 #include "draw_manager_c.hh"
 
@@ -909,10 +915,70 @@ blender::gpu::Batch *DRW_cache_object_loose_edges_get(Object *ob)
   }
 }
 
+/** Meshes with fewer faces are always drawn at full resolution. */
+static constexpr int mesh_lod_min_faces = 20000;
+/** Radius of the object bounds on screen (in pixels) below which each LOD level is used. */
+static constexpr float mesh_lod_screen_radius[MESH_LOD_LEVELS] = {200.0f, 50.0f};
+
+/**
+ * Return the decimated mesh to draw instead of the object's mesh, based on its size on screen.
+ * Returns nullptr if the full resolution mesh should be drawn.
+ */
+static Mesh *mesh_lod_get(Object *ob)
+{
+  using namespace blender;
+  if (!USER_EXPERIMENTAL_TEST(&U, use_viewport_mesh_lod)) {
+    return nullptr;
+  }
+  const RegionView3D *rv3d = DST.draw_ctx.rv3d;
+  if (rv3d == nullptr || DRW_state_is_image_render() || DRW_state_is_select() ||
+      DRW_state_is_depth())
+  {
+    return nullptr;
+  }
+  /* Modes editing or painting the mesh need the full resolution. */
+  if (ob->mode != OB_MODE_OBJECT) {
+    return nullptr;
+  }
+  Mesh &mesh = *static_cast<Mesh *>(ob->data);
+  if (mesh.runtime->edit_mesh != nullptr || mesh.faces_num < mesh_lod_min_faces) {
+    return nullptr;
+  }
+  const std::optional<Bounds<float3>> bounds = BKE_object_boundbox_get(ob);
+  if (!bounds) {
+    return nullptr;
+  }
+  const float4x4 &object_to_world = ob->object_to_world();
+  const float3 center = math::transform_point(object_to_world,
+                                              math::midpoint(bounds->min, bounds->max));
+  const float radius = math::distance(bounds->min, bounds->max) * 0.5f *
+                       math::reduce_max(math::to_scale(object_to_world));
+  const float pixel_size = ED_view3d_pixel_size_no_ui_scale(rv3d, center);
+  if (pixel_size <= 0.0f) {
+    /* Center is behind the view. */
+    return nullptr;
+  }
+  const float screen_radius = radius / pixel_size;
+
+  int level = -1;
+  for (const int i : IndexRange(MESH_LOD_LEVELS)) {
+    if (screen_radius < mesh_lod_screen_radius[i]) {
+      level = i;
+    }
+  }
+  if (level == -1) {
+    return nullptr;
+  }
+  return draw::DRW_mesh_batch_cache_lod_get(*ob, mesh, level);
+}
+
 blender::gpu::Batch *DRW_cache_object_surface_get(Object *ob)
 {
   switch (ob->type) {
     case OB_MESH:
+      if (Mesh *lod_mesh = mesh_lod_get(ob)) {
+        return blender::draw::DRW_mesh_batch_cache_get_surface(*lod_mesh);
+      }
       return DRW_cache_mesh_surface_get(ob);
     default:
       return nullptr;
@@ -975,6 +1041,10 @@ blender::gpu::Batch **DRW_cache_object_surface_material_get(Object *ob,
 {
   switch (ob->type) {
     case OB_MESH:
+      if (Mesh *lod_mesh = mesh_lod_get(ob)) {
+        return blender::draw::DRW_mesh_batch_cache_get_surface_shaded(
+            *ob, *lod_mesh, gpumat_array, gpumat_array_len);
+      }
       return DRW_cache_mesh_surface_shaded_get(ob, gpumat_array, gpumat_array_len);
     default:
       return nullptr;
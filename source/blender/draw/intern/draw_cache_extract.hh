@@ -25,6 +25,10 @@ namespace blender::draw {
 
 struct MeshRenderData;
 struct DRWSubdivCache;
+struct MeshLODCache;
+
+/** Number of decimated versions of a mesh, not counting the full resolution mesh. */
+#define MESH_LOD_LEVELS 2
 
 /* Vertex Group Selection and display options */
 struct DRW_MeshWeightState {
@@ -241,6 +245,9 @@ struct MeshBatchCache {
 
   DRWSubdivCache *subdiv_cache;
 
+  /** Decimated versions of the mesh, generated on demand. */
+  MeshLODCache *lod_cache;
+
   DRWBatchFlag batch_requested;
   DRWBatchFlag batch_ready;
 
@@ -296,6 +303,20 @@ void mesh_buffer_cache_create_requested(TaskGraph &task_graph,
                                         const ToolSettings *ts,
                                         bool use_hide);
 
+/**
+ * Return the decimated mesh of the given level (0 being the least decimated one), with a valid
+ * batch cache. Returns nullptr while the levels are being generated in the background.
+ */
+Mesh *mesh_lod_cache_get(MeshLODCache *&lod_cache, Object &object, const Mesh &mesh, int level);
+/** Create the batches requested from the decimated meshes. */
+void mesh_lod_cache_create_requested(TaskGraph &task_graph,
+                                     Object &object,
+                                     MeshLODCache *lod_cache,
+                                     const Scene &scene);
+/** Regenerate the levels the next time they are requested. */
+void mesh_lod_cache_tag_dirty(MeshLODCache *lod_cache);
+void mesh_lod_cache_free(MeshLODCache *lod_cache);
+
 void mesh_buffer_cache_create_requested_subdiv(MeshBatchCache &cache,
                                                MeshBufferCache &mbc,
                                                DRWSubdivCache &subdiv_cache,
@@ -207,7 +207,24 @@ void mesh_buffer_cache_create_requested(TaskGraph &task_graph,
       new MeshRenderDataUpdateTaskData{std::move(mr_ptr), mbc},
       [](void *task_data) { delete static_cast<MeshRenderDataUpdateTaskData *>(task_data); });
 
-  if (DRW_vbo_requested(buffers.vbo.pos)) {
+  /* Very dense meshes expand their per vertex data on the GPU. This has to happen on this thread
+   * since it owns the GPU context, the task graph is only used for CPU side extraction. */
+  const bool use_gpu_extraction = (DRW_vbo_requested(buffers.vbo.pos) ||
+                                   DRW_vbo_requested(buffers.vbo.vnor)) &&
+                                  mesh_extract_gpu_supported(*mr);
+  if (use_gpu_extraction) {
+    mesh_render_data_update_loose_geom(*mr, mbc);
+    gpu::VertBuf *vert_indices = extract_gpu_vert_indices_create(*mr);
+    if (DRW_vbo_requested(buffers.vbo.pos)) {
+      extract_positions_gpu(*mr, *vert_indices, *buffers.vbo.pos);
+    }
+    if (DRW_vbo_requested(buffers.vbo.vnor)) {
+      extract_vert_normals_gpu(*mr, *vert_indices, *buffers.vbo.vnor);
+    }
+    GPU_vertbuf_discard(vert_indices);
+  }
+
+  if (DRW_vbo_requested(buffers.vbo.pos) && !use_gpu_extraction) {
     struct TaskData {
       MeshRenderData &mr;
       MeshBufferCache &mbc;
@@ -253,7 +270,7 @@ void mesh_buffer_cache_create_requested(TaskGraph &task_graph,
         [](void *task_data) { delete static_cast<TaskData *>(task_data); });
     BLI_task_graph_edge_create(task_node_mesh_render_data, task_node);
   }
-  if (DRW_vbo_requested(buffers.vbo.vnor)) {
+  if (DRW_vbo_requested(buffers.vbo.vnor) && !use_gpu_extraction) {
     struct TaskData {
       MeshRenderData &mr;
       MeshBufferList &buffers;
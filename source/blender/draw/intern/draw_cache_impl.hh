@@ -195,6 +195,11 @@ blender::gpu::Batch *DRW_mesh_batch_cache_get_all_edges(Mesh &mesh);
 blender::gpu::Batch *DRW_mesh_batch_cache_get_loose_edges(Mesh &mesh);
 blender::gpu::Batch *DRW_mesh_batch_cache_get_edge_detection(Mesh &mesh, bool *r_is_manifold);
 blender::gpu::Batch *DRW_mesh_batch_cache_get_surface(Mesh &mesh);
+/**
+ * Decimated version of the mesh used to draw it when it is small on screen, see
+ * #MESH_LOD_LEVELS. Returns nullptr while it is being generated.
+ */
+Mesh *DRW_mesh_batch_cache_lod_get(Object &object, Mesh &mesh, int level);
 blender::gpu::Batch *DRW_mesh_batch_cache_get_surface_edges(Object &object, Mesh &mesh);
 blender::gpu::Batch **DRW_mesh_batch_cache_get_surface_shaded(Object &object,
                                                               Mesh &mesh,
@@ -721,6 +721,60 @@ static void mesh_batch_cache_discard_uvedit_select(MeshBatchCache &cache)
   mesh_batch_cache_discard_batch(cache, batch_map);
 }
 
+/**
+ * Discard the buffers depending on vertex positions, keeping the ones that only depend on the
+ * topology or on other attributes (selection, UVs, indices...). The tessellation can change with
+ * the positions, so the buffers built from triangles are discarded too.
+ */
+static void mesh_batch_cache_discard_deform(MeshBatchCache &cache)
+{
+  FOREACH_MESH_BUFFER_CACHE (cache, mbc) {
+    GPU_VERTBUF_DISCARD_SAFE(mbc->buff.vbo.pos);
+    GPU_VERTBUF_DISCARD_SAFE(mbc->buff.vbo.nor);
+    GPU_VERTBUF_DISCARD_SAFE(mbc->buff.vbo.vnor);
+    GPU_VERTBUF_DISCARD_SAFE(mbc->buff.vbo.edge_fac);
+    GPU_VERTBUF_DISCARD_SAFE(mbc->buff.vbo.tan);
+    GPU_VERTBUF_DISCARD_SAFE(mbc->buff.vbo.orco);
+    GPU_VERTBUF_DISCARD_SAFE(mbc->buff.vbo.mesh_analysis);
+    GPU_VERTBUF_DISCARD_SAFE(mbc->buff.vbo.fdots_pos);
+    GPU_VERTBUF_DISCARD_SAFE(mbc->buff.vbo.fdots_nor);
+    GPU_VERTBUF_DISCARD_SAFE(mbc->buff.vbo.edituv_stretch_area);
+    GPU_VERTBUF_DISCARD_SAFE(mbc->buff.vbo.edituv_stretch_angle);
+    /* Generic attributes may reference the position attribute. */
+    for (int i = 0; i < GPU_MAX_ATTR; i++) {
+      GPU_VERTBUF_DISCARD_SAFE(mbc->buff.vbo.attr[i]);
+    }
+    GPU_VERTBUF_DISCARD_SAFE(mbc->buff.vbo.attr_viewer);
+    GPU_INDEXBUF_DISCARD_SAFE(mbc->buff.ibo.tris);
+    GPU_INDEXBUF_DISCARD_SAFE(mbc->buff.ibo.lines_adjacency);
+    GPU_INDEXBUF_DISCARD_SAFE(mbc->buff.ibo.edituv_tris);
+  }
+  for (int i = 0; i < cache.mat_len; i++) {
+    GPU_INDEXBUF_DISCARD_SAFE(cache.tris_per_mat[i]);
+  }
+
+  DRWBatchFlag batch_map = BATCH_MAP(vbo.pos,
+                                     vbo.nor,
+                                     vbo.vnor,
+                                     vbo.edge_fac,
+                                     vbo.tan,
+                                     vbo.orco,
+                                     vbo.mesh_analysis,
+                                     vbo.fdots_pos,
+                                     vbo.fdots_nor,
+                                     vbo.attr_viewer);
+  batch_map |= BATCH_MAP(vbo.edituv_stretch_area,
+                         vbo.edituv_stretch_angle,
+                         vbo.attr[0],
+                         ibo.tris,
+                         ibo.lines_adjacency,
+                         ibo.edituv_tris);
+  mesh_batch_cache_discard_batch(cache, batch_map | MBC_SURFACE_PER_MAT);
+
+  cache.tot_area = 0.0f;
+  cache.tot_uv_area = 0.0f;
+}
+
 void DRW_mesh_batch_cache_dirty_tag(Mesh *mesh, eMeshBatchDirtyMode mode)
 {
   if (!mesh->runtime->batch_cache) {
@@ -754,6 +808,15 @@ void DRW_mesh_batch_cache_dirty_tag(Mesh *mesh, eMeshBatchDirtyMode mode)
     case BKE_MESH_BATCH_DIRTY_ALL:
       cache.is_dirty = true;
       break;
+    case BKE_MESH_BATCH_DIRTY_DEFORM:
+      mesh_lod_cache_tag_dirty(cache.lod_cache);
+      if (cache.subdiv_cache != nullptr) {
+        /* GPU subdivision caches its own evaluation of the positions. */
+        cache.is_dirty = true;
+        break;
+      }
+      mesh_batch_cache_discard_deform(cache);
+      break;
     case BKE_MESH_BATCH_DIRTY_SHADING:
       mesh_batch_cache_discard_shaded_tri(cache);
       mesh_batch_cache_discard_uvedit(cache);
@@ -828,6 +891,9 @@ static void mesh_batch_cache_clear(MeshBatchCache &cache)
   drw_mesh_weight_state_clear(&cache.weight_state);
 
   mesh_batch_cache_free_subdiv_cache(cache);
+
+  mesh_lod_cache_free(cache.lod_cache);
+  cache.lod_cache = nullptr;
 }
 
 void DRW_mesh_batch_cache_free(void *batch_cache)
@@ -903,6 +969,12 @@ gpu::Batch *DRW_mesh_batch_cache_get_surface(Mesh &mesh)
   return cache.batch.surface;
 }
 
+Mesh *DRW_mesh_batch_cache_lod_get(Object &object, Mesh &mesh, const int level)
+{
+  MeshBatchCache &cache = *mesh_batch_cache_get(mesh);
+  return mesh_lod_cache_get(cache.lod_cache, object, mesh, level);
+}
+
 gpu::Batch *DRW_mesh_batch_cache_get_loose_edges(Mesh &mesh)
 {
   MeshBatchCache &cache = *mesh_batch_cache_get(mesh);
@@ -1339,6 +1411,9 @@ void DRW_mesh_batch_cache_create_requested(TaskGraph &task_graph,
   MeshBatchCache &cache = *mesh_batch_cache_get(mesh);
   bool cd_uv_update = false;
 
+  /* Decimated meshes can be requested even when no batch of the mesh itself is. */
+  mesh_lod_cache_create_requested(task_graph, ob, cache.lod_cache, scene);
+
   /* Early out */
   if (cache.batch_requested == 0) {
 #ifndef NDEBUG
@@ -0,0 +1,145 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup draw
+ *
+ * \brief Decimated versions of meshes used to draw objects that are small on screen.
+ *
+ * The decimation is expensive, so it runs in a background task. Until it has finished the full
+ * resolution mesh is drawn.
+ */
+
+#include <array>
+#include <atomic>
+
+#include "MEM_guardedalloc.h"
+
+#include "BLI_index_range.hh"
+#include "BLI_task.h"
+
+#include "DNA_mesh_types.h"
+
+#include "BKE_lib_id.hh"
+#include "BKE_mesh.h"
+#include "BKE_mesh.hh"
+#include "BKE_mesh_types.hh"
+
+#include "bmesh.hh"
+#include "bmesh_tools.hh"
+
+#include "draw_cache_extract.hh"
+#include "draw_cache_impl.hh"
+
+namespace blender::draw {
+
+/** Ratio of faces kept for each LOD level. */
+static constexpr std::array<float, MESH_LOD_LEVELS> lod_face_ratios = {0.25f, 0.05f};
+
+struct MeshLODCache {
+  TaskPool *task_pool = nullptr;
+  /** Copy of the mesh to decimate, owned by the background task. */
+  Mesh *source = nullptr;
+  std::array<Mesh *, MESH_LOD_LEVELS> meshes = {};
+  /** Set by the background task when all levels have been generated. */
+  std::atomic<bool> is_ready = false;
+  /** Positions of the source mesh have changed and the levels are outdated. */
+  std::atomic<bool> is_dirty = false;
+};
+
+static Mesh *mesh_lod_decimate(const Mesh &mesh, const float face_ratio)
+{
+  BMeshCreateParams create_params{};
+  BMeshFromMeshParams convert_params{};
+  convert_params.calc_face_normal = true;
+  convert_params.calc_vert_normal = true;
+  BMesh *bm = BKE_mesh_to_bmesh_ex(&mesh, &create_params, &convert_params);
+  BM_mesh_decimate_collapse(bm, face_ratio, nullptr, 0.0f, false, -1, 0.0f);
+  Mesh *result = BKE_mesh_from_bmesh_for_eval_nomain(bm, nullptr, &mesh);
+  BM_mesh_free(bm);
+  return result;
+}
+
+static void mesh_lod_generate_task(TaskPool *__restrict pool, void *taskdata)
+{
+  MeshLODCache &lod_cache = *static_cast<MeshLODCache *>(taskdata);
+  for (const int level : IndexRange(MESH_LOD_LEVELS)) {
+    if (BLI_task_pool_current_canceled(pool)) {
+      return;
+    }
+    lod_cache.meshes[level] = mesh_lod_decimate(*lod_cache.source, lod_face_ratios[level]);
+  }
+  lod_cache.is_ready = true;
+}
+
+static MeshLODCache *mesh_lod_cache_create(const Mesh &mesh)
+{
+  MeshLODCache *lod_cache = MEM_new<MeshLODCache>(__func__);
+  /* Cheap because of implicit sharing, and makes the task independent of the evaluated mesh which
+   * can be freed or modified while the task runs. */
+  lod_cache->source = BKE_mesh_copy_for_eval(mesh);
+  lod_cache->task_pool = BLI_task_pool_create_background(nullptr, TASK_PRIORITY_LOW);
+  BLI_task_pool_push(lod_cache->task_pool, mesh_lod_generate_task, lod_cache, false, nullptr);
+  return lod_cache;
+}
+
+void mesh_lod_cache_free(MeshLODCache *lod_cache)
+{
+  if (lod_cache == nullptr) {
+    return;
+  }
+  BLI_task_pool_cancel(lod_cache->task_pool);
+  BLI_task_pool_free(lod_cache->task_pool);
+  for (Mesh *mesh : lod_cache->meshes) {
+    if (mesh) {
+      BKE_id_free(nullptr, mesh);
+    }
+  }
+  BKE_id_free(nullptr, lod_cache->source);
+  MEM_delete(lod_cache);
+}
+
+void mesh_lod_cache_tag_dirty(MeshLODCache *lod_cache)
+{
+  if (lod_cache) {
+    lod_cache->is_dirty = true;
+  }
+}
+
+Mesh *mesh_lod_cache_get(MeshLODCache *&lod_cache, Object &object, const Mesh &mesh, int level)
+{
+  BLI_assert(level >= 0 && level < MESH_LOD_LEVELS);
+  if (lod_cache && lod_cache->is_dirty) {
+    mesh_lod_cache_free(lod_cache);
+    lod_cache = nullptr;
+  }
+  if (lod_cache == nullptr) {
+    lod_cache = mesh_lod_cache_create(mesh);
+    return nullptr;
+  }
+  if (!lod_cache->is_ready) {
+    return nullptr;
+  }
+  Mesh *lod_mesh = lod_cache->meshes[level];
+  DRW_mesh_batch_cache_validate(object, *lod_mesh);
+  return lod_mesh;
+}
+
+void mesh_lod_cache_create_requested(TaskGraph &task_graph,
+                                     Object &object,
+                                     MeshLODCache *lod_cache,
+                                     const Scene &scene)
+{
+  if (lod_cache == nullptr || !lod_cache->is_ready) {
+    return;
+  }
+  for (Mesh *lod_mesh : lod_cache->meshes) {
+    if (lod_mesh->runtime->batch_cache == nullptr) {
+      continue;
+    }
+    DRW_mesh_batch_cache_create_requested(task_graph, object, *lod_mesh, scene, false, false);
+  }
+}
+
+}  // namespace blender::draw
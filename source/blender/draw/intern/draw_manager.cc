@@ -205,6 +205,35 @@ void Manager::submit(PassMain &pass, View &view)
   state.cleanup();
 }
 
+void Manager::submit_occluded(PassMain &pass,
+                              View &view,
+                              GPUTexture *hiz_tx,
+                              float2 hiz_uv_scale)
+{
+  view.bind();
+
+  debug_bind();
+
+  view.compute_visibility_occluded(bounds_buf.current(), resource_len_, hiz_tx, hiz_uv_scale);
+
+  command::RecordingState state;
+  state.inverted_view = view.is_inverted();
+
+  pass.draw_commands_buf_.bind(state,
+                               pass.headers_,
+                               pass.commands_,
+                               view.get_visibility_buffer(),
+                               view.visibility_word_per_draw(),
+                               view.view_len_,
+                               pass.use_custom_ids);
+
+  resource_bind();
+
+  pass.submit(state);
+
+  state.cleanup();
+}
+
 void Manager::submit(PassSortable &pass, View &view)
 {
   pass.sort();
@@ -199,6 +199,15 @@ class Manager {
   void submit(PassSimple &pass, View &view);
   void submit(PassMain &pass, View &view);
   void submit(PassSortable &pass, View &view);
+  /**
+   * Second phase of the occlusion culling (see #View::occlusion_culling_set).
+   * Submit the resources of `pass` that were occluded during the last `submit` using `view` but
+   * are not occluded by `hiz_tx`. `hiz_tx` is expected to contain the depth of the first phase.
+   */
+  void submit_occluded(PassMain &pass,
+                       View &view,
+                       GPUTexture *hiz_tx,
+                       float2 hiz_uv_scale = float2(1.0f));
   /**
    * Variant without any view. Must not contain any shader using `draw_view` create info.
    */
@@ -30,6 +30,7 @@
 #include "BKE_global.hh"
 #include "BKE_gpencil_legacy.h"
 #include "BKE_grease_pencil.h"
+#include "BKE_image.h"
 #include "BKE_lattice.hh"
 #include "BKE_main.hh"
 #include "BKE_mball.hh"
@@ -677,6 +678,11 @@ void DRW_viewport_request_redraw()
   }
 }
 
+bool DRW_viewport_is_redraw_requested()
+{
+  return DST.viewport && GPU_viewport_is_update_tagged(DST.viewport);
+}
+
 /** \} */
 
 /* -------------------------------------------------------------------- */
@@ -1552,7 +1558,7 @@ void DRW_draw_callbacks_post_scene()
       DRW_draw_gizmo_2d();
     }
 
-    if (G.debug_value > 20 && G.debug_value < 30) {
+    if (DRW_stats_draw_enabled()) {
       GPU_depth_test(GPU_DEPTH_NONE);
       /* local coordinate visible rect inside region, to accommodate overlapping ui */
       const rcti *rect = ED_region_visible_rect(DST.draw_ctx.region);
@@ -1711,6 +1717,11 @@ void DRW_draw_render_loop_ex(Depsgraph *depsgraph,
   /* No frame-buffer allowed before drawing. */
   BLI_assert(GPU_framebuffer_active_get() == GPU_framebuffer_back_get());
 
+  /* Increase the resolution of streamed image textures before the engines bind them. */
+  if (BKE_image_stream_gputextures(DEG_get_bmain(depsgraph))) {
+    DRW_viewport_request_redraw();
+  }
+
   /* Init engines */
   drw_engines_init();
 
@@ -2328,7 +2339,7 @@ void DRW_draw_render_loop_2d_ex(Depsgraph *depsgraph,
 
   DRW_stats_reset();
 
-  if (G.debug_value > 20 && G.debug_value < 30) {
+  if (DRW_stats_draw_enabled()) {
     GPU_depth_test(GPU_DEPTH_NONE);
     /* local coordinate visible rect inside region, to accommodate overlapping ui */
     const rcti *rect = ED_region_visible_rect(DST.draw_ctx.region);
@@ -3168,7 +3179,6 @@ void DRW_engines_free()
   DRW_curves_free();
   DRW_volume_free();
   DRW_shape_cache_free();
-  DRW_stats_free();
   DRW_globals_free();
 
   drw_debug_module_free(DST.debug);
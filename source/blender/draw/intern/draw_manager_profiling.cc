@@ -16,10 +16,11 @@
 
 #include "BLF_api.hh"
 
-#include "MEM_guardedalloc.h"
-
 #include "draw_manager_c.hh"
 
+#include "DNA_view3d_types.h"
+
+#include "GPU_capabilities.hh"
 #include "GPU_debug.hh"
 #include "GPU_texture.hh"
 
@@ -27,171 +28,55 @@
 
 #include "draw_manager_profiling.hh"
 
-#define MAX_TIMER_NAME 32
 #define MAX_NESTED_TIMER 8
-#define MIM_RANGE_LEN 8
-#define GPU_TIMER_FALLOFF 0.1
-
-struct DRWTimer {
-  uint32_t query[2];
-  uint64_t time_average;
-  char name[MAX_TIMER_NAME];
-  int lvl;       /* Hierarchy level for nested timer. */
-  bool is_query; /* Does this timer actually perform queries or is it just a group. */
-};
-
-static struct DRWTimerPool {
-  DRWTimer *timers;
-  int chunk_count;     /* Number of chunk allocated. */
-  int timer_count;     /* chunk_count * CHUNK_SIZE */
-  int timer_increment; /* Keep track of where we are in the stack. */
-  int end_increment;   /* Keep track of bad usage. */
-  bool is_recording;   /* Are we in the render loop? */
-  bool is_querying;    /* Keep track of bad usage. */
-} DTP = {nullptr};
-
-void DRW_stats_free()
-{
-  if (DTP.timers != nullptr) {
-    // for (int i = 0; i < DTP.timer_count; i++) {
-    // DRWTimer *timer = &DTP.timers[i];
-    // glDeleteQueries(2, timer->query);
-    // }
-    MEM_freeN(DTP.timers);
-    DTP.timers = nullptr;
-  }
-}
 
-void DRW_stats_begin()
+static bool drw_stats_debug_enabled()
 {
-  if (G.debug_value > 20 && G.debug_value < 30) {
-    DTP.is_recording = true;
-  }
-
-  if (DTP.is_recording && DTP.timers == nullptr) {
-    DTP.chunk_count = 1;
-    DTP.timer_count = DTP.chunk_count * MIM_RANGE_LEN;
-    DTP.timers = static_cast<DRWTimer *>(
-        MEM_callocN(sizeof(DRWTimer) * DTP.timer_count, "DRWTimer stack"));
-  }
-  else if (!DTP.is_recording && DTP.timers != nullptr) {
-    DRW_stats_free();
-  }
-
-  DTP.is_querying = false;
-  DTP.timer_increment = 0;
-  DTP.end_increment = 0;
+  return G.debug_value > 20 && G.debug_value < 30;
 }
 
-static DRWTimer *drw_stats_timer_get()
+static bool drw_stats_overlay_enabled()
 {
-  if (UNLIKELY(DTP.timer_increment >= DTP.timer_count)) {
-    /* Resize the stack. */
-    DTP.chunk_count++;
-    DTP.timer_count = DTP.chunk_count * MIM_RANGE_LEN;
-    DTP.timers = static_cast<DRWTimer *>(
-        MEM_recallocN(DTP.timers, sizeof(DRWTimer) * DTP.timer_count));
-  }
-
-  return &DTP.timers[DTP.timer_increment++];
+  const View3D *v3d = DST.draw_ctx.v3d;
+  return v3d && (v3d->flag2 & V3D_HIDE_OVERLAYS) == 0 &&
+         (v3d->overlay.flag & V3D_OVERLAY_GPU_TIMINGS);
 }
 
-static void drw_stats_timer_start_ex(const char *name, const bool is_query)
+void DRW_stats_begin()
 {
-  if (DTP.is_recording) {
-    DRWTimer *timer = drw_stats_timer_get();
-    STRNCPY(timer->name, name);
-    timer->lvl = DTP.timer_increment - DTP.end_increment - 1;
-    timer->is_query = is_query;
-
-    /* Queries cannot be nested or interleaved. */
-    BLI_assert(!DTP.is_querying);
-    if (timer->is_query) {
-      if (timer->query[0] == 0) {
-        // glGenQueries(1, timer->query);
-      }
-
-      // glFinish();
-      /* Issue query for the next frame */
-      // glBeginQuery(GL_TIME_ELAPSED, timer->query[0]);
-      DTP.is_querying = true;
-    }
+  if (drw_stats_debug_enabled() || drw_stats_overlay_enabled() || GPU_debug_timings_enabled()) {
+    GPU_debug_timings_frame_begin();
   }
 }
 
 void DRW_stats_group_start(const char *name)
 {
-  drw_stats_timer_start_ex(name, false);
-
   GPU_debug_group_begin(name);
 }
 
 void DRW_stats_group_end()
 {
   GPU_debug_group_end();
-  if (DTP.is_recording) {
-    BLI_assert(!DTP.is_querying);
-    DTP.end_increment++;
-  }
 }
 
 void DRW_stats_query_start(const char *name)
 {
   GPU_debug_group_begin(name);
-  drw_stats_timer_start_ex(name, true);
 }
 
 void DRW_stats_query_end()
 {
   GPU_debug_group_end();
-  if (DTP.is_recording) {
-    DTP.end_increment++;
-    BLI_assert(DTP.is_querying);
-    // glEndQuery(GL_TIME_ELAPSED);
-    DTP.is_querying = false;
-  }
 }
 
 void DRW_stats_reset()
 {
-  BLI_assert_msg((DTP.timer_increment - DTP.end_increment) <= 0,
-                 "You forgot a DRW_stats_group/query_end somewhere!");
-  BLI_assert_msg((DTP.timer_increment - DTP.end_increment) >= 0,
-                 "You forgot a DRW_stats_group/query_start somewhere!");
-
-  if (DTP.is_recording) {
-    uint64_t lvl_time[MAX_NESTED_TIMER] = {0};
-
-    /* Swap queries for the next frame and sum up each lvl time. */
-    for (int i = DTP.timer_increment - 1; i >= 0; i--) {
-      DRWTimer *timer = &DTP.timers[i];
-      std::swap(timer->query[0], timer->query[1]);
-
-      BLI_assert(timer->lvl < MAX_NESTED_TIMER);
-
-      if (timer->is_query) {
-        uint64_t time = 0;
-        if (timer->query[0] != 0) {
-          // glGetQueryObjectui64v(timer->query[0], GL_QUERY_RESULT, &time);
-        }
-        else {
-          time = 1000000000; /* 1ms default */
-        }
-
-        timer->time_average = timer->time_average * (1.0 - GPU_TIMER_FALLOFF) +
-                              time * GPU_TIMER_FALLOFF;
-        timer->time_average = std::min(timer->time_average, uint64_t(1000000000));
-      }
-      else {
-        timer->time_average = lvl_time[timer->lvl + 1];
-        lvl_time[timer->lvl + 1] = 0;
-      }
-
-      lvl_time[timer->lvl] += timer->time_average;
-    }
+  GPU_debug_timings_frame_end();
+}
 
-    DTP.is_recording = false;
-  }
+bool DRW_stats_draw_enabled()
+{
+  return drw_stats_debug_enabled() || drw_stats_overlay_enabled();
 }
 
 static void draw_stat_5row(const rcti *rect, int u, int v, const char *txt, const int size)
@@ -209,10 +94,60 @@ static void draw_stat(const rcti *rect, int u, int v, const char *txt, const int
       rect->xmin + (1 + u) * U.widget_unit, rect->ymax - (3 + v) * U.widget_unit, 0.0f, txt, size);
 }
 
+/** Draw the timings of the GPU debug groups that are nested at most `max_depth` times. */
+static void drw_stats_draw_gpu_timings(const rcti *rect, int v, const int max_depth)
+{
+  char stat_string[64];
+  double parent_time[MAX_NESTED_TIMER];
+
+  STRNCPY(stat_string, "GPU Render Timings");
+  draw_stat(rect, 0, v++, stat_string, sizeof(stat_string));
+
+  if (!GPU_timer_query_support()) {
+    STRNCPY(stat_string, "Not supported by the GPU backend");
+    draw_stat(rect, 1, v++, stat_string, sizeof(stat_string));
+    return;
+  }
+
+  for (const GPUDebugGroupTiming &timing : GPU_debug_timings_get()) {
+    /* Only display a number of levels at a time. */
+    if (timing.depth > max_depth || timing.depth >= MAX_NESTED_TIMER) {
+      continue;
+    }
+    parent_time[timing.depth] = timing.time_ms;
+
+    double time_percent = 100.0;
+    if (timing.depth > 0 && parent_time[timing.depth - 1] > 0.0) {
+      time_percent = (timing.time_ms / parent_time[timing.depth - 1]) * 100.0;
+    }
+
+    /* avoid very long number */
+    const double time_ms = std::min(timing.time_ms, 999.0);
+    time_percent = std::min(time_percent, 100.0);
+
+    STRNCPY(stat_string, timing.name.c_str());
+    draw_stat(rect, 0 + timing.depth, v, stat_string, sizeof(stat_string));
+    SNPRINTF(stat_string, "%.2fms", time_ms);
+    draw_stat(rect, 12 + timing.depth, v, stat_string, sizeof(stat_string));
+    SNPRINTF(stat_string, "%.0f", time_percent);
+    draw_stat(rect, 16 + timing.depth, v, stat_string, sizeof(stat_string));
+    v++;
+  }
+}
+
 void DRW_stats_draw(const rcti *rect)
 {
+  if (!drw_stats_debug_enabled()) {
+    /* Overlay only shows the top level passes of each engine, below the region info text. */
+    int fontid = BLF_default();
+    UI_FontThemeColor(fontid, TH_TEXT_HI);
+    BLF_batch_draw_begin();
+    drw_stats_draw_gpu_timings(rect, 6, 1);
+    BLF_batch_draw_end();
+    return;
+  }
+
   char stat_string[64];
-  int lvl_index[MAX_NESTED_TIMER];
   int v = 0, u = 0;
 
   double init_tot_time = 0.0, background_tot_time = 0.0, render_tot_time = 0.0, tot_time = 0.0;
@@ -307,44 +242,7 @@ void DRW_stats_draw(const rcti *rect)
   draw_stat_5row(rect, 1, v++, stat_string, sizeof(stat_string));
   v += 1;
 
-  /* GPU Timings */
-  STRNCPY(stat_string, "GPU Render Timings");
-  draw_stat(rect, 0, v++, stat_string, sizeof(stat_string));
-
-  for (int i = 0; i < DTP.timer_increment; i++) {
-    double time_ms, time_percent;
-    DRWTimer *timer = &DTP.timers[i];
-    DRWTimer *timer_parent = (timer->lvl > 0) ? &DTP.timers[lvl_index[timer->lvl - 1]] : nullptr;
-
-    /* Only display a number of lvl at a time */
-    if ((G.debug_value - 21) < timer->lvl) {
-      continue;
-    }
-
-    BLI_assert(timer->lvl < MAX_NESTED_TIMER);
-    lvl_index[timer->lvl] = i;
-
-    time_ms = timer->time_average / 1000000.0;
-
-    if (timer_parent != nullptr) {
-      time_percent = (double(timer->time_average) / double(timer_parent->time_average)) * 100.0;
-    }
-    else {
-      time_percent = 100.0;
-    }
-
-    /* avoid very long number */
-    time_ms = std::min(time_ms, 999.0);
-    time_percent = std::min(time_percent, 100.0);
-
-    SNPRINTF(stat_string, "%s", timer->name);
-    draw_stat(rect, 0 + timer->lvl, v, stat_string, sizeof(stat_string));
-    SNPRINTF(stat_string, "%.2fms", time_ms);
-    draw_stat(rect, 12 + timer->lvl, v, stat_string, sizeof(stat_string));
-    SNPRINTF(stat_string, "%.0f", time_percent);
-    draw_stat(rect, 16 + timer->lvl, v, stat_string, sizeof(stat_string));
-    v++;
-  }
+  drw_stats_draw_gpu_timings(rect, v, G.debug_value - 21);
 
   BLF_batch_draw_end();
 }
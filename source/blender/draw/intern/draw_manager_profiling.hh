@@ -10,13 +10,16 @@
 
 struct rcti;
 
-void DRW_stats_free();
+/**
+ * Start measuring the GPU time of the debug groups of the current redraw, if the timings are
+ * displayed or requested through the Python API.
+ */
 void DRW_stats_begin();
 void DRW_stats_reset();
 
 /**
- * Use this to group the queries. It does NOT keep track
- * of the time, it only sum what the queries inside it.
+ * Use this to group the queries. The group is a GPU debug group whose time is measured like any
+ * other debug group.
  */
 void DRW_stats_group_start(const char *name);
 void DRW_stats_group_end();
@@ -27,4 +30,6 @@ void DRW_stats_group_end();
 void DRW_stats_query_start(const char *name);
 void DRW_stats_query_end();
 
+/** Either the debug value (21-29) or the GPU timings overlay is enabled. */
+bool DRW_stats_draw_enabled();
 void DRW_stats_draw(const rcti *rect);
@@ -82,6 +82,31 @@ static DRWShaderCompiler &compiler_data()
   return compiler_data_;
 }
 
+/**
+ * Pop the material with the highest compilation priority from the queue.
+ * Among equal priorities the last one is picked because it will be less likely to lock the main
+ * thread if all GPUMaterials are to be freed (see DRW_deferred_shader_remove()).
+ * Must be called with the queue mutex locked.
+ */
+static GPUMaterial *drw_deferred_queue_pop_highest_priority(Vector<GPUMaterial *> &queue)
+{
+  if (queue.is_empty()) {
+    return nullptr;
+  }
+  int64_t best_index = queue.size() - 1;
+  float best_priority = GPU_material_compile_priority(queue[best_index]);
+  for (int64_t i = best_index - 1; i >= 0; i--) {
+    const float priority = GPU_material_compile_priority(queue[i]);
+    if (priority > best_priority) {
+      best_priority = priority;
+      best_index = i;
+    }
+  }
+  GPUMaterial *mat = queue[best_index];
+  queue.remove(best_index);
+  return mat;
+}
+
 static void *drw_deferred_shader_compilation_exec(void *)
 {
   using namespace blender;
@@ -103,10 +128,7 @@ static void *drw_deferred_shader_compilation_exec(void *)
     }
 
     compiler_data().queue_mutex.lock();
-    /* Pop last because it will be less likely to lock the main thread
-     * if all GPUMaterials are to be freed (see DRW_deferred_shader_remove()). */
-    GPUMaterial *mat = compiler_data().queue.is_empty() ? nullptr :
-                                                          compiler_data().queue.pop_last();
+    GPUMaterial *mat = drw_deferred_queue_pop_highest_priority(compiler_data().queue);
     if (mat) {
       /* Avoid another thread freeing the material mid compilation. */
       GPU_material_acquire(mat);
@@ -260,6 +282,8 @@ static void drw_deferred_queue_append(GPUMaterial *mat, bool is_optimization_job
   }
   else {
     GPU_material_status_set(mat, GPU_MAT_QUEUED);
+    /* Priority is raised by the engines while syncing the objects using this material. */
+    GPU_material_compile_priority_set(mat, 0.0f);
     compiler_data().queue.append(mat);
   }
 
@@ -355,6 +379,23 @@ void DRW_deferred_shader_remove(GPUMaterial *mat)
   }
 }
 
+void DRW_shader_queue_priority_raise(GPUMaterial *mat, float priority)
+{
+  if (GPU_use_main_context_workaround()) {
+    /* Deferred compilation is not supported. */
+    return;
+  }
+
+  std::scoped_lock queue_lock(compiler_data().queue_mutex);
+
+  if (GPU_material_status(mat) != GPU_MAT_QUEUED) {
+    return;
+  }
+  if (priority > GPU_material_compile_priority(mat)) {
+    GPU_material_compile_priority_set(mat, priority);
+  }
+}
+
 void DRW_deferred_shader_optimize_remove(GPUMaterial *mat)
 {
   if (GPU_use_main_context_workaround()) {
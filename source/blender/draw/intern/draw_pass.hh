@@ -138,6 +138,14 @@ class PassBase {
   SubPassVector<PassBase<DrawCommandBufType>> &sub_passes_;
   /** Currently bound shader. Used for interface queries. */
   GPUShader *shader_;
+  /**
+   * Last state and shader set by a command of this pass. Used to skip redundant commands so that
+   * consecutive draws stay inside the same #command::DrawMulti and can be merged. Reset when the
+   * state is unknown (start of the pass and after a sub-pass).
+   */
+  DRWState last_state_ = DRW_STATE_NO_DRAW;
+  int last_clip_plane_count_ = -1;
+  GPUShader *last_shader_ = nullptr;
 
  public:
   const char *debug_name;
@@ -454,6 +462,14 @@ class PassBase {
    */
   command::Undetermined &create_command(command::Type type);
 
+  /** Forget the last state and shader set, the next ones will always create a command. */
+  void state_tracking_reset()
+  {
+    last_state_ = DRW_STATE_NO_DRAW;
+    last_clip_plane_count_ = -1;
+    last_shader_ = nullptr;
+  }
+
   void submit(command::RecordingState &state) const;
 };
 
@@ -477,6 +493,7 @@ template<typename DrawCommandBufType> class Pass : public detail::PassBase<DrawC
     this->commands_.clear();
     this->sub_passes_.clear();
     this->draw_commands_buf_.clear();
+    this->state_tracking_reset();
   }
 };  // namespace blender::draw
 
@@ -530,6 +547,7 @@ class PassSortable : public PassMain {
     int64_t index = sub_passes_.append_and_get_index(
         PassBase(name, draw_commands_buf_, sub_passes_, shader_));
     headers_.append({Type::SubPass, uint(index)});
+    this->state_tracking_reset();
     /* Some sub-pass can also create sub-sub-passes (curve, point-clouds...) which will de-sync
      * the `sub_passes_.size()` and `sorting_values_.size()`, making the  `Header::index` not
      * reusable for the sorting value in the `sort()` function. To fix this, we flood the
@@ -618,6 +636,8 @@ template<class T> inline PassBase<T> &PassBase<T>::sub(const char *name)
   int64_t index = sub_passes_.append_and_get_index(
       PassBase(name, draw_commands_buf_, sub_passes_, shader_));
   headers_.append({command::Type::SubPass, uint(index)});
+  /* The sub-pass can change the state and the shader. */
+  this->state_tracking_reset();
   return sub_passes_[index];
 }
 
@@ -959,6 +979,12 @@ template<class T> inline void PassBase<T>::state_set(DRWState state, int clip_pl
   }
   /* Assumed to always be enabled. */
   state |= DRW_STATE_PROGRAM_POINT_SIZE;
+  if (state == last_state_ && clip_plane_count == last_clip_plane_count_) {
+    /* Avoid breaking the current multi-draw command. */
+    return;
+  }
+  last_state_ = state;
+  last_clip_plane_count_ = clip_plane_count;
   create_command(Type::StateSet).state_set = {state, clip_plane_count};
 }
 
@@ -971,6 +997,11 @@ inline void PassBase<T>::state_stencil(uint8_t write_mask, uint8_t reference, ui
 template<class T> inline void PassBase<T>::shader_set(GPUShader *shader)
 {
   shader_ = shader;
+  if (shader == last_shader_) {
+    /* Avoid breaking the current multi-draw command. */
+    return;
+  }
+  last_shader_ = shader;
   create_command(Type::ShaderBind).shader_bind = {shader};
 }
 
@@ -275,14 +275,27 @@ void View::compute_visibility(ObjectBoundsBuf &bounds, uint resource_len, bool d
   const uint32_t data = 0xFFFFFFFFu;
   GPU_storagebuf_clear(visibility_buf_, data);
 
+  /* Occlusion culling is skipped when culling is frozen as the HiZ doesn't match the frozen
+   * view. */
+  const bool use_occlusion = do_visibility_ && occlusion_.hiz_tx != nullptr && !frozen_ &&
+                             view_len_ == 1;
+  occlusion_phase1_done_ = use_occlusion;
+
   if (do_visibility_) {
-    GPUShader *shader = DRW_shader_draw_visibility_compute_get();
+    GPUShader *shader = use_occlusion ? DRW_shader_draw_visibility_occlusion_compute_get() :
+                                        DRW_shader_draw_visibility_compute_get();
     GPU_shader_bind(shader);
     GPU_shader_uniform_1i(shader, "resource_len", resource_len);
     GPU_shader_uniform_1i(shader, "view_len", view_len_);
     GPU_shader_uniform_1i(shader, "visibility_word_per_draw", word_per_draw);
     GPU_storagebuf_bind(bounds, GPU_shader_get_ssbo_binding(shader, "bounds_buf"));
     GPU_storagebuf_bind(visibility_buf_, GPU_shader_get_ssbo_binding(shader, "visibility_buf"));
+    if (use_occlusion) {
+      occluded_buf_.resize(words_len);
+      GPU_storagebuf_clear_to_zero(occluded_buf_);
+      occlusion_bind(shader, occlusion_.hiz_tx, occlusion_.hiz_persmat, occlusion_.hiz_uv_scale);
+      GPU_shader_uniform_1i(shader, "occlusion_phase", 1);
+    }
     GPU_uniformbuf_bind(frozen_ ? data_freeze_ : data_, DRW_VIEW_UBO_SLOT);
     GPU_uniformbuf_bind(frozen_ ? culling_freeze_ : culling_, DRW_VIEW_CULLING_UBO_SLOT);
     GPU_compute_dispatch(shader, divide_ceil_u(resource_len, DRW_VISIBILITY_GROUP_SIZE), 1, 1);
@@ -298,6 +311,57 @@ void View::compute_visibility(ObjectBoundsBuf &bounds, uint resource_len, bool d
   GPU_debug_group_end();
 }
 
+void View::compute_visibility_occluded(ObjectBoundsBuf &bounds,
+                                       uint resource_len,
+                                       GPUTexture *hiz_tx,
+                                       float2 hiz_uv_scale)
+{
+  BLI_assert(view_len_ == 1);
+
+  GPU_debug_group_begin("View.compute_visibility_occluded");
+
+  uint words_len = ceil_to_multiple_u(max_ii(1, divide_ceil_u(resource_len, 32)), 4);
+  visibility_buf_.resize(words_len);
+
+  if (!occlusion_phase1_done_) {
+    /* Everything has already been drawn by the first phase. */
+    GPU_storagebuf_clear_to_zero(visibility_buf_);
+    GPU_debug_group_end();
+    return;
+  }
+
+  const uint32_t data = 0xFFFFFFFFu;
+  GPU_storagebuf_clear(visibility_buf_, data);
+
+  GPUShader *shader = DRW_shader_draw_visibility_occlusion_compute_get();
+  GPU_shader_bind(shader);
+  GPU_shader_uniform_1i(shader, "resource_len", resource_len);
+  GPU_shader_uniform_1i(shader, "view_len", view_len_);
+  GPU_shader_uniform_1i(shader, "visibility_word_per_draw", 0);
+  GPU_shader_uniform_1i(shader, "occlusion_phase", 2);
+  GPU_storagebuf_bind(bounds, GPU_shader_get_ssbo_binding(shader, "bounds_buf"));
+  GPU_storagebuf_bind(visibility_buf_, GPU_shader_get_ssbo_binding(shader, "visibility_buf"));
+  occlusion_bind(shader, hiz_tx, this->persmat(), hiz_uv_scale);
+  GPU_uniformbuf_bind(data_, DRW_VIEW_UBO_SLOT);
+  GPU_uniformbuf_bind(culling_, DRW_VIEW_CULLING_UBO_SLOT);
+  GPU_compute_dispatch(shader, divide_ceil_u(resource_len, DRW_VISIBILITY_GROUP_SIZE), 1, 1);
+  GPU_memory_barrier(GPU_BARRIER_SHADER_STORAGE);
+
+  GPU_debug_group_end();
+}
+
+void View::occlusion_bind(GPUShader *shader,
+                          GPUTexture *hiz_tx,
+                          const float4x4 &hiz_persmat,
+                          float2 hiz_uv_scale)
+{
+  GPU_storagebuf_bind(occluded_buf_, GPU_shader_get_ssbo_binding(shader, "occluded_buf"));
+  GPU_texture_bind(hiz_tx, GPU_shader_get_sampler_binding(shader, "hiz_tx"));
+  GPU_shader_uniform_mat4(shader, "hiz_persmat", hiz_persmat.ptr());
+  GPU_shader_uniform_2fv(shader, "hiz_uv_scale", hiz_uv_scale);
+  GPU_shader_uniform_1i(shader, "hiz_lod_max", GPU_texture_mip_count(hiz_tx) - 1);
+}
+
 VisibilityBuf &View::get_visibility_buffer()
 {
   return visibility_buf_;
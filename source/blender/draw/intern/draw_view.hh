@@ -43,6 +43,17 @@ class View {
   UniformArrayBuffer<ViewCullingData, DRW_VIEW_MAX> culling_freeze_;
   /** Result of the visibility computation. 1 bit or 1 or 2 word per resource ID per view. */
   VisibilityBuf visibility_buf_;
+  /** Resources culled by the first occlusion culling phase. 1 bit per resource ID. */
+  VisibilityBuf occluded_buf_;
+
+  /** Depth pyramid used by the first phase of the occlusion culling. */
+  struct {
+    GPUTexture *hiz_tx = nullptr;
+    float4x4 hiz_persmat;
+    float2 hiz_uv_scale;
+  } occlusion_;
+  /** True if the last visibility computation tagged resources inside `occluded_buf_`. */
+  bool occlusion_phase1_done_ = false;
 
   const char *debug_name_;
 
@@ -56,14 +67,18 @@ class View {
 
  public:
   View(const char *name, int view_len = 1, bool procedural = false)
-      : visibility_buf_(name), debug_name_(name), view_len_(view_len), procedural_(procedural)
+      : visibility_buf_(name),
+        occluded_buf_(name),
+        debug_name_(name),
+        view_len_(view_len),
+        procedural_(procedural)
   {
     BLI_assert(view_len <= DRW_VIEW_MAX);
   }
 
   /* For compatibility with old system. Will be removed at some point. */
   View(const char *name, const DRWView *view)
-      : visibility_buf_(name), debug_name_(name), view_len_(1)
+      : visibility_buf_(name), occluded_buf_(name), debug_name_(name), view_len_(1)
   {
     this->sync(view);
   }
@@ -79,6 +94,32 @@ class View {
     do_visibility_ = enable;
   }
 
+  /**
+   * Enable two phase occlusion culling for the next submissions using this view.
+   *
+   * `hiz_tx` is a pyramid of the maximum depth, usually from the previous frame, rendered using
+   * `hiz_persmat`. `hiz_uv_scale` is the ratio of `hiz_tx` covered by the view, for padded
+   * textures. Resources hidden behind `hiz_tx` are not drawn. Once the depth pyramid has been
+   * updated with what was drawn, the hidden resources that became visible can be drawn using
+   * `Manager::submit_occluded`.
+   *
+   * Only supported for single view. The texture must stay valid until the submission.
+   */
+  void occlusion_culling_set(GPUTexture *hiz_tx,
+                             const float4x4 &hiz_persmat,
+                             float2 hiz_uv_scale = float2(1.0f))
+  {
+    BLI_assert(view_len_ == 1);
+    occlusion_.hiz_tx = hiz_tx;
+    occlusion_.hiz_persmat = hiz_persmat;
+    occlusion_.hiz_uv_scale = hiz_uv_scale;
+  }
+
+  void occlusion_culling_disable()
+  {
+    occlusion_.hiz_tx = nullptr;
+  }
+
   /**
    * Update culling data using a compute shader.
    * This is to be used if the matrices were updated externally
@@ -175,6 +216,15 @@ class View {
   void bind();
   virtual void compute_visibility(ObjectBoundsBuf &bounds, uint resource_len, bool debug_freeze);
   virtual VisibilityBuf &get_visibility_buffer();
+  void occlusion_bind(GPUShader *shader,
+                      GPUTexture *hiz_tx,
+                      const float4x4 &hiz_persmat,
+                      float2 hiz_uv_scale);
+  /** Second phase of the occlusion culling. */
+  void compute_visibility_occluded(ObjectBoundsBuf &bounds,
+                                   uint resource_len,
+                                   GPUTexture *hiz_tx,
+                                   float2 hiz_uv_scale);
 
   void update_viewport_size();
 
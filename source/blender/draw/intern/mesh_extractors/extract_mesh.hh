@@ -257,7 +257,26 @@ void extract_mesh_loose_edge_data(const Span<T> vert_data,
   });
 }
 
+/**
+ * Whether the per corner buffers of this mesh are expanded on the GPU with compute shaders instead
+ * of on the CPU. Only the raw per vertex data is then uploaded.
+ */
+bool mesh_extract_gpu_supported(const MeshRenderData &mr);
+/**
+ * Create a buffer containing the source vertex of each element of the per corner and loose
+ * geometry VBO layout, shared by all extractors using #extract_gpu_gather.
+ */
+gpu::VertBuf *extract_gpu_vert_indices_create(const MeshRenderData &mr);
+/** Build `dst` on the device from per vertex `src` data made of `element_stride` 32-bit words. */
+void extract_gpu_gather(gpu::VertBuf &src,
+                        gpu::VertBuf &vert_indices,
+                        gpu::VertBuf &dst,
+                        int element_stride);
+
 void extract_positions(const MeshRenderData &mr, gpu::VertBuf &vbo);
+void extract_positions_gpu(const MeshRenderData &mr,
+                           gpu::VertBuf &vert_indices,
+                           gpu::VertBuf &vbo);
 void extract_positions_subdiv(const DRWSubdivCache &subdiv_cache,
                               const MeshRenderData &mr,
                               gpu::VertBuf &vbo,
@@ -275,6 +294,9 @@ void extract_normals_subdiv(const MeshRenderData &mr,
                             gpu::VertBuf &pos_nor,
                             gpu::VertBuf &lnor);
 void extract_vert_normals(const MeshRenderData &mr, gpu::VertBuf &vbo);
+void extract_vert_normals_gpu(const MeshRenderData &mr,
+                              gpu::VertBuf &vert_indices,
+                              gpu::VertBuf &vbo);
 void extract_face_dot_normals(const MeshRenderData &mr, const bool use_hq, gpu::VertBuf &vbo);
 void extract_edge_factor(const MeshRenderData &mr, gpu::VertBuf &vbo);
 void extract_edge_factor_subdiv(const DRWSubdivCache &subdiv_cache,
@@ -0,0 +1,140 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup draw
+ *
+ * \brief GPU side expansion of per vertex mesh data into the per corner VBO layout.
+ *
+ * Only the raw per vertex arrays and the corner to vertex mapping are uploaded, a compute shader
+ * then builds the final vertex buffers on the device. This avoids writing and uploading the
+ * expanded per corner data from the CPU, which dominates extraction time for very dense meshes.
+ */
+
+#include "BLI_array_utils.hh"
+
+#include "GPU_capabilities.hh"
+#include "GPU_compute.hh"
+#include "GPU_shader.hh"
+#include "GPU_state.hh"
+
+#include "DRW_engine.hh"
+
+#include "extract_mesh.hh"
+
+extern "C" char datatoc_common_mesh_gather_comp_glsl[];
+
+namespace blender::draw {
+
+#define MESH_GATHER_LOCAL_WORK_GROUP_SIZE 64
+
+/**
+ * Below this number of corners, multi-threaded extraction on the CPU is fast enough and avoids
+ * the overhead of the extra buffers and the compute dispatch.
+ */
+#define MESH_GPU_EXTRACT_MIN_CORNERS (1 << 18)
+
+static GPUShader *g_mesh_gather_shader = nullptr;
+
+static GPUShader *mesh_gather_shader_get()
+{
+  if (g_mesh_gather_shader == nullptr) {
+    g_mesh_gather_shader = GPU_shader_create_compute(
+        datatoc_common_mesh_gather_comp_glsl, nullptr, nullptr, "mesh_gather");
+  }
+  return g_mesh_gather_shader;
+}
+
+void DRW_mesh_extract_gpu_free()
+{
+  if (g_mesh_gather_shader) {
+    GPU_shader_free(g_mesh_gather_shader);
+    g_mesh_gather_shader = nullptr;
+  }
+}
+
+bool mesh_extract_gpu_supported(const MeshRenderData &mr)
+{
+  if (mr.extract_type != MR_EXTRACT_MESH) {
+    return false;
+  }
+  if (mr.corners_num < MESH_GPU_EXTRACT_MIN_CORNERS) {
+    return false;
+  }
+  return GPU_compute_shader_support() && GPU_shader_storage_buffer_objects_support();
+}
+
+gpu::VertBuf *extract_gpu_vert_indices_create(const MeshRenderData &mr)
+{
+  static GPUVertFormat format = {0};
+  if (format.attr_len == 0) {
+    GPU_vertformat_attr_add(&format, "index", GPU_COMP_I32, 1, GPU_FETCH_INT);
+  }
+
+  gpu::VertBuf *vbo = GPU_vertbuf_calloc();
+  GPU_vertbuf_init_with_format(*vbo, format);
+  GPU_vertbuf_data_alloc(*vbo, mr.corners_num + mr.loose_indices_num);
+
+  MutableSpan<int> indices = vbo->data<int>();
+  MutableSpan corners_data = indices.take_front(mr.corners_num);
+  MutableSpan loose_edge_data = indices.slice(mr.corners_num, mr.loose_edges.size() * 2);
+  MutableSpan loose_vert_data = indices.take_back(mr.loose_verts.size());
+
+  threading::memory_bandwidth_bound_task(indices.size_in_bytes() * 2, [&]() {
+    array_utils::copy(mr.corner_verts, corners_data);
+    threading::parallel_for(mr.loose_edges.index_range(), 4096, [&](const IndexRange range) {
+      for (const int i : range) {
+        const int2 edge = mr.edges[mr.loose_edges[i]];
+        loose_edge_data[i * 2 + 0] = edge[0];
+        loose_edge_data[i * 2 + 1] = edge[1];
+      }
+    });
+    array_utils::copy(mr.loose_verts, loose_vert_data);
+  });
+
+  GPU_vertbuf_tag_dirty(vbo);
+  return vbo;
+}
+
+void extract_gpu_gather(gpu::VertBuf &src,
+                        gpu::VertBuf &vert_indices,
+                        gpu::VertBuf &dst,
+                        const int element_stride)
+{
+  const int elements_num = GPU_vertbuf_get_vertex_len(&vert_indices);
+  if (elements_num == 0) {
+    return;
+  }
+
+  GPUShader *shader = mesh_gather_shader_get();
+  GPU_shader_bind(shader);
+  GPU_shader_uniform_1i(shader, "elements_num", elements_num);
+  GPU_shader_uniform_1i(shader, "element_stride", element_stride);
+
+  GPU_vertbuf_bind_as_ssbo(&src, 0);
+  GPU_vertbuf_bind_as_ssbo(&vert_indices, 1);
+  GPU_vertbuf_bind_as_ssbo(&dst, 2);
+
+  /* Split the dispatch in two dimensions when the number of work groups exceeds the limit of the
+   * first dimension, the shader computes the linear index from both. */
+  const uint groups_num = divide_ceil_u(elements_num, MESH_GATHER_LOCAL_WORK_GROUP_SIZE);
+  uint groups_x = groups_num;
+  uint groups_y = 1u;
+  if (groups_x > uint(GPU_max_work_group_count(0))) {
+    groups_x = groups_y = uint(ceilf(sqrtf(float(groups_num))));
+    if (groups_x * (groups_y - 1) >= groups_num) {
+      groups_y -= 1;
+    }
+  }
+  BLI_assert(groups_y < uint(GPU_max_work_group_count(1)));
+
+  GPU_compute_dispatch(shader, groups_x, groups_y, 1);
+
+  /* The result is used as vertex attribute by the draw calls. */
+  GPU_memory_barrier(GPU_BARRIER_VERTEX_ATTRIB_ARRAY);
+
+  GPU_shader_unbind();
+}
+
+}  // namespace blender::draw
@@ -67,13 +67,18 @@ static void extract_positions_bm(const MeshRenderData &mr, MutableSpan<float3> v
   });
 }
 
-void extract_positions(const MeshRenderData &mr, gpu::VertBuf &vbo)
+static const GPUVertFormat &get_positions_format()
 {
   static GPUVertFormat format = {0};
   if (format.attr_len == 0) {
     GPU_vertformat_attr_add(&format, "pos", GPU_COMP_F32, 3, GPU_FETCH_FLOAT);
   }
-  GPU_vertbuf_init_with_format(vbo, format);
+  return format;
+}
+
+void extract_positions(const MeshRenderData &mr, gpu::VertBuf &vbo)
+{
+  GPU_vertbuf_init_with_format(vbo, get_positions_format());
   GPU_vertbuf_data_alloc(vbo, mr.corners_num + mr.loose_indices_num);
 
   MutableSpan vbo_data = vbo.data<float3>();
@@ -85,6 +90,24 @@ void extract_positions(const MeshRenderData &mr, gpu::VertBuf &vbo)
   }
 }
 
+void extract_positions_gpu(const MeshRenderData &mr,
+                           gpu::VertBuf &vert_indices,
+                           gpu::VertBuf &vbo)
+{
+  const GPUVertFormat &format = get_positions_format();
+  GPU_vertbuf_init_build_on_device(vbo, format, mr.corners_num + mr.loose_indices_num);
+
+  gpu::VertBuf *src = GPU_vertbuf_calloc();
+  GPU_vertbuf_init_with_format(*src, format);
+  GPU_vertbuf_data_alloc(*src, mr.verts_num);
+  src->data<float3>().copy_from(mr.vert_positions);
+  GPU_vertbuf_tag_dirty(src);
+
+  extract_gpu_gather(*src, vert_indices, vbo, 3);
+
+  GPU_vertbuf_discard(src);
+}
+
 static const GPUVertFormat &get_normals_format()
 {
   static GPUVertFormat format = {0};
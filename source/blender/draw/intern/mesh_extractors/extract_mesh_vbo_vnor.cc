@@ -66,14 +66,19 @@ static void extract_vert_normals_bm(const MeshRenderData &mr,
   });
 }
 
-void extract_vert_normals(const MeshRenderData &mr, gpu::VertBuf &vbo)
+static const GPUVertFormat &get_vert_normals_format()
 {
   static GPUVertFormat format = {0};
   if (format.attr_len == 0) {
     GPU_vertformat_attr_add(&format, "vnor", GPU_COMP_I10, 4, GPU_FETCH_INT_TO_FLOAT_UNIT);
   }
+  return format;
+}
+
+void extract_vert_normals(const MeshRenderData &mr, gpu::VertBuf &vbo)
+{
   const int size = mr.corners_num + mr.loose_indices_num;
-  GPU_vertbuf_init_with_format(vbo, format);
+  GPU_vertbuf_init_with_format(vbo, get_vert_normals_format());
   GPU_vertbuf_data_alloc(vbo, size);
   MutableSpan vbo_data = vbo.data<GPUPackedNormal>();
 
@@ -85,4 +90,23 @@ void extract_vert_normals(const MeshRenderData &mr, gpu::VertBuf &vbo)
   }
 }
 
+void extract_vert_normals_gpu(const MeshRenderData &mr,
+                              gpu::VertBuf &vert_indices,
+                              gpu::VertBuf &vbo)
+{
+  const GPUVertFormat &format = get_vert_normals_format();
+  GPU_vertbuf_init_build_on_device(vbo, format, mr.corners_num + mr.loose_indices_num);
+
+  /* Normals are packed once per vertex, the expansion to corners happens on the GPU. */
+  gpu::VertBuf *src = GPU_vertbuf_calloc();
+  GPU_vertbuf_init_with_format(*src, format);
+  GPU_vertbuf_data_alloc(*src, mr.verts_num);
+  convert_normals(mr.mesh->vert_normals(), src->data<GPUPackedNormal>());
+  GPU_vertbuf_tag_dirty(src);
+
+  extract_gpu_gather(*src, vert_indices, vbo, 1);
+
+  GPU_vertbuf_discard(src);
+}
+
 }  // namespace blender::draw
@@ -0,0 +1,41 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+/* Expand per vertex mesh data to the per corner and loose geometry layout of the mesh VBOs:
+ * `dst[i] = src[indices[i]]`, for elements made of `element_stride` 32-bit words. */
+
+layout(local_size_x = 64, local_size_y = 1, local_size_z = 1) in;
+
+uniform int elements_num;
+uniform int element_stride;
+
+layout(std430, binding = 0) readonly buffer inputData
+{
+  uint src_data[];
+};
+
+layout(std430, binding = 1) readonly buffer inputIndices
+{
+  int src_indices[];
+};
+
+layout(std430, binding = 2) writeonly buffer outputData
+{
+  uint dst_data[];
+};
+
+void main()
+{
+  uint invocations_per_row = gl_WorkGroupSize.x * gl_NumWorkGroups.x;
+  uint index = gl_GlobalInvocationID.x + gl_GlobalInvocationID.y * invocations_per_row;
+  if (index >= uint(elements_num)) {
+    return;
+  }
+
+  uint src_offset = uint(src_indices[index]) * uint(element_stride);
+  uint dst_offset = index * uint(element_stride);
+  for (int i = 0; i < element_stride; i++) {
+    dst_data[dst_offset + i] = src_data[src_offset + i];
+  }
+}
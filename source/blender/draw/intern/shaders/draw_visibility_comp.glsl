@@ -4,8 +4,14 @@
 
 /**
  * Compute visibility of each resource bounds for a given view.
+ *
+ * When `DRW_OCCLUSION_CULLING` is defined, resources inside the frustum are also tested against
+ * a hierarchical max depth buffer. This is done in two phases:
+ * - Phase 1 tests against the HiZ of the previous frame. Resources that are occluded are tagged
+ *   inside `occluded_buf`.
+ * - Phase 2 tests only the tagged resources against the HiZ built from the phase 1 result. The
+ *   ones that aren't occluded anymore are made visible.
  */
-/* TODO(fclem): This could be augmented by a 2 pass occlusion culling system. */
 
 #pragma BLENDER_REQUIRE(common_view_lib.glsl)
 #pragma BLENDER_REQUIRE(common_math_lib.glsl)
@@ -24,6 +30,79 @@ void mask_visibility_bit(uint view_id)
   }
 }
 
+#ifdef DRW_OCCLUSION_CULLING
+
+/**
+ * Return true if the bounds are completely hidden behind the depth stored in `hiz_tx`.
+ * The test is conservative: bounds crossing the near plane of `hiz_persmat` are never occluded.
+ */
+bool is_occluded(ObjectBounds bounds)
+{
+  vec3 p0 = bounds.bounding_corners[0].xyz;
+  vec3 ndc_min = vec3(1.0);
+  vec3 ndc_max = vec3(-1.0);
+  for (int i = 0; i < 8; i++) {
+    vec3 corner = p0;
+    corner += ((i & 1) != 0) ? bounds.bounding_corners[1].xyz : vec3(0.0);
+    corner += ((i & 2) != 0) ? bounds.bounding_corners[2].xyz : vec3(0.0);
+    corner += ((i & 4) != 0) ? bounds.bounding_corners[3].xyz : vec3(0.0);
+    vec4 hs_corner = hiz_persmat * vec4(corner, 1.0);
+    if (hs_corner.w <= 0.0) {
+      return false;
+    }
+    vec3 ndc_corner = hs_corner.xyz / hs_corner.w;
+    ndc_min = min(ndc_min, ndc_corner);
+    ndc_max = max(ndc_max, ndc_corner);
+  }
+
+  if (ndc_min.z < -1.0) {
+    return false;
+  }
+
+  /* Footprint of the bounds in texels of the first mip level. */
+  vec2 viewport_size = vec2(textureSize(hiz_tx, 0)) * hiz_uv_scale;
+  vec2 texel_min = saturate(ndc_min.xy * 0.5 + 0.5) * viewport_size;
+  vec2 texel_max = saturate(ndc_max.xy * 0.5 + 0.5) * viewport_size;
+
+  /* Select the mip level where the footprint covers at most 2x2 texels. */
+  vec2 footprint = texel_max - texel_min;
+  int lod = int(ceil(log2(max(1.0, max(footprint.x, footprint.y)))));
+  lod = clamp(lod, 0, hiz_lod_max);
+
+  ivec2 mip_size = textureSize(hiz_tx, lod);
+  ivec2 texel_start = clamp(ivec2(texel_min) >> lod, ivec2(0), mip_size - 1);
+  ivec2 texel_end = clamp(ivec2(texel_max) >> lod, ivec2(0), mip_size - 1);
+  /* Mip selection can be off by one texel because of the rounding. */
+  texel_end = min(texel_end, texel_start + 1);
+
+  float max_depth = 0.0;
+  for (int y = texel_start.y; y <= texel_end.y; y++) {
+    for (int x = texel_start.x; x <= texel_end.x; x++) {
+      max_depth = max(max_depth, texelFetch(hiz_tx, ivec2(x, y), lod).r);
+    }
+  }
+
+  float nearest_depth = ndc_min.z * 0.5 + 0.5;
+  return nearest_depth > max_depth;
+}
+
+bool occluded_bit_get()
+{
+  return (occluded_buf[gl_WorkGroupID.x] & (1u << gl_LocalInvocationID.x)) != 0u;
+}
+
+void occluded_bit_set()
+{
+  atomicOr(occluded_buf[gl_WorkGroupID.x], 1u << gl_LocalInvocationID.x);
+}
+
+bool visibility_bit_get()
+{
+  return (visibility_buf[gl_WorkGroupID.x] & (1u << gl_LocalInvocationID.x)) != 0u;
+}
+
+#endif
+
 void main()
 {
   if (int(gl_GlobalInvocationID.x) >= resource_len) {
@@ -68,4 +147,23 @@ void main()
       }
     }
   }
+
+#ifdef DRW_OCCLUSION_CULLING
+  /* Occlusion culling only supports a single view, visibility is tightly packed. */
+  if (occlusion_phase == 1) {
+    if (visibility_bit_get() && drw_bounds_are_valid(bounds) && is_occluded(bounds)) {
+      mask_visibility_bit(0u);
+      occluded_bit_set();
+    }
+  }
+  else {
+    /* Only draw what has been occluded during the first phase and isn't anymore. */
+    if (!occluded_bit_get()) {
+      mask_visibility_bit(0u);
+    }
+    else if (visibility_bit_get() && is_occluded(bounds)) {
+      mask_visibility_bit(0u);
+    }
+  }
+#endif
 }
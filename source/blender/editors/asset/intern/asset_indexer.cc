@@ -9,6 +9,7 @@
 #include <ctime>
 #include <fstream>
 #include <iomanip>
+#include <mutex>
 #include <optional>
 
 #include "ED_asset_indexer.hh"
@@ -308,6 +309,9 @@ struct AssetLibraryIndex {
 
   std::string library_path;
 
+  /** Indices of different files may be written in parallel, but share their parent directory. */
+  std::mutex parent_path_mutex;
+
   AssetLibraryIndex(const StringRef library_path) : library_path(library_path)
   {
     this->init_indices_base_path();
@@ -574,6 +578,7 @@ class AssetIndexFile : public AbstractFile {
 
   bool ensure_parent_path_exists() const
   {
+    std::scoped_lock lock(this->library_index.parent_path_mutex);
     return BLI_file_ensure_parent_dir_exists(this->get_file_path());
   }
 
@@ -104,6 +104,9 @@ struct FileIndexerType {
    * entries field, `r_read_entries_len` must be set to `0` and the function must return
    * `eFileIndexerResult::FILE_INDEXER_NEEDS_UPDATE`. In this case the blend file will read from
    * the blend file and the `update_index` function will be called.
+   *
+   * \note Several blend files may be listed in parallel, so this and `update_index` may be called
+   * from multiple threads at the same time (for different files).
    */
   FileIndexerReadIndexFunc read_index;
 
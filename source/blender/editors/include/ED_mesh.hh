@@ -123,6 +123,16 @@ struct EDBMUpdate_Params {
  * So many tools call these that we better make it a generic function.
  */
 void EDBM_update(Mesh *mesh, const EDBMUpdate_Params *params);
+/**
+ * Same as #EDBM_update for operators that moved vertices without changing the topology. Only the
+ * normals and tessellation of the geometry connected to the vertices with \a hflag are updated,
+ * as well as the geometry connected to their mirror vertices when \a use_mirror is set, which is
+ * only valid in between #EDBM_verts_mirror_cache_begin and #EDBM_verts_mirror_cache_end.
+ */
+void EDBM_update_from_moved_verts(Mesh *mesh,
+                                  const EDBMUpdate_Params *params,
+                                  char hflag,
+                                  bool use_mirror);
 /**
  * Bad level call from Python API.
  */
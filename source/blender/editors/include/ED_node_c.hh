@@ -18,6 +18,7 @@ struct View2D;
 struct bContext;
 struct bNode;
 struct bNodeTree;
+struct rctf;
 namespace blender::bke {
 struct bNodeTreeType;
 struct bNodeType;
@@ -132,10 +133,15 @@ void ED_node_tree_propagate_change(const bContext *C, Main *bmain, bNodeTree *nt
  * \param scene_owner: is the owner of the job,
  * we don't use it for anything else currently so could also be a void pointer,
  * but for now keep it an 'Scene' for consistency.
+ * \param viewer_region: if not null, only this region of the viewer image is computed, given in
+ * coordinates normalized to the viewer image size. Currently only supported by the CPU compositor.
  *
  * \note only call from spaces `refresh` callbacks, not direct! - use with care.
  */
-void ED_node_composite_job(const bContext *C, bNodeTree *nodetree, Scene *scene_owner);
+void ED_node_composite_job(const bContext *C,
+                           bNodeTree *nodetree,
+                           Scene *scene_owner,
+                           const rctf *viewer_region = nullptr);
 
 /* `node_ops.cc` */
 
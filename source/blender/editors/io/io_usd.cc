@@ -883,6 +883,8 @@ static int wm_usd_import_exec(bContext *C, wmOperator *op)
 
   const bool import_defined_only = RNA_boolean_get(op->ptr, "import_defined_only");
 
+  const bool load_payloads = RNA_boolean_get(op->ptr, "load_payloads");
+
   const bool create_collection = RNA_boolean_get(op->ptr, "create_collection");
 
   char *prim_path_mask = RNA_string_get_alloc(op->ptr, "prim_path_mask", nullptr, 0, nullptr);
@@ -935,6 +937,7 @@ static int wm_usd_import_exec(bContext *C, wmOperator *op)
 
   params.import_visible_only = import_visible_only;
   params.import_defined_only = import_defined_only;
+  params.load_payloads = load_payloads;
 
   params.import_cameras = import_cameras;
   params.import_curves = import_curves;
@@ -1002,6 +1005,7 @@ static void wm_usd_import_draw(bContext *C, wmOperator *op)
     uiLayout *sub = uiLayoutColumnWithHeading(col, true, IFACE_("Include"));
     uiItemR(sub, ptr, "import_visible_only", UI_ITEM_NONE, nullptr, ICON_NONE);
     uiItemR(sub, ptr, "import_defined_only", UI_ITEM_NONE, nullptr, ICON_NONE);
+    uiItemR(sub, ptr, "load_payloads", UI_ITEM_NONE, nullptr, ICON_NONE);
 
     col = uiLayoutColumn(panel, false);
     uiItemR(col, ptr, "set_frame_range", UI_ITEM_NONE, nullptr, ICON_NONE);
@@ -1282,6 +1286,13 @@ void WM_OT_usd_import(wmOperatorType *ot)
                   "Defined Primitives Only",
                   "Import only defined USD primitives. When disabled this allows importing USD "
                   "primitives which are not defined, such as those with an override specifier");
+
+  RNA_def_boolean(ot->srna,
+                  "load_payloads",
+                  true,
+                  "Payloads",
+                  "Load the payloads of the stage. When disabled only the scene hierarchy outside "
+                  "of payloads is imported, which is much faster for large stages");
 }
 
 namespace blender::ed::io {
@@ -10,6 +10,8 @@
 
 #include "MEM_guardedalloc.h"
 
+#include "BLI_array.hh"
+#include "BLI_atomic_disjoint_set.hh"
 #include "BLI_bitmap.h"
 #include "BLI_heap.h"
 #include "BLI_linklist.h"
@@ -21,6 +23,7 @@
 #include "BLI_math_vector.h"
 #include "BLI_rand.h"
 #include "BLI_string.h"
+#include "BLI_task.hh"
 #include "BLI_utildefines_stack.h"
 #include "BLI_vector.hh"
 
@@ -3215,6 +3218,108 @@ static void select_linked_delimit_end(BMEditMesh *em)
   BM_mesh_elem_toolflags_clear(bm);
 }
 
+/**
+ * Select the visible edges connected to the tagged vertices (or edges when \a seed_htype is
+ * #BM_EDGE), giving the same result as walking #BMW_VERT_SHELL from each of them.
+ * The connected sets are found in parallel with a disjoint set over the edges,
+ * which is much faster than the walker on large meshes.
+ */
+static void select_linked_verts_shell(BMesh *bm, const char seed_htype)
+{
+  using namespace blender;
+  BM_mesh_elem_index_ensure(bm, BM_VERT | BM_EDGE);
+  BM_mesh_elem_table_ensure(bm, BM_VERT | BM_EDGE);
+
+  AtomicDisjointSet vert_sets(bm->totvert);
+  threading::parallel_for(IndexRange(bm->totedge), 4096, [&](const IndexRange range) {
+    for (const int i : range) {
+      const BMEdge *e = BM_edge_at_index(bm, i);
+      if (!BM_elem_flag_test(e, BM_ELEM_HIDDEN)) {
+        vert_sets.join(BM_elem_index_get(e->v1), BM_elem_index_get(e->v2));
+      }
+    }
+  });
+
+  Array<bool> set_selected(bm->totvert, false);
+  if (seed_htype == BM_VERT) {
+    for (const int i : IndexRange(bm->totvert)) {
+      if (BM_elem_flag_test(BM_vert_at_index(bm, i), BM_ELEM_TAG)) {
+        set_selected[vert_sets.find_root(i)] = true;
+      }
+    }
+  }
+  else {
+    for (const int i : IndexRange(bm->totedge)) {
+      const BMEdge *e = BM_edge_at_index(bm, i);
+      if (BM_elem_flag_test(e, BM_ELEM_TAG) && !BM_elem_flag_test(e, BM_ELEM_HIDDEN)) {
+        set_selected[vert_sets.find_root(BM_elem_index_get(e->v1))] = true;
+      }
+    }
+  }
+
+  for (const int i : IndexRange(bm->totedge)) {
+    BMEdge *e = BM_edge_at_index(bm, i);
+    if (!BM_elem_flag_test(e, BM_ELEM_HIDDEN) &&
+        set_selected[vert_sets.find_root(BM_elem_index_get(e->v1))])
+    {
+      BM_edge_select_set(bm, e, true);
+    }
+  }
+}
+
+/**
+ * Select the visible faces connected to the tagged faces, giving the same result as walking
+ * #BMW_ISLAND from each of them. When \a use_delimit is set, only edges tagged with
+ * #BMO_ELE_TAG by #select_linked_delimit_begin connect faces.
+ */
+static void select_linked_faces_island(BMesh *bm, const bool use_delimit)
+{
+  using namespace blender;
+  BM_mesh_elem_index_ensure(bm, BM_FACE);
+  BM_mesh_elem_table_ensure(bm, BM_EDGE | BM_FACE);
+
+  AtomicDisjointSet face_sets(bm->totface);
+  threading::parallel_for(IndexRange(bm->totedge), 4096, [&](const IndexRange range) {
+    for (const int i : range) {
+      BMEdge *e = BM_edge_at_index(bm, i);
+      if (e->l == nullptr || BM_elem_flag_test(e, BM_ELEM_HIDDEN)) {
+        continue;
+      }
+      if (use_delimit && !BMO_edge_flag_test(bm, e, BMO_ELE_TAG)) {
+        continue;
+      }
+      int first_face = -1;
+      BMLoop *l_iter = e->l;
+      do {
+        if (BM_elem_flag_test(l_iter->f, BM_ELEM_HIDDEN)) {
+          continue;
+        }
+        if (first_face == -1) {
+          first_face = BM_elem_index_get(l_iter->f);
+        }
+        else {
+          face_sets.join(first_face, BM_elem_index_get(l_iter->f));
+        }
+      } while ((l_iter = l_iter->radial_next) != e->l);
+    }
+  });
+
+  Array<bool> set_selected(bm->totface, false);
+  for (const int i : IndexRange(bm->totface)) {
+    const BMFace *f = BM_face_at_index(bm, i);
+    if (BM_elem_flag_test(f, BM_ELEM_TAG) && !BM_elem_flag_test(f, BM_ELEM_HIDDEN)) {
+      set_selected[face_sets.find_root(i)] = true;
+    }
+  }
+
+  for (const int i : IndexRange(bm->totface)) {
+    BMFace *f = BM_face_at_index(bm, i);
+    if (!BM_elem_flag_test(f, BM_ELEM_HIDDEN) && set_selected[face_sets.find_root(i)]) {
+      BM_face_select_set(bm, f, true);
+    }
+  }
+}
+
 static int edbm_select_linked_exec(bContext *C, wmOperator *op)
 {
   Scene *scene = CTX_data_scene(C);
@@ -3267,16 +3372,16 @@ static int edbm_select_linked_exec(bContext *C, wmOperator *op)
         }
       }
 
-      BMW_init(&walker,
-               em->bm,
-               delimit ? BMW_LOOP_SHELL_WIRE : BMW_VERT_SHELL,
-               BMW_MASK_NOP,
-               delimit ? BMO_ELE_TAG : BMW_MASK_NOP,
-               BMW_MASK_NOP,
-               BMW_FLAG_TEST_HIDDEN,
-               BMW_NIL_LAY);
-
       if (delimit) {
+        BMW_init(&walker,
+                 em->bm,
+                 BMW_LOOP_SHELL_WIRE,
+                 BMW_MASK_NOP,
+                 BMO_ELE_TAG,
+                 BMW_MASK_NOP,
+                 BMW_FLAG_TEST_HIDDEN,
+                 BMW_NIL_LAY);
+
         BM_ITER_MESH (v, &iter, em->bm, BM_VERTS_OF_MESH) {
           if (BM_elem_flag_test(v, BM_ELEM_TAG)) {
             BMElem *ele_walk;
@@ -3296,21 +3401,13 @@ static int edbm_select_linked_exec(bContext *C, wmOperator *op)
             }
           }
         }
+
+        BMW_end(&walker);
       }
       else {
-        BM_ITER_MESH (v, &iter, em->bm, BM_VERTS_OF_MESH) {
-          if (BM_elem_flag_test(v, BM_ELEM_TAG)) {
-            BMEdge *e_walk;
-            BMW_ITER (e_walk, &walker, v) {
-              BM_edge_select_set(em->bm, e_walk, true);
-              BM_elem_flag_disable(e_walk, BM_ELEM_TAG);
-            }
-          }
-        }
+        select_linked_verts_shell(em->bm, BM_VERT);
       }
 
-      BMW_end(&walker);
-
       EDBM_selectmode_flush(em);
     }
     else if (em->selectmode & SCE_SELECT_EDGE) {
@@ -3333,16 +3430,16 @@ static int edbm_select_linked_exec(bContext *C, wmOperator *op)
         }
       }
 
-      BMW_init(&walker,
-               em->bm,
-               delimit ? BMW_LOOP_SHELL_WIRE : BMW_VERT_SHELL,
-               BMW_MASK_NOP,
-               delimit ? BMO_ELE_TAG : BMW_MASK_NOP,
-               BMW_MASK_NOP,
-               BMW_FLAG_TEST_HIDDEN,
-               BMW_NIL_LAY);
-
       if (delimit) {
+        BMW_init(&walker,
+                 em->bm,
+                 BMW_LOOP_SHELL_WIRE,
+                 BMW_MASK_NOP,
+                 BMO_ELE_TAG,
+                 BMW_MASK_NOP,
+                 BMW_FLAG_TEST_HIDDEN,
+                 BMW_NIL_LAY);
+
         BM_ITER_MESH (e, &iter, em->bm, BM_EDGES_OF_MESH) {
           if (BM_elem_flag_test(e, BM_ELEM_TAG)) {
             BMElem *ele_walk;
@@ -3362,21 +3459,13 @@ static int edbm_select_linked_exec(bContext *C, wmOperator *op)
             }
           }
         }
+
+        BMW_end(&walker);
       }
       else {
-        BM_ITER_MESH (e, &iter, em->bm, BM_EDGES_OF_MESH) {
-          if (BM_elem_flag_test(e, BM_ELEM_TAG)) {
-            BMEdge *e_walk;
-            BMW_ITER (e_walk, &walker, e) {
-              BM_edge_select_set(em->bm, e_walk, true);
-              BM_elem_flag_disable(e_walk, BM_ELEM_TAG);
-            }
-          }
-        }
+        select_linked_verts_shell(em->bm, BM_EDGE);
       }
 
-      BMW_end(&walker);
-
       EDBM_selectmode_flush(em);
     }
     else {
@@ -3386,26 +3475,7 @@ static int edbm_select_linked_exec(bContext *C, wmOperator *op)
         BM_elem_flag_set(f, BM_ELEM_TAG, BM_elem_flag_test(f, BM_ELEM_SELECT));
       }
 
-      BMW_init(&walker,
-               bm,
-               BMW_ISLAND,
-               BMW_MASK_NOP,
-               delimit ? BMO_ELE_TAG : BMW_MASK_NOP,
-               BMW_MASK_NOP,
-               BMW_FLAG_TEST_HIDDEN,
-               BMW_NIL_LAY);
-
-      BM_ITER_MESH (f, &iter, em->bm, BM_FACES_OF_MESH) {
-        if (BM_elem_flag_test(f, BM_ELEM_TAG)) {
-          BMFace *f_walk;
-          BMW_ITER (f_walk, &walker, f) {
-            BM_face_select_set(bm, f_walk, true);
-            BM_elem_flag_disable(f_walk, BM_ELEM_TAG);
-          }
-        }
-      }
-
-      BMW_end(&walker);
+      select_linked_faces_island(bm, delimit != 0);
     }
 
     if (delimit) {
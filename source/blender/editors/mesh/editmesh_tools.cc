@@ -2698,16 +2698,21 @@ static int edbm_do_smooth_vertex_exec(bContext *C, wmOperator *op)
     }
 
     /* apply mirror */
-    if (((Mesh *)obedit->data)->symmetry & ME_SYMMETRY_X) {
+    const bool use_mirror = ((Mesh *)obedit->data)->symmetry & ME_SYMMETRY_X;
+    if (use_mirror) {
       EDBM_verts_mirror_apply(em, BM_ELEM_SELECT, 0);
-      EDBM_verts_mirror_cache_end(em);
     }
 
     EDBMUpdate_Params params{};
     params.calc_looptris = true;
     params.calc_normals = false;
     params.is_destructive = false;
-    EDBM_update(static_cast<Mesh *>(obedit->data), &params);
+    /* Only the selected vertices and their mirror vertices moved. */
+    EDBM_update_from_moved_verts(mesh, &params, BM_ELEM_SELECT, use_mirror);
+
+    if (use_mirror) {
+      EDBM_verts_mirror_cache_end(em);
+    }
   }
 
   if (tot_selected == 0 && !tot_locked) {
@@ -2816,16 +2821,22 @@ static int edbm_do_smooth_laplacian_vertex_exec(bContext *C, wmOperator *op)
     }
 
     /* Apply mirror. */
-    if (((Mesh *)obedit->data)->symmetry & ME_SYMMETRY_X) {
+    const bool use_mirror = ((Mesh *)obedit->data)->symmetry & ME_SYMMETRY_X;
+    if (use_mirror) {
       EDBM_verts_mirror_apply(em, BM_ELEM_SELECT, 0);
-      EDBM_verts_mirror_cache_end(em);
     }
 
     EDBMUpdate_Params params{};
     params.calc_looptris = true;
     params.calc_normals = false;
     params.is_destructive = false;
-    EDBM_update(static_cast<Mesh *>(obedit->data), &params);
+    /* Only the selected vertices and their mirror vertices moved. */
+    EDBM_update_from_moved_verts(
+        static_cast<Mesh *>(obedit->data), &params, BM_ELEM_SELECT, use_mirror);
+
+    if (use_mirror) {
+      EDBM_verts_mirror_cache_end(em);
+    }
   }
 
   if (tot_selected == 0 && !tot_locked) {
@@ -13,8 +13,10 @@
 #include "DNA_object_types.h"
 
 #include "BLI_array.hh"
+#include "BLI_bitmap.h"
 #include "BLI_kdtree.h"
 #include "BLI_listbase.h"
+#include "BLI_math_geom.h"
 #include "BLI_math_matrix.h"
 #include "BLI_math_vector.h"
 
@@ -1652,24 +1654,49 @@ void EDBM_stats_update(BMEditMesh *em)
   }
 }
 
-void EDBM_update(Mesh *mesh, const EDBMUpdate_Params *params)
+/**
+ * \param bmpinfo: When not null, only update the normals and tessellation of the geometry it
+ * contains.
+ */
+static void edbm_update_ex(Mesh *mesh,
+                           const EDBMUpdate_Params *params,
+                           const eEditMeshUpdateType update_type,
+                           BMPartialUpdate *bmpinfo)
 {
   BMEditMesh *em = mesh->runtime->edit_mesh.get();
   /* Order of calling isn't important. */
+  BKE_editmesh_update_tag(em, update_type);
   DEG_id_tag_update(&mesh->id, ID_RECALC_GEOMETRY);
   WM_main_add_notifier(NC_GEOM | ND_DATA, &mesh->id);
 
   if (params->calc_normals && params->calc_looptris) {
     /* Calculating both has some performance gains. */
-    BKE_editmesh_looptris_and_normals_calc(em);
+    if (bmpinfo) {
+      BKE_editmesh_looptris_and_normals_calc_with_partial(em, bmpinfo);
+    }
+    else {
+      BKE_editmesh_looptris_and_normals_calc(em);
+    }
   }
   else {
     if (params->calc_normals) {
-      EDBM_mesh_normals_update(em);
+      if (bmpinfo) {
+        BMeshNormalsUpdate_Params normals_params{};
+        normals_params.face_normals = true;
+        BM_mesh_normals_update_with_partial_ex(em->bm, bmpinfo, &normals_params);
+      }
+      else {
+        EDBM_mesh_normals_update(em);
+      }
     }
 
     if (params->calc_looptris) {
-      BKE_editmesh_looptris_calc(em);
+      if (bmpinfo) {
+        BKE_editmesh_looptris_calc_with_partial(em, bmpinfo);
+      }
+      else {
+        BKE_editmesh_looptris_calc(em);
+      }
     }
   }
 
@@ -1695,6 +1722,66 @@ void EDBM_update(Mesh *mesh, const EDBMUpdate_Params *params)
 #endif
 }
 
+void EDBM_update(Mesh *mesh, const EDBMUpdate_Params *params)
+{
+  edbm_update_ex(mesh, params, BKE_EDITMESH_UPDATE_ALL, nullptr);
+}
+
+void EDBM_update_from_moved_verts(Mesh *mesh,
+                                  const EDBMUpdate_Params *params,
+                                  const char hflag,
+                                  const bool use_mirror)
+{
+  BLI_assert(!params->is_destructive);
+  BMEditMesh *em = mesh->runtime->edit_mesh.get();
+  BMesh *bm = em->bm;
+
+  if (em->looptris.size() != poly_to_tri_count(bm->totface, bm->totloop)) {
+    /* The tessellation is out of date with the topology, so it can't be updated partially. */
+    edbm_update_ex(mesh, params, BKE_EDITMESH_UPDATE_ALL, nullptr);
+    return;
+  }
+  if (!(params->calc_normals || params->calc_looptris)) {
+    edbm_update_ex(mesh, params, BKE_EDITMESH_UPDATE_DEFORM, nullptr);
+    return;
+  }
+
+  BM_mesh_elem_index_ensure(bm, BM_VERT);
+  BLI_bitmap *verts_mask = BLI_BITMAP_NEW(bm->totvert, __func__);
+  int verts_mask_count = 0;
+  BMIter iter;
+  BMVert *v;
+  BM_ITER_MESH (v, &iter, bm, BM_VERTS_OF_MESH) {
+    if (!BM_elem_flag_test(v, hflag)) {
+      continue;
+    }
+    for (BMVert *v_moved : {v, use_mirror ? EDBM_verts_mirror_get(em, v) : nullptr}) {
+      if (v_moved && !BLI_BITMAP_TEST_BOOL(verts_mask, BM_elem_index_get(v_moved))) {
+        BLI_BITMAP_ENABLE(verts_mask, BM_elem_index_get(v_moved));
+        verts_mask_count++;
+      }
+    }
+  }
+
+  /* Gathering the connected geometry is only worth it when a small part of the mesh moved,
+   * otherwise updating everything is faster. */
+  if (verts_mask_count > bm->totvert / 4) {
+    MEM_freeN(verts_mask);
+    edbm_update_ex(mesh, params, BKE_EDITMESH_UPDATE_DEFORM, nullptr);
+    return;
+  }
+
+  BMPartialUpdate_Params partial_params{};
+  partial_params.do_normals = params->calc_normals;
+  partial_params.do_tessellate = params->calc_looptris;
+  BMPartialUpdate *bmpinfo = BM_mesh_partial_create_from_verts(
+      bm, &partial_params, verts_mask, verts_mask_count);
+  MEM_freeN(verts_mask);
+
+  edbm_update_ex(mesh, params, BKE_EDITMESH_UPDATE_DEFORM, bmpinfo);
+  BM_mesh_partial_destroy(bmpinfo);
+}
+
 void EDBM_update_extern(Mesh *mesh, const bool do_tessellation, const bool is_destructive)
 {
   EDBMUpdate_Params params{};
@@ -499,6 +499,16 @@ static int start_bake_job(bContext *C,
   return OPERATOR_RUNNING_MODAL;
 }
 
+static std::unique_ptr<bake::BlobWriteSharing> create_blob_write_sharing(
+    const NodesModifierData &nmd, const int bake_id)
+{
+  const NodesModifierBake *bake = nmd.find_bake(bake_id);
+  const bool use_compression = bake && (bake->flag & NODES_MODIFIER_BAKE_COMPRESS);
+  return std::make_unique<bake::BlobWriteSharing>(use_compression ?
+                                                      bake::BlobCompression::ZstdShuffle :
+                                                      bake::BlobCompression::None);
+}
+
 static Vector<NodeBakeRequest> collect_simulations_to_bake(Main &bmain,
                                                            Scene &scene,
                                                            const Span<Object *> objects)
@@ -533,7 +543,7 @@ static Vector<NodeBakeRequest> collect_simulations_to_bake(Main &bmain,
         request.nmd = nmd;
         request.bake_id = id;
         request.node_type = node->type;
-        request.blob_sharing = std::make_unique<bake::BlobWriteSharing>();
+        request.blob_sharing = create_blob_write_sharing(*nmd, id);
         std::optional<bake::BakePath> path = bake::get_node_bake_path(bmain, *object, *nmd, id);
         if (!path) {
           continue;
@@ -834,7 +844,7 @@ static Vector<NodeBakeRequest> bake_single_node_gather_bake_request(bContext *C,
   request.nmd = &nmd;
   request.bake_id = bake_id;
   request.node_type = node->type;
-  request.blob_sharing = std::make_unique<bake::BlobWriteSharing>();
+  request.blob_sharing = create_blob_write_sharing(nmd, bake_id);
 
   const NodesModifierBake *bake = nmd.find_bake(bake_id);
   if (!bake) {
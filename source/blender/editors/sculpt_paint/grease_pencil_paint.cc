@@ -1097,7 +1097,7 @@ static void smooth_stroke(bke::greasepencil::Drawing &drawing,
                                    true,
                                    positions.span);
   positions.finish();
-  drawing.tag_positions_changed();
+  drawing.tag_positions_changed(stroke);
 
   if (drawing.opacities().is_span()) {
     bke::GSpanAttributeWriter opacities = attributes.lookup_for_write_span("opacity");
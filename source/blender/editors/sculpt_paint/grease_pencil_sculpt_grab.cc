@@ -16,6 +16,7 @@
 
 #include "DNA_grease_pencil_types.h"
 #include "DNA_view3d_types.h"
+#include "ED_curves.hh"
 #include "ED_grease_pencil.hh"
 #include "ED_view3d.hh"
 
@@ -229,7 +230,10 @@ void GrabOperation::on_stroke_extended(const bContext &C, const InputSample &ext
           positions[point_i] = placement.project(new_pos_view);
         });
 
-        params.drawing.tag_positions_changed();
+        /* Only a few strokes are usually grabbed, keep the fill triangles of the others. */
+        IndexMaskMemory memory;
+        params.drawing.tag_positions_changed(
+            ed::curves::curve_mask_from_points(curves, mask, GrainSize(512), memory));
         return true;
       });
   this->stroke_extended(extension_sample);
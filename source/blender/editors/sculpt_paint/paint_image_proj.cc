@@ -5221,6 +5221,13 @@ static void do_projectpaint_thread(TaskPool *__restrict /*pool*/, void *ph_v)
   /* mem arena for this brush projection only */
   MemArena *softenArena = nullptr;
 
+  /* for gradient fill only, the line is the same for every pixel */
+  float gradient_tangent[2];
+  sub_v2_v2v2(gradient_tangent, pos, lastpos);
+  const float gradient_line_len_sq = len_squared_v2(gradient_tangent);
+  const float gradient_line_len_sq_inv = 1.0f / gradient_line_len_sq;
+  const float gradient_line_len_inv = 1.0f / sqrtf(gradient_line_len_sq);
+
   if (brush_type == IMAGE_PAINT_BRUSH_TYPE_SMEAR) {
     pos_ofs[0] = pos[0] - lastpos[0];
     pos_ofs[1] = pos[1] - lastpos[1];
@@ -5267,9 +5274,6 @@ static void do_projectpaint_thread(TaskPool *__restrict /*pool*/, void *ph_v)
         /* fill brushes */
         if (ps->source == PROJ_SRC_VIEW_FILL) {
           if (brush->flag & BRUSH_USE_GRADIENT) {
-            /* these could probably be cached instead of being done per pixel */
-            float tangent[2];
-            float line_len_sq_inv, line_len;
             float f;
             float color_f[4];
             const float p[2] = {
@@ -5277,19 +5281,14 @@ static void do_projectpaint_thread(TaskPool *__restrict /*pool*/, void *ph_v)
                 projPixel->projCoSS[1] - lastpos[1],
             };
 
-            sub_v2_v2v2(tangent, pos, lastpos);
-            line_len = len_squared_v2(tangent);
-            line_len_sq_inv = 1.0f / line_len;
-            line_len = sqrtf(line_len);
-
             switch (brush->gradient_fill_mode) {
               case BRUSH_GRADIENT_LINEAR: {
-                f = dot_v2v2(p, tangent) * line_len_sq_inv;
+                f = dot_v2v2(p, gradient_tangent) * gradient_line_len_sq_inv;
                 break;
               }
               case BRUSH_GRADIENT_RADIAL:
               default: {
-                f = len_v2(p) / line_len;
+                f = len_v2(p) * gradient_line_len_inv;
                 break;
               }
             }
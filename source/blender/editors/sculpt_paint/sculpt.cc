@@ -6815,6 +6815,19 @@ void filter_region_clip_factors(const SculptSession &ss,
   }
 }
 
+/**
+ * Squared distance from the location to the position projected on the plane through the location
+ * with the given normal. Computed inline without the plane equation so that the loops over all
+ * vertices of a node are vectorized.
+ */
+BLI_INLINE float tube_distance_squared(const float3 &location,
+                                       const float3 &normal,
+                                       const float3 &position)
+{
+  const float3 offset = position - location;
+  return math::length_squared(offset - normal * math::dot(offset, normal));
+}
+
 void calc_brush_distances_squared(const SculptSession &ss,
                                   const Span<float3> positions,
                                   const Span<int> verts,
@@ -6828,12 +6841,8 @@ void calc_brush_distances_squared(const SculptSession &ss,
     /* The tube falloff shape requires the cached view normal. */
     const float3 &view_normal = ss.cache ? ss.cache->view_normal_symm :
                                            ss.filter_cache->view_normal;
-    float4 test_plane;
-    plane_from_point_normal_v3(test_plane, test_location, view_normal);
     for (const int i : verts.index_range()) {
-      float3 projected;
-      closest_to_plane_normalized_v3(projected, test_plane, positions[verts[i]]);
-      r_distances[i] = math::distance_squared(projected, test_location);
+      r_distances[i] = tube_distance_squared(test_location, view_normal, positions[verts[i]]);
     }
   }
   else {
@@ -6867,12 +6876,8 @@ void calc_brush_distances_squared(const SculptSession &ss,
     /* The tube falloff shape requires the cached view normal. */
     const float3 &view_normal = ss.cache ? ss.cache->view_normal_symm :
                                            ss.filter_cache->view_normal;
-    float4 test_plane;
-    plane_from_point_normal_v3(test_plane, test_location, view_normal);
     for (const int i : positions.index_range()) {
-      float3 projected;
-      closest_to_plane_normalized_v3(projected, test_plane, positions[i]);
-      r_distances[i] = math::distance_squared(projected, test_location);
+      r_distances[i] = tube_distance_squared(test_location, view_normal, positions[i]);
     }
   }
   else {
@@ -6898,9 +6903,7 @@ void filter_distances_with_radius(const float radius,
                                   const MutableSpan<float> factors)
 {
   for (const int i : distances.index_range()) {
-    if (distances[i] > radius) {
-      factors[i] = 0.0f;
-    }
+    factors[i] = distances[i] > radius ? 0.0f : factors[i];
   }
 }
 
@@ -6999,16 +7002,11 @@ void apply_hardness_to_distances(const float radius,
     return;
   }
   const float threshold = hardness * radius;
-  const float radius_inv = math::rcp(radius);
   const float hardness_inv_rcp = math::rcp(1.0f - hardness);
+  /* Same as remapping the normalized distance from the [hardness, 1] range to [0, 1], but without
+   * branches so the loop is vectorized. */
   for (const int i : distances.index_range()) {
-    if (distances[i] < threshold) {
-      distances[i] = 0.0f;
-    }
-    else {
-      const float radius_factor = (distances[i] * radius_inv - hardness) * hardness_inv_rcp;
-      distances[i] = radius_factor * radius;
-    }
+    distances[i] = std::max((distances[i] - threshold) * hardness_inv_rcp, 0.0f);
   }
 }
 
@@ -31,7 +31,10 @@
  */
 #include "sculpt_undo.hh"
 
+#include <array>
+#include <atomic>
 #include <mutex>
+#include <zstd.h>
 
 #include "MEM_guardedalloc.h"
 
@@ -40,6 +43,8 @@
 #include "BLI_listbase.h"
 #include "BLI_map.hh"
 #include "BLI_string.h"
+#include "BLI_task.h"
+#include "BLI_task.hh"
 #include "BLI_utildefines.h"
 #include "BLI_vector.hh"
 
@@ -47,6 +52,7 @@
 #include "DNA_object_types.h"
 #include "DNA_scene_types.h"
 #include "DNA_screen_types.h"
+#include "DNA_userdef_types.h"
 
 #include "BKE_attribute.hh"
 #include "BKE_ccg.hh"
@@ -142,6 +148,13 @@ struct Node {
 
   Array<float4, 0> loop_col;
 
+  /**
+   * The value arrays above compressed together once the undo step is old enough, see
+   * #node_compress. The arrays are then empty and their sizes are stored in #compressed_sizes.
+   */
+  Array<std::byte, 0> compressed_data;
+  std::array<int64_t, 5> compressed_sizes;
+
   /* Mesh. */
 
   Array<int, 0> vert_indices;
@@ -255,7 +268,11 @@ struct StepData {
   /** Storage of per-node undo data after creation of the undo step is finished. */
   Vector<std::unique_ptr<Node>> nodes;
 
-  size_t undo_size;
+  /** Background compression of the nodes of old steps, see #step_compress. */
+  TaskPool *compress_pool = nullptr;
+
+  /** Updated by the compression task, so that the undo memory limit accounts for it. */
+  std::atomic<size_t> undo_size = 0;
 };
 
 struct SculptUndoStep {
@@ -942,6 +959,168 @@ static void refine_subdiv(Depsgraph *depsgraph,
       subdiv, static_cast<const Mesh *>(object.data), deformed_verts);
 }
 
+/* -------------------------------------------------------------------- */
+/** \name Compression of Old Undo Steps
+ *
+ * The value arrays of the nodes of steps older than #UserDef.undo_compress_steps are compressed
+ * in the background, since sculpting on dense meshes stores a lot of them. They are only
+ * decompressed again when the step is restored.
+ * \{ */
+
+/** Nodes with less data than this are not worth compressing. */
+#define NODE_COMPRESS_MIN_SIZE 4096
+#define NODE_COMPRESS_LEVEL 1
+
+/** Call the function for each value array of the node, in a fixed order. */
+template<typename Fn> static void node_foreach_value_array(Node &node, const Fn &fn)
+{
+  fn(node.position);
+  fn(node.orig_position);
+  fn(node.col);
+  fn(node.mask);
+  fn(node.loop_col);
+}
+
+/**
+ * Compress the value arrays of the node, returning the number of bytes saved. All values are
+ * made of 32-bit floats, whose bytes are shuffled by significance before compression, since the
+ * exponent and high mantissa bytes of nearby values are very similar.
+ */
+static size_t node_compress(Node &node)
+{
+  if (!node.compressed_data.is_empty()) {
+    return 0;
+  }
+  int64_t size = 0;
+  node_foreach_value_array(node, [&](auto &array) { size += array.as_span().size_in_bytes(); });
+  if (size < NODE_COMPRESS_MIN_SIZE) {
+    return 0;
+  }
+
+  const int64_t values_num = size / sizeof(float);
+  Array<std::byte> shuffled(size);
+  int64_t value_offset = 0;
+  node_foreach_value_array(node, [&](auto &array) {
+    const Span<std::byte> bytes = array.as_span().template cast<std::byte>();
+    const int64_t array_values_num = bytes.size() / int64_t(sizeof(float));
+    for (const int64_t i : IndexRange(array_values_num)) {
+      for (const int64_t byte : IndexRange(sizeof(float))) {
+        shuffled[byte * values_num + value_offset + i] = bytes[i * sizeof(float) + byte];
+      }
+    }
+    value_offset += array_values_num;
+  });
+
+  Array<std::byte> compressed(ZSTD_compressBound(size));
+  const size_t compressed_size = ZSTD_compress(
+      compressed.data(), compressed.size(), shuffled.data(), size, NODE_COMPRESS_LEVEL);
+  if (ZSTD_isError(compressed_size) || compressed_size >= size_t(size - size / 8)) {
+    return 0;
+  }
+
+  node.compressed_data = compressed.as_span().take_front(compressed_size);
+  int array_index = 0;
+  node_foreach_value_array(node, [&](auto &array) {
+    node.compressed_sizes[array_index++] = array.size();
+    array = {};
+  });
+  return size - compressed_size;
+}
+
+/** Restore the value arrays of a compressed node, returning the number of bytes added. */
+static size_t node_decompress(Node &node)
+{
+  if (node.compressed_data.is_empty()) {
+    return 0;
+  }
+  int array_index = 0;
+  int64_t size = 0;
+  node_foreach_value_array(node, [&](auto &array) {
+    array.reinitialize(node.compressed_sizes[array_index++]);
+    size += array.as_span().size_in_bytes();
+  });
+
+  Array<std::byte> shuffled(size);
+  const size_t decompressed_size = ZSTD_decompress(
+      shuffled.data(), size, node.compressed_data.data(), node.compressed_data.size());
+  BLI_assert(decompressed_size == size_t(size));
+  UNUSED_VARS_NDEBUG(decompressed_size);
+
+  const int64_t values_num = size / sizeof(float);
+  int64_t value_offset = 0;
+  node_foreach_value_array(node, [&](auto &array) {
+    const MutableSpan<std::byte> bytes = array.as_mutable_span().template cast<std::byte>();
+    const int64_t array_values_num = bytes.size() / int64_t(sizeof(float));
+    for (const int64_t i : IndexRange(array_values_num)) {
+      for (const int64_t byte : IndexRange(sizeof(float))) {
+        bytes[i * sizeof(float) + byte] = shuffled[byte * values_num + value_offset + i];
+      }
+    }
+    value_offset += array_values_num;
+  });
+
+  const size_t compressed_size = node.compressed_data.size();
+  node.compressed_data = {};
+  return size - compressed_size;
+}
+
+static void step_compress_task_run(TaskPool *__restrict pool, void *taskdata)
+{
+  StepData &step_data = *static_cast<StepData *>(taskdata);
+  threading::parallel_for(step_data.nodes.index_range(), 1, [&](const IndexRange range) {
+    for (const int i : range) {
+      if (BLI_task_pool_current_canceled(pool)) {
+        return;
+      }
+      step_data.undo_size -= node_compress(*step_data.nodes[i]);
+    }
+  });
+}
+
+/** Compress the nodes of a step that is not active anymore in the background. */
+static void step_compress(StepData &step_data)
+{
+  if (step_data.compress_pool || step_data.nodes.is_empty()) {
+    return;
+  }
+  step_data.compress_pool = BLI_task_pool_create_background(&step_data, TASK_PRIORITY_LOW);
+  BLI_task_pool_push(step_data.compress_pool, step_compress_task_run, &step_data, false, nullptr);
+}
+
+/** Stop any pending compression of the step, the step data can be freed afterwards. */
+static void step_compress_cancel(StepData &step_data)
+{
+  if (!step_data.compress_pool) {
+    return;
+  }
+  BLI_task_pool_cancel(step_data.compress_pool);
+  BLI_task_pool_free(step_data.compress_pool);
+  step_data.compress_pool = nullptr;
+}
+
+/** Make the node data of the step readable and writable again before restoring it. */
+static void step_ensure_uncompressed(StepData &step_data)
+{
+  if (!step_data.compress_pool) {
+    return;
+  }
+  /* Finishing the compression is not worth delaying undo for. */
+  step_compress_cancel(step_data);
+  step_data.undo_size += threading::parallel_reduce(
+      step_data.nodes.index_range(),
+      1,
+      size_t(0),
+      [&](const IndexRange range, size_t size) {
+        for (const int i : range) {
+          size += node_decompress(*step_data.nodes[i]);
+        }
+        return size;
+      },
+      std::plus<size_t>());
+}
+
+/** \} */
+
 static void restore_list(bContext *C, Depsgraph *depsgraph, StepData &step_data)
 {
   Scene *scene = CTX_data_scene(C);
@@ -955,6 +1134,8 @@ static void restore_list(bContext *C, Depsgraph *depsgraph, StepData &step_data)
   SculptSession &ss = *object.sculpt;
   bke::pbvh::Tree &pbvh = *bke::object::pbvh_get(object);
 
+  step_ensure_uncompressed(step_data);
+
   /* Restore pivot. */
   ss.pivot_pos = step_data.pivot_pos;
   ss.pivot_rot = step_data.pivot_rot;
@@ -1230,6 +1411,7 @@ static void restore_list(bContext *C, Depsgraph *depsgraph, StepData &step_data)
 
 static void free_step_data(StepData &step_data)
 {
+  step_compress_cancel(step_data);
   geometry_free_data(&step_data.geometry_original);
   geometry_free_data(&step_data.geometry_modified);
   geometry_free_data(&step_data.geometry_bmesh_enter);
@@ -1870,6 +2052,7 @@ static size_t node_size_in_bytes(const Node &node)
   size += node.col.as_span().size_in_bytes();
   size += node.mask.as_span().size_in_bytes();
   size += node.loop_col.as_span().size_in_bytes();
+  size += node.compressed_data.as_span().size_in_bytes();
   size += node.vert_indices.as_span().size_in_bytes();
   size += node.corner_indices.as_span().size_in_bytes();
   size += node.vert_hidden.size() / 8;
@@ -1993,6 +2176,23 @@ static bool step_encode(bContext * /*C*/, Main *bmain, UndoStep *us_p)
   SculptUndoStep *us = (SculptUndoStep *)us_p;
   us->step.data_size = us->data.undo_size;
 
+  if (U.undo_compress_steps != 0) {
+    /* Compress the step that just became old enough in the background, and update the memory
+     * usage of steps compressed since the last push. */
+    UndoStack *ustack = ED_undo_stack_get();
+    int sculpt_steps_num = 0;
+    LISTBASE_FOREACH_BACKWARD (UndoStep *, us_iter, &ustack->steps) {
+      if (us_iter->type != BKE_UNDOSYS_TYPE_SCULPT) {
+        continue;
+      }
+      StepData &step_data = reinterpret_cast<SculptUndoStep *>(us_iter)->data;
+      if (++sculpt_steps_num == U.undo_compress_steps) {
+        step_compress(step_data);
+      }
+      us_iter->data_size = step_data.undo_size;
+    }
+  }
+
   Node *unode = us->data.nodes.is_empty() ? nullptr : us->data.nodes.last().get();
   if (unode && us->data.type == Type::DyntopoEnd) {
     us->step.use_memfile_step = true;
@@ -653,6 +653,21 @@ static void buttons_area_redraw(ScrArea *area, short buttons)
   }
 }
 
+/**
+ * Like #buttons_area_redraw, for changes of property values that can't change the context path
+ * in the header or the available tabs in the navigation bar, so only the main region has to be
+ * rebuilt. This avoids running the layout of all header and tab buttons for every frame during
+ * playback.
+ */
+static void buttons_main_region_redraw(ScrArea *area, short buttons)
+{
+  SpaceProperties *sbuts = static_cast<SpaceProperties *>(area->spacedata.first);
+
+  if (sbuts->mainb == buttons) {
+    ED_area_tag_redraw_regiontype(area, RGN_TYPE_WINDOW);
+  }
+}
+
 /** \} */
 
 /* -------------------------------------------------------------------- */
@@ -680,8 +695,9 @@ static void buttons_area_listener(const wmSpaceTypeListenerParams *params)
           sbuts->preview = 1;
           break;
         case ND_FRAME:
-          /* any buttons area can have animated properties so redraw all */
-          ED_area_tag_redraw(area);
+          /* Any buttons area can have animated properties so redraw all, the context path and
+           * tabs don't depend on the frame though. */
+          ED_area_tag_redraw_regiontype(area, RGN_TYPE_WINDOW);
           sbuts->preview = 1;
           break;
         case ND_OB_ACTIVE:
@@ -703,8 +719,8 @@ static void buttons_area_listener(const wmSpaceTypeListenerParams *params)
     case NC_OBJECT:
       switch (wmn->data) {
         case ND_TRANSFORM:
-          buttons_area_redraw(area, BCONTEXT_OBJECT);
-          buttons_area_redraw(area, BCONTEXT_DATA); /* Auto-texture-space flag. */
+          buttons_main_region_redraw(area, BCONTEXT_OBJECT);
+          buttons_main_region_redraw(area, BCONTEXT_DATA); /* Auto-texture-space flag. */
           break;
         case ND_POSE:
         case ND_BONE_ACTIVE:
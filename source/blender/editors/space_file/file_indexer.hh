@@ -14,3 +14,9 @@
  * set it won't use indexing. It is added to increase the code clarity.
  */
 extern const FileIndexerType file_indexer_noop;
+
+/**
+ * Indexer storing all linkable data-blocks of blend files, used when browsing their contents.
+ * Implemented in `file_library_indexer.cc`.
+ */
+extern const FileIndexerType file_indexer_library;
@@ -0,0 +1,249 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup edfile
+ *
+ * Indexer used when browsing the contents of blend files (e.g. when linking or appending). Unlike
+ * the asset indexer it stores all linkable data-blocks, so listing a library file or one of its
+ * ID groups doesn't need to open and scan the file again until it changes.
+ */
+
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+#include "file_indexer.hh"
+
+#include "MEM_guardedalloc.h"
+
+#include "BLI_fileops.h"
+#include "BLI_hash.hh"
+#include "BLI_linklist.h"
+#include "BLI_path_util.h"
+#include "BLI_serialize.hh"
+#include "BLI_string.h"
+#include "BLI_string_ref.hh"
+
+#include "BKE_appdir.hh"
+#include "BKE_asset.hh"
+
+#include "DNA_ID.h"
+
+#include "CLG_log.h"
+
+static CLG_LogRef LOG = {"ed.file.indexer"};
+
+namespace blender::ed::file::indexer {
+
+using namespace blender::io::serialize;
+
+/**
+ * Indexes are stored per blend file in
+ * #BKE_appdir_folder_caches + /library-indices/<file-path-hash>_<file-name>.index.json.
+ *
+ * The structure of an index file is
+ * \code
+ * {
+ *   "version": <file version number>,
+ *   "file_size": <size of the blend file>,
+ *   "file_mtime": <modification time of the blend file>,
+ *   "entries": [{
+ *     "name": "<ID name, including the ID code>",
+ *     "asset": 1,
+ *     "no_preview": 1
+ *   }]
+ * }
+ * \endcode
+ *
+ * The index is only used when the size and modification time of the blend file match the ones
+ * stored in the index. This doesn't depend on the clocks of the machine storing the index and the
+ * one storing the blend file being in sync, which matters for libraries on network drives.
+ *
+ * NOTE: `asset` and `no_preview` are optional attributes. Only the fact that a data-block is an
+ * asset is stored, not its meta-data.
+ */
+constexpr StringRef ATTRIBUTE_VERSION("version");
+constexpr StringRef ATTRIBUTE_FILE_SIZE("file_size");
+constexpr StringRef ATTRIBUTE_FILE_MTIME("file_mtime");
+constexpr StringRef ATTRIBUTE_ENTRIES("entries");
+constexpr StringRef ATTRIBUTE_ENTRIES_NAME("name");
+constexpr StringRef ATTRIBUTE_ENTRIES_ASSET("asset");
+constexpr StringRef ATTRIBUTE_ENTRIES_NO_PREVIEW("no_preview");
+
+/**
+ * Version to store in new index files. Increase when changing the structure of the index.
+ */
+constexpr int CURRENT_VERSION = 1;
+
+struct BlendFileStat {
+  int64_t size;
+  int64_t mtime;
+};
+
+static std::optional<BlendFileStat> blend_file_stat(const char *filepath)
+{
+  BLI_stat_t stat = {};
+  if (BLI_stat(filepath, &stat) == -1) {
+    return std::nullopt;
+  }
+  return BlendFileStat{int64_t(stat.st_size), int64_t(stat.st_mtime)};
+}
+
+/**
+ * `{BKE_appdir_folder_caches}/library-indices/{file-path-hash}_{file-name}.index.json`.
+ */
+static std::string index_file_path(const char *filepath)
+{
+  char index_path[FILE_MAX];
+  BKE_appdir_folder_caches(index_path, sizeof(index_path));
+  BLI_path_append(index_path, sizeof(index_path), "library-indices");
+
+  char filename[FILE_MAX];
+  BLI_path_split_file_part(filepath, filename, sizeof(filename));
+
+  std::stringstream ss;
+  ss << index_path << SEP_STR << std::setfill('0') << std::setw(16) << std::hex
+     << get_default_hash(StringRef(filepath)) << "_" << filename << ".index.json";
+  return ss.str();
+}
+
+static void init_value_from_file_indexer_entry(DictionaryValue &result,
+                                               const FileIndexerEntry &indexer_entry)
+{
+  const BLODataBlockInfo &datablock_info = indexer_entry.datablock_info;
+
+  /* Joined like #ID.name, see the asset indexer. */
+  char idcode_prefix[2];
+  *((short *)idcode_prefix) = indexer_entry.idcode;
+  result.append_str(ATTRIBUTE_ENTRIES_NAME,
+                    std::string(idcode_prefix, sizeof(idcode_prefix)) + datablock_info.name);
+
+  if (datablock_info.asset_data) {
+    result.append_int(ATTRIBUTE_ENTRIES_ASSET, 1);
+  }
+  if (datablock_info.no_preview_found) {
+    result.append_int(ATTRIBUTE_ENTRIES_NO_PREVIEW, 1);
+  }
+}
+
+static bool init_indexer_entry_from_value(FileIndexerEntry &indexer_entry,
+                                          const DictionaryValue &entry)
+{
+  const std::optional<StringRefNull> idcode_name = entry.lookup_str(ATTRIBUTE_ENTRIES_NAME);
+  if (!idcode_name || idcode_name->size() <= 2) {
+    return false;
+  }
+
+  indexer_entry.idcode = GS(idcode_name->data());
+  idcode_name->substr(2).copy(indexer_entry.datablock_info.name);
+
+  if (entry.lookup_int(ATTRIBUTE_ENTRIES_ASSET).value_or(0)) {
+    /* Only used to tag the entry as asset. */
+    indexer_entry.datablock_info.asset_data = BKE_asset_metadata_create();
+    indexer_entry.datablock_info.free_asset_data = true;
+  }
+  indexer_entry.datablock_info.no_preview_found =
+      entry.lookup_int(ATTRIBUTE_ENTRIES_NO_PREVIEW).value_or(0) != 0;
+  return true;
+}
+
+static eFileIndexerResult read_index(const char *filename,
+                                     FileIndexerEntries *entries,
+                                     int *r_read_entries_len,
+                                     void * /*user_data*/)
+{
+  const std::optional<BlendFileStat> file_stat = blend_file_stat(filename);
+  const std::string index_path = index_file_path(filename);
+  if (!file_stat || !BLI_exists(index_path.c_str())) {
+    return FILE_INDEXER_NEEDS_UPDATE;
+  }
+
+  JsonFormatter formatter;
+  std::ifstream is;
+  is.open(index_path);
+  const std::unique_ptr<Value> contents = formatter.deserialize(is);
+  is.close();
+
+  const DictionaryValue *root = contents ? contents->as_dictionary_value() : nullptr;
+  if (root == nullptr || root->lookup_int(ATTRIBUTE_VERSION) != CURRENT_VERSION) {
+    CLOG_INFO(&LOG, 3, "Library index file [%s] is ignored, unknown version.", index_path.c_str());
+    return FILE_INDEXER_NEEDS_UPDATE;
+  }
+  if (root->lookup_int(ATTRIBUTE_FILE_SIZE) != file_stat->size ||
+      root->lookup_int(ATTRIBUTE_FILE_MTIME) != file_stat->mtime)
+  {
+    CLOG_INFO(&LOG, 3, "Library index file [%s] needs to be refreshed.", index_path.c_str());
+    return FILE_INDEXER_NEEDS_UPDATE;
+  }
+
+  int read_entries_len = 0;
+  if (const ArrayValue *array = root->lookup_array(ATTRIBUTE_ENTRIES)) {
+    for (const std::shared_ptr<Value> &element : array->elements()) {
+      const DictionaryValue *entry_value = element->as_dictionary_value();
+      if (entry_value == nullptr) {
+        continue;
+      }
+      FileIndexerEntry *entry = static_cast<FileIndexerEntry *>(
+          MEM_callocN(sizeof(FileIndexerEntry), __func__));
+      if (!init_indexer_entry_from_value(*entry, *entry_value)) {
+        MEM_freeN(entry);
+        continue;
+      }
+      BLI_linklist_prepend(&entries->entries, entry);
+      read_entries_len++;
+    }
+  }
+
+  CLOG_INFO(&LOG, 1, "Read %d entries from library index for [%s].", read_entries_len, filename);
+  *r_read_entries_len = read_entries_len;
+  return FILE_INDEXER_ENTRIES_LOADED;
+}
+
+static void update_index(const char *filename, FileIndexerEntries *entries, void * /*user_data*/)
+{
+  const std::optional<BlendFileStat> file_stat = blend_file_stat(filename);
+  if (!file_stat) {
+    return;
+  }
+
+  DictionaryValue root;
+  root.append_int(ATTRIBUTE_VERSION, CURRENT_VERSION);
+  root.append_int(ATTRIBUTE_FILE_SIZE, file_stat->size);
+  root.append_int(ATTRIBUTE_FILE_MTIME, file_stat->mtime);
+  ArrayValue &array = *root.append_array(ATTRIBUTE_ENTRIES);
+  for (LinkNode *ln = entries->entries; ln; ln = ln->next) {
+    const FileIndexerEntry *indexer_entry = static_cast<const FileIndexerEntry *>(ln->link);
+    init_value_from_file_indexer_entry(*array.append_dict(), *indexer_entry);
+  }
+
+  const std::string index_path = index_file_path(filename);
+  if (!BLI_file_ensure_parent_dir_exists(index_path.c_str())) {
+    CLOG_ERROR(&LOG, "Index not created: couldn't create folder [%s].", index_path.c_str());
+    return;
+  }
+  CLOG_INFO(&LOG,
+            1,
+            "Update library index for [%s] store index in [%s].",
+            filename,
+            index_path.c_str());
+
+  JsonFormatter formatter;
+  std::ofstream os;
+  os.open(index_path, std::ios::out | std::ios::trunc);
+  formatter.serialize(os, root);
+  os.close();
+}
+
+constexpr FileIndexerType library_indexer()
+{
+  FileIndexerType indexer = {nullptr};
+  indexer.read_index = read_index;
+  indexer.update_index = update_index;
+  return indexer;
+}
+
+}  // namespace blender::ed::file::indexer
+
+const FileIndexerType file_indexer_library = blender::ed::file::indexer::library_indexer();
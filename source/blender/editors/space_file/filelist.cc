@@ -37,12 +37,15 @@
 #include "BLI_ghash.h"
 #include "BLI_linklist.h"
 #include "BLI_math_vector.h"
+#include "BLI_set.hh"
 #include "BLI_stack.h"
 #include "BLI_string_utils.hh"
 #include "BLI_task.h"
+#include "BLI_task.hh"
 #include "BLI_threads.h"
 #include "BLI_utildefines.h"
 #include "BLI_uuid.h"
+#include "BLI_vector.hh"
 
 #ifdef WIN32
 #  include "BLI_winstuff.h"
@@ -2996,6 +2999,17 @@ struct TodoDir {
   char *dir;
 };
 
+/** A #TodoDir taken from the stack of pending directories, with the result of reading it. */
+struct TodoDirRead {
+  int level;
+  char *dir;
+  /** The path of #dir relative to the filelist root, see #FileListReadJob.cur_relbase. */
+  char rel_subdir[FILE_MAX_LIBEXTRA];
+  ListBase entries = {nullptr};
+  int entries_num = 0;
+  bool is_lib = false;
+};
+
 struct FileListReadJob {
   ThreadMutex lock;
   char main_filepath[FILE_MAX];
@@ -3032,13 +3046,11 @@ struct FileListReadJob {
 
 /**
  * Append \a filename (or even a path inside of a .blend, like `Material/Material.001`), to the
- * current relative path being read within the filelist root. The returned string needs freeing
- * with #MEM_freeN().
+ * relative path being read within the filelist root (usually #FileListReadJob.cur_relbase). The
+ * returned string needs freeing with #MEM_freeN().
  */
-static char *current_relpath_append(const FileListReadJob *job_params, const char *filename)
+static char *current_relpath_append(const char *relbase, const char *filename)
 {
-  const char *relbase = job_params->cur_relbase;
-
   /* Early exit, nothing to join. */
   if (!relbase[0]) {
     return BLI_strdup(filename);
@@ -3082,7 +3094,7 @@ static int filelist_readjob_list_dir(FileListReadJob *job_params,
       }
 
       entry = MEM_new<FileListInternEntry>(__func__);
-      entry->relpath = current_relpath_append(job_params, files[i].relname);
+      entry->relpath = current_relpath_append(job_params->cur_relbase, files[i].relname);
       entry->st = files[i].s;
 
       BLI_path_join(full_path, FILE_MAX, root, files[i].relname);
@@ -3170,11 +3182,12 @@ enum ListLibOptions {
 };
 ENUM_OPERATORS(ListLibOptions, LIST_LIB_ADD_PARENT);
 
-static FileListInternEntry *filelist_readjob_list_lib_group_create(
-    const FileListReadJob *job_params, const int idcode, const char *group_name)
+static FileListInternEntry *filelist_readjob_list_lib_group_create(const char *relbase,
+                                                                   const int idcode,
+                                                                   const char *group_name)
 {
   FileListInternEntry *entry = MEM_new<FileListInternEntry>(__func__);
-  entry->relpath = current_relpath_append(job_params, group_name);
+  entry->relpath = current_relpath_append(relbase, group_name);
   entry->typeflag |= FILE_TYPE_BLENDERLIB | FILE_TYPE_DIR;
   entry->blentype = idcode;
   return entry;
@@ -3185,6 +3198,7 @@ static FileListInternEntry *filelist_readjob_list_lib_group_create(
  *           this requires redesigning things on the caller side for proper ownership management.
  */
 static void filelist_readjob_list_lib_add_datablock(FileListReadJob *job_params,
+                                                    const char *relbase,
                                                     ListBase *entries,
                                                     BLODataBlockInfo *datablock_info,
                                                     const bool prefix_relpath_with_group_name,
@@ -3194,10 +3208,10 @@ static void filelist_readjob_list_lib_add_datablock(FileListReadJob *job_params,
   FileListInternEntry *entry = MEM_new<FileListInternEntry>(__func__);
   if (prefix_relpath_with_group_name) {
     std::string datablock_path = StringRef(group_name) + SEP_STR + datablock_info->name;
-    entry->relpath = current_relpath_append(job_params, datablock_path.c_str());
+    entry->relpath = current_relpath_append(relbase, datablock_path.c_str());
   }
   else {
-    entry->relpath = current_relpath_append(job_params, datablock_info->name);
+    entry->relpath = current_relpath_append(relbase, datablock_info->name);
   }
   entry->typeflag |= FILE_TYPE_BLENDERLIB;
   if (datablock_info) {
@@ -3217,8 +3231,11 @@ static void filelist_readjob_list_lib_add_datablock(FileListReadJob *job_params,
         datablock_info->asset_data = metadata.get();
         datablock_info->free_asset_data = false;
 
+        /* Libraries may be read in parallel, see #filelist_readjob_recursive_dir_add_items. */
+        BLI_mutex_lock(&job_params->lock);
         entry->asset = job_params->load_asset_library->add_external_asset(
             entry->relpath, datablock_info->name, idcode, std::move(metadata));
+        BLI_mutex_unlock(&job_params->lock);
       }
     }
   }
@@ -3227,6 +3244,7 @@ static void filelist_readjob_list_lib_add_datablock(FileListReadJob *job_params,
 }
 
 static void filelist_readjob_list_lib_add_datablocks(FileListReadJob *job_params,
+                                                     const char *relbase,
                                                      ListBase *entries,
                                                      LinkNode *datablock_infos,
                                                      const bool prefix_relpath_with_group_name,
@@ -3235,13 +3253,19 @@ static void filelist_readjob_list_lib_add_datablocks(FileListReadJob *job_params
 {
   for (LinkNode *ln = datablock_infos; ln; ln = ln->next) {
     BLODataBlockInfo *datablock_info = static_cast<BLODataBlockInfo *>(ln->link);
-    filelist_readjob_list_lib_add_datablock(
-        job_params, entries, datablock_info, prefix_relpath_with_group_name, idcode, group_name);
+    filelist_readjob_list_lib_add_datablock(job_params,
+                                            relbase,
+                                            entries,
+                                            datablock_info,
+                                            prefix_relpath_with_group_name,
+                                            idcode,
+                                            group_name);
   }
 }
 
 static void filelist_readjob_list_lib_add_from_indexer_entries(
     FileListReadJob *job_params,
+    const char *relbase,
     ListBase *entries,
     const FileIndexerEntries *indexer_entries,
     const bool prefix_relpath_with_group_name)
@@ -3250,6 +3274,7 @@ static void filelist_readjob_list_lib_add_from_indexer_entries(
     FileIndexerEntry *indexer_entry = static_cast<FileIndexerEntry *>(ln->link);
     const char *group_name = BKE_idtype_idcode_to_name(indexer_entry->idcode);
     filelist_readjob_list_lib_add_datablock(job_params,
+                                            relbase,
                                             entries,
                                             &indexer_entry->datablock_info,
                                             prefix_relpath_with_group_name,
@@ -3259,10 +3284,10 @@ static void filelist_readjob_list_lib_add_from_indexer_entries(
 }
 
 static FileListInternEntry *filelist_readjob_list_lib_navigate_to_parent_entry_create(
-    const FileListReadJob *job_params)
+    const char *relbase)
 {
   FileListInternEntry *entry = MEM_new<FileListInternEntry>(__func__);
-  entry->relpath = current_relpath_append(job_params, FILENAME_PARENT);
+  entry->relpath = current_relpath_append(relbase, FILENAME_PARENT);
   entry->typeflag |= (FILE_TYPE_BLENDERLIB | FILE_TYPE_DIR);
   return entry;
 }
@@ -3279,30 +3304,115 @@ struct FileIndexer {
   void *user_data;
 };
 
+/**
+ * Add the entries of a single ID group (\a group) from the index.
+ * \return The number of added entries.
+ */
+static int filelist_readjob_list_lib_add_group_from_indexer_entries(
+    FileListReadJob *job_params,
+    const char *relbase,
+    ListBase *entries,
+    const FileIndexerEntries *indexer_entries,
+    const char *group)
+{
+  const int idcode = groupname_to_code(group);
+  int added_entries_len = 0;
+  for (const LinkNode *ln = indexer_entries->entries; ln; ln = ln->next) {
+    FileIndexerEntry *indexer_entry = static_cast<FileIndexerEntry *>(ln->link);
+    if (indexer_entry->idcode != idcode) {
+      continue;
+    }
+    filelist_readjob_list_lib_add_datablock(
+        job_params, relbase, entries, &indexer_entry->datablock_info, false, idcode, group);
+    added_entries_len++;
+  }
+  return added_entries_len;
+}
+
+/**
+ * Add an entry for each ID group that has data-blocks in the index.
+ * \return The number of added entries.
+ */
+static int filelist_readjob_list_lib_add_groups_from_indexer_entries(
+    const char *relbase, ListBase *entries, const FileIndexerEntries *indexer_entries)
+{
+  blender::Set<short> idcodes;
+  for (const LinkNode *ln = indexer_entries->entries; ln; ln = ln->next) {
+    const FileIndexerEntry *indexer_entry = static_cast<const FileIndexerEntry *>(ln->link);
+    if (!idcodes.add(indexer_entry->idcode)) {
+      continue;
+    }
+    FileListInternEntry *group_entry = filelist_readjob_list_lib_group_create(
+        relbase, indexer_entry->idcode, BKE_idtype_idcode_to_name(indexer_entry->idcode));
+    BLI_addtail(entries, group_entry);
+  }
+  return idcodes.size();
+}
+
 static int filelist_readjob_list_lib_populate_from_index(FileListReadJob *job_params,
+                                                         const char *relbase,
                                                          ListBase *entries,
                                                          const ListLibOptions options,
+                                                         const char *group,
                                                          const int read_from_index,
                                                          const FileIndexerEntries *indexer_entries)
 {
   int navigate_to_parent_len = 0;
   if (options & LIST_LIB_ADD_PARENT) {
     FileListInternEntry *entry = filelist_readjob_list_lib_navigate_to_parent_entry_create(
-        job_params);
+        relbase);
     BLI_addtail(entries, entry);
     navigate_to_parent_len = 1;
   }
 
-  filelist_readjob_list_lib_add_from_indexer_entries(job_params, entries, indexer_entries, true);
-  return read_from_index + navigate_to_parent_len;
+  if (group) {
+    return filelist_readjob_list_lib_add_group_from_indexer_entries(
+               job_params, relbase, entries, indexer_entries, group) +
+           navigate_to_parent_len;
+  }
+
+  /* Asset indices only contain assets, and the groups aren't shown in the asset browser. */
+  int group_len = 0;
+  if (!(options & LIST_LIB_ASSETS_ONLY)) {
+    group_len = filelist_readjob_list_lib_add_groups_from_indexer_entries(
+        relbase, entries, indexer_entries);
+  }
+  if (!(options & LIST_LIB_RECURSIVE)) {
+    return group_len + navigate_to_parent_len;
+  }
+
+  filelist_readjob_list_lib_add_from_indexer_entries(
+      job_params, relbase, entries, indexer_entries, true);
+  return read_from_index + group_len + navigate_to_parent_len;
+}
+
+/**
+ * Add the data-blocks of all ID groups of \a libfiledata to \a indexer_entries.
+ */
+static void filelist_readjob_list_lib_indexer_entries_extend(BlendHandle *libfiledata,
+                                                             FileIndexerEntries *indexer_entries)
+{
+  LinkNode *groups = BLO_blendhandle_get_linkable_groups(libfiledata);
+  for (LinkNode *ln = groups; ln; ln = ln->next) {
+    const int idcode = groupname_to_code(static_cast<char *>(ln->link));
+    int datablock_len;
+    LinkNode *datablock_infos = BLO_blendhandle_get_datablock_info(
+        libfiledata, idcode, false, &datablock_len);
+    ED_file_indexer_entries_extend_from_datablock_infos(indexer_entries, datablock_infos, idcode);
+    BLO_datablock_info_linklist_free(datablock_infos);
+  }
+  BLI_linklist_freeN(groups);
 }
 
 /**
+ * \param relbase: The path of \a root relative to the filelist root, used instead of
+ * #FileListReadJob.cur_relbase so several libraries can be read in parallel.
  * \return The number of entries found if the \a root path points to a valid library file.
  *         Otherwise returns no value (#std::nullopt).
  */
 static std::optional<int> filelist_readjob_list_lib(FileListReadJob *job_params,
                                                     const char *root,
+                                                    const char *relbase,
                                                     ListBase *entries,
                                                     const ListLibOptions options,
                                                     FileIndexer *indexer_runtime)
@@ -3327,14 +3437,10 @@ static std::optional<int> filelist_readjob_list_lib(FileListReadJob *job_params,
   const bool has_group = group != nullptr;
 
   /* Try read from indexer_runtime. */
-  /* Indexing returns all entries in a blend file. We should ignore the index when listing a group
-   * inside a blend file, so the `entries` isn't filled with undesired entries.
-   * This happens when linking or appending data-blocks, where you can navigate into a group (ie
-   * Materials/Objects) where you only want to work with partial indexes.
-   *
-   * Adding support for partial reading/updating indexes would increase the complexity.
-   */
-  const bool use_indexer = !has_group;
+  /* Indexing returns all entries in a blend file. When listing a group inside a blend file
+   * (ie Materials/Objects when linking or appending data-blocks), only the entries of that group
+   * are used. */
+  const bool use_indexer = indexer_runtime->callbacks != &file_indexer_noop;
   FileIndexerEntries indexer_entries = {nullptr};
   if (use_indexer) {
     int read_from_index = 0;
@@ -3342,7 +3448,7 @@ static std::optional<int> filelist_readjob_list_lib(FileListReadJob *job_params,
         dir, &indexer_entries, &read_from_index, indexer_runtime->user_data);
     if (indexer_result == FILE_INDEXER_ENTRIES_LOADED) {
       int entries_read = filelist_readjob_list_lib_populate_from_index(
-          job_params, entries, options, read_from_index, &indexer_entries);
+          job_params, relbase, entries, options, group, read_from_index, &indexer_entries);
       ED_file_indexer_entries_clear(&indexer_entries);
       return entries_read;
     }
@@ -3362,11 +3468,15 @@ static std::optional<int> filelist_readjob_list_lib(FileListReadJob *job_params,
   int navigate_to_parent_len = 0;
   if (options & LIST_LIB_ADD_PARENT) {
     FileListInternEntry *entry = filelist_readjob_list_lib_navigate_to_parent_entry_create(
-        job_params);
+        relbase);
     BLI_addtail(entries, entry);
     navigate_to_parent_len = 1;
   }
 
+  /* The listing below only contains all data-blocks of the file when listing all groups
+   * recursively, otherwise gather them separately to update the index. */
+  const bool index_from_listing = !has_group && (options & LIST_LIB_RECURSIVE);
+
   int group_len = 0;
   int datablock_len = 0;
   /* Read only the datablocks from this group. */
@@ -3375,7 +3485,7 @@ static std::optional<int> filelist_readjob_list_lib(FileListReadJob *job_params,
     LinkNode *datablock_infos = BLO_blendhandle_get_datablock_info(
         libfiledata, idcode, options & LIST_LIB_ASSETS_ONLY, &datablock_len);
     filelist_readjob_list_lib_add_datablocks(
-        job_params, entries, datablock_infos, false, idcode, group);
+        job_params, relbase, entries, datablock_infos, false, idcode, group);
     BLO_datablock_info_linklist_free(datablock_infos);
   }
   /* Read all datablocks from all groups. */
@@ -3387,7 +3497,7 @@ static std::optional<int> filelist_readjob_list_lib(FileListReadJob *job_params,
       const char *group_name = static_cast<char *>(ln->link);
       const int idcode = groupname_to_code(group_name);
       FileListInternEntry *group_entry = filelist_readjob_list_lib_group_create(
-          job_params, idcode, group_name);
+          relbase, idcode, group_name);
       BLI_addtail(entries, group_entry);
 
       if (options & LIST_LIB_RECURSIVE) {
@@ -3395,8 +3505,8 @@ static std::optional<int> filelist_readjob_list_lib(FileListReadJob *job_params,
         LinkNode *group_datablock_infos = BLO_blendhandle_get_datablock_info(
             libfiledata, idcode, options & LIST_LIB_ASSETS_ONLY, &group_datablock_len);
         filelist_readjob_list_lib_add_datablocks(
-            job_params, entries, group_datablock_infos, true, idcode, group_name);
-        if (use_indexer) {
+            job_params, relbase, entries, group_datablock_infos, true, idcode, group_name);
+        if (use_indexer && index_from_listing) {
           ED_file_indexer_entries_extend_from_datablock_infos(
               &indexer_entries, group_datablock_infos, idcode);
         }
@@ -3408,6 +3518,10 @@ static std::optional<int> filelist_readjob_list_lib(FileListReadJob *job_params,
     BLI_linklist_freeN(groups);
   }
 
+  if (use_indexer && !index_from_listing) {
+    filelist_readjob_list_lib_indexer_entries_extend(libfiledata, &indexer_entries);
+  }
+
   BLO_blendhandle_close(libfiledata);
 
   /* Update the index. */
@@ -3687,95 +3801,110 @@ static void filelist_readjob_recursive_dir_add_items(const bool do_lib,
   }
 
   while (!BLI_stack_is_empty(todo_dirs) && !(*stop)) {
-    int entries_num = 0;
-
-    char *subdir;
-    char rel_subdir[FILE_MAX_LIBEXTRA];
-    int recursion_level;
-    bool skip_currpar;
-
-    td_dir = static_cast<TodoDir *>(BLI_stack_peek(todo_dirs));
-    subdir = td_dir->dir;
-    recursion_level = td_dir->level;
-    skip_currpar = (recursion_level > 1);
+    /* Take all pending directories at once, so the libraries among them can be read in parallel.
+     * Reading them (or their asset index) dominates the loading time of large asset libraries. */
+    Vector<TodoDirRead> dirs_read;
+    while (!BLI_stack_is_empty(todo_dirs)) {
+      td_dir = static_cast<TodoDir *>(BLI_stack_peek(todo_dirs));
+      dirs_read.append_as();
+      TodoDirRead &dir_read = dirs_read.last();
+      dir_read.dir = td_dir->dir;
+      dir_read.level = td_dir->level;
+      BLI_stack_discard(todo_dirs);
+
+      /* ARRRG! We have to be very careful *not to use* common BLI_path_util helpers over
+       * entry->relpath itself (nor any path containing it), since it may actually be a datablock
+       * name inside .blend file, which can have slashes and backslashes! See #46827.
+       * Note that in the end, this means we 'cache' valid relative subdir once here,
+       * this is actually better. */
+      STRNCPY(dir_read.rel_subdir, dir_read.dir);
+      BLI_path_abs(dir_read.rel_subdir, root);
+      BLI_path_normalize_dir(dir_read.rel_subdir, sizeof(dir_read.rel_subdir));
+      BLI_path_rel(dir_read.rel_subdir, root);
+    }
 
-    BLI_stack_discard(todo_dirs);
+    if (do_lib) {
+      threading::parallel_for(dirs_read.index_range(), 1, [&](const IndexRange range) {
+        for (TodoDirRead &dir_read : dirs_read.as_mutable_span().slice(range)) {
+          if (*stop) {
+            return;
+          }
+          const bool skip_currpar = (dir_read.level > 1);
 
-    /* ARRRG! We have to be very careful *not to use* common BLI_path_util helpers over
-     * entry->relpath itself (nor any path containing it), since it may actually be a datablock
-     * name inside .blend file, which can have slashes and backslashes! See #46827.
-     * Note that in the end, this means we 'cache' valid relative subdir once here,
-     * this is actually better. */
-    STRNCPY(rel_subdir, subdir);
-    BLI_path_abs(rel_subdir, root);
-    BLI_path_normalize_dir(rel_subdir, sizeof(rel_subdir));
-    BLI_path_rel(rel_subdir, root);
+          ListLibOptions list_lib_options = LIST_LIB_OPTION_NONE;
+          if (!skip_currpar) {
+            list_lib_options |= LIST_LIB_ADD_PARENT;
+          }
 
-    /* Update the current relative base path within the filelist root. */
-    STRNCPY(job_params->cur_relbase, rel_subdir);
+          /* Libraries are loaded recursively when max_recursion is set. It doesn't check if there
+           * is still a recursion level over. */
+          if (max_recursion > 0) {
+            list_lib_options |= LIST_LIB_RECURSIVE;
+          }
+          /* Only load assets when browsing an asset library. For normal file browsing we return
+           * all entries. `FLF_ASSETS_ONLY` filter can be enabled/disabled by the user. */
+          if (job_params->load_asset_library) {
+            list_lib_options |= LIST_LIB_ASSETS_ONLY;
+          }
+          std::optional<int> lib_entries_num = filelist_readjob_list_lib(job_params,
+                                                                         dir_read.dir,
+                                                                         dir_read.rel_subdir,
+                                                                         &dir_read.entries,
+                                                                         list_lib_options,
+                                                                         &indexer_runtime);
+          if (lib_entries_num) {
+            dir_read.is_lib = true;
+            dir_read.entries_num += *lib_entries_num;
+          }
+        }
+      });
+    }
 
-    bool is_lib = false;
-    if (do_lib) {
-      ListLibOptions list_lib_options = LIST_LIB_OPTION_NONE;
-      if (!skip_currpar) {
-        list_lib_options |= LIST_LIB_ADD_PARENT;
+    for (TodoDirRead &dir_read : dirs_read) {
+      const int recursion_level = dir_read.level;
+      const bool skip_currpar = (recursion_level > 1);
+
+      /* Update the current relative base path within the filelist root. */
+      STRNCPY(job_params->cur_relbase, dir_read.rel_subdir);
+
+      if (!dir_read.is_lib && !(*stop) && BLI_is_dir(dir_read.dir)) {
+        dir_read.entries_num = filelist_readjob_list_dir(job_params,
+                                                         dir_read.dir,
+                                                         &dir_read.entries,
+                                                         filter_glob,
+                                                         do_lib,
+                                                         job_params->main_filepath,
+                                                         skip_currpar);
       }
 
-      /* Libraries are loaded recursively when max_recursion is set. It doesn't check if there is
-       * still a recursion level over. */
-      if (max_recursion > 0) {
-        list_lib_options |= LIST_LIB_RECURSIVE;
-      }
-      /* Only load assets when browsing an asset library. For normal file browsing we return all
-       * entries. `FLF_ASSETS_ONLY` filter can be enabled/disabled by the user. */
-      if (job_params->load_asset_library) {
-        list_lib_options |= LIST_LIB_ASSETS_ONLY;
-      }
-      std::optional<int> lib_entries_num = filelist_readjob_list_lib(
-          job_params, subdir, &entries, list_lib_options, &indexer_runtime);
-      if (lib_entries_num) {
-        is_lib = true;
-        entries_num += *lib_entries_num;
+      LISTBASE_FOREACH (FileListInternEntry *, entry, &dir_read.entries) {
+        entry->uid = filelist_uid_generate(filelist);
+        entry->name = fileentry_uiname(root, entry, dir);
+        entry->free_name = true;
+
+        if (filelist_readjob_should_recurse_into_entry(
+                max_recursion, dir_read.is_lib, recursion_level, entry))
+        {
+          /* We have a directory we want to list, add it to todo list!
+           * Using #BLI_path_join works but isn't needed as `root` has a trailing slash. */
+          BLI_string_join(dir, sizeof(dir), root, entry->relpath);
+          BLI_path_abs(dir, job_params->main_filepath);
+          BLI_path_normalize_dir(dir, sizeof(dir));
+          td_dir = static_cast<TodoDir *>(BLI_stack_push_r(todo_dirs));
+          td_dir->level = recursion_level + 1;
+          td_dir->dir = BLI_strdup(dir);
+          dirs_todo_count++;
+        }
       }
-    }
-
-    if (!is_lib && BLI_is_dir(subdir)) {
-      entries_num = filelist_readjob_list_dir(job_params,
-                                              subdir,
-                                              &entries,
-                                              filter_glob,
-                                              do_lib,
-                                              job_params->main_filepath,
-                                              skip_currpar);
-    }
-
-    LISTBASE_FOREACH (FileListInternEntry *, entry, &entries) {
-      entry->uid = filelist_uid_generate(filelist);
-      entry->name = fileentry_uiname(root, entry, dir);
-      entry->free_name = true;
 
-      if (filelist_readjob_should_recurse_into_entry(
-              max_recursion, is_lib, recursion_level, entry))
-      {
-        /* We have a directory we want to list, add it to todo list!
-         * Using #BLI_path_join works but isn't needed as `root` has a trailing slash. */
-        BLI_string_join(dir, sizeof(dir), root, entry->relpath);
-        BLI_path_abs(dir, job_params->main_filepath);
-        BLI_path_normalize_dir(dir, sizeof(dir));
-        td_dir = static_cast<TodoDir *>(BLI_stack_push_r(todo_dirs));
-        td_dir->level = recursion_level + 1;
-        td_dir->dir = BLI_strdup(dir);
-        dirs_todo_count++;
+      if (filelist_readjob_append_entries(job_params, &dir_read.entries, dir_read.entries_num)) {
+        *do_update = true;
       }
-    }
 
-    if (filelist_readjob_append_entries(job_params, &entries, entries_num)) {
-      *do_update = true;
+      dirs_done_count++;
+      *progress = float(dirs_done_count) / float(dirs_todo_count);
+      MEM_freeN(dir_read.dir);
     }
-
-    dirs_done_count++;
-    *progress = float(dirs_done_count) / float(dirs_todo_count);
-    MEM_freeN(subdir);
   }
 
   /* Finalize and free indexer. */
@@ -3883,7 +4012,7 @@ static void filelist_readjob_main_assets_add_items(FileListReadJob *job_params,
 
     entry = MEM_new<FileListInternEntry>(__func__);
     std::string datablock_path = StringRef(id_code_name) + SEP_STR + (id_iter->name + 2);
-    entry->relpath = current_relpath_append(job_params, datablock_path.c_str());
+    entry->relpath = current_relpath_append(job_params->cur_relbase, datablock_path.c_str());
     entry->name = id_iter->name + 2;
     entry->free_name = false;
     entry->typeflag |= FILE_TYPE_BLENDERLIB | FILE_TYPE_ASSET;
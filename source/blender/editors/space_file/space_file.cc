@@ -258,6 +258,11 @@ static void file_refresh(const bContext *C, ScrArea *area)
     filelist_setindexer(
         sfile->files, use_asset_indexer ? &asset::index::file_indexer_asset : &file_indexer_noop);
   }
+  else {
+    /* Avoid opening blend files again to list their contents, when linking from libraries on
+     * slow (network) drives. */
+    filelist_setindexer(sfile->files, &file_indexer_library);
+  }
 
   /* Update the active indices of bookmarks & co. */
   sfile->systemnr = fsmenu_get_active_indices(fsmenu, FS_CATEGORY_SYSTEM, params->dir);
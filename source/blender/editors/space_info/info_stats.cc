@@ -689,6 +689,22 @@ const char *ED_info_statusbar_string_ex(Main *bmain,
     uintptr_t mem_in_use = MEM_get_memory_in_use();
     BLI_str_format_byte_unit(formatted_mem, mem_in_use, false);
     ofs += BLI_snprintf_rlen(info + ofs, len, IFACE_("Memory: %s"), formatted_mem);
+
+    /* Show the subsystem using the most memory, when any memory is attributed to one. */
+    eMEMTag largest_tag = MEM_TAG_UNTAGGED;
+    size_t largest_tag_mem = 0;
+    for (int tag = MEM_TAG_UNTAGGED + 1; tag < MEM_TAG_NUM; tag++) {
+      const size_t tag_mem = MEM_get_memory_in_use_by_tag(eMEMTag(tag));
+      if (tag_mem > largest_tag_mem) {
+        largest_tag = eMEMTag(tag);
+        largest_tag_mem = tag_mem;
+      }
+    }
+    if (largest_tag != MEM_TAG_UNTAGGED) {
+      BLI_str_format_byte_unit(formatted_mem, largest_tag_mem, false);
+      ofs += BLI_snprintf_rlen(
+          info + ofs, len - ofs, " (%s: %s)", IFACE_(MEM_tag_name(largest_tag)), formatted_mem);
+    }
   }
 
   /* GPU VRAM status. */
@@ -132,6 +132,7 @@ struct TreeDrawContext {
 
   blender::Map<bNodeInstanceKey, blender::timeit::Nanoseconds>
       *compositor_per_node_execution_time = nullptr;
+  blender::Map<bNodeInstanceKey, int64_t> *compositor_per_node_memory_usage = nullptr;
 
   /**
    * Label for reroute nodes that is derived from upstream reroute nodes.
@@ -3045,6 +3046,63 @@ static std::optional<NodeExtraInfoRow> node_get_execution_time_label_row(
   return row;
 }
 
+static std::optional<int64_t> compositor_node_get_memory_usage(
+    const TreeDrawContext &tree_draw_ctx, const SpaceNode &snode, const bNode &node)
+{
+  BLI_assert(tree_draw_ctx.compositor_per_node_memory_usage);
+
+  /* For the frame nodes accumulate memory usage of its children. */
+  if (node.is_frame()) {
+    int64_t frame_memory_usage = 0;
+    bool has_any_memory_usage = false;
+    for (const bNode *current_node : node.direct_children_in_frame()) {
+      const bNodeInstanceKey key = current_node_instance_key(snode, *current_node);
+      if (const int64_t *node_memory_usage =
+              tree_draw_ctx.compositor_per_node_memory_usage->lookup_ptr(key))
+      {
+        frame_memory_usage += *node_memory_usage;
+        has_any_memory_usage = true;
+      }
+    }
+    if (!has_any_memory_usage) {
+      return std::nullopt;
+    }
+    return frame_memory_usage;
+  }
+
+  /* The group node instances have their own entries in the memory usages map. */
+  const bNodeInstanceKey key = current_node_instance_key(snode, node);
+  if (const int64_t *memory_usage = tree_draw_ctx.compositor_per_node_memory_usage->lookup_ptr(
+          key))
+  {
+    return *memory_usage;
+  }
+
+  return std::nullopt;
+}
+
+static std::optional<NodeExtraInfoRow> node_get_compositor_memory_usage_row(
+    TreeDrawContext &tree_draw_ctx, const SpaceNode &snode, const bNode &node)
+{
+  const std::optional<int64_t> memory_usage = compositor_node_get_memory_usage(
+      tree_draw_ctx, snode, node);
+  /* Don't show the memory usage of nodes that did not allocate any buffer. */
+  if (!memory_usage.has_value() || *memory_usage == 0) {
+    return std::nullopt;
+  }
+
+  char memory_usage_label[BLI_STR_FORMAT_INT64_BYTE_UNIT_SIZE];
+  BLI_str_format_byte_unit(memory_usage_label, *memory_usage, false);
+
+  NodeExtraInfoRow row;
+  row.text = memory_usage_label;
+  row.tooltip = TIP_(
+      "The size of the buffers allocated for the node results in the node tree's latest "
+      "evaluation. For frame and group nodes, the size for all sub-nodes");
+  row.icon = ICON_MEMORY;
+  return row;
+}
+
 static void node_get_compositor_extra_info(TreeDrawContext &tree_draw_ctx,
                                            const SpaceNode &snode,
                                            const bNode &node,
@@ -3056,6 +3114,12 @@ static void node_get_compositor_extra_info(TreeDrawContext &tree_draw_ctx,
     if (row.has_value()) {
       rows.append(std::move(*row));
     }
+
+    std::optional<NodeExtraInfoRow> memory_row = node_get_compositor_memory_usage_row(
+        tree_draw_ctx, snode, node);
+    if (memory_row.has_value()) {
+      rows.append(std::move(*memory_row));
+    }
   }
 }
 
@@ -4831,6 +4895,8 @@ static void draw_nodetree(const bContext &C,
     tree_draw_ctx.used_by_realtime_compositor = realtime_compositor_is_in_use(C);
     tree_draw_ctx.compositor_per_node_execution_time =
         &scene->runtime->compositor.per_node_execution_time;
+    tree_draw_ctx.compositor_per_node_memory_usage =
+        &scene->runtime->compositor.per_node_memory_usage;
   }
   else if (ntree.type == NTREE_SHADER && U.experimental.use_shader_node_previews &&
            BKE_scene_uses_shader_previews(CTX_data_scene(&C)) &&
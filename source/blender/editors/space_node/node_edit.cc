@@ -29,6 +29,7 @@
 #include "BKE_scene.hh"
 #include "BKE_scene_runtime.hh"
 
+#include "BLI_rect.h"
 #include "BLI_string.h"
 #include "BLI_string_utf8.h"
 
@@ -91,6 +92,9 @@ struct CompoJob {
   ViewLayer *view_layer;
   bNodeTree *ntree;
   int recalc_flags;
+  /* Region of the viewer image to compute, in normalized coordinates. */
+  bool use_viewer_region;
+  rctf viewer_region;
   /* Evaluated state/ */
   Depsgraph *compositor_depsgraph;
   bNodeTree *localtree;
@@ -256,6 +260,19 @@ static void compo_initjob(void *cjv)
     compo_tag_output_nodes(cj->localtree, cj->recalc_flags);
   }
 
+  /* Restrict the viewer border of the local tree to the requested viewer region, such that the
+   * compositor only computes the viewer image in that region and the areas of the operations
+   * needed for it. */
+  if (cj->use_viewer_region) {
+    bNodeTree *localtree = cj->localtree;
+    rctf viewer_border = cj->viewer_region;
+    if (localtree->flag & NTREE_VIEWER_BORDER) {
+      BLI_rctf_isect(&localtree->viewer_border, &viewer_border, &viewer_border);
+    }
+    localtree->viewer_border = viewer_border;
+    localtree->flag |= NTREE_VIEWER_BORDER;
+  }
+
   cj->re = RE_NewInteractiveCompositorRender(scene);
   if (scene->r.compositor_device == SCE_COMPOSITOR_DEVICE_GPU) {
     RE_system_gpu_context_ensure(cj->re);
@@ -327,6 +344,7 @@ static void compo_canceljob(void *cjv)
   cj->cancelled = true;
 
   scene->runtime->compositor.per_node_execution_time = cj->profiler.get_nodes_evaluation_times();
+  scene->runtime->compositor.per_node_memory_usage = cj->profiler.get_nodes_memory_usages();
 }
 
 static void compo_completejob(void *cjv)
@@ -337,6 +355,7 @@ static void compo_completejob(void *cjv)
   BKE_callback_exec_id(bmain, &scene->id, BKE_CB_EVT_COMPOSITE_POST);
 
   scene->runtime->compositor.per_node_execution_time = cj->profiler.get_nodes_evaluation_times();
+  scene->runtime->compositor.per_node_memory_usage = cj->profiler.get_nodes_memory_usages();
 }
 
 /** \} */
@@ -372,7 +391,10 @@ static bool is_compositing_possible(const bContext *C)
   return true;
 }
 
-void ED_node_composite_job(const bContext *C, bNodeTree *nodetree, Scene *scene_owner)
+void ED_node_composite_job(const bContext *C,
+                           bNodeTree *nodetree,
+                           Scene *scene_owner,
+                           const rctf *viewer_region)
 {
   using namespace blender::ed::space_node;
 
@@ -410,6 +432,10 @@ void ED_node_composite_job(const bContext *C, bNodeTree *nodetree, Scene *scene_
   cj->view_layer = view_layer;
   cj->ntree = nodetree;
   cj->recalc_flags = compo_get_recalc_flags(C);
+  cj->use_viewer_region = viewer_region != nullptr;
+  if (viewer_region) {
+    cj->viewer_region = *viewer_region;
+  }
 
   /* Set up job. */
   WM_jobs_customdata_set(wm_job, cj, compo_freejob);
@@ -95,6 +95,13 @@ struct SpaceNode_Runtime {
    */
   bool recalc_regular_compositing;
 
+  /**
+   * Region of the viewer image computed by the last compositing started from this editor, in
+   * coordinates normalized to the viewer image size. Used to recompute the viewer when the
+   * backdrop view reveals parts that were not computed, see #SNODE_BACKDRAW_VISIBLE_REGION.
+   */
+  rctf composited_backdrop_region;
+
   /** Temporary data for modal linking operator. */
   std::unique_ptr<bNodeLinkDrag> linkdrag;
 
@@ -227,6 +234,19 @@ bool space_node_view_flag(
 void NODE_OT_view_all(wmOperatorType *ot);
 void NODE_OT_view_selected(wmOperatorType *ot);
 
+/**
+ * Get the region of the viewer image that is visible in the backdrop, in coordinates normalized
+ * to the viewer image size and padded by the given fraction of its size. Returns false if the
+ * viewer image doesn't exist or is not visible.
+ */
+bool node_backdrop_visible_region_get(
+    Main &bmain, const SpaceNode &snode, const ARegion &region, float padding, rctf &r_region);
+/**
+ * Tag the compositor for recomputing if the backdrop view changed such that it reveals parts of
+ * the viewer image that were not computed, see #SNODE_BACKDRAW_VISIBLE_REGION.
+ */
+void node_backdrop_view_changed(Main &bmain, SpaceNode &snode, ScrArea &area, ARegion &region);
+
 void NODE_OT_backimage_move(wmOperatorType *ot);
 void NODE_OT_backimage_zoom(wmOperatorType *ot);
 void NODE_OT_backimage_fit(wmOperatorType *ot);
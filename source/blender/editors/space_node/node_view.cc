@@ -200,6 +200,69 @@ void NODE_OT_view_selected(wmOperatorType *ot)
 
 /** \} */
 
+/* -------------------------------------------------------------------- */
+/** \name Backdrop Visible Region
+ * \{ */
+
+bool node_backdrop_visible_region_get(Main &bmain,
+                                      const SpaceNode &snode,
+                                      const ARegion &region,
+                                      const float padding,
+                                      rctf &r_region)
+{
+  void *lock;
+  Image *ima = BKE_image_ensure_viewer(&bmain, IMA_TYPE_COMPOSITE, "Viewer Node");
+  ImBuf *ibuf = BKE_image_acquire_ibuf(ima, nullptr, &lock);
+
+  if ((ibuf == nullptr) || (ibuf->x == 0) || (ibuf->y == 0) || (snode.zoom <= 0.0f)) {
+    BKE_image_release_ibuf(ima, ibuf, lock);
+    return false;
+  }
+
+  /* Same placement as the backdrop drawing, see #draw_nodespace_back_pix. */
+  const float width = snode.zoom * ibuf->x;
+  const float height = snode.zoom * ibuf->y;
+  const float offset_x = snode.xof + ima->runtime.backdrop_offset[0] * snode.zoom;
+  const float offset_y = snode.yof + ima->runtime.backdrop_offset[1] * snode.zoom;
+  const float x = (region.winx - width) / 2 + offset_x;
+  const float y = (region.winy - height) / 2 + offset_y;
+
+  BKE_image_release_ibuf(ima, ibuf, lock);
+
+  BLI_rctf_init(&r_region,
+                -x / width,
+                (region.winx - x) / width,
+                -y / height,
+                (region.winy - y) / height);
+  BLI_rctf_pad(
+      &r_region, BLI_rctf_size_x(&r_region) * padding, BLI_rctf_size_y(&r_region) * padding);
+
+  rctf image_region;
+  BLI_rctf_init(&image_region, 0.0f, 1.0f, 0.0f, 1.0f);
+  return BLI_rctf_isect(&image_region, &r_region, &r_region);
+}
+
+void node_backdrop_view_changed(Main &bmain, SpaceNode &snode, ScrArea &area, ARegion &region)
+{
+  if (!(snode.flag & SNODE_BACKDRAW) || !(snode.flag & SNODE_BACKDRAW_VISIBLE_REGION)) {
+    return;
+  }
+
+  rctf visible_region;
+  if (!node_backdrop_visible_region_get(bmain, snode, region, 0.0f, visible_region)) {
+    return;
+  }
+
+  if (BLI_rctf_inside_rctf(&snode.runtime->composited_backdrop_region, &visible_region)) {
+    return;
+  }
+
+  snode.runtime->recalc_regular_compositing = true;
+  ED_area_tag_refresh(&area);
+}
+
+/** \} */
+
 /* -------------------------------------------------------------------- */
 /** \name Background Image Operators
  * \{ */
@@ -240,6 +303,7 @@ static int snode_bg_viewmove_modal(bContext *C, wmOperator *op, const wmEvent *e
       if (event->val == KM_RELEASE) {
         MEM_freeN(nvm);
         op->customdata = nullptr;
+        node_backdrop_view_changed(*CTX_data_main(C), *snode, *CTX_wm_area(C), *region);
         return OPERATOR_FINISHED;
       }
       break;
@@ -340,6 +404,7 @@ static int backimage_zoom_exec(bContext *C, wmOperator *op)
   ED_region_tag_redraw(region);
   WM_main_add_notifier(NC_NODE | ND_DISPLAY, nullptr);
   WM_main_add_notifier(NC_SPACE | ND_SPACE_NODE_VIEW, nullptr);
+  node_backdrop_view_changed(*CTX_data_main(C), *snode, *CTX_wm_area(C), *region);
 
   return OPERATOR_FINISHED;
 }
@@ -405,6 +470,7 @@ static int backimage_fit_exec(bContext *C, wmOperator * /*op*/)
   ED_region_tag_redraw(region);
   WM_main_add_notifier(NC_NODE | ND_DISPLAY, nullptr);
   WM_main_add_notifier(NC_SPACE | ND_SPACE_NODE_VIEW, nullptr);
+  node_backdrop_view_changed(*bmain, *snode, *CTX_wm_area(C), *region);
 
   return OPERATOR_FINISHED;
 }
@@ -9,6 +9,7 @@
 #include "AS_asset_representation.hh"
 
 #include "BLI_listbase.h"
+#include "BLI_rect.h"
 #include "BLI_string.h"
 
 #include "DNA_ID.h"
@@ -684,6 +685,36 @@ static bool is_compositor_viewer_image_visible(const bContext *C)
   return false;
 }
 
+/* Padding around the visible region of the backdrop that is computed as well, as a fraction of
+ * its size, such that small movements of the backdrop do not require recomputing the viewer. */
+static constexpr float BACKDROP_VISIBLE_REGION_PADDING = 0.1f;
+
+static void node_area_composite_job(const bContext *C,
+                                    SpaceNode *snode,
+                                    ScrArea *area,
+                                    Scene *scene)
+{
+  ARegion *region = BKE_area_find_region_type(area, RGN_TYPE_WINDOW);
+
+  rctf visible_region;
+  const bool use_visible_region = (snode->flag & SNODE_BACKDRAW) &&
+                                  (snode->flag & SNODE_BACKDRAW_VISIBLE_REGION) && region &&
+                                  node_backdrop_visible_region_get(*CTX_data_main(C),
+                                                                   *snode,
+                                                                   *region,
+                                                                   BACKDROP_VISIBLE_REGION_PADDING,
+                                                                   visible_region);
+
+  if (use_visible_region) {
+    snode->runtime->composited_backdrop_region = visible_region;
+    ED_node_composite_job(C, snode->nodetree, scene, &visible_region);
+  }
+  else {
+    BLI_rctf_init(&snode->runtime->composited_backdrop_region, 0.0f, 1.0f, 0.0f, 1.0f);
+    ED_node_composite_job(C, snode->nodetree, scene);
+  }
+}
+
 static void node_area_refresh(const bContext *C, ScrArea *area)
 {
   /* default now: refresh node is starting preview */
@@ -700,7 +731,7 @@ static void node_area_refresh(const bContext *C, ScrArea *area)
           /* Only start compositing if its result will be visible either in the backdrop or in a
            * viewer image. */
           if (snode->flag & SNODE_BACKDRAW || is_compositor_viewer_image_visible(C)) {
-            ED_node_composite_job(C, snode->nodetree, scene);
+            node_area_composite_job(C, snode, area, scene);
           }
         }
       }
@@ -800,19 +800,28 @@ static IMB_Proxy_Size seq_get_proxy_size_flags(bContext *C)
 
 static void seq_build_proxy(bContext *C, blender::Span<Sequence *> movie_strips)
 {
-  if (U.sequencer_proxy_setup != USER_SEQ_PROXY_SETUP_AUTOMATIC) {
-    return;
-  }
-
   wmJob *wm_job = ED_seq_proxy_wm_job_get(C);
   ProxyJob *pj = ED_seq_proxy_job_get(C, wm_job);
 
+  /* The seek index is cheap to build and makes scrubbing faster, also when proxies are not
+   * used or not needed because decoding is fast enough. */
   for (Sequence *seq : movie_strips) {
-    /* Enable and set proxy size. */
-    SEQ_proxy_set(seq, true);
-    seq->strip->proxy->build_size_flags = seq_get_proxy_size_flags(C);
-    seq->strip->proxy->build_flags |= SEQ_PROXY_SKIP_EXISTING;
-    SEQ_proxy_rebuild_context(pj->main, pj->depsgraph, pj->scene, seq, nullptr, &pj->queue, true);
+    SEQ_proxy_seek_index_rebuild_context(pj->main, pj->depsgraph, pj->scene, seq, &pj->queue);
+  }
+
+  if (U.sequencer_proxy_setup == USER_SEQ_PROXY_SETUP_AUTOMATIC) {
+    for (Sequence *seq : movie_strips) {
+      /* Enable and set proxy size. */
+      SEQ_proxy_set(seq, true);
+      seq->strip->proxy->build_size_flags = seq_get_proxy_size_flags(C);
+      seq->strip->proxy->build_flags |= SEQ_PROXY_SKIP_EXISTING;
+      SEQ_proxy_rebuild_context(
+          pj->main, pj->depsgraph, pj->scene, seq, nullptr, &pj->queue, true);
+    }
+  }
+
+  if (BLI_listbase_is_empty(&pj->queue)) {
+    return;
   }
 
   if (!WM_jobs_is_running(wm_job)) {
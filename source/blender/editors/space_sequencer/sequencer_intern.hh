@@ -30,6 +30,7 @@ class SeqQuadsBatch;
 struct ARegion;
 struct ARegionType;
 struct Scene;
+struct SeqRenderGPUCache;
 struct SeqRetimingKey;
 struct Sequence;
 struct SpaceSeq;
@@ -55,6 +56,8 @@ struct SpaceSeq_Runtime : public NonCopyable {
   float timeline_clamp_custom_range = 0;
 
   blender::ed::seq::SeqScopes scopes;
+  /** Resources of the GPU composited preview, see #SEQ_render_give_gpu_texture. */
+  SeqRenderGPUCache *gpu_cache = nullptr;
 
   SpaceSeq_Runtime() = default;
   ~SpaceSeq_Runtime();
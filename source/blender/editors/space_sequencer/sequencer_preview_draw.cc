@@ -89,26 +89,21 @@ void ED_sequencer_special_preview_clear()
   sequencer_special_update_set(nullptr);
 }
 
-ImBuf *sequencer_ibuf_get(const bContext *C,
-                          int timeline_frame,
-                          int frame_ofs,
-                          const char *viewname)
+static bool sequencer_render_data_get(const bContext *C,
+                                      const char *viewname,
+                                      SeqRenderData *r_context)
 {
   Main *bmain = CTX_data_main(C);
-  ARegion *region = CTX_wm_region(C);
   Depsgraph *depsgraph = CTX_data_expect_evaluated_depsgraph(C);
   Scene *scene = CTX_data_scene(C);
   SpaceSeq *sseq = CTX_wm_space_seq(C);
   bScreen *screen = CTX_wm_screen(C);
 
-  SeqRenderData context = {nullptr};
-  ImBuf *ibuf;
   int rectx, recty;
   double render_size;
-  short is_break = G.is_break;
 
   if (sseq->render_size == SEQ_RENDER_SIZE_NONE) {
-    return nullptr;
+    return false;
   }
 
   if (sseq->render_size == SEQ_RENDER_SIZE_SCENE) {
@@ -122,11 +117,29 @@ ImBuf *sequencer_ibuf_get(const bContext *C,
   recty = roundf(render_size * scene->r.ysch);
 
   SEQ_render_new_render_data(
-      bmain, depsgraph, scene, rectx, recty, sseq->render_size, false, &context);
-  context.view_id = BKE_scene_multiview_view_id_get(&scene->r, viewname);
-  context.use_proxies = (sseq->flag & SEQ_USE_PROXIES) != 0;
-  context.is_playing = screen->animtimer != nullptr;
-  context.is_scrubbing = screen->scrubbing;
+      bmain, depsgraph, scene, rectx, recty, sseq->render_size, false, r_context);
+  r_context->view_id = BKE_scene_multiview_view_id_get(&scene->r, viewname);
+  r_context->use_proxies = (sseq->flag & SEQ_USE_PROXIES) != 0;
+  r_context->is_playing = screen->animtimer != nullptr;
+  r_context->is_scrubbing = screen->scrubbing;
+  return true;
+}
+
+ImBuf *sequencer_ibuf_get(const bContext *C,
+                          int timeline_frame,
+                          int frame_ofs,
+                          const char *viewname)
+{
+  ARegion *region = CTX_wm_region(C);
+  SpaceSeq *sseq = CTX_wm_space_seq(C);
+
+  SeqRenderData context = {nullptr};
+  ImBuf *ibuf;
+  short is_break = G.is_break;
+
+  if (!sequencer_render_data_get(C, viewname, &context)) {
+    return nullptr;
+  }
 
   /* Sequencer could start rendering, in this case we need to be sure it wouldn't be
    * canceled by Escape pressed somewhere in the past. */
@@ -167,6 +180,37 @@ ImBuf *sequencer_ibuf_get(const bContext *C,
   return ibuf;
 }
 
+/**
+ * Composite the preview on the GPU when enabled in the preferences.
+ * Returns null when the preview has to be rendered with #sequencer_ibuf_get.
+ */
+static GPUTexture *sequencer_gpu_texture_get(const bContext *C,
+                                             int timeline_frame,
+                                             int frame_ofs,
+                                             const char *viewname)
+{
+  SpaceSeq *sseq = CTX_wm_space_seq(C);
+
+  if ((U.sequencer_editor_flag & USER_SEQ_ED_GPU_PREVIEW) == 0) {
+    return nullptr;
+  }
+  /* Scopes and metadata are computed from the image on the CPU. */
+  if (sseq->mainb != SEQ_DRAW_IMG_IMBUF || ED_sequencer_special_preview_get()) {
+    return nullptr;
+  }
+  if (sseq->preview_overlay.flag & SEQ_PREVIEW_SHOW_METADATA && sseq->flag & SEQ_SHOW_OVERLAY) {
+    return nullptr;
+  }
+
+  SeqRenderData context = {nullptr};
+  if (!sequencer_render_data_get(C, viewname, &context)) {
+    return nullptr;
+  }
+
+  return SEQ_render_give_gpu_texture(
+      &context, timeline_frame + frame_ofs, sseq->chanshown, &sseq->runtime->gpu_cache);
+}
+
 static ImBuf *sequencer_make_scope(Scene *scene,
                                    ImBuf *ibuf,
                                    ImBuf *(*make_scope_fn)(const ImBuf *ibuf))
@@ -427,6 +471,42 @@ static void sequencer_preview_get_rect(rctf *preview,
   }
 }
 
+static void sequencer_draw_display_quad(Scene *scene,
+                                        ARegion *region,
+                                        SpaceSeq *sseq,
+                                        const uint pos,
+                                        const uint texCoord,
+                                        bool draw_overlay,
+                                        bool draw_backdrop)
+{
+  immBegin(GPU_PRIM_TRI_FAN, 4);
+
+  rctf preview;
+  rctf canvas;
+  sequencer_preview_get_rect(&preview, scene, region, sseq, draw_overlay, draw_backdrop);
+
+  if (draw_overlay && (sseq->overlay_frame_type == SEQ_OVERLAY_FRAME_TYPE_RECT)) {
+    canvas = scene->ed->overlay_frame_rect;
+  }
+  else {
+    BLI_rctf_init(&canvas, 0.0f, 1.0f, 0.0f, 1.0f);
+  }
+
+  immAttr2f(texCoord, canvas.xmin, canvas.ymin);
+  immVertex2f(pos, preview.xmin, preview.ymin);
+
+  immAttr2f(texCoord, canvas.xmin, canvas.ymax);
+  immVertex2f(pos, preview.xmin, preview.ymax);
+
+  immAttr2f(texCoord, canvas.xmax, canvas.ymax);
+  immVertex2f(pos, preview.xmax, preview.ymax);
+
+  immAttr2f(texCoord, canvas.xmax, canvas.ymin);
+  immVertex2f(pos, preview.xmax, preview.ymin);
+
+  immEnd();
+}
+
 static void sequencer_draw_display_buffer(const bContext *C,
                                           Scene *scene,
                                           ARegion *region,
@@ -473,32 +553,7 @@ static void sequencer_draw_display_buffer(const bContext *C,
     immUniformColor3f(1.0f, 1.0f, 1.0f);
   }
 
-  immBegin(GPU_PRIM_TRI_FAN, 4);
-
-  rctf preview;
-  rctf canvas;
-  sequencer_preview_get_rect(&preview, scene, region, sseq, draw_overlay, draw_backdrop);
-
-  if (draw_overlay && (sseq->overlay_frame_type == SEQ_OVERLAY_FRAME_TYPE_RECT)) {
-    canvas = scene->ed->overlay_frame_rect;
-  }
-  else {
-    BLI_rctf_init(&canvas, 0.0f, 1.0f, 0.0f, 1.0f);
-  }
-
-  immAttr2f(texCoord, canvas.xmin, canvas.ymin);
-  immVertex2f(pos, preview.xmin, preview.ymin);
-
-  immAttr2f(texCoord, canvas.xmin, canvas.ymax);
-  immVertex2f(pos, preview.xmin, preview.ymax);
-
-  immAttr2f(texCoord, canvas.xmax, canvas.ymax);
-  immVertex2f(pos, preview.xmax, preview.ymax);
-
-  immAttr2f(texCoord, canvas.xmax, canvas.ymin);
-  immVertex2f(pos, preview.xmax, preview.ymin);
-
-  immEnd();
+  sequencer_draw_display_quad(scene, region, sseq, pos, texCoord, draw_overlay, draw_backdrop);
 
   GPU_texture_unbind(texture);
   GPU_texture_free(texture);
@@ -524,6 +579,69 @@ static void sequencer_draw_display_buffer(const bContext *C,
   }
 }
 
+/**
+ * Draw the preview composited on the GPU, the texture is in the sequencer color space with
+ * premultiplied alpha.
+ */
+static void sequencer_draw_display_texture(const bContext *C,
+                                           Scene *scene,
+                                           ARegion *region,
+                                           SpaceSeq *sseq,
+                                           GPUTexture *texture,
+                                           bool draw_overlay,
+                                           bool draw_backdrop)
+{
+  /* Format needs to be created prior to any #immBindShader call.
+   * Do it here because OCIO binds its own shader. */
+  GPUVertFormat *imm_format = immVertexFormat();
+  uint pos = GPU_vertformat_attr_add(imm_format, "pos", GPU_COMP_F32, 2, GPU_FETCH_FLOAT);
+  uint texCoord = GPU_vertformat_attr_add(
+      imm_format, "texCoord", GPU_COMP_F32, 2, GPU_FETCH_FLOAT);
+
+  const char *colorspace_name = scene->sequencer_colorspace_settings.name;
+  ColorSpace *colorspace = IMB_colormanagement_space_get_named(colorspace_name);
+  if (!IMB_colormanagement_setup_glsl_draw_from_space_ctx(C, colorspace, 0.0f, true)) {
+    /* The display transform can't be done on the GPU, read the image back and let the CPU
+     * fallback of the regular drawing handle it. */
+    const int width = GPU_texture_width(texture);
+    const int height = GPU_texture_height(texture);
+    float *pixels = static_cast<float *>(GPU_texture_read(texture, GPU_DATA_FLOAT, 0));
+    ImBuf *ibuf = IMB_allocFromBufferOwn(nullptr, pixels, width, height, 4);
+    IMB_colormanagement_assign_float_colorspace(ibuf, colorspace_name);
+    sequencer_draw_display_buffer(C, scene, region, sseq, ibuf, draw_overlay, draw_backdrop);
+    IMB_freeImBuf(ibuf);
+    return;
+  }
+
+  if (sseq->flag & SEQ_USE_ALPHA) {
+    GPU_blend(GPU_BLEND_ALPHA);
+  }
+
+  if (draw_backdrop) {
+    GPU_matrix_push();
+    GPU_matrix_identity_set();
+    GPU_matrix_push_projection();
+    GPU_matrix_identity_projection_set();
+  }
+
+  GPU_texture_filter_mode(texture, false);
+  GPU_texture_bind(texture, 0);
+
+  sequencer_draw_display_quad(scene, region, sseq, pos, texCoord, draw_overlay, draw_backdrop);
+
+  GPU_texture_unbind(texture);
+  IMB_colormanagement_finish_glsl_draw();
+
+  if (sseq->flag & SEQ_USE_ALPHA) {
+    GPU_blend(GPU_BLEND_NONE);
+  }
+
+  if (draw_backdrop) {
+    GPU_matrix_pop();
+    GPU_matrix_pop_projection();
+  }
+}
+
 static void draw_histogram(ARegion *region,
                            const blender::ed::seq::ScopeHistogram &hist,
                            SeqQuadsBatch &quads,
@@ -1103,8 +1221,12 @@ void sequencer_draw_preview(const bContext *C,
     preview_frame = sequencer_draw_get_transform_preview_frame(scene);
   }
 
-  /* Get image. */
-  ibuf = sequencer_ibuf_get(C, preview_frame, offset, names[sseq->multiview_eye]);
+  /* Get image, composited on the GPU when possible. */
+  GPUTexture *texture = sequencer_gpu_texture_get(
+      C, preview_frame, offset, names[sseq->multiview_eye]);
+  if (texture == nullptr) {
+    ibuf = sequencer_ibuf_get(C, preview_frame, offset, names[sseq->multiview_eye]);
+  }
 
   /* Setup off-screen buffers. */
   GPUViewport *viewport = WM_draw_region_get_viewport(region);
@@ -1150,6 +1272,9 @@ void sequencer_draw_preview(const bContext *C,
       ED_region_image_metadata_draw(0.0, 0.0, ibuf, &v2d->tot, 1.0, 1.0);
     }
   }
+  else if (texture) {
+    sequencer_draw_display_texture(C, scene, region, sseq, texture, draw_overlay, draw_backdrop);
+  }
 
   if (show_imbuf && (sseq->flag & SEQ_SHOW_OVERLAY)) {
     sequencer_draw_borders_overlay(sseq, v2d, scene);
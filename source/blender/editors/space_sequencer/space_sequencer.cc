@@ -41,6 +41,7 @@
 #include "WM_api.hh"
 #include "WM_message.hh"
 
+#include "SEQ_render.hh"
 #include "SEQ_retiming.hh"
 #include "SEQ_sequencer.hh"
 #include "SEQ_time.hh"
@@ -66,7 +67,10 @@ static void sequencer_scopes_tag_refresh(ScrArea *area)
   sseq->runtime->scopes.reference_ibuf = nullptr;
 }
 
-blender::ed::seq::SpaceSeq_Runtime::~SpaceSeq_Runtime() {}
+blender::ed::seq::SpaceSeq_Runtime::~SpaceSeq_Runtime()
+{
+  SEQ_render_gpu_cache_free(gpu_cache);
+}
 
 /* ******************** manage regions ********************* */
 
@@ -59,6 +59,16 @@ class DataSource {
   {
     return 0;
   }
+
+  /**
+   * Returns a value that changes whenever the displayed data may have changed, so that data
+   * derived from it (like the filtered rows) can be kept in #SpreadsheetCache across redraws.
+   * Zero means that nothing derived from the data should be cached.
+   */
+  virtual uint64_t data_version() const
+  {
+    return 0;
+  }
 };
 
 }  // namespace blender::ed::spreadsheet
@@ -675,8 +675,30 @@ std::unique_ptr<DataSource> data_source_from_geometry(const bContext *C, Object
   Object *object_orig = sspreadsheet->instance_ids_num == 0 ?
                             DEG_get_original_object(object_eval) :
                             nullptr;
-  return std::make_unique<GeometryDataSource>(
-      object_orig, std::move(geometry_set), component_type, domain, active_layer_index);
+
+  /* The displayed geometry only changes when the object is evaluated again, which also happens
+   * when its original data or the viewed node changes. */
+  uint64_t data_version = get_default_hash(CTX_data_depsgraph_pointer(C),
+                                           object_eval->id.session_uid,
+                                           object_eval->runtime->last_update_geometry);
+  data_version = get_default_hash(data_version,
+                                  sspreadsheet->object_eval_state,
+                                  sspreadsheet->geometry_component_type,
+                                  sspreadsheet->attribute_domain);
+  data_version = get_default_hash(data_version, active_layer_index);
+  for (const SpreadsheetInstanceID &instance_id :
+       Span(sspreadsheet->instance_ids, sspreadsheet->instance_ids_num))
+  {
+    data_version = get_default_hash(data_version, instance_id.reference_index);
+  }
+
+  return std::make_unique<GeometryDataSource>(object_orig,
+                                              std::move(geometry_set),
+                                              component_type,
+                                              domain,
+                                              active_layer_index,
+                                              ExtraColumns(),
+                                              data_version);
 }
 
 }  // namespace blender::ed::spreadsheet
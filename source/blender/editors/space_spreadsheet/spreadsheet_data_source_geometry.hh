@@ -51,6 +51,7 @@ class GeometryDataSource : public DataSource {
   /* Layer index for grease pencil component. */
   int layer_index_;
   ExtraColumns extra_columns_;
+  uint64_t data_version_;
 
   /* Some data is computed on the fly only when it is requested. Computing it does not change the
    * logical state of this data source. Therefore, the corresponding methods are const and need to
@@ -64,13 +65,15 @@ class GeometryDataSource : public DataSource {
                      const bke::GeometryComponent::Type component_type,
                      const bke::AttrDomain domain,
                      const int layer_index = -1,
-                     ExtraColumns extra_columns = {})
+                     ExtraColumns extra_columns = {},
+                     const uint64_t data_version = 0)
       : object_orig_(object_orig),
         geometry_set_(std::move(geometry_set)),
         component_(geometry_set_.get_component(component_type)),
         domain_(domain),
         layer_index_(layer_index),
-        extra_columns_(std::move(extra_columns))
+        extra_columns_(std::move(extra_columns)),
+        data_version_(data_version)
   {
   }
 
@@ -85,6 +88,11 @@ class GeometryDataSource : public DataSource {
 
   int tot_rows() const override;
 
+  uint64_t data_version() const override
+  {
+    return data_version_;
+  }
+
  private:
   std::optional<const bke::AttributeAccessor> get_component_attributes() const;
 };
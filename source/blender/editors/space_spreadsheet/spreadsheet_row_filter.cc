@@ -3,7 +3,9 @@
  * SPDX-License-Identifier: GPL-2.0-or-later */
 
 #include <cstring>
+#include <string>
 
+#include "BLI_hash.hh"
 #include "BLI_listbase.h"
 #include "BLI_math_color.hh"
 #include "BLI_math_matrix.hh"
@@ -363,6 +365,72 @@ static bool use_selection_filter(const SpaceSpreadsheet &sspreadsheet,
   return true;
 }
 
+template<typename T> static void append_bytes(std::string &r_state, const T &value)
+{
+  r_state.append(reinterpret_cast<const char *>(&value), sizeof(T));
+}
+
+/**
+ * Append all settings of the row filter that change which rows it keeps, so that the filtered
+ * rows can be reused while the filter settings don't change.
+ */
+static void append_row_filter_state(const SpreadsheetRowFilter &row_filter, std::string &r_state)
+{
+  r_state.append(row_filter.column_name);
+  r_state.push_back('\0');
+  append_bytes(r_state, row_filter.operation);
+  append_bytes(r_state, uint8_t(row_filter.flag & SPREADSHEET_ROW_FILTER_BOOL_VALUE));
+  append_bytes(r_state, row_filter.value_int);
+  append_bytes(r_state, row_filter.value_int2);
+  append_bytes(r_state, row_filter.value_float);
+  append_bytes(r_state, row_filter.threshold);
+  append_bytes(r_state, row_filter.value_float2);
+  append_bytes(r_state, row_filter.value_float3);
+  append_bytes(r_state, row_filter.value_color);
+  if (row_filter.value_string) {
+    r_state.append(row_filter.value_string);
+  }
+  r_state.push_back('\0');
+}
+
+/**
+ * Identifies the rows that remain after applying the first few enabled row filters to a specific
+ * version of the data.
+ */
+class RowFilterCacheKey : public SpreadsheetCache::Key {
+ public:
+  uint64_t data_version;
+  int tot_rows;
+  /** The settings of all applied filters, see #append_row_filter_state. */
+  std::string filters_state;
+
+  RowFilterCacheKey(const uint64_t data_version, const int tot_rows, std::string filters_state)
+      : data_version(data_version), tot_rows(tot_rows), filters_state(std::move(filters_state))
+  {
+  }
+
+  uint64_t hash() const override
+  {
+    return get_default_hash(data_version, tot_rows, filters_state);
+  }
+
+ private:
+  bool is_equal_to(const Key &other) const override
+  {
+    if (const RowFilterCacheKey *other_key = dynamic_cast<const RowFilterCacheKey *>(&other)) {
+      return data_version == other_key->data_version && tot_rows == other_key->tot_rows &&
+             filters_state == other_key->filters_state;
+    }
+    return false;
+  }
+};
+
+class RowFilterCacheValue : public SpreadsheetCache::Value {
+ public:
+  IndexMaskMemory memory;
+  IndexMask mask;
+};
+
 IndexMask spreadsheet_filter_rows(const SpaceSpreadsheet &sspreadsheet,
                                   const SpreadsheetLayout &spreadsheet_layout,
                                   const DataSource &data_source,
@@ -381,28 +449,52 @@ IndexMask spreadsheet_filter_rows(const SpaceSpreadsheet &sspreadsheet,
   IndexMaskMemory &mask_memory = scope.construct<IndexMaskMemory>();
   IndexMask mask(tot_rows);
 
-  if (use_selection) {
-    const GeometryDataSource *geometry_data_source = dynamic_cast<const GeometryDataSource *>(
-        &data_source);
-    mask = geometry_data_source->apply_selection_filter(mask_memory);
-  }
-
   if (use_filters) {
     Map<StringRef, const ColumnValues *> columns;
     for (const ColumnLayout &column : spreadsheet_layout.columns) {
       columns.add(column.values->name(), column.values);
     }
 
+    /* The rows remaining after every enabled filter are cached, so that changing or adding a
+     * filter only evaluates the filters after it, and redrawing unchanged data evaluates none. */
+    SpreadsheetCache &cache = sspreadsheet.runtime->cache;
+    const uint64_t data_version = data_source.data_version();
+    std::string filters_state;
+
     LISTBASE_FOREACH (const SpreadsheetRowFilter *, row_filter, &sspreadsheet.row_filters) {
       if (row_filter->flag & SPREADSHEET_ROW_FILTER_ENABLED) {
         if (!columns.contains(row_filter->column_name)) {
           continue;
         }
-        mask = apply_row_filter(*row_filter, columns, mask, mask_memory);
+        if (data_version == 0) {
+          mask = apply_row_filter(*row_filter, columns, mask, mask_memory);
+          continue;
+        }
+        append_row_filter_state(*row_filter, filters_state);
+        auto key = std::make_unique<RowFilterCacheKey>(data_version, tot_rows, filters_state);
+        if (const RowFilterCacheValue *value = dynamic_cast<const RowFilterCacheValue *>(
+                cache.lookup(*key)))
+        {
+          mask = value->mask;
+          continue;
+        }
+        auto value = std::make_unique<RowFilterCacheValue>();
+        value->mask = apply_row_filter(*row_filter, columns, mask, value->memory);
+        mask = value->mask;
+        cache.add(std::move(key), std::move(value));
       }
     }
   }
 
+  if (use_selection) {
+    /* The selection can change without the data being evaluated again, so it is applied to the
+     * (possibly cached) result of the row filters instead of being cached itself. */
+    const GeometryDataSource *geometry_data_source = dynamic_cast<const GeometryDataSource *>(
+        &data_source);
+    const IndexMask selection = geometry_data_source->apply_selection_filter(mask_memory);
+    mask = IndexMask::from_intersection(mask, selection, mask_memory);
+  }
+
   return mask;
 }
 
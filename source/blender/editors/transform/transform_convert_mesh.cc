@@ -2097,6 +2097,13 @@ static void recalcData_mesh(TransInfo *t)
   mesh_partial_types_calc(t, &partial_state);
 
   FOREACH_TRANS_DATA_CONTAINER (t, tc) {
+    /* Only coordinates change unless custom-data (UVs...) is being corrected too. */
+    const TransCustomDataMesh *tcmd = static_cast<const TransCustomDataMesh *>(
+        tc->custom.type.data);
+    const bool is_deform_only = (tcmd == nullptr) || (tcmd->cd_layer_correct == nullptr);
+    BKE_editmesh_update_tag(BKE_editmesh_from_object(tc->obedit),
+                            is_deform_only ? BKE_EDITMESH_UPDATE_DEFORM :
+                                             BKE_EDITMESH_UPDATE_ALL);
     DEG_id_tag_update(static_cast<ID *>(tc->obedit->data), ID_RECALC_GEOMETRY);
 
     mesh_partial_update(t, tc, &partial_state);
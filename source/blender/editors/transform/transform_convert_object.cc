@@ -28,6 +28,7 @@
 #include "ED_anim_api.hh"
 #include "ED_object.hh"
 
+#include "DEG_depsgraph.hh"
 #include "DEG_depsgraph_query.hh"
 
 #include "transform.hh"
@@ -847,6 +848,7 @@ static void recalcData_objects(TransInfo *t)
     transform_snap_project_individual_apply(t);
   }
 
+  blender::Vector<ID *> ids_to_tag;
   FOREACH_TRANS_DATA_CONTAINER (t, tc) {
     TransData *td = tc->data;
 
@@ -869,11 +871,12 @@ static void recalcData_objects(TransInfo *t)
 
       motionpath_update |= motionpath_need_update_object(t->scene, ob);
 
-      /* Sets recalc flags fully, instead of flushing existing ones
-       * otherwise proxies don't function correctly. */
-      DEG_id_tag_update(&ob->id, ID_RECALC_TRANSFORM);
+      ids_to_tag.append(&ob->id);
     }
   }
+  /* Sets recalc flags fully, instead of flushing existing ones
+   * otherwise proxies don't function correctly. */
+  DEG_id_tag_update_batch(CTX_data_main(t->context), ids_to_tag, ID_RECALC_TRANSFORM);
 
   if (motionpath_update) {
     /* Update motion paths once for all transformed objects. */
@@ -87,6 +87,23 @@ static bool memfile_undosys_step_encode(bContext * /*C*/, Main *bmain, UndoStep
   us->data = BKE_memfile_undo_encode(bmain, us_prev ? us_prev->data : nullptr);
   us->step.data_size = us->data->undo_size;
 
+  if (U.undo_compress_steps != 0) {
+    /* Compress the step that just became old enough in the background, and update the memory
+     * usage of steps compressed since the last push, so that the undo memory limit accounts for
+     * it. */
+    int memfile_steps_num = 0;
+    LISTBASE_FOREACH_BACKWARD (UndoStep *, us_iter, &ustack->steps) {
+      if (us_iter->type != BKE_UNDOSYS_TYPE_MEMFILE) {
+        continue;
+      }
+      MemFile *memfile = &((MemFileUndoStep *)us_iter)->data->memfile;
+      if (++memfile_steps_num == U.undo_compress_steps) {
+        BLO_memfile_compress(memfile);
+      }
+      us_iter->data_size = BLO_memfile_size_get(memfile);
+    }
+  }
+
   /* Store the fact that we should not re-use old data with that undo step, and reset the Main
    * flag. */
   us->step.use_old_bmain_data = !bmain->use_memfile_full_barrier;
@@ -114,6 +114,12 @@ class MultiFunction : NonCopyable, NonMovable {
      * memory usage.
      */
     bool allocates_array = false;
+    /**
+     * Upper bound for the number of indices processed at once when #allocates_array is true.
+     * Functions that allocate many intermediate arrays can lower this so that all of them stay in
+     * the CPU cache.
+     */
+    int64_t max_grain_size = 10000;
     /**
      * Tells the caller that every execution takes about the same time. This helps making a more
      * educated guess about a good grain size.
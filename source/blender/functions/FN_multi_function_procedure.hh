@@ -274,6 +274,8 @@ class Procedure : NonCopyable, NonMovable {
   Span<Variable *> variables();
   Span<const Variable *> variables() const;
 
+  Span<const CallInstruction *> call_instructions() const;
+
   std::string to_dot() const;
 
   bool validate() const;
@@ -520,6 +522,11 @@ inline Span<const Variable *> Procedure::variables() const
   return variables_;
 }
 
+inline Span<const CallInstruction *> Procedure::call_instructions() const
+{
+  return call_instructions_;
+}
+
 template<typename T, typename... Args>
 inline const MultiFunction &Procedure::construct_function(Args &&...args)
 {
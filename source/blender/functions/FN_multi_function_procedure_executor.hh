@@ -17,6 +17,13 @@ class ProcedureExecutor : public MultiFunction {
  private:
   Signature signature_;
   const Procedure &procedure_;
+  /** Size of one element of all intermediate variables together. */
+  int64_t intermediate_bytes_per_index_ = 0;
+  /** Upper bound for the memory used by intermediate variables, see #ValueAllocator. */
+  int64_t scratch_bytes_per_index_ = 0;
+  int64_t intermediate_variables_num_ = 0;
+  /** Smallest grain size of the called functions, see #MultiFunction::ExecutionHints. */
+  int64_t min_grain_size_ = 10000;
 
  public:
   ProcedureExecutor(const Procedure &procedure);
@@ -257,20 +257,28 @@ struct ScheduledNodes {
   }
 
   /**
-   * Split up the scheduled nodes into two groups that can be worked on in parallel.
+   * Split up the scheduled nodes into two groups that can be worked on in parallel. The nodes that
+   * have been scheduled most recently stay in this group, because they are most likely to use the
+   * data that the current thread just computed.
    */
   void split_into(ScheduledNodes &other)
   {
     BLI_assert(this != &other);
     const int64_t priority_split = priority_.size() / 2;
     const int64_t normal_split = normal_.size() / 2;
-    other.priority_.extend(priority_.as_span().drop_front(priority_split));
-    other.normal_.extend(normal_.as_span().drop_front(normal_split));
-    priority_.resize(priority_split);
-    normal_.resize(normal_split);
+    other.priority_.extend(priority_.as_span().take_front(priority_split));
+    other.normal_.extend(normal_.as_span().take_front(normal_split));
+    priority_.remove(0, priority_split);
+    normal_.remove(0, normal_split);
   }
 };
 
+/**
+ * Nodes that take longer than this are considered to be expensive enough that the remaining
+ * scheduled nodes should be shared with other threads.
+ */
+static constexpr timeit::Nanoseconds slow_node_duration_threshold = std::chrono::microseconds(50);
+
 struct CurrentTask {
   /**
    * Mutex used to protect #scheduled_nodes when the executor uses multi-threading.
@@ -812,11 +820,19 @@ class Executor {
       if (current_task.scheduled_nodes.is_empty()) {
         current_task.has_scheduled_nodes.store(false, std::memory_order_relaxed);
       }
+      const timeit::TimePoint start_time = timeit::Clock::now();
       this->run_node_task(*node, current_task, local_data);
+      const timeit::Nanoseconds duration = timeit::Clock::now() - start_time;
 
       /* If there are many nodes scheduled at the same time, it's beneficial to let multiple
-       * threads work on those. */
-      if (current_task.scheduled_nodes.nodes_num() > 128) {
+       * threads work on those. The same is true when the nodes take a while to execute, even if
+       * there are only a few of them, e.g. when there are many independent branches that each
+       * do some actual work. The split off nodes are pushed as a new task that idle threads can
+       * steal. */
+      const int64_t scheduled_nodes_num = current_task.scheduled_nodes.nodes_num();
+      if (scheduled_nodes_num > 128 ||
+          (scheduled_nodes_num >= 2 && duration > slow_node_duration_threshold))
+      {
         if (this->try_enable_multi_threading()) {
           std::unique_ptr<ScheduledNodes> split_nodes = std::make_unique<ScheduledNodes>();
           current_task.scheduled_nodes.split_into(*split_nodes);
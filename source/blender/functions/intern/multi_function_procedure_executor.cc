@@ -4,6 +4,9 @@
 
 #include "FN_multi_function_procedure_executor.hh"
 
+#include <new>
+
+#include "BLI_set.hh"
 #include "BLI_stack.hh"
 
 namespace blender::fn::multi_function {
@@ -17,8 +20,96 @@ ProcedureExecutor::ProcedureExecutor(const Procedure &procedure) : procedure_(pr
   }
 
   this->set_signature(&signature_);
+
+  Set<const Variable *> param_variables;
+  for (const ConstParameter &param : procedure.params()) {
+    param_variables.add(param.variable);
+  }
+  for (const Variable *variable : procedure.variables()) {
+    const DataType data_type = variable->data_type();
+    if (data_type.is_single() && !param_variables.contains(variable)) {
+      const int64_t type_size = data_type.single_type().size();
+      intermediate_bytes_per_index_ += type_size;
+      /* Small types are stored in buffers that can hold any small type, see #ValueAllocator. */
+      scratch_bytes_per_index_ += std::max<int64_t>(type_size, 16);
+      intermediate_variables_num_++;
+    }
+  }
+  for (const CallInstruction *instruction : procedure.call_instructions()) {
+    min_grain_size_ = std::min(min_grain_size_, instruction->fn().execution_hints().min_grain_size);
+  }
 }
 
+namespace {
+
+/**
+ * Memory for intermediate buffers that is reused by consecutive procedure evaluations on the same
+ * thread. Large masks are evaluated in many chunks, and allocating and freeing the buffers for
+ * every chunk would cost more than the evaluation of cheap procedures itself.
+ */
+struct ScratchMemory : NonCopyable, NonMovable {
+  void *buffer = nullptr;
+  int64_t size = 0;
+  bool in_use = false;
+
+  /* Not using guarded allocation, because the memory of the main thread is only freed when the
+   * thread exits, which is after checking for leaks. */
+  void free_buffer()
+  {
+    if (buffer) {
+      ::operator delete(buffer, std::align_val_t(64));
+      buffer = nullptr;
+    }
+  }
+
+  ~ScratchMemory()
+  {
+    this->free_buffer();
+  }
+};
+
+/** Don't keep around much memory for every thread. */
+constexpr int64_t max_scratch_memory_size = 4 * 1024 * 1024;
+
+static thread_local ScratchMemory scratch_memory;
+
+/** Provides the thread local scratch memory to a linear allocator for the duration of a call. */
+class ScopedScratchMemory : NonCopyable, NonMovable {
+ private:
+  bool is_used_ = false;
+
+ public:
+  ScopedScratchMemory(LinearAllocator<> &linear_allocator, const int64_t size)
+  {
+    if (scratch_memory.in_use || size > max_scratch_memory_size) {
+      /* The procedure is evaluated recursively or the memory would be too large. */
+      return;
+    }
+    if (scratch_memory.size < size) {
+      scratch_memory.free_buffer();
+      scratch_memory.buffer = ::operator new(size, std::align_val_t(64));
+      scratch_memory.size = size;
+    }
+    scratch_memory.in_use = true;
+    is_used_ = true;
+    linear_allocator.provide_buffer(scratch_memory.buffer, scratch_memory.size);
+  }
+
+  ~ScopedScratchMemory()
+  {
+    if (is_used_) {
+      scratch_memory.in_use = false;
+    }
+  }
+
+  bool is_used() const
+  {
+    return is_used_;
+  }
+};
+
+}  // namespace
+
 using IndicesSplitVectors = std::array<Vector<int64_t>, 2>;
 
 namespace {
@@ -1161,9 +1252,17 @@ void ProcedureExecutor::call(const IndexMask &full_mask, Params params, Context
 {
   BLI_assert(procedure_.validate());
 
+  /* Buffers of intermediate variables are usually allocated from the scratch memory. Also leave
+   * some space for the variable values and other small allocations. */
+  const int64_t scratch_size = scratch_bytes_per_index_ * full_mask.min_array_size() +
+                               intermediate_variables_num_ * 64 + 1024;
+
   AlignedBuffer<512, 64> local_buffer;
   LinearAllocator<> linear_allocator;
-  linear_allocator.provide_buffer(local_buffer);
+  const ScopedScratchMemory scratch{linear_allocator, scratch_size};
+  if (!scratch.is_used()) {
+    linear_allocator.provide_buffer(local_buffer);
+  }
 
   VariableStates variable_states{linear_allocator, procedure_, full_mask};
   variable_states.add_initial_variable_states(*this, procedure_, params);
@@ -1245,7 +1344,20 @@ MultiFunction::ExecutionHints ProcedureExecutor::get_execution_hints() const
 {
   ExecutionHints hints;
   hints.allocates_array = true;
-  hints.min_grain_size = 10000;
+  /* Expensive functions like noise textures benefit from multi-threading already on smaller
+   * domains. Splitting up the whole procedure is better than only threading the expensive
+   * function within every chunk. */
+  hints.min_grain_size = min_grain_size_;
+  /* Process indices in chunks whose intermediate buffers fit into the CPU cache together. The
+   * data then doesn't have to go through main memory between the instructions, which dominates
+   * the cost of long chains of cheap functions (like many math nodes) otherwise. The lower bound
+   * keeps the per-instruction overhead of the interpreter small. */
+  const int64_t cache_size = 256 * 1024;
+  const int64_t min_chunk_size = 1024;
+  if (intermediate_bytes_per_index_ > 0) {
+    hints.max_grain_size = std::clamp<int64_t>(
+        cache_size / intermediate_bytes_per_index_, min_chunk_size, hints.max_grain_size);
+  }
   return hints;
 }
 
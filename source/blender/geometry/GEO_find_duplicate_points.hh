@@ -0,0 +1,35 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+#pragma once
+
+#include "BLI_index_mask.hh"
+#include "BLI_math_vector_types.hh"
+
+/** \file
+ * \ingroup geo
+ */
+
+namespace blender::geometry {
+
+/**
+ * Find the selected points that are within \a merge_distance of another selected point. This
+ * gives the same result as #BLI_kdtree_3d_calc_duplicates_fast with `use_index_order` enabled:
+ * Points are processed in index order, and every point that has not been merged yet takes all
+ * unmerged points in its range as duplicates. Merging is always a single step.
+ *
+ * Instead of a KD-tree, a uniform grid with the merge distance as cell size is used, which can
+ * be built in parallel and is much faster to query.
+ *
+ * \param r_duplicates: Has the size of \a positions. Must be initialized to -1 for selected
+ * points. Afterwards, duplicates contain the index of the point they are merged into, and points
+ * that other points are merged into contain their own index.
+ * \return The number of duplicates found.
+ */
+int find_duplicate_points(Span<float3> positions,
+                          const IndexMask &selection,
+                          float merge_distance,
+                          MutableSpan<int> r_duplicates);
+
+}  // namespace blender::geometry
@@ -4,6 +4,8 @@
 
 #pragma once
 
+#include "BLI_function_ref.hh"
+
 #include "BKE_geometry_set.hh"
 
 namespace blender::geometry {
@@ -70,4 +72,21 @@ bke::GeometrySet realize_instances(bke::GeometrySet geometry_set,
                                    const RealizeInstancesOptions &options,
                                    const VariedDepthOptions &varied_depth_option);
 
+/**
+ * Same as #realize_instances, but instead of joining everything into a single geometry, the
+ * realized geometry is passed to the callback in multiple batches. Each batch contains a subset
+ * of the top-level instances with roughly at most `max_batch_elements` points, unless a single
+ * instance is larger than that. The non-instance geometry of the input is passed as first batch.
+ *
+ * This is useful for consumers that can process the geometry incrementally (e.g. exporters),
+ * because the peak memory usage is proportional to the batch size instead of the size of
+ * all realized instances.
+ *
+ * \note Generated ids are not guaranteed to match the ones generated by #realize_instances.
+ */
+void realize_instances_in_batches(bke::GeometrySet geometry_set,
+                                  const RealizeInstancesOptions &options,
+                                  int64_t max_batch_elements,
+                                  FunctionRef<void(bke::GeometrySet batch)> fn);
+
 }  // namespace blender::geometry
@@ -0,0 +1,124 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+#include "BLI_array.hh"
+#include "BLI_bounds.hh"
+#include "BLI_kdtree.h"
+#include "BLI_math_vector.hh"
+#include "BLI_sort.hh"
+#include "BLI_task.hh"
+
+#include "GEO_find_duplicate_points.hh"
+
+namespace blender::geometry {
+
+static int find_duplicate_points_kdtree(const Span<float3> positions,
+                                        const IndexMask &selection,
+                                        const float merge_distance,
+                                        MutableSpan<int> r_duplicates)
+{
+  KDTree_3d *tree = BLI_kdtree_3d_new(selection.size());
+  selection.foreach_index([&](const int64_t i) { BLI_kdtree_3d_insert(tree, i, positions[i]); });
+  BLI_kdtree_3d_balance(tree);
+  const int duplicates_num = BLI_kdtree_3d_calc_duplicates_fast(
+      tree, merge_distance, true, r_duplicates.data());
+  BLI_kdtree_3d_free(tree);
+  return duplicates_num;
+}
+
+/**
+ * Cells are identified by a single integer that packs the three cell coordinates. Sorting the
+ * points by that key puts cells next to each other along the x axis, so the three cells that
+ * have to be checked in every row are contiguous.
+ */
+constexpr int cell_coordinate_bits = 21;
+constexpr int64_t max_cell_coordinate = (int64_t(1) << cell_coordinate_bits) - 1;
+
+static uint64_t cell_key(const int3 cell)
+{
+  return (uint64_t(cell.z) << (2 * cell_coordinate_bits)) |
+         (uint64_t(cell.y) << cell_coordinate_bits) | uint64_t(cell.x);
+}
+
+struct GridPoint {
+  uint64_t key;
+  int index;
+};
+
+int find_duplicate_points(const Span<float3> positions,
+                          const IndexMask &selection,
+                          const float merge_distance,
+                          MutableSpan<int> r_duplicates)
+{
+  BLI_assert(positions.size() == r_duplicates.size());
+  if (selection.is_empty()) {
+    return 0;
+  }
+  const std::optional<Bounds<float3>> bounds = bounds::min_max(positions);
+  if (!(merge_distance > 0.0f) || !bounds) {
+    return find_duplicate_points_kdtree(positions, selection, merge_distance, r_duplicates);
+  }
+  /* Make the cells slightly larger than the merge distance, so that points within the distance
+   * are always in neighboring cells, even with rounding errors. */
+  const float cell_size = merge_distance * 1.001f;
+  const float3 extent = (bounds->max - bounds->min) / cell_size;
+  if (math::reduce_max(extent) >= float(max_cell_coordinate - 2)) {
+    /* The grid would be too fine for the packed keys. */
+    return find_duplicate_points_kdtree(positions, selection, merge_distance, r_duplicates);
+  }
+
+  /* Offset the cell coordinates by one, so that the neighbors of every cell have valid keys. */
+  auto cell_of_position = [&](const float3 &position) {
+    return int3((position - bounds->min) / cell_size) + int3(1);
+  };
+
+  Array<GridPoint> grid_points(selection.size());
+  selection.foreach_index_optimized<int>(GrainSize(4096), [&](const int i, const int pos) {
+    grid_points[pos] = {cell_key(cell_of_position(positions[i])), i};
+  });
+  parallel_sort(grid_points.begin(),
+                grid_points.end(),
+                [](const GridPoint &a, const GridPoint &b) { return a.key < b.key; });
+
+  const float merge_distance_sq = merge_distance * merge_distance;
+  int duplicates_num = 0;
+
+  /* Finding the duplicates has to be sequential, because whether a point can take duplicates
+   * depends on all points with a smaller index. */
+  selection.foreach_index([&](const int i) {
+    if (!ELEM(r_duplicates[i], -1, i)) {
+      return;
+    }
+    const float3 &position = positions[i];
+    const int3 cell = cell_of_position(position);
+    const int duplicates_num_prev = duplicates_num;
+    for (int z = cell.z - 1; z <= cell.z + 1; z++) {
+      for (int y = cell.y - 1; y <= cell.y + 1; y++) {
+        const uint64_t first_key = cell_key(int3(cell.x - 1, y, z));
+        const uint64_t last_key = cell_key(int3(cell.x + 1, y, z));
+        const GridPoint *point = std::lower_bound(
+            grid_points.begin(), grid_points.end(), first_key, [](const GridPoint &a, uint64_t b) {
+              return a.key < b;
+            });
+        for (; point != grid_points.end() && point->key <= last_key; point++) {
+          const int other = point->index;
+          if (other == i || r_duplicates[other] != -1) {
+            continue;
+          }
+          if (math::distance_squared(positions[other], position) <= merge_distance_sq) {
+            r_duplicates[other] = i;
+            duplicates_num++;
+          }
+        }
+      }
+    }
+    if (duplicates_num != duplicates_num_prev) {
+      /* Prevent chains of duplicates. */
+      r_duplicates[i] = i;
+    }
+  });
+  return duplicates_num;
+}
+
+}  // namespace blender::geometry
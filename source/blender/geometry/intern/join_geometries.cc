@@ -51,25 +51,25 @@ static void fill_new_attribute(const Span<const GeometryComponent *> src_compone
                                const bke::AttrDomain domain,
                                GMutableSpan dst_span)
 {
-  const CPPType *cpp_type = bke::custom_data_type_to_cpp_type(data_type);
-  BLI_assert(cpp_type != nullptr);
+  Array<int> offsets_data(src_components.size() + 1);
+  for (const int i : src_components.index_range()) {
+    offsets_data[i] = src_components[i]->attribute_domain_size(domain);
+  }
+  const OffsetIndices offsets = offset_indices::accumulate_counts_to_offsets(offsets_data);
 
-  int offset = 0;
-  for (const GeometryComponent *component : src_components) {
-    const int domain_num = component->attribute_domain_size(domain);
-    if (domain_num == 0) {
-      continue;
+  /* Copy directly from the source attributes without creating temporary spans for virtual arrays.
+   * Inputs are usually either many small or a few large components, so parallelize over the
+   * components and within each copy. */
+  threading::parallel_for(src_components.index_range(), 16, [&](const IndexRange range) {
+    for (const int i : range) {
+      if (offsets[i].is_empty()) {
+        continue;
+      }
+      const GVArray src = *src_components[i]->attributes()->lookup_or_default(
+          attribute_id, domain, data_type, nullptr);
+      array_utils::copy(src, dst_span.slice(offsets[i]));
     }
-    GVArray read_attribute = *component->attributes()->lookup_or_default(
-        attribute_id, domain, data_type, nullptr);
-
-    GVArraySpan src_span{read_attribute};
-    const void *src_buffer = src_span.data();
-    void *dst_buffer = dst_span[offset];
-    cpp_type->copy_assign_n(src_buffer, dst_buffer, domain_num);
-
-    offset += domain_num;
-  }
+  });
 }
 
 void join_attributes(const Span<const GeometryComponent *> src_components,
@@ -2321,4 +2321,108 @@ bke::GeometrySet realize_instances(bke::GeometrySet geometry_set,
 
 /** \} */
 
+/* -------------------------------------------------------------------- */
+/** \name Realize Instances in Batches
+ * \{ */
+
+static int64_t approximate_realized_elements_num(const bke::GeometrySet &geometry_set);
+
+/** The number of elements every instance contributes to the realized geometry. */
+static Array<int64_t> realized_elements_num_per_instance(const Instances &instances)
+{
+  const Span<bke::InstanceReference> references = instances.references();
+  Array<int64_t> num_per_reference(references.size());
+  for (const int i : references.index_range()) {
+    bke::GeometrySet reference_geometry;
+    references[i].to_geometry_set(reference_geometry);
+    num_per_reference[i] = approximate_realized_elements_num(reference_geometry);
+  }
+  const Span<int> handles = instances.reference_handles();
+  Array<int64_t> num_per_instance(instances.instances_num());
+  threading::parallel_for(handles.index_range(), 4096, [&](const IndexRange range) {
+    for (const int i : range) {
+      num_per_instance[i] = num_per_reference[handles[i]];
+    }
+  });
+  return num_per_instance;
+}
+
+static int64_t approximate_realized_elements_num(const bke::GeometrySet &geometry_set)
+{
+  int64_t elements_num = 0;
+  if (const Mesh *mesh = geometry_set.get_mesh()) {
+    elements_num += mesh->verts_num + mesh->corners_num;
+  }
+  if (const PointCloud *pointcloud = geometry_set.get_pointcloud()) {
+    elements_num += pointcloud->totpoint;
+  }
+  if (const Curves *curves = geometry_set.get_curves()) {
+    elements_num += curves->geometry.point_num;
+  }
+  if (const Instances *instances = geometry_set.get_instances()) {
+    const Array<int64_t> num_per_instance = realized_elements_num_per_instance(*instances);
+    for (const int64_t num : num_per_instance) {
+      elements_num += num;
+    }
+  }
+  return elements_num;
+}
+
+static void realize_instances_batch(const bke::GeometrySet &geometry_set,
+                                    const IndexRange batch,
+                                    const RealizeInstancesOptions &options,
+                                    const FunctionRef<void(bke::GeometrySet batch)> fn)
+{
+  const Instances &instances = *geometry_set.get_instances();
+  IndexMaskMemory memory;
+  const IndexMask instances_to_remove = IndexMask(batch).complement(
+      IndexRange(instances.instances_num()), memory);
+
+  std::unique_ptr<Instances> batch_instances = std::make_unique<Instances>(instances);
+  batch_instances->remove(instances_to_remove, options.attribute_filter);
+  batch_instances->remove_unused_references();
+
+  bke::GeometrySet batch_geometry = bke::GeometrySet::from_instances(batch_instances.release());
+  fn(realize_instances(std::move(batch_geometry), options));
+}
+
+void realize_instances_in_batches(bke::GeometrySet geometry_set,
+                                  const RealizeInstancesOptions &options,
+                                  const int64_t max_batch_elements,
+                                  const FunctionRef<void(bke::GeometrySet batch)> fn)
+{
+  if (!geometry_set.has_instances()) {
+    fn(std::move(geometry_set));
+    return;
+  }
+
+  bke::GeometrySet instances_geometry;
+  instances_geometry.add(*geometry_set.get_component<bke::InstancesComponent>());
+  geometry_set.remove<bke::InstancesComponent>();
+  if (!geometry_set.is_empty()) {
+    fn(std::move(geometry_set));
+  }
+
+  const Instances &instances = *instances_geometry.get_instances();
+  const Array<int64_t> num_per_instance = realized_elements_num_per_instance(instances);
+
+  int64_t batch_start = 0;
+  int64_t batch_elements_num = 0;
+  for (const int i : num_per_instance.index_range()) {
+    if (i > batch_start && batch_elements_num + num_per_instance[i] > max_batch_elements) {
+      realize_instances_batch(
+          instances_geometry, IndexRange::from_begin_end(batch_start, i), options, fn);
+      batch_start = i;
+      batch_elements_num = 0;
+    }
+    batch_elements_num += num_per_instance[i];
+  }
+  realize_instances_batch(instances_geometry,
+                          IndexRange::from_begin_end(batch_start, instances.instances_num()),
+                          options,
+                          fn);
+}
+
+/** \} */
+
 }  // namespace blender::geometry
@@ -0,0 +1,108 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: Apache-2.0 */
+
+#include "testing/testing.h"
+
+#include "BLI_math_matrix.hh"
+#include "BLI_rand.hh"
+#include "BLI_timeit.hh"
+
+#include "DNA_mesh_types.h"
+
+#include "BKE_geometry_set.hh"
+#include "BKE_idtype.hh"
+#include "BKE_instances.hh"
+#include "BKE_lib_id.hh"
+
+#include "GEO_mesh_primitive_grid.hh"
+#include "GEO_realize_instances.hh"
+
+namespace blender::geometry::tests {
+
+class MeshPerformanceTest : public ::testing::Test {
+ public:
+  static void SetUpTestSuite()
+  {
+    BKE_idtype_init();
+  }
+};
+
+/** A grid with noise in its height, so normals are not all the same. */
+static Mesh *create_noisy_grid(const int verts_num_x)
+{
+  Mesh *mesh = create_grid_mesh(verts_num_x, verts_num_x, 1.0f, 1.0f, std::nullopt);
+  RandomNumberGenerator rng(0);
+  for (float3 &position : mesh->vert_positions_for_write()) {
+    position.z = rng.get_float() * 0.01f;
+  }
+  mesh->tag_positions_changed();
+  return mesh;
+}
+
+TEST_F(MeshPerformanceTest, Normals)
+{
+  for (const int size : {100, 1000, 3000}) {
+    Mesh *mesh = create_noisy_grid(size);
+    printf("Grid with %d vertices\n", mesh->verts_num);
+    {
+      SCOPED_TIMER("  face normals");
+      EXPECT_EQ(mesh->face_normals().size(), mesh->faces_num);
+    }
+    {
+      SCOPED_TIMER("  vertex normals");
+      EXPECT_EQ(mesh->vert_normals().size(), mesh->verts_num);
+    }
+    mesh->tag_positions_changed();
+    {
+      SCOPED_TIMER("  vertex normals (without cached face normals)");
+      EXPECT_EQ(mesh->vert_normals().size(), mesh->verts_num);
+    }
+    BKE_id_free(nullptr, mesh);
+  }
+}
+
+TEST_F(MeshPerformanceTest, Triangulation)
+{
+  for (const int size : {100, 1000, 3000}) {
+    Mesh *mesh = create_noisy_grid(size);
+    printf("Grid with %d faces\n", mesh->faces_num);
+    {
+      SCOPED_TIMER("  corner triangles");
+      EXPECT_EQ(mesh->corner_tris().size(), mesh->faces_num * 2);
+    }
+    {
+      SCOPED_TIMER("  corner triangle faces");
+      EXPECT_EQ(mesh->corner_tri_faces().size(), mesh->faces_num * 2);
+    }
+    BKE_id_free(nullptr, mesh);
+  }
+}
+
+TEST_F(MeshPerformanceTest, RealizeInstances)
+{
+  for (const int instances_num : {100, 10000}) {
+    Mesh *mesh = create_noisy_grid(100);
+    const int verts_num = mesh->verts_num;
+
+    bke::Instances *instances = new bke::Instances();
+    const int handle = instances->add_reference(bke::GeometrySet::from_mesh(mesh));
+    instances->resize(instances_num);
+    instances->reference_handles_for_write().fill(handle);
+    MutableSpan<float4x4> transforms = instances->transforms_for_write();
+    for (const int i : transforms.index_range()) {
+      transforms[i] = math::from_location<float4x4>(float3(i, 0.0f, 0.0f));
+    }
+    bke::GeometrySet geometry = bke::GeometrySet::from_instances(instances);
+
+    printf("%d instances of a mesh with %d vertices\n", instances_num, verts_num);
+    bke::GeometrySet realized;
+    {
+      SCOPED_TIMER("  realize_instances");
+      realized = realize_instances(std::move(geometry), RealizeInstancesOptions());
+    }
+    EXPECT_EQ(realized.get_mesh()->verts_num, verts_num * instances_num);
+  }
+}
+
+}  // namespace blender::geometry::tests
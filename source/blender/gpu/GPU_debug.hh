@@ -61,6 +61,9 @@
 
 #pragma once
 
+#include <string>
+
+#include "BLI_span.hh"
 #include "BLI_sys_types.h"
 
 #define GPU_DEBUG_SHADER_COMPILATION_GROUP "Shader Compilation"
@@ -77,6 +80,32 @@ void GPU_debug_get_groups_names(int name_buf_len, char *r_name_buf);
  */
 bool GPU_debug_group_match(const char *ref);
 
+/** GPU time spent inside a debug group. */
+struct GPUDebugGroupTiming {
+  std::string name;
+  /** Number of parent groups. */
+  int depth;
+  double time_ms;
+};
+
+/**
+ * Measure the GPU time spent inside each debug group until #GPU_debug_timings_frame_end.
+ * Does nothing if the backend doesn't support timer queries.
+ */
+void GPU_debug_timings_frame_begin();
+void GPU_debug_timings_frame_end();
+/**
+ * Request the timings to be recorded even when they aren't displayed. The draw manager records
+ * the timings of every viewport redraw while this is enabled.
+ */
+void GPU_debug_timings_enable(bool enable);
+bool GPU_debug_timings_enabled();
+/**
+ * Timings of the debug groups of the last frame whose results are available, in submission
+ * order. The results lag a few frames behind to avoid waiting for the GPU.
+ */
+blender::Span<GPUDebugGroupTiming> GPU_debug_timings_get();
+
 /**
  * GPU Frame capture support.
  *
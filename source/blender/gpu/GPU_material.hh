@@ -294,6 +294,18 @@ eGPUMaterialOptimizationStatus GPU_material_optimization_status(GPUMaterial *mat
 void GPU_material_optimization_status_set(GPUMaterial *mat, eGPUMaterialOptimizationStatus status);
 bool GPU_material_optimization_ready(GPUMaterial *mat);
 
+/**
+ * Scheduling priority used by the deferred compilation queue.
+ * Materials with a higher priority are compiled first (e.g. visible and large on screen).
+ */
+float GPU_material_compile_priority(GPUMaterial *mat);
+void GPU_material_compile_priority_set(GPUMaterial *mat, float priority);
+/**
+ * Duration of the last compilation of this material in seconds.
+ * Only valid once the material status is #GPU_MAT_SUCCESS or #GPU_MAT_FAILED.
+ */
+double GPU_material_compile_time(GPUMaterial *mat);
+
 /**
  * Store reference to a similar default material for asynchronous PSO cache warming.
  *
@@ -77,6 +77,8 @@ void GPU_viewport_stereo_composite(GPUViewport *viewport, Stereo3dFormat *stereo
 
 void GPU_viewport_tag_update(GPUViewport *viewport);
 bool GPU_viewport_do_update(GPUViewport *viewport);
+/** Same as #GPU_viewport_do_update but doesn't clear the update tag. */
+bool GPU_viewport_is_update_tagged(const GPUViewport *viewport);
 
 int GPU_viewport_active_view_get(GPUViewport *viewport);
 bool GPU_viewport_is_stereo_get(GPUViewport *viewport);
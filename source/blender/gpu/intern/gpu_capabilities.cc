@@ -192,6 +192,11 @@ bool GPU_stencil_export_support()
   return GCaps.stencil_export_support;
 }
 
+bool GPU_timer_query_support()
+{
+  return GCaps.timer_query_support;
+}
+
 int GPU_max_shader_storage_buffer_bindings()
 {
   return GCaps.max_shader_storage_buffer_bindings;
@@ -73,6 +73,10 @@ Context::Context()
 
 Context::~Context()
 {
+  delete debug_timing_frame;
+  for (DebugTimingFrame *frame : debug_timing_frames_pending) {
+    delete frame;
+  }
   GPU_matrix_state_discard(matrix_state);
   delete state_manager;
   delete front_left;
@@ -51,6 +51,10 @@ class Context {
 
   DebugStack debug_stack;
   bool debug_is_capturing = false;
+  /** Frame recording the debug group timings, nullptr if not recording. */
+  DebugTimingFrame *debug_timing_frame = nullptr;
+  /** Recorded frames waiting for their timer query results, oldest first. */
+  Vector<DebugTimingFrame *> debug_timing_frames_pending;
 
   /* GPUContext counter used to assign a unique ID to each GPUContext.
    * NOTE(Metal): This is required by the Metal Backend, as a bug exists in the global OS shader
@@ -12,19 +12,28 @@
 
 #include "BLI_string.h"
 
+#include "gpu_backend.hh"
 #include "gpu_context_private.hh"
+#include "gpu_query.hh"
 
+#include "GPU_capabilities.hh"
 #include "GPU_debug.hh"
 
 using namespace blender;
 using namespace blender::gpu;
 
+static void debug_timing_group_begin(DebugTimingFrame &frame, const char *name);
+static void debug_timing_group_end(DebugTimingFrame &frame);
+
 void GPU_debug_group_begin(const char *name)
 {
+  Context *ctx = Context::get();
+  if (ctx && ctx->debug_timing_frame) {
+    debug_timing_group_begin(*ctx->debug_timing_frame, name);
+  }
   if (!(G.debug & G_DEBUG_GPU)) {
     return;
   }
-  Context *ctx = Context::get();
   DebugStack &stack = ctx->debug_stack;
   stack.append(StringRef(name));
   ctx->debug_group_begin(name, stack.size());
@@ -32,10 +41,13 @@ void GPU_debug_group_begin(const char *name)
 
 void GPU_debug_group_end()
 {
+  Context *ctx = Context::get();
+  if (ctx && ctx->debug_timing_frame) {
+    debug_timing_group_end(*ctx->debug_timing_frame);
+  }
   if (!(G.debug & G_DEBUG_GPU)) {
     return;
   }
-  Context *ctx = Context::get();
   ctx->debug_stack.pop_last();
   ctx->debug_group_end();
 }
@@ -164,3 +176,117 @@ void GPU_debug_capture_scope_end(void *scope)
   /* Declare end of capture scope region. */
   ctx->debug_capture_scope_end(scope);
 }
+
+/* -------------------------------------------------------------------- */
+/** \name Debug Group Timings
+ * \{ */
+
+/** Frames are dropped if the GPU is this many frames late. */
+static constexpr int debug_timing_max_pending_frames = 4;
+
+static bool debug_timings_enabled = false;
+static Vector<GPUDebugGroupTiming> debug_timings_result;
+
+DebugTimingFrame::~DebugTimingFrame()
+{
+  delete queries;
+}
+
+static void debug_timing_group_begin(DebugTimingFrame &frame, const char *name)
+{
+  frame.stack.append(frame.groups.size());
+  frame.groups.append({name, int(frame.stack.size()) - 1, frame.query_len++, -1});
+  frame.queries->write_timestamp();
+}
+
+static void debug_timing_group_end(DebugTimingFrame &frame)
+{
+  if (frame.stack.is_empty()) {
+    /* Group started before the recording. */
+    return;
+  }
+  frame.groups[frame.stack.pop_last()].end_query = frame.query_len++;
+  frame.queries->write_timestamp();
+}
+
+/** Returns false if the query results of the frame are not available yet. */
+static bool debug_timing_frame_resolve(DebugTimingFrame &frame)
+{
+  Vector<uint64_t> timestamps(frame.query_len);
+  if (!frame.queries->get_timestamp_result(timestamps)) {
+    return false;
+  }
+  debug_timings_result.clear();
+  for (const DebugTimingFrame::Group &group : frame.groups) {
+    if (group.end_query == -1) {
+      continue;
+    }
+    const uint64_t duration = timestamps[group.end_query] - timestamps[group.begin_query];
+    debug_timings_result.append({group.name, group.depth, double(duration) / 1000000.0});
+  }
+  return true;
+}
+
+void GPU_debug_timings_frame_begin()
+{
+  Context *ctx = Context::get();
+  if (ctx == nullptr || ctx->debug_timing_frame || !GPU_timer_query_support()) {
+    return;
+  }
+  DebugTimingFrame *frame = new DebugTimingFrame();
+  frame->queries = GPUBackend::get()->querypool_alloc();
+  frame->queries->init(GPU_QUERY_TIMESTAMP);
+  ctx->debug_timing_frame = frame;
+}
+
+void GPU_debug_timings_frame_end()
+{
+  Context *ctx = Context::get();
+  if (ctx == nullptr || ctx->debug_timing_frame == nullptr) {
+    return;
+  }
+  /* Close groups that are still open so that their time is still reported. */
+  while (!ctx->debug_timing_frame->stack.is_empty()) {
+    debug_timing_group_end(*ctx->debug_timing_frame);
+  }
+  ctx->debug_timing_frames_pending.append(ctx->debug_timing_frame);
+  ctx->debug_timing_frame = nullptr;
+
+  Vector<DebugTimingFrame *> &pending = ctx->debug_timing_frames_pending;
+  if (pending.size() > debug_timing_max_pending_frames) {
+    delete pending.first();
+    pending.remove(0);
+  }
+  /* Only keep the results of the most recent frame that completed. */
+  int resolved_len = 0;
+  for (DebugTimingFrame *frame : pending) {
+    if (!debug_timing_frame_resolve(*frame)) {
+      break;
+    }
+    resolved_len++;
+  }
+  for (DebugTimingFrame *frame : pending.as_span().take_front(resolved_len)) {
+    delete frame;
+  }
+  pending.remove(0, resolved_len);
+}
+
+void GPU_debug_timings_enable(bool enable)
+{
+  debug_timings_enabled = enable;
+  if (!enable) {
+    debug_timings_result.clear();
+  }
+}
+
+bool GPU_debug_timings_enabled()
+{
+  return debug_timings_enabled;
+}
+
+Span<GPUDebugGroupTiming> GPU_debug_timings_get()
+{
+  return debug_timings_result;
+}
+
+/** \} */
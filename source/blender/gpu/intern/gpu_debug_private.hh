@@ -10,11 +10,33 @@
 
 #pragma once
 
+#include <string>
+
 #include "BLI_string_ref.hh"
 #include "BLI_vector.hh"
 
 namespace blender::gpu {
 
+class QueryPool;
+
 using DebugStack = Vector<StringRef>;
 
+/** Timestamps of the debug groups of a single frame. */
+struct DebugTimingFrame {
+  struct Group {
+    std::string name;
+    int depth;
+    int begin_query;
+    int end_query;
+  };
+
+  QueryPool *queries = nullptr;
+  Vector<Group> groups;
+  /** Indices of the groups that haven't ended yet. */
+  Vector<int> stack;
+  int query_len = 0;
+
+  ~DebugTimingFrame();
+};
+
 }  // namespace blender::gpu
@@ -42,6 +42,10 @@
 
 #include "atomic_ops.h"
 
+#include "CLG_log.h"
+
+static CLG_LogRef LOG = {"gpu.material"};
+
 /* Structs */
 #define MAX_COLOR_BAND 128
 #define MAX_GPU_SKIES 8
@@ -85,6 +89,12 @@ struct GPUMaterial {
    */
   eGPUMaterialOptimizationStatus optimization_status;
   double creation_time;
+  /** Deferred compilation scheduling priority. Higher values are compiled first. */
+  float compile_priority;
+  /** Time at which the (possibly asynchronous) compilation started, in seconds. */
+  double compile_start_time;
+  /** Duration of the last compilation of this material, in seconds. */
+  double compile_time;
 #if ASYNC_OPTIMIZED_PASS_CREATION == 1
   struct DeferredOptimizePass {
     GPUCodegenCallbackFn callback;
@@ -756,6 +766,21 @@ void GPU_material_optimization_status_set(GPUMaterial *mat, eGPUMaterialOptimiza
   }
 }
 
+float GPU_material_compile_priority(GPUMaterial *mat)
+{
+  return mat->compile_priority;
+}
+
+void GPU_material_compile_priority_set(GPUMaterial *mat, float priority)
+{
+  mat->compile_priority = priority;
+}
+
+double GPU_material_compile_time(GPUMaterial *mat)
+{
+  return mat->compile_time;
+}
+
 bool GPU_material_optimization_ready(GPUMaterial *mat)
 {
   /* Timer threshold before optimizations will be queued.
@@ -963,6 +988,14 @@ static void gpu_material_finalize(GPUMaterial *mat, bool success)
 {
   mat->flag |= GPU_MATFLAG_UPDATED;
 
+  mat->compile_time = BLI_time_now_seconds() - mat->compile_start_time;
+  CLOG_INFO(&LOG,
+            1,
+            "Material \"%s\" %s in %.2f ms",
+            mat->ma ? mat->ma->id.name + 2 : "",
+            success ? "compiled" : "failed to compile",
+            mat->compile_time * 1000.0);
+
   if (success) {
     GPUShader *sh = GPU_pass_shader_get(mat->pass);
     if (sh != nullptr) {
@@ -1018,6 +1051,8 @@ void GPU_material_compile(GPUMaterial *mat)
   BLI_assert(ELEM(mat->status, GPU_MAT_QUEUED, GPU_MAT_CREATED));
   BLI_assert(mat->pass);
 
+  mat->compile_start_time = BLI_time_now_seconds();
+
 /* NOTE: The shader may have already been compiled here since we are
  * sharing GPUShader across GPUMaterials. In this case it's a no-op. */
 #ifndef NDEBUG
@@ -1038,6 +1073,7 @@ void GPU_material_async_compile(GPUMaterial *mat)
 #else
   const char *name = __func__;
 #endif
+  mat->compile_start_time = BLI_time_now_seconds();
   GPU_pass_begin_async_compilation(mat->pass, name);
 }
 
@@ -16,6 +16,7 @@ namespace blender::gpu {
 
 enum GPUQueryType {
   GPU_QUERY_OCCLUSION = 0,
+  GPU_QUERY_TIMESTAMP = 1,
 };
 
 class QueryPool {
@@ -41,6 +42,19 @@ class QueryPool {
    * drawn.
    */
   virtual void get_occlusion_result(MutableSpan<uint32_t> r_values) = 0;
+
+  /**
+   * Record the time at which the GPU finished executing all previous commands in the next query.
+   * Only valid for #GPU_QUERY_TIMESTAMP pools.
+   */
+  virtual void write_timestamp() = 0;
+
+  /**
+   * Must be fed with a buffer large enough to contain all the queries issued.
+   * Timestamps are in nanoseconds. Does not wait for the GPU: returns false if the results are
+   * not available yet.
+   */
+  virtual bool get_timestamp_result(MutableSpan<uint64_t> r_values) = 0;
 };
 
 }  // namespace blender::gpu
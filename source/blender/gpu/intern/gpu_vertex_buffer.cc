@@ -92,6 +92,7 @@ void VertBuf::allocate(uint vert_len)
   BLI_assert(vertex_alloc != vert_len || data_ == nullptr);
   vertex_len = vertex_alloc = vert_len;
 
+  MEM_TagScope mem_tag_scope(MEM_TAG_GPU_STAGING);
   this->acquire_data();
 
   flag |= GPU_VERTBUF_DATA_DIRTY;
@@ -103,6 +104,7 @@ void VertBuf::resize(uint vert_len)
   BLI_assert(vertex_alloc != vert_len);
   vertex_len = vertex_alloc = vert_len;
 
+  MEM_TagScope mem_tag_scope(MEM_TAG_GPU_STAGING);
   this->resize_data();
 
   flag |= GPU_VERTBUF_DATA_DIRTY;
@@ -96,6 +96,11 @@ bool GPU_viewport_do_update(GPUViewport *viewport)
   return ret;
 }
 
+bool GPU_viewport_is_update_tagged(const GPUViewport *viewport)
+{
+  return viewport->flag & DO_UPDATE;
+}
+
 GPUViewport *GPU_viewport_create()
 {
   GPUViewport *viewport = static_cast<GPUViewport *>(
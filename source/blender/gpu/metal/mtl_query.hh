@@ -39,5 +39,12 @@ class MTLQueryPool : public QueryPool {
   void end_query() override;
 
   void get_occlusion_result(MutableSpan<uint32_t> r_values) override;
+
+  /* Timestamp queries are not supported yet, see #GPU_timer_query_support. */
+  void write_timestamp() override {}
+  bool get_timestamp_result(MutableSpan<uint64_t> /*r_values*/) override
+  {
+    return false;
+  }
 };
 }  // namespace blender::gpu
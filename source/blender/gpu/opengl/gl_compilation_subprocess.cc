@@ -182,6 +182,15 @@ void GPU_compilation_subprocess_run(const char *subprocess_name)
 
   std::string cache_dir = cache_dir_get();
 
+  /* Program binaries are only valid for the driver that created them, include it in the cache key
+   * so a driver update doesn't hit outdated binaries that fail to load. */
+  DefaultHash<StringRefNull> hasher;
+  const char *gl_vendor = reinterpret_cast<const char *>(glGetString(GL_VENDOR));
+  const char *gl_renderer = reinterpret_cast<const char *>(glGetString(GL_RENDERER));
+  const char *gl_version = reinterpret_cast<const char *>(glGetString(GL_VERSION));
+  const std::string driver_str = std::string(gl_vendor) + gl_renderer + gl_version;
+  const std::string driver_hash_str = std::to_string(hasher(driver_str));
+
   while (true) {
     /* Process events to avoid crashes on Wayland.
      * See https://bugreports.qt.io/browse/QTBUG-81504 */
@@ -211,8 +220,7 @@ void GPU_compilation_subprocess_run(const char *subprocess_name)
     const char *geom_src = nullptr;
     const char *frag_src = nullptr;
 
-    DefaultHash<StringRefNull> hasher;
-    std::string hash_str = "_";
+    std::string hash_str = driver_hash_str + "_";
 
     auto get_src = [&]() {
       const char *src = next_src;
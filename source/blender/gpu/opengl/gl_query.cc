@@ -33,16 +33,21 @@ void GLQueryPool::reset(GPUQueryType type)
 }
 #endif
 
-void GLQueryPool::begin_query()
+GLuint GLQueryPool::next_query()
 {
-  /* TODO: add assert about expected usage. */
   while (query_issued_ >= query_ids_.size()) {
     int64_t prev_size = query_ids_.size();
     int64_t chunk_size = prev_size == 0 ? query_ids_.capacity() : QUERY_CHUNCK_LEN;
     query_ids_.resize(prev_size + chunk_size);
     glGenQueries(chunk_size, &query_ids_[prev_size]);
   }
-  glBeginQuery(gl_type_, query_ids_[query_issued_++]);
+  return query_ids_[query_issued_++];
+}
+
+void GLQueryPool::begin_query()
+{
+  /* TODO: add assert about expected usage. */
+  glBeginQuery(gl_type_, next_query());
 }
 
 void GLQueryPool::end_query()
@@ -61,4 +66,32 @@ void GLQueryPool::get_occlusion_result(MutableSpan<uint32_t> r_values)
   }
 }
 
+void GLQueryPool::write_timestamp()
+{
+  BLI_assert(type_ == GPU_QUERY_TIMESTAMP);
+  glQueryCounter(next_query(), GL_TIMESTAMP);
+}
+
+bool GLQueryPool::get_timestamp_result(MutableSpan<uint64_t> r_values)
+{
+  BLI_assert(type_ == GPU_QUERY_TIMESTAMP);
+  BLI_assert(r_values.size() == query_issued_);
+
+  if (query_issued_ == 0) {
+    return true;
+  }
+  /* Queries complete in order. Checking the last one is enough. */
+  GLuint is_available = GL_FALSE;
+  glGetQueryObjectuiv(query_ids_[query_issued_ - 1], GL_QUERY_RESULT_AVAILABLE, &is_available);
+  if (!is_available) {
+    return false;
+  }
+  for (int i = 0; i < query_issued_; i++) {
+    GLuint64 value;
+    glGetQueryObjectui64v(query_ids_[i], GL_QUERY_RESULT, &value);
+    r_values[i] = value;
+  }
+  return true;
+}
+
 }  // namespace blender::gpu
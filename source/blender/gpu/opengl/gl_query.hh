@@ -39,6 +39,13 @@ class GLQueryPool : public QueryPool {
   void end_query() override;
 
   void get_occlusion_result(MutableSpan<uint32_t> r_values) override;
+
+  void write_timestamp() override;
+  bool get_timestamp_result(MutableSpan<uint64_t> r_values) override;
+
+ private:
+  /** Returns the next unused query, creating new queries as needed. */
+  GLuint next_query();
 };
 
 static inline GLenum to_gl(GPUQueryType type)
@@ -47,6 +54,9 @@ static inline GLenum to_gl(GPUQueryType type)
     /* TODO(fclem): try with GL_ANY_SAMPLES_PASSED​. */
     return GL_SAMPLES_PASSED;
   }
+  if (type == GPU_QUERY_TIMESTAMP) {
+    return GL_TIMESTAMP;
+  }
   BLI_assert(0);
   return GL_SAMPLES_PASSED;
 }
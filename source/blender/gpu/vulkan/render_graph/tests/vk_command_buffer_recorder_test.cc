@@ -0,0 +1,96 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: Apache-2.0 */
+
+#include "testing/testing.h"
+
+#include "render_graph/vk_command_buffer_recorder.hh"
+#include "vk_render_graph_test_types.hh"
+
+namespace blender::gpu::render_graph {
+
+static void replay_segments(const VKCommandBufferRecorder &recorder,
+                            Span<VKCommandBufferRecorder::Segment> segments,
+                            Vector<Vector<std::string>> &r_logs)
+{
+  for (const VKCommandBufferRecorder::Segment &segment : segments) {
+    Vector<std::string> &log = r_logs.append_as();
+    CommandBufferLog command_buffer(log);
+    command_buffer.begin_recording();
+    recorder.replay_segment(segment, command_buffer);
+    command_buffer.end_recording();
+  }
+}
+
+/**
+ * Segments after the first one should bind the pipeline and descriptor set that were bound at
+ * their first command.
+ */
+TEST(vk_command_buffer_recorder, segments_rebind_state)
+{
+  VkHandle<VkPipeline> pipeline(1u);
+  VkHandle<VkPipelineLayout> pipeline_layout(2u);
+  VkHandle<VkDescriptorSet> descriptor_set(3u);
+  VkHandle<VkBuffer> buffer(4u);
+
+  VKCommandBufferRecorder recorder(2);
+  recorder.begin_recording();
+  recorder.fill_buffer(buffer, 0, 1024, 42);
+  recorder.bind_pipeline(VK_PIPELINE_BIND_POINT_COMPUTE, pipeline);
+  VkDescriptorSet vk_descriptor_set = descriptor_set;
+  recorder.bind_descriptor_sets(
+      VK_PIPELINE_BIND_POINT_COMPUTE, pipeline_layout, 0, 1, &vk_descriptor_set, 0, nullptr);
+  recorder.dispatch(1, 1, 1);
+  recorder.dispatch(2, 1, 1);
+  recorder.dispatch(3, 1, 1);
+  EXPECT_EQ(6, recorder.commands_num());
+
+  Span<VKCommandBufferRecorder::Segment> segments = recorder.build_segments(3);
+  EXPECT_EQ(3, segments.size());
+
+  Vector<Vector<std::string>> logs;
+  replay_segments(recorder, segments, logs);
+  EXPECT_EQ(2, logs[0].size());
+  EXPECT_EQ("fill_buffer(dst_buffer=0x4, dst_offset=0, size=1024, data=42)", logs[0][0]);
+  EXPECT_EQ(3, logs[1].size());
+  EXPECT_EQ(4, logs[2].size());
+  EXPECT_EQ(0, logs[2][0].find("bind_pipeline("));
+  EXPECT_EQ(0, logs[2][1].find("bind_descriptor_sets("));
+  EXPECT_EQ("dispatch(group_count_x=2, group_count_y=1, group_count_z=1)", logs[2][2]);
+  EXPECT_EQ("dispatch(group_count_x=3, group_count_y=1, group_count_z=1)", logs[2][3]);
+
+  /* All commands end up in a single segment when only one is requested. */
+  segments = recorder.build_segments(1);
+  EXPECT_EQ(1, segments.size());
+  EXPECT_EQ(6, segments[0].commands.size());
+}
+
+/**
+ * Rendering scopes, including suspended ones, cannot be split between command buffers.
+ */
+TEST(vk_command_buffer_recorder, rendering_is_not_split)
+{
+  VkHandle<VkBuffer> buffer(1u);
+
+  VKCommandBufferRecorder recorder(1);
+  recorder.begin_recording();
+  VkRenderingInfo vk_rendering_info = {};
+  vk_rendering_info.sType = VK_STRUCTURE_TYPE_RENDERING_INFO;
+  vk_rendering_info.flags = VK_RENDERING_SUSPENDING_BIT;
+  recorder.begin_rendering(&vk_rendering_info);
+  recorder.draw(3, 1, 0, 0);
+  recorder.end_rendering();
+  recorder.fill_buffer(buffer, 0, 1024, 42);
+  vk_rendering_info.flags = VK_RENDERING_RESUMING_BIT;
+  recorder.begin_rendering(&vk_rendering_info);
+  recorder.draw(6, 1, 0, 0);
+  recorder.end_rendering();
+  recorder.fill_buffer(buffer, 0, 1024, 0);
+
+  Span<VKCommandBufferRecorder::Segment> segments = recorder.build_segments(8);
+  EXPECT_EQ(2, segments.size());
+  EXPECT_EQ(IndexRange(0, 7), segments[0].commands);
+  EXPECT_EQ(IndexRange(7, 1), segments[1].commands);
+}
+
+}  // namespace blender::gpu::render_graph
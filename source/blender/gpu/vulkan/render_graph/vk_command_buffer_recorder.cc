@@ -0,0 +1,550 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup gpu
+ */
+
+#include <algorithm>
+#include <optional>
+#include <string>
+
+#include "BLI_math_base.h"
+#include "BLI_task.hh"
+#include "BLI_threads.h"
+
+#include "vk_backend.hh"
+#include "vk_command_buffer_recorder.hh"
+#include "vk_memory.hh"
+
+namespace blender::gpu::render_graph {
+
+static int bind_point_index(VkPipelineBindPoint pipeline_bind_point)
+{
+  return pipeline_bind_point == VK_PIPELINE_BIND_POINT_COMPUTE ? 1 : 0;
+}
+
+VKCommandBufferRecorder::VKCommandBufferRecorder(int64_t min_segment_size)
+    : min_segment_size_(min_segment_size)
+{
+}
+
+VKCommandBufferRecorder::~VKCommandBufferRecorder()
+{
+  if (vk_fence_ != VK_NULL_HANDLE) {
+    VK_ALLOCATION_CALLBACKS;
+    VKDevice &device = VKBackend::get().device;
+    vkDestroyFence(device.vk_handle(), vk_fence_, vk_allocation_callbacks);
+    vk_fence_ = VK_NULL_HANDLE;
+  }
+}
+
+/* -------------------------------------------------------------------- */
+/** \name Recording and submission
+ * \{ */
+
+void VKCommandBufferRecorder::begin_recording()
+{
+  commands_.clear();
+  split_points_.clear();
+  segments_.clear();
+  bound_state_ = {};
+  is_rendering_ = false;
+  is_rendering_suspending_ = false;
+  active_queries_ = 0;
+}
+
+void VKCommandBufferRecorder::end_recording()
+{
+  BLI_assert_msg(!is_rendering_, "Recording ended inside a rendering scope.");
+  BLI_assert_msg(active_queries_ == 0, "Recording ended with active queries.");
+
+  const Span<Segment> segments = build_segments(BLI_system_thread_count());
+  while (command_buffers_.size() < segments.size()) {
+    command_buffers_.append(std::make_unique<VKCommandBufferWrapper>());
+  }
+  command_buffers_used_ = segments.size();
+
+  /* Each command buffer has its own command pool, so they can be recorded concurrently. */
+  threading::parallel_for(segments.index_range(), 1, [&](const IndexRange range) {
+    for (const int64_t segment_index : range) {
+      VKCommandBufferWrapper &command_buffer = *command_buffers_[segment_index];
+      command_buffer.begin_recording();
+      replay_segment(segments[segment_index], command_buffer);
+      command_buffer.end_recording();
+    }
+  });
+}
+
+void VKCommandBufferRecorder::submit_with_cpu_synchronization()
+{
+  VK_ALLOCATION_CALLBACKS;
+  VKDevice &device = VKBackend::get().device;
+  if (vk_fence_ == VK_NULL_HANDLE) {
+    VkFenceCreateInfo vk_fence_create_info = {};
+    vk_fence_create_info.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+    vkCreateFence(device.vk_handle(), &vk_fence_create_info, vk_allocation_callbacks, &vk_fence_);
+  }
+
+  Vector<VkCommandBuffer> vk_command_buffers;
+  for (const int64_t index : IndexRange(command_buffers_used_)) {
+    vk_command_buffers.append(command_buffers_[index]->vk_command_buffer());
+  }
+
+  /* A single batch keeps the submission order of the command buffers. */
+  VkSubmitInfo vk_submit_info = {};
+  vk_submit_info.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+  vk_submit_info.commandBufferCount = uint32_t(vk_command_buffers.size());
+  vk_submit_info.pCommandBuffers = vk_command_buffers.data();
+
+  vkResetFences(device.vk_handle(), 1, &vk_fence_);
+  vkQueueSubmit(device.queue_get(), 1, &vk_submit_info, vk_fence_);
+}
+
+void VKCommandBufferRecorder::wait_for_cpu_synchronization()
+{
+  VKDevice &device = VKBackend::get().device;
+  while (vkWaitForFences(device.vk_handle(), 1, &vk_fence_, true, UINT64_MAX) == VK_TIMEOUT) {
+  }
+}
+
+Span<VKCommandBufferRecorder::Segment> VKCommandBufferRecorder::build_segments(
+    int64_t max_segments)
+{
+  segments_.clear();
+  if (commands_.is_empty()) {
+    return segments_;
+  }
+
+  const int64_t split_points_num = split_points_.size();
+  const int64_t step = int64_t(
+      divide_ceil_ul(uint64_t(split_points_num), uint64_t(std::max<int64_t>(max_segments, 1))));
+  for (int64_t index = 0; index < split_points_num; index += step) {
+    Segment segment = split_points_[index];
+    const int64_t end = index + step < split_points_num ?
+                            split_points_[index + step].commands.start() :
+                            commands_.size();
+    segment.commands = IndexRange::from_begin_end(segment.commands.start(), end);
+    segments_.append(segment);
+  }
+  return segments_;
+}
+
+void VKCommandBufferRecorder::replay_segment(const Segment &segment,
+                                             VKCommandBufferInterface &command_buffer) const
+{
+  /* Pipelines must be bound before the descriptor sets that use their layout. */
+  const BoundState &bound_state = segment.bound_state;
+  for (const int64_t command_index : {bound_state.pipeline[0],
+                                      bound_state.pipeline[1],
+                                      bound_state.descriptor_sets[0],
+                                      bound_state.descriptor_sets[1],
+                                      bound_state.index_buffer,
+                                      bound_state.vertex_buffers})
+  {
+    if (command_index != -1) {
+      commands_[command_index](command_buffer);
+    }
+  }
+
+  for (const int64_t command_index : segment.commands) {
+    commands_[command_index](command_buffer);
+  }
+}
+
+int64_t VKCommandBufferRecorder::add_command(Command &&command)
+{
+  const int64_t command_index = commands_.size();
+  const bool can_split = !is_rendering_ && active_queries_ == 0;
+  if (split_points_.is_empty() ||
+      (can_split && command_index - split_points_.last().commands.start() >= min_segment_size_))
+  {
+    split_points_.append({IndexRange(command_index, 0), bound_state_});
+  }
+  commands_.append(std::move(command));
+  return command_index;
+}
+
+/** \} */
+
+/* -------------------------------------------------------------------- */
+/** \name Commands
+ * \{ */
+
+void VKCommandBufferRecorder::bind_pipeline(VkPipelineBindPoint pipeline_bind_point,
+                                            VkPipeline pipeline)
+{
+  bound_state_.pipeline[bind_point_index(pipeline_bind_point)] = add_command(
+      [=](VKCommandBufferInterface &command_buffer) {
+        command_buffer.bind_pipeline(pipeline_bind_point, pipeline);
+      });
+}
+
+void VKCommandBufferRecorder::bind_descriptor_sets(VkPipelineBindPoint pipeline_bind_point,
+                                                   VkPipelineLayout layout,
+                                                   uint32_t first_set,
+                                                   uint32_t descriptor_set_count,
+                                                   const VkDescriptorSet *p_descriptor_sets,
+                                                   uint32_t dynamic_offset_count,
+                                                   const uint32_t *p_dynamic_offsets)
+{
+  /* The command builder always binds all descriptor sets starting from the first one. */
+  BLI_assert(first_set == 0);
+  bound_state_.descriptor_sets[bind_point_index(pipeline_bind_point)] = add_command(
+      [=,
+       descriptor_sets = Vector<VkDescriptorSet>(Span(p_descriptor_sets, descriptor_set_count)),
+       dynamic_offsets = Vector<uint32_t>(Span(p_dynamic_offsets, dynamic_offset_count))](
+          VKCommandBufferInterface &command_buffer) {
+        command_buffer.bind_descriptor_sets(pipeline_bind_point,
+                                            layout,
+                                            first_set,
+                                            descriptor_set_count,
+                                            descriptor_sets.data(),
+                                            dynamic_offset_count,
+                                            dynamic_offsets.data());
+      });
+}
+
+void VKCommandBufferRecorder::bind_index_buffer(VkBuffer buffer,
+                                                VkDeviceSize offset,
+                                                VkIndexType index_type)
+{
+  bound_state_.index_buffer = add_command([=](VKCommandBufferInterface &command_buffer) {
+    command_buffer.bind_index_buffer(buffer, offset, index_type);
+  });
+}
+
+void VKCommandBufferRecorder::bind_vertex_buffers(uint32_t first_binding,
+                                                  uint32_t binding_count,
+                                                  const VkBuffer *p_buffers,
+                                                  const VkDeviceSize *p_offsets)
+{
+  /* The command builder always binds all vertex buffers at once. */
+  BLI_assert(first_binding == 0);
+  bound_state_.vertex_buffers = add_command(
+      [=,
+       buffers = Vector<VkBuffer>(Span(p_buffers, binding_count)),
+       offsets = Vector<VkDeviceSize>(Span(p_offsets, binding_count))](
+          VKCommandBufferInterface &command_buffer) {
+        command_buffer.bind_vertex_buffers(
+            first_binding, binding_count, buffers.data(), offsets.data());
+      });
+}
+
+void VKCommandBufferRecorder::draw(uint32_t vertex_count,
+                                   uint32_t instance_count,
+                                   uint32_t first_vertex,
+                                   uint32_t first_instance)
+{
+  add_command([=](VKCommandBufferInterface &command_buffer) {
+    command_buffer.draw(vertex_count, instance_count, first_vertex, first_instance);
+  });
+}
+
+void VKCommandBufferRecorder::draw_indexed(uint32_t index_count,
+                                           uint32_t instance_count,
+                                           uint32_t first_index,
+                                           int32_t vertex_offset,
+                                           uint32_t first_instance)
+{
+  add_command([=](VKCommandBufferInterface &command_buffer) {
+    command_buffer.draw_indexed(
+        index_count, instance_count, first_index, vertex_offset, first_instance);
+  });
+}
+
+void VKCommandBufferRecorder::draw_indirect(VkBuffer buffer,
+                                            VkDeviceSize offset,
+                                            uint32_t draw_count,
+                                            uint32_t stride)
+{
+  add_command([=](VKCommandBufferInterface &command_buffer) {
+    command_buffer.draw_indirect(buffer, offset, draw_count, stride);
+  });
+}
+
+void VKCommandBufferRecorder::draw_indexed_indirect(VkBuffer buffer,
+                                                    VkDeviceSize offset,
+                                                    uint32_t draw_count,
+                                                    uint32_t stride)
+{
+  add_command([=](VKCommandBufferInterface &command_buffer) {
+    command_buffer.draw_indexed_indirect(buffer, offset, draw_count, stride);
+  });
+}
+
+void VKCommandBufferRecorder::dispatch(uint32_t group_count_x,
+                                       uint32_t group_count_y,
+                                       uint32_t group_count_z)
+{
+  add_command([=](VKCommandBufferInterface &command_buffer) {
+    command_buffer.dispatch(group_count_x, group_count_y, group_count_z);
+  });
+}
+
+void VKCommandBufferRecorder::dispatch_indirect(VkBuffer buffer, VkDeviceSize offset)
+{
+  add_command([=](VKCommandBufferInterface &command_buffer) {
+    command_buffer.dispatch_indirect(buffer, offset);
+  });
+}
+
+void VKCommandBufferRecorder::copy_buffer(VkBuffer src_buffer,
+                                          VkBuffer dst_buffer,
+                                          uint32_t region_count,
+                                          const VkBufferCopy *p_regions)
+{
+  add_command([=, regions = Vector<VkBufferCopy>(Span(p_regions, region_count))](
+                  VKCommandBufferInterface &command_buffer) {
+    command_buffer.copy_buffer(src_buffer, dst_buffer, region_count, regions.data());
+  });
+}
+
+void VKCommandBufferRecorder::copy_image(VkImage src_image,
+                                         VkImageLayout src_image_layout,
+                                         VkImage dst_image,
+                                         VkImageLayout dst_image_layout,
+                                         uint32_t region_count,
+                                         const VkImageCopy *p_regions)
+{
+  add_command([=, regions = Vector<VkImageCopy>(Span(p_regions, region_count))](
+                  VKCommandBufferInterface &command_buffer) {
+    command_buffer.copy_image(
+        src_image, src_image_layout, dst_image, dst_image_layout, region_count, regions.data());
+  });
+}
+
+void VKCommandBufferRecorder::blit_image(VkImage src_image,
+                                         VkImageLayout src_image_layout,
+                                         VkImage dst_image,
+                                         VkImageLayout dst_image_layout,
+                                         uint32_t region_count,
+                                         const VkImageBlit *p_regions,
+                                         VkFilter filter)
+{
+  add_command([=, regions = Vector<VkImageBlit>(Span(p_regions, region_count))](
+                  VKCommandBufferInterface &command_buffer) {
+    command_buffer.blit_image(src_image,
+                              src_image_layout,
+                              dst_image,
+                              dst_image_layout,
+                              region_count,
+                              regions.data(),
+                              filter);
+  });
+}
+
+void VKCommandBufferRecorder::copy_buffer_to_image(VkBuffer src_buffer,
+                                                   VkImage dst_image,
+                                                   VkImageLayout dst_image_layout,
+                                                   uint32_t region_count,
+                                                   const VkBufferImageCopy *p_regions)
+{
+  add_command([=, regions = Vector<VkBufferImageCopy>(Span(p_regions, region_count))](
+                  VKCommandBufferInterface &command_buffer) {
+    command_buffer.copy_buffer_to_image(
+        src_buffer, dst_image, dst_image_layout, region_count, regions.data());
+  });
+}
+
+void VKCommandBufferRecorder::copy_image_to_buffer(VkImage src_image,
+                                                   VkImageLayout src_image_layout,
+                                                   VkBuffer dst_buffer,
+                                                   uint32_t region_count,
+                                                   const VkBufferImageCopy *p_regions)
+{
+  add_command([=, regions = Vector<VkBufferImageCopy>(Span(p_regions, region_count))](
+                  VKCommandBufferInterface &command_buffer) {
+    command_buffer.copy_image_to_buffer(
+        src_image, src_image_layout, dst_buffer, region_count, regions.data());
+  });
+}
+
+void VKCommandBufferRecorder::fill_buffer(VkBuffer dst_buffer,
+                                          VkDeviceSize dst_offset,
+                                          VkDeviceSize size,
+                                          uint32_t data)
+{
+  add_command([=](VKCommandBufferInterface &command_buffer) {
+    command_buffer.fill_buffer(dst_buffer, dst_offset, size, data);
+  });
+}
+
+void VKCommandBufferRecorder::clear_color_image(VkImage image,
+                                                VkImageLayout image_layout,
+                                                const VkClearColorValue *p_color,
+                                                uint32_t range_count,
+                                                const VkImageSubresourceRange *p_ranges)
+{
+  add_command([=,
+               color = *p_color,
+               ranges = Vector<VkImageSubresourceRange>(Span(p_ranges, range_count))](
+                  VKCommandBufferInterface &command_buffer) {
+    command_buffer.clear_color_image(image, image_layout, &color, range_count, ranges.data());
+  });
+}
+
+void VKCommandBufferRecorder::clear_depth_stencil_image(
+    VkImage image,
+    VkImageLayout image_layout,
+    const VkClearDepthStencilValue *p_depth_stencil,
+    uint32_t range_count,
+    const VkImageSubresourceRange *p_ranges)
+{
+  add_command([=,
+               depth_stencil = *p_depth_stencil,
+               ranges = Vector<VkImageSubresourceRange>(Span(p_ranges, range_count))](
+                  VKCommandBufferInterface &command_buffer) {
+    command_buffer.clear_depth_stencil_image(
+        image, image_layout, &depth_stencil, range_count, ranges.data());
+  });
+}
+
+void VKCommandBufferRecorder::clear_attachments(uint32_t attachment_count,
+                                                const VkClearAttachment *p_attachments,
+                                                uint32_t rect_count,
+                                                const VkClearRect *p_rects)
+{
+  add_command([=,
+               attachments = Vector<VkClearAttachment>(Span(p_attachments, attachment_count)),
+               rects = Vector<VkClearRect>(Span(p_rects, rect_count))](
+                  VKCommandBufferInterface &command_buffer) {
+    command_buffer.clear_attachments(
+        attachment_count, attachments.data(), rect_count, rects.data());
+  });
+}
+
+void VKCommandBufferRecorder::pipeline_barrier(
+    VkPipelineStageFlags src_stage_mask,
+    VkPipelineStageFlags dst_stage_mask,
+    VkDependencyFlags dependency_flags,
+    uint32_t memory_barrier_count,
+    const VkMemoryBarrier *p_memory_barriers,
+    uint32_t buffer_memory_barrier_count,
+    const VkBufferMemoryBarrier *p_buffer_memory_barriers,
+    uint32_t image_memory_barrier_count,
+    const VkImageMemoryBarrier *p_image_memory_barriers)
+{
+  add_command(
+      [=,
+       memory_barriers = Vector<VkMemoryBarrier>(Span(p_memory_barriers, memory_barrier_count)),
+       buffer_memory_barriers = Vector<VkBufferMemoryBarrier>(
+           Span(p_buffer_memory_barriers, buffer_memory_barrier_count)),
+       image_memory_barriers = Vector<VkImageMemoryBarrier>(
+           Span(p_image_memory_barriers, image_memory_barrier_count))](
+          VKCommandBufferInterface &command_buffer) {
+        command_buffer.pipeline_barrier(src_stage_mask,
+                                        dst_stage_mask,
+                                        dependency_flags,
+                                        memory_barrier_count,
+                                        memory_barriers.data(),
+                                        buffer_memory_barrier_count,
+                                        buffer_memory_barriers.data(),
+                                        image_memory_barrier_count,
+                                        image_memory_barriers.data());
+      });
+}
+
+void VKCommandBufferRecorder::push_constants(VkPipelineLayout layout,
+                                             VkShaderStageFlags stage_flags,
+                                             uint32_t offset,
+                                             uint32_t size,
+                                             const void *p_values)
+{
+  add_command([=,
+               values = Vector<uint8_t>(
+                   Span(static_cast<const uint8_t *>(p_values), int64_t(size)))](
+                  VKCommandBufferInterface &command_buffer) {
+    command_buffer.push_constants(layout, stage_flags, offset, size, values.data());
+  });
+}
+
+void VKCommandBufferRecorder::begin_query(VkQueryPool vk_query_pool,
+                                          uint32_t query_index,
+                                          VkQueryControlFlags vk_query_control_flags)
+{
+  add_command([=](VKCommandBufferInterface &command_buffer) {
+    command_buffer.begin_query(vk_query_pool, query_index, vk_query_control_flags);
+  });
+  active_queries_ += 1;
+}
+
+void VKCommandBufferRecorder::end_query(VkQueryPool vk_query_pool, uint32_t query_index)
+{
+  add_command([=](VKCommandBufferInterface &command_buffer) {
+    command_buffer.end_query(vk_query_pool, query_index);
+  });
+  BLI_assert(active_queries_ > 0);
+  active_queries_ -= 1;
+}
+
+void VKCommandBufferRecorder::reset_query_pool(VkQueryPool vk_query_pool,
+                                               uint32_t first_query,
+                                               uint32_t query_count)
+{
+  add_command([=](VKCommandBufferInterface &command_buffer) {
+    command_buffer.reset_query_pool(vk_query_pool, first_query, query_count);
+  });
+}
+
+void VKCommandBufferRecorder::begin_rendering(const VkRenderingInfo *p_rendering_info)
+{
+  BLI_assert_msg(p_rendering_info->pNext == nullptr,
+                 "Extension structures of VkRenderingInfo are not copied.");
+  Vector<VkRenderingAttachmentInfo> color_attachments(
+      Span(p_rendering_info->pColorAttachments, p_rendering_info->colorAttachmentCount));
+  std::optional<VkRenderingAttachmentInfo> depth_attachment;
+  if (p_rendering_info->pDepthAttachment) {
+    depth_attachment = *p_rendering_info->pDepthAttachment;
+  }
+  std::optional<VkRenderingAttachmentInfo> stencil_attachment;
+  if (p_rendering_info->pStencilAttachment) {
+    stencil_attachment = *p_rendering_info->pStencilAttachment;
+  }
+
+  add_command([rendering_info = *p_rendering_info,
+               color_attachments = std::move(color_attachments),
+               depth_attachment,
+               stencil_attachment](VKCommandBufferInterface &command_buffer) {
+    VkRenderingInfo vk_rendering_info = rendering_info;
+    vk_rendering_info.pColorAttachments = color_attachments.data();
+    vk_rendering_info.pDepthAttachment = depth_attachment ? &*depth_attachment : nullptr;
+    vk_rendering_info.pStencilAttachment = stencil_attachment ? &*stencil_attachment : nullptr;
+    command_buffer.begin_rendering(&vk_rendering_info);
+  });
+
+  is_rendering_ = true;
+  is_rendering_suspending_ = (p_rendering_info->flags & VK_RENDERING_SUSPENDING_BIT) != 0;
+}
+
+void VKCommandBufferRecorder::end_rendering()
+{
+  add_command(
+      [](VKCommandBufferInterface &command_buffer) { command_buffer.end_rendering(); });
+  /* A suspended rendering scope is resumed later on and cannot be split either. */
+  is_rendering_ = is_rendering_suspending_;
+}
+
+void VKCommandBufferRecorder::begin_debug_utils_label(
+    const VkDebugUtilsLabelEXT *vk_debug_utils_label)
+{
+  add_command([label = *vk_debug_utils_label,
+               label_name = std::string(vk_debug_utils_label->pLabelName)](
+                  VKCommandBufferInterface &command_buffer) {
+    VkDebugUtilsLabelEXT vk_label = label;
+    vk_label.pLabelName = label_name.c_str();
+    command_buffer.begin_debug_utils_label(&vk_label);
+  });
+}
+
+void VKCommandBufferRecorder::end_debug_utils_label()
+{
+  add_command([](VKCommandBufferInterface &command_buffer) {
+    command_buffer.end_debug_utils_label();
+  });
+}
+
+/** \} */
+
+}  // namespace blender::gpu::render_graph
@@ -0,0 +1,211 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup gpu
+ */
+
+#pragma once
+
+#include <functional>
+#include <memory>
+
+#include "BLI_index_range.hh"
+#include "BLI_vector.hh"
+
+#include "vk_command_buffer_wrapper.hh"
+
+namespace blender::gpu::render_graph {
+
+/**
+ * Command buffer that stores the commands of the command builder in memory and records them into
+ * multiple Vulkan command buffers in parallel when recording ends.
+ *
+ * The command builder itself still runs on the submitting thread as it tracks resource states and
+ * pipeline barriers in order. Encoding the commands into the Vulkan command buffers is what is
+ * done in parallel, which is where most of the CPU time of a large render graph goes.
+ *
+ * The commands are split into segments that are each recorded into their own primary command
+ * buffer. A segment can only start where no rendering scope (including suspended ones) and no
+ * query is active, as these cannot span command buffers. Bound pipelines, descriptor sets, index
+ * and vertex buffers are not inherited between command buffers; each segment starts by binding the
+ * state that was active at its first command.
+ *
+ * All command buffers are submitted in a single batch. The batch keeps submission order so the
+ * pipeline barriers recorded by the command builder remain valid across segment boundaries.
+ */
+class VKCommandBufferRecorder : public VKCommandBufferInterface {
+ public:
+  using Command = std::function<void(VKCommandBufferInterface &command_buffer)>;
+
+  /**
+   * Index of the commands that define the bound state. -1 when the state hasn't been bound.
+   * Pipelines and descriptor sets are stored per bind point (graphics, compute).
+   */
+  struct BoundState {
+    int64_t pipeline[2] = {-1, -1};
+    int64_t descriptor_sets[2] = {-1, -1};
+    int64_t index_buffer = -1;
+    int64_t vertex_buffers = -1;
+  };
+
+  struct Segment {
+    IndexRange commands;
+    BoundState bound_state;
+  };
+
+ private:
+  /** Minimum number of commands in a segment; smaller segments aren't worth a task. */
+  int64_t min_segment_size_;
+
+  Vector<Command> commands_;
+  /**
+   * Points where a segment can start, found during recording. Only the start of the command range
+   * is known at that time. The first split point is always at the first command.
+   */
+  Vector<Segment> split_points_;
+  Vector<Segment> segments_;
+
+  BoundState bound_state_;
+  bool is_rendering_ = false;
+  bool is_rendering_suspending_ = false;
+  int active_queries_ = 0;
+
+  Vector<std::unique_ptr<VKCommandBufferWrapper>> command_buffers_;
+  int64_t command_buffers_used_ = 0;
+  VkFence vk_fence_ = VK_NULL_HANDLE;
+
+ public:
+  VKCommandBufferRecorder(int64_t min_segment_size = 512);
+  virtual ~VKCommandBufferRecorder();
+
+  void begin_recording() override;
+  void end_recording() override;
+  void submit_with_cpu_synchronization() override;
+  void wait_for_cpu_synchronization() override;
+
+  /**
+   * Split the recorded commands into at most `max_segments` segments of roughly equal size.
+   * Only split points that were valid during recording are used.
+   */
+  Span<Segment> build_segments(int64_t max_segments);
+
+  /** Record the given segment, including the bindings it depends on, into `command_buffer`. */
+  void replay_segment(const Segment &segment, VKCommandBufferInterface &command_buffer) const;
+
+  int64_t commands_num() const
+  {
+    return commands_.size();
+  }
+
+  void bind_pipeline(VkPipelineBindPoint pipeline_bind_point, VkPipeline pipeline) override;
+  void bind_descriptor_sets(VkPipelineBindPoint pipeline_bind_point,
+                            VkPipelineLayout layout,
+                            uint32_t first_set,
+                            uint32_t descriptor_set_count,
+                            const VkDescriptorSet *p_descriptor_sets,
+                            uint32_t dynamic_offset_count,
+                            const uint32_t *p_dynamic_offsets) override;
+  void bind_index_buffer(VkBuffer buffer, VkDeviceSize offset, VkIndexType index_type) override;
+  void bind_vertex_buffers(uint32_t first_binding,
+                           uint32_t binding_count,
+                           const VkBuffer *p_buffers,
+                           const VkDeviceSize *p_offsets) override;
+  void draw(uint32_t vertex_count,
+            uint32_t instance_count,
+            uint32_t first_vertex,
+            uint32_t first_instance) override;
+  void draw_indexed(uint32_t index_count,
+                    uint32_t instance_count,
+                    uint32_t first_index,
+                    int32_t vertex_offset,
+                    uint32_t first_instance) override;
+  void draw_indirect(VkBuffer buffer,
+                     VkDeviceSize offset,
+                     uint32_t draw_count,
+                     uint32_t stride) override;
+  void draw_indexed_indirect(VkBuffer buffer,
+                             VkDeviceSize offset,
+                             uint32_t draw_count,
+                             uint32_t stride) override;
+  void dispatch(uint32_t group_count_x, uint32_t group_count_y, uint32_t group_count_z) override;
+  void dispatch_indirect(VkBuffer buffer, VkDeviceSize offset) override;
+  void copy_buffer(VkBuffer src_buffer,
+                   VkBuffer dst_buffer,
+                   uint32_t region_count,
+                   const VkBufferCopy *p_regions) override;
+  void copy_image(VkImage src_image,
+                  VkImageLayout src_image_layout,
+                  VkImage dst_image,
+                  VkImageLayout dst_image_layout,
+                  uint32_t region_count,
+                  const VkImageCopy *p_regions) override;
+  void blit_image(VkImage src_image,
+                  VkImageLayout src_image_layout,
+                  VkImage dst_image,
+                  VkImageLayout dst_image_layout,
+                  uint32_t region_count,
+                  const VkImageBlit *p_regions,
+                  VkFilter filter) override;
+  void copy_buffer_to_image(VkBuffer src_buffer,
+                            VkImage dst_image,
+                            VkImageLayout dst_image_layout,
+                            uint32_t region_count,
+                            const VkBufferImageCopy *p_regions) override;
+  void copy_image_to_buffer(VkImage src_image,
+                            VkImageLayout src_image_layout,
+                            VkBuffer dst_buffer,
+                            uint32_t region_count,
+                            const VkBufferImageCopy *p_regions) override;
+  void fill_buffer(VkBuffer dst_buffer,
+                   VkDeviceSize dst_offset,
+                   VkDeviceSize size,
+                   uint32_t data) override;
+  void clear_color_image(VkImage image,
+                         VkImageLayout image_layout,
+                         const VkClearColorValue *p_color,
+                         uint32_t range_count,
+                         const VkImageSubresourceRange *p_ranges) override;
+  void clear_depth_stencil_image(VkImage image,
+                                 VkImageLayout image_layout,
+                                 const VkClearDepthStencilValue *p_depth_stencil,
+                                 uint32_t range_count,
+                                 const VkImageSubresourceRange *p_ranges) override;
+  void clear_attachments(uint32_t attachment_count,
+                         const VkClearAttachment *p_attachments,
+                         uint32_t rect_count,
+                         const VkClearRect *p_rects) override;
+  void pipeline_barrier(VkPipelineStageFlags src_stage_mask,
+                        VkPipelineStageFlags dst_stage_mask,
+                        VkDependencyFlags dependency_flags,
+                        uint32_t memory_barrier_count,
+                        const VkMemoryBarrier *p_memory_barriers,
+                        uint32_t buffer_memory_barrier_count,
+                        const VkBufferMemoryBarrier *p_buffer_memory_barriers,
+                        uint32_t image_memory_barrier_count,
+                        const VkImageMemoryBarrier *p_image_memory_barriers) override;
+  void push_constants(VkPipelineLayout layout,
+                      VkShaderStageFlags stage_flags,
+                      uint32_t offset,
+                      uint32_t size,
+                      const void *p_values) override;
+  void begin_query(VkQueryPool vk_query_pool,
+                   uint32_t query_index,
+                   VkQueryControlFlags vk_query_control_flags) override;
+  void end_query(VkQueryPool vk_query_pool, uint32_t query_index) override;
+  void reset_query_pool(VkQueryPool, uint32_t first_query, uint32_t query_count) override;
+  void begin_rendering(const VkRenderingInfo *p_rendering_info) override;
+  void end_rendering() override;
+  void begin_debug_utils_label(const VkDebugUtilsLabelEXT *vk_debug_utils_label) override;
+  void end_debug_utils_label() override;
+
+ private:
+  /**
+   * Add a command. When the command starts at a point where the command buffer can be split, a
+   * new segment is started if the current one is large enough.
+   */
+  int64_t add_command(Command &&command);
+};
+
+}  // namespace blender::gpu::render_graph
@@ -70,10 +70,6 @@ void VKCommandBufferWrapper::begin_recording()
     vk_command_buffer_allocate_info_.commandPool = vk_command_pool_;
     vk_command_pool_create_info_.queueFamilyIndex = 0;
   }
-  if (vk_fence_ == VK_NULL_HANDLE) {
-    vkCreateFence(device.vk_handle(), &vk_fence_create_info_, vk_allocation_callbacks, &vk_fence_);
-  }
-
   if (vk_command_buffer_ == VK_NULL_HANDLE) {
     vkAllocateCommandBuffers(
         device.vk_handle(), &vk_command_buffer_allocate_info_, &vk_command_buffer_);
@@ -92,7 +88,13 @@ void VKCommandBufferWrapper::end_recording()
 
 void VKCommandBufferWrapper::submit_with_cpu_synchronization()
 {
+  VK_ALLOCATION_CALLBACKS;
   VKDevice &device = VKBackend::get().device;
+  /* Created on first submission, command buffers recorded by #VKCommandBufferRecorder are
+   * submitted by the recorder and don't need a fence. */
+  if (vk_fence_ == VK_NULL_HANDLE) {
+    vkCreateFence(device.vk_handle(), &vk_fence_create_info_, vk_allocation_callbacks, &vk_fence_);
+  }
   vkResetFences(device.vk_handle(), 1, &vk_fence_);
   vkQueueSubmit(device.queue_get(), 1, &vk_submit_info_, vk_fence_);
 }
@@ -151,6 +151,11 @@ class VKCommandBufferWrapper : public VKCommandBufferInterface {
   void submit_with_cpu_synchronization() override;
   void wait_for_cpu_synchronization() override;
 
+  VkCommandBuffer vk_command_buffer() const
+  {
+    return vk_command_buffer_;
+  }
+
   void bind_pipeline(VkPipelineBindPoint pipeline_bind_point, VkPipeline pipeline) override;
   void bind_descriptor_sets(VkPipelineBindPoint pipeline_bind_point,
                             VkPipelineLayout layout,
@@ -79,7 +79,8 @@ class VKRenderGraph : public NonCopyable {
   VKCommandBuilder command_builder_;
 
   /**
-   * Command buffer sends the commands to the device (`VKCommandBufferWrapper`).
+   * Command buffer sends the commands to the device (`VKCommandBufferRecorder`, which records
+   * the commands in parallel into multiple `VKCommandBufferWrapper`).
    *
    * To improve testability the command buffer can be replaced by an instance of
    * `VKCommandBufferLog` this way test cases don't need to create a fully working context in order
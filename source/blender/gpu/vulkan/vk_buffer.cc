@@ -108,10 +108,15 @@ void VKBuffer::update(const void *data) const
 }
 
 void VKBuffer::flush() const
+{
+  flush(0, max_ulul(size_in_bytes(), 1));
+}
+
+void VKBuffer::flush(VkDeviceSize offset, VkDeviceSize size) const
 {
   const VKDevice &device = VKBackend::get().device;
   VmaAllocator allocator = device.mem_allocator_get();
-  vmaFlushAllocation(allocator, allocation_, 0, max_ulul(size_in_bytes(), 1));
+  vmaFlushAllocation(allocator, allocation_, offset, size);
 }
 
 void VKBuffer::clear(VKContext &context, uint32_t clear_value)
@@ -38,6 +38,8 @@ class VKBuffer {
   void clear(VKContext &context, uint32_t clear_value);
   void update(const void *data) const;
   void flush() const;
+  /** Flush a range of the mapped memory so it becomes visible to the device. */
+  void flush(VkDeviceSize offset, VkDeviceSize size) const;
   void read(VKContext &context, void *data) const;
 
   /**
@@ -674,6 +674,8 @@ VkQueryType to_vk_query_type(const GPUQueryType query_type)
   switch (query_type) {
     case GPU_QUERY_OCCLUSION:
       return VK_QUERY_TYPE_OCCLUSION;
+    case GPU_QUERY_TIMESTAMP:
+      return VK_QUERY_TYPE_TIMESTAMP;
   }
   BLI_assert_unreachable();
   return VK_QUERY_TYPE_OCCLUSION;
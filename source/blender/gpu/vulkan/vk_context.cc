@@ -157,6 +157,11 @@ VKDescriptorPools &VKContext::descriptor_pools_get()
   return thread_data_.resource_pool_get().descriptor_pools;
 }
 
+VKStagingRing &VKContext::staging_ring_get()
+{
+  return thread_data_.staging_ring;
+}
+
 VKDescriptorSetTracker &VKContext::descriptor_set_get()
 {
   return thread_data_.resource_pool_get().descriptor_set;
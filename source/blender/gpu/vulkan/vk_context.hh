@@ -22,6 +22,7 @@ namespace blender::gpu {
 class VKFrameBuffer;
 class VKVertexAttributeObject;
 class VKBatch;
+class VKStagingRing;
 class VKStateManager;
 class VKShader;
 class VKThreadData;
@@ -98,6 +99,7 @@ class VKContext : public Context, NonCopyable {
   }
 
   VKDescriptorPools &descriptor_pools_get();
+  VKStagingRing &staging_ring_get();
   VKDescriptorSetTracker &descriptor_set_get();
   VKStateManager &state_manager_get() const;
 
@@ -8,6 +8,7 @@
 
 #include <sstream>
 
+#include "render_graph/vk_command_buffer_recorder.hh"
 #include "vk_backend.hh"
 #include "vk_context.hh"
 #include "vk_device.hh"
@@ -41,6 +42,9 @@ void VKDevice::deinit()
 
   dummy_buffer.free();
   samplers_.free();
+  for (VKThreadData *thread_data : thread_data_) {
+    thread_data->staging_ring.free();
+  }
 
   {
     while (!thread_data_.is_empty()) {
@@ -380,7 +384,7 @@ VKThreadData &VKDevice::current_thread_data()
   VKThreadData *thread_data = new VKThreadData(
       *this,
       current_thread_id,
-      std::make_unique<render_graph::VKCommandBufferWrapper>(),
+      std::make_unique<render_graph::VKCommandBufferRecorder>(),
       resources);
   thread_data_.append(thread_data);
   return *thread_data;
@@ -21,6 +21,7 @@
 #include "vk_pipeline_pool.hh"
 #include "vk_resource_pool.hh"
 #include "vk_samplers.hh"
+#include "vk_staging_ring.hh"
 
 namespace blender::gpu {
 class VKBackend;
@@ -71,6 +72,8 @@ class VKThreadData : public NonCopyable, NonMovable {
    */
   uint32_t resource_pool_index = UINT32_MAX;
   std::array<VKResourcePool, 5> resource_pools;
+  /** Host memory for uploads recorded in `render_graph`. */
+  VKStagingRing staging_ring;
 
   /**
    * The current rendering depth.
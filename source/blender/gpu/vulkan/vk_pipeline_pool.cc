@@ -684,28 +684,30 @@ struct VKPipelineCachePrefixHeader {
   }
 };
 
-static std::string pipeline_cache_filepath_get()
+static std::string pipeline_cache_filepath_get(const char *filename)
 {
   static char tmp_dir_buffer[1024];
   BKE_appdir_folder_caches(tmp_dir_buffer, sizeof(tmp_dir_buffer));
 
   std::string cache_dir = std::string(tmp_dir_buffer) + "vk-pipeline-cache" + SEP_STR;
   BLI_dir_create_recursive(cache_dir.c_str());
-  std::string cache_file = cache_dir + "static-shaders.bin";
+  std::string cache_file = cache_dir + filename;
   return cache_file;
 }
-#endif
 
-void VKPipelinePool::read_from_disk()
-{
-#ifdef WITH_BUILDINFO
-  /* Don't read the shader cache when GPU debugging is enabled. When enabled we use different
-   * shaders and compilation settings. Previous generated pipelines will not be used. */
-  if (bool(G.debug & G_DEBUG_GPU)) {
-    return;
-  }
+static const char *static_pipeline_cache_filename = "static-shaders.bin";
+static const char *non_static_pipeline_cache_filename = "material-shaders.bin";
+
+/**
+ * Pipelines of material shaders accumulate over sessions, as every opened project adds its own.
+ * When the cache grows beyond this size it is not written, so the next session starts with an
+ * empty cache and only stores the pipelines it uses.
+ */
+static const size_t non_static_pipeline_cache_max_size = 256 * 1024 * 1024;
 
-  std::string cache_file = pipeline_cache_filepath_get();
+static void pipeline_cache_read(VkPipelineCache vk_pipeline_cache_dst, const char *filename)
+{
+  std::string cache_file = pipeline_cache_filepath_get(filename);
   if (!BLI_exists(cache_file.c_str())) {
     return;
   }
@@ -715,6 +717,9 @@ void VKPipelinePool::read_from_disk()
   /* Read cached binary. */
   fstream file(cache_file, std::ios::binary | std::ios::in | std::ios::ate);
   std::streamsize data_size = file.tellg();
+  if (data_size < std::streamsize(sizeof(VKPipelineCachePrefixHeader))) {
+    return;
+  }
   file.seekg(0, std::ios::beg);
   void *buffer = MEM_mallocN(data_size, __func__);
   file.read(reinterpret_cast<char *>(buffer), data_size);
@@ -724,7 +729,9 @@ void VKPipelinePool::read_from_disk()
   VKPipelineCachePrefixHeader prefix;
   VKPipelineCachePrefixHeader &read_prefix = *static_cast<VKPipelineCachePrefixHeader *>(buffer);
   prefix.data_size = read_prefix.data_size;
-  if (memcmp(&read_prefix, &prefix, sizeof(VKPipelineCachePrefixHeader)) != 0) {
+  if (memcmp(&read_prefix, &prefix, sizeof(VKPipelineCachePrefixHeader)) != 0 ||
+      read_prefix.data_size + sizeof(VKPipelineCachePrefixHeader) > size_t(data_size))
+  {
     /* Headers are different, most likely the cache will not work and potentially crash the driver.
      * [https://medium.com/@zeuxcg/creating-a-robust-pipeline-cache-with-vulkan-961d09416cda]
      */
@@ -736,7 +743,7 @@ void VKPipelinePool::read_from_disk()
     return;
   }
 
-  CLOG_INFO(&LOG, 0, "Initialize static pipeline cache from disk [%s].", cache_file.c_str());
+  CLOG_INFO(&LOG, 0, "Initialize pipeline cache from disk [%s].", cache_file.c_str());
   VKDevice &device = VKBackend::get().device;
   VkPipelineCacheCreateInfo create_info = {};
   create_info.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
@@ -746,28 +753,32 @@ void VKPipelinePool::read_from_disk()
   vkCreatePipelineCache(device.vk_handle(), &create_info, nullptr, &vk_pipeline_cache);
   MEM_freeN(buffer);
 
-  vkMergePipelineCaches(device.vk_handle(), vk_pipeline_cache_static_, 1, &vk_pipeline_cache);
+  vkMergePipelineCaches(device.vk_handle(), vk_pipeline_cache_dst, 1, &vk_pipeline_cache);
   vkDestroyPipelineCache(device.vk_handle(), vk_pipeline_cache, nullptr);
-#endif
 }
 
-void VKPipelinePool::write_to_disk()
+static void pipeline_cache_write(VkPipelineCache vk_pipeline_cache,
+                                 const char *filename,
+                                 const size_t max_size)
 {
-#ifdef WITH_BUILDINFO
-  /* Don't write the pipeline cache when GPU debugging is enabled. When enabled we use different
-   * shaders and compilation settings. Writing them to disk will clutter the pipeline cache. */
-  if (bool(G.debug & G_DEBUG_GPU)) {
+  VKDevice &device = VKBackend::get().device;
+  size_t data_size;
+  vkGetPipelineCacheData(device.vk_handle(), vk_pipeline_cache, &data_size, nullptr);
+
+  std::string cache_file = pipeline_cache_filepath_get(filename);
+  if (data_size > max_size) {
+    CLOG_INFO(&LOG,
+              0,
+              "Pipeline cache exceeds its maximum size, removing it from disk [%s].",
+              cache_file.c_str());
+    BLI_delete(cache_file.c_str(), false, false);
     return;
   }
 
-  VKDevice &device = VKBackend::get().device;
-  size_t data_size;
-  vkGetPipelineCacheData(device.vk_handle(), vk_pipeline_cache_static_, &data_size, nullptr);
   void *buffer = MEM_mallocN(data_size, __func__);
-  vkGetPipelineCacheData(device.vk_handle(), vk_pipeline_cache_static_, &data_size, buffer);
+  vkGetPipelineCacheData(device.vk_handle(), vk_pipeline_cache, &data_size, buffer);
 
-  std::string cache_file = pipeline_cache_filepath_get();
-  CLOG_INFO(&LOG, 0, "Writing static pipeline cache to disk [%s].", cache_file.c_str());
+  CLOG_INFO(&LOG, 0, "Writing pipeline cache to disk [%s].", cache_file.c_str());
 
   fstream file(cache_file, std::ios::binary | std::ios::out);
 
@@ -777,6 +788,36 @@ void VKPipelinePool::write_to_disk()
   file.write(static_cast<char *>(buffer), data_size);
 
   MEM_freeN(buffer);
+}
+#endif
+
+void VKPipelinePool::read_from_disk()
+{
+#ifdef WITH_BUILDINFO
+  /* Don't read the shader cache when GPU debugging is enabled. When enabled we use different
+   * shaders and compilation settings. Previous generated pipelines will not be used. */
+  if (bool(G.debug & G_DEBUG_GPU)) {
+    return;
+  }
+
+  pipeline_cache_read(vk_pipeline_cache_static_, static_pipeline_cache_filename);
+  pipeline_cache_read(vk_pipeline_cache_non_static_, non_static_pipeline_cache_filename);
+#endif
+}
+
+void VKPipelinePool::write_to_disk()
+{
+#ifdef WITH_BUILDINFO
+  /* Don't write the pipeline cache when GPU debugging is enabled. When enabled we use different
+   * shaders and compilation settings. Writing them to disk will clutter the pipeline cache. */
+  if (bool(G.debug & G_DEBUG_GPU)) {
+    return;
+  }
+
+  pipeline_cache_write(vk_pipeline_cache_static_, static_pipeline_cache_filename, SIZE_MAX);
+  pipeline_cache_write(vk_pipeline_cache_non_static_,
+                       non_static_pipeline_cache_filename,
+                       non_static_pipeline_cache_max_size);
 #endif
 }
 
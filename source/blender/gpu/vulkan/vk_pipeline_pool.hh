@@ -319,7 +319,7 @@ class VKPipelinePool : public NonCopyable {
   void free_data();
 
   /**
-   * Read the static pipeline cache from cache file.
+   * Read the static and material pipeline caches from cache files.
    *
    * Pipeline caches requires blender to be build with `WITH_BUILDINFO` enabled . Between commits
    * shader modules can change and shader module identifiers cannot be used. We use the build info
@@ -335,7 +335,8 @@ class VKPipelinePool : public NonCopyable {
   void read_from_disk();
 
   /**
-   * Store the static pipeline cache to disk.
+   * Store the static and material pipeline caches to disk. The material pipeline cache is not
+   * stored when it grew too large, so it gets rebuilt with only the pipelines still in use.
    *
    * Pipeline caches requires blender to be build with `WITH_BUILDINFO` enabled . Between commits
    * shader modules can change and shader module identifiers cannot be used. We use the build info
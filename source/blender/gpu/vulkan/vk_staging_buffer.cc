@@ -14,6 +14,15 @@ namespace blender::gpu {
 VKStagingBuffer::VKStagingBuffer(const VKBuffer &device_buffer, Direction direction)
     : device_buffer_(device_buffer)
 {
+  if (direction == Direction::HostToDevice) {
+    VKContext &context = *VKContext::get();
+    ring_allocation_ = context.staging_ring_get().allocate(context.render_graph.submission_id,
+                                                           device_buffer.size_in_bytes());
+    if (ring_allocation_) {
+      return;
+    }
+  }
+
   VkBufferUsageFlags usage;
   switch (direction) {
     case Direction::HostToDevice:
@@ -27,11 +36,41 @@ VKStagingBuffer::VKStagingBuffer(const VKBuffer &device_buffer, Direction direct
   debug::object_label(host_buffer_.vk_handle(), "StagingBuffer");
 }
 
+void *VKStagingBuffer::mapped_memory_get() const
+{
+  if (ring_allocation_) {
+    return ring_allocation_.mapped_memory_get();
+  }
+  return host_buffer_.mapped_memory_get();
+}
+
+void VKStagingBuffer::update(const void *data) const
+{
+  memcpy(mapped_memory_get(), data, device_buffer_.size_in_bytes());
+  flush();
+}
+
+void VKStagingBuffer::flush() const
+{
+  if (ring_allocation_) {
+    ring_allocation_.buffer->flush(ring_allocation_.offset, ring_allocation_.size);
+  }
+  else {
+    host_buffer_.flush();
+  }
+}
+
 void VKStagingBuffer::copy_to_device(VKContext &context)
 {
-  BLI_assert(host_buffer_.is_allocated() && host_buffer_.is_mapped());
   render_graph::VKCopyBufferNode::CreateInfo copy_buffer = {};
-  copy_buffer.src_buffer = host_buffer_.vk_handle();
+  if (ring_allocation_) {
+    copy_buffer.src_buffer = ring_allocation_.buffer->vk_handle();
+    copy_buffer.region.srcOffset = ring_allocation_.offset;
+  }
+  else {
+    BLI_assert(host_buffer_.is_allocated() && host_buffer_.is_mapped());
+    copy_buffer.src_buffer = host_buffer_.vk_handle();
+  }
   copy_buffer.dst_buffer = device_buffer_.vk_handle();
   copy_buffer.region.size = device_buffer_.size_in_bytes();
 
@@ -51,7 +90,9 @@ void VKStagingBuffer::copy_from_device(VKContext &context)
 
 void VKStagingBuffer::free()
 {
-  host_buffer_.free();
+  if (host_buffer_.is_allocated()) {
+    host_buffer_.free();
+  }
 }
 
 }  // namespace blender::gpu
@@ -10,6 +10,7 @@
 
 #include "vk_buffer.hh"
 #include "vk_common.hh"
+#include "vk_staging_ring.hh"
 
 namespace blender::gpu {
 
@@ -17,6 +18,10 @@ namespace blender::gpu {
  * Utility class to copy data from host to device and vise versa.
  *
  * This is a common as buffers on device are more performant than when located inside host memory.
+ *
+ * Host to device transfers are sub-allocated from the staging ring of the active context. Only
+ * when the transfer doesn't fit in the ring, or when reading back, a dedicated host buffer is
+ * created.
  */
 class VKStagingBuffer {
  public:
@@ -42,9 +47,16 @@ class VKStagingBuffer {
 
   /**
    * The temporary buffer on host for the transfer. Also called the staging buffer.
+   *
+   * Only allocated when `ring_allocation_` isn't used.
    */
   VKBuffer host_buffer_;
 
+  /**
+   * Sub allocation inside the staging ring.
+   */
+  VKStagingRing::Allocation ring_allocation_;
+
  public:
   VKStagingBuffer(const VKBuffer &device_buffer, Direction direction);
 
@@ -59,10 +71,28 @@ class VKStagingBuffer {
   void copy_from_device(VKContext &context);
 
   /**
-   * Get the reference to the host buffer to update/load the data.
+   * Get the mapped host memory to update the data. The memory is as large as the device buffer.
+   */
+  void *mapped_memory_get() const;
+
+  /**
+   * Copy `data` into the host memory and make it visible to the device.
+   */
+  void update(const void *data) const;
+
+  /**
+   * Make changes to the memory returned by `mapped_memory_get` visible to the device.
+   */
+  void flush() const;
+
+  /**
+   * Get the reference to the host buffer to load the data.
+   *
+   * Only available for device to host transfers.
    */
   const VKBuffer &host_buffer_get() const
   {
+    BLI_assert(!ring_allocation_);
     return host_buffer_;
   }
 
@@ -0,0 +1,74 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup gpu
+ */
+
+#include <algorithm>
+
+#include "BLI_math_base.h"
+
+#include "vk_debug.hh"
+#include "vk_staging_ring.hh"
+
+namespace blender::gpu {
+
+/**
+ * Alignment of allocations. Covers `optimalBufferCopyOffsetAlignment` and texel sizes of all
+ * supported devices and formats.
+ */
+static constexpr VkDeviceSize allocation_alignment = 256;
+
+VKStagingRing::Allocation VKStagingRing::allocate(const VKSubmissionID &submission_id,
+                                                  VkDeviceSize size)
+{
+  if (size > max_allocation_size) {
+    return {};
+  }
+
+  if (submission_id_ != submission_id) {
+    reset();
+    submission_id_ = submission_id;
+  }
+
+  VkDeviceSize offset = ceil_to_multiple_ul(offset_, allocation_alignment);
+  if (offset + size > chunk_size && offset != 0) {
+    chunk_index_ += 1;
+    offset = 0;
+  }
+
+  if (chunk_index_ == chunks_.size()) {
+    std::unique_ptr<VKBuffer> chunk = std::make_unique<VKBuffer>();
+    if (!chunk->create(chunk_size, GPU_USAGE_STREAM, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, true)) {
+      return {};
+    }
+    debug::object_label(chunk->vk_handle(), "StagingRing");
+    chunks_.append(std::move(chunk));
+  }
+
+  offset_ = offset + size;
+  return {chunks_[chunk_index_].get(), offset, size};
+}
+
+void VKStagingRing::reset()
+{
+  /* Keep the chunks that were needed since the last reset, they will likely be needed again. */
+  const int64_t min_chunks_to_keep = 2;
+  const int64_t chunks_to_keep = std::max(chunk_index_ + 1, min_chunks_to_keep);
+  while (chunks_.size() > chunks_to_keep) {
+    chunks_.pop_last();
+  }
+  chunk_index_ = 0;
+  offset_ = 0;
+}
+
+void VKStagingRing::free()
+{
+  chunks_.clear();
+  chunk_index_ = 0;
+  offset_ = 0;
+}
+
+}  // namespace blender::gpu
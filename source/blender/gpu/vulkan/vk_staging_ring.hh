@@ -0,0 +1,88 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup gpu
+ */
+
+#pragma once
+
+#include <memory>
+
+#include "BLI_utility_mixins.hh"
+#include "BLI_vector.hh"
+
+#include "vk_buffer.hh"
+#include "vk_common.hh"
+#include "vk_resource_tracker.hh"
+
+namespace blender::gpu {
+
+/**
+ * Persistently mapped host memory used to upload data to the device.
+ *
+ * Allocating a staging buffer per upload results in thousands of small VMA allocations when
+ * loading a scene. Instead uploads are sub-allocated linearly from large host visible buffers
+ * (chunks) and the copy commands refer to their offset inside the chunk.
+ *
+ * The render graph waits until the device has finished all commands of a submission. When the
+ * submission id of the render graph has changed, all previous uploads have been completed and the
+ * chunks can be reused from the start.
+ *
+ * Each #VKThreadData owns a staging ring that should only be used together with the render graph
+ * of the same thread data.
+ */
+class VKStagingRing : public NonCopyable {
+ public:
+  /** Size of a single chunk. */
+  static constexpr VkDeviceSize chunk_size = 16 * 1024 * 1024;
+  /**
+   * Uploads larger than this use a dedicated staging buffer. Avoids large uploads wasting most of
+   * a chunk.
+   */
+  static constexpr VkDeviceSize max_allocation_size = chunk_size / 4;
+
+  struct Allocation {
+    /** Chunk containing the allocation, nullptr when the allocation failed. */
+    const VKBuffer *buffer = nullptr;
+    VkDeviceSize offset = 0;
+    VkDeviceSize size = 0;
+
+    void *mapped_memory_get() const
+    {
+      return static_cast<uint8_t *>(buffer->mapped_memory_get()) + offset;
+    }
+
+    operator bool() const
+    {
+      return buffer != nullptr;
+    }
+  };
+
+ private:
+  Vector<std::unique_ptr<VKBuffer>> chunks_;
+  /** Chunk and offset where the next allocation starts. */
+  int64_t chunk_index_ = 0;
+  VkDeviceSize offset_ = 0;
+  /** Submission id of the render graph when the first allocation since the last reset was made. */
+  VKSubmissionID submission_id_;
+
+ public:
+  /**
+   * Allocate `size` bytes of mapped host memory that can be used as source of a transfer
+   * command. The memory stays valid until the next submission of `submission_id` has finished.
+   *
+   * Returns an empty allocation when the size is too large to be sub-allocated.
+   */
+  Allocation allocate(const VKSubmissionID &submission_id, VkDeviceSize size);
+
+  /** Free all chunks. */
+  void free();
+
+ private:
+  /** Reuse all chunks from the start, releasing chunks that weren't needed recently. */
+  void reset();
+};
+
+}  // namespace blender::gpu
@@ -16,6 +16,7 @@
 #include "vk_pixel_buffer.hh"
 #include "vk_shader.hh"
 #include "vk_shader_interface.hh"
+#include "vk_staging_ring.hh"
 #include "vk_state_manager.hh"
 #include "vk_vertex_buffer.hh"
 
@@ -286,13 +287,28 @@ void VKTexture::update_sub(
     sample_len = device_memory_size / to_bytesize(device_format_);
   }
 
+  /* Small uploads are sub-allocated from the staging ring, larger ones get their own buffer. */
+  const VKStagingRing::Allocation ring_allocation = context.staging_ring_get().allocate(
+      context.render_graph.submission_id, device_memory_size);
   VKBuffer staging_buffer;
-  staging_buffer.create(device_memory_size, GPU_USAGE_DYNAMIC, VK_BUFFER_USAGE_TRANSFER_SRC_BIT);
-  convert_host_to_device(
-      staging_buffer.mapped_memory_get(), data, sample_len, format, format_, device_format_);
+  const VKBuffer *src_buffer = ring_allocation.buffer;
+  VkDeviceSize src_offset = ring_allocation.offset;
+  if (!ring_allocation) {
+    staging_buffer.create(device_memory_size, GPU_USAGE_DYNAMIC, VK_BUFFER_USAGE_TRANSFER_SRC_BIT);
+    src_buffer = &staging_buffer;
+    src_offset = 0;
+  }
+  convert_host_to_device(static_cast<uint8_t *>(src_buffer->mapped_memory_get()) + src_offset,
+                         data,
+                         sample_len,
+                         format,
+                         format_,
+                         device_format_);
+  src_buffer->flush(src_offset, device_memory_size);
 
   render_graph::VKCopyBufferToImageNode::CreateInfo copy_buffer_to_image = {};
-  copy_buffer_to_image.src_buffer = staging_buffer.vk_handle();
+  copy_buffer_to_image.src_buffer = src_buffer->vk_handle();
+  copy_buffer_to_image.region.bufferOffset = src_offset;
   copy_buffer_to_image.dst_image = vk_image_handle();
   copy_buffer_to_image.region.imageExtent.width = extent.x;
   copy_buffer_to_image.region.imageExtent.height = extent.y;
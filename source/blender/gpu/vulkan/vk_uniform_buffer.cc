@@ -26,7 +26,7 @@ void VKUniformBuffer::update(const void *data)
   }
   else {
     VKStagingBuffer staging_buffer(buffer_, VKStagingBuffer::Direction::HostToDevice);
-    staging_buffer.host_buffer_get().update(data);
+    staging_buffer.update(data);
     staging_buffer.copy_to_device(context);
   }
 }
@@ -137,25 +137,25 @@ void VKVertexBuffer::release_data()
   MEM_SAFE_FREE(data_);
 }
 
-void VKVertexBuffer::upload_data_direct(const VKBuffer &host_buffer)
+void VKVertexBuffer::upload_data_direct(void *host_memory)
 {
   device_format_ensure();
   if (vertex_format_converter.needs_conversion()) {
     if (G.debug & G_DEBUG_GPU) {
       std::cout << "PERFORMANCE: Vertex buffer requires conversion.\n";
     }
-    vertex_format_converter.convert(host_buffer.mapped_memory_get(), data_, vertex_len);
-    host_buffer.flush();
+    vertex_format_converter.convert(host_memory, data_, vertex_len);
   }
   else {
-    host_buffer.update(data_);
+    memcpy(host_memory, data_, buffer_.size_in_bytes());
   }
 }
 
 void VKVertexBuffer::upload_data_via_staging_buffer(VKContext &context)
 {
   VKStagingBuffer staging_buffer(buffer_, VKStagingBuffer::Direction::HostToDevice);
-  upload_data_direct(staging_buffer.host_buffer_get());
+  upload_data_direct(staging_buffer.mapped_memory_get());
+  staging_buffer.flush();
   staging_buffer.copy_to_device(context);
 }
 
@@ -171,7 +171,8 @@ void VKVertexBuffer::upload_data()
   if (flag & GPU_VERTBUF_DATA_DIRTY) {
     device_format_ensure();
     if (buffer_.is_mapped()) {
-      upload_data_direct(buffer_);
+      upload_data_direct(buffer_.mapped_memory_get());
+      buffer_.flush();
     }
     else {
       VKContext &context = *VKContext::get();
@@ -62,7 +62,8 @@ class VKVertexBuffer : public VertBuf, public VKBindableResource {
  private:
   void allocate();
 
-  void upload_data_direct(const VKBuffer &host_buffer);
+  /** Write the vertex data in device format to the given host visible memory. */
+  void upload_data_direct(void *host_memory);
   void upload_data_via_staging_buffer(VKContext &context);
 
   /* VKTexture requires access to `buffer_` to convert a vertex buffer to a texture. */
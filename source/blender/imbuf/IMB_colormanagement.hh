@@ -52,6 +52,7 @@ bool IMB_colormanagement_space_is_srgb(ColorSpace *colorspace);
 bool IMB_colormanagement_space_name_is_data(const char *name);
 bool IMB_colormanagement_space_name_is_scene_linear(const char *name);
 bool IMB_colormanagement_space_name_is_srgb(const char *name);
+ColorSpace *IMB_colormanagement_space_get_named(const char *name);
 
 BLI_INLINE void IMB_colormanagement_get_luminance_coefficients(float r_rgb[3]);
 
@@ -86,6 +86,21 @@ ImBuf *IMB_thumb_load_image(const char *filepath,
                             char colorspace[IM_MAX_SPACE],
                             IMBThumbLoadFlags load_flags = IMBThumbLoadFlags::Zero);
 
+/**
+ * Load an image at a reduced resolution, for previews that don't need the full resolution.
+ * Formats that support it decode at the lower resolution directly (JPEG DCT scaling, sub-sampled
+ * EXR reads, WebP scaling), other formats are loaded at full resolution.
+ *
+ * \param max_size: Approximate size of the largest dimension of the result.
+ * \param r_width, r_height: Size of the full resolution image.
+ */
+ImBuf *IMB_load_image_reduced(const char *filepath,
+                              int flags,
+                              size_t max_size,
+                              char colorspace[IM_MAX_SPACE],
+                              size_t *r_width,
+                              size_t *r_height);
+
 void IMB_freeImBuf(ImBuf *ibuf);
 
 ImBuf *IMB_allocImBuf(unsigned int x, unsigned int y, unsigned char planes, unsigned int flags);
@@ -316,6 +331,15 @@ IndexBuildContext *IMB_anim_index_rebuild_context(ImBufAnim *anim,
                                                   GSet *file_list,
                                                   bool build_only_on_bad_performance);
 
+/**
+ * Prepare context for building the seek index of the movie, which maps frames to the key frame
+ * decoding has to start from. Only packets are read, so this is much faster than building
+ * time-codes or proxies. Returns null when the index already exists and \a overwrite is false.
+ *
+ * Use #IMB_anim_index_rebuild and #IMB_anim_index_rebuild_finish to build the index.
+ */
+IndexBuildContext *IMB_anim_seek_index_rebuild_context(ImBufAnim *anim, bool overwrite);
+
 /**
  * Will rebuild all used indices and proxies at once.
  */
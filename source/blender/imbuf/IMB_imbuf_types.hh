@@ -112,6 +112,8 @@ enum eImBufFlags {
   IB_thumbnail = 1 << 16,
   IB_multiview = 1 << 17,
   IB_halffloat = 1 << 18,
+  /** Decode movies using the GPU video decoder when available. */
+  IB_animhwdecode = 1 << 19,
 };
 
 /** \} */
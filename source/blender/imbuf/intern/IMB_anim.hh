@@ -47,8 +47,16 @@ struct ImBufAnim {
   AVFrame *pFrameRGB;
   AVFrame *pFrameDeinterlaced;
   SwsContext *img_convert_ctx;
+  /** Pixel format (#AVPixelFormat) of the frames converted by #img_convert_ctx. */
+  int img_convert_src_fmt;
   int videoStream;
 
+  /** Pixel format (#AVPixelFormat) of frames decoded by the hardware, -1 without hardware
+   * decoding. */
+  int hw_pix_fmt;
+  /** Hardware decoded frame downloaded to system memory. */
+  AVFrame *pFrame_hw_download;
+
   AVFrame *pFrame;
   bool pFrame_complete;
   AVFrame *pFrame_backup;
@@ -69,9 +77,16 @@ struct ImBufAnim {
   ImBufAnim *proxy_anim[IMB_PROXY_MAX_SLOT];
   ImBufAnimIndex *record_run;
   ImBufAnimIndex *no_gaps;
+  ImBufAnimIndex *seek_index;
+  bool seek_index_tried;
 
   char colorspace[64];
   char suffix[64]; /* MAX_NAME - multiview */
 
   IDProperty *metadata;
 };
+
+#ifdef WITH_FFMPEG
+/** Release the hardware decoding devices shared by all movies. */
+void imb_anim_hw_device_exit();
+#endif
@@ -90,6 +90,8 @@ uint64_t IMB_indexer_get_seek_pos_pts(ImBufAnimIndex *idx, int frame_index);
 uint64_t IMB_indexer_get_seek_pos_dts(ImBufAnimIndex *idx, int frame_index);
 
 int IMB_indexer_get_frame_index(ImBufAnimIndex *idx, int frameno);
+/** Index of the first frame that is not displayed before \a pts. */
+int IMB_indexer_get_frame_index_from_pts(ImBufAnimIndex *idx, uint64_t pts);
 uint64_t IMB_indexer_get_pts(ImBufAnimIndex *idx, int frame_index);
 int IMB_indexer_get_duration(ImBufAnimIndex *idx);
 
@@ -101,6 +103,12 @@ void IMB_free_indices(ImBufAnim *anim);
 
 ImBufAnim *IMB_anim_open_proxy(ImBufAnim *anim, IMB_Proxy_Size preview_size);
 ImBufAnimIndex *IMB_anim_open_index(ImBufAnim *anim, IMB_Timecode_Type tc);
+/**
+ * Open the seek index built from the packets of the movie, or null when it wasn't built.
+ * Unlike time-code indices, it doesn't change frame numbers and is only used to find the key
+ * frame decoding has to start from.
+ */
+ImBufAnimIndex *IMB_anim_open_seek_index(ImBufAnim *anim);
 
 int IMB_proxy_size_to_array_index(IMB_Proxy_Size pr_size);
 int IMB_timecode_to_array_index(IMB_Timecode_Type tc);
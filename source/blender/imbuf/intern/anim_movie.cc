@@ -11,6 +11,7 @@
 #include <cmath>
 #include <cstdio>
 #include <cstdlib>
+#include <mutex>
 #include <sys/types.h>
 #ifndef _WIN32
 #  include <dirent.h>
@@ -18,6 +19,7 @@
 #  include <io.h>
 #endif
 
+#include "BLI_index_range.hh"
 #include "BLI_math_base.hh"
 #include "BLI_path_util.h"
 #include "BLI_string.h"
@@ -45,6 +47,7 @@ extern "C" {
 #  include <libavcodec/avcodec.h>
 #  include <libavformat/avformat.h>
 #  include <libavutil/cpu.h>
+#  include <libavutil/hwcontext.h>
 #  include <libavutil/imgutils.h>
 #  include <libavutil/rational.h>
 #  include <libswscale/swscale.h>
@@ -235,6 +238,182 @@ static int ffmpeg_frame_count_get(AVFormatContext *pFormatCtx, AVStream *video_s
   return 0;
 }
 
+/**
+ * (Re)create the context converting frames of the given pixel format to RGBA.
+ * Returns false on failure.
+ */
+static bool ffmpeg_sws_context_create(ImBufAnim *anim, const AVPixelFormat src_fmt)
+{
+  /* The following for color space determination */
+  int srcRange, dstRange, brightness, contrast, saturation;
+  int *table;
+  const int *inv_table;
+
+  if (anim->img_convert_ctx) {
+    BKE_ffmpeg_sws_release_context(anim->img_convert_ctx);
+  }
+  anim->img_convert_ctx = BKE_ffmpeg_sws_get_context(anim->x,
+                                                     anim->y,
+                                                     src_fmt,
+                                                     AV_PIX_FMT_RGBA,
+                                                     SWS_BILINEAR | SWS_PRINT_INFO |
+                                                         SWS_FULL_CHR_H_INT);
+  if (!anim->img_convert_ctx) {
+    return false;
+  }
+  anim->img_convert_src_fmt = src_fmt;
+
+  /* Try do detect if input has 0-255 YCbCR range (JFIF, JPEG, Motion-JPEG). */
+  if (!sws_getColorspaceDetails(anim->img_convert_ctx,
+                                (int **)&inv_table,
+                                &srcRange,
+                                &table,
+                                &dstRange,
+                                &brightness,
+                                &contrast,
+                                &saturation))
+  {
+    srcRange = srcRange || anim->pCodecCtx->color_range == AVCOL_RANGE_JPEG;
+    inv_table = sws_getCoefficients(anim->pCodecCtx->colorspace);
+
+    if (sws_setColorspaceDetails(anim->img_convert_ctx,
+                                 (int *)inv_table,
+                                 srcRange,
+                                 table,
+                                 dstRange,
+                                 brightness,
+                                 contrast,
+                                 saturation))
+    {
+      fprintf(stderr, "Warning: Could not set libswscale colorspace details.\n");
+    }
+  }
+  else {
+    fprintf(stderr, "Warning: Could not set libswscale colorspace details.\n");
+  }
+
+  return true;
+}
+
+/* -------------------------------------------------------------------- */
+/** \name Hardware Accelerated Decoding
+ *
+ * Decoding is done by the video decoder of the GPU and the frames are downloaded to system memory
+ * to be converted to RGBA like software decoded frames. The devices are shared by all movies, as
+ * creating one per strip is slow and some drivers limit the number of devices.
+ * \{ */
+
+/** Device types to try, in order of preference. */
+static const AVHWDeviceType hw_device_types[] = {
+#  if defined(__APPLE__)
+    AV_HWDEVICE_TYPE_VIDEOTOOLBOX,
+#  elif defined(_WIN32)
+    AV_HWDEVICE_TYPE_D3D11VA,
+    AV_HWDEVICE_TYPE_CUDA,
+#  else
+    AV_HWDEVICE_TYPE_CUDA,
+    AV_HWDEVICE_TYPE_VAAPI,
+#  endif
+};
+
+static std::mutex hw_device_mutex;
+/** Shared devices, indexed like #hw_device_types. A failed creation is not retried. */
+static AVBufferRef *hw_devices[ARRAY_SIZE(hw_device_types)] = {nullptr};
+static bool hw_devices_tried[ARRAY_SIZE(hw_device_types)] = {false};
+
+/** Returns a new reference to the shared device, nullptr if it can't be created. */
+static AVBufferRef *ffmpeg_hw_device_get(const int device_index)
+{
+  std::scoped_lock lock(hw_device_mutex);
+  if (!hw_devices_tried[device_index]) {
+    hw_devices_tried[device_index] = true;
+    if (av_hwdevice_ctx_create(
+            &hw_devices[device_index], hw_device_types[device_index], nullptr, nullptr, 0) < 0)
+    {
+      hw_devices[device_index] = nullptr;
+    }
+  }
+  return hw_devices[device_index] ? av_buffer_ref(hw_devices[device_index]) : nullptr;
+}
+
+void imb_anim_hw_device_exit()
+{
+  std::scoped_lock lock(hw_device_mutex);
+  for (const int i : blender::IndexRange(ARRAY_SIZE(hw_device_types))) {
+    av_buffer_unref(&hw_devices[i]);
+    hw_devices_tried[i] = false;
+  }
+}
+
+static AVPixelFormat ffmpeg_hw_decode_get_format(AVCodecContext *codec_ctx,
+                                                 const AVPixelFormat *pix_fmts)
+{
+  const ImBufAnim *anim = static_cast<const ImBufAnim *>(codec_ctx->opaque);
+  for (const AVPixelFormat *pix_fmt = pix_fmts; *pix_fmt != AV_PIX_FMT_NONE; pix_fmt++) {
+    if (*pix_fmt == anim->hw_pix_fmt) {
+      return *pix_fmt;
+    }
+  }
+  /* The stream is not supported by the hardware decoder (e.g. its profile or bit depth),
+   * fall back to software decoding. */
+  return avcodec_default_get_format(codec_ctx, pix_fmts);
+}
+
+/**
+ * Setup the codec context to decode on the GPU, before opening it.
+ * Returns false if no hardware decoder is available for the codec.
+ */
+static bool ffmpeg_hw_decode_init(ImBufAnim *anim, AVCodecContext *codec_ctx, const AVCodec *codec)
+{
+  for (const int device_index : blender::IndexRange(ARRAY_SIZE(hw_device_types))) {
+    for (int i = 0;; i++) {
+      const AVCodecHWConfig *config = avcodec_get_hw_config(codec, i);
+      if (config == nullptr) {
+        break;
+      }
+      if (config->device_type != hw_device_types[device_index] ||
+          (config->methods & AV_CODEC_HW_CONFIG_METHOD_HW_DEVICE_CTX) == 0)
+      {
+        continue;
+      }
+      AVBufferRef *device = ffmpeg_hw_device_get(device_index);
+      if (device == nullptr) {
+        break;
+      }
+      /* The codec context takes ownership of the reference. */
+      codec_ctx->hw_device_ctx = device;
+      codec_ctx->opaque = anim;
+      codec_ctx->get_format = ffmpeg_hw_decode_get_format;
+      anim->hw_pix_fmt = config->pix_fmt;
+      av_log(anim->pFormatCtx,
+             AV_LOG_INFO,
+             "Using %s hardware decoding\n",
+             av_hwdevice_get_type_name(hw_device_types[device_index]));
+      return true;
+    }
+  }
+  return false;
+}
+
+/**
+ * Download the frame to system memory if it was decoded by the hardware.
+ * Returns the frame to convert to RGBA, nullptr on failure.
+ */
+static AVFrame *ffmpeg_hw_decode_download(ImBufAnim *anim, AVFrame *input)
+{
+  if (input->format != anim->hw_pix_fmt) {
+    return input;
+  }
+  av_frame_unref(anim->pFrame_hw_download);
+  if (av_hwframe_transfer_data(anim->pFrame_hw_download, input, 0) < 0) {
+    fprintf(stderr, "ffmpeg_fetchibuf: failed to download hardware decoded frame\n");
+    return nullptr;
+  }
+  return anim->pFrame_hw_download;
+}
+
+/** \} */
+
 static int startffmpeg(ImBufAnim *anim)
 {
   const AVCodec *pCodec;
@@ -246,11 +425,6 @@ static int startffmpeg(ImBufAnim *anim)
   double frs_den;
   int streamcount;
 
-  /* The following for color space determination */
-  int srcRange, dstRange, brightness, contrast, saturation;
-  int *table;
-  const int *inv_table;
-
   if (anim == nullptr) {
     return (-1);
   }
@@ -300,14 +474,27 @@ static int startffmpeg(ImBufAnim *anim)
   avcodec_parameters_to_context(pCodecCtx, video_stream->codecpar);
   pCodecCtx->workaround_bugs = FF_BUG_AUTODETECT;
 
-  if (pCodec->capabilities & AV_CODEC_CAP_OTHER_THREADS) {
+  anim->hw_pix_fmt = -1;
+  /* Deinterlacing works on the decoder pixel format, which hardware decoding changes. */
+  const bool use_hw_decode = (anim->ib_flags & IB_animhwdecode) &&
+                             (anim->ib_flags & IB_animdeinterlace) == 0 &&
+                             ffmpeg_hw_decode_init(anim, pCodecCtx, pCodec);
+
+  if (use_hw_decode) {
+    /* Decoding is done by the GPU, threads only add latency and memory usage. */
+    pCodecCtx->thread_count = 1;
+  }
+  else if (pCodec->capabilities & AV_CODEC_CAP_OTHER_THREADS) {
     pCodecCtx->thread_count = 0;
   }
   else {
     pCodecCtx->thread_count = BLI_system_thread_count();
   }
 
-  if (pCodec->capabilities & AV_CODEC_CAP_FRAME_THREADS) {
+  if (use_hw_decode) {
+    /* Pass. */
+  }
+  else if (pCodec->capabilities & AV_CODEC_CAP_FRAME_THREADS) {
     pCodecCtx->thread_type = FF_THREAD_FRAME;
   }
   else if (pCodec->capabilities & AV_CODEC_CAP_SLICE_THREADS) {
@@ -362,6 +549,9 @@ static int startffmpeg(ImBufAnim *anim)
   anim->pFrame_complete = false;
   anim->pFrameDeinterlaced = av_frame_alloc();
   anim->pFrameRGB = av_frame_alloc();
+  if (use_hw_decode) {
+    anim->pFrame_hw_download = av_frame_alloc();
+  }
   anim->pFrameRGB->format = AV_PIX_FMT_RGBA;
   anim->pFrameRGB->width = anim->x;
   anim->pFrameRGB->height = anim->y;
@@ -381,6 +571,7 @@ static int startffmpeg(ImBufAnim *anim)
     av_frame_free(&anim->pFrameDeinterlaced);
     av_frame_free(&anim->pFrame);
     av_frame_free(&anim->pFrame_backup);
+    av_frame_free(&anim->pFrame_hw_download);
     anim->pCodecCtx = nullptr;
     return -1;
   }
@@ -394,6 +585,7 @@ static int startffmpeg(ImBufAnim *anim)
     av_frame_free(&anim->pFrameDeinterlaced);
     av_frame_free(&anim->pFrame);
     av_frame_free(&anim->pFrame_backup);
+    av_frame_free(&anim->pFrame_hw_download);
     anim->pCodecCtx = nullptr;
     return -1;
   }
@@ -415,14 +607,8 @@ static int startffmpeg(ImBufAnim *anim)
         1);
   }
 
-  anim->img_convert_ctx = BKE_ffmpeg_sws_get_context(anim->x,
-                                                     anim->y,
-                                                     anim->pCodecCtx->pix_fmt,
-                                                     AV_PIX_FMT_RGBA,
-                                                     SWS_BILINEAR | SWS_PRINT_INFO |
-                                                         SWS_FULL_CHR_H_INT);
-
-  if (!anim->img_convert_ctx) {
+  anim->img_convert_ctx = nullptr;
+  if (!ffmpeg_sws_context_create(anim, anim->pCodecCtx->pix_fmt)) {
     fprintf(stderr, "Can't transform color space??? Bailing out...\n");
     avcodec_free_context(&anim->pCodecCtx);
     avformat_close_input(&anim->pFormatCtx);
@@ -431,39 +617,11 @@ static int startffmpeg(ImBufAnim *anim)
     av_frame_free(&anim->pFrameDeinterlaced);
     av_frame_free(&anim->pFrame);
     av_frame_free(&anim->pFrame_backup);
+    av_frame_free(&anim->pFrame_hw_download);
     anim->pCodecCtx = nullptr;
     return -1;
   }
 
-  /* Try do detect if input has 0-255 YCbCR range (JFIF, JPEG, Motion-JPEG). */
-  if (!sws_getColorspaceDetails(anim->img_convert_ctx,
-                                (int **)&inv_table,
-                                &srcRange,
-                                &table,
-                                &dstRange,
-                                &brightness,
-                                &contrast,
-                                &saturation))
-  {
-    srcRange = srcRange || anim->pCodecCtx->color_range == AVCOL_RANGE_JPEG;
-    inv_table = sws_getCoefficients(anim->pCodecCtx->colorspace);
-
-    if (sws_setColorspaceDetails(anim->img_convert_ctx,
-                                 (int *)inv_table,
-                                 srcRange,
-                                 table,
-                                 dstRange,
-                                 brightness,
-                                 contrast,
-                                 saturation))
-    {
-      fprintf(stderr, "Warning: Could not set libswscale colorspace details.\n");
-    }
-  }
-  else {
-    fprintf(stderr, "Warning: Could not set libswscale colorspace details.\n");
-  }
-
   return 0;
 }
 
@@ -541,6 +699,19 @@ static void ffmpeg_postprocess(ImBufAnim *anim, AVFrame *input, ImBuf *ibuf)
     return;
   }
 
+  input = ffmpeg_hw_decode_download(anim, input);
+  if (input == nullptr) {
+    return;
+  }
+  /* Downloaded frames use the native format of the hardware decoder (e.g. NV12), which differs
+   * from the software decoder format. */
+  if (input->format != anim->img_convert_src_fmt &&
+      !ffmpeg_sws_context_create(anim, AVPixelFormat(input->format)))
+  {
+    fprintf(stderr, "ffmpeg_fetchibuf: can't transform color space\n");
+    return;
+  }
+
   av_log(anim->pFormatCtx,
          AV_LOG_DEBUG,
          "  POSTPROC: AVFrame planes: %p %p %p %p\n",
@@ -997,21 +1168,33 @@ static int ffmpeg_seek_to_key_frame(ImBufAnim *anim,
   int64_t seek_pos;
   int ret;
 
-  if (tc_index) {
+  /* Without time-codes, the seek index still tells which key frame decoding has to start from. */
+  ImBufAnimIndex *seek_index = tc_index ? tc_index : IMB_anim_open_seek_index(anim);
+
+  if (seek_index) {
     /* We can use timestamps generated from our indexer to seek. */
-    int new_frame_index = IMB_indexer_get_frame_index(tc_index, position);
-    int old_frame_index = IMB_indexer_get_frame_index(tc_index, anim->cur_position);
+    int new_frame_index;
+    int old_frame_index;
+    if (tc_index) {
+      new_frame_index = IMB_indexer_get_frame_index(tc_index, position);
+      old_frame_index = IMB_indexer_get_frame_index(tc_index, anim->cur_position);
+    }
+    else {
+      new_frame_index = IMB_indexer_get_frame_index_from_pts(seek_index, pts_to_search);
+      old_frame_index = IMB_indexer_get_frame_index_from_pts(
+          seek_index, ffmpeg_get_pts_to_search(anim, nullptr, anim->cur_position));
+    }
 
-    if (IMB_indexer_can_scan(tc_index, old_frame_index, new_frame_index)) {
+    if (IMB_indexer_can_scan(seek_index, old_frame_index, new_frame_index)) {
       /* No need to seek, return early. */
       return 0;
     }
     uint64_t pts;
     uint64_t dts;
 
-    seek_pos = IMB_indexer_get_seek_pos(tc_index, new_frame_index);
-    pts = IMB_indexer_get_seek_pos_pts(tc_index, new_frame_index);
-    dts = IMB_indexer_get_seek_pos_dts(tc_index, new_frame_index);
+    seek_pos = IMB_indexer_get_seek_pos(seek_index, new_frame_index);
+    pts = IMB_indexer_get_seek_pos_pts(seek_index, new_frame_index);
+    dts = IMB_indexer_get_seek_pos_dts(seek_index, new_frame_index);
 
     anim->cur_key_frame_pts = timestamp_from_pts_or_dts(pts, dts);
 
@@ -1182,7 +1365,10 @@ static void free_anim_ffmpeg(ImBufAnim *anim)
       MEM_freeN(anim->pFrameDeinterlaced->data[0]);
     }
     av_frame_free(&anim->pFrameDeinterlaced);
-    BKE_ffmpeg_sws_release_context(anim->img_convert_ctx);
+    av_frame_free(&anim->pFrame_hw_download);
+    if (anim->img_convert_ctx) {
+      BKE_ffmpeg_sws_release_context(anim->img_convert_ctx);
+    }
   }
   anim->duration_in_frames = 0;
 }
@@ -11,6 +11,8 @@
 
 #include <cmath>
 #include <cstring>
+#include <mutex>
+#include <string>
 
 #include "DNA_color_types.h"
 #include "DNA_image_types.h"
@@ -29,9 +31,12 @@
 #include "MEM_guardedalloc.h"
 
 #include "BLI_blenlib.h"
+#include "BLI_hash.hh"
+#include "BLI_map.hh"
 #include "BLI_math_color.h"
 #include "BLI_math_color.hh"
 #include "BLI_rect.h"
+#include "BLI_simd.hh"
 #include "BLI_string.h"
 #include "BLI_task.h"
 #include "BLI_task.hh"
@@ -122,6 +127,89 @@ static struct global_color_picking_state {
 
 /** \} */
 
+/* -------------------------------------------------------------------- */
+/** \name CPU Processor Cache
+ *
+ * Creating and optimizing an OCIO processor is expensive compared to applying it to a small
+ * buffer, while the same few transforms are requested for every drawn image, sequencer strip and
+ * render tile. Processors are cached by a description of their transform, every user gets its own
+ * handle to the shared processor.
+ * \{ */
+
+/** Maximum number of cached processors, to bound memory while tweaking e.g. the exposure. */
+#define CPU_PROCESSOR_CACHE_MAX_SIZE 64
+
+struct CPUProcessorKey {
+  std::string from_colorspace;
+  /** Target color space, or the view transform for display processors. */
+  std::string to_colorspace;
+  std::string display;
+  std::string look;
+  float exposure = 0.0f;
+  float gamma = 1.0f;
+  float temperature = 0.0f;
+  float tint = 0.0f;
+  bool use_white_balance = false;
+
+  uint64_t hash() const
+  {
+    return blender::get_default_hash(
+        blender::get_default_hash(from_colorspace, to_colorspace, display, look),
+        blender::get_default_hash(exposure, gamma, temperature, tint),
+        use_white_balance);
+  }
+
+  friend bool operator==(const CPUProcessorKey &a, const CPUProcessorKey &b)
+  {
+    return a.from_colorspace == b.from_colorspace && a.to_colorspace == b.to_colorspace &&
+           a.display == b.display && a.look == b.look && a.exposure == b.exposure &&
+           a.gamma == b.gamma && a.temperature == b.temperature && a.tint == b.tint &&
+           a.use_white_balance == b.use_white_balance;
+  }
+};
+
+/** Processors that failed to be created are cached as null, to not retry them every time. */
+static blender::Map<CPUProcessorKey, OCIO_ConstCPUProcessorRcPtr *> cpu_processor_cache;
+static std::mutex cpu_processor_cache_mutex;
+
+static void cpu_processor_cache_clear()
+{
+  std::lock_guard lock(cpu_processor_cache_mutex);
+  for (OCIO_ConstCPUProcessorRcPtr *cpu_processor : cpu_processor_cache.values()) {
+    if (cpu_processor) {
+      OCIO_cpuProcessorRelease(cpu_processor);
+    }
+  }
+  cpu_processor_cache.clear();
+}
+
+/**
+ * Get a new handle to the processor for the transform described by `key`, calling `create_fn`
+ * when it isn't cached yet. The handle must be released with #OCIO_cpuProcessorRelease.
+ */
+template<typename CreateFn>
+static OCIO_ConstCPUProcessorRcPtr *cpu_processor_cache_get(const CPUProcessorKey &key,
+                                                            const CreateFn &create_fn)
+{
+  std::lock_guard lock(cpu_processor_cache_mutex);
+  OCIO_ConstCPUProcessorRcPtr **cached = cpu_processor_cache.lookup_ptr(key);
+  if (cached == nullptr) {
+    if (cpu_processor_cache.size() >= CPU_PROCESSOR_CACHE_MAX_SIZE) {
+      /* Other users hold their own handles, so releasing the cached ones is safe. */
+      for (OCIO_ConstCPUProcessorRcPtr *cpu_processor : cpu_processor_cache.values()) {
+        if (cpu_processor) {
+          OCIO_cpuProcessorRelease(cpu_processor);
+        }
+      }
+      cpu_processor_cache.clear();
+    }
+    cached = &cpu_processor_cache.lookup_or_add(key, create_fn());
+  }
+  return *cached ? OCIO_cpuProcessorCopy(*cached) : nullptr;
+}
+
+/** \} */
+
 /* -------------------------------------------------------------------- */
 /** \name Color Managed Cache
  * \{ */
@@ -613,6 +701,8 @@ static void colormanage_free_config()
   ColorSpace *colorspace;
   ColorManagedDisplay *display;
 
+  cpu_processor_cache_clear();
+
   /* free color spaces */
   colorspace = static_cast<ColorSpace *>(global_colorspaces.first);
   while (colorspace) {
@@ -894,33 +984,47 @@ static OCIO_ConstCPUProcessorRcPtr *create_display_buffer_processor(const char *
                                                                     const bool use_white_balance,
                                                                     const char *from_colorspace)
 {
-  OCIO_ConstConfigRcPtr *config = OCIO_getCurrentConfig();
   const bool use_look = colormanage_use_look(look, view_transform);
-  const float scale = (exposure == 0.0f) ? 1.0f : powf(2.0f, exposure);
-  const float exponent = (gamma == 1.0f) ? 1.0f : 1.0f / max_ff(FLT_EPSILON, gamma);
 
-  OCIO_ConstProcessorRcPtr *processor = OCIO_createDisplayProcessor(config,
-                                                                    from_colorspace,
-                                                                    view_transform,
-                                                                    display,
-                                                                    (use_look) ? look : "",
-                                                                    scale,
-                                                                    exponent,
-                                                                    temperature,
-                                                                    tint,
-                                                                    use_white_balance,
-                                                                    false);
+  CPUProcessorKey key;
+  key.from_colorspace = from_colorspace;
+  key.to_colorspace = view_transform;
+  key.display = display;
+  key.look = use_look ? look : "";
+  key.exposure = exposure;
+  key.gamma = gamma;
+  key.temperature = temperature;
+  key.tint = tint;
+  key.use_white_balance = use_white_balance;
+
+  return cpu_processor_cache_get(key, [&]() -> OCIO_ConstCPUProcessorRcPtr * {
+    OCIO_ConstConfigRcPtr *config = OCIO_getCurrentConfig();
+    const float scale = (exposure == 0.0f) ? 1.0f : powf(2.0f, exposure);
+    const float exponent = (gamma == 1.0f) ? 1.0f : 1.0f / max_ff(FLT_EPSILON, gamma);
+
+    OCIO_ConstProcessorRcPtr *processor = OCIO_createDisplayProcessor(config,
+                                                                      from_colorspace,
+                                                                      view_transform,
+                                                                      display,
+                                                                      (use_look) ? look : "",
+                                                                      scale,
+                                                                      exponent,
+                                                                      temperature,
+                                                                      tint,
+                                                                      use_white_balance,
+                                                                      false);
 
-  OCIO_configRelease(config);
+    OCIO_configRelease(config);
 
-  if (processor == nullptr) {
-    return nullptr;
-  }
+    if (processor == nullptr) {
+      return nullptr;
+    }
 
-  OCIO_ConstCPUProcessorRcPtr *cpu_processor = OCIO_processorGetCPUProcessor(processor);
-  OCIO_processorRelease(processor);
+    OCIO_ConstCPUProcessorRcPtr *cpu_processor = OCIO_processorGetCPUProcessor(processor);
+    OCIO_processorRelease(processor);
 
-  return cpu_processor;
+    return cpu_processor;
+  });
 }
 
 static OCIO_ConstProcessorRcPtr *create_colorspace_transform_processor(const char *from_colorspace,
@@ -1108,6 +1212,58 @@ static void curve_mapping_apply_pixel(const CurveMapping *curve_mapping,
   }
 }
 
+/** Convert RGBA byte pixels to float, with the same result as #rgba_uchar_to_float. */
+static void rgba_uchar_to_float_n(float *dst, const uchar *src, const int64_t pixels_num)
+{
+  int64_t i = 0;
+#if BLI_HAVE_SSE2
+  const __m128i zero = _mm_setzero_si128();
+  const __m128 scale = _mm_set1_ps(1.0f / 255.0f);
+  for (; i + 4 <= pixels_num; i += 4) {
+    const __m128i rgba8 = _mm_loadu_si128((const __m128i *)(src + i * 4));
+    const __m128i rgba16_lo = _mm_unpacklo_epi8(rgba8, zero);
+    const __m128i rgba16_hi = _mm_unpackhi_epi8(rgba8, zero);
+    float *pixel = dst + i * 4;
+    _mm_storeu_ps(pixel, _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(rgba16_lo, zero)), scale));
+    _mm_storeu_ps(pixel + 4,
+                  _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(rgba16_lo, zero)), scale));
+    _mm_storeu_ps(pixel + 8,
+                  _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(rgba16_hi, zero)), scale));
+    _mm_storeu_ps(pixel + 12,
+                  _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(rgba16_hi, zero)), scale));
+  }
+#endif
+  for (; i < pixels_num; i++) {
+    rgba_uchar_to_float(dst + i * 4, src + i * 4);
+  }
+}
+
+/** Convert RGBA float pixels to bytes, with the same result as #rgba_float_to_uchar. */
+static void rgba_float_to_uchar_n(uchar *dst, const float *src, const int64_t pixels_num)
+{
+  int64_t i = 0;
+#if BLI_HAVE_SSE2
+  const __m128 zero = _mm_setzero_ps();
+  const __m128 one = _mm_set1_ps(1.0f);
+  const __m128 scale = _mm_set1_ps(255.0f);
+  const __m128 half = _mm_set1_ps(0.5f);
+  for (; i + 4 <= pixels_num; i += 4) {
+    __m128i rgba32[4];
+    for (int j = 0; j < 4; j++) {
+      __m128 rgba = _mm_loadu_ps(src + (i + j) * 4);
+      rgba = _mm_min_ps(_mm_max_ps(rgba, zero), one);
+      rgba32[j] = _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(rgba, scale), half));
+    }
+    const __m128i rgba16_lo = _mm_packs_epi32(rgba32[0], rgba32[1]);
+    const __m128i rgba16_hi = _mm_packs_epi32(rgba32[2], rgba32[3]);
+    _mm_storeu_si128((__m128i *)(dst + i * 4), _mm_packus_epi16(rgba16_lo, rgba16_hi));
+  }
+#endif
+  for (; i < pixels_num; i++) {
+    rgba_float_to_uchar(dst + i * 4, src + i * 4);
+  }
+}
+
 void colorspace_set_default_role(char *colorspace, int size, int role)
 {
   if (colorspace && colorspace[0] == '\0') {
@@ -1510,6 +1666,11 @@ bool IMB_colormanagement_space_name_is_srgb(const char *name)
   return (colorspace && IMB_colormanagement_space_is_srgb(colorspace));
 }
 
+ColorSpace *IMB_colormanagement_space_get_named(const char *name)
+{
+  return colormanage_colorspace_get_named(name);
+}
+
 blender::float3x3 IMB_colormanagement_get_xyz_to_scene_linear()
 {
   return blender::float3x3(imbuf_xyz_to_scene_linear);
@@ -1660,18 +1821,18 @@ static void display_buffer_apply_get_linear_buffer(DisplayBufferThread *handle,
     size_t i;
 
     /* first convert byte buffer to float, keep in image space */
-    for (i = 0, fp = linear_buffer, cp = byte_buffer; i != i_last;
-         i++, fp += channels, cp += channels)
-    {
-      if (channels == 3) {
+    if (channels == 4) {
+      rgba_uchar_to_float_n(linear_buffer, byte_buffer, i_last);
+    }
+    else if (channels == 3) {
+      for (i = 0, fp = linear_buffer, cp = byte_buffer; i != i_last;
+           i++, fp += channels, cp += channels)
+      {
         rgb_uchar_to_float(fp, cp);
       }
-      else if (channels == 4) {
-        rgba_uchar_to_float(fp, cp);
-      }
-      else {
-        BLI_assert_msg(0, "Buffers of 3 or 4 channels are only supported here");
-      }
+    }
+    else {
+      BLI_assert_msg(0, "Buffers of 3 or 4 channels are only supported here");
     }
 
     if (!is_data && !is_data_display) {
@@ -4043,12 +4204,20 @@ ColormanageProcessor *IMB_colormanagement_colorspace_processor_new(const char *f
   cm_processor = MEM_cnew<ColormanageProcessor>("colormanagement processor");
   cm_processor->is_data_result = IMB_colormanagement_space_name_is_data(to_colorspace);
 
-  OCIO_ConstProcessorRcPtr *processor = create_colorspace_transform_processor(from_colorspace,
-                                                                              to_colorspace);
-  if (processor != nullptr) {
-    cm_processor->cpu_processor = OCIO_processorGetCPUProcessor(processor);
-  }
-  OCIO_processorRelease(processor);
+  CPUProcessorKey key;
+  key.from_colorspace = from_colorspace;
+  key.to_colorspace = to_colorspace;
+  cm_processor->cpu_processor = cpu_processor_cache_get(
+      key, [&]() -> OCIO_ConstCPUProcessorRcPtr * {
+        OCIO_ConstProcessorRcPtr *processor = create_colorspace_transform_processor(
+            from_colorspace, to_colorspace);
+        if (processor == nullptr) {
+          return nullptr;
+        }
+        OCIO_ConstCPUProcessorRcPtr *cpu_processor = OCIO_processorGetCPUProcessor(processor);
+        OCIO_processorRelease(processor);
+        return cpu_processor;
+      });
 
   return cm_processor;
 }
@@ -4133,12 +4302,12 @@ void IMB_colormanagement_processor_apply_pixel(ColormanageProcessor *cm_processo
   }
 }
 
-void IMB_colormanagement_processor_apply(ColormanageProcessor *cm_processor,
-                                         float *buffer,
-                                         int width,
-                                         int height,
-                                         int channels,
-                                         bool predivide)
+static void processor_apply_rows(ColormanageProcessor *cm_processor,
+                                 float *buffer,
+                                 int width,
+                                 int height,
+                                 int channels,
+                                 bool predivide)
 {
   /* apply curve mapping */
   if (cm_processor->curve_mapping) {
@@ -4176,22 +4345,55 @@ void IMB_colormanagement_processor_apply(ColormanageProcessor *cm_processor,
   }
 }
 
+/** Number of pixels processed by one task when applying a processor to a buffer. */
+#define PROCESSOR_APPLY_GRAIN_PIXELS (64 * 1024)
+
+static int processor_apply_grain_rows(const int width)
+{
+  return std::max(1, PROCESSOR_APPLY_GRAIN_PIXELS / std::max(width, 1));
+}
+
+void IMB_colormanagement_processor_apply(ColormanageProcessor *cm_processor,
+                                         float *buffer,
+                                         int width,
+                                         int height,
+                                         int channels,
+                                         bool predivide)
+{
+  using namespace blender;
+  /* Large buffers like full renders are split into horizontal strips processed in parallel. */
+  threading::parallel_for(
+      IndexRange(height), processor_apply_grain_rows(width), [&](const IndexRange rows) {
+        processor_apply_rows(cm_processor,
+                             buffer + size_t(channels) * width * rows.first(),
+                             width,
+                             rows.size(),
+                             channels,
+                             predivide);
+      });
+}
+
 void IMB_colormanagement_processor_apply_byte(
     ColormanageProcessor *cm_processor, uchar *buffer, int width, int height, int channels)
 {
+  using namespace blender;
   /* TODO(sergey): Would be nice to support arbitrary channels configurations,
    * but for now it's not so important.
    */
   BLI_assert(channels == 4);
-  float pixel[4];
-  for (int y = 0; y < height; y++) {
-    for (int x = 0; x < width; x++) {
-      size_t offset = channels * (size_t(y) * width + x);
-      rgba_uchar_to_float(pixel, buffer + offset);
-      IMB_colormanagement_processor_apply_v4(cm_processor, pixel);
-      rgba_float_to_uchar(buffer + offset, pixel);
-    }
-  }
+  /* Convert strips of rows to float and apply the processor to the whole strip at once, instead
+   * of calling the processor for every pixel. */
+  threading::parallel_for(
+      IndexRange(height), processor_apply_grain_rows(width), [&](const IndexRange rows) {
+        const int64_t pixels_num = int64_t(width) * rows.size();
+        uchar *rows_buffer = buffer + size_t(channels) * width * rows.first();
+        float *float_buffer = static_cast<float *>(
+            MEM_mallocN(sizeof(float[4]) * pixels_num, "color conversion float buffer"));
+        rgba_uchar_to_float_n(float_buffer, rows_buffer, pixels_num);
+        processor_apply_rows(cm_processor, float_buffer, width, rows.size(), channels, false);
+        rgba_float_to_uchar_n(rows_buffer, float_buffer, pixels_num);
+        MEM_freeN(float_buffer);
+      });
 }
 
 void IMB_colormanagement_processor_free(ColormanageProcessor *cm_processor)
@@ -6,6 +6,7 @@
  * \ingroup imbuf
  */
 
+#include <algorithm>
 #include <cstdlib>
 
 #include "MEM_guardedalloc.h"
@@ -22,6 +23,7 @@
 #include "BLI_threads.h"
 #include "BLI_time.h"
 #include "BLI_utildefines.h"
+#include "BLI_vector.hh"
 
 #ifdef _WIN32
 #  include "BLI_winstuff.h"
@@ -259,6 +261,23 @@ uint64_t IMB_indexer_get_seek_pos_dts(ImBufAnimIndex *idx, int frame_index)
   return idx->entries[frame_index].seek_pos_dts;
 }
 
+int IMB_indexer_get_frame_index_from_pts(ImBufAnimIndex *idx, uint64_t pts)
+{
+  /* Time-stamps are signed, even though they are stored unsigned. */
+  const anim_index_entry *entries = idx->entries;
+  const anim_index_entry *entries_end = entries + idx->num_entries;
+  const anim_index_entry *entry = std::lower_bound(
+      entries, entries_end, int64_t(pts), [](const anim_index_entry &entry, const int64_t pts) {
+        return int64_t(entry.pts) < pts;
+      });
+
+  if (entry == entries_end) {
+    return idx->num_entries - 1;
+  }
+
+  return int(entry - entries);
+}
+
 int IMB_indexer_get_frame_index(ImBufAnimIndex *idx, int frameno)
 {
   int len = idx->num_entries;
@@ -441,6 +460,25 @@ static void get_tc_filepath(ImBufAnim *anim, IMB_Timecode_Type tc, char *filepat
   BLI_path_join(filepath, FILE_MAXFILE + FILE_MAXDIR, index_dir, index_name);
 }
 
+static void get_seek_index_filepath(ImBufAnim *anim, char *filepath)
+{
+  char index_dir[FILE_MAXDIR];
+  char stream_suffix[20];
+  char index_name[256];
+
+  stream_suffix[0] = 0;
+
+  if (anim->streamindex > 0) {
+    SNPRINTF(stream_suffix, "_st%d", anim->streamindex);
+  }
+
+  SNPRINTF(index_name, "seek%s%s.blen_tc", stream_suffix, anim->suffix);
+
+  get_index_dir(anim, index_dir, sizeof(index_dir));
+
+  BLI_path_join(filepath, FILE_MAXFILE + FILE_MAXDIR, index_dir, index_name);
+}
+
 /* ----------------------------------------------------------------------
  * - common rebuilder structures
  * ---------------------------------------------------------------------- */
@@ -786,6 +824,8 @@ struct FFmpegIndexBuilderContext : public IndexBuildContext {
 
   proxy_output_ctx *proxy_ctx[IMB_PROXY_MAX_SLOT];
   anim_index_builder *indexer[IMB_TC_NUM_TYPES];
+  /** Only build the seek index from packets, nothing is decoded. */
+  anim_index_builder *seek_indexer;
 
   int tcs_in_use;
   int proxy_sizes_in_use;
@@ -806,41 +846,23 @@ struct FFmpegIndexBuilderContext : public IndexBuildContext {
   bool building_cancelled;
 };
 
-static IndexBuildContext *index_ffmpeg_create_context(ImBufAnim *anim,
-                                                      int tcs_in_use,
-                                                      int proxy_sizes_in_use,
-                                                      int quality,
-                                                      bool build_only_on_bad_performance)
+/* Open the movie and find its video stream, closes the movie on failure. */
+static bool index_ffmpeg_open_video_stream(FFmpegIndexBuilderContext *context, ImBufAnim *anim)
 {
-  FFmpegIndexBuilderContext *context = MEM_cnew<FFmpegIndexBuilderContext>(
-      "FFmpeg index builder context");
-  int num_proxy_sizes = IMB_PROXY_MAX_SLOT;
-  int i, streamcount;
-
-  context->tcs_in_use = tcs_in_use;
-  context->proxy_sizes_in_use = proxy_sizes_in_use;
-  context->num_proxy_sizes = IMB_PROXY_MAX_SLOT;
-  context->build_only_on_bad_performance = build_only_on_bad_performance;
-
-  memset(context->proxy_ctx, 0, sizeof(context->proxy_ctx));
-  memset(context->indexer, 0, sizeof(context->indexer));
-
   if (avformat_open_input(&context->iFormatCtx, anim->filepath, nullptr, nullptr) != 0) {
-    MEM_freeN(context);
-    return nullptr;
+    return false;
   }
 
   if (avformat_find_stream_info(context->iFormatCtx, nullptr) < 0) {
     avformat_close_input(&context->iFormatCtx);
-    MEM_freeN(context);
-    return nullptr;
+    return false;
   }
 
-  streamcount = anim->streamindex;
+  int streamcount = anim->streamindex;
 
   /* Find the video stream */
   context->videoStream = -1;
-  for (i = 0; i < context->iFormatCtx->nb_streams; i++) {
+  for (int i = 0; i < context->iFormatCtx->nb_streams; i++) {
     if (context->iFormatCtx->streams[i]->codecpar->codec_type == AVMEDIA_TYPE_VIDEO) {
       if (streamcount > 0) {
         streamcount--;
@@ -853,11 +875,58 @@ static IndexBuildContext *index_ffmpeg_create_context(ImBufAnim *anim,
 
   if (context->videoStream == -1) {
     avformat_close_input(&context->iFormatCtx);
+    return false;
+  }
+
+  context->iStream = context->iFormatCtx->streams[context->videoStream];
+  return true;
+}
+
+static IndexBuildContext *index_ffmpeg_create_seek_index_context(ImBufAnim *anim)
+{
+  FFmpegIndexBuilderContext *context = MEM_cnew<FFmpegIndexBuilderContext>(
+      "FFmpeg seek index builder context");
+
+  if (!index_ffmpeg_open_video_stream(context, anim)) {
     MEM_freeN(context);
     return nullptr;
   }
 
-  context->iStream = context->iFormatCtx->streams[context->videoStream];
+  char filepath[FILE_MAX];
+  get_seek_index_filepath(anim, filepath);
+  context->seek_indexer = IMB_index_builder_create(filepath);
+  if (!context->seek_indexer) {
+    avformat_close_input(&context->iFormatCtx);
+    MEM_freeN(context);
+    return nullptr;
+  }
+
+  return (IndexBuildContext *)context;
+}
+
+static IndexBuildContext *index_ffmpeg_create_context(ImBufAnim *anim,
+                                                      int tcs_in_use,
+                                                      int proxy_sizes_in_use,
+                                                      int quality,
+                                                      bool build_only_on_bad_performance)
+{
+  FFmpegIndexBuilderContext *context = MEM_cnew<FFmpegIndexBuilderContext>(
+      "FFmpeg index builder context");
+  int num_proxy_sizes = IMB_PROXY_MAX_SLOT;
+  int i;
+
+  context->tcs_in_use = tcs_in_use;
+  context->proxy_sizes_in_use = proxy_sizes_in_use;
+  context->num_proxy_sizes = IMB_PROXY_MAX_SLOT;
+  context->build_only_on_bad_performance = build_only_on_bad_performance;
+
+  memset(context->proxy_ctx, 0, sizeof(context->proxy_ctx));
+  memset(context->indexer, 0, sizeof(context->indexer));
+
+  if (!index_ffmpeg_open_video_stream(context, anim)) {
+    MEM_freeN(context);
+    return nullptr;
+  }
 
   context->iCodec = avcodec_find_decoder(context->iStream->codecpar->codec_id);
 
@@ -949,6 +1018,10 @@ static void index_rebuild_ffmpeg_finish(FFmpegIndexBuilderContext *context, cons
     }
   }
 
+  if (context->seek_indexer) {
+    IMB_index_builder_finish(context->seek_indexer, do_rollback);
+  }
+
   avcodec_free_context(&context->iCodecCtx);
   avformat_close_input(&context->iFormatCtx);
 
@@ -1102,6 +1175,101 @@ static int index_rebuild_ffmpeg(FFmpegIndexBuilderContext *context,
   return 1;
 }
 
+/**
+ * Build the seek index from the packets of the video stream. This only reads the file, so it is
+ * much faster than building time-codes, which decodes every frame.
+ *
+ * Every frame gets an entry with the key frame decoding has to start from. Frames in an open GOP
+ * that are displayed before their key frame depend on the previous key frame.
+ */
+static int index_rebuild_ffmpeg_packets(FFmpegIndexBuilderContext *context,
+                                        const bool *stop,
+                                        bool *do_update,
+                                        float *progress)
+{
+  AVPacket *packet = av_packet_alloc();
+  const uint64_t stream_size = avio_size(context->iFormatCtx->pb);
+  blender::Vector<anim_index_entry> entries;
+
+  while (av_read_frame(context->iFormatCtx, packet) >= 0) {
+    if (*stop) {
+      av_packet_unref(packet);
+      break;
+    }
+
+    if (packet->stream_index != context->videoStream) {
+      av_packet_unref(packet);
+      continue;
+    }
+
+    const int64_t pts = timestamp_from_pts_or_dts(packet->pts, packet->dts);
+
+    if (packet->flags & AV_PKT_FLAG_KEY) {
+      context->last_seek_pos = context->seek_pos;
+      context->last_seek_pos_pts = context->seek_pos_pts;
+      context->last_seek_pos_dts = context->seek_pos_dts;
+
+      context->seek_pos = packet->pos;
+      context->seek_pos_pts = packet->pts;
+      context->seek_pos_dts = packet->dts;
+    }
+
+    anim_index_entry entry;
+    entry.frameno = 0;
+    entry.pts = pts;
+    if (pts < timestamp_from_pts_or_dts(context->seek_pos_pts, context->seek_pos_dts)) {
+      entry.seek_pos = context->last_seek_pos;
+      entry.seek_pos_pts = context->last_seek_pos_pts;
+      entry.seek_pos_dts = context->last_seek_pos_dts;
+    }
+    else {
+      entry.seek_pos = context->seek_pos;
+      entry.seek_pos_pts = context->seek_pos_pts;
+      entry.seek_pos_dts = context->seek_pos_dts;
+    }
+    entries.append(entry);
+
+    if (stream_size > 0 && packet->pos >= 0) {
+      *progress = float(double(packet->pos) / double(stream_size));
+      *do_update = true;
+    }
+
+    av_packet_unref(packet);
+  }
+
+  av_packet_free(&packet);
+
+  if (*stop || entries.is_empty()) {
+    context->building_cancelled = true;
+    return 0;
+  }
+
+  /* Packets are stored in decoding order, the index is ordered by presentation time. */
+  std::sort(entries.begin(),
+            entries.end(),
+            [](const anim_index_entry &a, const anim_index_entry &b) {
+              return int64_t(a.pts) < int64_t(b.pts);
+            });
+
+  const double frame_rate = av_q2d(
+      av_guess_frame_rate(context->iFormatCtx, context->iStream, nullptr));
+  const double pts_time_base = av_q2d(context->iStream->time_base);
+  const int64_t start_pts = entries.first().pts;
+
+  for (const anim_index_entry &entry : entries) {
+    const int frameno = floor((int64_t(entry.pts) - start_pts) * pts_time_base * frame_rate +
+                              0.5);
+    IMB_index_builder_add_entry(context->seek_indexer,
+                                frameno,
+                                entry.seek_pos,
+                                entry.seek_pos_pts,
+                                entry.seek_pos_dts,
+                                entry.pts);
+  }
+
+  return 1;
+}
+
 /* Get number of frames, that can be decoded in specified time period. */
 static int indexer_performance_get_decode_rate(FFmpegIndexBuilderContext *context,
                                                const double time_period)
@@ -1295,6 +1463,26 @@ IndexBuildContext *IMB_anim_index_rebuild_context(ImBufAnim *anim,
   UNUSED_VARS(tcs_in_use, proxy_sizes_in_use, quality);
 }
 
+IndexBuildContext *IMB_anim_seek_index_rebuild_context(ImBufAnim *anim, const bool overwrite)
+{
+  if (!overwrite) {
+    char filepath[FILE_MAX];
+    get_seek_index_filepath(anim, filepath);
+    if (BLI_exists(filepath)) {
+      return nullptr;
+    }
+  }
+
+  IndexBuildContext *context = nullptr;
+#ifdef WITH_FFMPEG
+  if (anim->state == ImBufAnim::State::Valid) {
+    context = index_ffmpeg_create_seek_index_context(anim);
+  }
+#endif
+
+  return context;
+}
+
 void IMB_anim_index_rebuild(IndexBuildContext *context,
                             /* NOLINTNEXTLINE: readability-non-const-parameter. */
                             bool *stop,
@@ -1304,7 +1492,10 @@ void IMB_anim_index_rebuild(IndexBuildContext *context,
                             float *progress)
 {
 #ifdef WITH_FFMPEG
-  if (context != nullptr) {
+  if (context != nullptr && ((FFmpegIndexBuilderContext *)context)->seek_indexer) {
+    index_rebuild_ffmpeg_packets((FFmpegIndexBuilderContext *)context, stop, do_update, progress);
+  }
+  else if (context != nullptr) {
     if (indexer_need_to_build_proxy((FFmpegIndexBuilderContext *)context)) {
       index_rebuild_ffmpeg((FFmpegIndexBuilderContext *)context, stop, do_update, progress);
     }
@@ -1343,9 +1534,14 @@ void IMB_free_indices(ImBufAnim *anim)
     IMB_indexer_close(anim->no_gaps);
     anim->no_gaps = nullptr;
   }
+  if (anim->seek_index) {
+    IMB_indexer_close(anim->seek_index);
+    anim->seek_index = nullptr;
+  }
 
   anim->proxies_tried = 0;
   anim->indices_tried = 0;
+  anim->seek_index_tried = false;
 }
 
 void IMB_anim_set_index_dir(ImBufAnim *anim, const char *dir)
@@ -1414,6 +1610,25 @@ ImBufAnimIndex *IMB_anim_open_index(ImBufAnim *anim, IMB_Timecode_Type tc)
   return *index;
 }
 
+ImBufAnimIndex *IMB_anim_open_seek_index(ImBufAnim *anim)
+{
+  if (anim->seek_index_tried) {
+    return anim->seek_index;
+  }
+
+  char filepath[FILE_MAX];
+  get_seek_index_filepath(anim, filepath);
+
+  /* Avoid the error report of the indexer when the index was not built. */
+  if (BLI_exists(filepath)) {
+    anim->seek_index = IMB_indexer_open(filepath);
+  }
+
+  anim->seek_index_tried = true;
+
+  return anim->seek_index;
+}
+
 int IMB_anim_index_get_frame_index(ImBufAnim *anim, IMB_Timecode_Type tc, int position)
 {
   ImBufAnimIndex *idx = IMB_anim_open_index(anim, tc);
@@ -11,6 +11,7 @@
 #include "BLI_utildefines.h"
 
 #include "IMB_allocimbuf.hh"
+#include "IMB_anim.hh"
 #include "IMB_colormanagement_intern.hh"
 #include "IMB_filetype.hh"
 #include "IMB_imbuf.hh"
@@ -27,6 +28,9 @@ void IMB_exit()
 {
   imb_filetypes_exit();
   colormanagement_exit();
+#ifdef WITH_FFMPEG
+  imb_anim_hw_device_exit();
+#endif
   imb_mmap_lock_exit();
   imb_refcounter_lock_exit();
 }
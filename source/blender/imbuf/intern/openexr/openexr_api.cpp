@@ -2269,7 +2269,7 @@ ImBuf *imb_load_openexr(const uchar *mem, size_t size, int flags, char colorspac
 }
 
 ImBuf *imb_load_filepath_thumbnail_openexr(const char *filepath,
-                                           const int /*flags*/,
+                                           const int flags,
                                            const size_t max_thumb_size,
                                            char colorspace[],
                                            size_t *r_width,
@@ -2306,8 +2306,9 @@ ImBuf *imb_load_filepath_thumbnail_openexr(const char *filepath,
     *r_width = source_w;
     *r_height = source_h;
 
-    /* If there is an embedded thumbnail, return that instead of making a new one. */
-    if (file->header().hasPreviewImage()) {
+    /* If there is an embedded thumbnail, return that instead of making a new one. Only for
+     * thumbnails, reduced resolution loads need the requested size. */
+    if ((flags & IB_thumbnail) && file->header().hasPreviewImage()) {
       const Imf::PreviewImage &preview = file->header().previewImage();
       ImBuf *ibuf = IMB_allocFromBuffer(
           (uint8_t *)preview.pixels(), nullptr, preview.width(), preview.height(), 4);
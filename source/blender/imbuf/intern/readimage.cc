@@ -177,7 +177,7 @@ ImBuf *IMB_thumb_load_image(const char *filepath,
   }
 
   ImBuf *ibuf = nullptr;
-  int flags = IB_rect | IB_metadata;
+  int flags = IB_rect | IB_metadata | IB_thumbnail;
   /* Size of the original image. */
   size_t width = 0;
   size_t height = 0;
@@ -224,6 +224,43 @@ ImBuf *IMB_thumb_load_image(const char *filepath,
   return ibuf;
 }
 
+ImBuf *IMB_load_image_reduced(const char *filepath,
+                              int flags,
+                              size_t max_size,
+                              char colorspace[IM_MAX_SPACE],
+                              size_t *r_width,
+                              size_t *r_height)
+{
+  const ImFileType *type = IMB_file_type_from_ftype(IMB_ispic_type(filepath));
+  if (type == nullptr) {
+    return nullptr;
+  }
+
+  *r_width = 0;
+  *r_height = 0;
+
+  if (type->load_filepath_thumbnail == nullptr) {
+    ImBuf *ibuf = IMB_loadiffname(filepath, flags, colorspace);
+    if (ibuf) {
+      *r_width = ibuf->x;
+      *r_height = ibuf->y;
+    }
+    return ibuf;
+  }
+
+  char effective_colorspace[IM_MAX_SPACE] = "";
+  if (colorspace) {
+    STRNCPY(effective_colorspace, colorspace);
+  }
+
+  ImBuf *ibuf = type->load_filepath_thumbnail(
+      filepath, flags, max_size, colorspace, r_width, r_height);
+  if (ibuf) {
+    imb_handle_alpha(ibuf, flags, colorspace, effective_colorspace);
+  }
+  return ibuf;
+}
+
 ImBuf *IMB_testiffname(const char *filepath, int flags)
 {
   ImBuf *ibuf;
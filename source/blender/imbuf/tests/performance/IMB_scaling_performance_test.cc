@@ -5,6 +5,7 @@
 #include "testing/testing.h"
 
 #include "IMB_imbuf.hh"
+#include "IMB_interp.hh"
 
 #include "BLI_math_base.hh"
 #include "BLI_math_matrix.hh"
@@ -101,6 +102,29 @@ static void imb_scale_box(ImBuf *&src, int width, int height)
   IMB_scale(src, width, height, IMBScaleFilter::Box, true);
 }
 
+/** Bilinear scaling that samples every pixel individually, as reference for #IMB_scale. */
+static void imb_scale_bilinear_reference(ImBuf *&src, int width, int height)
+{
+  ImBuf *dst = IMB_allocImBuf(width, height, src->planes, src->flags);
+  const float factor_x = float(src->x) / width;
+  const float factor_y = float(src->y) / height;
+  for (int y = 0; y < height; y++) {
+    const float v = (float(y) + 0.5f) * factor_y - 0.5f;
+    for (int x = 0; x < width; x++) {
+      const float u = (float(x) + 0.5f) * factor_x - 0.5f;
+      const int64_t offset = int64_t(y) * width + x;
+      if (src->byte_buffer.data) {
+        imbuf::interpolate_bilinear_byte(src, dst->byte_buffer.data + offset * 4, u, v);
+      }
+      if (src->float_buffer.data) {
+        imbuf::interpolate_bilinear_fl(src, dst->float_buffer.data + offset * 4, u, v);
+      }
+    }
+  }
+  IMB_freeImBuf(src);
+  src = dst;
+}
+
 static void scale_perf_impl(const char *name,
                             bool use_float,
                             void (*func)(ImBuf *&src, int width, int height))
@@ -131,6 +155,47 @@ static void test_scaling_perf(bool use_float)
   scale_perf_impl("xform_boxfl_m", use_float, imb_xform_box);
 }
 
+/** Compare speed and result of bilinear #IMB_scale against per pixel sampling. */
+static void test_scaling_bilinear_quality(bool use_float)
+{
+  const int2 sizes[] = {{DST_LARGER_X, DST_LARGER_Y}, {DST_SMALLER_X, DST_SMALLER_Y}};
+  for (const int2 &size : sizes) {
+    ImBuf *ref = create_src_image(use_float);
+    ImBuf *res = create_src_image(use_float);
+    {
+      SCOPED_TIMER("bilin_reference");
+      imb_scale_bilinear_reference(ref, size.x, size.y);
+    }
+    {
+      SCOPED_TIMER("bilin_scale_s");
+      imb_scale_bilinear_st(res, size.x, size.y);
+    }
+    const int64_t values_num = int64_t(size.x) * size.y * 4;
+    float max_error = 0.0f;
+    for (int64_t i = 0; i < values_num; i++) {
+      const float error = use_float ?
+                              math::abs(ref->float_buffer.data[i] - res->float_buffer.data[i]) :
+                              math::abs(float(ref->byte_buffer.data[i]) -
+                                        float(res->byte_buffer.data[i]));
+      max_error = math::max(max_error, error);
+    }
+    printf("bilinear %dx%d: max difference to reference %g\n", size.x, size.y, max_error);
+    EXPECT_EQ(max_error, 0.0f);
+    IMB_freeImBuf(ref);
+    IMB_freeImBuf(res);
+  }
+}
+
+TEST(imbuf_scaling, scaling_bilinear_quality_byte)
+{
+  test_scaling_bilinear_quality(false);
+}
+
+TEST(imbuf_scaling, scaling_bilinear_quality_float)
+{
+  test_scaling_bilinear_quality(true);
+}
+
 TEST(imbuf_scaling, scaling_perf_byte)
 {
   test_scaling_perf(false);
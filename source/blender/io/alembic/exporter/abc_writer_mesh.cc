@@ -11,6 +11,7 @@
 #include "intern/abc_axis_conversion.h"
 
 #include "BLI_math_vector.h"
+#include "BLI_task.hh"
 
 #include "BKE_attribute.hh"
 #include "BKE_lib_id.hh"
@@ -137,7 +138,10 @@ void ABCGenericMeshWriter::do_write(HierarchyContext &context)
   Object *object = context.object;
   bool needsfree = false;
 
-  Mesh *mesh = get_export_mesh(object, needsfree);
+  /* Geometry instances carry their own evaluated mesh, which is not affected by the modifiers of
+   * their duplicator. */
+  Mesh *mesh = context.instanced_data ? reinterpret_cast<Mesh *>(context.instanced_data) :
+                                        get_export_mesh(object, needsfree);
 
   if (mesh == nullptr) {
     return;
@@ -209,8 +213,10 @@ void ABCGenericMeshWriter::write_mesh(HierarchyContext &context, Mesh *mesh)
   std::vector<int32_t> face_verts, loop_counts;
   std::vector<Imath::V3f> velocities;
 
-  get_vertices(mesh, points);
-  get_topology(mesh, face_verts, loop_counts);
+  threading::parallel_invoke(
+      mesh->corners_num > 1024,
+      [&]() { get_vertices(mesh, points); },
+      [&]() { get_topology(mesh, face_verts, loop_counts); });
 
   if (!frame_has_been_written_ && args_.export_params->face_sets) {
     write_face_sets(context.object, mesh, abc_poly_mesh_schema_);
@@ -435,9 +441,11 @@ static void get_vertices(Mesh *mesh, std::vector<Imath::V3f> &points)
   points.resize(mesh->verts_num);
 
   const Span<float3> positions = mesh->vert_positions();
-  for (int i = 0, e = mesh->verts_num; i < e; i++) {
-    copy_yup_from_zup(points[i].getValue(), positions[i]);
-  }
+  threading::parallel_for(positions.index_range(), 4096, [&](const IndexRange range) {
+    for (const int i : range) {
+      copy_yup_from_zup(points[i].getValue(), positions[i]);
+    }
+  });
 }
 
 static void get_topology(Mesh *mesh,
@@ -449,19 +457,20 @@ static void get_topology(Mesh *mesh,
 
   face_verts.clear();
   loop_counts.clear();
-  face_verts.reserve(corner_verts.size());
-  loop_counts.reserve(faces.size());
+  face_verts.resize(corner_verts.size());
+  loop_counts.resize(faces.size());
 
   /* NOTE: data needs to be written in the reverse order. */
-  for (const int i : faces.index_range()) {
-    const IndexRange face = faces[i];
-    loop_counts.push_back(face.size());
-
-    int corner = face.start() + (face.size() - 1);
-    for (int j = 0; j < face.size(); j++, corner--) {
-      face_verts.push_back(corner_verts[corner]);
+  threading::parallel_for(faces.index_range(), 1024, [&](const IndexRange range) {
+    for (const int i : range) {
+      const IndexRange face = faces[i];
+      loop_counts[i] = face.size();
+
+      for (const int j : face.index_range()) {
+        face_verts[face.start() + j] = corner_verts[face.last(j)];
+      }
     }
-  }
+  });
 }
 
 static void get_edge_creases(Mesh *mesh,
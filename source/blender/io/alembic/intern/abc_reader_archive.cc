@@ -34,6 +34,13 @@ static IArchive open_archive(const std::string &filename,
                              const std::vector<std::istream *> &input_streams)
 {
   try {
+    if (input_streams.empty()) {
+      /* Let Ogawa memory-map the file. Reads from a single shared stream are serialized by a
+       * lock, while mapped reads of different objects can run concurrently during evaluation. */
+      Alembic::AbcCoreOgawa::ReadArchive archive_reader;
+      return IArchive(archive_reader(filename), kWrapExisting, ErrorHandler::kThrowPolicy);
+    }
+
     Alembic::AbcCoreOgawa::ReadArchive archive_reader(input_streams);
 
     return IArchive(archive_reader(filename), kWrapExisting, ErrorHandler::kThrowPolicy);
@@ -112,15 +119,14 @@ ArchiveReader::ArchiveReader(const Main *bmain, const char *filename)
   BLI_path_abs(abs_filepath, BKE_main_blendfile_path(bmain));
 
 #ifdef WIN32
+  /* Open the stream explicitly to support non-ASCII file paths. */
   UTF16_ENCODE(abs_filepath);
   std::wstring wstr(abs_filepath_16);
   m_infile.open(wstr.c_str(), std::ios::in | std::ios::binary);
   UTF16_UN_ENCODE(abs_filepath);
-#else
-  m_infile.open(abs_filepath, std::ios::in | std::ios::binary);
-#endif
 
   m_streams.push_back(&m_infile);
+#endif
 
   m_archive = open_archive(abs_filepath, m_streams);
 }
@@ -68,6 +68,11 @@ struct HierarchyContext {
    * it's animated. This is necessary when a parent object in Blender is not part of the export. */
   bool animation_check_include_parent;
 
+  /* Data instanced by a dupli of a geometry set, for example geometry nodes instances. These
+   * duplis use their duplicator as object, so this data should be exported instead of the
+   * object's own data. It is null for all other objects. */
+  ID *instanced_data;
+
   /*********** Determined during writer creation: ***************/
   float parent_matrix_inv_world[4][4]; /* Inverse of the parent's world matrix. */
   std::string export_path; /* Hierarchical path, such as "/grandparent/parent/object_name". */
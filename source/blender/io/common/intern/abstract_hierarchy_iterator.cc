@@ -452,6 +452,9 @@ void AbstractHierarchyIterator::visit_dupli_object(DupliObject *dupli_object,
   context->export_path = "";
   context->original_export_path = "";
   context->animation_check_include_parent = false;
+  if (dupli_object->ob_data != nullptr && dupli_object->ob_data != dupli_object->ob->data) {
+    context->instanced_data = dupli_object->ob_data;
+  }
 
   copy_m4_m4(context->matrix_world, dupli_object->mat);
 
@@ -535,7 +538,22 @@ void AbstractHierarchyIterator::determine_duplication_references(
   ExportChildren children = graph_children(parent_context);
 
   for (HierarchyContext *context : children) {
-    if (context->duplicator != nullptr) {
+    if (context->instanced_data != nullptr) {
+      /* All instances of a geometry set share their duplicator as object, so only the instanced
+       * data tells them apart. The first instance of some data is written, later instances of the
+       * same data reference it. */
+      ID *source_data_id = context->instanced_data;
+      const ExportPathMap::const_iterator &it = duplisource_export_path_.find(source_data_id);
+
+      if (it == duplisource_export_path_.end()) {
+        context->mark_as_not_instanced();
+        duplisource_export_path_[source_data_id] = get_object_data_path(context);
+      }
+      else {
+        context->mark_as_instance_of(it->second);
+      }
+    }
+    else if (context->duplicator != nullptr) {
       ID *source_id = &context->object->id;
       const ExportPathMap::const_iterator &it = duplisource_export_path_.find(source_id);
 
@@ -632,9 +650,17 @@ void AbstractHierarchyIterator::make_writer_object_data(const HierarchyContext *
     return;
   }
 
+  ID *object_data = static_cast<ID *>(context->object->data);
+  if (context->instanced_data != nullptr) {
+    if (GS(context->instanced_data->name) != GS(object_data->name)) {
+      /* The data writer is chosen by object type, which cannot write other kinds of data. */
+      return;
+    }
+    object_data = context->instanced_data;
+  }
+
   HierarchyContext data_context = context_for_object_data(context);
   if (data_context.is_instance()) {
-    ID *object_data = static_cast<ID *>(context->object->data);
     data_context.original_export_path = duplisource_export_path_[object_data];
 
     /* If the object is marked as an instance, so should the object data. */
@@ -16,8 +16,10 @@
 #include "BKE_report.hh"
 #include "BKE_scene.hh"
 
+#include "BLI_array.hh"
 #include "BLI_string.h"
 #include "BLI_string_utils.hh"
+#include "BLI_task.hh"
 
 #include "DEG_depsgraph_query.hh"
 
@@ -132,22 +134,28 @@ void export_frame(Depsgraph *depsgraph,
 
     const bool mirrored = is_negative_m4(xform);
 
-    /* Write triangles. */
+    /* Fill the triangles of the whole object in parallel, then write them at once. */
     const Span<float3> positions = mesh->vert_positions();
     const Span<int> corner_verts = mesh->corner_verts();
-    for (const int3 &tri : mesh->corner_tris()) {
-      PackedTriangle data{};
-      for (int i = 0; i < 3; i++) {
-        /* Reverse face order for mirrored objects. */
-        int idx = mirrored ? 2 - i : i;
-        float3 pos = positions[corner_verts[tri[idx]]];
-        mul_m4_v3(xform, pos);
-        pos *= global_scale;
-        data.vertices[i] = pos;
+    const Span<int3> corner_tris = mesh->corner_tris();
+    Array<PackedTriangle> tris(corner_tris.size());
+    threading::parallel_for(corner_tris.index_range(), 2048, [&](const IndexRange range) {
+      for (const int tri_i : range) {
+        const int3 &tri = corner_tris[tri_i];
+        PackedTriangle data{};
+        for (int i = 0; i < 3; i++) {
+          /* Reverse face order for mirrored objects. */
+          int idx = mirrored ? 2 - i : i;
+          float3 pos = positions[corner_verts[tri[idx]]];
+          mul_m4_v3(xform, pos);
+          pos *= global_scale;
+          data.vertices[i] = pos;
+        }
+        data.normal = math::normal_tri(data.vertices[0], data.vertices[1], data.vertices[2]);
+        tris[tri_i] = data;
       }
-      data.normal = math::normal_tri(data.vertices[0], data.vertices[1], data.vertices[2]);
-      writer->write_triangle(data);
-    }
+    });
+    writer->write_triangles(tris);
   }
   DEG_OBJECT_ITER_END;
 }
@@ -17,7 +17,9 @@
 #include "stl_data.hh"
 #include "stl_export_writer.hh"
 
+#include "BLI_array.hh"
 #include "BLI_fileops.h"
+#include "BLI_task.hh"
 
 namespace blender::io::stl {
 
@@ -56,34 +58,55 @@ FileWriter::~FileWriter()
   fclose(file_);
 }
 
-void FileWriter::write_triangle(const PackedTriangle &data)
+static void format_triangle(fmt::memory_buffer &buf, const PackedTriangle &data)
 {
-  tris_num_++;
-  if (ascii_) {
-    fmt::print(file_,
-               "facet normal {} {} {}\n"
-               " outer loop\n"
-               "  vertex {} {} {}\n"
-               "  vertex {} {} {}\n"
-               "  vertex {} {} {}\n"
-               " endloop\n"
-               "endfacet\n",
+  fmt::format_to(fmt::appender(buf),
+                 "facet normal {} {} {}\n"
+                 " outer loop\n"
+                 "  vertex {} {} {}\n"
+                 "  vertex {} {} {}\n"
+                 "  vertex {} {} {}\n"
+                 " endloop\n"
+                 "endfacet\n",
+
+                 data.normal.x,
+                 data.normal.y,
+                 data.normal.z,
+                 data.vertices[0].x,
+                 data.vertices[0].y,
+                 data.vertices[0].z,
+                 data.vertices[1].x,
+                 data.vertices[1].y,
+                 data.vertices[1].z,
+                 data.vertices[2].x,
+                 data.vertices[2].y,
+                 data.vertices[2].z);
+}
 
-               data.normal.x,
-               data.normal.y,
-               data.normal.z,
-               data.vertices[0].x,
-               data.vertices[0].y,
-               data.vertices[0].z,
-               data.vertices[1].x,
-               data.vertices[1].y,
-               data.vertices[1].z,
-               data.vertices[2].x,
-               data.vertices[2].y,
-               data.vertices[2].z);
+void FileWriter::write_triangles(const Span<PackedTriangle> tris)
+{
+  tris_num_ += uint32_t(tris.size());
+  if (!ascii_) {
+    fwrite(tris.data(), sizeof(PackedTriangle), tris.size(), file_);
+    return;
   }
-  else {
-    fwrite(&data, sizeof(data), 1, file_);
+
+  /* Formatting floats dominates ASCII export, so format fixed size chunks in parallel and write
+   * them in their original order. */
+  constexpr int64_t chunk_size = 8192;
+  const int64_t chunks_num = (tris.size() + chunk_size - 1) / chunk_size;
+  Array<fmt::memory_buffer> buffers(chunks_num);
+  threading::parallel_for(IndexRange(chunks_num), 1, [&](const IndexRange range) {
+    for (const int64_t chunk : range) {
+      const IndexRange chunk_range = IndexRange(chunk * chunk_size, chunk_size)
+                                         .intersect(tris.index_range());
+      for (const PackedTriangle &data : tris.slice(chunk_range)) {
+        format_triangle(buffers[chunk], data);
+      }
+    }
+  });
+  for (const fmt::memory_buffer &buf : buffers) {
+    fwrite(buf.data(), 1, buf.size(), file_);
   }
 }
 
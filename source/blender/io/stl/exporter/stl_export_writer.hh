@@ -10,6 +10,8 @@
 
 #include <cstdio>
 
+#include "BLI_span.hh"
+
 namespace blender::io::stl {
 
 struct PackedTriangle;
@@ -18,7 +20,11 @@ class FileWriter {
  public:
   FileWriter(const char *filepath, bool ascii);
   ~FileWriter();
-  void write_triangle(const PackedTriangle &data);
+  /**
+   * Write a run of triangles at once. Binary triangles are written with a single call, ASCII
+   * triangles are formatted in parallel chunks that are then written in order.
+   */
+  void write_triangles(Span<PackedTriangle> tris);
 
  private:
   FILE *file_;
@@ -12,6 +12,7 @@
 #include "BKE_mesh.hh"
 
 #include "BLI_array.hh"
+#include "BLI_mmap.h"
 
 #include "DNA_mesh_types.h"
 
@@ -24,7 +25,6 @@ namespace blender::io::stl {
 
 Mesh *read_stl_binary(FILE *file, const bool use_custom_normals)
 {
-  const int chunk_size = 1024;
   uint32_t num_tris = 0;
   fseek(file, BINARY_HEADER_SIZE, SEEK_SET);
   if (fread(&num_tris, sizeof(uint32_t), 1, file) != 1) {
@@ -36,13 +36,25 @@ Mesh *read_stl_binary(FILE *file, const bool use_custom_normals)
     return BKE_mesh_new_nomain(0, 0, 0, 0);
   }
 
-  Array<PackedTriangle> tris_buf(chunk_size);
   STLMeshHelper stl_mesh(num_tris, use_custom_normals);
-  size_t num_read_tris;
-  while ((num_read_tris = fread(tris_buf.data(), sizeof(PackedTriangle), chunk_size, file))) {
-    for (size_t i = 0; i < num_read_tris; i++) {
-      stl_mesh.add_triangle(tris_buf[i]);
-    }
+
+  /* Map the file to access the triangles directly without copying them, falling back to
+   * reading the whole file when that isn't possible. */
+  const size_t tris_offset = BINARY_HEADER_SIZE + sizeof(uint32_t);
+  BLI_mmap_file *mmap_file = BLI_mmap_open(fileno(file));
+  if (mmap_file && BLI_mmap_get_length(mmap_file) >= tris_offset + BINARY_STRIDE * num_tris) {
+    const char *data = static_cast<const char *>(BLI_mmap_get_pointer(mmap_file));
+    stl_mesh.add_triangles(
+        Span(reinterpret_cast<const PackedTriangle *>(data + tris_offset), num_tris));
+  }
+  else {
+    Array<PackedTriangle> tris(num_tris);
+    fseek(file, tris_offset, SEEK_SET);
+    const size_t num_read_tris = fread(tris.data(), sizeof(PackedTriangle), num_tris, file);
+    stl_mesh.add_triangles(tris.as_span().take_front(num_read_tris));
+  }
+  if (mmap_file) {
+    BLI_mmap_free(mmap_file);
   }
 
   return stl_mesh.to_mesh();
@@ -6,12 +6,17 @@
  * \ingroup stl
  */
 
+#include <array>
+#include <cstddef>
+#include <cstring>
 #include <iostream>
 
 #include "BKE_mesh.hh"
 
 #include "BLI_array_utils.hh"
+#include "BLI_sort.hh"
 #include "BLI_span.hh"
+#include "BLI_task.hh"
 
 #include "DNA_mesh_types.h"
 
@@ -26,8 +31,6 @@ STLMeshHelper::STLMeshHelper(int tris_num, bool use_custom_normals)
   degenerate_tris_num_ = 0;
   duplicate_tris_num_ = 0;
   tris_.reserve(tris_num);
-  /* Upper bound (all vertices are unique). */
-  verts_.reserve(tris_num * 3);
   if (use_custom_normals) {
     loop_normals_.reserve(tris_num * 3);
   }
@@ -38,6 +41,14 @@ bool STLMeshHelper::add_triangle(const PackedTriangle &data)
   int v1_id = verts_.index_of_or_add(data.vertices[0]);
   int v2_id = verts_.index_of_or_add(data.vertices[1]);
   int v3_id = verts_.index_of_or_add(data.vertices[2]);
+  return this->add_triangle(v1_id, v2_id, v3_id, data.normal);
+}
+
+bool STLMeshHelper::add_triangle(const int v1_id,
+                                 const int v2_id,
+                                 const int v3_id,
+                                 const float3 &normal)
+{
   if ((v1_id == v2_id) || (v1_id == v3_id) || (v2_id == v3_id)) {
     degenerate_tris_num_++;
     return false;
@@ -48,11 +59,88 @@ bool STLMeshHelper::add_triangle(const PackedTriangle &data)
   }
 
   if (use_custom_normals_) {
-    loop_normals_.append_n_times(data.normal, 3);
+    loop_normals_.append_n_times(normal, 3);
   }
   return true;
 }
 
+/**
+ * The bits of a triangle corner's position. Vertices are merged when their positions are
+ * bitwise equal, which matches the hashing of #VectorSet. The triangles may be read directly
+ * from a file mapping, so their members aren't necessarily aligned.
+ */
+static std::array<uint32_t, 3> corner_position_bits(const Span<PackedTriangle> tris,
+                                                    const int corner)
+{
+  std::array<uint32_t, 3> bits;
+  const char *tri = reinterpret_cast<const char *>(&tris[corner / 3]);
+  memcpy(bits.data(),
+         tri + offsetof(PackedTriangle, vertices) + sizeof(float3) * (corner % 3),
+         sizeof(bits));
+  return bits;
+}
+
+void STLMeshHelper::add_triangles(const Span<PackedTriangle> tris)
+{
+  BLI_assert(verts_.is_empty() && tris_.is_empty());
+  const int corners_num = int(tris.size() * 3);
+
+  /* Sort the corners by position, with ties broken by their index so the first corner using
+   * each position starts its group. */
+  Array<int> sorted_corners(corners_num);
+  array_utils::fill_index_range<int>(sorted_corners);
+  parallel_sort(sorted_corners.begin(), sorted_corners.end(), [&](const int a, const int b) {
+    const std::array<uint32_t, 3> a_bits = corner_position_bits(tris, a);
+    const std::array<uint32_t, 3> b_bits = corner_position_bits(tris, b);
+    if (a_bits != b_bits) {
+      return a_bits < b_bits;
+    }
+    return a < b;
+  });
+
+  /* Find the first corner with the same position as each corner. Groups are small, so it's
+   * cheap to search backwards for the start of each group. */
+  Array<int> first_corners(corners_num);
+  threading::parallel_for(sorted_corners.index_range(), 4096, [&](const IndexRange range) {
+    for (const int i : range) {
+      const std::array<uint32_t, 3> bits = corner_position_bits(tris, sorted_corners[i]);
+      int group_start = i;
+      while (group_start > 0 &&
+             corner_position_bits(tris, sorted_corners[group_start - 1]) == bits)
+      {
+        group_start--;
+      }
+      first_corners[sorted_corners[i]] = sorted_corners[group_start];
+    }
+  });
+  sorted_corners = {};
+
+  /* Number the unique positions in the order they are first used, like #VectorSet does. */
+  Array<int> corner_verts(corners_num);
+  int verts_num = 0;
+  for (const int corner : IndexRange(corners_num)) {
+    const int first_corner = first_corners[corner];
+    corner_verts[corner] = (first_corner == corner) ? verts_num++ : corner_verts[first_corner];
+  }
+
+  merged_verts_.reinitialize(verts_num);
+  threading::parallel_for(IndexRange(corners_num), 4096, [&](const IndexRange range) {
+    for (const int corner : range) {
+      if (first_corners[corner] != corner) {
+        continue;
+      }
+      const std::array<uint32_t, 3> bits = corner_position_bits(tris, corner);
+      memcpy(&merged_verts_[corner_verts[corner]], bits.data(), sizeof(float3));
+    }
+  });
+
+  for (const int i : tris.index_range()) {
+    const PackedTriangle tri = tris[i];
+    this->add_triangle(
+        corner_verts[i * 3], corner_verts[i * 3 + 1], corner_verts[i * 3 + 2], tri.normal);
+  }
+}
+
 Mesh *STLMeshHelper::to_mesh()
 {
   if (degenerate_tris_num_ > 0) {
@@ -64,8 +152,10 @@ Mesh *STLMeshHelper::to_mesh()
               << std::endl;
   }
 
-  Mesh *mesh = BKE_mesh_new_nomain(verts_.size(), 0, tris_.size(), tris_.size() * 3);
-  mesh->vert_positions_for_write().copy_from(verts_);
+  const Span<float3> verts = merged_verts_.is_empty() ? verts_.as_span() :
+                                                        merged_verts_.as_span();
+  Mesh *mesh = BKE_mesh_new_nomain(verts.size(), 0, tris_.size(), tris_.size() * 3);
+  mesh->vert_positions_for_write().copy_from(verts);
   offset_indices::fill_constant_group_size(3, 0, mesh->face_offsets_for_write());
   array_utils::copy(tris_.as_span().cast<int>(), mesh->corner_verts_for_write());
 
@@ -10,7 +10,9 @@
 
 #include <cstdint>
 
+#include "BLI_array.hh"
 #include "BLI_math_vector_types.hh"
+#include "BLI_span.hh"
 #include "BLI_vector.hh"
 #include "BLI_vector_set.hh"
 #include "stl_data.hh"
@@ -50,6 +52,8 @@ class Triangle {
 class STLMeshHelper {
  private:
   VectorSet<float3> verts_;
+  /** Vertex positions merged by #add_triangles, used instead of #verts_ when not empty. */
+  Array<float3> merged_verts_;
   VectorSet<Triangle> tris_;
   Vector<float3> loop_normals_;
   int degenerate_tris_num_;
@@ -64,7 +68,17 @@ class STLMeshHelper {
    */
   bool add_triangle(const PackedTriangle &data);
 
+  /**
+   * Add all triangles at once, merging duplicate vertices in parallel by sorting the triangle
+   * corners by position. The result is the same as adding the triangles one by one.
+   * Must be called on an empty helper.
+   */
+  void add_triangles(Span<PackedTriangle> tris);
+
   Mesh *to_mesh();
+
+ private:
+  bool add_triangle(int v1_id, int v2_id, int v3_id, const float3 &normal);
 };
 
 }  // namespace blender::io::stl
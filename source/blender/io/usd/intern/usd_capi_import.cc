@@ -269,9 +269,12 @@ static void import_startjob(void *customdata, wmJobWorkerStatus *worker_status)
     }
   }
 
+  const pxr::UsdStage::InitialLoadSet load_set = data->params.load_payloads ?
+                                                      pxr::UsdStage::LoadAll :
+                                                      pxr::UsdStage::LoadNone;
   pxr::UsdStageRefPtr stage = pop_mask.IsEmpty() ?
-                                  pxr::UsdStage::Open(data->filepath) :
-                                  pxr::UsdStage::OpenMasked(data->filepath, pop_mask);
+                                  pxr::UsdStage::Open(data->filepath, load_set) :
+                                  pxr::UsdStage::OpenMasked(data->filepath, pop_mask, load_set);
 
   if (!stage) {
     BKE_reportf(worker_status->reports,
@@ -19,6 +19,7 @@
 #include "BLI_assert.h"
 #include "BLI_color.hh"
 #include "BLI_math_vector_types.hh"
+#include "BLI_task.hh"
 
 #include "BKE_attribute.hh"
 #include "BKE_customdata.hh"
@@ -91,7 +92,10 @@ void USDGenericMeshWriter::do_write(HierarchyContext &context)
 {
   Object *object_eval = context.object;
   bool needsfree = false;
-  Mesh *mesh = get_export_mesh(object_eval, needsfree);
+  /* Geometry instances carry their own evaluated mesh, which is not affected by the modifiers of
+   * their duplicator. */
+  Mesh *mesh = context.instanced_data ? reinterpret_cast<Mesh *>(context.instanced_data) :
+                                        get_export_mesh(object_eval, needsfree);
 
   if (mesh == nullptr) {
     return;
@@ -122,8 +126,11 @@ void USDGenericMeshWriter::do_write(HierarchyContext &context)
 
   try {
     /* Fetch the subdiv modifier, if one exists and it is the last modifier. */
-    const SubsurfModifierData *subsurfData = get_last_subdiv_modifier(
-        usd_export_context_.export_params.evaluation_mode, object_eval);
+    const SubsurfModifierData *subsurfData =
+        context.instanced_data ?
+            nullptr :
+            get_last_subdiv_modifier(usd_export_context_.export_params.evaluation_mode,
+                                     object_eval);
 
     write_mesh(context, mesh, subsurfData);
 
@@ -564,8 +571,9 @@ void USDGenericMeshWriter::write_subdiv(const pxr::TfToken &subdiv_scheme,
 
 static void get_positions(const Mesh *mesh, USDMeshData &usd_mesh_data)
 {
-  const Span<pxr::GfVec3f> positions = mesh->vert_positions().cast<pxr::GfVec3f>();
-  usd_mesh_data.points = pxr::VtArray<pxr::GfVec3f>(positions.begin(), positions.end());
+  usd_mesh_data.points.resize(mesh->verts_num);
+  array_utils::copy(mesh->vert_positions().cast<pxr::GfVec3f>(),
+                    MutableSpan(usd_mesh_data.points.data(), mesh->verts_num));
 }
 
 static void get_loops_polys(const Mesh *mesh, USDMeshData &usd_mesh_data)
@@ -589,8 +597,9 @@ static void get_loops_polys(const Mesh *mesh, USDMeshData &usd_mesh_data)
       faces.index_range(),
       MutableSpan(usd_mesh_data.face_vertex_counts.data(), mesh->faces_num));
 
-  const Span<int> corner_verts = mesh->corner_verts();
-  usd_mesh_data.face_indices = pxr::VtIntArray(corner_verts.begin(), corner_verts.end());
+  usd_mesh_data.face_indices.resize(mesh->corners_num);
+  array_utils::copy(mesh->corner_verts(),
+                    MutableSpan(usd_mesh_data.face_indices.data(), mesh->corners_num));
 }
 
 static void get_edge_creases(const Mesh *mesh, USDMeshData &usd_mesh_data)
@@ -640,10 +649,16 @@ static void get_vert_creases(const Mesh *mesh, USDMeshData &usd_mesh_data)
 
 void USDGenericMeshWriter::get_geometry_data(const Mesh *mesh, USDMeshData &usd_mesh_data)
 {
-  get_positions(mesh, usd_mesh_data);
-  get_loops_polys(mesh, usd_mesh_data);
-  get_edge_creases(mesh, usd_mesh_data);
-  get_vert_creases(mesh, usd_mesh_data);
+  /* The arrays are independent from each other, so gather them concurrently. Authoring them on
+   * the stage still happens on the calling thread. */
+  threading::parallel_invoke(
+      mesh->corners_num > 1024,
+      [&]() { get_positions(mesh, usd_mesh_data); },
+      [&]() { get_loops_polys(mesh, usd_mesh_data); },
+      [&]() {
+        get_edge_creases(mesh, usd_mesh_data);
+        get_vert_creases(mesh, usd_mesh_data);
+      });
 }
 
 void USDGenericMeshWriter::assign_materials(const HierarchyContext &context,
@@ -736,9 +751,11 @@ void USDGenericMeshWriter::write_normals(const Mesh *mesh, pxr::UsdGeomMesh &usd
     case bke::MeshNormalDomain::Face: {
       const OffsetIndices faces = mesh->faces();
       const Span<float3> face_normals = mesh->face_normals();
-      for (const int i : faces.index_range()) {
-        dst_normals.slice(faces[i]).fill(face_normals[i]);
-      }
+      threading::parallel_for(faces.index_range(), 1024, [&](const IndexRange range) {
+        for (const int i : range) {
+          dst_normals.slice(faces[i]).fill(face_normals[i]);
+        }
+      });
       break;
     }
     case bke::MeshNormalDomain::Corner: {
@@ -176,6 +176,8 @@ struct USDImportParams {
 
   bool import_defined_only;
   bool import_visible_only;
+  /** When false, open the stage without loading any payloads. */
+  bool load_payloads;
 
   bool import_cameras;
   bool import_curves;
@@ -8,12 +8,14 @@
 
 #include "BKE_report.hh"
 
+#include "BLI_array.hh"
 #include "BLI_fileops.hh"
 #include "BLI_map.hh"
 #include "BLI_math_vector.h"
 #include "BLI_math_vector_types.hh"
 #include "BLI_string.h"
 #include "BLI_string_ref.hh"
+#include "BLI_task.hh"
 #include "BLI_vector.hh"
 
 #include "obj_export_mtl.hh"
@@ -71,25 +73,69 @@ static Geometry *create_geometry(Geometry *const prev_geometry,
   return new_geometry();
 }
 
-static void geom_add_vertex(const char *p, const char *end, GlobalVertices &r_global_vertices)
+/**
+ * Parse a run of consecutive vertex position lines (with the keyword already dropped) in
+ * parallel. These make up most of the data in large files.
+ */
+static void geom_add_vertices(const Span<StringRef> lines, GlobalVertices &r_global_vertices)
 {
   r_global_vertices.flush_mrgb_block();
-  float3 vert;
-  p = parse_floats(p, end, 0.0f, vert, 3);
-  r_global_vertices.vertices.append(vert);
-  /* OBJ extension: `xyzrgb` vertex colors, when the vertex position
-   * is followed by 3 more RGB color components. See
-   * http://paulbourke.net/dataformats/obj/colour.html */
-  if (p < end) {
-    float3 srgb;
-    p = parse_floats(p, end, -1.0f, srgb, 3);
-    if (srgb.x >= 0 && srgb.y >= 0 && srgb.z >= 0) {
-      float3 linear;
-      srgb_to_linearrgb_v3_v3(linear, srgb);
-      r_global_vertices.set_vertex_color(r_global_vertices.vertices.size() - 1, linear);
+  const int64_t start = r_global_vertices.vertices.size();
+  r_global_vertices.vertices.resize(start + lines.size());
+  MutableSpan<float3> vertices = r_global_vertices.vertices.as_mutable_span().drop_front(start);
+  Array<float3> colors(lines.size());
+  threading::parallel_for(lines.index_range(), 2048, [&](const IndexRange range) {
+    for (const int64_t i : range) {
+      const char *p = lines[i].begin(), *end = lines[i].end();
+      p = parse_floats(p, end, 0.0f, vertices[i], 3);
+      /* OBJ extension: `xyzrgb` vertex colors, when the vertex position
+       * is followed by 3 more RGB color components. See
+       * http://paulbourke.net/dataformats/obj/colour.html */
+      colors[i] = float3(-1.0f);
+      if (p < end) {
+        float3 srgb;
+        parse_floats(p, end, -1.0f, srgb, 3);
+        if (srgb.x >= 0 && srgb.y >= 0 && srgb.z >= 0) {
+          srgb_to_linearrgb_v3_v3(colors[i], srgb);
+        }
+      }
+    }
+  });
+  for (const int64_t i : lines.index_range()) {
+    if (colors[i].x >= 0.0f) {
+      r_global_vertices.set_vertex_color(start + i, colors[i]);
     }
   }
-  UNUSED_VARS(p);
+}
+
+static void geom_add_vertex_normals(const Span<StringRef> lines,
+                                    GlobalVertices &r_global_vertices)
+{
+  const int64_t start = r_global_vertices.vert_normals.size();
+  r_global_vertices.vert_normals.resize(start + lines.size());
+  MutableSpan<float3> normals = r_global_vertices.vert_normals.as_mutable_span().drop_front(
+      start);
+  threading::parallel_for(lines.index_range(), 2048, [&](const IndexRange range) {
+    for (const int64_t i : range) {
+      parse_floats(lines[i].begin(), lines[i].end(), 0.0f, normals[i], 3);
+      /* Normals can be printed with only several digits in the file,
+       * making them ever-so-slightly non unit length. Make sure they are
+       * normalized. */
+      normalize_v3(normals[i]);
+    }
+  });
+}
+
+static void geom_add_uv_vertices(const Span<StringRef> lines, GlobalVertices &r_global_vertices)
+{
+  const int64_t start = r_global_vertices.uv_vertices.size();
+  r_global_vertices.uv_vertices.resize(start + lines.size());
+  MutableSpan<float2> uvs = r_global_vertices.uv_vertices.as_mutable_span().drop_front(start);
+  threading::parallel_for(lines.index_range(), 2048, [&](const IndexRange range) {
+    for (const int64_t i : range) {
+      parse_floats(lines[i].begin(), lines[i].end(), 0.0f, uvs[i], 2);
+    }
+  });
 }
 
 static void geom_add_mrgb_colors(const char *p, const char *end, GlobalVertices &r_global_vertices)
@@ -119,26 +165,6 @@ static void geom_add_mrgb_colors(const char *p, const char *end, GlobalVertices
   }
 }
 
-static void geom_add_vertex_normal(const char *p,
-                                   const char *end,
-                                   GlobalVertices &r_global_vertices)
-{
-  float3 normal;
-  parse_floats(p, end, 0.0f, normal, 3);
-  /* Normals can be printed with only several digits in the file,
-   * making them ever-so-slightly non unit length. Make sure they are
-   * normalized. */
-  normalize_v3(normal);
-  r_global_vertices.vert_normals.append(normal);
-}
-
-static void geom_add_uv_vertex(const char *p, const char *end, GlobalVertices &r_global_vertices)
-{
-  float2 uv;
-  parse_floats(p, end, 0.0f, uv, 2);
-  r_global_vertices.uv_vertices.append(uv);
-}
-
 /**
  * Parse vertex index and transform to non-negative, zero-based.
  * Sets r_index to the index or INT32_MAX on error.
@@ -461,6 +487,32 @@ static bool parse_keyword(const char *&p, const char *end, StringRef keyword)
   return true;
 }
 
+/**
+ * Starting with the rest of the current line, gather it and all the directly following lines
+ * that start with the same keyword, dropping the keyword from each of them.
+ */
+static void gather_keyword_lines(const char *p,
+                                 const char *end,
+                                 const StringRef keyword,
+                                 StringRef &buffer_str,
+                                 size_t &line_number,
+                                 Vector<StringRef> &r_lines)
+{
+  r_lines.clear();
+  r_lines.append(StringRef(p, end));
+  while (!buffer_str.is_empty()) {
+    StringRef rest = buffer_str;
+    const StringRef line = read_next_line(rest);
+    const char *line_p = drop_whitespace(line.begin(), line.end());
+    if (!parse_keyword(line_p, line.end(), keyword)) {
+      break;
+    }
+    r_lines.append(StringRef(line_p, line.end()));
+    buffer_str = rest;
+    ++line_number;
+  }
+}
+
 /* Special case: if there were no faces/edges in any geometries,
  * treat all the vertices as a point cloud. */
 static void use_all_vertices_if_no_faces(Geometry *geom,
@@ -505,6 +557,7 @@ void OBJParser::parse(Vector<std::unique_ptr<Geometry>> &r_all_geometries,
 
   size_t buffer_offset = 0;
   size_t line_number = 0;
+  Vector<StringRef> vertex_data_lines;
   while (true) {
     /* Read a chunk of input from the file. */
     size_t bytes_read = fread(buffer.data() + buffer_offset, 1, read_buffer_size_, obj_file_);
@@ -559,16 +612,20 @@ void OBJParser::parse(Vector<std::unique_ptr<Geometry>> &r_all_geometries,
       if (p == end) {
         continue;
       }
-      /* Most common things that start with 'v': vertices, normals, UVs. */
+      /* Most common things that start with 'v': vertices, normals, UVs.
+       * They usually come in long runs of the same kind, which are parsed together. */
       if (*p == 'v') {
         if (parse_keyword(p, end, "v")) {
-          geom_add_vertex(p, end, r_global_vertices);
+          gather_keyword_lines(p, end, "v", buffer_str, line_number, vertex_data_lines);
+          geom_add_vertices(vertex_data_lines, r_global_vertices);
         }
         else if (parse_keyword(p, end, "vn")) {
-          geom_add_vertex_normal(p, end, r_global_vertices);
+          gather_keyword_lines(p, end, "vn", buffer_str, line_number, vertex_data_lines);
+          geom_add_vertex_normals(vertex_data_lines, r_global_vertices);
         }
         else if (parse_keyword(p, end, "vt")) {
-          geom_add_uv_vertex(p, end, r_global_vertices);
+          gather_keyword_lines(p, end, "vt", buffer_str, line_number, vertex_data_lines);
+          geom_add_uv_vertices(vertex_data_lines, r_global_vertices);
         }
       }
       /* Faces. */
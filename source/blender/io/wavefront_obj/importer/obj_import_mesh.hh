@@ -34,9 +34,17 @@ class MeshFromGeometry : NonMovable, NonCopyable {
   {
   }
 
+  /**
+   * Build the mesh without adding anything to Main, so meshes of different geometries can be
+   * created in parallel.
+   */
   Mesh *create_mesh(const OBJImportParams &import_params);
 
+  /**
+   * Add an object for a mesh built with #create_mesh to Main, taking ownership of the mesh.
+   */
   Object *create_mesh_object(Main *bmain,
+                             Mesh *mesh,
                              Map<std::string, std::unique_ptr<MTLMaterial>> &materials,
                              Map<std::string, Material *> &created_materials,
                              const OBJImportParams &import_params);
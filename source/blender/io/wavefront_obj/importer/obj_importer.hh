@@ -12,9 +12,14 @@
 
 namespace blender::io::obj {
 
+/**
+ * Large read buffers give the parser long runs of vertex data to parse in parallel.
+ */
+constexpr size_t DEFAULT_READ_BUFFER_SIZE = 8 * 1024 * 1024;
+
 void importer_geometry(const OBJImportParams &import_params,
                        Vector<bke::GeometrySet> &geometries,
-                       size_t read_buffer_size = 256 * 1024);
+                       size_t read_buffer_size = DEFAULT_READ_BUFFER_SIZE);
 
 /* Main import function used from within Blender. */
 void importer_main(bContext *C, const OBJImportParams &import_params);
@@ -24,6 +29,6 @@ void importer_main(Main *bmain,
                    Scene *scene,
                    ViewLayer *view_layer,
                    const OBJImportParams &import_params,
-                   size_t read_buffer_size = 256 * 1024);
+                   size_t read_buffer_size = DEFAULT_READ_BUFFER_SIZE);
 
 }  // namespace blender::io::obj
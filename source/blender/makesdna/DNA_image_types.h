@@ -137,6 +137,13 @@ typedef struct Image_Runtime {
   /* Compositor viewer might be translated, and that translation will be stored in this runtime
    * vector by the compositor so that the editor draw code can draw the image translated. */
   float backdrop_offset[2];
+
+  /**
+   * Number of times the resolution of the streamed GPU texture still has to be doubled to reach
+   * its final resolution. Zero when the texture isn't streamed or is fully resident.
+   */
+  int gpu_stream_lod;
+  char _pad[4];
 } Image_Runtime;
 
 typedef struct Image {
@@ -153,4 +153,6 @@ enum {
   PTCACHE_COMPRESS_NO = 0,
   PTCACHE_COMPRESS_LZO = 1,
   PTCACHE_COMPRESS_LZMA = 2,
+  PTCACHE_COMPRESS_ZSTD_FAST = 3,
+  PTCACHE_COMPRESS_ZSTD_SLOW = 4,
 };
@@ -2556,6 +2556,7 @@ enum {
   FFMPEG_AUTOSPLIT_OUTPUT = (1 << 1),
   FFMPEG_LOSSLESS_OUTPUT = (1 << 2),
   FFMPEG_USE_MAX_B_FRAMES = (1 << 3),
+  FFMPEG_USE_HW_ENCODER = (1 << 4),
 };
 
 /** #Paint::flags */
@@ -2856,6 +2857,7 @@ enum {
   SCE_EEVEE_SHADOW_JITTERED_VIEWPORT = (1 << 26),
   SCE_EEVEE_VOLUME_CUSTOM_RANGE = (1 << 27),
   SCE_EEVEE_FAST_GI_ENABLED = (1 << 28),
+  SCE_EEVEE_SHADOW_STATIC_CACHE = (1 << 29),
 };
 
 typedef enum RaytraceEEVEE_Flag {
@@ -1646,7 +1646,8 @@ typedef enum eSpaceNode_Flag {
   SNODE_SHOW_R = (1 << 7),
   SNODE_SHOW_G = (1 << 8),
   SNODE_SHOW_B = (1 << 9),
-  SNODE_FLAG_UNUSED_5 = (1 << 5),   /* cleared */
+  /** Only compute the region of the viewer image that is visible in the backdrop. */
+  SNODE_BACKDRAW_VISIBLE_REGION = (1 << 5),
   SNODE_FLAG_UNUSED_6 = (1 << 6),   /* cleared */
   SNODE_FLAG_UNUSED_10 = (1 << 10), /* cleared */
   SNODE_FLAG_UNUSED_11 = (1 << 11), /* cleared */
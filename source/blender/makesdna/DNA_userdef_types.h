@@ -761,7 +761,10 @@ typedef struct UserDef_Experimental {
   char use_animation_baklava;
   char use_docking;
   char enable_new_cpu_compositor;
-  char _pad[1];
+  char use_incremental_save;
+  char use_async_save;
+  char use_viewport_mesh_lod;
+  char _pad[6];
   /** `makesdna` does not allow empty structs. */
 } UserDef_Experimental;
 
@@ -949,7 +952,9 @@ typedef struct UserDef {
   /** Maximum number of simulations connection limit for online operations. */
   uint8_t network_connection_limit;
 
-  char _pad14[3];
+  /** Compress global and sculpt undo steps older than this number of steps (0 to disable). */
+  uint8_t undo_compress_steps;
+  char _pad14[2];
 
   short undosteps;
   int undomemory;
@@ -975,7 +980,8 @@ typedef struct UserDef {
   int prefetchframes;
   /** Control the rotation step of the view when PAD2, PAD4, PAD6&PAD8 is use. */
   float pad_rot_angle;
-  char _pad12[4];
+  /** Maximum size of streamed image textures in MiB, 0 for no limit. */
+  int texture_streaming_budget;
   /** Rotating view icon size. */
   short rvisize;
   /** Rotating view icon brightness. */
@@ -1323,6 +1329,7 @@ typedef enum eUserpref_GPU_Flag {
   USER_GPU_FLAG_OVERLAY_SMOOTH_WIRE = (1 << 2),
   USER_GPU_FLAG_SUBDIVISION_EVALUATION = (1 << 3),
   USER_GPU_FLAG_FRESNEL_EDIT = (1 << 4),
+  USER_GPU_FLAG_TEXTURE_STREAMING = (1 << 5),
 } eUserpref_GPU_Flag;
 
 /** #UserDef.tablet_api */
@@ -1598,6 +1605,8 @@ typedef enum eUserpref_SeqProxySetup {
 typedef enum eUserpref_SeqEditorFlags {
   USER_SEQ_ED_SIMPLE_TWEAKING = (1 << 0),
   USER_SEQ_ED_CONNECT_STRIPS_BY_DEFAULT = (1 << 1),
+  USER_SEQ_ED_HARDWARE_DECODE = (1 << 2),
+  USER_SEQ_ED_GPU_PREVIEW = (1 << 3),
 } eUserpref_SeqEditorFlags;
 
 /* Locale Ids. Auto will try to get local from OS. Our default is English though. */
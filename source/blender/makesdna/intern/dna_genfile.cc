@@ -31,6 +31,11 @@
 #include "DNA_genfile.h"
 #include "DNA_sdna_types.h" /* for SDNA ;-) */
 
+#ifdef WITH_TBB
+#  include <tbb/blocked_range.h>
+#  include <tbb/parallel_for.h>
+#endif
+
 /**
  * \section dna_genfile Overview
  *
@@ -1288,6 +1293,12 @@ static void reconstruct_struct(const DNA_ReconstructInfo *reconstruct_info,
   }
 }
 
+/**
+ * Minimum size (in bytes) of the reconstructed data before an array of structs is reconstructed
+ * in parallel, smaller arrays are not worth the threading overhead.
+ */
+#define DNA_RECONSTRUCT_PARALLEL_MIN_SIZE (1 << 16)
+
 /** Reconstructs an array of structs. */
 static void reconstruct_structs(const DNA_ReconstructInfo *reconstruct_info,
                                 const int blocks,
@@ -1302,11 +1313,28 @@ static void reconstruct_structs(const DNA_ReconstructInfo *reconstruct_info,
   const int old_block_size = reconstruct_info->oldsdna->types_size[old_struct->type_index];
   const int new_block_size = reconstruct_info->newsdna->types_size[new_struct->type_index];
 
-  for (int a = 0; a < blocks; a++) {
-    const char *old_block = old_blocks + a * old_block_size;
-    char *new_block = new_blocks + a * new_block_size;
-    reconstruct_struct(reconstruct_info, new_struct_index, old_block, new_block);
+  auto reconstruct_range = [&](const int first, const int last) {
+    for (int a = first; a < last; a++) {
+      const char *old_block = old_blocks + int64_t(a) * old_block_size;
+      char *new_block = new_blocks + int64_t(a) * new_block_size;
+      reconstruct_struct(reconstruct_info, new_struct_index, old_block, new_block);
+    }
+  };
+
+#ifdef WITH_TBB
+  /* Every array element is reconstructed independently and the reconstruct info is read-only,
+   * so large arrays (e.g. mesh data saved with an older DNA layout) can be split across threads.
+   * This library can't depend on the blenlib task scheduler, so use TBB directly. */
+  if (int64_t(blocks) * new_block_size >= DNA_RECONSTRUCT_PARALLEL_MIN_SIZE) {
+    const int grain_size = std::max(1, DNA_RECONSTRUCT_PARALLEL_MIN_SIZE / new_block_size);
+    tbb::parallel_for(tbb::blocked_range<int>(0, blocks, grain_size),
+                      [&](const tbb::blocked_range<int> &range) {
+                        reconstruct_range(range.begin(), range.end());
+                      });
+    return;
   }
+#endif
+  reconstruct_range(0, blocks);
 }
 
 void *DNA_struct_reconstruct(const DNA_ReconstructInfo *reconstruct_info,
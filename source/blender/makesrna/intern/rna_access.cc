@@ -4853,8 +4853,27 @@ static int rna_raw_access(ReportList *reports,
         return 1;
       }
 
-      /* Could also be faster with non-matching types,
-       * for now we just do slower loop. */
+      /* Convert between the raw types directly, which is much faster than the generic loop
+       * going through RNA for every item. This is common when passing arrays of a different type
+       * than the property, like double precision arrays for float properties. */
+      for (int a = 0; a < out.len; a++) {
+        RawArray item = out;
+        item.array = (char *)out.array + size_t(a) * out.stride;
+        for (int j = 0; j < arraylen; j++) {
+          const int in_index = a * arraylen + j;
+          double value;
+          if (set) {
+            RAW_GET(double, value, in, in_index);
+            RAW_SET(double, item, j, value);
+          }
+          else {
+            RAW_GET(double, value, item, j);
+            RAW_SET(double, in, in_index, value);
+          }
+        }
+      }
+
+      return 1;
     }
     BLI_assert_msg(itemlen == 0 || itemtype != PROP_ENUM,
                    "Enum array properties should not exist");
@@ -962,6 +962,16 @@ static void rna_def_pointcache_common(StructRNA *srna)
       {PTCACHE_COMPRESS_NO, "NO", 0, "None", "No compression"},
       {PTCACHE_COMPRESS_LZO, "LIGHT", 0, "Lite", "Fast but not so effective compression"},
       {PTCACHE_COMPRESS_LZMA, "HEAVY", 0, "Heavy", "Effective but slow compression"},
+      {PTCACHE_COMPRESS_ZSTD_FAST,
+       "ZSTD_FAST",
+       0,
+       "Zstd Fast",
+       "Fast compression that is also fast to read, more effective than Lite"},
+      {PTCACHE_COMPRESS_ZSTD_SLOW,
+       "ZSTD_SLOW",
+       0,
+       "Zstd Slow",
+       "Effective compression that is still fast to read, slower to write than Zstd Fast"},
       {0, nullptr, 0, nullptr, nullptr},
   };
 
@@ -6625,6 +6625,15 @@ static void rna_def_scene_ffmpeg_settings(BlenderRNA *brna)
       prop, "Encoding Speed", "Tradeoff between encoding speed and compression ratio");
   RNA_def_property_update(prop, NC_SCENE | ND_RENDER_OPTIONS, nullptr);
 
+  prop = RNA_def_property(srna, "use_hardware_encoder", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(prop, nullptr, "flags", FFMPEG_USE_HW_ENCODER);
+  RNA_def_property_clear_flag(prop, PROP_ANIMATABLE);
+  RNA_def_property_ui_text(prop,
+                           "Hardware Encoder",
+                           "Encode H.264 and AV1 video on the GPU when supported by the system, "
+                           "falling back to the software encoder otherwise");
+  RNA_def_property_update(prop, NC_SCENE | ND_RENDER_OPTIONS, nullptr);
+
   prop = RNA_def_property(srna, "use_autosplit", PROP_BOOLEAN, PROP_NONE);
   RNA_def_property_boolean_sdna(prop, nullptr, "flags", FFMPEG_AUTOSPLIT_OUTPUT);
   RNA_def_property_clear_flag(prop, PROP_ANIMATABLE);
@@ -8592,6 +8601,16 @@ static void rna_def_scene_eevee(BlenderRNA *brna)
   RNA_def_property_override_flag(prop, PROPOVERRIDE_OVERRIDABLE_LIBRARY);
   RNA_def_property_update(prop, NC_SCENE | ND_RENDER_OPTIONS, nullptr);
 
+  prop = RNA_def_property(srna, "use_shadow_static_cache", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(prop, nullptr, "flag", SCE_EEVEE_SHADOW_STATIC_CACHE);
+  RNA_def_property_ui_text(prop,
+                           "Static Shadow Cache",
+                           "Keep the shadows of static objects in a separate cache during "
+                           "animation playback, only re-rendering the shadows of moving objects. "
+                           "Doubles the shadow memory usage during playback");
+  RNA_def_property_override_flag(prop, PROPOVERRIDE_OVERRIDABLE_LIBRARY);
+  RNA_def_property_update(prop, NC_SCENE | ND_RENDER_OPTIONS, nullptr);
+
   prop = RNA_def_property(srna, "shadow_ray_count", PROP_INT, PROP_UNSIGNED);
   RNA_def_property_range(prop, 1, 4);
   RNA_def_property_ui_text(
@@ -10,6 +10,7 @@
 #include <cstdlib>
 
 #include "BLI_kdopbvh.h"
+#include "BLI_listbase.h"
 #include "BLI_math_matrix.h"
 #include "BLI_math_vector.h"
 #include "BLI_path_util.h"
@@ -33,7 +34,9 @@
 #  include "BKE_editmesh.hh"
 #  include "BKE_global.hh"
 #  include "BKE_image.h"
+#  include "BKE_node.hh"
 #  include "BKE_scene.hh"
+#  include "BKE_scene_runtime.hh"
 #  include "BKE_writemovie.hh"
 
 #  include "DEG_depsgraph_query.hh"
@@ -178,6 +181,33 @@ static void rna_Scene_ray_cast(Scene *scene,
   }
 }
 
+static void rna_Scene_compositor_node_statistics(Scene *scene,
+                                                 bNode *node,
+                                                 float *r_execution_time,
+                                                 float *r_memory_usage)
+{
+  *r_execution_time = 0.0f;
+  *r_memory_usage = 0.0f;
+
+  /* Statistics are only stored for the nodes of the compositing tree of the scene. Nodes inside
+   * node groups are not supported, since a node group can have multiple instances. */
+  if (!scene->nodetree || BLI_findindex(&scene->nodetree->nodes, node) == -1) {
+    return;
+  }
+
+  const bNodeInstanceKey key = blender::bke::node_instance_key(
+      blender::bke::NODE_INSTANCE_KEY_BASE, scene->nodetree, node);
+  const blender::bke::CompositorRuntime &compositor = scene->runtime->compositor;
+
+  const blender::timeit::Nanoseconds *execution_time =
+      compositor.per_node_execution_time.lookup_ptr(key);
+  if (execution_time) {
+    *r_execution_time = std::chrono::duration<float>(*execution_time).count();
+  }
+
+  *r_memory_usage = float(compositor.per_node_memory_usage.lookup_default(key, 0));
+}
+
 static void rna_Scene_sequencer_editing_free(Scene *scene)
 {
   SEQ_editing_free(scene, true);
@@ -334,6 +364,34 @@ void RNA_api_scene(StructRNA *srna)
   parm = RNA_def_float_matrix(func, "matrix", 4, 4, nullptr, 0.0f, 0.0f, "", "Matrix", 0.0f, 0.0f);
   RNA_def_function_output(func, parm);
 
+  /* Compositor. */
+  func = RNA_def_function(
+      srna, "compositor_node_statistics", "rna_Scene_compositor_node_statistics");
+  RNA_def_function_ui_description(
+      func, "Get the statistics of a node during the last evaluation of the compositor");
+  parm = RNA_def_pointer(func, "node", "Node", "", "Node in the compositing node tree");
+  RNA_def_parameter_flags(parm, PROP_NEVER_NULL, PARM_REQUIRED);
+  parm = RNA_def_float(func,
+                       "execution_time",
+                       0.0f,
+                       0.0f,
+                       FLT_MAX,
+                       "Execution Time",
+                       "Execution time of the node in seconds, including nodes inside of groups",
+                       0.0f,
+                       FLT_MAX);
+  RNA_def_function_output(func, parm);
+  parm = RNA_def_float(func,
+                       "memory_usage",
+                       0.0f,
+                       0.0f,
+                       FLT_MAX,
+                       "Memory Usage",
+                       "Size in bytes of the results of the node, including nodes inside of groups",
+                       0.0f,
+                       FLT_MAX);
+  RNA_def_function_output(func, parm);
+
   /* Sequencer. */
   func = RNA_def_function(srna, "sequence_editor_create", "SEQ_editing_ensure");
   RNA_def_function_ui_description(func, "Ensure sequence editor is valid in this scene");
@@ -312,6 +312,38 @@ static void rna_SequenceEditor_update_cache(Main * /*bmain*/, Scene *scene, Poin
   SEQ_cache_cleanup(scene);
 }
 
+static SeqDiskCacheStatistics rna_SequenceEditor_disk_cache_statistics(PointerRNA *ptr)
+{
+  SeqDiskCacheStatistics stats;
+  SEQ_cache_disk_statistics_get((Scene *)ptr->owner_id, &stats);
+  return stats;
+}
+
+static int rna_SequenceEditor_disk_cache_hits_get(PointerRNA *ptr)
+{
+  return rna_SequenceEditor_disk_cache_statistics(ptr).read_hits;
+}
+
+static int rna_SequenceEditor_disk_cache_misses_get(PointerRNA *ptr)
+{
+  return rna_SequenceEditor_disk_cache_statistics(ptr).read_misses;
+}
+
+static int rna_SequenceEditor_disk_cache_pending_writes_get(PointerRNA *ptr)
+{
+  return rna_SequenceEditor_disk_cache_statistics(ptr).pending_writes;
+}
+
+static int rna_SequenceEditor_disk_cache_skipped_writes_get(PointerRNA *ptr)
+{
+  return rna_SequenceEditor_disk_cache_statistics(ptr).writes_skipped;
+}
+
+static float rna_SequenceEditor_disk_cache_compression_ratio_get(PointerRNA *ptr)
+{
+  return rna_SequenceEditor_disk_cache_statistics(ptr).compression_ratio;
+}
+
 /* internal use */
 static int rna_SequenceEditor_elements_length(PointerRNA *ptr)
 {
@@ -2532,6 +2564,44 @@ static void rna_def_editor(BlenderRNA *brna)
       "Render frames ahead of current frame in the background for faster playback");
   RNA_def_property_update(prop, NC_SCENE | ND_SEQUENCER, nullptr);
 
+  prop = RNA_def_property(srna, "disk_cache_hits", PROP_INT, PROP_UNSIGNED);
+  RNA_def_property_clear_flag(prop, PROP_EDITABLE);
+  RNA_def_property_int_funcs(prop, "rna_SequenceEditor_disk_cache_hits_get", nullptr, nullptr);
+  RNA_def_property_ui_text(
+      prop, "Disk Cache Hits", "Number of images that were read from the disk cache");
+
+  prop = RNA_def_property(srna, "disk_cache_misses", PROP_INT, PROP_UNSIGNED);
+  RNA_def_property_clear_flag(prop, PROP_EDITABLE);
+  RNA_def_property_int_funcs(prop, "rna_SequenceEditor_disk_cache_misses_get", nullptr, nullptr);
+  RNA_def_property_ui_text(
+      prop, "Disk Cache Misses", "Number of images that were not found in the disk cache");
+
+  prop = RNA_def_property(srna, "disk_cache_pending_writes", PROP_INT, PROP_UNSIGNED);
+  RNA_def_property_clear_flag(prop, PROP_EDITABLE);
+  RNA_def_property_int_funcs(
+      prop, "rna_SequenceEditor_disk_cache_pending_writes_get", nullptr, nullptr);
+  RNA_def_property_ui_text(prop,
+                           "Disk Cache Pending Writes",
+                           "Number of images waiting to be written to the disk cache");
+
+  prop = RNA_def_property(srna, "disk_cache_skipped_writes", PROP_INT, PROP_UNSIGNED);
+  RNA_def_property_clear_flag(prop, PROP_EDITABLE);
+  RNA_def_property_int_funcs(
+      prop, "rna_SequenceEditor_disk_cache_skipped_writes_get", nullptr, nullptr);
+  RNA_def_property_ui_text(prop,
+                           "Disk Cache Skipped Writes",
+                           "Number of images that were not written to the disk cache, because "
+                           "writing could not keep up with rendering");
+
+  prop = RNA_def_property(srna, "disk_cache_compression_ratio", PROP_FLOAT, PROP_NONE);
+  RNA_def_property_clear_flag(prop, PROP_EDITABLE);
+  RNA_def_property_float_funcs(
+      prop, "rna_SequenceEditor_disk_cache_compression_ratio_get", nullptr, nullptr);
+  RNA_def_property_ui_text(prop,
+                           "Disk Cache Compression Ratio",
+                           "Size of images written to the disk cache divided by their size on "
+                           "disk");
+
   /* functions */
 
   func = RNA_def_function(srna, "display_stack", "rna_SequenceEditor_display_stack");
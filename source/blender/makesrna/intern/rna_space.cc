@@ -4585,6 +4585,14 @@ static void rna_def_space_view3d_overlay(BlenderRNA *brna)
   RNA_def_property_ui_text(prop, "Show Statistics", "Display scene statistics overlay text");
   RNA_def_property_update(prop, NC_SPACE | ND_SPACE_VIEW3D, nullptr);
 
+  prop = RNA_def_property(srna, "show_gpu_timings", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(prop, nullptr, "overlay.flag", V3D_OVERLAY_GPU_TIMINGS);
+  RNA_def_property_ui_text(
+      prop,
+      "Show GPU Timings",
+      "Display the GPU time spent in each render pass (only supported with OpenGL)");
+  RNA_def_property_update(prop, NC_SPACE | ND_SPACE_VIEW3D, nullptr);
+
   /* show camera composition guides */
   prop = RNA_def_property(srna, "show_camera_guides", PROP_BOOLEAN, PROP_NONE);
   RNA_def_property_boolean_sdna(prop, nullptr, "flag2", V3D_SHOW_CAMERA_GUIDES);
@@ -7833,6 +7841,15 @@ static void rna_def_space_node(BlenderRNA *brna)
   RNA_def_property_update(
       prop, NC_SPACE | ND_SPACE_NODE_VIEW, "rna_SpaceNodeEditor_show_backdrop_update");
 
+  prop = RNA_def_property(srna, "use_backdrop_visible_region", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(prop, nullptr, "flag", SNODE_BACKDRAW_VISIBLE_REGION);
+  RNA_def_property_ui_text(prop,
+                           "Visible Region Only",
+                           "Only compute the region of the viewer image that is visible in the "
+                           "backdrop, parts that become visible are computed when the backdrop is "
+                           "moved or zoomed (CPU compositor only)");
+  RNA_def_property_update(prop, NC_SPACE | ND_SPACE_NODE, nullptr);
+
   prop = RNA_def_property(srna, "geometry_nodes_tool_tree", PROP_POINTER, PROP_NONE);
   RNA_def_property_pointer_funcs(
       prop, nullptr, nullptr, nullptr, "rna_SpaceNodeEditor_geometry_nodes_tool_tree_poll");
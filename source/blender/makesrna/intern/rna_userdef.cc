@@ -5572,6 +5572,15 @@ static void rna_def_userdef_edit(BlenderRNA *brna)
   RNA_def_property_ui_text(
       prop, "Undo Memory Size", "Maximum memory usage in megabytes (0 means unlimited)");
 
+  prop = RNA_def_property(srna, "undo_compress_steps", PROP_INT, PROP_NONE);
+  RNA_def_property_int_sdna(prop, nullptr, "undo_compress_steps");
+  RNA_def_property_range(prop, 0, 255);
+  RNA_def_property_ui_text(prop,
+                           "Compress Undo Steps",
+                           "Compress the memory of global and sculpt undo steps older than this "
+                           "number of steps in the background, allowing more steps within the "
+                           "memory limit at the cost of slower undo (0 disables compression)");
+
   prop = RNA_def_property(srna, "use_global_undo", PROP_BOOLEAN, PROP_NONE);
   RNA_def_property_boolean_sdna(prop, nullptr, "uiflag", USER_GLOBALUNDO);
   RNA_def_property_ui_text(
@@ -6110,6 +6119,24 @@ static void rna_def_userdef_system(BlenderRNA *brna)
   RNA_def_property_enum_sdna(prop, nullptr, "sequencer_proxy_setup");
   RNA_def_property_ui_text(prop, "Proxy Setup", "When and how proxies are created");
 
+  prop = RNA_def_property(srna, "use_sequencer_hardware_decoding", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(
+      prop, nullptr, "sequencer_editor_flag", USER_SEQ_ED_HARDWARE_DECODE);
+  RNA_def_property_ui_text(prop,
+                           "Hardware Decoding",
+                           "Decode movie strips using the video decoder of the GPU when "
+                           "available (VA-API, NVDEC, VideoToolbox or D3D11VA), "
+                           "used for movies loaded after changing this option");
+
+  prop = RNA_def_property(srna, "use_sequencer_gpu_preview", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(prop, nullptr, "sequencer_editor_flag", USER_SEQ_ED_GPU_PREVIEW);
+  RNA_def_property_ui_text(prop,
+                           "GPU Preview",
+                           "Transform and blend image and movie strips on the GPU when drawing "
+                           "the preview, strips using effects or modifiers are still rendered "
+                           "on the CPU");
+  RNA_def_property_update(prop, 0, "rna_userdef_update");
+
   prop = RNA_def_property(srna, "scrollback", PROP_INT, PROP_UNSIGNED);
   RNA_def_property_int_sdna(prop, nullptr, "scrollback");
   RNA_def_property_range(prop, 32, 32768);
@@ -6196,6 +6223,25 @@ static void rna_def_userdef_system(BlenderRNA *brna)
       prop, "GL Texture Limit", "Limit the texture size to save graphics memory");
   RNA_def_property_update(prop, 0, "rna_userdef_gl_texture_limit_update");
 
+  prop = RNA_def_property(srna, "use_texture_streaming", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(prop, nullptr, "gpu_flag", USER_GPU_FLAG_TEXTURE_STREAMING);
+  RNA_def_property_ui_text(prop,
+                           "Texture Streaming",
+                           "Upload material image textures at a low resolution first and "
+                           "progressively increase their resolution while they are displayed");
+  RNA_def_property_update(prop, 0, "rna_userdef_gl_texture_limit_update");
+
+  prop = RNA_def_property(srna, "texture_streaming_budget", PROP_INT, PROP_NONE);
+  RNA_def_property_int_sdna(prop, nullptr, "texture_streaming_budget");
+  RNA_def_property_range(prop, 0, INT_MAX);
+  RNA_def_property_ui_range(prop, 0, 65536, 256, -1);
+  RNA_def_property_ui_text(prop,
+                           "Texture Streaming Budget",
+                           "Maximum amount of graphics memory in MiB used by image textures "
+                           "before streamed textures stop increasing in resolution "
+                           "(set to 0 for no limit)");
+  RNA_def_property_update(prop, 0, "rna_userdef_update");
+
   prop = RNA_def_property(srna, "texture_time_out", PROP_INT, PROP_NONE);
   RNA_def_property_int_sdna(prop, nullptr, "textimeout");
   RNA_def_property_range(prop, 0, 3600);
@@ -7447,6 +7493,28 @@ static void rna_def_userdef_experimental(BlenderRNA *brna)
   RNA_def_property_boolean_sdna(prop, nullptr, "enable_new_cpu_compositor", 1);
   RNA_def_property_ui_text(prop, "CPU Compositor", "Enable the new CPU compositor");
 
+  prop = RNA_def_property(srna, "use_incremental_save", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(prop, nullptr, "use_incremental_save", 1);
+  RNA_def_property_ui_text(prop,
+                           "Incremental Save",
+                           "When saving a compressed file again, reuse the compressed data of "
+                           "data-blocks which did not change since the previous save");
+
+  prop = RNA_def_property(srna, "use_async_save", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(prop, nullptr, "use_async_save", 1);
+  RNA_def_property_ui_text(prop,
+                           "Background Save",
+                           "Only gather the file data when saving, and compress and write it to "
+                           "disk in the background");
+
+  prop = RNA_def_property(srna, "use_viewport_mesh_lod", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(prop, nullptr, "use_viewport_mesh_lod", 1);
+  RNA_def_property_ui_text(prop,
+                           "Viewport Mesh LOD",
+                           "Draw decimated versions of dense meshes that are small on screen in "
+                           "the viewport. The decimated meshes are generated in the background");
+  RNA_def_property_update(prop, 0, "rna_userdef_update");
+
   prop = RNA_def_property(srna, "use_all_linked_data_direct", PROP_BOOLEAN, PROP_NONE);
   RNA_def_property_ui_text(
       prop,
@@ -11,6 +11,7 @@
 #include "MOD_lineart.h"
 
 #include "BLI_listbase.h"
+#include "BLI_map.hh"
 #include "BLI_math_base.hh"
 #include "BLI_math_geom.h"
 #include "BLI_math_matrix.h"
@@ -20,6 +21,7 @@
 #include "BLI_sort.hh"
 #include "BLI_string.h"
 #include "BLI_task.h"
+#include "BLI_task.hh"
 #include "BLI_time.h"
 #include "BLI_utildefines.h"
 #include "BLI_vector.hh"
@@ -4663,89 +4665,117 @@ static void lineart_create_edges_from_isec_data(LineartIsecData *d)
 
   /* We don't care about removing duplicated vert in this method, chaining can handle that,
    * and it saves us from using locks and look up tables. */
-  LineartVert *v = static_cast<LineartVert *>(
+  LineartVert *isec_verts = static_cast<LineartVert *>(
       lineart_mem_acquire(ld->edge_data_pool, sizeof(LineartVert) * total_lines * 2));
-  LineartEdge *e = static_cast<LineartEdge *>(
+  LineartEdge *isec_edges = static_cast<LineartEdge *>(
       lineart_mem_acquire(ld->edge_data_pool, sizeof(LineartEdge) * total_lines));
-  LineartEdgeSegment *es = static_cast<LineartEdgeSegment *>(
+  LineartEdgeSegment *isec_segments = static_cast<LineartEdgeSegment *>(
       lineart_mem_acquire(ld->edge_data_pool, sizeof(LineartEdgeSegment) * total_lines));
 
   LineartElementLinkNode *eln = static_cast<LineartElementLinkNode *>(
       lineart_mem_acquire(ld->edge_data_pool, sizeof(LineartElementLinkNode)));
   eln->element_count = total_lines;
-  eln->pointer = e;
+  eln->pointer = isec_edges;
   eln->flags |= LRT_ELEMENT_INTERSECTION_DATA;
   BLI_addhead(&ld->geom.line_buffer_pointers, eln);
 
+  /* Look up the object of every object index once instead of searching the buffer list for each
+   * intersection line. The first match is kept, like #lineart_find_matching_eln. */
+  blender::Map<int, Object *> object_by_obindex;
+  LISTBASE_FOREACH (LineartElementLinkNode *, line_eln, &ld->geom.line_buffer_pointers) {
+    object_by_obindex.add(line_eln->obindex, static_cast<Object *>(line_eln->object_ref));
+  }
+
+  /* Make room for all new edges, so they can be filled in parallel. */
+  LineartPendingEdges *pe = &ld->pending_edges;
+  if (pe->next + total_lines > pe->max) {
+    const int new_max = std::max(pe->max * 2, pe->next + total_lines);
+    LineartEdge **new_array = static_cast<LineartEdge **>(
+        MEM_mallocN(sizeof(LineartEdge *) * new_max, "LineartPendingEdges array"));
+    if (LIKELY(pe->array)) {
+      memcpy(new_array, pe->array, sizeof(LineartEdge *) * pe->next);
+      MEM_freeN(pe->array);
+    }
+    pe->max = new_max;
+    pe->array = new_array;
+  }
+
+  int thread_offset = 0;
   for (int i = 0; i < d->thread_count; i++) {
     LineartIsecThread *th = &d->threads[i];
     if (!th->current) {
       continue;
     }
 
-    for (int j = 0; j < th->current; j++) {
-      LineartIsecSingle *is = &th->array[j];
-      LineartVert *v1 = v;
-      LineartVert *v2 = v + 1;
-      copy_v3_v3_db(v1->gloc, is->v1);
-      copy_v3_v3_db(v2->gloc, is->v2);
-      /* The intersection line has been generated only in geometry space, so we need to transform
-       * them as well. */
-      mul_v4_m4v3_db(v1->fbcoord, ld->conf.view_projection, v1->gloc);
-      mul_v4_m4v3_db(v2->fbcoord, ld->conf.view_projection, v2->gloc);
-      mul_v3db_db(v1->fbcoord, (1 / v1->fbcoord[3]));
-      mul_v3db_db(v2->fbcoord, (1 / v2->fbcoord[3]));
-
-      v1->fbcoord[0] -= ld->conf.shift_x * 2;
-      v1->fbcoord[1] -= ld->conf.shift_y * 2;
-      v2->fbcoord[0] -= ld->conf.shift_x * 2;
-      v2->fbcoord[1] -= ld->conf.shift_y * 2;
-
-      /* This z transformation is not the same as the rest of the part, because the data don't go
-       * through normal perspective division calls in the pipeline, but this way the 3D result and
-       * occlusion on the generated line is correct, and we don't really use 2D for viewport stroke
-       * generation anyway. */
-      v1->fbcoord[2] = ZMin * ZMax / (ZMax - fabs(v1->fbcoord[2]) * (ZMax - ZMin));
-      v2->fbcoord[2] = ZMin * ZMax / (ZMax - fabs(v2->fbcoord[2]) * (ZMax - ZMin));
-      e->v1 = v1;
-      e->v2 = v2;
-      e->t1 = is->tri1;
-      e->t2 = is->tri2;
-      /* This is so we can also match intersection edges from shadow to later viewing stage. */
-      e->edge_identifier = (uint64_t(e->t1->target_reference) << 32) | e->t2->target_reference;
-      e->flags = MOD_LINEART_EDGE_FLAG_INTERSECTION;
-      e->intersection_mask = (is->tri1->intersection_mask | is->tri2->intersection_mask);
-      BLI_addtail(&e->segments, es);
-
-      int obi1 = (e->t1->target_reference & LRT_OBINDEX_HIGHER);
-      int obi2 = (e->t2->target_reference & LRT_OBINDEX_HIGHER);
-      LineartElementLinkNode *eln1 = lineart_find_matching_eln(&ld->geom.line_buffer_pointers,
-                                                               obi1);
-      LineartElementLinkNode *eln2 = obi1 == obi2 ? eln1 :
-                                                    lineart_find_matching_eln(
-                                                        &ld->geom.line_buffer_pointers, obi2);
-      Object *ob1 = eln1 ? static_cast<Object *>(eln1->object_ref) : nullptr;
-      Object *ob2 = eln2 ? static_cast<Object *>(eln2->object_ref) : nullptr;
-      if (e->t1->intersection_priority > e->t2->intersection_priority) {
-        e->object_ref = ob1;
-      }
-      else if (e->t1->intersection_priority < e->t2->intersection_priority) {
-        e->object_ref = ob2;
-      }
-      else { /* equal priority */
-        if (ob1 == ob2) {
-          /* object_ref should be ambiguous if intersection lines comes from different objects. */
-          e->object_ref = ob1;
-        }
-      }
+    LineartVert *th_v = isec_verts + thread_offset * 2;
+    LineartEdge *th_e = isec_edges + thread_offset;
+    LineartEdgeSegment *th_es = isec_segments + thread_offset;
+    LineartEdge **th_pending = pe->array + pe->next + thread_offset;
+
+    blender::threading::parallel_for(
+        blender::IndexRange(th->current), 1024, [&](const blender::IndexRange range) {
+          for (const int j : range) {
+            LineartIsecSingle *is = &th->array[j];
+            LineartVert *v1 = &th_v[j * 2];
+            LineartVert *v2 = &th_v[j * 2 + 1];
+            LineartEdge *e = &th_e[j];
+            copy_v3_v3_db(v1->gloc, is->v1);
+            copy_v3_v3_db(v2->gloc, is->v2);
+            /* The intersection line has been generated only in geometry space, so we need to
+             * transform them as well. */
+            mul_v4_m4v3_db(v1->fbcoord, ld->conf.view_projection, v1->gloc);
+            mul_v4_m4v3_db(v2->fbcoord, ld->conf.view_projection, v2->gloc);
+            mul_v3db_db(v1->fbcoord, (1 / v1->fbcoord[3]));
+            mul_v3db_db(v2->fbcoord, (1 / v2->fbcoord[3]));
+
+            v1->fbcoord[0] -= ld->conf.shift_x * 2;
+            v1->fbcoord[1] -= ld->conf.shift_y * 2;
+            v2->fbcoord[0] -= ld->conf.shift_x * 2;
+            v2->fbcoord[1] -= ld->conf.shift_y * 2;
+
+            /* This z transformation is not the same as the rest of the part, because the data
+             * don't go through normal perspective division calls in the pipeline, but this way
+             * the 3D result and occlusion on the generated line is correct, and we don't really
+             * use 2D for viewport stroke generation anyway. */
+            v1->fbcoord[2] = ZMin * ZMax / (ZMax - fabs(v1->fbcoord[2]) * (ZMax - ZMin));
+            v2->fbcoord[2] = ZMin * ZMax / (ZMax - fabs(v2->fbcoord[2]) * (ZMax - ZMin));
+            e->v1 = v1;
+            e->v2 = v2;
+            e->t1 = is->tri1;
+            e->t2 = is->tri2;
+            /* This is so we can also match intersection edges from shadow to later viewing
+             * stage. */
+            e->edge_identifier = (uint64_t(e->t1->target_reference) << 32) |
+                                 e->t2->target_reference;
+            e->flags = MOD_LINEART_EDGE_FLAG_INTERSECTION;
+            e->intersection_mask = (is->tri1->intersection_mask | is->tri2->intersection_mask);
+            BLI_addtail(&e->segments, &th_es[j]);
+
+            int obi1 = (e->t1->target_reference & LRT_OBINDEX_HIGHER);
+            int obi2 = (e->t2->target_reference & LRT_OBINDEX_HIGHER);
+            Object *ob1 = object_by_obindex.lookup_default(obi1, nullptr);
+            Object *ob2 = object_by_obindex.lookup_default(obi2, nullptr);
+            if (e->t1->intersection_priority > e->t2->intersection_priority) {
+              e->object_ref = ob1;
+            }
+            else if (e->t1->intersection_priority < e->t2->intersection_priority) {
+              e->object_ref = ob2;
+            }
+            else { /* equal priority */
+              if (ob1 == ob2) {
+                /* object_ref should be ambiguous if intersection lines comes from different
+                 * objects. */
+                e->object_ref = ob1;
+              }
+            }
 
-      lineart_add_edge_to_array(&ld->pending_edges, e);
+            th_pending[j] = e;
+          }
+        });
 
-      v += 2;
-      e++;
-      es++;
-    }
+    thread_offset += th->current;
   }
+  pe->next += total_lines;
 }
 
 void lineart_main_add_triangles(LineartData *ld)
@@ -424,6 +424,17 @@ struct GeometryNodesLazyFunctionGraphInfo {
    * This can be used as a simple heuristic for the complexity of the node group.
    */
   int num_inline_nodes_approximate = 0;
+  /**
+   * Identifies this graph for the cache of group outputs. Unlike the pointer, it is never reused
+   * when the graph is rebuilt, so cached outputs of an outdated graph are never found again.
+   */
+  uint64_t unique_id = 0;
+  /**
+   * True when the outputs of the group only depend on its inputs, i.e. the group (including
+   * nested groups) does not reference any data-blocks and does not use nodes that depend on the
+   * evaluation context like the scene time or the object the modifier is on.
+   */
+  bool outputs_only_depend_on_inputs = false;
 };
 
 std::unique_ptr<LazyFunction> get_simulation_output_lazy_function(
@@ -7,7 +7,12 @@
 
 #include "DNA_space_types.h"
 
+#include "BLI_fileops.h"
+#include "BLI_generic_key.hh"
+#include "BLI_hash.hh"
+
 #include "BKE_node.hh"
+#include "BKE_report.hh"
 
 #include "NOD_rna_define.hh"
 #include "NOD_socket.hh"
@@ -49,6 +54,77 @@ void search_link_ops_for_import_node(GatherLinkSearchOpParams &params)
   }
 }
 
+/**
+ * Identifies an imported file in the #memory_cache.
+ */
+class ImportedFileCacheKey : public GenericKey {
+ public:
+  std::string importer;
+  std::string path;
+  int64_t modification_time;
+  int64_t size;
+
+  uint64_t hash() const override
+  {
+    return get_default_hash(this->importer, this->path, this->modification_time, this->size);
+  }
+
+  BLI_STRUCT_EQUALITY_OPERATORS_4(ImportedFileCacheKey, importer, path, modification_time, size)
+
+  bool equal_to(const GenericKey &other) const override
+  {
+    if (const auto *other_typed = dynamic_cast<const ImportedFileCacheKey *>(&other)) {
+      return *this == *other_typed;
+    }
+    return false;
+  }
+
+  std::unique_ptr<GenericKey> to_storable() const override
+  {
+    return std::make_unique<ImportedFileCacheKey>(*this);
+  }
+};
+
+void ImportedFileCacheValue::add_reports(const ReportList &reports)
+{
+  LISTBASE_FOREACH (const Report *, report, &reports.list) {
+    const NodeWarningType type = report->type == RPT_ERROR ? NodeWarningType::Error :
+                                                             NodeWarningType::Info;
+    this->warnings.append({type, report->message});
+  }
+}
+
+void ImportedFileCacheValue::count_memory(MemoryCounter &memory) const
+{
+  this->geometry.count_memory(memory);
+}
+
+std::shared_ptr<const ImportedFileCacheValue> import_file_cached(
+    const StringRef importer,
+    const std::string &path,
+    const FunctionRef<std::unique_ptr<ImportedFileCacheValue>()> import_fn)
+{
+  BLI_stat_t stat;
+  if (BLI_stat(path.c_str(), &stat) != 0) {
+    /* Let the importer report the missing file, but don't cache that. */
+    return import_fn();
+  }
+
+  ImportedFileCacheKey key;
+  key.importer = importer;
+  key.path = path;
+  key.modification_time = int64_t(stat.st_mtime);
+  key.size = int64_t(stat.st_size);
+  return memory_cache::get<ImportedFileCacheValue>(key, import_fn);
+}
+
+void add_import_warnings(GeoNodeExecParams &params, const ImportedFileCacheValue &value)
+{
+  for (const std::pair<NodeWarningType, std::string> &warning : value.warnings) {
+    params.error_message_add(warning.first, TIP_(warning.second.c_str()));
+  }
+}
+
 namespace enums {
 
 const EnumPropertyItem *attribute_type_type_with_socket_fn(bContext * /*C*/,
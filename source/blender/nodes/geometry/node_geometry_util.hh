@@ -6,6 +6,9 @@
 
 #include "MEM_guardedalloc.h"
 
+#include "BLI_function_ref.hh"
+#include "BLI_memory_cache.hh"
+
 #include "BKE_node.hh"
 #include "BKE_node_socket_value.hh"
 
@@ -17,6 +20,7 @@
 #include "node_util.hh"
 
 struct BVHTreeFromMesh;
+struct ReportList;
 namespace blender::nodes {
 class GatherAddNodeSearchParams;
 class GatherLinkSearchOpParams;
@@ -34,6 +38,34 @@ void search_link_ops_for_tool_node(GatherLinkSearchOpParams &params);
 void search_link_ops_for_volume_grid_node(GatherLinkSearchOpParams &params);
 void search_link_ops_for_import_node(GatherLinkSearchOpParams &params);
 
+/**
+ * Geometry and warnings of a file read by an import node, kept in the #memory_cache.
+ */
+class ImportedFileCacheValue : public memory_cache::CachedValue {
+ public:
+  bke::GeometrySet geometry;
+  Vector<std::pair<NodeWarningType, std::string>> warnings;
+
+  /** Store the reports of the importer, to show them as node warnings. */
+  void add_reports(const ReportList &reports);
+
+  void count_memory(MemoryCounter &memory) const override;
+};
+
+/**
+ * Read a file for an import node through the #memory_cache, so that re-evaluating node trees does
+ * not read and parse the same file again. Besides the path, cached results are identified by the
+ * modification time and size of the file, and by the importer name, which has to be different
+ * for different import options.
+ */
+std::shared_ptr<const ImportedFileCacheValue> import_file_cached(
+    StringRef importer,
+    const std::string &path,
+    FunctionRef<std::unique_ptr<ImportedFileCacheValue>()> import_fn);
+
+/** Add the warnings of an imported file to the node. */
+void add_import_warnings(GeoNodeExecParams &params, const ImportedFileCacheValue &value);
+
 void get_closest_in_bvhtree(BVHTreeFromMesh &tree_data,
                             const VArray<float3> &positions,
                             const IndexMask &mask,
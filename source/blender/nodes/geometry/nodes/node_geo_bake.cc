@@ -800,6 +800,10 @@ void draw_common_bake_settings(BakeDrawContext &ctx, uiLayout *layout)
     uiLayoutSetActive(subcol, ctx.bake->flag & NODES_MODIFIER_BAKE_CUSTOM_PATH);
     uiItemR(subcol, &ctx.bake_rna, "directory", UI_ITEM_NONE, IFACE_("Path"), ICON_NONE);
   }
+  {
+    uiLayout *col = uiLayoutColumn(settings_col, true);
+    uiItemR(col, &ctx.bake_rna, "use_compression", UI_ITEM_NONE, IFACE_("Compress"), ICON_NONE);
+  }
   {
     uiLayout *col = uiLayoutColumn(settings_col, true);
     uiItemR(col,
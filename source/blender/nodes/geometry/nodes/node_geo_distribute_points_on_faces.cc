@@ -100,6 +100,26 @@ static math::Quaternion normal_to_rotation(const float3 normal)
   return math::normalize(math::Quaternion(quat));
 }
 
+/**
+ * Every triangle has its own random number generator that only depends on the triangle index and
+ * the seed. That makes the samples of a triangle independent from all other triangles, which
+ * allows generating them in parallel, and keeps them stable when other parts of the mesh change.
+ */
+static RandomNumberGenerator corner_tri_rng(const int tri_i,
+                                            const int seed,
+                                            const float3 &v0_pos,
+                                            const float3 &v1_pos,
+                                            const float3 &v2_pos,
+                                            const float base_density,
+                                            const float density_factor,
+                                            int &r_point_amount)
+{
+  const float area = area_tri_v3(v0_pos, v1_pos, v2_pos);
+  RandomNumberGenerator rng(noise::hash(tri_i, seed));
+  r_point_amount = rng.round_probabilistic(area * base_density * density_factor);
+  return rng;
+}
+
 static void sample_mesh_surface(const Mesh &mesh,
                                 const float base_density,
                                 const Span<float> density_factors,
@@ -112,40 +132,59 @@ static void sample_mesh_surface(const Mesh &mesh,
   const Span<int> corner_verts = mesh.corner_verts();
   const Span<int3> corner_tris = mesh.corner_tris();
 
-  for (const int tri_i : corner_tris.index_range()) {
-    const int3 &tri = corner_tris[tri_i];
-    const int v0_loop = tri[0];
-    const int v1_loop = tri[1];
-    const int v2_loop = tri[2];
-    const float3 &v0_pos = positions[corner_verts[v0_loop]];
-    const float3 &v1_pos = positions[corner_verts[v1_loop]];
-    const float3 &v2_pos = positions[corner_verts[v2_loop]];
-
-    float corner_tri_density_factor = 1.0f;
-    if (!density_factors.is_empty()) {
-      const float v0_density_factor = std::max(0.0f, density_factors[v0_loop]);
-      const float v1_density_factor = std::max(0.0f, density_factors[v1_loop]);
-      const float v2_density_factor = std::max(0.0f, density_factors[v2_loop]);
-      corner_tri_density_factor = (v0_density_factor + v1_density_factor + v2_density_factor) /
-                                  3.0f;
+  auto tri_density_factor = [&](const int3 &tri) {
+    if (density_factors.is_empty()) {
+      return 1.0f;
     }
-    const float area = area_tri_v3(v0_pos, v1_pos, v2_pos);
-
-    const int corner_tri_seed = noise::hash(tri_i, seed);
-    RandomNumberGenerator corner_tri_rng(corner_tri_seed);
-
-    const int point_amount = corner_tri_rng.round_probabilistic(area * base_density *
-                                                                corner_tri_density_factor);
+    const float v0_density_factor = std::max(0.0f, density_factors[tri[0]]);
+    const float v1_density_factor = std::max(0.0f, density_factors[tri[1]]);
+    const float v2_density_factor = std::max(0.0f, density_factors[tri[2]]);
+    return (v0_density_factor + v1_density_factor + v2_density_factor) / 3.0f;
+  };
 
-    for (int i = 0; i < point_amount; i++) {
-      const float3 bary_coord = corner_tri_rng.get_barycentric_coordinates();
-      float3 point_pos;
-      interp_v3_v3v3v3(point_pos, v0_pos, v1_pos, v2_pos, bary_coord);
-      r_positions.append(point_pos);
-      r_bary_coords.append(bary_coord);
-      r_tri_indices.append(tri_i);
+  /* Count the points in every triangle first, so that the samples can be written to their final
+   * position in parallel. The order is the same as when sampling the triangles one by one. */
+  Array<int> offset_data(corner_tris.size() + 1);
+  threading::parallel_for(corner_tris.index_range(), 2048, [&](const IndexRange range) {
+    for (const int tri_i : range) {
+      const int3 &tri = corner_tris[tri_i];
+      corner_tri_rng(tri_i,
+                     seed,
+                     positions[corner_verts[tri[0]]],
+                     positions[corner_verts[tri[1]]],
+                     positions[corner_verts[tri[2]]],
+                     base_density,
+                     tri_density_factor(tri),
+                     offset_data[tri_i]);
     }
-  }
+  });
+  const OffsetIndices<int> offsets = offset_indices::accumulate_counts_to_offsets(offset_data);
+
+  r_positions.resize(offsets.total_size());
+  r_bary_coords.resize(offsets.total_size());
+  r_tri_indices.resize(offsets.total_size());
+  threading::parallel_for(corner_tris.index_range(), 1024, [&](const IndexRange range) {
+    for (const int tri_i : range) {
+      const IndexRange points = offsets[tri_i];
+      if (points.is_empty()) {
+        continue;
+      }
+      const int3 &tri = corner_tris[tri_i];
+      const float3 &v0_pos = positions[corner_verts[tri[0]]];
+      const float3 &v1_pos = positions[corner_verts[tri[1]]];
+      const float3 &v2_pos = positions[corner_verts[tri[2]]];
+      int point_amount;
+      RandomNumberGenerator rng = corner_tri_rng(
+          tri_i, seed, v0_pos, v1_pos, v2_pos, base_density, tri_density_factor(tri), point_amount);
+      BLI_assert(point_amount == points.size());
+      for (const int i : points) {
+        const float3 bary_coord = rng.get_barycentric_coordinates();
+        interp_v3_v3v3v3(r_positions[i], v0_pos, v1_pos, v2_pos, bary_coord);
+        r_bary_coords[i] = bary_coord;
+      }
+      r_tri_indices.as_mutable_span().slice(points).fill(tri_i);
+    }
+  });
 }
 
 BLI_NOINLINE static KDTree_3d *build_kdtree(Span<float3> positions)
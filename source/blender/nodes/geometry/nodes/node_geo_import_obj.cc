@@ -35,42 +35,41 @@ static void node_geo_exec(GeoNodeExecParams params)
     return;
   }
 
-  OBJImportParams import_params;
-  STRNCPY(import_params.filepath, path.c_str());
-
-  ReportList reports;
-  BKE_reports_init(&reports, RPT_STORE);
-  BLI_SCOPED_DEFER([&]() { BKE_reports_free(&reports); });
-  import_params.reports = &reports;
-
-  Vector<bke::GeometrySet> geometries;
-  OBJ_import_geometries(&import_params, geometries);
-
-  LISTBASE_FOREACH (Report *, report, &(import_params.reports)->list) {
-    NodeWarningType type;
-    switch (report->type) {
-      case RPT_ERROR:
-        type = NodeWarningType::Error;
-        break;
-      default:
-        type = NodeWarningType::Info;
-        break;
-    }
-    params.error_message_add(type, TIP_(report->message));
-  }
-
-  if (geometries.is_empty()) {
+  std::shared_ptr<const ImportedFileCacheValue> value = import_file_cached(
+      "OBJ", path, [&]() {
+        OBJImportParams import_params;
+        STRNCPY(import_params.filepath, path.c_str());
+
+        ReportList reports;
+        BKE_reports_init(&reports, RPT_STORE);
+        BLI_SCOPED_DEFER([&]() { BKE_reports_free(&reports); });
+        import_params.reports = &reports;
+
+        Vector<bke::GeometrySet> geometries;
+        OBJ_import_geometries(&import_params, geometries);
+
+        auto value = std::make_unique<ImportedFileCacheValue>();
+        value->add_reports(reports);
+        if (geometries.is_empty()) {
+          return value;
+        }
+
+        bke::Instances *instances = new bke::Instances();
+        for (GeometrySet geometry : geometries) {
+          const int handle = instances->add_reference(bke::InstanceReference{std::move(geometry)});
+          instances->add_instance(handle, float4x4::identity());
+        }
+        value->geometry = GeometrySet::from_instances(instances);
+        return value;
+      });
+
+  add_import_warnings(params, *value);
+  if (!value->geometry.has_instances()) {
     params.set_default_remaining_outputs();
     return;
   }
 
-  bke::Instances *instances = new bke::Instances();
-  for (GeometrySet geometry : geometries) {
-    const int handle = instances->add_reference(bke::InstanceReference{std::move(geometry)});
-    instances->add_instance(handle, float4x4::identity());
-  }
-
-  params.set_output("Instances", GeometrySet::from_instances(instances));
+  params.set_output("Instances", value->geometry);
 #else
   params.error_message_add(NodeWarningType::Error,
                            TIP_("Disabled, Blender was compiled without OBJ I/O"));
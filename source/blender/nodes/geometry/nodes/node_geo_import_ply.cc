@@ -33,31 +33,25 @@ static void node_geo_exec(GeoNodeExecParams params)
     return;
   }
 
-  PLYImportParams import_params{};
-  STRNCPY(import_params.filepath, path.c_str());
-  import_params.import_attributes = true;
-
-  ReportList reports;
-  BKE_reports_init(&reports, RPT_STORE);
-  BLI_SCOPED_DEFER([&]() { BKE_reports_free(&reports); })
-  import_params.reports = &reports;
-
-  Mesh *mesh = PLY_import_mesh(&import_params);
-
-  LISTBASE_FOREACH (Report *, report, &(import_params.reports)->list) {
-    NodeWarningType type;
-    switch (report->type) {
-      case RPT_ERROR:
-        type = NodeWarningType::Error;
-        break;
-      default:
-        type = NodeWarningType::Info;
-        break;
-    }
-    params.error_message_add(type, TIP_(report->message));
-  }
-
-  params.set_output("Mesh", GeometrySet::from_mesh(mesh));
+  std::shared_ptr<const ImportedFileCacheValue> value = import_file_cached(
+      "PLY", path, [&]() {
+        PLYImportParams import_params{};
+        STRNCPY(import_params.filepath, path.c_str());
+        import_params.import_attributes = true;
+
+        ReportList reports;
+        BKE_reports_init(&reports, RPT_STORE);
+        BLI_SCOPED_DEFER([&]() { BKE_reports_free(&reports); })
+        import_params.reports = &reports;
+
+        auto value = std::make_unique<ImportedFileCacheValue>();
+        value->geometry = GeometrySet::from_mesh(PLY_import_mesh(&import_params));
+        value->add_reports(reports);
+        return value;
+      });
+
+  add_import_warnings(params, *value);
+  params.set_output("Mesh", value->geometry);
 
 #else
   params.error_message_add(NodeWarningType::Error,
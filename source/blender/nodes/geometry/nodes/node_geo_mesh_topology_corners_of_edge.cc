@@ -50,11 +50,8 @@ class CornersOfEdgeInput final : public bke::MeshFieldInput {
                                  const IndexMask &mask) const final
   {
     const IndexRange edge_range(mesh.edges_num);
-    Array<int> map_offsets;
-    Array<int> map_indices;
     const Span<int> corner_edges = mesh.corner_edges();
-    const GroupedSpan<int> edge_to_loop_map = bke::mesh::build_edge_to_corner_map(
-        mesh.corner_edges(), mesh.edges_num, map_offsets, map_indices);
+    const GroupedSpan<int> edge_to_loop_map = mesh.edge_to_corner_map();
 
     const bke::MeshFieldContext context{mesh, domain};
     fn::FieldEvaluator evaluator{context, &mask};
@@ -49,11 +49,7 @@ class EdgesOfVertInput final : public bke::MeshFieldInput {
                                  const IndexMask &mask) const final
   {
     const IndexRange vert_range(mesh.verts_num);
-    const Span<int2> edges = mesh.edges();
-    Array<int> map_offsets;
-    Array<int> map_indices;
-    const GroupedSpan<int> vert_to_edge_map = bke::mesh::build_vert_to_edge_map(
-        edges, mesh.verts_num, map_offsets, map_indices);
+    const GroupedSpan<int> vert_to_edge_map = mesh.vert_to_edge_map();
 
     const bke::MeshFieldContext context{mesh, domain};
     fn::FieldEvaluator evaluator{context, &mask};
@@ -62,7 +62,14 @@ static void grouped_sort(const OffsetIndices<int> offsets,
   threading::parallel_for(offsets.index_range(), 250, [&](const IndexRange range) {
     for (const int group_index : range) {
       MutableSpan<int> group = indices.slice(offsets[group_index]);
-      parallel_sort(group.begin(), group.end(), comparator);
+      if (group.size() > 4096) {
+        /* The indices of every group are in ascending order, so the stable radix sort has the
+         * same result as the comparator. */
+        parallel_radix_sort_indices_by_key(weights, group);
+      }
+      else {
+        parallel_sort(group.begin(), group.end(), comparator);
+      }
     }
   });
 }
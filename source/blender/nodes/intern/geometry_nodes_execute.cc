@@ -6,6 +6,8 @@
  * \ingroup nodes
  */
 
+#include "MEM_guardedalloc.h"
+
 #include "BLI_math_color.hh"
 #include "BLI_math_euler.hh"
 #include "BLI_math_quaternion.hh"
@@ -934,6 +936,7 @@ bke::GeometrySet execute_geometry_nodes_on_geometry(const bNodeTree &btree,
                                                     GeoNodesCallData &call_data,
                                                     bke::GeometrySet input_geometry)
 {
+  MEM_TagScope mem_tag_scope(MEM_TAG_GEOMETRY);
   const nodes::GeometryNodesLazyFunctionGraphInfo &lf_graph_info =
       *nodes::ensure_geometry_nodes_lazy_function_graph(btree);
   const GeometryNodesGroupFunction &function = lf_graph_info.function;
@@ -32,8 +32,12 @@
 #include "BLI_dot_export.hh"
 #include "BLI_hash.h"
 #include "BLI_hash_md5.hh"
+#include "BLI_generic_key.hh"
 #include "BLI_lazy_threading.hh"
 #include "BLI_map.hh"
+#include "BLI_memory_cache.hh"
+#include "BLI_memory_counter.hh"
+#include "BLI_time.h"
 
 #include "DNA_ID.h"
 
@@ -49,6 +53,7 @@
 #include "FN_lazy_function_execute.hh"
 #include "FN_lazy_function_graph_executor.hh"
 
+#include "DEG_depsgraph_debug.hh"
 #include "DEG_depsgraph_query.hh"
 
 #include <fmt/format.h>
@@ -249,10 +254,24 @@ class LazyFunctionForGeometryNode : public LazyFunction {
         own_lf_graph_info_.mapping.lf_input_index_for_attribute_propagation_to_output,
         get_anonymous_attribute_name};
 
+    const bool use_trace = DEG_debug_trace_is_recording();
+    const double trace_start_time = use_trace ? BLI_time_now_seconds() : 0.0;
+
     geo_eval_log::TimePoint start_time = geo_eval_log::Clock::now();
     node_.typeinfo->geometry_node_execute(geo_params);
     geo_eval_log::TimePoint end_time = geo_eval_log::Clock::now();
 
+    if (use_trace) {
+      const double trace_end_time = BLI_time_now_seconds();
+      const bNodeTree &tree = node_.owner_tree();
+      DEG_debug_trace_add_event("geometry_nodes",
+                                node_.name,
+                                fmt::format("{} ({})", tree.id.name + 2, node_.idname),
+                                trace_start_time,
+                                trace_end_time);
+      DEG_debug_trace_add_memory_usage(trace_end_time);
+    }
+
     if (geo_eval_log::GeoTreeLogger *tree_logger = local_user_data.try_get_tree_logger(*user_data))
     {
       tree_logger->node_execution_times.append(*tree_logger->allocator,
@@ -1072,15 +1091,92 @@ static bool should_log_socket_values_for_context(const GeoNodesLFUserData &user_
   return true;
 }
 
+/**
+ * Identifies the outputs of a node group evaluated with specific single value inputs.
+ */
+class GroupOutputsCacheKey : public GenericKey {
+ public:
+  uint64_t group_id;
+  Vector<bke::SocketValueVariant> inputs;
+
+  uint64_t hash() const override
+  {
+    uint64_t hash = get_default_hash(group_id);
+    for (const bke::SocketValueVariant &value : inputs) {
+      const GPointer ptr = value.get_single_ptr();
+      hash = get_default_hash(hash, ptr.type()->hash(ptr.get()));
+    }
+    return hash;
+  }
+
+  bool equal_to(const GenericKey &other) const override
+  {
+    const auto *other_key = dynamic_cast<const GroupOutputsCacheKey *>(&other);
+    if (!other_key) {
+      return false;
+    }
+    if (group_id != other_key->group_id || inputs.size() != other_key->inputs.size()) {
+      return false;
+    }
+    for (const int i : inputs.index_range()) {
+      const GPointer a = inputs[i].get_single_ptr();
+      const GPointer b = other_key->inputs[i].get_single_ptr();
+      if (a.type() != b.type() || !a.type()->is_equal(a.get(), b.get())) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  std::unique_ptr<GenericKey> to_storable() const override
+  {
+    return std::make_unique<GroupOutputsCacheKey>(*this);
+  }
+};
+
+/**
+ * The outputs of a node group that are kept in the #memory_cache.
+ */
+class GroupOutputsCacheValue : public memory_cache::CachedValue {
+ public:
+  LinearAllocator<> allocator;
+  Vector<GMutablePointer> outputs;
+
+  ~GroupOutputsCacheValue() override
+  {
+    for (GMutablePointer &output : outputs) {
+      output.destruct();
+    }
+  }
+
+  void count_memory(MemoryCounter &memory) const override
+  {
+    for (const GMutablePointer &output : outputs) {
+      if (output.is_type<bke::GeometrySet>()) {
+        output.get<bke::GeometrySet>()->count_memory(memory);
+      }
+      else {
+        memory.add(output.type()->size());
+      }
+    }
+  }
+};
+
 /**
  * This lazy-function wraps a group node. Internally it just executes the lazy-function graph of
  * the referenced group.
+ *
+ * When the outputs of the group only depend on its single value inputs, they are also cached
+ * across evaluations, so that e.g. a group generating a complex geometry from a few parameters
+ * does not have to be evaluated again when something else in the node tree changes.
  */
 class LazyFunctionForGroupNode : public LazyFunction {
  private:
   const bNode &group_node_;
   const LazyFunction &group_lazy_function_;
+  const GeometryNodesLazyFunctionGraphInfo &group_lf_graph_info_;
   bool has_many_nodes_ = false;
+  bool use_outputs_cache_ = false;
 
   struct Storage {
     void *group_storage = nullptr;
@@ -1092,7 +1188,9 @@ class LazyFunctionForGroupNode : public LazyFunction {
   LazyFunctionForGroupNode(const bNode &group_node,
                            const GeometryNodesLazyFunctionGraphInfo &group_lf_graph_info,
                            GeometryNodesLazyFunctionGraphInfo &own_lf_graph_info)
-      : group_node_(group_node), group_lazy_function_(*group_lf_graph_info.function.function)
+      : group_node_(group_node),
+        group_lazy_function_(*group_lf_graph_info.function.function),
+        group_lf_graph_info_(group_lf_graph_info)
   {
     debug_name_ = group_node.name;
     allow_missing_requested_inputs_ = true;
@@ -1122,6 +1220,53 @@ class LazyFunctionForGroupNode : public LazyFunction {
       own_lf_graph_info.mapping.lf_input_index_for_attribute_propagation_to_output
           [output_bsocket.index_in_all_outputs()] = lf_index;
     }
+
+    use_outputs_cache_ = this->group_outputs_are_cacheable(group_lf_graph_info);
+  }
+
+  /**
+   * Only groups that don't take geometries and output no fields are cached. Hashing geometries
+   * would be too expensive, and fields can't be evaluated outside of their context anyway.
+   */
+  bool group_outputs_are_cacheable(const GeometryNodesLazyFunctionGraphInfo &group_lf_graph_info)
+  {
+    if (!group_lf_graph_info.outputs_only_depend_on_inputs) {
+      return false;
+    }
+    const GeometryNodesGroupFunction &group_fn = group_lf_graph_info.function;
+    if (!group_fn.inputs.attributes_to_propagate.range.is_empty()) {
+      return false;
+    }
+    const bNodeTree &group_btree = *reinterpret_cast<const bNodeTree *>(group_node_.id);
+    const FieldInferencingInterface *field_interface =
+        group_btree.runtime->field_inferencing_interface.get();
+    if (field_interface == nullptr) {
+      return false;
+    }
+    const CPPType &variant_type = CPPType::get<bke::SocketValueVariant>();
+    for (const int lf_index : group_fn.inputs.main) {
+      if (inputs_[lf_index].type != &variant_type) {
+        return false;
+      }
+    }
+    for (const int i : group_fn.outputs.main.index_range()) {
+      const CPPType &type = *outputs_[group_fn.outputs.main[i]].type;
+      if (type.is<bke::GeometrySet>()) {
+        continue;
+      }
+      if (&type != &variant_type) {
+        return false;
+      }
+      if (!field_interface->outputs.index_range().contains(i)) {
+        return false;
+      }
+      /* Dependent fields are single values when all inputs are single values. */
+      const OutputSocketFieldType field_type = field_interface->outputs[i].field_type();
+      if (!ELEM(field_type, OutputSocketFieldType::None, OutputSocketFieldType::DependentField)) {
+        return false;
+      }
+    }
+    return true;
   }
 
   void execute_impl(lf::Params &params, const lf::Context &context) const override
@@ -1151,9 +1296,141 @@ class LazyFunctionForGroupNode : public LazyFunction {
     lf::Context group_context{storage->group_storage, &group_user_data, &group_local_user_data};
 
     ScopedComputeContextTimer timer(group_context);
+    if (use_outputs_cache_ && !group_user_data.log_socket_values) {
+      this->execute_with_outputs_cache(params, group_user_data, group_local_user_data);
+      return;
+    }
     group_lazy_function_.execute(params, group_context);
   }
 
+  /**
+   * Compute all inputs first so that they can be used as cache key, then either copy the cached
+   * outputs or evaluate the group eagerly.
+   */
+  void execute_with_outputs_cache(lf::Params &params,
+                                  GeoNodesLFUserData &group_user_data,
+                                  GeoNodesLFLocalUserData &group_local_user_data) const
+  {
+    const GeometryNodesGroupFunction &group_fn = group_lf_graph_info_.function;
+
+    /* All inputs are used, because the group is evaluated as a whole. */
+    for (const int lf_index : group_fn.outputs.input_usages) {
+      if (!params.output_was_set(lf_index)) {
+        params.set_output(lf_index, true);
+      }
+    }
+
+    bool any_input_missing = false;
+    for (const int lf_index : group_fn.inputs.main) {
+      if (params.try_get_input_data_ptr_or_request(lf_index) == nullptr) {
+        any_input_missing = true;
+      }
+    }
+    if (any_input_missing) {
+      /* Wait until all inputs are available. */
+      return;
+    }
+
+    GroupOutputsCacheKey key;
+    key.group_id = group_lf_graph_info_.unique_id;
+    bool key_is_valid = true;
+    for (const int lf_index : group_fn.inputs.main) {
+      const auto &value = params.get_input<bke::SocketValueVariant>(lf_index);
+      if (value.is_context_dependent_field() || value.is_volume_grid()) {
+        key_is_valid = false;
+        break;
+      }
+      bke::SocketValueVariant single_value = value;
+      single_value.convert_to_single();
+      const CPPType &type = *single_value.get_single_ptr().type();
+      if (!type.is_hashable() || !type.is_equality_comparable()) {
+        key_is_valid = false;
+        break;
+      }
+      key.inputs.append(std::move(single_value));
+    }
+
+    auto compute_outputs = [&]() {
+      auto value = std::make_unique<GroupOutputsCacheValue>();
+      this->execute_group_eagerly(params, group_user_data, group_local_user_data, *value);
+      return value;
+    };
+
+    if (!key_is_valid) {
+      GroupOutputsCacheValue value;
+      this->execute_group_eagerly(params, group_user_data, group_local_user_data, value);
+      this->set_outputs_from_cache(params, value);
+      return;
+    }
+    const std::shared_ptr<const GroupOutputsCacheValue> value =
+        memory_cache::get<GroupOutputsCacheValue>(key, compute_outputs);
+    this->set_outputs_from_cache(params, *value);
+  }
+
+  void execute_group_eagerly(lf::Params &params,
+                             GeoNodesLFUserData &group_user_data,
+                             GeoNodesLFLocalUserData &group_local_user_data,
+                             GroupOutputsCacheValue &r_value) const
+  {
+    const GeometryNodesGroupFunction &group_fn = group_lf_graph_info_.function;
+    const int inputs_num = group_lazy_function_.inputs().size();
+    const int outputs_num = group_lazy_function_.outputs().size();
+
+    LinearAllocator<> allocator;
+    bool true_value = true;
+    Array<GMutablePointer> inputs(inputs_num);
+    for (const int lf_index : group_fn.inputs.main) {
+      inputs[lf_index] = {*group_lazy_function_.inputs()[lf_index].type,
+                          params.try_get_input_data_ptr(lf_index)};
+    }
+    for (const int lf_index : group_fn.inputs.output_usages) {
+      inputs[lf_index] = {CPPType::get<bool>(), &true_value};
+    }
+
+    Array<GMutablePointer> outputs(outputs_num);
+    for (const int i : IndexRange(outputs_num)) {
+      const CPPType &type = *group_lazy_function_.outputs()[i].type;
+      outputs[i] = {type, allocator.allocate(type.size(), type.alignment())};
+    }
+
+    Array<std::optional<lf::ValueUsage>> input_usages(inputs_num);
+    Array<lf::ValueUsage> output_usages(outputs_num, lf::ValueUsage::Used);
+    Array<bool> set_outputs(outputs_num, false);
+
+    LinearAllocator<> storage_allocator;
+    lf::Context group_context{group_lazy_function_.init_storage(storage_allocator),
+                              &group_user_data,
+                              &group_local_user_data};
+    lf::BasicParams group_params{
+        group_lazy_function_, inputs, outputs, input_usages, output_usages, set_outputs};
+    group_lazy_function_.execute(group_params, group_context);
+    group_lazy_function_.destruct_storage(group_context.storage);
+
+    for (const int lf_index : group_fn.outputs.main) {
+      const CPPType &type = *outputs[lf_index].type();
+      void *buffer = r_value.allocator.allocate(type.size(), type.alignment());
+      type.move_construct(outputs[lf_index].get(), buffer);
+      r_value.outputs.append({type, buffer});
+    }
+    for (GMutablePointer &output : outputs) {
+      output.destruct();
+    }
+  }
+
+  void set_outputs_from_cache(lf::Params &params, const GroupOutputsCacheValue &value) const
+  {
+    const GeometryNodesGroupFunction &group_fn = group_lf_graph_info_.function;
+    for (const int i : group_fn.outputs.main.index_range()) {
+      const int lf_index = group_fn.outputs.main[i];
+      if (params.output_was_set(lf_index)) {
+        continue;
+      }
+      const GMutablePointer output = value.outputs[i];
+      output.type()->copy_construct(output.get(), params.get_output_data_ptr(lf_index));
+      params.output_set(lf_index);
+    }
+  }
+
   void *init_storage(LinearAllocator<> &allocator) const override
   {
     Storage *s = allocator.construct<Storage>().release();
@@ -4509,6 +4786,73 @@ struct GeometryNodesLazyFunctionBuilder {
   }
 };
 
+static bool node_tree_outputs_only_depend_on_inputs(const bNodeTree &btree)
+{
+  for (const bNode *bnode : btree.all_nodes()) {
+    if (bnode->is_muted()) {
+      continue;
+    }
+    switch (bnode->typeinfo->type) {
+      case NODE_CUSTOM_GROUP:
+      case NODE_GROUP: {
+        const bNodeTree *group_btree = reinterpret_cast<const bNodeTree *>(bnode->id);
+        if (group_btree == nullptr) {
+          continue;
+        }
+        const GeometryNodesLazyFunctionGraphInfo *group_lf_graph_info =
+            ensure_geometry_nodes_lazy_function_graph(*group_btree);
+        if (group_lf_graph_info == nullptr ||
+            !group_lf_graph_info->outputs_only_depend_on_inputs)
+        {
+          return false;
+        }
+        continue;
+      }
+      case GEO_NODE_SELF_OBJECT:
+      case GEO_NODE_INPUT_SCENE_TIME:
+      case GEO_NODE_INPUT_ACTIVE_CAMERA:
+      case GEO_NODE_IS_VIEWPORT:
+      case GEO_NODE_OBJECT_INFO:
+      case GEO_NODE_COLLECTION_INFO:
+      case GEO_NODE_IMAGE_INFO:
+      case GEO_NODE_IMAGE_TEXTURE:
+      case GEO_NODE_DEFORM_CURVES_ON_SURFACE:
+      case GEO_NODE_SIMULATION_INPUT:
+      case GEO_NODE_SIMULATION_OUTPUT:
+      case GEO_NODE_BAKE:
+      case GEO_NODE_VIEWER:
+      case GEO_NODE_WARNING:
+      case GEO_NODE_GIZMO_LINEAR:
+      case GEO_NODE_GIZMO_DIAL:
+      case GEO_NODE_GIZMO_TRANSFORM:
+      case GEO_NODE_IMPORT_STL:
+      case GEO_NODE_IMPORT_OBJ:
+      case GEO_NODE_IMPORT_PLY:
+      case GEO_NODE_TOOL_SELECTION:
+      case GEO_NODE_TOOL_SET_SELECTION:
+      case GEO_NODE_TOOL_3D_CURSOR:
+      case GEO_NODE_TOOL_FACE_SET:
+      case GEO_NODE_TOOL_SET_FACE_SET:
+      case GEO_NODE_TOOL_VIEWPORT_TRANSFORM:
+      case GEO_NODE_TOOL_MOUSE_POSITION:
+      case GEO_NODE_TOOL_ACTIVE_ELEMENT: {
+        return false;
+      }
+      default: {
+        if (bnode->id != nullptr) {
+          /* The output may depend on the referenced data-block (e.g. a material or an object). */
+          return false;
+        }
+        if (bnode->typeinfo == &bke::NodeTypeUndefined) {
+          return false;
+        }
+        break;
+      }
+    }
+  }
+  return true;
+}
+
 const GeometryNodesLazyFunctionGraphInfo *ensure_geometry_nodes_lazy_function_graph(
     const bNodeTree &btree)
 {
@@ -4556,7 +4900,11 @@ const GeometryNodesLazyFunctionGraphInfo *ensure_geometry_nodes_lazy_function_gr
     return lf_graph_info_ptr.get();
   }
 
+  static std::atomic<uint64_t> next_unique_id = 1;
+
   auto lf_graph_info = std::make_unique<GeometryNodesLazyFunctionGraphInfo>();
+  lf_graph_info->unique_id = next_unique_id.fetch_add(1, std::memory_order_relaxed);
+  lf_graph_info->outputs_only_depend_on_inputs = node_tree_outputs_only_depend_on_inputs(btree);
   GeometryNodesLazyFunctionBuilder builder{btree, *lf_graph_info};
   builder.build();
 
@@ -96,6 +96,40 @@ static float3 sh_node_vector_rotate_around_axis(const float3 &vector,
   return result + center;
 }
 
+/**
+ * Rotations around the main axes only have to rotate two components, which is much cheaper than
+ * building a rotation matrix for an arbitrary axis for every element.
+ */
+static float3 sh_node_vector_rotate_around_x(const float3 &vector,
+                                             const float3 &center,
+                                             const float angle)
+{
+  const float3 p = vector - center;
+  const float s = sinf(angle);
+  const float c = cosf(angle);
+  return float3(p.x, c * p.y - s * p.z, s * p.y + c * p.z) + center;
+}
+
+static float3 sh_node_vector_rotate_around_y(const float3 &vector,
+                                             const float3 &center,
+                                             const float angle)
+{
+  const float3 p = vector - center;
+  const float s = sinf(angle);
+  const float c = cosf(angle);
+  return float3(c * p.x + s * p.z, p.y, c * p.z - s * p.x) + center;
+}
+
+static float3 sh_node_vector_rotate_around_z(const float3 &vector,
+                                             const float3 &center,
+                                             const float angle)
+{
+  const float3 p = vector - center;
+  const float s = sinf(angle);
+  const float c = cosf(angle);
+  return float3(c * p.x - s * p.y, s * p.x + c * p.y, p.z) + center;
+}
+
 static float3 sh_node_vector_rotate_euler(const float3 &vector,
                                           const float3 &center,
                                           const float3 &rotation,
@@ -105,9 +139,12 @@ static float3 sh_node_vector_rotate_euler(const float3 &vector,
   float3 result = vector - center;
   eul_to_mat3(mat, rotation);
   if (invert) {
-    invert_m3(mat);
+    /* The inverse of a rotation matrix is its transpose. */
+    mul_transposed_m3_v3(mat, result);
+  }
+  else {
+    mul_m3_v3(mat, result);
   }
-  mul_m3_v3(mat, result);
   return result + center;
 }
 
@@ -134,47 +171,44 @@ static const mf::MultiFunction *get_multi_function(const bNode &node)
       return &fn;
     }
     case NODE_VECTOR_ROTATE_TYPE_AXIS_X: {
-      float3 axis = float3(1.0f, 0.0f, 0.0f);
       if (invert) {
         static auto fn = mf::build::SI3_SO<float3, float3, float, float3>(
-            "Rotate X-Axis", [=](const float3 &in, const float3 &center, float angle) {
-              return sh_node_vector_rotate_around_axis(in, center, axis, -angle);
+            "Rotate X-Axis", [](const float3 &in, const float3 &center, float angle) {
+              return sh_node_vector_rotate_around_x(in, center, -angle);
             });
         return &fn;
       }
       static auto fn = mf::build::SI3_SO<float3, float3, float, float3>(
-          "Rotate X-Axis", [=](const float3 &in, const float3 &center, float angle) {
-            return sh_node_vector_rotate_around_axis(in, center, axis, angle);
+          "Rotate X-Axis", [](const float3 &in, const float3 &center, float angle) {
+            return sh_node_vector_rotate_around_x(in, center, angle);
           });
       return &fn;
     }
     case NODE_VECTOR_ROTATE_TYPE_AXIS_Y: {
-      float3 axis = float3(0.0f, 1.0f, 0.0f);
       if (invert) {
         static auto fn = mf::build::SI3_SO<float3, float3, float, float3>(
-            "Rotate Y-Axis", [=](const float3 &in, const float3 &center, float angle) {
-              return sh_node_vector_rotate_around_axis(in, center, axis, -angle);
+            "Rotate Y-Axis", [](const float3 &in, const float3 &center, float angle) {
+              return sh_node_vector_rotate_around_y(in, center, -angle);
             });
         return &fn;
       }
       static auto fn = mf::build::SI3_SO<float3, float3, float, float3>(
-          "Rotate Y-Axis", [=](const float3 &in, const float3 &center, float angle) {
-            return sh_node_vector_rotate_around_axis(in, center, axis, angle);
+          "Rotate Y-Axis", [](const float3 &in, const float3 &center, float angle) {
+            return sh_node_vector_rotate_around_y(in, center, angle);
           });
       return &fn;
     }
     case NODE_VECTOR_ROTATE_TYPE_AXIS_Z: {
-      float3 axis = float3(0.0f, 0.0f, 1.0f);
       if (invert) {
         static auto fn = mf::build::SI3_SO<float3, float3, float, float3>(
-            "Rotate Z-Axis", [=](const float3 &in, const float3 &center, float angle) {
-              return sh_node_vector_rotate_around_axis(in, center, axis, -angle);
+            "Rotate Z-Axis", [](const float3 &in, const float3 &center, float angle) {
+              return sh_node_vector_rotate_around_z(in, center, -angle);
             });
         return &fn;
       }
       static auto fn = mf::build::SI3_SO<float3, float3, float, float3>(
-          "Rotate Z-Axis", [=](const float3 &in, const float3 &center, float angle) {
-            return sh_node_vector_rotate_around_axis(in, center, axis, angle);
+          "Rotate Z-Axis", [](const float3 &in, const float3 &center, float angle) {
+            return sh_node_vector_rotate_around_z(in, center, angle);
           });
       return &fn;
     }
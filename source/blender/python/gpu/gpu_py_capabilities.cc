@@ -329,6 +329,22 @@ static PyObject *pygpu_hdr_support_get(PyObject * /*self*/)
   return PyBool_FromLong(GPU_hdr_support());
 }
 
+PyDoc_STRVAR(
+    /* Wrap. */
+    pygpu_timer_query_support_get_doc,
+    ".. function:: timer_query_support_get()\n"
+    "\n"
+    "   Return whether GPU backend supports measuring the GPU time of draw passes.\n"
+    "\n"
+    "   :return: Timer query support available.\n"
+    "   :rtype: bool\n");
+static PyObject *pygpu_timer_query_support_get(PyObject * /*self*/)
+{
+  BPYGPU_IS_INIT_OR_ERROR_OBJ;
+
+  return PyBool_FromLong(GPU_timer_query_support());
+}
+
 PyDoc_STRVAR(
     /* Wrap. */
     pygpu_max_work_group_count_get_doc,
@@ -454,6 +470,10 @@ static PyMethodDef pygpu_capabilities__tp_methods[] = {
      (PyCFunction)pygpu_hdr_support_get,
      METH_NOARGS,
      pygpu_hdr_support_get_doc},
+    {"timer_query_support_get",
+     (PyCFunction)pygpu_timer_query_support_get,
+     METH_NOARGS,
+     pygpu_timer_query_support_get_doc},
     {
         "max_work_group_count_get",
         (PyCFunction)pygpu_max_work_group_count_get,
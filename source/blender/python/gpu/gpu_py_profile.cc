@@ -0,0 +1,130 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup bpygpu
+ *
+ * - Use `bpygpu_` for local API.
+ * - Use `BPyGPU` for public API.
+ */
+
+#include <Python.h>
+
+#include "BLI_utildefines.h"
+
+#include "GPU_debug.hh"
+
+#include "../generic/py_capi_utils.h"
+#include "../generic/python_utildefines.h"
+
+#include "gpu_py.hh"
+#include "gpu_py_profile.hh" /* Own include. */
+
+/* -------------------------------------------------------------------- */
+/** \name Functions
+ * \{ */
+
+PyDoc_STRVAR(
+    /* Wrap. */
+    pygpu_profile_timings_enable_doc,
+    ".. function:: timings_enable(enable)\n"
+    "\n"
+    "   Record the GPU time spent in each draw pass of the viewport.\n"
+    "   Has no effect when :func:`gpu.capabilities.timer_query_support_get` returns False.\n"
+    "\n"
+    "   :arg enable: Enable or disable the recording.\n"
+    "   :type enable: bool\n");
+static PyObject *pygpu_profile_timings_enable(PyObject * /*self*/, PyObject *value)
+{
+  BPYGPU_IS_INIT_OR_ERROR_OBJ;
+
+  const int enable = PyC_Long_AsBool(value);
+  if (enable == -1) {
+    return nullptr;
+  }
+  GPU_debug_timings_enable(enable);
+  Py_RETURN_NONE;
+}
+
+PyDoc_STRVAR(
+    /* Wrap. */
+    pygpu_profile_timings_get_doc,
+    ".. function:: timings_get()\n"
+    "\n"
+    "   Get the GPU timings of the draw passes of the last measured viewport redraw.\n"
+    "   The results lag a few redraws behind to avoid waiting for the GPU.\n"
+    "\n"
+    "   :return: List of (name, depth, milliseconds) tuples in submission order.\n"
+    "   :rtype: list[tuple[str, int, float]]\n");
+static PyObject *pygpu_profile_timings_get(PyObject * /*self*/)
+{
+  BPYGPU_IS_INIT_OR_ERROR_OBJ;
+
+  const blender::Span<GPUDebugGroupTiming> timings = GPU_debug_timings_get();
+  PyObject *list = PyList_New(timings.size());
+  for (const int64_t i : timings.index_range()) {
+    const GPUDebugGroupTiming &timing = timings[i];
+    PyObject *item = PyTuple_New(3);
+    PyTuple_SET_ITEMS(item,
+                      PyUnicode_FromStringAndSize(timing.name.c_str(), timing.name.size()),
+                      PyLong_FromLong(timing.depth),
+                      PyFloat_FromDouble(timing.time_ms));
+    PyList_SET_ITEM(list, i, item);
+  }
+  return list;
+}
+
+/** \} */
+
+/* -------------------------------------------------------------------- */
+/** \name Module
+ * \{ */
+
+#if (defined(__GNUC__) && !defined(__clang__))
+#  pragma GCC diagnostic push
+#  pragma GCC diagnostic ignored "-Wcast-function-type"
+#endif
+
+static PyMethodDef pygpu_profile__tp_methods[] = {
+    {"timings_enable",
+     (PyCFunction)pygpu_profile_timings_enable,
+     METH_O,
+     pygpu_profile_timings_enable_doc},
+    {"timings_get",
+     (PyCFunction)pygpu_profile_timings_get,
+     METH_NOARGS,
+     pygpu_profile_timings_get_doc},
+    {nullptr, nullptr, 0, nullptr},
+};
+
+#if (defined(__GNUC__) && !defined(__clang__))
+#  pragma GCC diagnostic pop
+#endif
+
+PyDoc_STRVAR(
+    /* Wrap. */
+    pygpu_profile__tp_doc,
+    "This module provides access to GPU profiling of the viewport draw passes.");
+static PyModuleDef pygpu_profile_module_def = {
+    /*m_base*/ PyModuleDef_HEAD_INIT,
+    /*m_name*/ "gpu.profile",
+    /*m_doc*/ pygpu_profile__tp_doc,
+    /*m_size*/ 0,
+    /*m_methods*/ pygpu_profile__tp_methods,
+    /*m_slots*/ nullptr,
+    /*m_traverse*/ nullptr,
+    /*m_clear*/ nullptr,
+    /*m_free*/ nullptr,
+};
+
+PyObject *bpygpu_profile_init()
+{
+  PyObject *submodule;
+
+  submodule = PyModule_Create(&pygpu_profile_module_def);
+
+  return submodule;
+}
+
+/** \} */
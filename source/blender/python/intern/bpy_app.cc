@@ -28,6 +28,7 @@
 
 #include "bpy_app_handlers.h"
 #include "bpy_driver.h"
+#include "bpy_profile.h"
 
 #include "BPY_extern_python.h" /* For #BPY_python_app_help_text_fn. */
 
@@ -35,6 +36,7 @@
 #include "bpy_app_icons.h"
 #include "bpy_app_timers.h"
 
+#include "BLI_task.h"
 #include "BLI_utildefines.h"
 
 #include "BKE_appdir.hh"
@@ -481,6 +483,11 @@ static PyGetSetDef bpy_app_getsets[] = {
      bpy_app_debug_doc,
      (void *)G_DEBUG_SIMDATA},
     {"debug_io", bpy_app_debug_get, bpy_app_debug_set, bpy_app_debug_doc, (void *)G_DEBUG_IO},
+    {"debug_startup",
+     bpy_app_debug_get,
+     bpy_app_debug_set,
+     bpy_app_debug_doc,
+     (void *)G_DEBUG_STARTUP},
 
     {"use_event_simulate",
      bpy_app_global_flag_get,
@@ -618,6 +625,275 @@ static PyObject *bpy_app_help_text(PyObject * /*self*/, PyObject *args, PyObject
   return result;
 }
 
+PyDoc_STRVAR(
+    /* Wrap. */
+    bpy_app_task_stats_start_doc,
+    ".. staticmethod:: task_stats_start(trace=False)\n"
+    "\n"
+    "   Start collecting task pool statistics, clearing the previously collected ones.\n"
+    "\n"
+    "   :arg trace: Also record every task and wait, for :func:`task_stats_write_trace`.\n"
+    "   :type trace: bool\n");
+static PyObject *bpy_app_task_stats_start(PyObject * /*self*/, PyObject *args, PyObject *kwds)
+{
+  bool trace = false;
+  static const char *_keywords[] = {"trace", nullptr};
+  static _PyArg_Parser _parser = {
+      PY_ARG_PARSER_HEAD_COMPAT()
+      "|$" /* Optional keyword only arguments. */
+      "O&" /* `trace` */
+      ":task_stats_start",
+      _keywords,
+      nullptr,
+  };
+  if (!_PyArg_ParseTupleAndKeywordsFast(args, kwds, &_parser, PyC_ParseBool, &trace)) {
+    return nullptr;
+  }
+  BLI_task_pool_stats_enable(trace);
+  Py_RETURN_NONE;
+}
+
+PyDoc_STRVAR(
+    /* Wrap. */
+    bpy_app_task_stats_stop_doc,
+    ".. staticmethod:: task_stats_stop()\n"
+    "\n"
+    "   Stop collecting task pool statistics, the collected ones remain available.\n");
+static PyObject *bpy_app_task_stats_stop(PyObject * /*self*/)
+{
+  BLI_task_pool_stats_disable();
+  Py_RETURN_NONE;
+}
+
+static void task_stats_dict_set(PyObject *dict, const char *key, PyObject *value)
+{
+  PyDict_SetItemString(dict, key, value);
+  Py_DECREF(value);
+}
+
+PyDoc_STRVAR(
+    /* Wrap. */
+    bpy_app_task_stats_doc,
+    ".. staticmethod:: task_stats()\n"
+    "\n"
+    "   Return the task pool statistics collected since :func:`task_stats_start`.\n"
+    "   Times are in seconds, the ``threads`` list contains the tasks run, busy and idle time\n"
+    "   of every thread of the task scheduler.\n"
+    "\n"
+    "   :return: Statistics.\n"
+    "   :rtype: dict\n");
+static PyObject *bpy_app_task_stats(PyObject * /*self*/)
+{
+  TaskPoolStats stats;
+  BLI_task_pool_stats_get(&stats);
+
+  TaskPoolThreadStats threads[256];
+  const int threads_len = BLI_task_pool_stats_get_threads(threads, ARRAY_SIZE(threads));
+  PyObject *threads_list = PyList_New(threads_len);
+  for (int i = 0; i < threads_len; i++) {
+    PyObject *thread = PyDict_New();
+    task_stats_dict_set(thread, "tasks_run", PyLong_FromUnsignedLongLong(threads[i].tasks_run));
+    task_stats_dict_set(thread, "busy_time", PyFloat_FromDouble(threads[i].busy_time));
+    task_stats_dict_set(
+        thread, "idle_time", PyFloat_FromDouble(stats.elapsed_time - threads[i].busy_time));
+    PyList_SET_ITEM(threads_list, i, thread);
+  }
+
+  PyObject *result = PyDict_New();
+  task_stats_dict_set(result, "elapsed_time", PyFloat_FromDouble(stats.elapsed_time));
+  task_stats_dict_set(result, "pools_created", PyLong_FromUnsignedLongLong(stats.pools_created));
+  task_stats_dict_set(result, "tasks_pushed", PyLong_FromUnsignedLongLong(stats.tasks_pushed));
+  task_stats_dict_set(result, "tasks_run", PyLong_FromUnsignedLongLong(stats.tasks_run));
+  task_stats_dict_set(result, "tasks_stolen", PyLong_FromUnsignedLongLong(stats.tasks_stolen));
+  task_stats_dict_set(
+      result, "max_pending_tasks", PyLong_FromUnsignedLongLong(stats.max_pending_tasks));
+  task_stats_dict_set(result, "task_time", PyFloat_FromDouble(stats.task_time));
+  task_stats_dict_set(result, "waits", PyLong_FromUnsignedLongLong(stats.waits));
+  task_stats_dict_set(result, "wait_time", PyFloat_FromDouble(stats.wait_time));
+  task_stats_dict_set(
+      result, "main_thread_wait_time", PyFloat_FromDouble(stats.main_thread_wait_time));
+  task_stats_dict_set(result, "threads", threads_list);
+  return result;
+}
+
+PyDoc_STRVAR(
+    /* Wrap. */
+    bpy_app_task_stats_write_trace_doc,
+    ".. staticmethod:: task_stats_write_trace(filepath)\n"
+    "\n"
+    "   Write the tasks and waits recorded since ``task_stats_start(trace=True)`` in the\n"
+    "   Trace Event Format, which can be opened in Perfetto or ``chrome://tracing``.\n"
+    "\n"
+    "   :arg filepath: The JSON file to write.\n"
+    "   :type filepath: str\n");
+static PyObject *bpy_app_task_stats_write_trace(PyObject * /*self*/, PyObject *args)
+{
+  const char *filepath;
+  if (!PyArg_ParseTuple(args, "s:task_stats_write_trace", &filepath)) {
+    return nullptr;
+  }
+  if (!BLI_task_pool_stats_write_trace(filepath)) {
+    PyErr_Format(PyExc_OSError, "task_stats_write_trace: unable to write \"%s\"", filepath);
+    return nullptr;
+  }
+  Py_RETURN_NONE;
+}
+
+PyDoc_STRVAR(
+    /* Wrap. */
+    bpy_app_python_stats_start_doc,
+    ".. staticmethod:: python_stats_start()\n"
+    "\n"
+    "   Start collecting statistics about Python callbacks, clearing the previously collected\n"
+    "   ones. While a depsgraph trace is recorded, see\n"
+    "   :meth:`bpy.types.Depsgraph.debug_trace_begin`, the callbacks and long waits for the GIL\n"
+    "   are also added to it.\n");
+static PyObject *bpy_app_python_stats_start(PyObject * /*self*/)
+{
+  bpy_profile_enable();
+  Py_RETURN_NONE;
+}
+
+PyDoc_STRVAR(
+    /* Wrap. */
+    bpy_app_python_stats_stop_doc,
+    ".. staticmethod:: python_stats_stop()\n"
+    "\n"
+    "   Stop collecting Python statistics, the collected ones remain available.\n");
+static PyObject *bpy_app_python_stats_stop(PyObject * /*self*/)
+{
+  bpy_profile_disable();
+  Py_RETURN_NONE;
+}
+
+PyDoc_STRVAR(
+    /* Wrap. */
+    bpy_app_python_stats_doc,
+    ".. staticmethod:: python_stats()\n"
+    "\n"
+    "   Return the Python statistics collected since :func:`python_stats_start`.\n"
+    "   Times are in seconds. ``calls`` contains the number of calls, total and maximum time of\n"
+    "   every callback, grouped by category, e.g. ``Operator``, ``Panel``, ``drivers``,\n"
+    "   ``draw_handlers`` or the name of an application handler. ``gil_waits`` and\n"
+    "   ``gil_wait_time`` count the acquisitions of the GIL by Blender and the time spent\n"
+    "   waiting for it, ``rna_gets`` and ``rna_sets`` count the accesses of RNA properties.\n"
+    "\n"
+    "   :return: Statistics.\n"
+    "   :rtype: dict\n");
+static PyObject *bpy_app_python_stats(PyObject * /*self*/)
+{
+  return bpy_profile_stats_as_dict();
+}
+
+PyDoc_STRVAR(
+    /* Wrap. */
+    bpy_app_frame_stats_start_doc,
+    ".. staticmethod:: frame_stats_start(overlay=False)\n"
+    "\n"
+    "   Start collecting statistics about the frames drawn by the window manager, clearing the\n"
+    "   previously collected ones.\n"
+    "\n"
+    "   :arg overlay: Also draw the times of the last frame in the corner of every window.\n"
+    "   :type overlay: bool\n");
+static PyObject *bpy_app_frame_stats_start(PyObject * /*self*/, PyObject *args, PyObject *kwds)
+{
+  bool overlay = false;
+  static const char *_keywords[] = {"overlay", nullptr};
+  static _PyArg_Parser _parser = {
+      PY_ARG_PARSER_HEAD_COMPAT()
+      "|$" /* Optional keyword only arguments. */
+      "O&" /* `overlay` */
+      ":frame_stats_start",
+      _keywords,
+      nullptr,
+  };
+  if (!_PyArg_ParseTupleAndKeywordsFast(args, kwds, &_parser, PyC_ParseBool, &overlay)) {
+    return nullptr;
+  }
+  WM_frame_stats_enable(overlay);
+  Py_RETURN_NONE;
+}
+
+PyDoc_STRVAR(
+    /* Wrap. */
+    bpy_app_frame_stats_stop_doc,
+    ".. staticmethod:: frame_stats_stop()\n"
+    "\n"
+    "   Stop collecting frame statistics, the collected ones remain available.\n");
+static PyObject *bpy_app_frame_stats_stop(PyObject * /*self*/)
+{
+  WM_frame_stats_disable();
+  Py_RETURN_NONE;
+}
+
+static PyObject *frame_stats_time_as_dict(const wmFrameStatsTime &time)
+{
+  PyObject *result = PyDict_New();
+  task_stats_dict_set(result, "count", PyLong_FromUnsignedLongLong(time.count));
+  task_stats_dict_set(result, "total_time", PyFloat_FromDouble(time.total_time));
+  task_stats_dict_set(result, "max_time", PyFloat_FromDouble(time.max_time));
+  task_stats_dict_set(result, "last_time", PyFloat_FromDouble(time.last_time));
+  return result;
+}
+
+PyDoc_STRVAR(
+    /* Wrap. */
+    bpy_app_frame_stats_doc,
+    ".. staticmethod:: frame_stats()\n"
+    "\n"
+    "   Return the frame statistics collected since :func:`frame_stats_start`.\n"
+    "   Times are in seconds. Only iterations of the main loop that drew a window count as\n"
+    "   frames. ``events``, ``handlers``, ``notifiers``, ``depsgraph``, ``draw`` and ``swap``\n"
+    "   contain the count, total, maximum and last time of these parts of a frame, ``frame``\n"
+    "   the same for whole frames. ``input_latency`` is the time from the oldest input event\n"
+    "   handled in a frame until the frame was drawn. ``coalesced_mouse_moves`` counts the\n"
+    "   mouse moves that were merged into a following one before being handled.\n"
+    "\n"
+    "   :return: Statistics.\n"
+    "   :rtype: dict\n");
+static PyObject *bpy_app_frame_stats(PyObject * /*self*/)
+{
+  wmFrameStats stats;
+  WM_frame_stats_get(&stats);
+
+  PyObject *result = PyDict_New();
+  task_stats_dict_set(result, "elapsed_time", PyFloat_FromDouble(stats.elapsed_time));
+  task_stats_dict_set(result, "frames", PyLong_FromUnsignedLongLong(stats.frames));
+  task_stats_dict_set(result, "input_events", PyLong_FromUnsignedLongLong(stats.input_events));
+  task_stats_dict_set(
+      result, "coalesced_mouse_moves", PyLong_FromUnsignedLongLong(stats.coalesced_mouse_moves));
+  task_stats_dict_set(result, "events", frame_stats_time_as_dict(stats.events));
+  task_stats_dict_set(result, "handlers", frame_stats_time_as_dict(stats.handlers));
+  task_stats_dict_set(result, "notifiers", frame_stats_time_as_dict(stats.notifiers));
+  task_stats_dict_set(result, "depsgraph", frame_stats_time_as_dict(stats.depsgraph));
+  task_stats_dict_set(result, "draw", frame_stats_time_as_dict(stats.draw));
+  task_stats_dict_set(result, "swap", frame_stats_time_as_dict(stats.swap));
+  task_stats_dict_set(result, "frame", frame_stats_time_as_dict(stats.frame));
+  task_stats_dict_set(result, "input_latency", frame_stats_time_as_dict(stats.input_latency));
+  return result;
+}
+
+PyDoc_STRVAR(
+    /* Wrap. */
+    bpy_app_memory_usage_by_tag_doc,
+    ".. staticmethod:: memory_usage_by_tag()\n"
+    "\n"
+    "   Return the memory in use per subsystem (depsgraph, geometry, undo, ...) in bytes.\n"
+    "   Memory that isn't attributed to a subsystem is reported as ``Untagged``.\n"
+    "\n"
+    "   :return: Memory in use by subsystem name.\n"
+    "   :rtype: dict[str, int]\n");
+static PyObject *bpy_app_memory_usage_by_tag(PyObject * /*self*/)
+{
+  PyObject *result = PyDict_New();
+  for (int tag = 0; tag < MEM_TAG_NUM; tag++) {
+    PyObject *value = PyLong_FromSize_t(MEM_get_memory_in_use_by_tag(eMEMTag(tag)));
+    PyDict_SetItemString(result, MEM_tag_name(eMEMTag(tag)), value);
+    Py_DECREF(value);
+  }
+  return result;
+}
+
 #if (defined(__GNUC__) && !defined(__clang__))
 #  pragma GCC diagnostic push
 #  pragma GCC diagnostic ignored "-Wcast-function-type"
@@ -632,6 +908,50 @@ static PyMethodDef bpy_app_methods[] = {
      (PyCFunction)bpy_app_help_text,
      METH_VARARGS | METH_KEYWORDS | METH_STATIC,
      bpy_app_help_text_doc},
+    {"task_stats_start",
+     (PyCFunction)bpy_app_task_stats_start,
+     METH_VARARGS | METH_KEYWORDS | METH_STATIC,
+     bpy_app_task_stats_start_doc},
+    {"task_stats_stop",
+     (PyCFunction)bpy_app_task_stats_stop,
+     METH_NOARGS | METH_STATIC,
+     bpy_app_task_stats_stop_doc},
+    {"task_stats",
+     (PyCFunction)bpy_app_task_stats,
+     METH_NOARGS | METH_STATIC,
+     bpy_app_task_stats_doc},
+    {"task_stats_write_trace",
+     (PyCFunction)bpy_app_task_stats_write_trace,
+     METH_VARARGS | METH_STATIC,
+     bpy_app_task_stats_write_trace_doc},
+    {"python_stats_start",
+     (PyCFunction)bpy_app_python_stats_start,
+     METH_NOARGS | METH_STATIC,
+     bpy_app_python_stats_start_doc},
+    {"python_stats_stop",
+     (PyCFunction)bpy_app_python_stats_stop,
+     METH_NOARGS | METH_STATIC,
+     bpy_app_python_stats_stop_doc},
+    {"python_stats",
+     (PyCFunction)bpy_app_python_stats,
+     METH_NOARGS | METH_STATIC,
+     bpy_app_python_stats_doc},
+    {"frame_stats_start",
+     (PyCFunction)bpy_app_frame_stats_start,
+     METH_VARARGS | METH_KEYWORDS | METH_STATIC,
+     bpy_app_frame_stats_start_doc},
+    {"frame_stats_stop",
+     (PyCFunction)bpy_app_frame_stats_stop,
+     METH_NOARGS | METH_STATIC,
+     bpy_app_frame_stats_stop_doc},
+    {"frame_stats",
+     (PyCFunction)bpy_app_frame_stats,
+     METH_NOARGS | METH_STATIC,
+     bpy_app_frame_stats_doc},
+    {"memory_usage_by_tag",
+     (PyCFunction)bpy_app_memory_usage_by_tag,
+     METH_NOARGS | METH_STATIC,
+     bpy_app_memory_usage_by_tag_doc},
     {nullptr, nullptr, 0, nullptr},
 };
 
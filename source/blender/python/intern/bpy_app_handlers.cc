@@ -10,6 +10,7 @@
  * functions into (called via blenders generic BLI_cb api)
  */
 
+#include "BLI_time.h"
 #include "BLI_utildefines.h"
 #include <Python.h>
 
@@ -18,6 +19,7 @@
 #include "RNA_access.hh"
 
 #include "bpy_app_handlers.h"
+#include "bpy_profile.h"
 #include "bpy_rna.h"
 
 #include "../generic/python_utildefines.h"
@@ -360,7 +362,7 @@ void bpy_app_generic_callback(Main * /*main*/,
 {
   PyObject *cb_list = py_cb_array[POINTER_AS_INT(arg)];
   if (PyList_GET_SIZE(cb_list) > 0) {
-    const PyGILState_STATE gilstate = PyGILState_Ensure();
+    const PyGILState_STATE gilstate = bpy_profile_gil_ensure();
 
     const int num_arguments = 2;
     PyObject *args_all = PyTuple_New(num_arguments); /* save python creating each call */
@@ -391,7 +393,15 @@ void bpy_app_generic_callback(Main * /*main*/,
     for (pos = 0; pos < PyList_GET_SIZE(cb_list); pos++) {
       func = PyList_GET_ITEM(cb_list, pos);
       PyObject *args = choose_arguments(func, args_all, args_single);
+      const bool use_profile = bpy_profile_is_enabled();
+      const double profile_start = use_profile ? BLI_time_now_seconds() : 0.0;
       ret = PyObject_Call(func, args, nullptr);
+      if (use_profile) {
+        bpy_profile_add_call(app_cb_info_fields[POINTER_AS_INT(arg)].name,
+                             bpy_profile_callback_name(func),
+                             profile_start,
+                             BLI_time_now_seconds());
+      }
       if (ret == nullptr) {
         /* Don't set last system variables because they might cause some
          * dangling pointers to external render engines (when exception
@@ -17,6 +17,7 @@
 #include "BLI_listbase.h"
 #include "BLI_math_base.h"
 #include "BLI_string.h"
+#include "BLI_time.h"
 
 #include "BKE_animsys.h"
 #include "BKE_fcurve_driver.h"
@@ -31,6 +32,7 @@
 #include "bpy_intern_string.h"
 
 #include "bpy_driver.h"
+#include "bpy_profile.h"
 #include "bpy_rna.h"
 
 #include "BPY_extern.h"
@@ -261,7 +263,7 @@ void BPY_driver_reset()
   const bool use_gil = true; /* !PyC_IsInterpreterActive(); */
 
   if (use_gil) {
-    gilstate = PyGILState_Ensure();
+    gilstate = bpy_profile_gil_ensure();
   }
 
   /* Currently exit/reset are practically the same besides the GIL check. */
@@ -537,7 +539,7 @@ float BPY_driver_exec(PathResolvedRNA *anim_rna,
   use_gil = true; /* !PyC_IsInterpreterActive(); */
 
   if (use_gil) {
-    gilstate = PyGILState_Ensure();
+    gilstate = bpy_profile_gil_ensure();
   }
 
   /* Needed since drivers are updated directly after undo where `main` is re-allocated #28807. */
@@ -704,8 +706,13 @@ float BPY_driver_exec(PathResolvedRNA *anim_rna,
 #else
   /* Evaluate the compiled expression. */
   if (expr_code) {
+    const bool use_profile = bpy_profile_is_enabled();
+    const double profile_start = use_profile ? BLI_time_now_seconds() : 0.0;
     retval = PyEval_EvalCode(
         static_cast<PyObject *>((void *)expr_code), bpy_pydriver_Dict, driver_vars);
+    if (use_profile) {
+      bpy_profile_add_call("drivers", expr, profile_start, BLI_time_now_seconds());
+    }
   }
 #endif
 
@@ -37,6 +37,7 @@
 #include "bpy_capi_utils.h"
 #include "bpy_intern_string.h"
 #include "bpy_path.h"
+#include "bpy_profile.h"
 #include "bpy_props.h"
 #include "bpy_rna.h"
 #include "bpy_traceback.h"
@@ -119,7 +120,7 @@ void bpy_context_set(bContext *C, PyGILState_STATE *gilstate)
   py_call_level++;
 
   if (gilstate) {
-    *gilstate = PyGILState_Ensure();
+    *gilstate = bpy_profile_gil_ensure();
   }
 
   if (py_call_level == 1) {
@@ -0,0 +1,183 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup pythonintern
+ *
+ * All statistics are only modified while holding the GIL, so they don't need further locking.
+ */
+
+#include <algorithm>
+#include <string>
+
+#include "BLI_map.hh"
+#include "BLI_time.h"
+
+#include "DEG_depsgraph_debug.hh"
+
+#include "bpy_profile.h" /* Own include. */
+
+namespace blender {
+
+struct PythonCallStats {
+  int64_t calls = 0;
+  double total_time = 0.0;
+  double max_time = 0.0;
+};
+
+struct PythonStats {
+  double start_time = 0.0;
+  double stop_time = 0.0;
+  /** Statistics of every callback, by category and name. */
+  Map<std::string, Map<std::string, PythonCallStats>> calls;
+  int64_t gil_waits = 0;
+  double gil_wait_time = 0.0;
+  double gil_max_wait_time = 0.0;
+  int64_t rna_gets = 0;
+  int64_t rna_sets = 0;
+};
+
+/**
+ * Waits shorter than this are the common case of a thread acquiring the GIL that is free or that
+ * it already holds, and are not added to a depsgraph trace as they would only clutter it.
+ */
+static constexpr double GIL_WAIT_TRACE_MIN_TIME = 1e-4;
+
+static bool python_stats_enabled = false;
+
+static PythonStats &python_stats()
+{
+  static PythonStats stats;
+  return stats;
+}
+
+}  // namespace blender
+
+using namespace blender;
+
+void bpy_profile_enable()
+{
+  PythonStats &stats = python_stats();
+  stats = PythonStats();
+  stats.start_time = BLI_time_now_seconds();
+  python_stats_enabled = true;
+}
+
+void bpy_profile_disable()
+{
+  if (python_stats_enabled) {
+    python_stats().stop_time = BLI_time_now_seconds();
+    python_stats_enabled = false;
+  }
+}
+
+bool bpy_profile_is_enabled()
+{
+  return python_stats_enabled;
+}
+
+PyGILState_STATE bpy_profile_gil_ensure()
+{
+  if (!python_stats_enabled) {
+    return PyGILState_Ensure();
+  }
+  const double start = BLI_time_now_seconds();
+  const PyGILState_STATE gilstate = PyGILState_Ensure();
+  const double end = BLI_time_now_seconds();
+
+  /* Statistics may have been disabled while waiting. */
+  if (python_stats_enabled) {
+    PythonStats &stats = python_stats();
+    const double time = end - start;
+    stats.gil_waits++;
+    stats.gil_wait_time += time;
+    stats.gil_max_wait_time = std::max(stats.gil_max_wait_time, time);
+    if (time >= GIL_WAIT_TRACE_MIN_TIME) {
+      DEG_debug_trace_add_event("python", "GIL Wait", "", start, end);
+    }
+  }
+  return gilstate;
+}
+
+void bpy_profile_add_call(const char *category,
+                          const char *name,
+                          const double start,
+                          const double end)
+{
+  if (!python_stats_enabled) {
+    return;
+  }
+  const double time = end - start;
+  PythonCallStats &call_stats = python_stats()
+                                    .calls.lookup_or_add_default_as(StringRef(category))
+                                    .lookup_or_add_default_as(StringRef(name));
+  call_stats.calls++;
+  call_stats.total_time += time;
+  call_stats.max_time = std::max(call_stats.max_time, time);
+  DEG_debug_trace_add_event("python", name, category, start, end);
+}
+
+const char *bpy_profile_callback_name(PyObject *callable)
+{
+  if (PyMethod_Check(callable)) {
+    callable = PyMethod_GET_FUNCTION(callable);
+  }
+  if (PyFunction_Check(callable)) {
+    const char *name = PyUnicode_AsUTF8(((PyFunctionObject *)callable)->func_qualname);
+    if (name) {
+      return name;
+    }
+    PyErr_Clear();
+  }
+  return Py_TYPE(callable)->tp_name;
+}
+
+void bpy_profile_add_rna_access(const bool is_set)
+{
+  if (!python_stats_enabled) {
+    return;
+  }
+  PythonStats &stats = python_stats();
+  if (is_set) {
+    stats.rna_sets++;
+  }
+  else {
+    stats.rna_gets++;
+  }
+}
+
+static void stats_dict_set(PyObject *dict, const char *key, PyObject *value)
+{
+  PyDict_SetItemString(dict, key, value);
+  Py_DECREF(value);
+}
+
+PyObject *bpy_profile_stats_as_dict()
+{
+  const PythonStats &stats = python_stats();
+  const double end_time = python_stats_enabled ? BLI_time_now_seconds() : stats.stop_time;
+
+  PyObject *calls = PyDict_New();
+  for (const auto category : stats.calls.items()) {
+    PyObject *category_calls = PyDict_New();
+    for (const auto item : category.value.items()) {
+      PyObject *call = PyDict_New();
+      stats_dict_set(call, "calls", PyLong_FromLongLong(item.value.calls));
+      stats_dict_set(call, "total_time", PyFloat_FromDouble(item.value.total_time));
+      stats_dict_set(call, "max_time", PyFloat_FromDouble(item.value.max_time));
+      stats_dict_set(category_calls, item.key.c_str(), call);
+    }
+    stats_dict_set(calls, category.key.c_str(), category_calls);
+  }
+
+  PyObject *result = PyDict_New();
+  stats_dict_set(result, "elapsed_time", PyFloat_FromDouble(end_time - stats.start_time));
+  stats_dict_set(result, "calls", calls);
+  stats_dict_set(result, "gil_waits", PyLong_FromLongLong(stats.gil_waits));
+  stats_dict_set(result, "gil_wait_time", PyFloat_FromDouble(stats.gil_wait_time));
+  stats_dict_set(result, "gil_max_wait_time", PyFloat_FromDouble(stats.gil_max_wait_time));
+  stats_dict_set(result, "rna_gets", PyLong_FromLongLong(stats.rna_gets));
+  stats_dict_set(result, "rna_sets", PyLong_FromLongLong(stats.rna_sets));
+  return result;
+}
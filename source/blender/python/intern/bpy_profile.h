@@ -0,0 +1,55 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup pythonintern
+ *
+ * Optional statistics about the time spent in Python callbacks, the time spent waiting for the
+ * GIL and the number of RNA attribute accesses, see `bpy.app.python_stats_start`.
+ */
+
+#pragma once
+
+#include <Python.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Start collecting statistics, clearing the previously collected ones. */
+void bpy_profile_enable(void);
+/** Stop collecting statistics, the collected ones remain available. */
+void bpy_profile_disable(void);
+bool bpy_profile_is_enabled(void);
+
+/**
+ * Acquire the GIL like `PyGILState_Ensure`, recording the time spent waiting for it when
+ * statistics are collected.
+ */
+PyGILState_STATE bpy_profile_gil_ensure(void);
+
+/**
+ * Record a call of a Python callback that ran between the given times, from
+ * #BLI_time_now_seconds. Calls are grouped by category (operators, drivers, handlers, ...) and
+ * name. When a depsgraph trace is recorded the call is also added to it.
+ *
+ * \note Must be called with the GIL held, like all the functions below.
+ */
+void bpy_profile_add_call(const char *category, const char *name, double start, double end);
+
+/**
+ * The qualified name of a Python function or method for #bpy_profile_add_call, the name of the
+ * type for other callable objects.
+ */
+const char *bpy_profile_callback_name(PyObject *callable);
+
+/** Count an attribute access of an RNA struct from Python. */
+void bpy_profile_add_rna_access(bool is_set);
+
+/** Return the collected statistics as a new dictionary. */
+PyObject *bpy_profile_stats_as_dict(void);
+
+#ifdef __cplusplus
+}
+#endif
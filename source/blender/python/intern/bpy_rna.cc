@@ -25,6 +25,7 @@
 #include "BLI_listbase.h"
 #include "BLI_math_rotation.h"
 #include "BLI_string.h"
+#include "BLI_time.h"
 #include "BLI_utildefines.h"
 
 #include "BPY_extern.h"
@@ -32,6 +33,7 @@
 
 #include "bpy_capi_utils.h"
 #include "bpy_intern_string.h"
+#include "bpy_profile.h"
 #include "bpy_props.h"
 #include "bpy_rna.h"
 #include "bpy_rna_anim.h"
@@ -4426,6 +4428,7 @@ static PyObject *pyrna_struct_getattro(BPy_StructRNA *self, PyObject *pyname)
     }
   }
   else if ((prop = RNA_struct_find_property(&self->ptr, name))) {
+    bpy_profile_add_rna_access(false);
     ret = pyrna_prop_to_py(&self->ptr, prop);
   }
   /* RNA function only if callback is declared (no optional functions). */
@@ -4704,6 +4707,7 @@ static int pyrna_struct_setattro(BPy_StructRNA *self, PyObject *pyname, PyObject
                    RNA_struct_identifier(self->ptr.type));
       return -1;
     }
+    bpy_profile_add_rna_access(true);
   }
   else if (self->ptr.type == &RNA_Context) {
     /* Code just raises correct error, context prop's can't be set,
@@ -5540,6 +5544,59 @@ static bool foreach_compat_buffer(RawPropertyType raw_type, int attr_signed, con
   return false;
 }
 
+/**
+ * The raw type matching the items of a buffer of the given format, so buffers of another type
+ * than the property can still be converted without going through Python objects.
+ */
+static RawPropertyType foreach_buffer_raw_type(const char *format, const Py_ssize_t itemsize)
+{
+  const char f = format ? *format : 'B'; /* B is assumed when not set */
+  RawPropertyType raw_type;
+
+  switch (f) {
+    case 'b':
+      raw_type = PROP_RAW_INT8;
+      break;
+    case 'B':
+      raw_type = PROP_RAW_UINT8;
+      break;
+    case 'h':
+      raw_type = PROP_RAW_SHORT;
+      break;
+    case 'H':
+      raw_type = PROP_RAW_UINT16;
+      break;
+    case 'i':
+      raw_type = PROP_RAW_INT;
+      break;
+    case '?':
+      raw_type = PROP_RAW_BOOLEAN;
+      break;
+    case 'f':
+      raw_type = PROP_RAW_FLOAT;
+      break;
+    case 'd':
+      raw_type = PROP_RAW_DOUBLE;
+      break;
+    case 'l':
+    case 'q':
+      raw_type = PROP_RAW_INT64;
+      break;
+    case 'L':
+    case 'Q':
+      raw_type = PROP_RAW_UINT64;
+      break;
+    default:
+      return PROP_RAW_UNSET;
+  }
+
+  /* Catches types with a platform dependent size, like `long`. */
+  if (RNA_raw_type_sizeof(raw_type) != size_t(itemsize)) {
+    return PROP_RAW_UNSET;
+  }
+  return raw_type;
+}
+
 static PyObject *foreach_getset(BPy_PropertyRNA *self, PyObject *args, int set)
 {
   PyObject *item = nullptr;
@@ -5591,6 +5648,15 @@ static PyObject *foreach_getset(BPy_PropertyRNA *self, PyObject *args, int set)
           ok = RNA_property_collection_raw_set(
               nullptr, &self->ptr, self->prop, attr, buf.buf, raw_type, tot);
         }
+        else {
+          /* Convert from buffers of another type directly. */
+          const RawPropertyType buf_raw_type = foreach_buffer_raw_type(buf.format, buf.itemsize);
+          if (buf_raw_type != PROP_RAW_UNSET && buf.len == Py_ssize_t(tot) * buf.itemsize) {
+            buffer_is_compat = true;
+            ok = RNA_property_collection_raw_set(
+                nullptr, &self->ptr, self->prop, attr, buf.buf, buf_raw_type, tot);
+          }
+        }
 
         PyBuffer_Release(&buf);
       }
@@ -5667,6 +5733,15 @@ static PyObject *foreach_getset(BPy_PropertyRNA *self, PyObject *args, int set)
           ok = RNA_property_collection_raw_get(
               nullptr, &self->ptr, self->prop, attr, buf.buf, raw_type, tot);
         }
+        else {
+          /* Convert to buffers of another type directly. */
+          const RawPropertyType buf_raw_type = foreach_buffer_raw_type(buf.format, buf.itemsize);
+          if (buf_raw_type != PROP_RAW_UNSET && buf.len == Py_ssize_t(tot) * buf.itemsize) {
+            buffer_is_compat = true;
+            ok = RNA_property_collection_raw_get(
+                nullptr, &self->ptr, self->prop, attr, buf.buf, buf_raw_type, tot);
+          }
+        }
 
         PyBuffer_Release(&buf);
       }
@@ -8898,8 +8973,25 @@ static int bpy_class_call(bContext *C, PointerRNA *ptr, FunctionRNA *func, Param
 #endif
       /* *** Main Caller *** */
 
+      const bool use_profile = bpy_profile_is_enabled();
+      const double profile_start = use_profile ? BLI_time_now_seconds() : 0.0;
+
       ret = PyObject_Call(item, args, nullptr);
 
+      if (use_profile) {
+        char profile_name[256];
+        SNPRINTF(profile_name,
+                 "%s.%s",
+                 RNA_struct_identifier(ptr->type),
+                 RNA_function_identifier(func));
+        /* Group by the type that is extended, e.g. all operators or all panels. */
+        StructRNA *base = RNA_struct_base(ptr->type);
+        bpy_profile_add_call(RNA_struct_identifier(base ? base : ptr->type),
+                             profile_name,
+                             profile_start,
+                             BLI_time_now_seconds());
+      }
+
       /* *** Done Calling *** */
 
 #ifdef USE_PEDANTIC_WRITE
@@ -24,11 +24,14 @@
 
 #include "WM_api.hh"
 
+#include "BLI_time.h"
+
 #include "ED_space_api.hh"
 
 #include "BPY_extern.h" /* For public API. */
 
 #include "bpy_capi_utils.h"
+#include "bpy_profile.h"
 #include "bpy_rna.h"
 #include "bpy_rna_callback.h" /* Own include. */
 
@@ -53,7 +56,15 @@ static void cb_region_draw(const bContext *C, ARegion * /*region*/, void *custom
 
   cb_func = PyTuple_GET_ITEM((PyObject *)customdata, 1);
   cb_args = PyTuple_GET_ITEM((PyObject *)customdata, 2);
+  const bool use_profile = bpy_profile_is_enabled();
+  const double profile_start = use_profile ? BLI_time_now_seconds() : 0.0;
   result = PyObject_CallObject(cb_func, cb_args);
+  if (use_profile) {
+    bpy_profile_add_call("draw_handlers",
+                         bpy_profile_callback_name(cb_func),
+                         profile_start,
+                         BLI_time_now_seconds());
+  }
 
   if (result) {
     Py_DECREF(result);
@@ -98,7 +109,15 @@ static void cb_wm_cursor_draw(bContext *C, int x, int y, void *customdata)
   PyObject *cb_args_with_xy = PyC_Tuple_CopySized(cb_args, cb_args_len + 1);
   PyTuple_SET_ITEM(cb_args_with_xy, cb_args_len, cb_args_xy);
 
+  const bool use_profile = bpy_profile_is_enabled();
+  const double profile_start = use_profile ? BLI_time_now_seconds() : 0.0;
   result = PyObject_CallObject(cb_func, cb_args_with_xy);
+  if (use_profile) {
+    bpy_profile_add_call("draw_handlers",
+                         bpy_profile_callback_name(cb_func),
+                         profile_start,
+                         BLI_time_now_seconds());
+  }
 
   Py_DECREF(cb_args_with_xy);
 
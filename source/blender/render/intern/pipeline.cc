@@ -36,6 +36,7 @@
 #include "BLI_rect.h"
 #include "BLI_set.hh"
 #include "BLI_string.h"
+#include "BLI_task.h"
 #include "BLI_threads.h"
 #include "BLI_time.h"
 #include "BLI_timecode.h"
@@ -652,10 +653,10 @@ void RE_FreeAllPersistentData()
   }
 }
 
-static void re_gpu_texture_caches_free(Render *re)
+static void re_gpu_texture_caches_free(Render *re, const bool free_compositor = true)
 {
   /* Free persistent compositor that may be using these textures. */
-  if (re->compositor) {
+  if (re->compositor && free_compositor) {
     RE_compositor_free(*re);
   }
 
@@ -1378,7 +1379,13 @@ static void do_render_compositor(Render *re)
                                 &compositor_render_context,
                                 nullptr);
         }
-        compositor_render_context.save_file_outputs(re->pipeline_scene_eval);
+        if (re->file_output_task_pool) {
+          /* Wait for the file outputs of the previous frame to be written before queuing those of
+           * this frame, such that at most the file outputs of two frames are kept in memory. */
+          BLI_task_pool_work_and_wait(re->file_output_task_pool);
+        }
+        compositor_render_context.save_file_outputs(re->pipeline_scene_eval,
+                                                    re->file_output_task_pool);
 
         ntree->runtime->stats_draw = nullptr;
         ntree->runtime->test_break = nullptr;
@@ -2426,12 +2433,20 @@ void RE_RenderAnim(Render *re,
   re->flag |= R_ANIMATION;
   DEG_graph_id_tag_update(re->main, re->pipeline_depsgraph, &re->scene->id, ID_RECALC_AUDIO_MUTE);
 
+  /* Write the File Output nodes images of each frame in the background while the next frame is
+   * rendered and composited. */
+  re->file_output_task_pool = BLI_task_pool_create_background(nullptr, TASK_PRIORITY_LOW);
+
   scene->r.subframe = 0.0f;
   for (nfra = sfra, scene->r.cfra = sfra; scene->r.cfra <= efra; scene->r.cfra++) {
     char filepath[FILE_MAX];
 
-    /* Reduce GPU memory usage so renderer has more space. */
-    RE_FreeGPUTextureCaches();
+    /* Reduce GPU memory usage so renderer has more space. With persistent data, the compositor
+     * of this render is kept, so the following frames reuse its cached data and textures. */
+    const bool keep_compositor = (rd.mode & R_PERSISTENT_DATA) != 0;
+    for (Render *re_iter : RenderGlobal.render_list) {
+      re_gpu_texture_caches_free(re_iter, !(keep_compositor && re_iter == re));
+    }
 
     /* A feedback loop exists here -- render initialization requires updated
      * render layers settings which could be animated, but scene evaluation for
@@ -2596,6 +2611,10 @@ void RE_RenderAnim(Render *re,
     }
   }
 
+  BLI_task_pool_work_and_wait(re->file_output_task_pool);
+  BLI_task_pool_free(re->file_output_task_pool);
+  re->file_output_task_pool = nullptr;
+
   /* end movie */
   if (is_movie && do_write_file) {
     re_movie_free_all(re, mh, totvideos);
@@ -132,6 +132,8 @@ struct ViewRender : public BaseRender {
 };
 
 /** Controls state of render, everything that's read-only during render stage. */
+struct TaskPool;
+
 struct Render : public BaseRender {
   /* NOTE: Currently unused, provision for the future.
    * Add these now to allow the guarded memory allocator to catch C-specific function calls. */
@@ -216,6 +218,11 @@ struct Render : public BaseRender {
   blender::render::RealtimeCompositor *compositor = nullptr;
   std::mutex compositor_mutex;
 
+  /* Pool of the tasks writing the images of the File Output nodes during animation renders, such
+   * that the images of a frame are written while the next frame is rendered and composited. Only
+   * exists during #RE_RenderAnim. */
+  TaskPool *file_output_task_pool = nullptr;
+
   /* Callbacks for the corresponding base class method implementation. */
   void (*display_init_cb)(void *handle, RenderResult *rr) = nullptr;
   void *dih = nullptr;
@@ -10,6 +10,7 @@
 #include "BLI_math_geom.h"
 #include "BLI_math_vector.hh"
 #include "BLI_math_vector_types.hh"
+#include "BLI_task.hh"
 #include "BLI_vector.hh"
 
 #include "BKE_attribute.hh"
@@ -218,86 +219,126 @@ class TextureMarginMap {
    * Walk over the map and for margin pixels follow the direction stored in the bottom 3
    * bits back to the face.
    * Then look up the pixel from the next face.
+   *
+   * Rows are processed in parallel. All new pixels are looked up before any of them is written,
+   * so the result doesn't depend on the order in which the margin pixels are processed.
    */
   void lookup_pixels(ImBuf *ibuf, char *mask, int maxPolygonSteps)
   {
     float4 *ibuf_ptr_fl = reinterpret_cast<float4 *>(ibuf->float_buffer.data);
     uchar4 *ibuf_ptr_ch = reinterpret_cast<uchar4 *>(ibuf->byte_buffer.data);
-    size_t pixel_index = 0;
-    for (int y = 0; y < h_; y++) {
-      for (int x = 0; x < w_; x++) {
-        uint32_t dp = pixel_data_[pixel_index];
-        if (IsDijkstraPixel(dp) && !DijkstraPixelIsUnset(dp)) {
-          int dist = DijkstraPixelGetDistance(dp);
-          int direction = DijkstraPixelGetDirection(dp);
-
-          int xx = x;
-          int yy = y;
-
-          /* Follow the dijkstra directions to find the face this margin pixels belongs to. */
-          while (dist > 0) {
-            xx -= directions[direction][0];
-            yy -= directions[direction][1];
-            dp = get_pixel(xx, yy);
-            dist -= distances[direction];
-            BLI_assert(!dist || (dist == DijkstraPixelGetDistance(dp)));
-            direction = DijkstraPixelGetDirection(dp);
-          }
-
-          uint32_t face = get_pixel(xx, yy);
-
-          BLI_assert(!IsDijkstraPixel(face));
 
-          float destX, destY;
-
-          int other_poly;
-          bool found_pixel_in_polygon = false;
-          if (lookup_pixel_polygon_neighborhood(x, y, &face, &destX, &destY, &other_poly)) {
-
-            for (int i = 0; i < maxPolygonSteps; i++) {
-              /* Force to pixel grid. */
-              int nx = int(round(destX));
-              int ny = int(round(destY));
-              uint32_t polygon_from_map = get_pixel(nx, ny);
-              if (other_poly == polygon_from_map) {
-                found_pixel_in_polygon = true;
-                break;
-              }
-
-              float dist_to_edge;
-              /* Look up again, but starting from the face we were expected to land in. */
-              if (!lookup_pixel(nx, ny, other_poly, &destX, &destY, &other_poly, &dist_to_edge)) {
-                found_pixel_in_polygon = false;
-                break;
-              }
-            }
-
-            if (found_pixel_in_polygon) {
+    struct MarginPixel {
+      size_t pixel_index;
+      float4 color_fl;
+      uchar4 color_ch;
+    };
+    Array<Vector<MarginPixel>> new_pixels_per_row(h_);
+
+    threading::parallel_for(IndexRange(h_), 16, [&](const IndexRange range) {
+      for (const int y : range) {
+        for (int x = 0; x < w_; x++) {
+          const size_t pixel_index = size_t(y) * w_ + x;
+          const uint32_t dp = pixel_data_[pixel_index];
+          if (IsDijkstraPixel(dp) && !DijkstraPixelIsUnset(dp)) {
+            float destX, destY;
+            if (lookup_margin_pixel(x, y, dp, maxPolygonSteps, &destX, &destY)) {
+              MarginPixel new_pixel{pixel_index, float4(0.0f), uchar4(0)};
               if (ibuf_ptr_fl) {
-                ibuf_ptr_fl[pixel_index] = imbuf::interpolate_bilinear_border_fl(
-                    ibuf, destX, destY);
+                new_pixel.color_fl = imbuf::interpolate_bilinear_border_fl(ibuf, destX, destY);
               }
               if (ibuf_ptr_ch) {
-                ibuf_ptr_ch[pixel_index] = imbuf::interpolate_bilinear_border_byte(
+                new_pixel.color_ch = imbuf::interpolate_bilinear_border_byte(
                     ibuf, destX, destY);
               }
-              /* Add our new pixels to the assigned pixel map. */
-              mask[pixel_index] = 1;
+              new_pixels_per_row[y].append(new_pixel);
             }
           }
+          else if (DijkstraPixelIsUnset(dp) || !IsDijkstraPixel(dp)) {
+            /* These are not margin pixels, make sure the extend filter which is run after this
+             * step leaves them alone.
+             */
+            mask[pixel_index] = 1;
+          }
         }
-        else if (DijkstraPixelIsUnset(dp) || !IsDijkstraPixel(dp)) {
-          /* These are not margin pixels, make sure the extend filter which is run after this step
-           * leaves them alone.
-           */
-          mask[pixel_index] = 1;
+      }
+    });
+
+    threading::parallel_for(IndexRange(h_), 64, [&](const IndexRange range) {
+      for (const int y : range) {
+        for (const MarginPixel &new_pixel : new_pixels_per_row[y]) {
+          if (ibuf_ptr_fl) {
+            ibuf_ptr_fl[new_pixel.pixel_index] = new_pixel.color_fl;
+          }
+          if (ibuf_ptr_ch) {
+            ibuf_ptr_ch[new_pixel.pixel_index] = new_pixel.color_ch;
+          }
+          /* Add our new pixels to the assigned pixel map. */
+          mask[new_pixel.pixel_index] = 1;
         }
-        pixel_index++;
       }
-    }
+    });
   }
 
  private:
+  /**
+   * Follow the dijkstra directions from the margin pixel at \a x, \a y to find the face it
+   * belongs to, then find the position to copy its value from in the adjacent face.
+   */
+  bool lookup_margin_pixel(const int x,
+                           const int y,
+                           uint32_t dp,
+                           const int maxPolygonSteps,
+                           float *r_destx,
+                           float *r_desty) const
+  {
+    int dist = DijkstraPixelGetDistance(dp);
+    int direction = DijkstraPixelGetDirection(dp);
+
+    int xx = x;
+    int yy = y;
+
+    /* Follow the dijkstra directions to find the face this margin pixels belongs to. */
+    while (dist > 0) {
+      xx -= directions[direction][0];
+      yy -= directions[direction][1];
+      dp = get_pixel(xx, yy);
+      dist -= distances[direction];
+      BLI_assert(!dist || (dist == DijkstraPixelGetDistance(dp)));
+      direction = DijkstraPixelGetDirection(dp);
+    }
+
+    uint32_t face = get_pixel(xx, yy);
+
+    BLI_assert(!IsDijkstraPixel(face));
+
+    float destX, destY;
+
+    int other_poly;
+    if (!lookup_pixel_polygon_neighborhood(x, y, &face, &destX, &destY, &other_poly)) {
+      return false;
+    }
+
+    for (int i = 0; i < maxPolygonSteps; i++) {
+      /* Force to pixel grid. */
+      int nx = int(round(destX));
+      int ny = int(round(destY));
+      uint32_t polygon_from_map = get_pixel(nx, ny);
+      if (other_poly == polygon_from_map) {
+        *r_destx = destX;
+        *r_desty = destY;
+        return true;
+      }
+
+      float dist_to_edge;
+      /* Look up again, but starting from the face we were expected to land in. */
+      if (!lookup_pixel(nx, ny, other_poly, &destX, &destY, &other_poly, &dist_to_edge)) {
+        return false;
+      }
+    }
+    return false;
+  }
+
   float2 uv_to_xy(const float2 &mloopuv) const
   {
     float2 ret;
@@ -336,7 +377,12 @@ class TextureMarginMap {
    * pixels also check the neighboring polygons.
    */
   bool lookup_pixel_polygon_neighborhood(
-      float x, float y, uint32_t *r_start_poly, float *r_destx, float *r_desty, int *r_other_poly)
+      float x,
+      float y,
+      uint32_t *r_start_poly,
+      float *r_destx,
+      float *r_desty,
+      int *r_other_poly) const
   {
     float found_dist;
     if (lookup_pixel(x, y, *r_start_poly, r_destx, r_desty, r_other_poly, &found_dist)) {
@@ -389,7 +435,7 @@ class TextureMarginMap {
                     float *r_destx,
                     float *r_desty,
                     int *r_other_poly,
-                    float *r_dist_to_edge)
+                    float *r_dist_to_edge) const
   {
     float2 point(x, y);
 
@@ -26,6 +26,16 @@ bool SEQ_proxy_rebuild_context(Main *bmain,
                                GSet *file_list,
                                ListBase *queue,
                                bool build_only_on_bad_performance);
+/**
+ * Queue building the seek index of a movie strip, which lets seeking start decoding from the
+ * right key frame without time-codes or proxies. Returns false when there is nothing to build.
+ * The queue is processed by #SEQ_proxy_rebuild like proxies.
+ */
+bool SEQ_proxy_seek_index_rebuild_context(Main *bmain,
+                                          Depsgraph *depsgraph,
+                                          Scene *scene,
+                                          Sequence *seq,
+                                          ListBase *queue);
 void SEQ_proxy_rebuild(SeqIndexBuildContext *context, wmJobWorkerStatus *worker_status);
 void SEQ_proxy_rebuild_finish(SeqIndexBuildContext *context, bool stop);
 void SEQ_proxy_set(Sequence *seq, bool value);
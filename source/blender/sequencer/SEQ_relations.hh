@@ -59,6 +59,22 @@ void SEQ_cache_iterate(
     void *userdata,
     bool callback_init(void *userdata, size_t item_count),
     bool callback_iter(void *userdata, Sequence *seq, int timeline_frame, int cache_type));
+
+struct SeqDiskCacheStatistics {
+  /** Images found in and missing from the disk cache when reading. */
+  int read_hits;
+  int read_misses;
+  /** Images waiting to be written by the background task. */
+  int pending_writes;
+  /** Images that were not written because too many writes were pending. */
+  int writes_skipped;
+  /** Size of written images divided by the size of their compressed data. */
+  float compression_ratio;
+};
+/**
+ * Get statistics of the disk cache of the scene, zeroed when there is no disk cache.
+ */
+void SEQ_cache_disk_statistics_get(Scene *scene, SeqDiskCacheStatistics *r_stats);
 /**
  * Return immediate parent meta of sequence.
  */
@@ -10,16 +10,19 @@
 
 struct Depsgraph;
 struct GPUOffScreen;
+struct GPUTexture;
 struct GPUViewport;
 struct ImBuf;
 struct ListBase;
 struct Main;
 struct Scene;
+struct SeqRenderGPUCache;
 struct Sequence;
 struct StripElem;
 
 enum eSeqTaskId {
   SEQ_TASK_MAIN_RENDER,
+  /** Prefetch workers use consecutive IDs starting with this one. */
   SEQ_TASK_PREFETCH_RENDER,
 };
 
@@ -60,6 +63,23 @@ ImBuf *SEQ_render_give_ibuf(const SeqRenderData *context, float timeline_frame,
 ImBuf *SEQ_render_give_ibuf_direct(const SeqRenderData *context,
                                    float timeline_frame,
                                    Sequence *seq);
+/**
+ * Composite the strips shown at `timeline_frame` on the GPU, for previews. Strip images are
+ * uploaded as they are loaded and transform, crop and blending are done while drawing them, so
+ * none of these have to run on the CPU.
+ *
+ * Only image and movie strips blended with Replace, Alpha Over or Add are supported, without
+ * modifiers or saturation adjustments.
+ *
+ * \param cache: GPU resources kept between calls, created when null.
+ * \return Texture in the sequencer color space with premultiplied alpha, owned by `cache`, or
+ * null when the strips must be rendered with #SEQ_render_give_ibuf instead.
+ */
+GPUTexture *SEQ_render_give_gpu_texture(const SeqRenderData *context,
+                                        float timeline_frame,
+                                        int chanshown,
+                                        SeqRenderGPUCache **cache);
+void SEQ_render_gpu_cache_free(SeqRenderGPUCache *cache);
 void SEQ_render_new_render_data(Main *bmain,
                                 Depsgraph *depsgraph,
                                 Scene *scene,
@@ -8,10 +8,20 @@
 
 #include <cstddef>
 #include <ctime>
+#include <fcntl.h>
 #include <memory.h>
+#include <zstd.h>
+
+#ifdef WIN32
+#  include <io.h>
+#else
+#  include <unistd.h>
+#endif
 
 #include "MEM_guardedalloc.h"
 
+#include "atomic_ops.h"
+
 #include "DNA_scene_types.h"
 #include "DNA_sequence_types.h"
 
@@ -19,23 +29,31 @@
 #include "IMB_imbuf.hh"
 #include "IMB_imbuf_types.hh"
 
+#include "BLI_array.hh"
 #include "BLI_blenlib.h"
 #include "BLI_endian_defines.h"
 #include "BLI_endian_switch.h"
 #include "BLI_fileops.h"
 #include "BLI_fileops_types.h"
 #include "BLI_listbase.h"
+#include "BLI_mmap.h"
 #include "BLI_path_util.h"
+#include "BLI_task.h"
+#include "BLI_task.hh"
 #include "BLI_threads.h"
+#include "BLI_vector.hh"
 
 #include "BKE_main.hh"
 
+#include "SEQ_relations.hh"
 #include "SEQ_render.hh"
 #include "SEQ_time.hh"
 
 #include "disk_cache.hh"
 #include "image_cache.hh"
 
+using namespace blender;
+
 /**
  * Disk Cache Design Notes
  * =======================
@@ -44,8 +62,11 @@
  * For each cached non-temp image, image data and supplementary info are written to HDD.
  * Multiple(DCACHE_IMAGES_PER_FILE) images share the same file.
  * Each of these files contains header DiskCacheHeader followed by image data.
- * ZLIB compression with user definable level can be used to compress image data(per image)
- * Images are written in order in which they are rendered.
+ * ZSTD compression with user definable level can be used to compress image data(per image).
+ * Bytes of float images are shuffled into planes before compression, which compresses better.
+ * Images are written in order in which they are rendered, by a background task so rendering
+ * doesn't wait for the disk. When writing can't keep up, images are not written at all.
+ * Images are read back through a memory mapped file.
  * Overwriting of individual entry is not possible.
  * Stored images are deleted by invalidation, or when size of all files exceeds maximum
  * size specified in user preferences.
@@ -57,11 +78,19 @@
  * `<cache type>-<resolution X>x<resolution Y>-<rendersize>%(<view_id>)-<frame no>.dcf`. */
 #define DCACHE_FNAME_FORMAT "%d-%dx%d-%d%%(%d)-%d.dcf"
 #define DCACHE_IMAGES_PER_FILE 100
-#define DCACHE_CURRENT_VERSION 2
+#define DCACHE_CURRENT_VERSION 3
+/* Maximum number of images waiting to be written, each of them holds a reference to the image. */
+#define DCACHE_MAX_PENDING_WRITES 8
 #define COLORSPACE_NAME_MAX 64 /* XXX: defined in IMB intern. */
 
+enum {
+  /** Bytes of the image data were shuffled into planes before compression. */
+  DCACHE_ENTRY_SHUFFLED = (1 << 0),
+};
+
 struct DiskCacheHeaderEntry {
   uchar encoding;
+  uchar flag;
   uint64_t frameno;
   uint64_t size_compressed;
   uint64_t size_raw;
@@ -79,6 +108,15 @@ struct SeqDiskCache {
   ListBase files;
   ThreadMutex read_write_mutex;
   size_t size_total;
+  /** Serial background pool, images are written in the order they were rendered. */
+  TaskPool *write_pool;
+  int32_t pending_writes;
+  int32_t writes_skipped;
+  /* Statistics, protected by `read_write_mutex`. */
+  int read_hits;
+  int read_misses;
+  uint64_t bytes_raw_written;
+  uint64_t bytes_written;
 };
 
 struct DiskCacheFile {
@@ -216,6 +254,12 @@ static void seq_disk_cache_delete_file(SeqDiskCache *disk_cache, DiskCacheFile *
   MEM_freeN(file);
 }
 
+/* Wait for or cancel writes which are still in progress, so they don't write outdated images. */
+static void seq_disk_cache_cancel_writes(SeqDiskCache *disk_cache)
+{
+  BLI_task_pool_cancel(disk_cache->write_pool);
+}
+
 bool seq_disk_cache_enforce_limits(SeqDiskCache *disk_cache)
 {
   BLI_mutex_lock(&disk_cache->read_write_mutex);
@@ -403,6 +447,8 @@ void seq_disk_cache_invalidate(SeqDiskCache *disk_cache,
   int start;
   int end;
 
+  seq_disk_cache_cancel_writes(disk_cache);
+
   BLI_mutex_lock(&disk_cache->read_write_mutex);
 
   start = SEQ_time_left_handle_frame_get(scene, seq_changed) - DCACHE_IMAGES_PER_FILE;
@@ -413,53 +459,111 @@ void seq_disk_cache_invalidate(SeqDiskCache *disk_cache,
   BLI_mutex_unlock(&disk_cache->read_write_mutex);
 }
 
-static size_t deflate_imbuf_to_file(ImBuf *ibuf,
-                                    FILE *file,
-                                    int level,
-                                    DiskCacheHeaderEntry *header_entry)
+static void seq_disk_cache_shuffle_bytes(const uint8_t *src,
+                                         const size_t size,
+                                         const int element_size,
+                                         uint8_t *dst)
 {
-  void *data = (ibuf->byte_buffer.data != nullptr) ? (void *)ibuf->byte_buffer.data :
-                                                     (void *)ibuf->float_buffer.data;
+  const int64_t elements_num = size / element_size;
+  threading::parallel_for(IndexRange(elements_num), 64 * 1024, [&](const IndexRange range) {
+    for (const int byte : IndexRange(element_size)) {
+      uint8_t *dst_plane = dst + byte * elements_num;
+      for (const int64_t i : range) {
+        dst_plane[i] = src[i * element_size + byte];
+      }
+    }
+  });
+}
 
-  /* Apply compression if wanted, otherwise just write directly to the file. */
-  if (level > 0) {
-    return BLI_file_zstd_from_mem_at_pos(
-        data, header_entry->size_raw, file, header_entry->offset, level);
+static void seq_disk_cache_unshuffle_bytes(const uint8_t *src,
+                                           const size_t size,
+                                           const int element_size,
+                                           uint8_t *dst)
+{
+  const int64_t elements_num = size / element_size;
+  threading::parallel_for(IndexRange(elements_num), 64 * 1024, [&](const IndexRange range) {
+    for (const int byte : IndexRange(element_size)) {
+      const uint8_t *src_plane = src + byte * elements_num;
+      for (const int64_t i : range) {
+        dst[i * element_size + byte] = src_plane[i];
+      }
+    }
+  });
+}
+
+static const void *seq_disk_cache_imbuf_data(const ImBuf *ibuf)
+{
+  return (ibuf->byte_buffer.data != nullptr) ? (const void *)ibuf->byte_buffer.data :
+                                               (const void *)ibuf->float_buffer.data;
+}
+
+/**
+ * Compress the image data. Float pixels are shuffled first, so that the similar high bytes of
+ * neighboring values end up next to each other, which compresses much better.
+ * Returns an empty vector on failure.
+ */
+static Vector<uint8_t> seq_disk_cache_compress(const ImBuf *ibuf,
+                                               const int level,
+                                               DiskCacheHeaderEntry *header_entry)
+{
+  const uint8_t *data = static_cast<const uint8_t *>(seq_disk_cache_imbuf_data(ibuf));
+  const size_t size = header_entry->size_raw;
+
+  Vector<uint8_t> shuffled;
+  if (ibuf->byte_buffer.data == nullptr) {
+    shuffled.resize(size);
+    seq_disk_cache_shuffle_bytes(data, size, sizeof(float), shuffled.data());
+    data = shuffled.data();
+    header_entry->flag |= DCACHE_ENTRY_SHUFFLED;
   }
 
-  fseek(file, header_entry->offset, SEEK_SET);
-  return fwrite(data, 1, header_entry->size_raw, file);
+  Vector<uint8_t> compressed(ZSTD_compressBound(size));
+  const size_t compressed_size = ZSTD_compress(
+      compressed.data(), compressed.size(), data, size, level);
+  if (ZSTD_isError(compressed_size)) {
+    return {};
+  }
+  compressed.resize(compressed_size);
+  return compressed;
 }
 
-static size_t inflate_file_to_imbuf(ImBuf *ibuf, FILE *file, DiskCacheHeaderEntry *header_entry)
+static bool seq_disk_cache_decompress(BLI_mmap_file *mmap_file,
+                                      const DiskCacheHeaderEntry *header_entry,
+                                      ImBuf *ibuf)
 {
-  void *data = (ibuf->byte_buffer.data != nullptr) ? (void *)ibuf->byte_buffer.data :
-                                                     (void *)ibuf->float_buffer.data;
-  char header[4];
-  fseek(file, header_entry->offset, SEEK_SET);
-  if (fread(header, 1, sizeof(header), file) != sizeof(header)) {
-    return 0;
+  void *data = const_cast<void *>(seq_disk_cache_imbuf_data(ibuf));
+  const size_t size_raw = header_entry->size_raw;
+  const size_t size_compressed = header_entry->size_compressed;
+
+  if (header_entry->offset + size_compressed > BLI_mmap_get_length(mmap_file)) {
+    return false;
   }
+  const char *src = static_cast<const char *>(BLI_mmap_get_pointer(mmap_file)) +
+                    header_entry->offset;
 
   /* Check if the data is compressed or raw. */
-  if (BLI_file_magic_is_zstd(header)) {
-    return BLI_file_unzstd_to_mem_at_pos(data, header_entry->size_raw, file, header_entry->offset);
+  if (size_compressed < 4 || !BLI_file_magic_is_zstd(src)) {
+    return size_compressed == size_raw &&
+           BLI_mmap_read(mmap_file, data, header_entry->offset, size_raw);
   }
 
-  fseek(file, header_entry->offset, SEEK_SET);
-  return fread(data, 1, header_entry->size_raw, file);
-}
+  if ((header_entry->flag & DCACHE_ENTRY_SHUFFLED) == 0) {
+    const size_t size = ZSTD_decompress(data, size_raw, src, size_compressed);
+    return !ZSTD_isError(size) && size == size_raw;
+  }
 
-static bool seq_disk_cache_read_header(FILE *file, DiskCacheHeader *header)
-{
-  BLI_fseek(file, 0LL, SEEK_SET);
-  const size_t num_items_read = fread(header, sizeof(*header), 1, file);
-  if (num_items_read < 1) {
-    BLI_assert_msg(0, "unable to read disk cache header");
-    perror("unable to read disk cache header");
+  Array<uint8_t> shuffled(size_raw, NoInitialization());
+  const size_t size = ZSTD_decompress(shuffled.data(), size_raw, src, size_compressed);
+  if (ZSTD_isError(size) || size != size_raw) {
     return false;
   }
+  seq_disk_cache_unshuffle_bytes(
+      shuffled.data(), size_raw, sizeof(float), static_cast<uint8_t *>(data));
+  return true;
+}
 
+static void seq_disk_cache_header_endian_switch(DiskCacheHeader *header)
+{
   for (int i = 0; i < DCACHE_IMAGES_PER_FILE; i++) {
     if ((ENDIAN_ORDER == B_ENDIAN) && header->entry[i].encoding == 0) {
       BLI_endian_switch_uint64(&header->entry[i].frameno);
@@ -468,7 +572,19 @@ static bool seq_disk_cache_read_header(FILE *file, DiskCacheHeader *header)
       BLI_endian_switch_uint64(&header->entry[i].size_raw);
     }
   }
+}
+
+static bool seq_disk_cache_read_header(FILE *file, DiskCacheHeader *header)
+{
+  BLI_fseek(file, 0LL, SEEK_SET);
+  const size_t num_items_read = fread(header, sizeof(*header), 1, file);
+  if (num_items_read < 1) {
+    BLI_assert_msg(0, "unable to read disk cache header");
+    perror("unable to read disk cache header");
+    return false;
+  }
 
+  seq_disk_cache_header_endian_switch(header);
   return true;
 }
 
@@ -478,8 +594,35 @@ static size_t seq_disk_cache_write_header(FILE *file, const DiskCacheHeader *hea
   return fwrite(header, sizeof(*header), 1, file);
 }
 
-static int seq_disk_cache_add_header_entry(const SeqCacheKey *key,
-                                           ImBuf *ibuf,
+static void seq_disk_cache_init_header_entry(const float frame_index,
+                                             const ImBuf *ibuf,
+                                             DiskCacheHeaderEntry *header_entry)
+{
+  memset(header_entry, 0, sizeof(*header_entry));
+
+  if (ENDIAN_ORDER == B_ENDIAN) {
+    header_entry->encoding = 255;
+  }
+  else {
+    header_entry->encoding = 0;
+  }
+
+  header_entry->frameno = frame_index;
+
+  /* Store colorspace name of ibuf. */
+  const char *colorspace_name;
+  if (ibuf->byte_buffer.data) {
+    header_entry->size_raw = int64_t(ibuf->x) * ibuf->y * ibuf->channels;
+    colorspace_name = IMB_colormanagement_get_rect_colorspace(const_cast<ImBuf *>(ibuf));
+  }
+  else {
+    header_entry->size_raw = int64_t(ibuf->x) * ibuf->y * ibuf->channels * 4;
+    colorspace_name = IMB_colormanagement_get_float_colorspace(const_cast<ImBuf *>(ibuf));
+  }
+  STRNCPY(header_entry->colorspace_name, colorspace_name);
+}
+
+static int seq_disk_cache_add_header_entry(const DiskCacheHeaderEntry *new_entry,
                                            DiskCacheHeader *header)
 {
   int i;
@@ -505,27 +648,8 @@ static int seq_disk_cache_add_header_entry(const SeqCacheKey *key,
     offset = header->entry[i - 1].offset + header->entry[i - 1].size_compressed;
   }
 
-  if (ENDIAN_ORDER == B_ENDIAN) {
-    header->entry[i].encoding = 255;
-  }
-  else {
-    header->entry[i].encoding = 0;
-  }
-
+  header->entry[i] = *new_entry;
   header->entry[i].offset = offset;
-  header->entry[i].frameno = key->frame_index;
-
-  /* Store colorspace name of ibuf. */
-  const char *colorspace_name;
-  if (ibuf->byte_buffer.data) {
-    header->entry[i].size_raw = int64_t(ibuf->x) * ibuf->y * ibuf->channels;
-    colorspace_name = IMB_colormanagement_get_rect_colorspace(ibuf);
-  }
-  else {
-    header->entry[i].size_raw = int64_t(ibuf->x) * ibuf->y * ibuf->channels * 4;
-    colorspace_name = IMB_colormanagement_get_float_colorspace(ibuf);
-  }
-  STRNCPY(header->entry[i].colorspace_name, colorspace_name);
 
   return i;
 }
@@ -541,13 +665,30 @@ static int seq_disk_cache_get_header_entry(const SeqCacheKey *key, const DiskCac
   return -1;
 }
 
-bool seq_disk_cache_write_file(SeqDiskCache *disk_cache, SeqCacheKey *key, ImBuf *ibuf)
+static bool seq_disk_cache_write_file_ex(SeqDiskCache *disk_cache,
+                                         const char *filepath,
+                                         const float frame_index,
+                                         const ImBuf *ibuf)
 {
-  BLI_mutex_lock(&disk_cache->read_write_mutex);
+  DiskCacheHeaderEntry new_entry;
+  seq_disk_cache_init_header_entry(frame_index, ibuf, &new_entry);
+
+  /* Compress before locking, reading other images doesn't have to wait for it. */
+  const void *data = seq_disk_cache_imbuf_data(ibuf);
+  size_t size = new_entry.size_raw;
+  Vector<uint8_t> compressed;
+  const int level = seq_disk_cache_compression_level();
+  if (level > 0) {
+    compressed = seq_disk_cache_compress(ibuf, level, &new_entry);
+    if (compressed.is_empty()) {
+      return false;
+    }
+    data = compressed.data();
+    size = compressed.size();
+  }
 
-  char filepath[FILE_MAX];
+  BLI_mutex_lock(&disk_cache->read_write_mutex);
 
-  seq_disk_cache_get_file_path(disk_cache, key, filepath, sizeof(filepath));
   BLI_file_ensure_parent_dir_exists(filepath);
 
   /* Touch the file. */
@@ -572,26 +713,76 @@ bool seq_disk_cache_write_file(SeqDiskCache *disk_cache, SeqCacheKey *key, ImBuf
     BLI_mutex_unlock(&disk_cache->read_write_mutex);
     return false;
   }
-  int entry_index = seq_disk_cache_add_header_entry(key, ibuf, &header);
+  int entry_index = seq_disk_cache_add_header_entry(&new_entry, &header);
 
-  size_t bytes_written = deflate_imbuf_to_file(
-      ibuf, file, seq_disk_cache_compression_level(), &header.entry[entry_index]);
+  BLI_fseek(file, header.entry[entry_index].offset, SEEK_SET);
+  const bool success = fwrite(data, 1, size, file) == size;
 
-  if (bytes_written != 0) {
+  if (success) {
     /* Last step is writing header, as image data can be overwritten,
      * but missing data would cause problems.
      */
-    header.entry[entry_index].size_compressed = bytes_written;
+    header.entry[entry_index].size_compressed = size;
     seq_disk_cache_write_header(file, &header);
-    seq_disk_cache_update_file(disk_cache, filepath);
-    fclose(file);
+  }
+  fclose(file);
 
-    BLI_mutex_unlock(&disk_cache->read_write_mutex);
-    return true;
+  if (success) {
+    seq_disk_cache_update_file(disk_cache, filepath);
+    disk_cache->bytes_raw_written += new_entry.size_raw;
+    disk_cache->bytes_written += size;
   }
 
   BLI_mutex_unlock(&disk_cache->read_write_mutex);
-  return false;
+  return success;
+}
+
+struct DiskCacheWriteTask {
+  SeqDiskCache *disk_cache;
+  char filepath[FILE_MAX];
+  float frame_index;
+  ImBuf *ibuf;
+};
+
+static void seq_disk_cache_write_task(TaskPool *__restrict /*pool*/, void *taskdata)
+{
+  DiskCacheWriteTask *task = static_cast<DiskCacheWriteTask *>(taskdata);
+  seq_disk_cache_write_file_ex(task->disk_cache, task->filepath, task->frame_index, task->ibuf);
+  seq_disk_cache_enforce_limits(task->disk_cache);
+}
+
+static void seq_disk_cache_write_task_free(TaskPool *__restrict /*pool*/, void *taskdata)
+{
+  DiskCacheWriteTask *task = static_cast<DiskCacheWriteTask *>(taskdata);
+  atomic_sub_and_fetch_int32(&task->disk_cache->pending_writes, 1);
+  IMB_freeImBuf(task->ibuf);
+  MEM_delete(task);
+}
+
+bool seq_disk_cache_write_file(SeqDiskCache *disk_cache, SeqCacheKey *key, ImBuf *ibuf)
+{
+  /* Writing is slower than rendering most images, when the writes can't keep up it's better to
+   * skip images than to keep all of them in memory. */
+  if (atomic_add_and_fetch_int32(&disk_cache->pending_writes, 1) > DCACHE_MAX_PENDING_WRITES) {
+    atomic_sub_and_fetch_int32(&disk_cache->pending_writes, 1);
+    atomic_add_and_fetch_int32(&disk_cache->writes_skipped, 1);
+    return false;
+  }
+
+  /* The key refers to data that may be freed before the task runs, resolve the path now. */
+  DiskCacheWriteTask *task = MEM_new<DiskCacheWriteTask>(__func__);
+  task->disk_cache = disk_cache;
+  seq_disk_cache_get_file_path(disk_cache, key, task->filepath, sizeof(task->filepath));
+  task->frame_index = key->frame_index;
+  task->ibuf = ibuf;
+  IMB_refImBuf(ibuf);
+
+  BLI_task_pool_push(disk_cache->write_pool,
+                     seq_disk_cache_write_task,
+                     task,
+                     true,
+                     seq_disk_cache_write_task_free);
+  return true;
 }
 
 ImBuf *seq_disk_cache_read_file(SeqDiskCache *disk_cache, SeqCacheKey *key)
@@ -602,24 +793,36 @@ ImBuf *seq_disk_cache_read_file(SeqDiskCache *disk_cache, SeqCacheKey *key)
   DiskCacheHeader header;
 
   seq_disk_cache_get_file_path(disk_cache, key, filepath, sizeof(filepath));
-  BLI_file_ensure_parent_dir_exists(filepath);
 
-  FILE *file = BLI_fopen(filepath, "rb");
-  if (!file) {
+  const int file = BLI_open(filepath, O_BINARY | O_RDONLY, 0);
+  if (file == -1) {
+    disk_cache->read_misses++;
     BLI_mutex_unlock(&disk_cache->read_write_mutex);
     return nullptr;
   }
 
-  if (!seq_disk_cache_read_header(file, &header)) {
-    fclose(file);
+  /* The mapping stays valid after the file is closed. */
+  BLI_mmap_file *mmap_file = BLI_mmap_open(file);
+  close(file);
+  if (mmap_file == nullptr) {
+    disk_cache->read_misses++;
+    BLI_mutex_unlock(&disk_cache->read_write_mutex);
+    return nullptr;
+  }
+
+  if (!BLI_mmap_read(mmap_file, &header, 0, sizeof(header))) {
+    BLI_mmap_free(mmap_file);
+    disk_cache->read_misses++;
     BLI_mutex_unlock(&disk_cache->read_write_mutex);
     return nullptr;
   }
+  seq_disk_cache_header_endian_switch(&header);
   int entry_index = seq_disk_cache_get_header_entry(key, &header);
 
   /* Item not found. */
   if (entry_index < 0) {
-    fclose(file);
+    BLI_mmap_free(mmap_file);
+    disk_cache->read_misses++;
     BLI_mutex_unlock(&disk_cache->read_write_mutex);
     return nullptr;
   }
@@ -627,49 +830,63 @@ ImBuf *seq_disk_cache_read_file(SeqDiskCache *disk_cache, SeqCacheKey *key)
   ImBuf *ibuf;
   uint64_t size_char = uint64_t(key->context.rectx) * key->context.recty * 4;
   uint64_t size_float = uint64_t(key->context.rectx) * key->context.recty * 16;
-  size_t expected_size;
 
   if (header.entry[entry_index].size_raw == size_char) {
-    expected_size = size_char;
     ibuf = IMB_allocImBuf(
         key->context.rectx, key->context.recty, 32, IB_rect | IB_uninitialized_pixels);
     IMB_colormanagement_assign_byte_colorspace(ibuf, header.entry[entry_index].colorspace_name);
   }
   else if (header.entry[entry_index].size_raw == size_float) {
-    expected_size = size_float;
     ibuf = IMB_allocImBuf(
         key->context.rectx, key->context.recty, 32, IB_rectfloat | IB_uninitialized_pixels);
     IMB_colormanagement_assign_float_colorspace(ibuf, header.entry[entry_index].colorspace_name);
   }
   else {
-    fclose(file);
+    BLI_mmap_free(mmap_file);
+    disk_cache->read_misses++;
     BLI_mutex_unlock(&disk_cache->read_write_mutex);
     return nullptr;
   }
 
-  size_t bytes_read = inflate_file_to_imbuf(ibuf, file, &header.entry[entry_index]);
+  const bool success = seq_disk_cache_decompress(mmap_file, &header.entry[entry_index], ibuf);
+  BLI_mmap_free(mmap_file);
 
   /* Sanity check. */
-  if (bytes_read != expected_size) {
-    fclose(file);
+  if (!success) {
     IMB_freeImBuf(ibuf);
+    disk_cache->read_misses++;
     BLI_mutex_unlock(&disk_cache->read_write_mutex);
     return nullptr;
   }
   BLI_file_touch(filepath);
   seq_disk_cache_update_file(disk_cache, filepath);
-  fclose(file);
+  disk_cache->read_hits++;
 
   BLI_mutex_unlock(&disk_cache->read_write_mutex);
   return ibuf;
 }
 
+void seq_disk_cache_statistics_get(SeqDiskCache *disk_cache, SeqDiskCacheStatistics *r_stats)
+{
+  BLI_mutex_lock(&disk_cache->read_write_mutex);
+  r_stats->read_hits = disk_cache->read_hits;
+  r_stats->read_misses = disk_cache->read_misses;
+  r_stats->compression_ratio = disk_cache->bytes_written ?
+                                   float(double(disk_cache->bytes_raw_written) /
+                                         double(disk_cache->bytes_written)) :
+                                   1.0f;
+  BLI_mutex_unlock(&disk_cache->read_write_mutex);
+  r_stats->pending_writes = atomic_load_int32(&disk_cache->pending_writes);
+  r_stats->writes_skipped = atomic_load_int32(&disk_cache->writes_skipped);
+}
+
 SeqDiskCache *seq_disk_cache_create(Main *bmain, Scene *scene)
 {
   SeqDiskCache *disk_cache = static_cast<SeqDiskCache *>(
       MEM_callocN(sizeof(SeqDiskCache), "SeqDiskCache"));
   disk_cache->bmain = bmain;
   BLI_mutex_init(&disk_cache->read_write_mutex);
+  disk_cache->write_pool = BLI_task_pool_create_background_serial(nullptr, TASK_PRIORITY_LOW);
   seq_disk_cache_handle_versioning(disk_cache);
   seq_disk_cache_get_files(disk_cache, seq_disk_cache_base_dir());
   disk_cache->timestamp = scene->ed->disk_cache_timestamp;
@@ -679,6 +896,8 @@ SeqDiskCache *seq_disk_cache_create(Main *bmain, Scene *scene)
 
 void seq_disk_cache_free(SeqDiskCache *disk_cache)
 {
+  seq_disk_cache_cancel_writes(disk_cache);
+  BLI_task_pool_free(disk_cache->write_pool);
   BLI_freelistN(&disk_cache->files);
   BLI_mutex_end(&disk_cache->read_write_mutex);
   MEM_freeN(disk_cache);
@@ -17,6 +17,7 @@ struct Main;
 struct Scene;
 struct SeqCacheKey;
 struct SeqDiskCache;
+struct SeqDiskCacheStatistics;
 struct Sequence;
 
 SeqDiskCache *seq_disk_cache_create(Main *bmain, Scene *scene);
@@ -25,6 +26,7 @@ bool seq_disk_cache_is_enabled(Main *bmain);
 ImBuf *seq_disk_cache_read_file(SeqDiskCache *disk_cache, SeqCacheKey *key);
 bool seq_disk_cache_write_file(SeqDiskCache *disk_cache, SeqCacheKey *key, ImBuf *ibuf);
 bool seq_disk_cache_enforce_limits(SeqDiskCache *disk_cache);
+void seq_disk_cache_statistics_get(SeqDiskCache *disk_cache, SeqDiskCacheStatistics *r_stats);
 void seq_disk_cache_invalidate(SeqDiskCache *disk_cache,
                                Scene *scene,
                                Sequence *seq,
@@ -811,15 +811,27 @@ void seq_cache_put(
   if (!key->is_temp_cache) {
     if (seq_disk_cache_is_enabled(context->bmain)) {
       if (cache->disk_cache == nullptr) {
-        seq_disk_cache_create(context->bmain, context->scene);
+        cache->disk_cache = seq_disk_cache_create(context->bmain, context->scene);
       }
 
+      /* Limits are enforced by the background write. */
       seq_disk_cache_write_file(cache->disk_cache, key, i);
-      seq_disk_cache_enforce_limits(cache->disk_cache);
     }
   }
 }
 
+void SEQ_cache_disk_statistics_get(Scene *scene, SeqDiskCacheStatistics *r_stats)
+{
+  *r_stats = {};
+  r_stats->compression_ratio = 1.0f;
+
+  SeqCache *cache = seq_cache_get_from_scene(scene);
+  if (cache == nullptr || cache->disk_cache == nullptr) {
+    return;
+  }
+  seq_disk_cache_statistics_get(cache->disk_cache, r_stats);
+}
+
 void SEQ_cache_iterate(
     Scene *scene,
     void *userdata,
@@ -503,6 +503,46 @@ bool SEQ_proxy_rebuild_context(Main *bmain,
   return true;
 }
 
+bool SEQ_proxy_seek_index_rebuild_context(Main *bmain,
+                                          Depsgraph *depsgraph,
+                                          Scene *scene,
+                                          Sequence *seq,
+                                          ListBase *queue)
+{
+  if (seq->type != SEQ_TYPE_MOVIE) {
+    return false;
+  }
+
+  /* Work on a copy like proxy building does, the anims of the strip are used for rendering. */
+  Sequence *nseq = SEQ_sequence_dupli_recursive(scene, scene, nullptr, seq, 0);
+  seq_open_anim_file(scene, nseq, true);
+
+  /* Only the first view is indexed. */
+  StripAnim *sanim = static_cast<StripAnim *>(nseq->anims.first);
+  IndexBuildContext *index_context = nullptr;
+  if (sanim && sanim->anim) {
+    index_context = IMB_anim_seek_index_rebuild_context(sanim->anim, false);
+  }
+
+  if (index_context == nullptr) {
+    seq_free_sequence_recurse(nullptr, nseq, true);
+    return false;
+  }
+
+  SeqIndexBuildContext *context = static_cast<SeqIndexBuildContext *>(
+      MEM_callocN(sizeof(SeqIndexBuildContext), "seq seek index rebuild context"));
+  context->index_context = index_context;
+  context->bmain = bmain;
+  context->depsgraph = depsgraph;
+  context->scene = scene;
+  context->orig_seq = seq;
+  context->orig_seq_uid = seq->runtime.session_uid;
+  context->seq = nseq;
+
+  BLI_addtail(queue, BLI_genericNodeN(context));
+  return true;
+}
+
 void SEQ_proxy_rebuild(SeqIndexBuildContext *context, wmJobWorkerStatus *worker_status)
 {
   const bool overwrite = context->overwrite;
@@ -18,6 +18,7 @@
 #include "DNA_sequence_types.h"
 #include "DNA_space_types.h"
 
+#include "BLI_array.hh"
 #include "BLI_linklist.h"
 #include "BLI_listbase.h"
 #include "BLI_math_geom.h"
@@ -457,6 +458,38 @@ static bool seq_need_scale_to_render_size(const Sequence *seq, bool is_proxy_ima
   return false;
 }
 
+static float seq_render_preview_scale_factor(const SeqRenderData *context)
+{
+  return context->preview_render_size == SEQ_RENDER_SIZE_SCENE ?
+             float(context->scene->r.size) / 100 :
+             SEQ_rendersize_to_scale_factor(context->preview_render_size);
+}
+
+/**
+ * While scrubbing a preview smaller than the media, decode the media directly at the preview
+ * size when possible, instead of decoding the full resolution and scaling it down afterwards.
+ * Such images have the size of a proxy and are handled like proxy images.
+ */
+static bool seq_render_use_reduced_decode(const SeqRenderData *context)
+{
+  return context->is_scrubbing && !context->for_render && !context->is_proxy_render &&
+         seq_render_preview_scale_factor(context) < 1.0f;
+}
+
+/** Scale an image decoded at a reduced resolution to the size of a proxy of the preview size. */
+static void seq_render_scale_to_preview_size(const SeqRenderData *context,
+                                             ImBuf *ibuf,
+                                             const int full_width,
+                                             const int full_height)
+{
+  const float scale = seq_render_preview_scale_factor(context);
+  const int width = max_ii(1, int(full_width * scale));
+  const int height = max_ii(1, int(full_height * scale));
+  if (ibuf->x != width || ibuf->y != height) {
+    IMB_scale(ibuf, width, height, IMBScaleFilter::Bilinear, false);
+  }
+}
+
 static void sequencer_image_crop_transform_matrix(const Sequence *seq,
                                                   const ImBuf *in,
                                                   const ImBuf *out,
@@ -545,11 +578,7 @@ static eIMBInterpolationFilterMode get_auto_filter(const StripTransform *transfo
 static void sequencer_preprocess_transform_crop(
     ImBuf *in, ImBuf *out, const SeqRenderData *context, Sequence *seq, const bool is_proxy_image)
 {
-  const Scene *scene = context->scene;
-  const float preview_scale_factor = context->preview_render_size == SEQ_RENDER_SIZE_SCENE ?
-                                         float(scene->r.size) / 100 :
-                                         SEQ_rendersize_to_scale_factor(
-                                             context->preview_render_size);
+  const float preview_scale_factor = seq_render_preview_scale_factor(context);
   const bool do_scale_to_render_size = seq_need_scale_to_render_size(seq, is_proxy_image);
   const float image_scale_factor = do_scale_to_render_size ? 1.0f : preview_scale_factor;
 
@@ -965,6 +994,43 @@ static ImBuf *seq_render_image_strip_view(const SeqRenderData *context,
   return ibuf;
 }
 
+/**
+ * Load an image at the preview size, see #seq_render_use_reduced_decode. The size of the full
+ * image must be known from a previous load.
+ */
+static ImBuf *seq_render_image_strip_reduced(const SeqRenderData *context,
+                                             Sequence *seq,
+                                             const char *filepath,
+                                             const StripElem *s_elem)
+{
+  int flag = IB_rect | IB_metadata;
+  if (seq->alpha_mode == SEQ_ALPHA_PREMUL) {
+    flag |= IB_alphamode_premul;
+  }
+
+  const float scale = seq_render_preview_scale_factor(context);
+  const size_t max_size = size_t(max_ii(s_elem->orig_width, s_elem->orig_height) * scale);
+  size_t full_width, full_height;
+  ImBuf *ibuf = IMB_load_image_reduced(filepath,
+                                       flag,
+                                       max_size,
+                                       seq->strip->colorspace_settings.name,
+                                       &full_width,
+                                       &full_height);
+  if (ibuf == nullptr) {
+    return nullptr;
+  }
+
+  /* We don't need both (speed reasons)! */
+  if (ibuf->float_buffer.data != nullptr && ibuf->byte_buffer.data != nullptr) {
+    imb_freerectImBuf(ibuf);
+  }
+
+  seq_render_scale_to_preview_size(context, ibuf, int(full_width), int(full_height));
+  seq_imbuf_to_sequencer_space(context->scene, ibuf, false);
+  return ibuf;
+}
+
 static bool seq_image_strip_is_multiview_render(Scene *scene,
                                                 Sequence *seq,
                                                 int totfiles,
@@ -1073,6 +1139,16 @@ static ImBuf *seq_render_image_strip(const SeqRenderData *context,
     MEM_freeN(ibufs_arr);
   }
   else {
+    if (seq_render_use_reduced_decode(context) && s_elem->orig_width > 0 &&
+        s_elem->orig_height > 0)
+    {
+      ibuf = seq_render_image_strip_reduced(context, seq, filepath, s_elem);
+      if (ibuf != nullptr) {
+        blender::seq::media_presence_set_missing(context->scene, seq, false);
+        *r_is_proxy_image = true;
+        return ibuf;
+      }
+    }
     ibuf = seq_render_image_strip_view(context, seq, filepath, prefix, ext, context->view_id);
   }
 
@@ -1118,6 +1194,53 @@ static IMB_Timecode_Type seq_render_movie_strip_timecode_get(Sequence *seq)
                                                IMB_TC_NONE);
 }
 
+/**
+ * Use any other built proxy of a movie when the proxy of the preview size is missing, see
+ * #seq_render_use_reduced_decode. Prefers the smallest proxy that is not smaller than the preview.
+ */
+static ImBuf *seq_render_movie_strip_other_proxy(const SeqRenderData *context,
+                                                 Sequence *seq,
+                                                 StripAnim *sanim,
+                                                 const int frame_index)
+{
+  const StripProxy *proxy = seq->strip->proxy;
+  if (proxy == nullptr || !context->use_proxies || (seq->flag & SEQ_USE_PROXY) == 0 ||
+      (proxy->storage & SEQ_STORAGE_PROXY_CUSTOM_FILE))
+  {
+    return nullptr;
+  }
+
+  const float scale = seq_render_preview_scale_factor(context);
+  const std::pair<IMB_Proxy_Size, float> sizes[] = {
+      {IMB_PROXY_25, 0.25f}, {IMB_PROXY_50, 0.5f}, {IMB_PROXY_75, 0.75f}, {IMB_PROXY_100, 1.0f}};
+  Vector<IMB_Proxy_Size> candidates;
+  for (const auto &[size, size_scale] : sizes) {
+    if ((proxy->build_size_flags & size) && size_scale >= scale) {
+      candidates.append(size);
+    }
+  }
+  for (int i = ARRAY_SIZE(sizes) - 1; i >= 0; i--) {
+    if ((proxy->build_size_flags & sizes[i].first) && sizes[i].second < scale) {
+      candidates.append(sizes[i].first);
+    }
+  }
+
+  for (const IMB_Proxy_Size size : candidates) {
+    ImBuf *ibuf = IMB_anim_absolute(sanim->anim,
+                                    frame_index + seq->anim_startofs,
+                                    seq_render_movie_strip_timecode_get(seq),
+                                    size);
+    if (ibuf != nullptr) {
+      seq_render_scale_to_preview_size(context,
+                                       ibuf,
+                                       IMB_anim_get_image_width(sanim->anim),
+                                       IMB_anim_get_image_height(sanim->anim));
+      return ibuf;
+    }
+  }
+  return nullptr;
+}
+
 /**
  * Render individual view for multi-view or single (default view) for mono-view.
  */
@@ -1152,6 +1275,13 @@ static ImBuf *seq_render_movie_strip_view(const SeqRenderData *context,
     }
   }
 
+  if (ibuf == nullptr && seq_render_use_reduced_decode(context)) {
+    ibuf = seq_render_movie_strip_other_proxy(context, seq, sanim, frame_index);
+    if (ibuf != nullptr) {
+      *r_is_proxy_image = true;
+    }
+  }
+
   /* Fetching for requested proxy size failed, try fetching the original instead. */
   if (ibuf == nullptr) {
     ibuf = IMB_anim_absolute(sanim->anim,
@@ -1859,6 +1989,31 @@ ImBuf *seq_render_strip(const SeqRenderData *context,
   return ibuf;
 }
 
+ImBuf *seq_render_strip_raw(const SeqRenderData *context, Sequence *seq, float timeline_frame)
+{
+  ImBuf *ibuf = nullptr;
+  bool is_proxy_image = false;
+
+  /* Proxies are not stored in cache. */
+  if (!SEQ_can_use_proxy(context, seq, SEQ_rendersize_to_proxysize(context->preview_render_size)))
+  {
+    ibuf = seq_cache_get(context, seq, timeline_frame, SEQ_CACHE_STORE_RAW);
+  }
+
+  if (ibuf == nullptr) {
+    SeqRenderState state;
+    BLI_mutex_lock(&seq_render_mutex);
+    ibuf = do_render_strip_uncached(context, &state, seq, timeline_frame, &is_proxy_image);
+    BLI_mutex_unlock(&seq_render_mutex);
+
+    if (ibuf && !is_proxy_image) {
+      seq_cache_put(context, seq, timeline_frame, SEQ_CACHE_STORE_RAW, ibuf);
+    }
+  }
+
+  return ibuf;
+}
+
 static bool seq_must_swap_input_in_blend_mode(Sequence *seq)
 {
   bool swap_input = false;
@@ -1944,6 +2099,80 @@ static bool is_opaque_alpha_over(const Sequence *seq)
   return true;
 }
 
+static bool seq_render_strip_is_thread_safe(const Sequence *seq)
+{
+  /* Scene strips need the main GPU context, effect and meta strips may share inputs with other
+   * strips of the stack. */
+  if (!ELEM(seq->type, SEQ_TYPE_IMAGE, SEQ_TYPE_MOVIE, SEQ_TYPE_COLOR)) {
+    return false;
+  }
+  /* The mask strip may be rendered by another thread at the same time. */
+  LISTBASE_FOREACH (SequenceModifierData *, smd, &seq->modifiers) {
+    if ((smd->flag & SEQUENCE_MODIFIER_MUTE) == 0 &&
+        smd->mask_input_type == SEQUENCE_MASK_INPUT_STRIP && smd->mask_sequence != nullptr)
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * Render the inputs of the stack concurrently, before they are blended in order. Only strips
+ * that are known to be needed are rendered: strips below a cached composite image and strips
+ * that could be hidden by an opaque strip above them are skipped.
+ *
+ * Returns the images indexed like `strips`, nullptr for strips that were not rendered.
+ */
+static Array<ImBuf *> seq_render_strip_stack_inputs_parallel(const SeqRenderData *context,
+                                                             SeqRenderState *state,
+                                                             Span<Sequence *> strips,
+                                                             float timeline_frame)
+{
+  Array<ImBuf *> ibufs(strips.size(), nullptr);
+
+  Vector<int64_t> indices;
+  OpaqueQuadTracker possible_occluders;
+  for (int64_t i = strips.size() - 1; i >= 0; i--) {
+    Sequence *seq = strips[i];
+
+    ImBuf *composite = seq_cache_get(context, seq, timeline_frame, SEQ_CACHE_STORE_COMPOSITE);
+    if (composite) {
+      IMB_freeImBuf(composite);
+      break;
+    }
+
+    const bool is_replace = seq->blend_mode == SEQ_BLEND_REPLACE;
+    const bool is_used = is_replace ||
+                         seq_get_early_out_for_blend_mode(seq) != StripEarlyOut::UseInput1;
+    if (is_used && !possible_occluders.is_occluded(context, seq, i) &&
+        seq_render_strip_is_thread_safe(seq))
+    {
+      indices.append(i);
+    }
+
+    if (is_replace) {
+      break;
+    }
+    if (is_opaque_alpha_over(seq)) {
+      possible_occluders.add_occluder(context, seq, i);
+    }
+  }
+
+  if (indices.size() < 2) {
+    return ibufs;
+  }
+
+  threading::parallel_for(indices.index_range(), 1, [&](const IndexRange range) {
+    for (const int64_t i : indices.as_span().slice(range)) {
+      SeqRenderState local_state = *state;
+      ibufs[i] = seq_render_strip(context, &local_state, strips[i], timeline_frame);
+    }
+  });
+
+  return ibufs;
+}
+
 static ImBuf *seq_render_strip_stack(const SeqRenderData *context,
                                      SeqRenderState *state,
                                      ListBase *channels,
@@ -1957,6 +2186,15 @@ static ImBuf *seq_render_strip_stack(const SeqRenderData *context,
     return nullptr;
   }
 
+  Array<ImBuf *> inputs = seq_render_strip_stack_inputs_parallel(
+      context, state, strips, timeline_frame);
+  /* Use the image rendered ahead if there is one, render the strip otherwise. */
+  auto render_strip = [&](const int64_t index) {
+    ImBuf *ibuf = inputs[index];
+    inputs[index] = nullptr;
+    return ibuf ? ibuf : seq_render_strip(context, state, strips[index], timeline_frame);
+  };
+
   OpaqueQuadTracker opaques;
 
   int64_t i;
@@ -1970,7 +2208,7 @@ static ImBuf *seq_render_strip_stack(const SeqRenderData *context,
       break;
     }
     if (seq->blend_mode == SEQ_BLEND_REPLACE) {
-      out = seq_render_strip(context, state, seq, timeline_frame);
+      out = render_strip(i);
       break;
     }
 
@@ -1986,15 +2224,15 @@ static ImBuf *seq_render_strip_stack(const SeqRenderData *context,
      * - If we are rendering a strip that is known to be opaque, we mark it as an occluder,
      *   so that strips below can check if they are completely hidden. */
     if (out == nullptr && early_out == StripEarlyOut::DoEffect && is_opaque_alpha_over(seq)) {
-      ImBuf *test = seq_render_strip(context, state, seq, timeline_frame);
+      ImBuf *test = render_strip(i);
       if (ELEM(test->planes, R_IMF_PLANES_BW, R_IMF_PLANES_RGB) || i == 0) {
         early_out = StripEarlyOut::UseInput2;
       }
       else {
         early_out = StripEarlyOut::DoEffect;
       }
-      /* Free the image. It is stored in cache, so this doesn't affect performance. */
-      IMB_freeImBuf(test);
+      /* Keep the image for blending, it is not always stored in the cache. */
+      inputs[i] = test;
 
       /* Check whether the raw (before preprocessing, which can add alpha) strip content
        * was opaque. */
@@ -2010,7 +2248,7 @@ static ImBuf *seq_render_strip_stack(const SeqRenderData *context,
     switch (early_out) {
       case StripEarlyOut::NoInput:
       case StripEarlyOut::UseInput2:
-        out = seq_render_strip(context, state, seq, timeline_frame);
+        out = render_strip(i);
         break;
       case StripEarlyOut::UseInput1:
         if (i == 0) {
@@ -2023,7 +2261,7 @@ static ImBuf *seq_render_strip_stack(const SeqRenderData *context,
           /* This is an effect at the bottom of the stack, so one of the inputs does not exist yet:
            * create one that is transparent black. Extra optimization for an alpha over strip at
            * the bottom, we can just return it instead of blending with black. */
-          ImBuf *ibuf2 = seq_render_strip(context, state, seq, timeline_frame);
+          ImBuf *ibuf2 = render_strip(i);
           const bool use_float = ibuf2 && ibuf2->float_buffer.data;
           ImBuf *ibuf1 = IMB_allocImBuf(
               context->rectx, context->recty, 32, use_float ? IB_rectfloat : IB_rect);
@@ -2055,7 +2293,7 @@ static ImBuf *seq_render_strip_stack(const SeqRenderData *context,
 
     if (seq_get_early_out_for_blend_mode(seq) == StripEarlyOut::DoEffect) {
       ImBuf *ibuf1 = out;
-      ImBuf *ibuf2 = seq_render_strip(context, state, seq, timeline_frame);
+      ImBuf *ibuf2 = render_strip(i);
 
       out = seq_render_strip_stack_apply_effect(context, seq, timeline_frame, ibuf1, ibuf2);
 
@@ -2066,6 +2304,11 @@ static ImBuf *seq_render_strip_stack(const SeqRenderData *context,
     seq_cache_put(context, strips[i], timeline_frame, SEQ_CACHE_STORE_COMPOSITE, out);
   }
 
+  /* Inputs rendered ahead that turned out to be occluded. */
+  for (ImBuf *ibuf : inputs) {
+    IMB_freeImBuf(ibuf);
+  }
+
   return out;
 }
 
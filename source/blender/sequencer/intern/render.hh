@@ -54,6 +54,13 @@ ImBuf *seq_render_strip(const SeqRenderData *context,
                         SeqRenderState *state,
                         Sequence *seq,
                         float timeline_frame);
+/**
+ * Render the strip image before preprocessing (transform, crop, color adjustments, modifiers),
+ * using the raw image cache when possible.
+ *
+ * \note The returned #ImBuf has its reference increased, free after usage!
+ */
+ImBuf *seq_render_strip_raw(const SeqRenderData *context, Sequence *seq, float timeline_frame);
 ImBuf *seq_render_mask(const SeqRenderData *context,
                        Mask *mask,
                        float frame_index,
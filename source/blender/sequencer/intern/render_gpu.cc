@@ -0,0 +1,335 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup sequencer
+ *
+ * \brief Compositing of the strip stack on the GPU for the preview.
+ *
+ * The raw strip images are uploaded to textures, which are kept as long as the images are shown.
+ * Each strip is then drawn as a transformed and cropped quad into an off-screen buffer, blending
+ * is done by the GPU blend state. Strips that need any other processing make the whole frame
+ * fall back to #SEQ_render_give_ibuf.
+ */
+
+#include "MEM_guardedalloc.h"
+
+#include "DNA_scene_types.h"
+#include "DNA_sequence_types.h"
+
+#include "BLI_listbase.h"
+#include "BLI_map.hh"
+#include "BLI_math_base.h"
+#include "BLI_vector.hh"
+
+#include "IMB_imbuf.hh"
+#include "IMB_imbuf_types.hh"
+
+#include "GPU_framebuffer.hh"
+#include "GPU_immediate.hh"
+#include "GPU_matrix.hh"
+#include "GPU_state.hh"
+#include "GPU_texture.hh"
+
+#include "SEQ_relations.hh"
+#include "SEQ_render.hh"
+#include "SEQ_sequencer.hh"
+#include "SEQ_transform.hh"
+
+#include "image_cache.hh"
+#include "prefetch.hh"
+#include "render.hh"
+
+using namespace blender;
+
+struct SeqRenderGPUCache {
+  GPUOffScreen *offscreen = nullptr;
+  /** Textures of the strip images, the images are referenced while they are in the map. */
+  Map<ImBuf *, GPUTexture *> textures;
+};
+
+static bool seq_gpu_strip_is_supported(const Sequence *seq)
+{
+  if (!ELEM(seq->type, SEQ_TYPE_IMAGE, SEQ_TYPE_MOVIE)) {
+    return false;
+  }
+  if (!ELEM(seq->blend_mode, SEQ_BLEND_REPLACE, SEQ_TYPE_ALPHAOVER, SEQ_TYPE_ADD)) {
+    return false;
+  }
+  /* Preprocessing which is only implemented for #ImBuf. */
+  if (seq->sat != 1.0f || seq->modifiers.first != nullptr) {
+    return false;
+  }
+  if (seq->type == SEQ_TYPE_IMAGE && (seq->flag & SEQ_FILTERY)) {
+    return false;
+  }
+  return true;
+}
+
+static GPUTexture *seq_gpu_texture_create(const ImBuf *ibuf)
+{
+  GPUTexture *texture = nullptr;
+  const eGPUTextureUsage usage = GPU_TEXTURE_USAGE_SHADER_READ;
+  if (ibuf->float_buffer.data) {
+    if (ibuf->channels != 4) {
+      return nullptr;
+    }
+    texture = GPU_texture_create_2d(
+        "seq_strip_image", ibuf->x, ibuf->y, 1, GPU_RGBA16F, usage, nullptr);
+    if (texture) {
+      GPU_texture_update(texture, GPU_DATA_FLOAT, ibuf->float_buffer.data);
+    }
+  }
+  else if (ibuf->byte_buffer.data) {
+    texture = GPU_texture_create_2d(
+        "seq_strip_image", ibuf->x, ibuf->y, 1, GPU_RGBA8, usage, nullptr);
+    if (texture) {
+      GPU_texture_update(texture, GPU_DATA_UBYTE, ibuf->byte_buffer.data);
+    }
+  }
+  return texture;
+}
+
+/**
+ * Blend state matching the CPU blend effects. Byte images have straight alpha and float images
+ * have premultiplied alpha, the off-screen buffer always stores premultiplied alpha.
+ */
+static void seq_gpu_strip_blend_set(const Sequence *seq, const ImBuf *ibuf)
+{
+  const bool is_premultiplied = ibuf->float_buffer.data != nullptr;
+  float mul = seq->mul;
+  float opacity = 1.0f;
+  if (seq->blend_mode == SEQ_BLEND_REPLACE) {
+    mul *= seq->blend_opacity / 100.0f;
+  }
+  else {
+    opacity = seq->blend_opacity / 100.0f;
+  }
+  const float alpha = ((seq->flag & SEQ_MULTIPLY_ALPHA) ? mul : 1.0f) * opacity;
+
+  if (seq->blend_mode == SEQ_TYPE_ADD) {
+    /* The add effect scales the added color by its alpha for both byte and float images. */
+    immUniformColor4f(mul, mul, mul, alpha);
+    GPU_blend(GPU_BLEND_ADDITIVE);
+  }
+  else if (is_premultiplied) {
+    const float color_mul = mul * opacity;
+    immUniformColor4f(color_mul, color_mul, color_mul, alpha);
+    GPU_blend(GPU_BLEND_ALPHA_PREMULT);
+  }
+  else {
+    immUniformColor4f(mul, mul, mul, alpha);
+    GPU_blend(GPU_BLEND_ALPHA);
+  }
+}
+
+static void seq_gpu_strip_draw(const Scene *scene,
+                               const Sequence *seq,
+                               const ImBuf *ibuf,
+                               GPUTexture *texture,
+                               const uint pos,
+                               const uint texcoord)
+{
+  float quad[4][2];
+  SEQ_image_transform_final_quad_get(scene, seq, quad);
+
+  /* Crop in normalized texture coordinates, the quad corners are ordered as
+   * top right, bottom right, bottom left and top left. */
+  const StripCrop *crop = seq->strip->crop;
+  float image_size[2] = {float(ibuf->x), float(ibuf->y)};
+  if (seq->strip->stripdata->orig_width > 0 && seq->strip->stripdata->orig_height > 0) {
+    image_size[0] = seq->strip->stripdata->orig_width;
+    image_size[1] = seq->strip->stripdata->orig_height;
+  }
+  const float u_min = crop->left / image_size[0];
+  const float u_max = 1.0f - crop->right / image_size[0];
+  const float v_min = crop->bottom / image_size[1];
+  const float v_max = 1.0f - crop->top / image_size[1];
+  const float texcoords[4][2] = {{u_max, v_max}, {u_max, v_min}, {u_min, v_min}, {u_min, v_max}};
+
+  const StripTransform *transform = seq->strip->transform;
+  GPU_texture_filter_mode(texture, transform->filter != SEQ_TRANSFORM_FILTER_NEAREST);
+  immBindTexture("image", texture);
+
+  immBegin(GPU_PRIM_TRI_FAN, 4);
+  for (int i = 0; i < 4; i++) {
+    immAttr2fv(texcoord, texcoords[i]);
+    immVertex2fv(pos, quad[i]);
+  }
+  immEnd();
+}
+
+static GPUOffScreen *seq_gpu_offscreen_ensure(SeqRenderGPUCache &cache,
+                                              const int width,
+                                              const int height)
+{
+  if (cache.offscreen && (GPU_offscreen_width(cache.offscreen) != width ||
+                          GPU_offscreen_height(cache.offscreen) != height))
+  {
+    GPU_offscreen_free(cache.offscreen);
+    cache.offscreen = nullptr;
+  }
+  if (cache.offscreen == nullptr) {
+    /* Host read is needed when the display transform can't be done on the GPU. */
+    const eGPUTextureUsage usage = GPU_TEXTURE_USAGE_SHADER_READ | GPU_TEXTURE_USAGE_ATTACHMENT |
+                                   GPU_TEXTURE_USAGE_HOST_READ;
+    cache.offscreen = GPU_offscreen_create(width, height, false, GPU_RGBA16F, usage, nullptr);
+  }
+  return cache.offscreen;
+}
+
+static void seq_gpu_textures_free(Map<ImBuf *, GPUTexture *> &textures)
+{
+  for (const auto item : textures.items()) {
+    GPU_texture_free(item.value);
+    IMB_freeImBuf(item.key);
+  }
+  textures.clear();
+}
+
+GPUTexture *SEQ_render_give_gpu_texture(const SeqRenderData *context,
+                                        float timeline_frame,
+                                        int chanshown,
+                                        SeqRenderGPUCache **cache)
+{
+  Scene *scene = context->scene;
+  Editing *ed = SEQ_editing_get(scene);
+  ListBase *seqbasep;
+  ListBase *channels;
+
+  if (ed == nullptr) {
+    return nullptr;
+  }
+
+  if ((chanshown < 0) && !BLI_listbase_is_empty(&ed->metastack)) {
+    int count = BLI_listbase_count(&ed->metastack);
+    count = max_ii(count + chanshown, 0);
+    seqbasep = ((MetaStack *)BLI_findlink(&ed->metastack, count))->oldbasep;
+    channels = ((MetaStack *)BLI_findlink(&ed->metastack, count))->old_channels;
+  }
+  else {
+    seqbasep = ed->seqbasep;
+    channels = ed->displayed_channels;
+  }
+
+  Vector<Sequence *> shown_strips = seq_get_shown_sequences(
+      scene, channels, seqbasep, timeline_frame, chanshown);
+  if (shown_strips.is_empty()) {
+    return nullptr;
+  }
+
+  /* Strips below the top-most replacing strip don't contribute to the result. */
+  int64_t first_index = 0;
+  for (int64_t i = shown_strips.size() - 1; i >= 0; i--) {
+    if (shown_strips[i]->blend_mode == SEQ_BLEND_REPLACE) {
+      first_index = i;
+      break;
+    }
+  }
+  const Span<Sequence *> strips = shown_strips.as_span().drop_front(first_index);
+
+  for (const Sequence *seq : strips) {
+    if (!seq_gpu_strip_is_supported(seq)) {
+      return nullptr;
+    }
+  }
+
+  seq_cache_free_temp_cache(scene, context->task_id, timeline_frame);
+  /* Make sure we only keep the `anim` data for strips that are in view. */
+  SEQ_relations_free_all_anim_ibufs(scene, timeline_frame);
+
+  if (*cache == nullptr) {
+    *cache = MEM_new<SeqRenderGPUCache>(__func__);
+  }
+  SeqRenderGPUCache &gpu_cache = **cache;
+
+  /* Gather the strip textures, reusing the ones of images which are still shown. */
+  Map<ImBuf *, GPUTexture *> textures;
+  Vector<ImBuf *> ibufs;
+  bool is_supported = true;
+  for (Sequence *seq : strips) {
+    ImBuf *ibuf = seq_render_strip_raw(context, seq, timeline_frame);
+    if (ibuf == nullptr) {
+      is_supported = false;
+      break;
+    }
+    GPUTexture *texture = textures.lookup_default(ibuf, nullptr);
+    if (texture == nullptr) {
+      texture = gpu_cache.textures.pop_default(ibuf, nullptr);
+    }
+    if (texture) {
+      /* Only one reference is kept per image. */
+      IMB_freeImBuf(ibuf);
+    }
+    else {
+      texture = seq_gpu_texture_create(ibuf);
+      if (texture == nullptr) {
+        IMB_freeImBuf(ibuf);
+        is_supported = false;
+        break;
+      }
+    }
+    textures.add(ibuf, texture);
+    ibufs.append(ibuf);
+  }
+
+  seq_gpu_textures_free(gpu_cache.textures);
+  gpu_cache.textures = std::move(textures);
+
+  if (!is_supported) {
+    return nullptr;
+  }
+
+  GPUOffScreen *offscreen = seq_gpu_offscreen_ensure(gpu_cache, context->rectx, context->recty);
+  if (offscreen == nullptr) {
+    return nullptr;
+  }
+
+  GPU_offscreen_bind(offscreen, true);
+  GPU_clear_color(0.0f, 0.0f, 0.0f, 0.0f);
+  GPU_depth_test(GPU_DEPTH_NONE);
+
+  /* Map the strip quads, which are in scene pixels with the pixel aspect applied, to the
+   * off-screen buffer which is scaled by the preview size. */
+  const float half_width = 0.5f * scene->r.xsch * scene->r.xasp / scene->r.yasp;
+  const float half_height = 0.5f * scene->r.ysch;
+  GPU_matrix_push();
+  GPU_matrix_push_projection();
+  GPU_matrix_identity_set();
+  GPU_matrix_ortho_set(-half_width, half_width, -half_height, half_height, -1.0f, 1.0f);
+
+  GPUVertFormat *format = immVertexFormat();
+  const uint pos = GPU_vertformat_attr_add(format, "pos", GPU_COMP_F32, 2, GPU_FETCH_FLOAT);
+  const uint texcoord = GPU_vertformat_attr_add(
+      format, "texCoord", GPU_COMP_F32, 2, GPU_FETCH_FLOAT);
+  immBindBuiltinProgram(GPU_SHADER_3D_IMAGE_COLOR);
+
+  for (const int64_t i : strips.index_range()) {
+    ImBuf *ibuf = ibufs[i];
+    seq_gpu_strip_blend_set(strips[i], ibuf);
+    seq_gpu_strip_draw(scene, strips[i], ibuf, gpu_cache.textures.lookup(ibuf), pos, texcoord);
+  }
+
+  immUnbindProgram();
+  GPU_blend(GPU_BLEND_NONE);
+  GPU_matrix_pop_projection();
+  GPU_matrix_pop();
+  GPU_offscreen_unbind(offscreen, true);
+
+  seq_prefetch_start(context, timeline_frame);
+
+  return GPU_offscreen_color_texture(offscreen);
+}
+
+void SEQ_render_gpu_cache_free(SeqRenderGPUCache *cache)
+{
+  if (cache == nullptr) {
+    return;
+  }
+  seq_gpu_textures_free(cache->textures);
+  if (cache->offscreen) {
+    GPU_offscreen_free(cache->offscreen);
+  }
+  MEM_delete(cache);
+}
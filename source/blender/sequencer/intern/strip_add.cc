@@ -52,6 +52,7 @@
 #include "proxy.hh"
 #include "sequencer.hh"
 #include "strip_time.hh"
+#include "utils.hh"
 
 void SEQ_add_load_data_init(SeqLoadData *load_data,
                             const char *name,
@@ -580,7 +581,7 @@ void SEQ_add_reload_new_file(Main *bmain, Scene *scene, Sequence *seq, const boo
 
             seq_multiview_name(scene, i, prefix, ext, filepath_view, sizeof(filepath_view));
             anim = openanim(filepath_view,
-                            IB_rect | ((seq->flag & SEQ_FILTERY) ? IB_animdeinterlace : 0),
+                            seq_anim_open_flags_get(seq),
                             seq->streamindex,
                             seq->strip->colorspace_settings.name);
 
@@ -598,7 +599,7 @@ void SEQ_add_reload_new_file(Main *bmain, Scene *scene, Sequence *seq, const boo
       if (is_multiview_loaded == false) {
         ImBufAnim *anim;
         anim = openanim(filepath,
-                        IB_rect | ((seq->flag & SEQ_FILTERY) ? IB_animdeinterlace : 0),
+                        seq_anim_open_flags_get(seq),
                         seq->streamindex,
                         seq->strip->colorspace_settings.name);
         if (anim) {
@@ -6,13 +6,21 @@
  * \ingroup sequencer
  */
 
+#include <algorithm>
+#include <cstdio>
+#include <mutex>
+
+#include "BLI_fileops.h"
+#include "BLI_fileops_types.h"
 #include "BLI_map.hh"
 #include "BLI_math_base.h"
 #include "BLI_path_util.h"
 #include "BLI_set.hh"
+#include "BLI_string.h"
 #include "BLI_task.hh"
 #include "BLI_vector.hh"
 
+#include "BKE_appdir.hh"
 #include "BKE_context.hh"
 #include "BKE_main.hh"
 
@@ -32,6 +40,8 @@
 namespace blender::seq {
 
 static constexpr int MAX_THUMBNAILS = 5000;
+/** Size of the on-disk thumbnail cache, the oldest files are removed when it's exceeded. */
+static constexpr int64_t MAX_DISK_CACHE_SIZE = 512ll * 1024 * 1024;
 
 // #define DEBUG_PRINT_THUMB_JOB_TIMES
 
@@ -232,17 +242,170 @@ static void scale_to_thumbnail_size(ImBuf *ibuf)
   IMB_scale(ibuf, width, height, IMBScaleFilter::Nearest, false);
 }
 
+/* -------------------------------------------------------------------- */
+/** \name On-Disk Thumbnail Cache
+ *
+ * Decoding a movie frame is much slower than reading a small thumbnail, so movie thumbnails are
+ * also stored in the user cache directory and reused by later sessions. Files are identified by
+ * the path, size and modification time of the movie, so a changed movie gets new thumbnails.
+ * \{ */
+
+static constexpr char THUMB_DISK_MAGIC[4] = {'S', 'Q', 'T', 'B'};
+static constexpr int THUMB_DISK_VERSION = 1;
+
+struct ThumbDiskHeader {
+  char magic[4];
+  int32_t version;
+  int32_t width;
+  int32_t height;
+};
+
+static bool thumb_disk_dir_get(char r_dirpath[FILE_MAX])
+{
+  if (!BKE_appdir_folder_caches(r_dirpath, FILE_MAX)) {
+    return false;
+  }
+  BLI_path_append_dir(r_dirpath, FILE_MAX, "sequencer_thumbnails");
+  return true;
+}
+
+static bool thumb_disk_filepath_get(const ThumbnailCache::Request &request,
+                                    char r_filepath[FILE_MAX])
+{
+  char dirpath[FILE_MAX];
+  BLI_stat_t st;
+  if (!thumb_disk_dir_get(dirpath) || BLI_stat(request.file_path.c_str(), &st) != 0) {
+    return false;
+  }
+  const uint64_t file_hash = get_default_hash(
+      request.file_path, uint64_t(st.st_size), uint64_t(st.st_mtime));
+  char filename[FILE_MAXFILE];
+  SNPRINTF(filename,
+           "%016llx_%d_%d.thumb",
+           (unsigned long long)file_hash,
+           request.stream_index,
+           request.frame_index);
+  BLI_path_join(r_filepath, FILE_MAX, dirpath, filename);
+  return true;
+}
+
+static ImBuf *thumb_disk_read(const ThumbnailCache::Request &request)
+{
+  char filepath[FILE_MAX];
+  if (!thumb_disk_filepath_get(request, filepath)) {
+    return nullptr;
+  }
+  FILE *file = BLI_fopen(filepath, "rb");
+  if (file == nullptr) {
+    return nullptr;
+  }
+
+  ImBuf *ibuf = nullptr;
+  ThumbDiskHeader header;
+  if (fread(&header, sizeof(header), 1, file) == 1 &&
+      memcmp(header.magic, THUMB_DISK_MAGIC, sizeof(header.magic)) == 0 &&
+      header.version == THUMB_DISK_VERSION && header.width > 0 &&
+      header.width <= SEQ_THUMB_SIZE && header.height > 0 && header.height <= SEQ_THUMB_SIZE)
+  {
+    ibuf = IMB_allocImBuf(header.width, header.height, 32, IB_rect);
+    const size_t size = size_t(header.width) * header.height * 4;
+    if (ibuf != nullptr && fread(ibuf->byte_buffer.data, size, 1, file) != 1) {
+      IMB_freeImBuf(ibuf);
+      ibuf = nullptr;
+    }
+  }
+  fclose(file);
+  return ibuf;
+}
+
+static void thumb_disk_write(const ThumbnailCache::Request &request, const ImBuf *thumb)
+{
+  if (thumb->byte_buffer.data == nullptr) {
+    return;
+  }
+  char filepath[FILE_MAX];
+  if (!thumb_disk_filepath_get(request, filepath) ||
+      !BLI_file_ensure_parent_dir_exists(filepath))
+  {
+    return;
+  }
+
+  /* Write to a temporary file first, so that readers never see partially written files. */
+  char filepath_tmp[FILE_MAX];
+  SNPRINTF(filepath_tmp, "%s.tmp", filepath);
+  FILE *file = BLI_fopen(filepath_tmp, "wb");
+  if (file == nullptr) {
+    return;
+  }
+  ThumbDiskHeader header;
+  memcpy(header.magic, THUMB_DISK_MAGIC, sizeof(header.magic));
+  header.version = THUMB_DISK_VERSION;
+  header.width = thumb->x;
+  header.height = thumb->y;
+  const size_t size = size_t(thumb->x) * thumb->y * 4;
+  const bool success = fwrite(&header, sizeof(header), 1, file) == 1 &&
+                       fwrite(thumb->byte_buffer.data, size, 1, file) == 1;
+  fclose(file);
+  if (!success || BLI_rename_overwrite(filepath_tmp, filepath) != 0) {
+    BLI_delete(filepath_tmp, false, false);
+  }
+}
+
+/** Remove the oldest thumbnails when the cache is larger than #MAX_DISK_CACHE_SIZE. */
+static void thumb_disk_enforce_limits()
+{
+  char dirpath[FILE_MAX];
+  if (!thumb_disk_dir_get(dirpath) || !BLI_is_dir(dirpath)) {
+    return;
+  }
+  direntry *filelist;
+  const uint filelist_num = BLI_filelist_dir_contents(dirpath, &filelist);
+  Vector<const direntry *> files;
+  int64_t total_size = 0;
+  for (const uint i : IndexRange(filelist_num)) {
+    if (S_ISREG(filelist[i].s.st_mode)) {
+      files.append(&filelist[i]);
+      total_size += filelist[i].s.st_size;
+    }
+  }
+  if (total_size > MAX_DISK_CACHE_SIZE) {
+    std::sort(files.begin(), files.end(), [](const direntry *a, const direntry *b) {
+      return a->s.st_mtime < b->s.st_mtime;
+    });
+    /* Remove a bit more than needed, to not do this again soon. */
+    for (const direntry *file : files) {
+      if (total_size <= MAX_DISK_CACHE_SIZE * 3 / 4) {
+        break;
+      }
+      BLI_delete(file->path, false, false);
+      total_size -= file->s.st_size;
+    }
+  }
+  BLI_filelist_free(filelist, filelist_num);
+}
+
+/** \} */
+
 /* Background job that processes in-flight thumbnail requests. */
 class ThumbGenerationJob {
   Scene *scene_ = nullptr;
   ThumbnailCache *cache_ = nullptr;
 
+  /* Movies opened by the job, shared between all the requests for the same file and stream
+   * while the job runs. Requests of one file are processed by a single thread at a time. */
+  Map<std::pair<std::string, int>, ImBufAnim *> anims_;
+  std::mutex anims_mutex_;
+
  public:
   ThumbGenerationJob(Scene *scene, ThumbnailCache *cache) : scene_(scene), cache_(cache) {}
 
   static void ensure_job(const bContext *C, ThumbnailCache *cache);
 
  private:
+  ImBufAnim *anim_get(const ThumbnailCache::Request &request);
+  ImBuf *make_thumb_for_movie(const ThumbnailCache::Request &request);
+  void free_anims();
+
   static void run_fn(void *customdata, wmJobWorkerStatus *worker_status);
   static void end_fn(void *customdata);
   static void free_fn(void *customdata);
@@ -271,6 +434,44 @@ void ThumbGenerationJob::free_fn(void *customdata)
   MEM_delete(job);
 }
 
+ImBufAnim *ThumbGenerationJob::anim_get(const ThumbnailCache::Request &request)
+{
+  std::scoped_lock lock(anims_mutex_);
+  return anims_.lookup_or_add_cb({request.file_path, request.stream_index}, [&]() {
+    return IMB_open_anim(request.file_path.c_str(), IB_rect, request.stream_index, nullptr);
+  });
+}
+
+void ThumbGenerationJob::free_anims()
+{
+  for (ImBufAnim *anim : anims_.values()) {
+    if (anim != nullptr) {
+      IMB_free_anim(anim);
+    }
+  }
+  anims_.clear();
+}
+
+ImBuf *ThumbGenerationJob::make_thumb_for_movie(const ThumbnailCache::Request &request)
+{
+  ImBuf *thumb = thumb_disk_read(request);
+  if (thumb == nullptr) {
+    /* Decode the movie frame. */
+    ImBufAnim *anim = anim_get(request);
+    if (anim == nullptr) {
+      return nullptr;
+    }
+    thumb = IMB_anim_absolute(anim, request.frame_index, IMB_TC_NONE, IMB_PROXY_NONE);
+    if (thumb == nullptr) {
+      return nullptr;
+    }
+    scale_to_thumbnail_size(thumb);
+    thumb_disk_write(request, thumb);
+  }
+  seq_imbuf_assign_spaces(scene_, thumb);
+  return thumb;
+}
+
 void ThumbGenerationJob::run_fn(void *customdata, wmJobWorkerStatus *worker_status)
 {
 #ifdef DEBUG_PRINT_THUMB_JOB_TIMES
@@ -311,94 +512,81 @@ void ThumbGenerationJob::run_fn(void *customdata, wmJobWorkerStatus *worker_stat
                 return a.frame_index < b.frame_index;
               });
 
-    /* Process the requests in parallel. Split requests into approximately 4 groups:
-     * we don't want to go too wide since that would potentially mean that a single input
-     * movie gets assigned to more than one thread, and the thumbnail loading itself
-     * is somewhat-threaded already. */
-    int64_t grain_size = math::max<int64_t>(8, requests.size() / 4);
-    threading::parallel_for(requests.index_range(), grain_size, [&](IndexRange range) {
-      /* Often the same movie file is chopped into multiple strips next to each other.
-       * Since the requests are sorted by file path and frame index, we can reuse ImBufAnim
-       * objects between them for performance. */
-      ImBufAnim *cur_anim = nullptr;
-      std::string cur_anim_path;
-      int cur_stream = 0;
-      for (const int i : range) {
-        const ThumbnailCache::Request &request = requests[i];
-        if (worker_status->stop) {
-          break;
-        }
+    /* Group the requests by file and stream. Each group is processed by one thread, so that
+     * a movie is opened once and its frames are decoded in order, reusing the decoder state. */
+    Vector<IndexRange> groups;
+    for (int64_t start = 0; start < requests.size();) {
+      int64_t end = start + 1;
+      while (end < requests.size() && requests[end].file_path == requests[start].file_path &&
+             requests[end].stream_index == requests[start].stream_index)
+      {
+        end++;
+      }
+      groups.append(IndexRange(start, end - start));
+      start = end;
+    }
+
+    threading::parallel_for(groups.index_range(), 1, [&](IndexRange group_range) {
+      for (const int group_index : group_range) {
+        for (const int i : groups[group_index]) {
+          const ThumbnailCache::Request &request = requests[i];
+          if (worker_status->stop) {
+            return;
+          }
 
 #ifdef DEBUG_PRINT_THUMB_JOB_TIMES
-        ++total_thumbs;
+          ++total_thumbs;
 #endif
-        ImBuf *thumb = nullptr;
-        if (request.seq_type == SEQ_TYPE_IMAGE) {
-          /* Load thumbnail for an image. */
+          ImBuf *thumb = nullptr;
+          if (request.seq_type == SEQ_TYPE_IMAGE) {
+            /* Load thumbnail for an image. */
 #ifdef DEBUG_PRINT_THUMB_JOB_TIMES
-          ++total_images;
+            ++total_images;
 #endif
-          thumb = make_thumb_for_image(job->scene_, request);
-        }
-        else if (request.seq_type == SEQ_TYPE_MOVIE) {
-          /* Load thumbnail for an movie. */
+            thumb = make_thumb_for_image(job->scene_, request);
+            scale_to_thumbnail_size(thumb);
+          }
+          else if (request.seq_type == SEQ_TYPE_MOVIE) {
+            /* Load thumbnail for an movie. */
 #ifdef DEBUG_PRINT_THUMB_JOB_TIMES
-          ++total_movies;
+            ++total_movies;
 #endif
-
-          /* Are we switching to a different movie file / stream? */
-          if (request.file_path != cur_anim_path || request.stream_index != cur_stream) {
-            if (cur_anim != nullptr) {
-              IMB_free_anim(cur_anim);
-              cur_anim = nullptr;
-            }
-
-            cur_anim_path = request.file_path;
-            cur_stream = request.stream_index;
-            cur_anim = IMB_open_anim(cur_anim_path.c_str(), IB_rect, cur_stream, nullptr);
+            thumb = job->make_thumb_for_movie(request);
+          }
+          else {
+            BLI_assert_unreachable();
           }
 
-          /* Decode the movie frame. */
-          if (cur_anim != nullptr) {
-            thumb = IMB_anim_absolute(cur_anim, request.frame_index, IMB_TC_NONE, IMB_PROXY_NONE);
-            if (thumb != nullptr) {
-              seq_imbuf_assign_spaces(job->scene_, thumb);
+          /* Add result into the cache (under cache mutex lock). */
+          {
+            std::scoped_lock lock(thumb_cache_mutex);
+            ThumbnailCache::FileEntry *val = job->cache_->map_.lookup_ptr(request.file_path);
+            if (val != nullptr) {
+              val->used_at = math::max(val->used_at, request.requested_at);
+              val->frames.append(
+                  {request.frame_index, request.stream_index, thumb, request.requested_at});
             }
+            else {
+              IMB_freeImBuf(thumb);
+            }
+            /* Remove the request from original set. */
+            job->cache_->requests_.remove(request);
           }
-        }
-        else {
-          BLI_assert_unreachable();
-        }
 
-        scale_to_thumbnail_size(thumb);
-
-        /* Add result into the cache (under cache mutex lock). */
-        {
-          std::scoped_lock lock(thumb_cache_mutex);
-          ThumbnailCache::FileEntry *val = job->cache_->map_.lookup_ptr(request.file_path);
-          if (val != nullptr) {
-            val->used_at = math::max(val->used_at, request.requested_at);
-            val->frames.append(
-                {request.frame_index, request.stream_index, thumb, request.requested_at});
-          }
-          else {
-            IMB_freeImBuf(thumb);
+          if (thumb) {
+            worker_status->do_update = true;
           }
-          /* Remove the request from original set. */
-          job->cache_->requests_.remove(request);
         }
-
-        if (thumb) {
-          worker_status->do_update = true;
-        }
-      }
-      if (cur_anim != nullptr) {
-        IMB_free_anim(cur_anim);
-        cur_anim = nullptr;
       }
     });
   }
 
+  job->free_anims();
+
+  /* Checking the disk usage requires listing the whole directory, do it once per session. */
+  static std::once_flag disk_limits_checked;
+  std::call_once(disk_limits_checked, thumb_disk_enforce_limits);
+
 #ifdef DEBUG_PRINT_THUMB_JOB_TIMES
   clock_t t1 = clock();
   printf("VSE thumb job: %i thumbs (%i img, %i movie) in %.3f sec\n",
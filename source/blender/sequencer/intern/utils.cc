@@ -16,6 +16,7 @@
 
 #include "DNA_scene_types.h"
 #include "DNA_sequence_types.h"
+#include "DNA_userdef_types.h"
 
 #include "BLI_blenlib.h"
 #include "BLI_vector_set.hh"
@@ -202,6 +203,18 @@ ListBase *SEQ_get_seqbase_from_sequence(Sequence *seq, ListBase **r_channels, in
   return seqbase;
 }
 
+int seq_anim_open_flags_get(const Sequence *seq)
+{
+  int flags = IB_rect;
+  if (seq->flag & SEQ_FILTERY) {
+    flags |= IB_animdeinterlace;
+  }
+  if (U.sequencer_editor_flag & USER_SEQ_ED_HARDWARE_DECODE) {
+    flags |= IB_animhwdecode;
+  }
+  return flags;
+}
+
 static void open_anim_filepath(Sequence *seq,
                                StripAnim *sanim,
                                const char *filepath,
@@ -209,13 +222,13 @@ static void open_anim_filepath(Sequence *seq,
 {
   if (openfile) {
     sanim->anim = openanim(filepath,
-                           IB_rect | ((seq->flag & SEQ_FILTERY) ? IB_animdeinterlace : 0),
+                           seq_anim_open_flags_get(seq),
                            seq->streamindex,
                            seq->strip->colorspace_settings.name);
   }
   else {
     sanim->anim = openanim_noload(filepath,
-                                  IB_rect | ((seq->flag & SEQ_FILTERY) ? IB_animdeinterlace : 0),
+                                  seq_anim_open_flags_get(seq),
                                   seq->streamindex,
                                   seq->strip->colorspace_settings.name);
   }
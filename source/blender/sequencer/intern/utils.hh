@@ -10,7 +10,10 @@
 
 struct ListBase;
 struct Scene;
+struct Sequence;
 
 bool sequencer_seq_generates_image(Sequence *seq);
+/** #ImBuf flags to open the movie files of a strip with. */
+int seq_anim_open_flags_get(const Sequence *seq);
 void seq_open_anim_file(Scene *scene, Sequence *seq, bool openfile);
 Sequence *SEQ_get_meta_by_seqbase(ListBase *seqbase_main, ListBase *meta_seqbase);
@@ -17,9 +17,12 @@
 #  include "DNA_scene_types.h"
 #  include "DNA_texture_types.h"
 
+#  include "BLI_array.hh"
 #  include "BLI_math_geom.h"
 #  include "BLI_math_matrix.h"
 #  include "BLI_math_vector.h"
+#  include "BLI_offset_indices.hh"
+#  include "BLI_task.hh"
 #  include "BLI_utildefines.h"
 
 #  include "BKE_cloth.hh"
@@ -42,7 +45,17 @@
 #    include "BLI_time.h"
 #  endif
 
+using blender::Array;
+using blender::IndexRange;
+using blender::OffsetIndices;
+
 static float I[3][3] = {{1, 0, 0}, {0, 1, 0}, {0, 0, 1}};
+
+/**
+ * Number of vertices processed by a task in the long vector and big matrix operations. Smaller
+ * simulations are solved on the calling thread.
+ */
+static constexpr int64_t LFVECTOR_GRAIN_SIZE = 2048;
 static float ZERO[3][3] = {{0, 0, 0}, {0, 0, 0}, {0, 0, 0}};
 
 #  if 0
@@ -173,15 +186,26 @@ DO_INLINE void submul_lfvectorS(float (*to)[3], float (*fLongVector)[3], float s
 /* dot product for big vector */
 DO_INLINE float dot_lfvector(float (*fLongVectorA)[3], float (*fLongVectorB)[3], uint verts)
 {
-  long i = 0;
-  float temp = 0.0;
-  /* XXX brecht, disabled this for now (first schedule line was already disabled),
-   * due to non-commutative nature of floating point ops this makes the sim give
-   * different results each time you run it!
-   * schedule(guided, 2) */
-  // #pragma omp parallel for reduction(+: temp) if (verts > CLOTH_OPENMP_LIMIT)
-  for (i = 0; i < long(verts); i++) {
-    temp += dot_v3v3(fLongVectorA[i], fLongVectorB[i]);
+  /* Floating point addition isn't associative, so a regular parallel reduction makes the
+   * simulation give different results each time it runs. Instead, chunks of a fixed size are
+   * summed in parallel and the chunk sums are added in order, which doesn't depend on the
+   * scheduling or the number of threads. */
+  const int64_t chunks_num = divide_ceil_ul(verts, LFVECTOR_GRAIN_SIZE);
+  Array<float, 64> chunk_sums(chunks_num);
+  blender::threading::parallel_for(IndexRange(chunks_num), 1, [&](const IndexRange chunks) {
+    for (const int64_t chunk : chunks) {
+      const IndexRange range = IndexRange(chunk * LFVECTOR_GRAIN_SIZE, LFVECTOR_GRAIN_SIZE)
+                                   .intersect(IndexRange(verts));
+      float temp = 0.0f;
+      for (const int64_t i : range) {
+        temp += dot_v3v3(fLongVectorA[i], fLongVectorB[i]);
+      }
+      chunk_sums[chunk] = temp;
+    }
+  });
+  float temp = 0.0f;
+  for (const float chunk_sum : chunk_sums) {
+    temp += chunk_sum;
   }
   return temp;
 }
@@ -191,21 +215,23 @@ DO_INLINE void add_lfvector_lfvector(float (*to)[3],
                                      float (*fLongVectorB)[3],
                                      uint verts)
 {
-  uint i = 0;
-
-  for (i = 0; i < verts; i++) {
-    add_v3_v3v3(to[i], fLongVectorA[i], fLongVectorB[i]);
-  }
+  blender::threading::parallel_for(
+      IndexRange(verts), LFVECTOR_GRAIN_SIZE, [&](const IndexRange range) {
+        for (const int64_t i : range) {
+          add_v3_v3v3(to[i], fLongVectorA[i], fLongVectorB[i]);
+        }
+      });
 }
 /* `A = B + C * float` -> for big vector. */
 DO_INLINE void add_lfvector_lfvectorS(
     float (*to)[3], float (*fLongVectorA)[3], float (*fLongVectorB)[3], float bS, uint verts)
 {
-  uint i = 0;
-
-  for (i = 0; i < verts; i++) {
-    VECADDS(to[i], fLongVectorA[i], fLongVectorB[i], bS);
-  }
+  blender::threading::parallel_for(
+      IndexRange(verts), LFVECTOR_GRAIN_SIZE, [&](const IndexRange range) {
+        for (const int64_t i : range) {
+          VECADDS(to[i], fLongVectorA[i], fLongVectorB[i], bS);
+        }
+      });
 }
 /* `A = B * float + C * float` -> for big vector */
 DO_INLINE void add_lfvectorS_lfvectorS(float (*to)[3],
@@ -215,11 +241,12 @@ DO_INLINE void add_lfvectorS_lfvectorS(float (*to)[3],
                                        float bS,
                                        uint verts)
 {
-  uint i = 0;
-
-  for (i = 0; i < verts; i++) {
-    VECADDSS(to[i], fLongVectorA[i], aS, fLongVectorB[i], bS);
-  }
+  blender::threading::parallel_for(
+      IndexRange(verts), LFVECTOR_GRAIN_SIZE, [&](const IndexRange range) {
+        for (const int64_t i : range) {
+          VECADDSS(to[i], fLongVectorA[i], aS, fLongVectorB[i], bS);
+        }
+      });
 }
 /* `A = B - C * float` -> for big vector. */
 DO_INLINE void sub_lfvector_lfvectorS(
@@ -236,11 +263,12 @@ DO_INLINE void sub_lfvector_lfvector(float (*to)[3],
                                      float (*fLongVectorB)[3],
                                      uint verts)
 {
-  uint i = 0;
-
-  for (i = 0; i < verts; i++) {
-    sub_v3_v3v3(to[i], fLongVectorA[i], fLongVectorB[i]);
-  }
+  blender::threading::parallel_for(
+      IndexRange(verts), LFVECTOR_GRAIN_SIZE, [&](const IndexRange range) {
+        for (const int64_t i : range) {
+          sub_v3_v3v3(to[i], fLongVectorA[i], fLongVectorB[i]);
+        }
+      });
 }
 ///////////////////////////
 // 3x3 matrix
@@ -613,6 +641,70 @@ DO_INLINE void mul_bfmatrix_lfvector(float (*to)[3], fmatrix3x3 *from, lfVector
   del_lfvector(temp);
 }
 
+/**
+ * The off-diagonal blocks of a sparse symmetric big matrix that contribute to each row of a
+ * product with it. This allows computing the product row by row in parallel, where
+ * #mul_bfmatrix_lfvector scatters the transposed lower triangle to other rows.
+ */
+struct bfmatrix_rows {
+  /** Offsets of the blocks of every row, of size vertex count + 1. */
+  Array<int> offsets;
+  /** Indices of the blocks, `-index - 1` for blocks that are multiplied transposed. */
+  Array<int> blocks;
+};
+
+/** The matrix layout only changes when springs are added, so this is built once per step. */
+static void build_bfmatrix_rows(const fmatrix3x3 *matrix, bfmatrix_rows &rows)
+{
+  const uint vcount = matrix[0].vcount;
+  const uint blocks_end = vcount + matrix[0].scount;
+
+  rows.offsets.reinitialize(vcount + 1);
+  rows.offsets.fill(0);
+  for (uint i = vcount; i < blocks_end; i++) {
+    rows.offsets[matrix[i].r]++;
+    rows.offsets[matrix[i].c]++;
+  }
+  const OffsetIndices<int> offsets = blender::offset_indices::accumulate_counts_to_offsets(
+      rows.offsets);
+
+  rows.blocks.reinitialize(offsets.total_size());
+  Array<int> row_sizes(vcount, 0);
+  for (uint i = vcount; i < blocks_end; i++) {
+    const uint r = matrix[i].r;
+    const uint c = matrix[i].c;
+    rows.blocks[offsets[r][row_sizes[r]++]] = int(i);
+    rows.blocks[offsets[c][row_sizes[c]++]] = -int(i) - 1;
+  }
+}
+
+/* SPARSE SYMMETRIC multiply big matrix with long vector, in parallel. */
+DO_INLINE void mul_bfmatrix_lfvector_rows(float (*to)[3],
+                                          const fmatrix3x3 *from,
+                                          const bfmatrix_rows &rows,
+                                          lfVector *fLongVector)
+{
+  const OffsetIndices<int> offsets = rows.offsets.as_span();
+  blender::threading::parallel_for(
+      IndexRange(from[0].vcount), LFVECTOR_GRAIN_SIZE, [&](const IndexRange range) {
+        for (const int64_t i : range) {
+          zero_v3(to[i]);
+          muladd_fmatrix_fvector(to[i], from[i].m, fLongVector[i]);
+          for (const int block : rows.blocks.as_span().slice(offsets[i])) {
+            if (block >= 0) {
+              muladd_fmatrix_fvector(to[i], from[block].m, fLongVector[from[block].c]);
+            }
+            else {
+              /* This block is in the lower triangle of the sparse matrix, so the multiplication
+               * occurs with the transposed sub-matrix. */
+              const fmatrix3x3 &transposed = from[-block - 1];
+              muladd_fmatrixT_fvector(to[i], transposed.m, fLongVector[transposed.r]);
+            }
+          }
+        }
+      });
+}
+
 /* SPARSE SYMMETRIC sub big matrix with big matrix. */
 /* A -= B * float + C * float --> for big matrix */
 /* VERIFIED */
@@ -742,11 +834,12 @@ BLI_INLINE void root_to_world_m3(Implicit_Data *data,
 
 DO_INLINE void filter(lfVector *V, fmatrix3x3 *S)
 {
-  uint i = 0;
-
-  for (i = 0; i < S[0].vcount; i++) {
-    mul_m3_v3(S[i].m, V[S[i].r]);
-  }
+  blender::threading::parallel_for(
+      IndexRange(S[0].vcount), LFVECTOR_GRAIN_SIZE, [&](const IndexRange range) {
+        for (const int64_t i : range) {
+          mul_m3_v3(S[i].m, V[S[i].r]);
+        }
+      });
 }
 
 /* this version of the CG algorithm does not work very well with partial constraints
@@ -821,6 +914,7 @@ static int cg_filtered(lfVector *ldV, fmatrix3x3 *lA, lfVector *lB, lfVector *z,
 
 static int cg_filtered(lfVector *ldV,
                        fmatrix3x3 *lA,
+                       const bfmatrix_rows &lA_rows,
                        lfVector *lB,
                        lfVector *z,
                        fmatrix3x3 *S,
@@ -848,7 +942,7 @@ static int cg_filtered(lfVector *ldV,
   delta_target = conjgrad_epsilon * conjgrad_epsilon * bnorm2;
 
   /* r = filter(B - A * dV) */
-  mul_bfmatrix_lfvector(AdV, lA, ldV);
+  mul_bfmatrix_lfvector_rows(AdV, lA, lA_rows, ldV);
   sub_lfvector_lfvector(r, lB, AdV, numverts);
   filter(r, S);
 
@@ -871,7 +965,7 @@ static int cg_filtered(lfVector *ldV,
 #  endif
 
   while (delta_new > delta_target && conjgrad_loopcount < conjgrad_looplimit) {
-    mul_bfmatrix_lfvector(q, lA, c);
+    mul_bfmatrix_lfvector_rows(q, lA, lA_rows, c);
     filter(q, S);
 
     alpha = delta_new / dot_lfvector(c, q, numverts);
@@ -1131,7 +1225,11 @@ bool SIM_mass_spring_solve_velocities(Implicit_Data *data, float dt, ImplicitSol
 
   subadd_bfmatrixS_bfmatrixS(data->A, data->dFdV, dt, data->dFdX, (dt * dt));
 
-  mul_bfmatrix_lfvector(dFdXmV, data->dFdX, data->V);
+  /* All matrices share the layout of the blocks. */
+  bfmatrix_rows rows;
+  build_bfmatrix_rows(data->A, rows);
+
+  mul_bfmatrix_lfvector_rows(dFdXmV, data->dFdX, rows, data->V);
 
   add_lfvectorS_lfvectorS(data->B, data->F, dt, dFdXmV, (dt * dt), numverts);
 
@@ -1140,7 +1238,7 @@ bool SIM_mass_spring_solve_velocities(Implicit_Data *data, float dt, ImplicitSol
 #  endif
 
   /* Conjugate gradient algorithm to solve Ax=b. */
-  cg_filtered(data->dV, data->A, data->B, data->z, data->S, result);
+  cg_filtered(data->dV, data->A, rows, data->B, data->z, data->S, result);
 
   // cg_filtered_pre(id->dV, id->A, id->B, id->z, id->S, id->P, id->Pinv, id->bigI);
 
@@ -55,6 +55,7 @@ struct wmEventHandler_Dropbox;
 struct wmEventHandler_Keymap;
 struct wmEventHandler_Op;
 struct wmEventHandler_UI;
+struct wmFrameStats;
 struct wmGenericUserData;
 struct wmGesture;
 struct wmJob;
@@ -144,6 +145,16 @@ void WM_exit(bContext *C, int exit_code) ATTR_NORETURN;
 
 void WM_main(bContext *C) ATTR_NORETURN;
 
+/**
+ * Start collecting statistics about the time spent in the parts of the main loop and the latency
+ * from input events to the frames showing their result, clearing the previously collected ones.
+ * \param show_overlay: Also draw the times of the last frame in the corner of every window.
+ */
+void WM_frame_stats_enable(bool show_overlay);
+/** Stop collecting frame statistics, the collected ones remain available. */
+void WM_frame_stats_disable();
+void WM_frame_stats_get(wmFrameStats *r_stats);
+
 /**
  * Show the splash screen as needed on startup.
  *
@@ -1608,6 +1619,7 @@ enum eWM_JobType {
   WM_JOB_TYPE_CALCULATE_SIMULATION_NODES,
   WM_JOB_TYPE_BAKE_GEOMETRY_NODES,
   WM_JOB_TYPE_UV_PACK,
+  WM_JOB_TYPE_FILE_SAVE,
   /* Add as needed, bake, seq proxy build
    * if having hard coded values is a problem. */
 };
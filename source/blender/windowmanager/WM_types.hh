@@ -936,6 +936,49 @@ struct wmTimer {
   bool sleep;
 };
 
+/** Time spent in one part of the main loop, see #wmFrameStats. */
+struct wmFrameStatsTime {
+  /** Number of frames that included this part. */
+  uint64_t count;
+  double total_time;
+  double max_time;
+  /** Time of the last frame, zero when the last frame didn't include this part. */
+  double last_time;
+};
+
+/**
+ * Statistics about the iterations of the main loop that drew at least one window, collected
+ * since #WM_frame_stats_enable. Times are in seconds.
+ */
+struct wmFrameStats {
+  double elapsed_time;
+  uint64_t frames;
+  /** Input events received from GHOST. */
+  uint64_t input_events;
+  /** Mouse moves that were merged with the following one before being handled. */
+  uint64_t coalesced_mouse_moves;
+
+  /** Receiving events from GHOST and adding them to the event queues of windows. */
+  wmFrameStatsTime events;
+  /** Running event handlers and operators. */
+  wmFrameStatsTime handlers;
+  /** Handling notifiers, without the depsgraph evaluation. */
+  wmFrameStatsTime notifiers;
+  /** Evaluating the depsgraphs of all windows. */
+  wmFrameStatsTime depsgraph;
+  /** Drawing windows, without swapping their buffers. */
+  wmFrameStatsTime draw;
+  /** Swapping the buffers of windows, which may wait for the vertical blank. */
+  wmFrameStatsTime swap;
+  /** The whole frame. */
+  wmFrameStatsTime frame;
+  /**
+   * Time from the time-stamp of the oldest input event handled in a frame until the buffers of
+   * the frame were swapped, only for frames that handled input events.
+   */
+  wmFrameStatsTime input_latency;
+};
+
 enum wmPopupSize {
   WM_POPUP_SIZE_SMALL = 0,
   WM_POPUP_SIZE_LARGE,
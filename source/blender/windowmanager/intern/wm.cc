@@ -45,6 +45,7 @@
 #include "wm.hh"
 #include "wm_draw.hh"
 #include "wm_event_system.hh"
+#include "wm_frame_stats.hh"
 #include "wm_window.hh"
 #ifdef WITH_XR_OPENXR
 #  include "wm_xr.hh"
@@ -629,17 +630,24 @@ void WM_main(bContext *C)
   wm_event_do_refresh_wm_and_depsgraph(C);
 
   while (true) {
+    wm_frame_stats_begin();
 
     /* Get events from ghost, handle window events, add to window queues. */
     wm_window_events_process(C);
+    wm_frame_stats_phase_end(wmFramePhase::Events);
 
     /* Per window, all events to the window, screen, area and region handlers. */
     wm_event_do_handlers(C);
+    wm_frame_stats_phase_end(wmFramePhase::Handlers);
 
     /* Events have left notes about changes, we handle and cache it. */
     wm_event_do_notifiers(C);
+    wm_frame_stats_phase_end(wmFramePhase::Notifiers);
 
     /* Execute cached changes draw. */
     wm_draw_update(C);
+    wm_frame_stats_phase_end(wmFramePhase::Draw);
+
+    wm_frame_stats_end();
   }
 }
@@ -23,6 +23,7 @@
 
 #include "BLI_math_matrix.h"
 #include "BLI_math_vector_types.hh"
+#include "BLI_time.h"
 #include "BLI_utildefines.h"
 
 #include "BKE_context.hh"
@@ -55,6 +56,7 @@
 #include "wm.hh"
 #include "wm_draw.hh"
 #include "wm_event_system.hh"
+#include "wm_frame_stats.hh"
 #include "wm_surface.hh"
 #include "wm_window.hh"
 
@@ -1155,6 +1157,8 @@ static void wm_draw_window_onscreen(bContext *C, wmWindow *win, int view)
     }
   }
 
+  wm_frame_stats_draw(win);
+
   GPU_debug_group_end();
 }
 
@@ -1577,7 +1581,14 @@ void wm_draw_update(bContext *C)
       wm_draw_window(C, win);
       wm_draw_update_clear_window(C, win);
 
-      wm_window_swap_buffers(win);
+      if (wm_frame_stats_is_enabled()) {
+        const double swap_start_time = BLI_time_now_seconds();
+        wm_window_swap_buffers(win);
+        wm_frame_stats_add_nested(wmFramePhase::Swap, swap_start_time, BLI_time_now_seconds());
+      }
+      else {
+        wm_window_swap_buffers(win);
+      }
     }
   }
 
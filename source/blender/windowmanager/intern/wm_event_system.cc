@@ -31,6 +31,7 @@
 
 #include "BLI_blenlib.h"
 #include "BLI_ghash.h"
+#include "BLI_time.h"
 #include "BLI_timer.h"
 #include "BLI_utildefines.h"
 
@@ -72,6 +73,7 @@
 
 #include "wm.hh"
 #include "wm_event_system.hh"
+#include "wm_frame_stats.hh"
 #include "wm_event_types.hh"
 #include "wm_surface.hh"
 #include "wm_window.hh"
@@ -485,6 +487,8 @@ void wm_event_do_depsgraph(bContext *C, bool is_after_open_file)
 
     ED_view3d_screen_datamask(scene, view_layer, screen, &win_combine_v3d_datamask);
   }
+  const bool use_frame_stats = wm_frame_stats_is_enabled();
+  const double start_time = use_frame_stats ? BLI_time_now_seconds() : 0.0;
   /* Update all the dependency graphs of visible view layers. */
   LISTBASE_FOREACH (wmWindow *, win, &wm->windows) {
     Scene *scene = WM_window_get_active_scene(win);
@@ -508,6 +512,10 @@ void wm_event_do_depsgraph(bContext *C, bool is_after_open_file)
   }
 
   wm_surfaces_do_depsgraph(C);
+
+  if (use_frame_stats) {
+    wm_frame_stats_add_nested(wmFramePhase::Depsgraph, start_time, BLI_time_now_seconds());
+  }
 }
 
 void wm_event_do_refresh_wm_and_depsgraph(bContext *C)
@@ -5522,6 +5530,7 @@ static wmEvent *wm_event_add_mousemove(wmWindow *win, const wmEvent *event)
   if (event_last && event_last->type == MOUSEMOVE) {
     event_last->type = INBETWEEN_MOUSEMOVE;
     event_last->flag = (eWM_EventFlag)0;
+    wm_frame_stats_add_coalesced_mouse_move();
   }
 
   wmEvent *event_new = wm_event_add(win, event);
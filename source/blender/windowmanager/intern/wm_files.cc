@@ -72,6 +72,7 @@
 #include "BKE_context.hh"
 #include "BKE_global.hh"
 #include "BKE_idprop.hh"
+#include "BKE_idtype.hh"
 #include "BKE_lib_id.hh"
 #include "BKE_lib_override.hh"
 #include "BKE_lib_remap.hh"
@@ -911,6 +912,33 @@ static void wm_read_callback_post_wrapper(bContext *C, const char *filepath, con
 /** \name Read Main Blend-File API
  * \{ */
 
+/**
+ * Print where the time went when reading the file, with `--debug-io`.
+ * One `key: value` item per line, so it's easy to parse by scripts comparing loading times.
+ */
+static void file_read_reports_print_profile(const BlendFileReadReport *bf_reports)
+{
+  printf("Blend file read profile:\n");
+  printf("  whole: %.4fs\n", bf_reports->duration.whole);
+  printf("  read_data: %.4fs\n", bf_reports->duration.read_data);
+  printf("  dna_conversion: %.4fs\n", bf_reports->duration.dna_conversion);
+  printf("  versioning: %.4fs\n", bf_reports->duration.versioning);
+  printf("  libraries: %.4fs\n", bf_reports->duration.libraries);
+  printf("  lib_link: %.4fs\n", bf_reports->duration.lib_link);
+  printf("  lib_overrides: %.4fs\n", bf_reports->duration.lib_overrides);
+  printf("  lib_overrides_resync: %.4fs\n", bf_reports->duration.lib_overrides_resync);
+  for (int i = 0; i < INDEX_ID_MAX; i++) {
+    const auto &id_type = bf_reports->id_types[i];
+    if (id_type.count == 0) {
+      continue;
+    }
+    printf("  id_type %s: %d in %.4fs\n",
+           BKE_idtype_idcode_to_name(BKE_idtype_index_to_idcode(i)),
+           id_type.count,
+           id_type.duration);
+  }
+}
+
 static void file_read_reports_finalize(BlendFileReadReport *bf_reports)
 {
   double duration_whole_minutes, duration_whole_seconds;
@@ -955,9 +983,16 @@ static void file_read_reports_finalize(BlendFileReadReport *bf_reports)
       &LOG, 0, "Blender file read in %.0fm%.2fs", duration_whole_minutes, duration_whole_seconds);
   CLOG_INFO(&LOG,
             0,
-            " * Loading libraries: %.0fm%.2fs",
+            " * Reading data-blocks: %.2fs (including DNA conversion: %.2fs)",
+            bf_reports->duration.read_data,
+            bf_reports->duration.dna_conversion);
+  CLOG_INFO(&LOG, 0, " * Versioning: %.2fs", bf_reports->duration.versioning);
+  CLOG_INFO(&LOG,
+            0,
+            " * Loading libraries: %.0fm%.2fs (including linking: %.2fs)",
             duration_libraries_minutes,
-            duration_libraries_seconds);
+            duration_libraries_seconds,
+            bf_reports->duration.lib_link);
   CLOG_INFO(&LOG,
             0,
             " * Applying overrides: %.0fm%.2fs",
@@ -973,6 +1008,10 @@ static void file_read_reports_finalize(BlendFileReadReport *bf_reports)
             duration_lib_override_recursive_resync_minutes,
             duration_lib_override_recursive_resync_seconds);
 
+  if (G.debug & G_DEBUG_IO) {
+    file_read_reports_print_profile(bf_reports);
+  }
+
   if (bf_reports->resynced_lib_overrides_libraries_count != 0) {
     for (LinkNode *node_lib = bf_reports->resynced_lib_overrides_libraries; node_lib != nullptr;
          node_lib = node_lib->next)
@@ -1072,6 +1111,9 @@ bool WM_file_read(bContext *C, const char *filepath, ReportList *reports)
      * risk, because the excluded path list is also loaded. Further it's just confusing
      * if a user loads a file and various preferences change. */
     params.skip_flags = BLO_READ_SKIP_USERDEF;
+    if (G.background && (G.f & G_FLAG_READ_ACTIVE_SCENE_ONLY)) {
+      params.skip_flags |= BLO_READ_SKIP_UNREACHABLE_IDS;
+    }
 
     BlendFileReadReport bf_reports{};
     bf_reports.reports = reports;
@@ -2093,6 +2135,13 @@ static bool wm_file_write_check_with_report_on_failure(Main *bmain,
     return false;
   }
 
+  if (bmain->is_partially_read) {
+    BKE_report(reports,
+               RPT_ERROR,
+               "Cannot save a file that was only partially loaded (--load-active-scene-only)");
+    return false;
+  }
+
   if (bmain->is_asset_edit_file &&
       blender::StringRef(filepath).endswith(BLENDER_ASSET_FILE_SUFFIX))
   {
@@ -2113,6 +2162,92 @@ static bool wm_file_write_check_with_report_on_failure(Main *bmain,
 /**
  * \see #wm_homefile_write_exec wraps #BLO_write_file in a similar way.
  */
+/* -------------------------------------------------------------------- */
+/** \name Background File Write
+ *
+ * The file data is gathered on the main thread (see #BLO_write_file_snapshot),
+ * compressing and writing it to disk is done in a job.
+ * \{ */
+
+struct FileWriteJob {
+  BlendFileWriteSnapshot *snapshot;
+  char filepath[FILE_MAX];
+  /** Created once the file is written, owned by the job. */
+  ImBuf *ibuf_thumb;
+  bool success;
+};
+
+static void wm_file_write_job_startjob(void *customdata, wmJobWorkerStatus *worker_status)
+{
+  FileWriteJob *job = static_cast<FileWriteJob *>(customdata);
+  /* Stopping is ignored on purpose: once the versioned backups have been rotated, the file must
+   * be fully written. Quitting and loading files wait for the job to finish. */
+  job->success = BLO_write_file_snapshot_write(
+      job->snapshot, worker_status->reports, &worker_status->progress);
+
+  if (job->success) {
+    /* The thumbnail can't be written before the blend is. */
+    if (job->ibuf_thumb) {
+      IMB_thumb_delete(job->filepath, THB_FAIL); /* Without this a failed thumb overrides. */
+      job->ibuf_thumb = IMB_thumb_create(
+          job->filepath, THB_LARGE, THB_SOURCE_BLEND, job->ibuf_thumb);
+    }
+    BKE_reportf(
+        worker_status->reports, RPT_INFO, "Saved \"%s\"", BLI_path_basename(job->filepath));
+  }
+  worker_status->do_update = true;
+}
+
+static void wm_file_write_job_endjob(void *customdata)
+{
+  FileWriteJob *job = static_cast<FileWriteJob *>(customdata);
+  Main *bmain = G_MAIN;
+  wmWindowManager *wm = static_cast<wmWindowManager *>(bmain->wm.first);
+
+  if (!job->success && STREQ(bmain->filepath, job->filepath)) {
+    /* The changes are not on disk. */
+    wm->file_saved = 0;
+  }
+
+  BKE_callback_exec_string(
+      bmain, job->success ? BKE_CB_EVT_SAVE_POST : BKE_CB_EVT_SAVE_POST_FAIL, job->filepath);
+}
+
+static void wm_file_write_job_free(void *customdata)
+{
+  FileWriteJob *job = static_cast<FileWriteJob *>(customdata);
+  BLO_write_file_snapshot_free(job->snapshot);
+  if (job->ibuf_thumb) {
+    IMB_freeImBuf(job->ibuf_thumb);
+  }
+  MEM_freeN(job);
+}
+
+/**
+ * Write \a snapshot to disk in a job, taking ownership of it and of \a ibuf_thumb.
+ */
+static void wm_file_write_job_start(wmWindowManager *wm,
+                                    wmWindow *win,
+                                    BlendFileWriteSnapshot *snapshot,
+                                    const char *filepath,
+                                    ImBuf *ibuf_thumb)
+{
+  FileWriteJob *job = MEM_cnew<FileWriteJob>(__func__);
+  job->snapshot = snapshot;
+  STRNCPY(job->filepath, filepath);
+  job->ibuf_thumb = ibuf_thumb;
+
+  wmJob *wm_job = WM_jobs_get(
+      wm, win, wm, "Saving File...", WM_JOB_PROGRESS, WM_JOB_TYPE_FILE_SAVE);
+  WM_jobs_customdata_set(wm_job, job, wm_file_write_job_free);
+  WM_jobs_timer(wm_job, 0.1, 0, 0);
+  WM_jobs_callbacks(
+      wm_job, wm_file_write_job_startjob, nullptr, nullptr, wm_file_write_job_endjob);
+  WM_jobs_start(wm, wm_job);
+}
+
+/** \} */
+
 static bool wm_file_write(bContext *C,
                           const char *filepath,
                           int fileflags,
@@ -2132,6 +2267,12 @@ static bool wm_file_write(bContext *C,
     return false;
   }
 
+  wmWindowManager *wm = CTX_wm_manager(C);
+  if (wm) {
+    /* Finish a previous background save first, it may write to the same file. */
+    WM_jobs_kill_type(wm, wm, WM_JOB_TYPE_FILE_SAVE);
+  }
+
   /* Call pre-save callbacks before writing preview,
    * that way you can generate custom file thumbnail. */
 
@@ -2219,7 +2360,21 @@ static bool wm_file_write(bContext *C,
   blend_write_params.use_save_as_copy = use_save_as_copy;
   blend_write_params.thumb = thumb;
 
-  const bool success = BLO_write_file(bmain, filepath, fileflags, &blend_write_params, reports);
+  const bool use_background_write = USER_EXPERIMENTAL_TEST(&U, use_async_save) &&
+                                    !G.background && BLI_thread_is_main() && wm != nullptr;
+  bool success;
+  if (use_background_write) {
+    BlendFileWriteSnapshot *snapshot = BLO_write_file_snapshot(
+        bmain, filepath, fileflags, &blend_write_params, reports);
+    success = snapshot != nullptr;
+    if (success) {
+      wm_file_write_job_start(wm, CTX_wm_window(C), snapshot, filepath, ibuf_thumb);
+      ibuf_thumb = nullptr;
+    }
+  }
+  else {
+    success = BLO_write_file(bmain, filepath, fileflags, &blend_write_params, reports);
+  }
 
   if (success) {
     const bool do_history_file_update = (G.background == false) &&
@@ -2242,12 +2397,18 @@ static bool wm_file_write(bContext *C,
       ibuf_thumb = IMB_thumb_create(filepath, THB_LARGE, THB_SOURCE_BLEND, ibuf_thumb);
     }
 
-    /* Without this there is no feedback the file was saved. */
-    BKE_reportf(reports, RPT_INFO, "Saved \"%s\"", BLI_path_basename(filepath));
+    /* Without this there is no feedback the file was saved.
+     * For background writes this is reported once the job is done. */
+    if (!use_background_write) {
+      BKE_reportf(reports, RPT_INFO, "Saved \"%s\"", BLI_path_basename(filepath));
+    }
   }
 
-  BKE_callback_exec_string(
-      bmain, success ? BKE_CB_EVT_SAVE_POST : BKE_CB_EVT_SAVE_POST_FAIL, filepath);
+  /* Background writes run the post-save callbacks once the job is done. */
+  if (!(use_background_write && success)) {
+    BKE_callback_exec_string(
+        bmain, success ? BKE_CB_EVT_SAVE_POST : BKE_CB_EVT_SAVE_POST_FAIL, filepath);
+  }
 
   if (ibuf_thumb) {
     IMB_freeImBuf(ibuf_thumb);
@@ -0,0 +1,264 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup wm
+ *
+ * Statistics about the iterations of the main loop. Everything happens on the main thread, so no
+ * locking is needed.
+ */
+
+#include <algorithm>
+#include <string>
+
+#include <fmt/format.h>
+
+#include "BLI_assert.h"
+#include "BLI_math_color.h"
+#include "BLI_time.h"
+
+#include "DNA_userdef_types.h"
+
+#include "UI_interface.hh"
+#include "UI_resources.hh"
+
+#include "WM_api.hh"
+#include "WM_types.hh"
+#include "wm_frame_stats.hh"
+
+static constexpr int FRAME_PHASES_NUM = int(wmFramePhase::Swap) + 1;
+
+struct FrameStatsState {
+  wmFrameStats stats = {};
+  bool enabled = false;
+  bool show_overlay = false;
+  double start_time = 0.0;
+  double stop_time = 0.0;
+
+  /** The iteration of the main loop that is currently timed, see #wm_frame_stats_begin. */
+  bool frame_started = false;
+  double frame_start_time = 0.0;
+  double phase_start_time = 0.0;
+  /** Time of the nested phases that ran during the current phase. */
+  double nested_time = 0.0;
+  bool frame_swapped = false;
+  /** Times of the phases of the current frame, indexed by #wmFramePhase. */
+  double phase_times[FRAME_PHASES_NUM] = {};
+  bool phase_used[FRAME_PHASES_NUM] = {};
+
+  /**
+   * Time-stamp of the oldest input event that wasn't shown in a frame yet, in the time of
+   * #BLI_time_now_seconds. Negative when there is none.
+   */
+  double pending_input_time = -1.0;
+};
+
+static FrameStatsState &frame_stats_state()
+{
+  static FrameStatsState state;
+  return state;
+}
+
+static wmFrameStatsTime &frame_stats_phase_time(wmFrameStats &stats, const wmFramePhase phase)
+{
+  switch (phase) {
+    case wmFramePhase::Events:
+      return stats.events;
+    case wmFramePhase::Handlers:
+      return stats.handlers;
+    case wmFramePhase::Notifiers:
+      return stats.notifiers;
+    case wmFramePhase::Depsgraph:
+      return stats.depsgraph;
+    case wmFramePhase::Draw:
+      return stats.draw;
+    case wmFramePhase::Swap:
+      return stats.swap;
+  }
+  BLI_assert_unreachable();
+  return stats.frame;
+}
+
+static void frame_stats_time_add(wmFrameStatsTime &time, const double value)
+{
+  time.count++;
+  time.total_time += value;
+  time.max_time = std::max(time.max_time, value);
+  time.last_time = value;
+}
+
+void WM_frame_stats_enable(const bool show_overlay)
+{
+  FrameStatsState &state = frame_stats_state();
+  state = FrameStatsState();
+  state.enabled = true;
+  state.show_overlay = show_overlay;
+  state.start_time = BLI_time_now_seconds();
+}
+
+void WM_frame_stats_disable()
+{
+  FrameStatsState &state = frame_stats_state();
+  if (state.enabled) {
+    state.enabled = false;
+    state.frame_started = false;
+    state.stop_time = BLI_time_now_seconds();
+  }
+}
+
+void WM_frame_stats_get(wmFrameStats *r_stats)
+{
+  const FrameStatsState &state = frame_stats_state();
+  *r_stats = state.stats;
+  const double end_time = state.enabled ? BLI_time_now_seconds() : state.stop_time;
+  r_stats->elapsed_time = end_time - state.start_time;
+}
+
+bool wm_frame_stats_is_enabled()
+{
+  return frame_stats_state().enabled;
+}
+
+void wm_frame_stats_begin()
+{
+  FrameStatsState &state = frame_stats_state();
+  if (!state.enabled) {
+    return;
+  }
+  state.frame_started = true;
+  state.frame_start_time = BLI_time_now_seconds();
+  state.phase_start_time = state.frame_start_time;
+  state.nested_time = 0.0;
+  state.frame_swapped = false;
+  std::fill_n(state.phase_times, FRAME_PHASES_NUM, 0.0);
+  std::fill_n(state.phase_used, FRAME_PHASES_NUM, false);
+}
+
+void wm_frame_stats_phase_end(const wmFramePhase phase)
+{
+  FrameStatsState &state = frame_stats_state();
+  if (!state.frame_started) {
+    return;
+  }
+  const double time = BLI_time_now_seconds();
+  state.phase_times[int(phase)] += std::max(time - state.phase_start_time - state.nested_time,
+                                            0.0);
+  state.phase_used[int(phase)] = true;
+  state.phase_start_time = time;
+  state.nested_time = 0.0;
+}
+
+void wm_frame_stats_add_nested(const wmFramePhase phase, const double start, const double end)
+{
+  FrameStatsState &state = frame_stats_state();
+  if (!state.frame_started) {
+    return;
+  }
+  state.phase_times[int(phase)] += end - start;
+  state.phase_used[int(phase)] = true;
+  state.nested_time += end - start;
+  if (phase == wmFramePhase::Swap) {
+    state.frame_swapped = true;
+  }
+}
+
+void wm_frame_stats_end()
+{
+  FrameStatsState &state = frame_stats_state();
+  if (!state.frame_started) {
+    return;
+  }
+  state.frame_started = false;
+  if (!state.frame_swapped) {
+    /* Iterations that don't draw mostly wait for events, their time isn't interesting. */
+    return;
+  }
+
+  const double time = BLI_time_now_seconds();
+  wmFrameStats &stats = state.stats;
+  stats.frames++;
+  for (int i = 0; i < FRAME_PHASES_NUM; i++) {
+    wmFrameStatsTime &phase_time = frame_stats_phase_time(stats, wmFramePhase(i));
+    if (state.phase_used[i]) {
+      frame_stats_time_add(phase_time, state.phase_times[i]);
+    }
+    else {
+      phase_time.last_time = 0.0;
+    }
+  }
+  frame_stats_time_add(stats.frame, time - state.frame_start_time);
+
+  if (state.pending_input_time >= 0.0) {
+    frame_stats_time_add(stats.input_latency, time - state.pending_input_time);
+    state.pending_input_time = -1.0;
+  }
+  else {
+    stats.input_latency.last_time = 0.0;
+  }
+}
+
+void wm_frame_stats_add_input_event(const double queue_time)
+{
+  FrameStatsState &state = frame_stats_state();
+  if (!state.enabled) {
+    return;
+  }
+  state.stats.input_events++;
+  const double input_time = BLI_time_now_seconds() - std::max(queue_time, 0.0);
+  if (state.pending_input_time < 0.0 || input_time < state.pending_input_time) {
+    state.pending_input_time = input_time;
+  }
+}
+
+void wm_frame_stats_add_coalesced_mouse_move()
+{
+  FrameStatsState &state = frame_stats_state();
+  if (state.enabled) {
+    state.stats.coalesced_mouse_moves++;
+  }
+}
+
+void wm_frame_stats_draw(wmWindow *win)
+{
+  const FrameStatsState &state = frame_stats_state();
+  if (!(state.enabled && state.show_overlay) || state.stats.frames == 0) {
+    return;
+  }
+  const wmFrameStats &stats = state.stats;
+  const auto ms = [](const double time) { return time * 1000.0; };
+
+  const std::string frame_str = fmt::format(
+      "Frame {:.1f} ms | Events {:.1f} | Handlers {:.1f} | Notifiers {:.1f} | Depsgraph {:.1f} | "
+      "Draw {:.1f} | Swap {:.1f}",
+      ms(stats.frame.last_time),
+      ms(stats.events.last_time),
+      ms(stats.handlers.last_time),
+      ms(stats.notifiers.last_time),
+      ms(stats.depsgraph.last_time),
+      ms(stats.draw.last_time),
+      ms(stats.swap.last_time));
+  const double latency_average = stats.input_latency.count ?
+                                     stats.input_latency.total_time / stats.input_latency.count :
+                                     0.0;
+  const std::string latency_str = fmt::format(
+      "Input latency {:.1f} ms (average {:.1f}, max {:.1f}) | {} events, {} mouse moves merged",
+      ms(stats.input_latency.last_time),
+      ms(latency_average),
+      ms(stats.input_latency.max_time),
+      stats.input_events,
+      stats.coalesced_mouse_moves);
+
+  /* Use the theme settings from tooltips, like other text drawn over the whole window. */
+  const uiFontStyle *fstyle = UI_FSTYLE_WIDGET;
+  const bTheme *btheme = UI_GetTheme();
+  const uiWidgetColors *wcol = &btheme->tui.wcol_tooltip;
+  float col_fg[4], col_bg[4];
+  rgba_uchar_to_float(col_fg, wcol->text);
+  rgba_uchar_to_float(col_bg, wcol->inner);
+
+  const float x = 0.5f * UI_UNIT_X;
+  const float y = float(WM_window_native_pixel_y(win)) - 1.5f * UI_UNIT_Y;
+  UI_fontstyle_draw_simple_backdrop(fstyle, x, y, frame_str, col_fg, col_bg);
+  UI_fontstyle_draw_simple_backdrop(fstyle, x, y - UI_UNIT_Y, latency_str, col_fg, col_bg);
+}
@@ -248,6 +248,8 @@ void WM_init(bContext *C, int argc, const char **argv)
 
   BLI_assert((G.fileflags & G_FILE_NO_UI) == 0);
 
+  BKE_blender_startup_phase_end("Window-manager types & editors");
+
   /**
    * NOTE(@ideasman42): Startup file and order of initialization.
    *
@@ -278,6 +280,8 @@ void WM_init(bContext *C, int argc, const char **argv)
 
   wm_homefile_read_ex(C, &read_homefile_params, nullptr, &params_file_read_post);
 
+  BKE_blender_startup_phase_end("Startup file & preferences");
+
   /* NOTE: leave `G_MAIN->filepath` set to an empty string since this
    * matches behavior after loading a new file. */
   BLI_assert(G_MAIN->filepath[0] == '\0');
@@ -305,6 +309,8 @@ void WM_init(bContext *C, int argc, const char **argv)
     UI_init();
     GPU_context_end_frame(GPU_context_active_get());
     GPU_render_end();
+
+    BKE_blender_startup_phase_end("GPU & interface");
   }
 
   blender::bke::subdiv::init();
@@ -313,7 +319,9 @@ void WM_init(bContext *C, int argc, const char **argv)
 
 #ifdef WITH_PYTHON
   BPY_python_start(C, argc, argv);
+  BKE_blender_startup_phase_end("Python & scripts");
   BPY_python_reset(C);
+  BKE_blender_startup_phase_end("Python text blocks");
 #else
   UNUSED_VARS(argc, argv);
 #endif
@@ -344,15 +352,18 @@ void WM_init(bContext *C, int argc, const char **argv)
   WM_keyconfig_update_postpone_begin();
 
   WM_keyconfig_init(C);
+  BKE_blender_startup_phase_end("History & key-maps");
 
   /* Load add-ons after key-maps have been initialized (but before the blend file has been read),
    * important to guarantee default key-maps have been declared & before post-read handlers run. */
   wm_init_scripts_extensions_once(C);
+  BKE_blender_startup_phase_end("Add-ons & extensions");
 
   WM_keyconfig_update_postpone_end();
   WM_keyconfig_update(static_cast<wmWindowManager *>(G_MAIN->wm.first));
 
   wm_homefile_read_post(C, params_file_read_post);
+  BKE_blender_startup_phase_end("Key-map update & startup file post-read");
 }
 
 static bool wm_init_splash_show_on_startup_check()
@@ -607,6 +618,7 @@ void WM_exit_ex(bContext *C, const bool do_python_exit, const bool do_user_exit_
    * the modifiers were garbage collected. */
   if (gpu_is_init) {
     blender::draw::DRW_subdiv_free();
+    blender::draw::DRW_mesh_extract_gpu_free();
   }
 
   ANIM_fcurves_copybuf_free();
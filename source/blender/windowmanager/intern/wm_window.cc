@@ -54,6 +54,7 @@
 #include "wm_draw.hh"
 #include "wm_event_system.hh"
 #include "wm_files.hh"
+#include "wm_frame_stats.hh"
 #include "wm_platform_support.hh"
 #include "wm_window.hh"
 #include "wm_window_private.hh"
@@ -1444,6 +1445,21 @@ static bool ghost_event_proc(GHOST_EventHandle ghost_event, GHOST_TUserDataPtr C
 
   wmWindow *win = static_cast<wmWindow *>(GHOST_GetWindowUserData(ghostwin));
 
+  if (wm_frame_stats_is_enabled() && ELEM(type,
+                                          GHOST_kEventCursorMove,
+                                          GHOST_kEventButtonDown,
+                                          GHOST_kEventButtonUp,
+                                          GHOST_kEventWheel,
+                                          GHOST_kEventTrackpad,
+                                          GHOST_kEventKeyDown,
+                                          GHOST_kEventKeyUp))
+  {
+    /* Time-stamps use the same clock as #GHOST_GetMilliSeconds. */
+    const uint64_t now_ms = GHOST_GetMilliSeconds(g_system);
+    wm_frame_stats_add_input_event(
+        now_ms > event_time_ms ? double(now_ms - event_time_ms) / 1000.0 : 0.0);
+  }
+
   switch (type) {
     case GHOST_kEventWindowDeactivate: {
       wm_window_update_eventstate_modifiers_clear(wm, win, event_time_ms);
@@ -0,0 +1,54 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup wm
+ *
+ * \name WM-Frame-Stats
+ *
+ * Optional timing of the parts of the main loop and of the latency from input events to the
+ * frame that shows their result, see #WM_frame_stats_enable.
+ */
+
+#pragma once
+
+struct wmWindow;
+
+/** Parts of an iteration of the main loop, see #wmFrameStats. */
+enum class wmFramePhase {
+  Events,
+  Handlers,
+  Notifiers,
+  Depsgraph,
+  Draw,
+  Swap,
+};
+
+bool wm_frame_stats_is_enabled();
+
+/** Start timing an iteration of the main loop. */
+void wm_frame_stats_begin();
+/** End a phase of the main loop, which started where the previous phase ended. */
+void wm_frame_stats_phase_end(wmFramePhase phase);
+/**
+ * Add a phase that ran between the given times, from #BLI_time_now_seconds, as part of the
+ * current phase of the main loop. Its time isn't counted for the current phase.
+ */
+void wm_frame_stats_add_nested(wmFramePhase phase, double start, double end);
+/**
+ * End the iteration of the main loop. It's only added to the statistics when a window was drawn,
+ * otherwise its input events are counted for the next frame that is drawn.
+ */
+void wm_frame_stats_end();
+
+/**
+ * Add an input event that was received from GHOST, after waiting for the given time (in
+ * seconds) since its time-stamp.
+ */
+void wm_frame_stats_add_input_event(double queue_time);
+/** Count a mouse move that is merged with the following one, see #INBETWEEN_MOUSEMOVE. */
+void wm_frame_stats_add_coalesced_mouse_move();
+
+/** Draw the times of the last frame in the corner of the window, when enabled. */
+void wm_frame_stats_draw(wmWindow *win);
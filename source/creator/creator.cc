@@ -287,6 +287,8 @@ int main(int argc,
   int argv_num;
 #endif
 
+  BKE_blender_startup_timing_begin();
+
   /* Ensure we free data on early-exit. */
   CreatorAtExitData app_init_data = {nullptr};
   BKE_blender_atexit_register(callback_main_atexit, &app_init_data);
@@ -517,6 +519,8 @@ int main(int argc,
 
   BKE_materials_init();
 
+  BKE_blender_startup_phase_end("Arguments & sub-systems");
+
 #ifndef WITH_PYTHON_MODULE
   if (G.background == 0) {
     BLI_args_parse(ba, ARG_PASS_SETTINGS_GUI, nullptr, nullptr);
@@ -542,6 +546,7 @@ int main(int argc,
 #ifndef WITH_PYTHON_MODULE
   /* Handles #ARG_PASS_FINAL. */
   BLI_args_parse(ba, ARG_PASS_FINAL, main_args_handle_load_file, C);
+  BKE_blender_startup_phase_end("Command line arguments & files");
 #endif
 
   /* Explicitly free data allocated for argument parsing:
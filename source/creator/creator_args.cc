@@ -35,6 +35,7 @@
 #  endif
 
 #  include "BKE_appdir.hh"
+#  include "BKE_blender.hh"
 #  include "BKE_blender_cli_command.hh"
 #  include "BKE_blender_version.h"
 #  include "BKE_blendfile.hh"
@@ -70,6 +71,7 @@
 #  endif
 
 #  include "DEG_depsgraph.hh"
+#  include "DEG_depsgraph_debug.hh"
 
 #  include "WM_types.hh"
 
@@ -748,8 +750,10 @@ static void print_help(bArgs *ba, bool all)
   BLI_args_print_arg_doc(ba, "--debug-depsgraph-time");
   BLI_args_print_arg_doc(ba, "--debug-depsgraph-pretty");
   BLI_args_print_arg_doc(ba, "--debug-depsgraph-uid");
+  BLI_args_print_arg_doc(ba, "--debug-depsgraph-trace");
   BLI_args_print_arg_doc(ba, "--debug-ghost");
   BLI_args_print_arg_doc(ba, "--debug-wintab");
+  BLI_args_print_arg_doc(ba, "--debug-startup");
   BLI_args_print_arg_doc(ba, "--debug-gpu");
   BLI_args_print_arg_doc(ba, "--debug-gpu-force-workarounds");
   BLI_args_print_arg_doc(ba, "--debug-gpu-compile-shaders");
@@ -789,6 +793,7 @@ static void print_help(bArgs *ba, bool all)
   BLI_args_print_arg_doc(ba, "--open-last");
   BLI_args_print_arg_doc(ba, "--app-template");
   BLI_args_print_arg_doc(ba, "--factory-startup");
+  BLI_args_print_arg_doc(ba, "--load-active-scene-only");
   BLI_args_print_arg_doc(ba, "--enable-event-simulate");
   PRINT("\n");
   BLI_args_print_arg_doc(ba, "--env-system-datafiles");
@@ -1008,6 +1013,37 @@ static void clog_abort_on_error_callback(void *fp)
   abort();
 }
 
+static char debug_depsgraph_trace_filepath[FILE_MAX];
+
+static void debug_depsgraph_trace_atexit(void * /*user_data*/)
+{
+  if (!DEG_debug_trace_end(debug_depsgraph_trace_filepath)) {
+    fprintf(stderr,
+            "Error: could not write depsgraph trace to '%s'\n",
+            debug_depsgraph_trace_filepath);
+  }
+}
+
+static const char arg_handle_debug_depsgraph_trace_set_doc[] =
+    "<filepath>\n"
+    "\tRecord the evaluation timeline of dependency graphs and write it on exit,\n"
+    "\tas JSON that can be opened in 'chrome://tracing' or Perfetto.";
+static int arg_handle_debug_depsgraph_trace_set(int argc, const char **argv, void * /*data*/)
+{
+  const char *arg_id = "--debug-depsgraph-trace";
+  if (argc > 1) {
+    if (!DEG_debug_trace_is_recording()) {
+      BKE_blender_atexit_register(debug_depsgraph_trace_atexit, nullptr);
+    }
+    STRNCPY(debug_depsgraph_trace_filepath, argv[1]);
+    BLI_path_abs_from_cwd(debug_depsgraph_trace_filepath, sizeof(debug_depsgraph_trace_filepath));
+    DEG_debug_trace_begin();
+    return 1;
+  }
+  fprintf(stderr, "\nError: '%s' no args given.\n", arg_id);
+  return 0;
+}
+
 static const char arg_handle_debug_exit_on_error_doc[] =
     "\n\t"
     "Immediately exit when internal errors are detected.";
@@ -1276,6 +1312,9 @@ static const char arg_handle_debug_mode_generic_set_doc_ghost[] =
 static const char arg_handle_debug_mode_generic_set_doc_wintab[] =
     "\n\t"
     "Enable debug messages for Wintab.";
+static const char arg_handle_debug_mode_generic_set_doc_startup[] =
+    "\n\t"
+    "Print the time spent in each phase of startup and in loading each add-on.";
 static const char arg_handle_debug_mode_generic_set_doc_xr[] =
     "\n\t"
     "Enable debug messages for virtual reality contexts.\n"
@@ -1583,6 +1622,18 @@ static int arg_handle_factory_startup_set(int /*argc*/, const char ** /*argv*/,
   return 0;
 }
 
+static const char arg_handle_load_active_scene_only_set_doc[] =
+    "\n\t"
+    "In background mode, only load the data used by the active scene of blend-files opened after\n"
+    "\tthis argument, skipping other scenes and unused data-blocks. Such files can't be saved.";
+static int arg_handle_load_active_scene_only_set(int /*argc*/,
+                                                 const char ** /*argv*/,
+                                                 void * /*data*/)
+{
+  G.f |= G_FLAG_READ_ACTIVE_SCENE_ONLY;
+  return 0;
+}
+
 static const char arg_handle_enable_event_simulate_doc[] =
     "\n\t"
     "Enable event simulation testing feature 'bpy.types.Window.event_simulate'.";
@@ -2726,6 +2777,11 @@ void main_args_setup(bContext *C, bArgs *ba, bool all)
                "--debug-wintab",
                CB_EX(arg_handle_debug_mode_generic_set, wintab),
                (void *)G_DEBUG_WINTAB);
+  BLI_args_add(ba,
+               nullptr,
+               "--debug-startup",
+               CB_EX(arg_handle_debug_mode_generic_set, startup),
+               (void *)G_DEBUG_STARTUP);
   BLI_args_add(ba, nullptr, "--debug-all", CB(arg_handle_debug_mode_all), nullptr);
 
   BLI_args_add(ba, nullptr, "--debug-io", CB(arg_handle_debug_mode_io), nullptr);
@@ -2803,6 +2859,8 @@ void main_args_setup(bContext *C, bArgs *ba, bool all)
                "--debug-depsgraph-uid",
                CB_EX(arg_handle_debug_mode_generic_set, depsgraph_uid),
                (void *)G_DEBUG_DEPSGRAPH_UID);
+  BLI_args_add(
+      ba, nullptr, "--debug-depsgraph-trace", CB(arg_handle_debug_depsgraph_trace_set), nullptr);
   BLI_args_add(ba,
                nullptr,
                "--debug-gpu-force-workarounds",
@@ -2814,6 +2872,11 @@ void main_args_setup(bContext *C, bArgs *ba, bool all)
 
   BLI_args_add(ba, nullptr, "--app-template", CB(arg_handle_app_template), nullptr);
   BLI_args_add(ba, nullptr, "--factory-startup", CB(arg_handle_factory_startup_set), nullptr);
+  BLI_args_add(ba,
+               nullptr,
+               "--load-active-scene-only",
+               CB(arg_handle_load_active_scene_only_set),
+               nullptr);
   BLI_args_add(
       ba, nullptr, "--enable-event-simulate", CB(arg_handle_enable_event_simulate), nullptr);
 
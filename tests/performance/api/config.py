@@ -34,6 +34,7 @@ class TestEntry:
     status: str = 'queued'
     error_msg: str = ''
     output: Dict = field(default_factory=dict)
+    samples: List = field(default_factory=list)
     benchmark_type: str = 'comparison'
 
     def to_json(self) -> Dict:
@@ -127,6 +128,8 @@ class TestConfig:
         self.builds = getattr(config, 'builds', {})
         self.queue = TestQueue(self.base_dir / 'results.json')
         self.benchmark_type = getattr(config, 'benchmark_type', 'comparison')
+        # Number of times every test is run, the median of the runs is used as result.
+        self.repeat = max(getattr(config, 'repeat', 1), 1)
 
         self.devices = []
         self._update_devices(env, getattr(config, 'devices', ['CPU']))
@@ -150,6 +153,7 @@ class TestConfig:
         default_config = """devices = ['CPU']\n"""
         default_config += """tests = ['*']\n"""
         default_config += """categories = ['*']\n"""
+        default_config += """repeat = 1\n"""
         default_config += """builds = {\n"""
         default_config += """    'main': '/home/user/blender-git/build/bin/blender',"""
         default_config += """    '2.93': '/home/user/blender-2.93/blender',"""
@@ -18,6 +18,18 @@ from .config import TestConfig
 from .device import TestMachine
 
 
+def get_peak_memory() -> int:
+    # Peak resident memory of the current process in bytes, not available on Windows.
+    try:
+        import resource
+    except ImportError:
+        return None
+
+    peak = resource.getrusage(resource.RUSAGE_SELF).ru_maxrss
+    # Linux reports kilobytes, macOS bytes.
+    return peak if sys.platform == "darwin" else peak * 1024
+
+
 class TestEnvironment:
     def __init__(self, blender_git_dir: pathlib.Path, base_dir: pathlib.Path):
         self.blender_git_dir = blender_git_dir
@@ -31,6 +43,8 @@ class TestEnvironment:
         self.cmake_options = ['-DWITH_INTERNATIONAL=OFF', '-DWITH_BUILDINFO=OFF']
         self.log_file = None
         self.machine = None
+        # Peak resident memory of the last Blender process started by run_in_blender.
+        self.last_peak_memory = None
         self._init_default_blender_executable()
         self.set_default_blender_executable()
 
@@ -251,6 +265,7 @@ class TestEnvironment:
         # Serialize arguments in base64, to avoid having to escape it.
         args = base64.b64encode(pickle.dumps(args))
         output_prefix = 'TEST_OUTPUT: '
+        peak_memory_prefix = 'TEST_PEAK_MEMORY: '
 
         expression = (f'import sys, pickle, base64;'
                       f'sys.path.append(r"{package_path}");'
@@ -258,19 +273,25 @@ class TestEnvironment:
                       f'args = pickle.loads(base64.b64decode({args}));'
                       f'result = {modulename}.{functionname}(args);'
                       f'result = base64.b64encode(pickle.dumps(result));'
-                      f'print("\\n{output_prefix}" + result.decode() + "\\n")')
+                      f'print("\\n{output_prefix}" + result.decode() + "\\n");'
+                      f'from api.environment import get_peak_memory;'
+                      f'print("\\n{peak_memory_prefix}" + str(get_peak_memory()) + "\\n")')
 
         expr_args = blender_args + ['--python-expr', expression]
         lines = self.call_blender(expr_args, foreground=foreground)
 
         # Parse output.
+        result = {}
+        self.last_peak_memory = None
         for line in lines:
             if line.startswith(output_prefix):
                 output = line[len(output_prefix):].strip()
                 result = pickle.loads(base64.b64decode(output))
-                return result, lines
+            elif line.startswith(peak_memory_prefix):
+                peak_memory = line[len(peak_memory_prefix):].strip()
+                self.last_peak_memory = None if peak_memory == 'None' else int(peak_memory)
 
-        return {}, lines
+        return result, lines
 
     def find_blend_files(self, dirpath: pathlib.Path) -> List:
         # Find .blend files in subdirectories of the given directory in the
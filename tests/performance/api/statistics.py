@@ -0,0 +1,74 @@
+# SPDX-FileCopyrightText: 2024 Blender Authors
+#
+# SPDX-License-Identifier: Apache-2.0
+
+import statistics
+from typing import Dict, List
+
+
+def percentile(values: List[float], p: float) -> float:
+    # Percentile with linear interpolation between the closest ranks, p in [0, 100].
+    values = sorted(values)
+    position = (len(values) - 1) * p / 100.0
+    lower = int(position)
+    upper = min(lower + 1, len(values) - 1)
+    return values[lower] + (values[upper] - values[lower]) * (position - lower)
+
+
+def aggregate_outputs(outputs: List[Dict]) -> Dict:
+    # Combine the outputs of repeated runs of a test. Every value is replaced by its median, so
+    # results of a single run and of repeated runs can be compared. The spread of the time is
+    # added as separate outputs.
+    if len(outputs) == 1:
+        return outputs[0]
+
+    result = {}
+    for key in outputs[0].keys():
+        values = [output[key] for output in outputs if key in output]
+        if not all(isinstance(value, (int, float)) for value in values):
+            result[key] = values[-1]
+            continue
+
+        result[key] = percentile(values, 50)
+        if key == 'time':
+            result['time_p95'] = percentile(values, 95)
+            result['time_stdev'] = statistics.stdev(values)
+
+    return result
+
+
+def find_regressions(entries: List, base_revision: str, threshold: float, output: str) -> List[Dict]:
+    # Compare the output of every test against the same test and device of the base revision,
+    # and return the ones that increased by more than the threshold, as a fraction.
+    base_entries = {}
+    for entry in entries:
+        if entry.revision == base_revision and entry.status == 'done':
+            base_entries[(entry.category, entry.test, entry.device_id)] = entry
+
+    regressions = []
+    for entry in entries:
+        if entry.revision == base_revision or entry.status != 'done':
+            continue
+
+        base_entry = base_entries.get((entry.category, entry.test, entry.device_id))
+        if not base_entry or output not in entry.output or output not in base_entry.output:
+            continue
+
+        base_value = base_entry.output[output]
+        value = entry.output[output]
+        if base_value <= 0.0:
+            continue
+
+        change = (value - base_value) / base_value
+        if change > threshold:
+            regressions.append({'category': entry.category,
+                                'test': entry.test,
+                                'device_id': entry.device_id,
+                                'revision': entry.revision,
+                                'base_revision': base_revision,
+                                'output': output,
+                                'base_value': base_value,
+                                'value': value,
+                                'change': change})
+
+    return regressions
@@ -7,6 +7,7 @@ import api
 import argparse
 import fnmatch
 import glob
+import json
 import pathlib
 import shutil
 import sys
@@ -74,6 +75,8 @@ def print_row(config: api.TestConfig, entries: List, end='\n') -> None:
         result = ''
         if status in {'done', 'outdated'} and output:
             result = '%.4fs' % output['time']
+            if 'time_p95' in output:
+                result += ' (p95 %.4fs)' % output['time_p95']
 
             if status == 'outdated':
                 result += " (outdated)"
@@ -133,6 +136,7 @@ def run_entry(env: api.TestEnvironment,
 
     # Clear output
     entry.output = None
+    entry.samples = []
     entry.error_msg = ''
 
     # Build revision, or just set path to existing executable.
@@ -162,9 +166,19 @@ def run_entry(env: api.TestEnvironment,
         print_row(config, row, end='\r')
 
         try:
-            entry.output = test.run(env, device_id)
-            if not entry.output:
-                raise Exception("Test produced no output")
+            outputs = []
+            for _ in range(config.repeat):
+                output = test.run(env, device_id)
+                if not output:
+                    raise Exception("Test produced no output")
+                # Tests that don't measure memory themselves report the peak memory of the
+                # Blender process they ran in.
+                if 'peak_memory' not in output and env.last_peak_memory:
+                    output['peak_memory'] = env.last_peak_memory
+                outputs.append(output)
+
+            entry.output = api.aggregate_outputs(outputs)
+            entry.samples = outputs if len(outputs) > 1 else []
             entry.status = 'done'
         except KeyboardInterrupt as e:
             raise e
@@ -309,6 +323,47 @@ def cmd_run(env: api.TestEnvironment, argv: List, update_only: bool):
     sys.exit(exit_code)
 
 
+def cmd_compare(env: api.TestEnvironment, argv: List):
+    # Report tests that got slower than the base revision, for use as a gate in automation.
+    parser = argparse.ArgumentParser()
+    parser.add_argument('config')
+    parser.add_argument('base_revision')
+    parser.add_argument('--threshold', type=float, default=5.0,
+                        help='Allowed increase in percent before a test is a regression')
+    parser.add_argument('--output', type=str, default='time',
+                        help='Test output to compare, for example time or peak_memory')
+    parser.add_argument('--json', type=str, default=None,
+                        help='Write the regressions to this JSON file')
+    args = parser.parse_args(argv)
+
+    configs = env.get_configs(args.config)
+    if not configs:
+        sys.stderr.write(f'Error: configuration {args.config} not found\n')
+        sys.exit(1)
+
+    config = configs[0]
+    if args.base_revision not in config.revision_names():
+        sys.stderr.write(f'Error: revision {args.base_revision} not found in configuration\n')
+        sys.exit(1)
+
+    regressions = api.find_regressions(
+        config.queue.entries, args.base_revision, args.threshold / 100.0, args.output)
+
+    for regression in regressions:
+        print(f"{regression['category']: <15} {regression['test']: <40} "
+              f"{regression['revision']: <20} {regression['base_value']:.4f} -> "
+              f"{regression['value']:.4f} (+{regression['change'] * 100.0:.1f}%)")
+
+    if args.json:
+        with open(args.json, 'w') as f:
+            json.dump(regressions, f, indent=2)
+
+    if regressions:
+        sys.exit(1)
+
+    print(f'No {args.output} regressions above {args.threshold}% compared to {args.base_revision}')
+
+
 def cmd_graph(argv: List):
     # Create graph from a given JSON results file.
     parser = argparse.ArgumentParser()
@@ -343,6 +398,8 @@ def main():
              '  update [<config>] [<test>]           Execute only queued and outdated tests\n'
              '  reset [<config>] [<test>]            Clear tests results in configuration\n'
              '  status [<config>] [<test>]           List configurations and their tests\n'
+             '  compare <config> <base_revision>     List tests slower than the base revision,\n'
+             '          [--threshold <percent>]      failing when there are any\n'
              '  \n'
              '  graph a.json b.json... -o out.html   Create graph from results in JSON files\n')
 
@@ -383,6 +440,8 @@ def main():
         cmd_reset(env, argv)
     elif args.command == 'status':
         cmd_status(env, argv)
+    elif args.command == 'compare':
+        cmd_compare(env, argv)
     elif args.command == 'help':
         parser.print_usage()
     else:
@@ -0,0 +1,142 @@
+# SPDX-FileCopyrightText: 2024 Blender Authors
+#
+# SPDX-License-Identifier: Apache-2.0
+
+import api
+
+
+# File extension of each benchmarked format.
+FORMATS = {
+    "obj": ".obj",
+    "ply": ".ply",
+    "stl": ".stl",
+    "usd": ".usdc",
+    "alembic": ".abc",
+}
+
+# Number of grid subdivisions of the generated meshes, giving roughly 0.25 and 2.25 million
+# vertices. The grid is duplicated into several objects to also cover per-object overhead.
+GRID_SIZES = (500, 1500)
+OBJECTS_NUM = 4
+
+
+def prepare_io_scene(context, size):
+    import bpy
+    """
+    Prepare a clean state of the scene with a few high-res grids with noise in their height, so
+    the exported data doesn't compress trivially.
+    """
+
+    if context.object:
+        bpy.ops.object.mode_set(mode='OBJECT')
+
+    # Delete all current objects from the scene.
+    bpy.ops.object.select_all(action='SELECT')
+    bpy.ops.object.delete(use_global=False)
+    bpy.ops.outliner.orphans_purge()
+
+    bpy.ops.mesh.primitive_grid_add(
+        x_subdivisions=size, y_subdivisions=size, size=2, align='WORLD', location=(0, 0, 0))
+
+    ob = context.object
+    for vert in ob.data.vertices:
+        x, y, _ = vert.co
+        vert.co.z = 0.05 * ((x * 37.0 + y * 91.0) % 1.0)
+
+    for i in range(1, OBJECTS_NUM):
+        copy = ob.copy()
+        copy.data = ob.data.copy()
+        copy.location.x = 2.5 * i
+        context.collection.objects.link(copy)
+
+
+def _export(file_format, filepath):
+    import bpy
+
+    if file_format == "obj":
+        bpy.ops.wm.obj_export(filepath=filepath)
+    elif file_format == "ply":
+        bpy.ops.wm.ply_export(filepath=filepath)
+    elif file_format == "stl":
+        bpy.ops.wm.stl_export(filepath=filepath)
+    elif file_format == "usd":
+        bpy.ops.wm.usd_export(filepath=filepath)
+    elif file_format == "alembic":
+        bpy.ops.wm.alembic_export(filepath=filepath, as_background_job=False)
+
+
+def _import(file_format, filepath):
+    import bpy
+
+    if file_format == "obj":
+        bpy.ops.wm.obj_import(filepath=filepath)
+    elif file_format == "ply":
+        bpy.ops.wm.ply_import(filepath=filepath)
+    elif file_format == "stl":
+        bpy.ops.wm.stl_import(filepath=filepath)
+    elif file_format == "usd":
+        bpy.ops.wm.usd_import(filepath=filepath)
+    elif file_format == "alembic":
+        bpy.ops.wm.alembic_import(filepath=filepath, as_background_job=False)
+
+
+def _run(args):
+    import bpy
+    import os
+    import tempfile
+    import time
+    context = bpy.context
+
+    file_format = args["format"]
+    direction = args["direction"]
+
+    prepare_io_scene(context, args["size"])
+
+    with tempfile.TemporaryDirectory() as temp_dir:
+        filepath = os.path.join(temp_dir, "benchmark" + FORMATS[file_format])
+
+        if direction == "export":
+            start = time.time()
+            _export(file_format, filepath)
+            end = time.time()
+        else:
+            _export(file_format, filepath)
+            bpy.ops.object.select_all(action='SELECT')
+            bpy.ops.object.delete(use_global=False)
+            bpy.ops.outliner.orphans_purge()
+
+            start = time.time()
+            _import(file_format, filepath)
+            end = time.time()
+
+        file_size = os.path.getsize(filepath)
+
+    return {'time': end - start,
+            'throughput_mb_per_second': file_size / (1024 * 1024) / max(end - start, 1e-6)}
+
+
+class FileIOTest(api.Test):
+    def __init__(self, file_format, direction, size):
+        self.file_format = file_format
+        self.direction = direction
+        self.size = size
+
+    def name(self):
+        return f"{self.file_format}_{self.direction}_{self.size}"
+
+    def category(self):
+        return "file_io"
+
+    def run(self, env, device_id):
+        args = {"format": self.file_format, "direction": self.direction, "size": self.size}
+
+        result, _ = env.run_in_blender(_run, args)
+
+        return result
+
+
+def generate(env):
+    return [FileIOTest(file_format, direction, size)
+            for file_format in FORMATS
+            for direction in ("import", "export")
+            for size in GRID_SIZES]
@@ -0,0 +1,125 @@
+# SPDX-FileCopyrightText: 2024 Blender Authors
+#
+# SPDX-License-Identifier: Apache-2.0
+
+import api
+
+
+# Number of grid subdivisions of the generated mesh used by each operator. Operators that create
+# a lot of new geometry use a smaller mesh to keep the test time reasonable.
+OPERATOR_GRID_SIZES = {
+    "editmode_toggle": 1000,
+    "subdivide": 500,
+    "extrude": 1000,
+    "bevel": 300,
+    "boolean": 300,
+    "bisect": 1000,
+    "unwrap": 500,
+}
+
+
+def prepare_edit_scene(context, size):
+    import bpy
+    """
+    Prepare a clean state of the scene suitable for benchmarking
+
+    It creates a high-res grid with some noise in its height, so operators don't hit special
+    cases for flat geometry, and leaves it in object mode.
+    """
+
+    # Ensure the current mode is object, as it might not be the always the case
+    # if the benchmark script is run from a non-clean state of the .blend file.
+    if context.object:
+        bpy.ops.object.mode_set(mode='OBJECT')
+
+    # Delete all current objects from the scene.
+    bpy.ops.object.select_all(action='SELECT')
+    bpy.ops.object.delete(use_global=False)
+    bpy.ops.outliner.orphans_purge()
+
+    bpy.ops.mesh.primitive_grid_add(
+        x_subdivisions=size, y_subdivisions=size, size=2, align='WORLD', location=(0, 0, 0))
+
+    ob = context.object
+    for vert in ob.data.vertices:
+        x, y, _ = vert.co
+        vert.co.z = 0.05 * ((x * 37.0 + y * 91.0) % 1.0)
+
+
+def _prepare_operator(operator):
+    import bpy
+
+    if operator == "boolean":
+        # Add a cube to cut out of the grid, with the cube as the only selected part of the mesh.
+        bpy.ops.mesh.select_all(action='DESELECT')
+        bpy.ops.mesh.primitive_cube_add(size=1.0, location=(0.0, 0.0, 0.0))
+    else:
+        bpy.ops.mesh.select_all(action='SELECT')
+
+
+def _run_operator(operator):
+    import bpy
+
+    if operator == "subdivide":
+        bpy.ops.mesh.subdivide(number_cuts=1)
+    elif operator == "extrude":
+        bpy.ops.mesh.extrude_region()
+    elif operator == "bevel":
+        bpy.ops.mesh.bevel(offset=0.001, segments=2, affect='EDGES')
+    elif operator == "boolean":
+        bpy.ops.mesh.intersect_boolean(operation='DIFFERENCE', solver='EXACT')
+    elif operator == "bisect":
+        bpy.ops.mesh.bisect(plane_co=(0.0, 0.0, 0.0), plane_no=(1.0, 1.0, 0.0))
+    elif operator == "unwrap":
+        bpy.ops.uv.unwrap(method='ANGLE_BASED', margin=0.001)
+
+
+def _run(args):
+    import bpy
+    import time
+    context = bpy.context
+
+    operator = args["operator"]
+
+    # Create an undo stack explicitly. This isn't created by default in background mode.
+    bpy.ops.ed.undo_push()
+
+    prepare_edit_scene(context, OPERATOR_GRID_SIZES[operator])
+
+    if operator == "editmode_toggle":
+        start = time.time()
+        bpy.ops.object.mode_set(mode='EDIT')
+        bpy.ops.object.mode_set(mode='OBJECT')
+        end = time.time()
+        return {'time': end - start}
+
+    bpy.ops.object.mode_set(mode='EDIT')
+    _prepare_operator(operator)
+
+    start = time.time()
+    _run_operator(operator)
+    end = time.time()
+
+    return {'time': end - start}
+
+
+class MeshEditTest(api.Test):
+    def __init__(self, operator):
+        self.operator = operator
+
+    def name(self):
+        return self.operator
+
+    def category(self):
+        return "mesh_edit"
+
+    def run(self, env, device_id):
+        args = {"operator": self.operator}
+
+        result, _ = env.run_in_blender(_run, args)
+
+        return result
+
+
+def generate(env):
+    return [MeshEditTest(operator) for operator in OPERATOR_GRID_SIZES]
@@ -118,6 +118,11 @@ def _run(args):
 
     prepare_sculpt_scene(context)
 
+    curve_preset = args.get("curve_preset")
+    if curve_preset:
+        # Exercise the falloff evaluation of the active brush with a specific curve.
+        context.tool_settings.sculpt.brush.curve_preset = curve_preset
+
     context_override = context.copy()
     set_view3d_context_override(context_override)
 
@@ -132,17 +137,20 @@ def _run(args):
 
 
 class SculptBrushTest(api.Test):
-    def __init__(self, filepath):
+    def __init__(self, filepath, curve_preset=None):
         self.filepath = filepath
+        self.curve_preset = curve_preset
 
     def name(self):
+        if self.curve_preset:
+            return "{:s}_{:s}".format(self.filepath.stem, self.curve_preset.lower())
         return self.filepath.stem
 
     def category(self):
         return "sculpt"
 
     def run(self, env, device_id):
-        args = {}
+        args = {"curve_preset": self.curve_preset}
 
         result, _ = env.run_in_blender(_run, args, [self.filepath])
 
@@ -151,4 +159,8 @@ class SculptBrushTest(api.Test):
 
 def generate(env):
     filepaths = env.find_blend_files('sculpt/*')
-    return [SculptBrushTest(filepath) for filepath in filepaths]
+    tests = [SculptBrushTest(filepath) for filepath in filepaths]
+    # Analytic and custom curve falloffs use different code paths.
+    for curve_preset in ('SMOOTH', 'CUSTOM'):
+        tests += [SculptBrushTest(filepath, curve_preset) for filepath in filepaths]
+    return tests